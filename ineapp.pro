@@ -4,6 +4,9 @@
 ########################################################################################################################
 
 TEMPLATE = subdirs
-SUBDIRS = ineapp test
+SUBDIRS = ineapp test benchmark
 
 test.depends = ineapp
+
+benchmark.subdir = test/benchmark
+benchmark.depends = ineapp
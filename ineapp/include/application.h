@@ -72,6 +72,36 @@ class APP_PUBLIC_API Application:public EQt::ProgrammaticApplication {
          */
         static const char environmentVariableEnvironmentType[];
 
+        /**
+         * Environment variable used to enable placement profiling.  When set, the variable holds the name of the file
+         * to receive the profiling report when the application exits.
+         */
+        static const char environmentVariablePlacementProfile[];
+
+        /**
+         * Environment variable used to enable keystroke to paint latency tracing.  When set, the variable holds the
+         * name of the file to receive the latency report.
+         */
+        static const char environmentVariableLatencyTrace[];
+
+        /**
+         * Environment variable used to set the scene memory budget, in megabytes.  A value of 0 disables the memory
+         * governor.
+         */
+        static const char environmentVariableSceneMemoryBudget[];
+
+        /**
+         * Environment variable used to request a memory governor report.  When set, the variable holds the name of
+         * the file to receive the report.
+         */
+        static const char environmentVariableSceneMemoryReport[];
+
+        /**
+         * Environment variable used to select the native plot renderer.  When set, the variable holds a comma
+         * separated list of plot engine names, such as "xy", that should render plots without using QChart.
+         */
+        static const char environmentVariableNativePlots[];
+
         /**
          * The name of the application global math font.
          */
@@ -221,6 +251,16 @@ class APP_PUBLIC_API Application:public EQt::ProgrammaticApplication {
          */
         int exec();
 
+        /**
+         * Method you can call to write the latency tracing report collected so far.  The report is written to the
+         * file named by the INESONIC_LATENCY_TRACE environment variable and is written again when the application
+         * exits.
+         *
+         * \return Returns true on success.  Returns false if latency tracing is disabled or the report could not be
+         *         written.
+         */
+        bool writeLatencyTraceReport();
+
     signals:
         /**
          * Signal that is emitted when the button size has been changed.
@@ -357,6 +397,14 @@ class APP_PUBLIC_API Application:public EQt::ProgrammaticApplication {
          */
         void startNormalApplication();
 
+        /**
+         * Method that initializes the language definition and plug-ins without creating a user interface and then
+         * runs a batch export, as requested on the command line.
+         *
+         * \return Returns the application exit status code.
+         */
+        int runBatchExport();
+
         /**
          * Method that performs platform specific customizations.
          */
@@ -420,6 +468,26 @@ class APP_PUBLIC_API Application:public EQt::ProgrammaticApplication {
          */
         void checkDebugSupport();
 
+        /**
+         * Method that checks if placement profiling should be enabled.
+         */
+        void checkPlacementProfiling();
+
+        /**
+         * Method that checks if latency tracing should be enabled.
+         */
+        void checkLatencyTracing();
+
+        /**
+         * Method that configures the memory governor.
+         */
+        void checkSceneMemoryBudget();
+
+        /**
+         * Method that selects the plot engines that should use the native plot renderer.
+         */
+        void checkNativePlotRenderer();
+
         /**
          * Method that sets up the environment based on environment variables.
          */
@@ -468,6 +536,22 @@ class APP_PUBLIC_API Application:public EQt::ProgrammaticApplication {
          */
         bool currentIncludeDebug;
 
+        /**
+         * The file to receive the placement profiling report.  An empty string indicates that placement profiling is
+         * disabled.
+         */
+        QString currentPlacementProfileFilename;
+
+        /**
+         * The file to receive the latency tracing report.  An empty string indicates that latency tracing is disabled.
+         */
+        QString currentLatencyTraceFilename;
+
+        /**
+         * The file to receive the memory governor report.  An empty string indicates that no report is written.
+         */
+        QString currentSceneMemoryReportFilename;
+
         /**
          * The current primary screen.
          */
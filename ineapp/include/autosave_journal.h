@@ -0,0 +1,497 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref AutosaveJournal class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef AUTOSAVE_JOURNAL_H
+#define AUTOSAVE_JOURNAL_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QSharedPointer>
+#include <QThreadPool>
+
+#include <ld_element_cursor.h>
+
+#include "app_common.h"
+#include "command_container.h"
+
+class QTimer;
+class QDataStream;
+
+namespace Ld {
+    class RootElement;
+}
+
+class Document;
+
+/**
+ * Class that maintains a crash-safe autosave journal for a single document.
+ *
+ * Text insertions and deletions are appended to a journal file next to the document as they are executed.  Commands
+ * that the journal can not describe, such as structural edits and undo/redo operations, cause a full snapshot of the
+ * document to be written instead.  Snapshots are also written periodically and after a bounded number of journal
+ * records so that recovery never replays a long journal.
+ *
+ * Journal records are written, in order, by a single worker thread.  Snapshots are saved on the GUI thread from a
+ * clone of the element tree as the element tree's save path is not known to be safe to run from another thread.  The
+ * worker is drained before a snapshot is saved so no journal write can follow the snapshot out of order.  Snapshots
+ * alternate between two files and the journal header naming the current snapshot is replaced atomically so that a
+ * crash at any point leaves a consistent journal behind.
+ *
+ * The journal and snapshots are removed whenever the document is loaded or saved and when the document is closed.
+ * A journal left on disk therefore indicates that the application terminated with unsaved changes.
+ *
+ * Documents that have never been saved are not journaled.
+ */
+class APP_PUBLIC_API AutosaveJournal:public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * Delay between a journal record being generated and the record being written, in mSec.  Records generated
+         * during this window are written together.
+         */
+        static constexpr unsigned flushDelayMSec = 250;
+
+        /**
+         * Delay between a command that can not be journaled and the resulting snapshot, in mSec.  Commands issued
+         * during this window are captured by the same snapshot.
+         */
+        static constexpr unsigned snapshotDelayMSec = 1000;
+
+        /**
+         * Interval between periodic snapshots, in mSec.  Periodic snapshots are only written if records have been
+         * journaled since the last snapshot.
+         */
+        static constexpr unsigned snapshotIntervalMSec = 5 * 60 * 1000;
+
+        /**
+         * The number of journal records after which a snapshot is written to bound the recovery time.
+         */
+        static constexpr unsigned maximumRecordsBetweenSnapshots = 2000;
+
+        /**
+         * Constructor
+         *
+         * \param[in] document The document to be journaled.  The document also becomes the parent of this object.
+         */
+        explicit AutosaveJournal(Document* document);
+
+        ~AutosaveJournal() override;
+
+        /**
+         * Method you can use to determine if a journal exists for a file.
+         *
+         * \param[in] filename The filename of the document.
+         *
+         * \return Returns true if a journal exists for the file.  Returns false if there is nothing to recover.
+         */
+        static bool recoveryAvailable(const QString& filename);
+
+        /**
+         * Method you can use to remove the journal and any snapshots for a file.
+         *
+         * \param[in] filename The filename of the document.
+         */
+        static void discard(const QString& filename);
+
+        /**
+         * Method you can use to start journaling against a file.  Any existing journal for the file is removed as the
+         * file is assumed to reflect the current document contents.
+         *
+         * \param[in] filename The filename of the document.  An empty filename stops journaling.
+         */
+        void start(const QString& filename);
+
+        /**
+         * Method you can use to stop journaling.  Pending writes are completed and the journal and any snapshots are
+         * removed.
+         */
+        void stop();
+
+        /**
+         * Method you can use to recover the document from a journal.  The journal's base, either the file itself or
+         * the most recent snapshot, is loaded and the journal records are replayed through the command queue.
+         *
+         * Recovering from a snapshot loads a private copy of the snapshot so that the snapshot slots can be reused.
+         * Nothing is saved over the original file; the document's owner is expected to direct saves to it.  Use
+         * \ref AutosaveJournal::lastRecoveryFromSnapshot to determine which base was used.
+         *
+         * \param[in] filename The filename of the document.
+         *
+         * \return Returns true on success.  Returns false if the journal or its base could not be read.
+         */
+        bool recover(const QString& filename);
+
+        /**
+         * Method you can use to determine the time the GUI thread was stalled by the most recent snapshot.  This
+         * includes cloning the element tree and saving the snapshot.
+         *
+         * \return Returns the stall time, in nanoseconds.
+         */
+        unsigned long long lastSnapshotStallNanoseconds() const;
+
+        /**
+         * Method you can use to determine the time taken to write the most recent snapshot.
+         *
+         * \return Returns the write time, in nanoseconds.  Zero is returned if the most recent snapshot failed.
+         */
+        unsigned long long lastSnapshotWriteNanoseconds() const;
+
+        /**
+         * Method you can use to determine the time taken by the most recent recovery.
+         *
+         * \return Returns the recovery time, in nanoseconds.
+         */
+        unsigned long long lastRecoveryNanoseconds() const;
+
+        /**
+         * Method you can use to determine the number of records replayed by the most recent recovery.
+         *
+         * \return Returns the number of replayed records.
+         */
+        unsigned long lastNumberRecoveredRecords() const;
+
+        /**
+         * Method you can use to determine if the most recent recovery was based on a snapshot.  A document recovered
+         * from a snapshot is backed by a copy of that snapshot rather than by the original file.
+         *
+         * \return Returns true if the most recent recovery loaded a snapshot.  Returns false if it loaded the file.
+         */
+        bool lastRecoveryFromSnapshot() const;
+
+    public slots:
+        /**
+         * Slot you can trigger when a command has been executed.
+         *
+         * \param[in] executedCommand The executed command.
+         */
+        void commandExecuted(const CommandContainer& executedCommand);
+
+        /**
+         * Slot you can trigger when the document changes in a way that can not be journaled, such as an undo or redo
+         * operation.
+         */
+        void snapshotRequired();
+
+    private slots:
+        /**
+         * Slot that is triggered to write pending records.
+         */
+        void flush();
+
+        /**
+         * Slot that is triggered to write a snapshot.
+         */
+        void writeSnapshot();
+
+        /**
+         * Slot that is triggered by the periodic snapshot timer.
+         */
+        void periodicSnapshot();
+
+    private:
+        /**
+         * Enumeration of journal record types.
+         */
+        enum class RecordType : quint8 {
+            /**
+             * Indicates a \ref InsertStringCommand record.
+             */
+            INSERT_STRING = 1,
+
+            /**
+             * Indicates a \ref DeleteCommand record.
+             */
+            DELETE_CONTENT = 2
+        };
+
+        /**
+         * Class that holds a cursor position in a form that survives saving, loading and cloning the element tree.
+         * Positions are recorded as a path of child indexes from the root element.
+         */
+        class Position {
+            public:
+                Position();
+
+                /**
+                 * Constructor
+                 *
+                 * \param[in] elementCursor The element cursor to be recorded.
+                 */
+                Position(const Ld::ElementCursor& elementCursor);
+
+                ~Position();
+
+                /**
+                 * Method you can use to convert this position back into an element cursor.
+                 *
+                 * \param[in] rootElement The root element of the tree to be searched.
+                 *
+                 * \return Returns the element cursor.  An invalid cursor is returned if the position does not exist in
+                 *         the tree.
+                 */
+                Ld::ElementCursor elementCursor(QSharedPointer<Ld::RootElement> rootElement) const;
+
+                /**
+                 * Method that writes this position to a data stream.
+                 *
+                 * \param[in] stream The stream to receive the position.
+                 */
+                void write(QDataStream& stream) const;
+
+                /**
+                 * Method that reads this position from a data stream.
+                 *
+                 * \param[in] stream The stream to read the position from.
+                 */
+                void read(QDataStream& stream);
+
+            private:
+                /**
+                 * Flag indicating if the position is valid.
+                 */
+                bool currentValid;
+
+                /**
+                 * Child indexes from the root element to the element under the cursor.
+                 */
+                QList<quint32> currentPath;
+
+                /**
+                 * Flag indicating if the cursor points to a child position of the element rather than the element.
+                 */
+                bool currentChildPosition;
+
+                /**
+                 * The child index, used when the cursor references a child position.
+                 */
+                quint32 currentChildIndex;
+
+                /**
+                 * Flag indicating if the cursor references the whole element.
+                 */
+                bool currentWholeElement;
+
+                /**
+                 * The text index.
+                 */
+                quint32 currentTextIndex;
+
+                /**
+                 * The region index.
+                 */
+                quint32 currentRegionIndex;
+        };
+
+        /**
+         * Enumeration of journal bases.
+         */
+        enum class Base : qint32 {
+            /**
+             * Indicates the journal records apply to the document file.
+             */
+            DOCUMENT_FILE = 0,
+
+            /**
+             * Indicates the journal records apply to a snapshot.
+             */
+            SNAPSHOT = 1
+        };
+
+        /**
+         * Value placed at the start of every journal.
+         */
+        static constexpr quint32 journalMagic = 0x494E454A;
+
+        /**
+         * The current journal format version.
+         */
+        static constexpr quint32 journalVersion = 1;
+
+        /**
+         * Method that determines the journal filename for a document.
+         *
+         * \param[in] filename The filename of the document.
+         *
+         * \return Returns the journal filename.
+         */
+        static QString journalFilename(const QString& filename);
+
+        /**
+         * Method that determines the filename of a snapshot slot for a document.
+         *
+         * \param[in] filename The filename of the document.
+         *
+         * \param[in] slot     The snapshot slot, either 0 or 1.
+         *
+         * \return Returns the snapshot filename.
+         */
+        static QString snapshotFilename(const QString& filename, unsigned slot);
+
+        /**
+         * Method that determines the filename of the copy of a snapshot that backs a recovered document.
+         *
+         * \param[in] filename The filename of the document.
+         *
+         * \return Returns the recovered copy's filename.
+         */
+        static QString recoveryFilename(const QString& filename);
+
+        /**
+         * Method that frames a block of data so that torn writes can be detected.
+         *
+         * \param[in] payload The data to be framed.
+         *
+         * \return Returns the framed data.
+         */
+        static QByteArray frame(const QByteArray& payload);
+
+        /**
+         * Method that encodes a journal header.
+         *
+         * \param[in] base         The journal base.
+         *
+         * \param[in] snapshotSlot The snapshot slot.  Ignored if the base is the document file.
+         *
+         * \return Returns the framed header.
+         */
+        static QByteArray header(Base base, unsigned snapshotSlot);
+
+        /**
+         * Method that writes a journal atomically, replacing any existing journal.
+         *
+         * \param[in] journalFilename The journal filename.
+         *
+         * \param[in] contents        The framed journal contents.
+         *
+         * \return Returns true on success, false on error.
+         */
+        static bool replaceJournal(const QString& journalFilename, const QByteArray& contents);
+
+        /**
+         * Method that appends framed records to a journal.
+         *
+         * \param[in] journalFilename The journal filename.
+         *
+         * \param[in] records         The framed records.
+         *
+         * \return Returns true on success, false on error.
+         */
+        static bool appendJournal(const QString& journalFilename, const QByteArray& records);
+
+        /**
+         * Method that saves a snapshot and points the journal at it.  The journal is removed if the snapshot can not
+         * be saved.  This method must be called on the GUI thread after the worker has been drained.
+         *
+         * \param[in] rootElement     A clone of the document's root element.
+         *
+         * \param[in] filename        The filename of the document.
+         *
+         * \param[in] slot            The snapshot slot to be written.
+         *
+         * \return Returns the time taken to write the snapshot, in nanoseconds.  Zero is returned on error.
+         */
+        static unsigned long long saveSnapshot(
+            QSharedPointer<Ld::RootElement> rootElement,
+            const QString&                  filename,
+            unsigned                        slot
+        );
+
+        /**
+         * Method that discards pending state and cancels pending timers.
+         */
+        void reset();
+
+        /**
+         * The document being journaled.
+         */
+        Document* currentDocument;
+
+        /**
+         * The filename of the document.  An empty string indicates journaling is stopped.
+         */
+        QString currentFilename;
+
+        /**
+         * Framed records not yet written.
+         */
+        QByteArray pendingRecords;
+
+        /**
+         * Flag indicating if a journal header has been written for the current base.
+         */
+        bool currentJournalStarted;
+
+        /**
+         * Flag indicating if records can be appended to the journal.  Cleared when the document changes in a way that
+         * the journal can not describe and set again once a snapshot is taken.
+         */
+        bool currentJournalValid;
+
+        /**
+         * The snapshot slot currently referenced by the journal.
+         */
+        unsigned currentSnapshotSlot;
+
+        /**
+         * The number of records journaled since the last snapshot.
+         */
+        unsigned long currentRecordsSinceSnapshot;
+
+        /**
+         * Worker used to write journal records in order.
+         */
+        QThreadPool writerPool;
+
+        /**
+         * Timer used to coalesce journal writes.
+         */
+        QTimer* flushTimer;
+
+        /**
+         * Timer used to coalesce snapshots.
+         */
+        QTimer* snapshotTimer;
+
+        /**
+         * Timer used to trigger periodic snapshots.
+         */
+        QTimer* periodicSnapshotTimer;
+
+        /**
+         * The most recent snapshot stall time.
+         */
+        unsigned long long currentSnapshotStallNanoseconds;
+
+        /**
+         * The most recent snapshot write time.
+         */
+        unsigned long long currentSnapshotWriteNanoseconds;
+
+        /**
+         * The most recent recovery time.
+         */
+        unsigned long long currentRecoveryNanoseconds;
+
+        /**
+         * The number of records replayed by the most recent recovery.
+         */
+        unsigned long currentNumberRecoveredRecords;
+
+        /**
+         * Flag indicating if the most recent recovery loaded a snapshot.
+         */
+        bool currentRecoveryFromSnapshot;
+};
+
+#endif
@@ -0,0 +1,526 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref BatchExporter class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef BATCH_EXPORTER_H
+#define BATCH_EXPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QList>
+#include <QSet>
+#include <QMap>
+#include <QSharedPointer>
+
+#include <util_hash_functions.h>
+
+#include <ld_element_structures.h>
+#include <ld_code_generator_output_type_container.h>
+#include <ld_code_generator_visual.h>
+
+#include "app_common.h"
+
+class QTimer;
+class QPrinter;
+
+namespace Ld {
+    class RootElement;
+    class CodeGenerator;
+}
+
+class PrintingEngine;
+
+/**
+ * Class that exports a list of documents without a user interface.
+ *
+ * Documents are loaded, laid out by their root presentations without any attached view, and then exported to one or
+ * more formats.  Each format is handled by a lane that exports one document at a time.  The HTML and LaTeX code
+ * generators are shared by the application so their lanes can not run two translations at once; parallelism comes
+ * instead from running the lanes for different formats against different documents at the same time.
+ *
+ * Document loading is serial.  Documents are loaded on the GUI thread, one per pass through the event loop, because
+ * Ld registers imports while parsing.  No two documents are ever parsed at once and the GUI thread, including lane
+ * dispatch and layout, is blocked while a document is parsed.  Imports shared between documents are parsed once and
+ * reused through the \ref ImportLoader cache.
+ *
+ * HTML and LaTeX exports start as soon as a document is loaded.  PDF and image exports wait until the document's
+ * layout is complete.
+ *
+ * Results are written to standard output, errors to standard error.  The class is intended to be driven from the GUI
+ * thread by \ref Application.  For a fully headless run, the caller should also select the offscreen platform plug-in,
+ * either with "-platform offscreen" or through the QT_QPA_PLATFORM environment variable.
+ */
+class APP_PUBLIC_API BatchExporter:public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * The default image export resolution, in DPI.
+         */
+        static constexpr double defaultImageDpi = 300.0;
+
+        /**
+         * The interval used to check for completed document layouts, in mSec.
+         */
+        static constexpr unsigned layoutPollingIntervalMSec = 50;
+
+        /**
+         * The time allowed for a document layout to complete, in mSec.  Documents whose layout does not complete in
+         * this time are reported as failures for the formats that need a layout.
+         */
+        static constexpr unsigned layoutTimeoutMSec = 120000;
+
+        /**
+         * Enumeration of supported export formats.
+         */
+        enum class Format {
+            /**
+             * Indicates HTML export, one directory per document.
+             */
+            HTML,
+
+            /**
+             * Indicates LaTeX export, one directory per document.
+             */
+            LATEX,
+
+            /**
+             * Indicates PDF export.
+             */
+            PDF,
+
+            /**
+             * Indicates export of every element that can be rendered as an image.
+             */
+            IMAGES
+        };
+
+        /**
+         * Constructor
+         *
+         * \param[in] parent Pointer to the parent object.
+         */
+        explicit BatchExporter(QObject* parent = Q_NULLPTR);
+
+        ~BatchExporter() override;
+
+        /**
+         * Method you can use to determine if the command line requests a batch export.
+         *
+         * \param[in] arguments The application command line arguments.
+         *
+         * \return Returns true if a batch export was requested.  Returns false if the application should start
+         *         normally.
+         */
+        static bool isBatchExportRequested(const QStringList& arguments);
+
+        /**
+         * Method you can use to configure this exporter from the command line.  The following options are supported:
+         *
+         *     --export <formats>   Comma separated list of formats: html, latex, pdf, images.
+         *     --output <directory> Directory to receive the exported files.  Defaults to the current directory.
+         *     --jobs <count>       Maximum number of documents in flight at once.  Defaults to the number of cores.
+         *     --dpi <resolution>   Image export resolution.  Defaults to 300 DPI.
+         *     --include-imports    Include imported documents in HTML and LaTeX exports.
+         *
+         * All remaining arguments are treated as document filenames.  Each document is exported into a subdirectory
+         * of the output directory named after the document.
+         *
+         * \param[in] arguments The application command line arguments.
+         *
+         * \return Returns true on success.  Returns false if the command line is invalid.  Use
+         *         \ref BatchExporter::errorString to obtain a description of the error.
+         */
+        bool configure(const QStringList& arguments);
+
+        /**
+         * Method you can use to obtain a description of the most recent configuration error.
+         *
+         * \return Returns the error string.
+         */
+        QString errorString() const;
+
+        /**
+         * Method you can use to determine the number of documents that could not be fully exported.
+         *
+         * \return Returns the number of failed documents.
+         */
+        unsigned long numberFailures() const;
+
+    signals:
+        /**
+         * Signal that is emitted when every document has been processed.
+         */
+        void finished();
+
+    public slots:
+        /**
+         * Slot you can trigger to start the export.  The \ref BatchExporter::finished signal is emitted once every
+         * document has been processed.
+         */
+        void start();
+
+    private slots:
+        /**
+         * Slot that is triggered from the event loop to load the next pending document.  The document is parsed on
+         * the GUI thread before this slot returns.
+         */
+        void loadNext();
+
+        /**
+         * Slot that is triggered periodically to check for documents whose layout is complete.
+         */
+        void checkLayouts();
+
+    private:
+        /**
+         * Class that tracks a single document.
+         */
+        class Job {
+            public:
+                /**
+                 * The document filename.
+                 */
+                QString filename;
+
+                /**
+                 * The directory receiving the exported files for this document.
+                 */
+                QString outputDirectory;
+
+                /**
+                 * The document root element.
+                 */
+                QSharedPointer<Ld::RootElement> rootElement;
+
+                /**
+                 * Formats not yet exported.
+                 */
+                QSet<Format> remainingFormats;
+
+                /**
+                 * Flag indicating if a lane is currently exporting this document.  Lanes never share a document so
+                 * that two threads never walk the same element tree.
+                 */
+                bool busy;
+
+                /**
+                 * Errors reported for this document.
+                 */
+                QStringList errors;
+
+                /**
+                 * Timer started when the document starts waiting for its layout to complete.
+                 */
+                QElapsedTimer layoutTimer;
+        };
+
+        /**
+         * Class that holds the documents queued against a single export format.
+         */
+        class Lane {
+            public:
+                Lane();
+
+                /**
+                 * Documents waiting for this lane.
+                 */
+                QList<Job*> queue;
+
+                /**
+                 * The document currently being exported by this lane.  A null pointer indicates the lane is idle.
+                 */
+                Job* activeJob;
+        };
+
+        /**
+         * Class that receives status from a shared code generator and reports completion back to the exporter on the
+         * GUI thread.  Code generator visuals are called from the translation thread.
+         */
+        class TranslationMonitor:public Ld::CodeGeneratorVisual {
+            public:
+                /**
+                 * Constructor
+                 *
+                 * \param[in] exporter The exporter to be notified.
+                 *
+                 * \param[in] format   The format handled by the monitored code generator.
+                 */
+                TranslationMonitor(BatchExporter* exporter, Format format);
+
+                ~TranslationMonitor() override;
+
+                /**
+                 * Method that is called when a translation is completed.
+                 *
+                 * \param[in] success     Holds true if the translation was successful.
+                 *
+                 * \param[in] rootElement The root element of the translated tree.
+                 *
+                 * \param[in] outputType  The translation output type.
+                 */
+                void translationCompleted(
+                    bool                                        success,
+                    QSharedPointer<Ld::RootElement>             rootElement,
+                    const Ld::CodeGeneratorOutputTypeContainer& outputType
+                ) final;
+
+                /**
+                 * Method that is called when a translation is aborted.
+                 *
+                 * \param[in] rootElement The root element of the translated tree.
+                 *
+                 * \param[in] outputType  The translation output type.
+                 */
+                void translationAborted(
+                    QSharedPointer<Ld::RootElement>             rootElement,
+                    const Ld::CodeGeneratorOutputTypeContainer& outputType
+                ) final;
+
+            private:
+                /**
+                 * Method that reports completion to the exporter.
+                 *
+                 * \param[in] success Holds true if the translation was successful.
+                 */
+                void report(bool success);
+
+                /**
+                 * The exporter to be notified.
+                 */
+                BatchExporter* currentExporter;
+
+                /**
+                 * The monitored format.
+                 */
+                Format currentFormat;
+        };
+
+        /**
+         * Method that parses a comma separated list of formats.
+         *
+         * \param[in] formatList The list of formats.
+         *
+         * \return Returns the formats.  An empty set is returned if any format is unknown.
+         */
+        static QSet<Format> parseFormats(const QString& formatList);
+
+        /**
+         * Method that returns a printable name for a format.
+         *
+         * \param[in] format The format.
+         *
+         * \return Returns the format name.
+         */
+        static QString formatName(Format format);
+
+        /**
+         * Method that starts loading documents until the configured number of documents are in flight.
+         */
+        void startLoads();
+
+        /**
+         * Method that starts any idle lane that has a document waiting.
+         */
+        void dispatch();
+
+        /**
+         * Method that starts an export.
+         *
+         * \param[in] format The format to export.
+         *
+         * \param[in] job    The document to export.
+         */
+        void startExport(Format format, Job* job);
+
+        /**
+         * Method that starts an HTML export.
+         *
+         * \param[in] job The document to export.
+         *
+         * \return Returns true if the translation was started.
+         */
+        bool startHtmlExport(Job* job);
+
+        /**
+         * Method that starts a LaTeX export.
+         *
+         * \param[in] job The document to export.
+         *
+         * \return Returns true if the translation was started.
+         */
+        bool startLaTeXExport(Job* job);
+
+        /**
+         * Method that starts a PDF export.
+         *
+         * \param[in] job The document to export.
+         */
+        void startPdfExport(Job* job);
+
+        /**
+         * Method that exports every element of a document that can be rendered as an image.
+         *
+         * \param[in] job The document to export.
+         *
+         * \return Returns true on success.
+         */
+        bool exportImages(Job* job);
+
+        /**
+         * Method that exports images for an element and its descendants.  Descendants of an element that is exported
+         * as an image are not exported separately.
+         *
+         * \param[in]     element         The element to export.
+         *
+         * \param[in]     imageDirectory  The directory receiving the images.
+         *
+         * \param[in,out] imageIndex      The index of the next image.
+         *
+         * \param[in,out] errors          List to receive any errors.
+         */
+        void exportImages(
+            Ld::ElementPointer element,
+            const QString&     imageDirectory,
+            unsigned long&     imageIndex,
+            QStringList&       errors
+        );
+
+        /**
+         * Method that is called when a lane finishes exporting a document.
+         *
+         * \param[in] format  The lane's format.
+         *
+         * \param[in] success Holds true if the export succeeded.
+         */
+        void exportCompleted(Format format, bool success);
+
+        /**
+         * Method that releases a document once every format has been exported.
+         *
+         * \param[in] job The document to release.
+         */
+        void finishJob(Job* job);
+
+        /**
+         * Method that emits the \ref BatchExporter::finished signal if every document has been processed.
+         */
+        void checkFinished();
+
+        /**
+         * The requested formats.
+         */
+        QSet<Format> currentFormats;
+
+        /**
+         * The output directory.
+         */
+        QString currentOutputDirectory;
+
+        /**
+         * The maximum number of documents in flight.
+         */
+        unsigned currentMaximumJobs;
+
+        /**
+         * The image export resolution.
+         */
+        double currentImageDpi;
+
+        /**
+         * Flag indicating if imports should be included in HTML and LaTeX exports.
+         */
+        bool currentIncludeImports;
+
+        /**
+         * The most recent configuration error.
+         */
+        QString currentErrorString;
+
+        /**
+         * Documents not yet loaded.
+         */
+        QStringList pendingFilenames;
+
+        /**
+         * Documents waiting to be loaded.
+         */
+        QList<Job*> pendingLoads;
+
+        /**
+         * Documents waiting for their layout to complete.
+         */
+        QList<Job*> awaitingLayout;
+
+        /**
+         * Loaded documents.
+         */
+        QSet<Job*> loadedJobs;
+
+        /**
+         * The export lanes, by format.
+         */
+        QMap<Format, Lane> lanes;
+
+        /**
+         * Monitor used by the HTML code generator.
+         */
+        TranslationMonitor htmlMonitor;
+
+        /**
+         * Monitor used by the LaTeX code generator.
+         */
+        TranslationMonitor latexMonitor;
+
+        /**
+         * The code generator currently used by the HTML or LaTeX lanes, by format.
+         */
+        QMap<Format, QSharedPointer<Ld::CodeGenerator>> activeCodeGenerators;
+
+        /**
+         * The printer used by the PDF lane.
+         */
+        QPrinter* currentPrinter;
+
+        /**
+         * The printing engine used by the PDF lane.
+         */
+        PrintingEngine* currentPrintingEngine;
+
+        /**
+         * Timer used to check for completed layouts.
+         */
+        QTimer* layoutTimer;
+
+        /**
+         * The number of documents that failed.
+         */
+        unsigned long currentNumberFailures;
+
+        /**
+         * Flag indicating if the finished signal has been emitted.
+         */
+        bool currentFinished;
+};
+
+/**
+ * Hash function for the \ref BatchExporter::Format enumeration.
+ *
+ * \param[in] value The value to be hashed.
+ *
+ * \param[in] seed  An optional seed value.
+ *
+ * \return Returns a hash of the value.
+ */
+Util::HashResult qHash(BatchExporter::Format value, Util::HashSeed seed = 0);
+
+#endif
@@ -102,7 +102,12 @@ class APP_PUBLIC_API Command {
             /**
              * Value used to indicate the \ref PasteCommand command type.
              */
-            PASTE
+            PASTE,
+
+            /**
+             * Value used to indicate the \ref ReplaceAllCommand command type.
+             */
+            REPLACE_ALL
         };
 
         Command();
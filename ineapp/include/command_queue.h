@@ -92,6 +92,27 @@ class APP_PUBLIC_API CommandQueue:public QObject, public CommandQueueBase {
          */
         void redoHasFailed(const CommandContainer& failedCommand);
 
+        /**
+         * Signal that is emitted whenever a newly inserted command has been successfully executed.
+         *
+         * \param[out] executedCommand The command that was performed.
+         */
+        void commandHasExecuted(const CommandContainer& executedCommand);
+
+        /**
+         * Signal that is emitted whenever an undo operation completes successfully.
+         *
+         * \param[out] undoneCommand The command that was undone.
+         */
+        void undoHasCompleted(const CommandContainer& undoneCommand);
+
+        /**
+         * Signal that is emitted whenever a redo operation completes successfully.
+         *
+         * \param[out] redoneCommand The command that was redone.
+         */
+        void redoHasCompleted(const CommandContainer& redoneCommand);
+
     private:
         /**
          * Virtual method you can overload to receive notification whenever the undo status changes.  The default
@@ -142,6 +163,27 @@ class APP_PUBLIC_API CommandQueue:public QObject, public CommandQueueBase {
          *                           container if an redo was requested when no redo operation was available.
          */
         void redoFailed(const CommandContainer& failedCommand) final;
+
+        /**
+         * Virtual method that is called whenever a newly inserted command has been successfully executed.
+         *
+         * \param[out] executedCommand The command that was performed.
+         */
+        void commandExecuted(const CommandContainer& executedCommand) final;
+
+        /**
+         * Virtual method that is called whenever an undo operation completes successfully.
+         *
+         * \param[out] undoneCommand The command that was undone.
+         */
+        void undoCompleted(const CommandContainer& undoneCommand) final;
+
+        /**
+         * Virtual method that is called whenever a redo operation completes successfully.
+         *
+         * \param[out] redoneCommand The command that was redone.
+         */
+        void redoCompleted(const CommandContainer& redoneCommand) final;
 };
 
 #endif
@@ -241,6 +241,30 @@ class APP_PUBLIC_API CommandQueueBase {
          */
         virtual void redoFailed(const CommandContainer& failedCommand);
 
+        /**
+         * Virtual method that is called whenever a newly inserted command has been successfully executed.  The method
+         * is called before the command is merged into the undo stack.  The default implementation simply returns.
+         *
+         * \param[out] executedCommand The command that was performed.
+         */
+        virtual void commandExecuted(const CommandContainer& executedCommand);
+
+        /**
+         * Virtual method that is called whenever an undo operation completes successfully.  The default
+         * implementation simply returns.
+         *
+         * \param[out] undoneCommand The command that was undone.
+         */
+        virtual void undoCompleted(const CommandContainer& undoneCommand);
+
+        /**
+         * Virtual method that is called whenever a redo operation completes successfully.  The default
+         * implementation simply returns.
+         *
+         * \param[out] redoneCommand The command that was redone.
+         */
+        virtual void redoCompleted(const CommandContainer& redoneCommand);
+
     private:
         /**
          * Method that will attempt to restore the cursor state for a command.
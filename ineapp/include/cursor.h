@@ -18,6 +18,8 @@
 #include <QRectF>
 #include <QPointF>
 #include <QList>
+#include <QHash>
+#include <QPair>
 #include <QPen>
 #include <QBrush>
 #include <QPainter>
@@ -667,11 +669,72 @@ class APP_PUBLIC_API Cursor:public QObject, public Ld::Cursor, private EditHelpe
          */
         Ld::Location locationOfCursor(const Ld::ElementCursor& cursor) const;
 
+        /**
+         * Method that uses the paragraph line index to locate the cursor position on the line above or below a
+         * cursor.  Only cursors on direct children of a paragraph are handled.  Moves past the first or last line of
+         * a paragraph continue on the previous or next paragraph.
+         *
+         * \param[in]  cursor  The starting cursor.
+         *
+         * \param[in]  forward If true, the line below the cursor is used.  If false, the line above the cursor is
+         *                     used.
+         *
+         * \param[out] result  The cursor on the adjacent line.
+         *
+         * \return Returns true if the adjacent line was located.  Returns false if the caller should locate the line
+         *         by stepping through the document.
+         */
+        bool cursorOnAdjacentLine(const Ld::ElementCursor& cursor, bool forward, Ld::ElementCursor& result) const;
+
+        /**
+         * Type used to hold the selection rectangles calculated for an element, along with the cursor marking the
+         * start of the selection within the element.
+         */
+        typedef QPair<Ld::ElementCursor, QList<QRectF>> CachedSelectionRectangles;
+
+        /**
+         * Type used to cache the selection rectangles of elements fully or partially covered by the selection, keyed
+         * by element.
+         */
+        typedef QHash<const Ld::Element*, CachedSelectionRectangles> SelectionRectangleCache;
+
         /**
          * Method that is called to update the selection rectangles.
          */
         void updateSelectionRectangles() const;
 
+        /**
+         * Method that provides selection rectangles for an element that does not contain the end of the selection,
+         * then advances the cursor and element.  Rectangles are reused from the last update when the element starts
+         * at the same position and the scene has not been repositioned.
+         *
+         * \param[in,out] cursor       The cursor tracking the element.
+         *
+         * \param[in,out] element      The element to be used and then updated.
+         *
+         * \param[in]     endingCursor The ending cursor.
+         *
+         * \param[in,out] updatedCache The cache of rectangles used by this update.  Rectangles for the element are
+         *                             added to the cache.
+         *
+         * \return Returns a list of selection rectangles to be included.
+         */
+        QList<QRectF> cachedSelectionRectanglesForElement(
+            Ld::ElementCursor&       cursor,
+            Ld::ElementPointer&      element,
+            const Ld::ElementCursor& endingCursor,
+            SelectionRectangleCache& updatedCache
+        ) const;
+
+        /**
+         * Method that merges horizontally adjacent selection rectangles that share a line.
+         *
+         * \param[in] rectangles The rectangles to be merged, in document order.
+         *
+         * \return Returns the merged rectangles, in document order.
+         */
+        static QList<QRectF> mergeSelectionRectangles(const QList<QRectF>& rectangles);
+
         /**
          * Method that can be used to advance a selection cursor.
          *
@@ -1058,6 +1121,16 @@ class APP_PUBLIC_API Cursor:public QObject, public Ld::Cursor, private EditHelpe
          * Rectangle representing the bounding rectangle for the scene.
          */
         mutable QRectF currentBoundingRectangle;
+
+        /**
+         * Selection rectangles calculated for each element during the last update.
+         */
+        mutable SelectionRectangleCache selectionRectangleCache;
+
+        /**
+         * The root presentation placement generation the selection rectangle cache was built against.
+         */
+        mutable unsigned long long selectionRectangleCacheGeneration;
 };
 
 /**
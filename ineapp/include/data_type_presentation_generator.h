@@ -203,6 +203,68 @@ class APP_PUBLIC_API DataTypePresentationGenerator:public virtual Ld::DataTypeDe
         virtual Presentation::ReflowHint reflowHint(bool afterAbort) const;
 
     protected:
+        /**
+         * Class that enables the member measurement cache for its lifetime.  Container generators create a scope
+         * around the measurement and rendering of a value so that heights calculated for members during the
+         * measurement pass are reused when the members are rendered.  Scopes may be nested.  Measurements recorded
+         * under a scope are discarded when the scope is destroyed.
+         *
+         * Measurements are keyed by the address of the value, the format, and the relative scale.  You should only
+         * record measurements for values that remain in place for the lifetime of the innermost scope.
+         */
+        class MeasurementScope {
+            public:
+                MeasurementScope();
+
+                ~MeasurementScope();
+        };
+
+        /**
+         * Method you can use to obtain a cached height measurement for a value.
+         *
+         * \param[in]  value         The value that was measured.
+         *
+         * \param[in]  format        The format used to measure the value.
+         *
+         * \param[in]  relativeScale The relative scale used to measure the value.
+         *
+         * \param[out] height        The cached height.
+         *
+         * \param[out] ascent        The cached ascent.
+         *
+         * \return Returns true if a measurement was found.  Returns false if the value has not been measured or no
+         *         \ref DataTypePresentationGenerator::MeasurementScope is active.
+         */
+        static bool cachedHeight(
+            const Model::Variant& value,
+            Ld::FormatPointer     format,
+            float                 relativeScale,
+            float&                height,
+            float&                ascent
+        );
+
+        /**
+         * Method you can use to record a height measurement for a value.  The measurement is ignored if no
+         * \ref DataTypePresentationGenerator::MeasurementScope is active.
+         *
+         * \param[in] value         The measured value.
+         *
+         * \param[in] format        The format used to measure the value.
+         *
+         * \param[in] relativeScale The relative scale used to measure the value.
+         *
+         * \param[in] height        The measured height.
+         *
+         * \param[in] ascent        The measured ascent.
+         */
+        static void cacheHeight(
+            const Model::Variant& value,
+            Ld::FormatPointer     format,
+            float                 relativeScale,
+            float                 height,
+            float                 ascent
+        );
+
         /**
          * Method you can use to request free space from the presenter.
          *
@@ -41,6 +41,7 @@ class QTimer;
 
 class Editor;
 class CommandQueue;
+class AutosaveJournal;
 
 /**
  * Class that tracks the contents of a single document.  This class acts as a wrapper for both the root element and the
@@ -219,6 +220,18 @@ class APP_PUBLIC_API Document:public RootPresentation {
          */
         bool loadDocument(const QString& filename);
 
+        /**
+         * Recovers this document from the autosave journal left behind for a file.  You can use the
+         * \ref AutosaveJournal::recoveryAvailable method to determine if a journal exists.  The recovered document is
+         * marked as modified and is not saved.  Saves are directed to the original file even if the document was
+         * recovered from a snapshot.
+         *
+         * \param[in] filename The filename of the file containing this document.
+         *
+         * \return Returns true on success, false on failure.
+         */
+        bool recoverDocument(const QString& filename);
+
         /**
          * Saves the document.
          *
@@ -235,6 +248,13 @@ class APP_PUBLIC_API Document:public RootPresentation {
          */
         bool saveDocument(const QString& newFilename);
 
+        /**
+         * Method you can use to access the autosave journal for this document.
+         *
+         * \return Returns a pointer to the autosave journal.
+         */
+        AutosaveJournal* autosaveJournal() const;
+
         /**
          * Determines the filename associated with this document.
          *
@@ -579,6 +599,18 @@ class APP_PUBLIC_API Document:public RootPresentation {
          * The command queue for commands associated with this document.
          */
         CommandQueue* currentCommandQueue;
+
+        /**
+         * The autosave journal for this document.
+         */
+        AutosaveJournal* currentAutosaveJournal;
+
+        /**
+         * The filename of the file this document was recovered for, if the document was recovered from a snapshot and
+         * has not been saved since.  The element tree refers to a copy of the snapshot in this case so saves are
+         * directed to this file.  An empty string otherwise.
+         */
+        QString currentRecoveredFilename;
 };
 
 #endif
@@ -0,0 +1,367 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref DocumentTextIndex class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef DOCUMENT_TEXT_INDEX_H
+#define DOCUMENT_TEXT_INDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QRegularExpression>
+
+#include <ld_element_structures.h>
+#include <ld_element_cursor.h>
+
+#include "app_common.h"
+
+/**
+ * Class that maintains an index of the searchable text in a document.  The index holds every text region in document
+ * order, grouped into runs of regions that a search is allowed to treat as contiguous text.
+ *
+ * Regions are grouped by the top level element, or block, that contains them.  Element change notifications only mark
+ * the affected block as stale so the index is updated incrementally, one block at a time, on the next search.
+ */
+class APP_PUBLIC_API DocumentTextIndex {
+    public:
+        /**
+         * Class that describes a single match.
+         */
+        class APP_PUBLIC_API Match {
+            public:
+                Match();
+
+                /**
+                 * Constructor.
+                 *
+                 * \param[in] startCursor   Cursor at the first character of the match.
+                 *
+                 * \param[in] endCursor     Cursor just past the last character of the match.
+                 *
+                 * \param[in] text          The matched text.
+                 *
+                 * \param[in] capturedTexts The text of the whole match followed by the text of each capture group.
+                 */
+                Match(
+                    const Ld::ElementCursor& startCursor,
+                    const Ld::ElementCursor& endCursor,
+                    const QString&           text,
+                    const QStringList&       capturedTexts = QStringList()
+                );
+
+                /**
+                 * Copy constructor.
+                 *
+                 * \param[in] other The instance to be copied.
+                 */
+                Match(const Match& other);
+
+                ~Match();
+
+                /**
+                 * Method you can use to obtain a cursor at the start of the match.
+                 *
+                 * \return Returns a cursor at the first character of the match.
+                 */
+                const Ld::ElementCursor& startCursor() const;
+
+                /**
+                 * Method you can use to obtain a cursor at the end of the match.
+                 *
+                 * \return Returns a cursor just past the last character of the match.
+                 */
+                const Ld::ElementCursor& endCursor() const;
+
+                /**
+                 * Method you can use to obtain the matched text.
+                 *
+                 * \return Returns the matched text.
+                 */
+                const QString& text() const;
+
+                /**
+                 * Method you can use to obtain the text captured by the regular expression.
+                 *
+                 * \return Returns the text of the whole match followed by the text of each capture group.  An empty
+                 *         list is returned for literal searches.
+                 */
+                const QStringList& capturedTexts() const;
+
+                /**
+                 * Method you can use to build the replacement text for this match.  Back references of the form \\N
+                 * or \\NN, as accepted by QString::replace, are expanded from the captures of the original match
+                 * rather than by matching the expression again against the matched text alone.
+                 *
+                 * \param[in] replacementText The replacement text, possibly holding back references.
+                 *
+                 * \return Returns the expanded replacement text.
+                 */
+                QString expandReplacement(const QString& replacementText) const;
+
+                /**
+                 * Method you can use to determine if the match lies within a single text region.
+                 *
+                 * \return Returns true if the match starts and ends in the same text region.  Returns false if the
+                 *         match spans multiple text regions.
+                 */
+                bool isWithinRegion() const;
+
+                /**
+                 * Assignment operator.
+                 *
+                 * \param[in] other The instance to be copied.
+                 *
+                 * \return Returns a reference to this instance.
+                 */
+                Match& operator=(const Match& other);
+
+            private:
+                /**
+                 * Cursor at the start of the match.
+                 */
+                Ld::ElementCursor currentStartCursor;
+
+                /**
+                 * Cursor at the end of the match.
+                 */
+                Ld::ElementCursor currentEndCursor;
+
+                /**
+                 * The matched text.
+                 */
+                QString currentText;
+
+                /**
+                 * The text of the whole match followed by the text of each capture group.
+                 */
+                QStringList currentCapturedTexts;
+        };
+
+        DocumentTextIndex();
+
+        ~DocumentTextIndex();
+
+        /**
+         * Method you can use to set the root element to be indexed.  Changing the root element discards the index.
+         *
+         * \param[in] rootElement The root element to be indexed.
+         */
+        void setRootElement(Ld::ElementPointer rootElement);
+
+        /**
+         * Method you can call when an element's contents change.
+         *
+         * \param[in] element The changed element.
+         */
+        void elementChanged(Ld::ElementPointer element);
+
+        /**
+         * Method you can call when an element is added to the tree.
+         *
+         * \param[in] element The newly added element.
+         */
+        void elementAdded(Ld::ElementPointer element);
+
+        /**
+         * Method you can call when an element is removed from the tree.
+         *
+         * \param[in] element The element being removed.
+         */
+        void elementRemoved(Ld::ElementPointer element);
+
+        /**
+         * Method that discards the index.  The index will be rebuilt on the next search.
+         */
+        void clear();
+
+        /**
+         * Method that locates every match in the document.
+         *
+         * \param[in] searchText        The search text to be located.
+         *
+         * \param[in] caseSensitive     If true, the search will require an exact case match.  If false, the search
+         *                              will ignore case.
+         *
+         * \param[in] wholeWordsOnly    If true, the search will require that the search string represent an entire
+         *                              word or group of words.
+         *
+         * \param[in] regularExpression If true, the search string will be treated as a regular expression.  If
+         *                              false, the search string will be treated as normal text.
+         *
+         * \return Returns every match, in document order.  Empty matches are never reported.
+         */
+        QList<Match> findAll(
+            const QString& searchText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
+        /**
+         * Method that builds the regular expression used for a search.
+         *
+         * \param[in] searchText        The search text to be located.
+         *
+         * \param[in] caseSensitive     If true, the expression will be case sensitive.
+         *
+         * \param[in] wholeWordsOnly    If true, the expression will only match whole words.
+         *
+         * \param[in] regularExpression If true, the search text is a regular expression.  If false, the search text
+         *                              is literal text.
+         *
+         * \return Returns the regular expression.
+         */
+        static QRegularExpression searchExpression(
+            const QString& searchText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
+    private:
+        /**
+         * Class that identifies a single text region.
+         */
+        class Region {
+            public:
+                /**
+                 * The element holding the region.
+                 */
+                Ld::ElementWeakPointer element;
+
+                /**
+                 * The region index within the element.
+                 */
+                unsigned regionIndex;
+        };
+
+        /**
+         * Class that holds a run of regions that can be searched as contiguous text.
+         */
+        class Run {
+            public:
+                /**
+                 * The aggregated text of the run.
+                 */
+                QString text;
+
+                /**
+                 * The offset into the aggregated text where each region starts.
+                 */
+                QVector<unsigned long> offsets;
+
+                /**
+                 * The regions in the run.
+                 */
+                QVector<Region> regions;
+        };
+
+        /**
+         * Class that holds the runs under one top level element.
+         */
+        class Block {
+            public:
+                /**
+                 * The top level element.
+                 */
+                Ld::ElementWeakPointer element;
+
+                /**
+                 * The runs under the top level element, in document order.
+                 */
+                QList<Run> runs;
+        };
+
+        /**
+         * Method that brings the index up to date.
+         */
+        void update();
+
+        /**
+         * Method that builds the block for a top level element.
+         *
+         * \param[in] element The top level element.
+         *
+         * \return Returns the newly built block.
+         */
+        static Block buildBlock(Ld::ElementPointer element);
+
+        /**
+         * Method that appends the regions of an element, and its descendants, to a block.
+         *
+         * \param[in]     element             The element to be added.
+         *
+         * \param[in,out] block               The block to receive the regions.
+         *
+         * \param[in,out] previousElement     The element holding the last region added to the block.
+         *
+         * \param[in,out] previousRegionIndex The index of the last region added to the block.
+         */
+        static void appendRegions(
+            Ld::ElementPointer  element,
+            Block&              block,
+            Ld::ElementPointer& previousElement,
+            unsigned&           previousRegionIndex
+        );
+
+        /**
+         * Method that determines if every region in a block is still under the block's element.
+         *
+         * \param[in] block The block to be checked.
+         *
+         * \return Returns true if the block is still current.  Returns false if the block must be rebuilt.
+         */
+        static bool blockIsCurrent(const Block& block);
+
+        /**
+         * Method that locates the top level element holding an element.
+         *
+         * \param[in] element The element of interest.
+         *
+         * \return Returns the top level element.  A null pointer is returned if the element is not under the root.
+         */
+        const Ld::Element* topLevelElement(Ld::ElementPointer element) const;
+
+        /**
+         * The root element being indexed.
+         */
+        Ld::ElementWeakPointer currentRootElement;
+
+        /**
+         * The blocks, in document order.
+         */
+        QList<Block> currentBlocks;
+
+        /**
+         * Map of block indexes by top level element.
+         */
+        QHash<const Ld::Element*, int> blockIndexByElement;
+
+        /**
+         * The top level elements whose blocks must be rebuilt.
+         */
+        QSet<const Ld::Element*> staleBlocks;
+
+        /**
+         * Flag indicating that top level elements have been added or removed.
+         */
+        bool structureChanged;
+
+        /**
+         * Flag indicating that an element was removed from an unknown block.  Every block is verified on the next
+         * update.
+         */
+        bool verificationNeeded;
+};
+
+#endif
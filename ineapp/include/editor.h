@@ -16,8 +16,11 @@
 #include <QList>
 #include <QGraphicsView>
 #include <QPoint>
+#include <QPointF>
 #include <QTimer>
 #include <QSharedPointer>
+#include <QTransform>
+#include <QElapsedTimer>
 
 #include <eqt_signal_aggregator.h>
 
@@ -31,8 +34,14 @@
 #include "scene_units.h"
 #include "command.h"
 #include "command_container.h"
+#include "document_text_index.h"
+#include "viewport_layer.h"
+#include "scene_tile_cache.h"
 
 class QResizeEvent;
+class QShowEvent;
+class QHideEvent;
+class QPaintEvent;
 class QPainter;
 class QDragEventEvent;
 class QDragLeaveEvent;
@@ -94,6 +103,12 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
          */
         static constexpr unsigned cursorMarginY = 2;
 
+        /**
+         * Indicates the minimum time, in milliseconds, between cursor updates while the mouse is dragged.  Mouse moves
+         * received within this interval are coalesced into a single update.  The value matches a 60Hz display.
+         */
+        static constexpr unsigned dragUpdateIntervalMilliseconds = 16;
+
         /**
          * Constructor.  This version constructs a new-empty document for the editor.
          *
@@ -306,6 +321,32 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
             return !guidesEnabled();
         }
 
+        /**
+         * Method you can use to determine if the cursor and page decorations are drawn on an overlay above a cached
+         * rendering of the scene.
+         *
+         * \return Returns true if the overlay is used.  Returns false if the cursor and page decorations are drawn
+         *         as part of the scene.
+         */
+        bool overlayLayerEnabled() const;
+
+        /**
+         * Method you can use to obtain the number of viewport paint events since the paint statistics were last
+         * reset.
+         *
+         * \return Returns the number of paint events.
+         */
+        unsigned long long numberPaintEvents() const;
+
+        /**
+         * Method you can use to obtain the fraction of time spent painting the viewport since the paint statistics
+         * were last reset.  Time spent outside of viewport paint events, such as scene updates and layout, is not
+         * included.
+         *
+         * \return Returns the fraction of the elapsed wall clock time spent in viewport paint events.
+         */
+        double paintLoad() const;
+
         /**
          * Method you can use to access the cursor.
          *
@@ -1037,6 +1078,21 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
             setGuidesEnabled(!nowDisabled);
         }
 
+        /**
+         * Slot you can use to enable or disable the overlay used to draw the cursor and page decorations.  When the
+         * overlay is enabled, the scene is rendered into a cached layer and cursor blinks and decoration changes only
+         * repaint the overlay.
+         *
+         * \param[in] nowEnabled If true, the overlay will be used.  If false, the cursor and page decorations will be
+         *                       drawn as part of the scene.
+         */
+        void setOverlayLayerEnabled(bool nowEnabled = true);
+
+        /**
+         * Slot you can use to reset the paint statistics.
+         */
+        void resetPaintStatistics();
+
         /**
          * Slot that inserts a new command into the command queue.
          *
@@ -1131,6 +1187,61 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
             bool           okToLoop = true
         );
 
+        /**
+         * Method you can use to locate every match in the document.  The search uses the document's text index
+         * rather than walking the document from the cursor.
+         *
+         * \param[in] searchText        The search text to be located.
+         *
+         * \param[in] caseSensitive     If true, the search will require an exact case match.  If false, the search
+         *                              will ignore case.
+         *
+         * \param[in] wholeWordsOnly    If true, the search will require that the search string represent an entire
+         *                              word or group of words.  Strings making up a part of a word will be
+         *                              ignored.
+         *
+         * \param[in] regularExpression If true, the search string will be treated as a regular expression.  If
+         *                              false, the search string will be treated as normal text.
+         *
+         * \return Returns every match, in document order.
+         */
+        QList<DocumentTextIndex::Match> findAll(
+            const QString& searchText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
+        /**
+         * Slot you can use to replace every match in the document.  All replacements are applied by a single
+         * command so they can be undone in one step and the document is repositioned once.
+         *
+         * \param[in] searchText        The search text to be located.
+         *
+         * \param[in] replacementText   The replacement text.  When performing a regular expression search, the
+         *                              replacement text can reference captured groups.
+         *
+         * \param[in] caseSensitive     If true, the search will require an exact case match.  If false, the search
+         *                              will ignore case.
+         *
+         * \param[in] wholeWordsOnly    If true, the search will require that the search string represent an entire
+         *                              word or group of words.  Strings making up a part of a word will be
+         *                              ignored.
+         *
+         * \param[in] regularExpression If true, the search string will be treated as a regular expression.  If
+         *                              false, the search string will be treated as normal text.
+         *
+         * \return Returns the number of replacements performed.  Matches that span multiple text regions are not
+         *         replaced.
+         */
+        unsigned long replaceAll(
+            const QString& searchText,
+            const QString& replacementText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
         /**
          * Changes the current zoom factor for the editor.
          *
@@ -1155,6 +1266,14 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
          */
         void drawForeground(QPainter* painter, const QRectF& rect) final;
 
+        /**
+         * Method that is triggered when the viewport needs to be repainted.  When the overlay is enabled, this method
+         * updates the cached scene and decoration layers, composites them, and then draws the cursor.
+         *
+         * \param[in] event The event that triggered the call to this method.
+         */
+        void paintEvent(QPaintEvent* event) final;
+
         /**
          * Method that is called when the user drags content into this editor.
          *
@@ -1255,6 +1374,22 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
          */
         void resizeEvent(QResizeEvent* event) final;
 
+        /**
+         * Method that is triggered when the editor is shown.  We overload this method to lay out the document again
+         * if the memory governor released its scene while the editor was hidden.
+         *
+         * \param[in] event The event that triggered the call to this method.
+         */
+        void showEvent(QShowEvent* event) final;
+
+        /**
+         * Method that is triggered when the editor is hidden.  We overload this method to let the memory governor
+         * reclaim the scene of documents that are no longer visible.
+         *
+         * \param[in] event The event that triggered the call to this method.
+         */
+        void hideEvent(QHideEvent* event) final;
+
     private slots:
         /**
          * Slot that is triggered when presentation updates in the document complete.
@@ -1336,6 +1471,16 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
          */
         void blinkCursor();
 
+        /**
+         * Slot that is triggered when the application is idle to replace scaled tiles with sharp tiles.
+         */
+        void refineTiles();
+
+        /**
+         * Slot that is triggered to move the cursor to the most recent mouse position received during a drag.
+         */
+        void applyPendingDrag();
+
     private:
         /**
          * Performs configuration common to all constructors.
@@ -1365,6 +1510,53 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
          */
         void updateCursorPosition();
 
+        /**
+         * Method that schedules a repaint of a region of the scene that only contains the cursor.
+         *
+         * \param[in] sceneRectangle The area to repaint, in scene units.
+         */
+        void updateCursorArea(const QRectF& sceneRectangle);
+
+        /**
+         * Method that determines the area covered by selection rectangles that differ between two cursor updates.
+         * Rectangles common to the start and end of both lists are considered unchanged.
+         *
+         * \param[in] oldRectangles The selection rectangles from the previous update, in document order.
+         *
+         * \param[in] newRectangles The selection rectangles from this update, in document order.
+         *
+         * \return Returns the bounding rectangle of the changed rectangles, in scene units.  A null rectangle is
+         *         returned if no rectangle changed.
+         */
+        static QRectF changedSelectionArea(const QList<QRectF>& oldRectangles, const QList<QRectF>& newRectangles);
+
+        /**
+         * Method that marks a region of the scene as changed in the cached layers.
+         *
+         * \param[in] sceneRectangle        The changed area, in scene units.
+         *
+         * \param[in] invalidateScene       If true, the scene layer will be invalidated.
+         *
+         * \param[in] invalidateDecorations If true, the decoration layer will be invalidated.
+         */
+        void invalidateLayers(
+            const QRectF& sceneRectangle,
+            bool          invalidateScene = true,
+            bool          invalidateDecorations = true
+        );
+
+        /**
+         * Method that adjusts the cached scene and decoration layers to the current viewport size and transform.
+         * Layers are scrolled in place when the transform only changes by a whole pixel translation and are
+         * invalidated otherwise.
+         */
+        void synchronizeLayers();
+
+        /**
+         * Method that brings the cached scene and decoration layers up to date with the current viewport.
+         */
+        void updateLayers();
+
         /**
          * Signal aggregator used to reduce processing overhead for the page format updates.
          */
@@ -1417,6 +1609,26 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
          */
         QRectF previousCursorBoundingRectangle;
 
+        /**
+         * The selection rectangles drawn by the previous cursor update.
+         */
+        QList<QRectF> previousSelectionRectangles;
+
+        /**
+         * Timer used to coalesce cursor updates while the mouse is dragged.
+         */
+        QTimer* dragTimer;
+
+        /**
+         * Flag indicating that a mouse move has been received but not yet applied to the cursor.
+         */
+        bool dragUpdatePending;
+
+        /**
+         * The most recent mouse position received during a drag, in scene coordinates.
+         */
+        QPointF pendingDragPosition;
+
         /**
          * The timer used to blink the cursor.
          */
@@ -1436,6 +1648,56 @@ class APP_PUBLIC_API Editor:public QGraphicsView, private SceneUnits {
          * Indicates the current cursor position type.
          */
         Cursor::Type currentCursorType;
+
+        /**
+         * Flag indicating if the cursor and page decorations are drawn on an overlay.
+         */
+        bool currentOverlayLayerEnabled;
+
+        /**
+         * Flag that is set while the scene layer is being rendered.  Used to suppress foreground drawing.
+         */
+        bool renderingSceneLayer;
+
+        /**
+         * Cached rendering of the scene.
+         */
+        ViewportLayer sceneLayer;
+
+        /**
+         * Cached rendering of the page margins and guides.
+         */
+        ViewportLayer decorationLayer;
+
+        /**
+         * The viewport transform used when the cached layers were last rendered.
+         */
+        QTransform layerTransform;
+
+        /**
+         * Cached tiles of the pages, used to render the scene layer.
+         */
+        SceneTileCache sceneTileCache;
+
+        /**
+         * Zero length timer used to refine scaled tiles while the application is idle.
+         */
+        QTimer* tileRefinementTimer;
+
+        /**
+         * Timer used to measure the elapsed time since the paint statistics were reset.
+         */
+        QElapsedTimer paintStatisticsTimer;
+
+        /**
+         * The number of paint events since the paint statistics were reset.
+         */
+        unsigned long long currentNumberPaintEvents;
+
+        /**
+         * The time spent in paint events since the paint statistics were reset, in nanoseconds.
+         */
+        qint64 currentPaintNanoseconds;
 };
 
 #endif
@@ -294,6 +294,30 @@ class APP_PUBLIC_API FindAndReplaceDialog:public EQt::ProgrammaticDialog {
             bool           regularExpression
         );
 
+        /**
+         * Signal that is emitted when the user clicks the replace all button.
+         *
+         * \param[out] searchText        The text to be located.
+         *
+         * \param[out] replacementText   The text to replace the search text.
+         *
+         * \param[out] caseSensitive     If true, the search should be case sensitive.  If false, the search should
+         *                               case insensitive.
+         *
+         * \param[out] wholeWordsOnly    If true, the search should look for whole words only.  If false, the search
+         *                               can identify text in words.
+         *
+         * \param[out] regularExpression If true, the search should be treated as a regular expression search.  if
+         *                               false, the search should be a normal search.
+         */
+        void replaceAll(
+            const QString& searchText,
+            const QString& replacementText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
         /**
          * Signal that is emitted when the user clicks either the close button or the dialog X in the title bar.
          */
@@ -444,6 +468,11 @@ class APP_PUBLIC_API FindAndReplaceDialog:public EQt::ProgrammaticDialog {
          */
         void replaceAndSearchForwardsButtonClicked();
 
+        /**
+         * Slot that is triggered when the replace all button is clicked.
+         */
+        void replaceAllButtonClicked();
+
         /**
          * Slot that is triggered when the close button is clicked.
          */
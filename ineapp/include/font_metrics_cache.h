@@ -0,0 +1,263 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref FontMetricsCache class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef FONT_METRICS_CACHE_H
+#define FONT_METRICS_CACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QFont>
+#include <QFontMetricsF>
+
+#include "app_common.h"
+
+/**
+ * Class that provides a process-wide cache of fonts and font metrics used during placement.  Presentations rebuild
+ * the same fonts, from the same formats and relative scales, on every placement.  Constructing a QFontMetricsF
+ * instance for each of these forces Qt to re-resolve font engine state so placement code should obtain metrics from
+ * this cache instead.
+ *
+ * Entries are keyed by the font.  Because fonts are derived from the format's font attributes and the relative scale,
+ * the font is a complete key for both.
+ *
+ * The cache holds at most \ref FontMetricsCache::maximumNumberEntries fonts, discarding the least recently used font
+ * when full.  Discarded entries, including those discarded by \ref FontMetricsCache::clear, are only destroyed once
+ * control returns to the event loop so references returned by this class may be held for the duration of a placement.
+ * The cache is intended for use from the thread performing placement.
+ */
+class APP_PUBLIC_API FontMetricsCache {
+    public:
+        /**
+         * Class that holds a single cached font along with its metrics and commonly used advances.
+         */
+        class APP_PUBLIC_API Entry {
+            public:
+                /**
+                 * Constructor
+                 *
+                 * \param[in] font The font to be cached.
+                 */
+                Entry(const QFont& font);
+
+                ~Entry();
+
+                /**
+                 * Method you can use to obtain the cached font.
+                 *
+                 * \return Returns the cached font.
+                 */
+                const QFont& font() const;
+
+                /**
+                 * Method you can use to obtain the font metrics for the cached font.
+                 *
+                 * \return Returns the font metrics.
+                 */
+                const QFontMetricsF& fontMetrics() const;
+
+                /**
+                 * Method you can use to obtain the font ascent.
+                 *
+                 * \return Returns the font ascent, in scene units.
+                 */
+                float ascent() const;
+
+                /**
+                 * Method you can use to obtain the font descent.
+                 *
+                 * \return Returns the font descent, in scene units.
+                 */
+                float descent() const;
+
+                /**
+                 * Method you can use to obtain the font height.
+                 *
+                 * \return Returns the font height, in scene units.
+                 */
+                float height() const;
+
+                /**
+                 * Method you can use to obtain the advance of the letter "M".  The value is commonly used for spacing
+                 * between coefficients and columns.
+                 *
+                 * \return Returns the advance of the letter "M", in scene units.
+                 */
+                float mWidth() const;
+
+                /**
+                 * Method you can use to obtain the advance of a single space.
+                 *
+                 * \return Returns the advance of a space, in scene units.
+                 */
+                float spaceWidth() const;
+
+                /**
+                 * Method you can use to obtain the advance of a short, frequently measured, string such as an
+                 * operator or separator.  Results are remembered so this method should not be used for arbitrary
+                 * text.
+                 *
+                 * \param[in] text The text to be measured.
+                 *
+                 * \return Returns the advance of the text, in scene units.
+                 */
+                float horizontalAdvance(const QString& text) const;
+
+            private:
+                /**
+                 * The maximum number of remembered advances.
+                 */
+                static constexpr int maximumNumberAdvances = 64;
+
+                /**
+                 * The cached font.
+                 */
+                QFont currentFont;
+
+                /**
+                 * The cached font metrics.
+                 */
+                QFontMetricsF currentFontMetrics;
+
+                /**
+                 * The font ascent.
+                 */
+                float currentAscent;
+
+                /**
+                 * The font descent.
+                 */
+                float currentDescent;
+
+                /**
+                 * The font height.
+                 */
+                float currentHeight;
+
+                /**
+                 * The advance of the letter "M".
+                 */
+                float currentMWidth;
+
+                /**
+                 * The advance of a space.
+                 */
+                float currentSpaceWidth;
+
+                /**
+                 * Remembered advances, by string.
+                 */
+                mutable QHash<QString, float> currentAdvances;
+        };
+
+        /**
+         * Method you can use to obtain the cache entry for a font.  The entry is created if needed.
+         *
+         * \param[in] font The font of interest.
+         *
+         * \return Returns a reference to the cache entry.
+         */
+        static const Entry& entry(const QFont& font);
+
+        /**
+         * Convenience method you can use to obtain the font metrics for a font.
+         *
+         * \param[in] font The font of interest.
+         *
+         * \return Returns a reference to the cached font metrics.
+         */
+        static inline const QFontMetricsF& fontMetrics(const QFont& font) {
+            return entry(font).fontMetrics();
+        }
+
+        /**
+         * Method you can use to discard all cache entries and start a new cache generation.  You should call this
+         * method when the available fonts or the screen resolution change.  References previously returned by this
+         * class remain valid until control returns to the event loop.
+         */
+        static void clear();
+
+        /**
+         * Method you can use to obtain the current cache generation.  The generation changes each time
+         * \ref FontMetricsCache::clear is called.
+         *
+         * \return Returns the current cache generation.
+         */
+        static unsigned long generation();
+
+        /**
+         * Method you can use to determine the number of cached fonts.
+         *
+         * \return Returns the number of cached fonts.
+         */
+        static unsigned long numberEntries();
+
+    private:
+        /**
+         * The maximum number of cached fonts.
+         */
+        static constexpr int maximumNumberEntries = 256;
+
+        /**
+         * Class that tracks a cache entry along with when it was last used.
+         */
+        class Slot {
+            public:
+                /**
+                 * The cache entry.
+                 */
+                Entry* entry;
+
+                /**
+                 * The use count value when the entry was last used.
+                 */
+                unsigned long long lastUse;
+        };
+
+        /**
+         * Method that removes the least recently used entry from the cache.
+         */
+        static void evictLeastRecentlyUsed();
+
+        /**
+         * Method that queues an entry to be destroyed once control returns to the event loop.
+         *
+         * \param[in] entry The entry to be destroyed.
+         */
+        static void retire(Entry* entry);
+
+        /**
+         * Method that destroys all retired entries.
+         */
+        static void releaseRetiredEntries();
+
+        /**
+         * The cache entries, by font.
+         */
+        static QHash<QFont, Slot> entries;
+
+        /**
+         * Entries removed from the cache that are waiting to be destroyed.
+         */
+        static QList<Entry*> retiredEntries;
+
+        /**
+         * The current cache generation.
+         */
+        static unsigned long currentGeneration;
+
+        /**
+         * Counter incremented on every lookup.  Used to determine the least recently used entry.
+         */
+        static unsigned long long currentUseCount;
+};
+
+#endif
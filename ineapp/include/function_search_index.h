@@ -0,0 +1,214 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref FunctionSearchIndex class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef FUNCTION_SEARCH_INDEX_H
+#define FUNCTION_SEARCH_INDEX_H
+
+#include <QCoreApplication> // For Q_DECLARE_TR_FUNCTIONS macro.
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QBitArray>
+
+#include <ld_capabilities.h>
+#include <ld_function_data.h>
+
+#include "app_common.h"
+
+/**
+ * Class that maintains a process-wide index of the registered functions.  The index holds the display strings for
+ * every function and function variant and a bitset of the functions in each category so that the function browser
+ * can filter without copying function data.
+ *
+ * Search strings are matched by the function database itself so that results are identical to
+ * Ld::FunctionDatabase::search.  The matches for recently used search strings are retained so that each string is
+ * only looked up once.
+ *
+ * The index is built after the plug-ins are registered and is rebuilt on next use whenever the function database
+ * changes.  Functions are identified by their position in the index.
+ */
+class APP_PUBLIC_API FunctionSearchIndex {
+    Q_DECLARE_TR_FUNCTIONS(FunctionSearchIndex)
+
+    public:
+        /**
+         * Class that holds the precomputed data for a single function.
+         */
+        class Entry {
+            public:
+                /**
+                 * The function data.
+                 */
+                Ld::FunctionData functionData;
+
+                /**
+                 * The rich text used to display the function name.
+                 */
+                QString functionText;
+
+                /**
+                 * The function description.
+                 */
+                QString description;
+
+                /**
+                 * The parameter descriptions for each variant of the function.
+                 */
+                QList<QStringList> variantParameters;
+
+                /**
+                 * The rich text used to display each variant of the function.
+                 */
+                QStringList variantText;
+        };
+
+        /**
+         * The maximum number of search strings whose matches are retained.
+         */
+        static constexpr int maximumCachedSearchStrings = 64;
+
+        /**
+         * Method that builds, or rebuilds, the index from the function database.  You should call this method after
+         * the plug-ins have registered their functions.
+         */
+        static void build();
+
+        /**
+         * Method that discards the index.  The index will be rebuilt on next use.
+         */
+        static void invalidate();
+
+        /**
+         * Method you can use to determine if the index has been rebuilt.  Entry indexes and bitsets obtained before
+         * the generation changed must not be used with the rebuilt index.
+         *
+         * \return Returns a value that changes each time the index is rebuilt.
+         */
+        static unsigned long generation();
+
+        /**
+         * Method you can use to determine the number of indexed functions.
+         *
+         * \return Returns the number of indexed functions.
+         */
+        static unsigned numberEntries();
+
+        /**
+         * Method you can use to obtain the precomputed data for a function.
+         *
+         * \param[in] entryIndex The zero based index of the function.
+         *
+         * \return Returns a reference to the precomputed function data.
+         */
+        static const Entry& entry(unsigned entryIndex);
+
+        /**
+         * Method that determines which functions are available with a given set of capabilities.  This method
+         * queries the function database and should only be called when the capabilities change.
+         *
+         * \param[in] capabilities The capabilities to test against.  Empty capabilities will include all functions.
+         *
+         * \return Returns a bitset holding one bit per indexed function.
+         */
+        static QBitArray capabilityMatches(const Ld::Capabilities& capabilities);
+
+        /**
+         * Method that determines which functions belong to a list of categories.
+         *
+         * \param[in] categories The categories of interest.  An empty list will include all functions.
+         *
+         * \return Returns a bitset holding one bit per indexed function.
+         */
+        static QBitArray categoryMatches(const QList<QString>& categories);
+
+        /**
+         * Method that locates the functions that match a search string.
+         *
+         * \param[in] candidates   Bitset of the functions that can be reported.
+         *
+         * \param[in] searchString The search string, matched as by Ld::FunctionDatabase::search.  An empty search
+         *                         string matches every candidate.
+         *
+         * \return Returns the indexes of the matching functions, in database order.
+         */
+        static QVector<unsigned> search(const QBitArray& candidates, const QString& searchString);
+
+    private:
+        /**
+         * Method that builds the index if needed.
+         */
+        static void ensureBuilt();
+
+        /**
+         * Method that determines which functions match a search string.  Matches are obtained from the function
+         * database and retained for later calls.
+         *
+         * \param[in] searchString The search string.
+         *
+         * \return Returns a bitset holding one bit per indexed function.
+         */
+        static QBitArray searchStringMatches(const QString& searchString);
+
+        /**
+         * Method that calculates all the variants of a given function.
+         *
+         * \param[in] functionData The function data to calculate the variants for.
+         *
+         * \return Returns a list of all the variant descriptions.
+         */
+        static QList<QStringList> variants(const Ld::FunctionData& functionData);
+
+        /**
+         * Method that generates the rich text used to display a function variant.
+         *
+         * \param[in] functionData The function data.
+         *
+         * \param[in] parameters   The parameter descriptions for the variant.
+         *
+         * \return Returns the rich text for the variant.
+         */
+        static QString variantText(const Ld::FunctionData& functionData, const QStringList& parameters);
+
+        /**
+         * Flag indicating if the index is current.
+         */
+        static bool currentlyBuilt;
+
+        /**
+         * The current index generation.
+         */
+        static unsigned long currentGeneration;
+
+        /**
+         * The indexed functions, in database order.
+         */
+        static QList<Entry> entries;
+
+        /**
+         * Map of entry indexes by function command.
+         */
+        static QHash<QString, unsigned> entryIndexByCommand;
+
+        /**
+         * Bitset of the functions in each category.
+         */
+        static QMap<QString, QBitArray> categoryBits;
+
+        /**
+         * Bitset of the matching functions for recently used search strings.
+         */
+        static QHash<QString, QBitArray> searchMatches;
+};
+
+#endif
@@ -0,0 +1,419 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref GraphicsItemPoolBase class and the \ref GraphicsItemPool class template.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef GRAPHICS_ITEM_POOL_H
+#define GRAPHICS_ITEM_POOL_H
+
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QPointer>
+#include <QTimer>
+
+#include <typeinfo>
+
+#include "app_common.h"
+
+class QGraphicsItem;
+
+namespace EQt {
+    class GraphicsTextItem;
+}
+
+/**
+ * Base class for pools of graphics items.  Presentations that rebuild their graphics items frequently, such as
+ * text presentations when lines are re-split, can acquire items from a pool and release items back to the pool rather
+ * than allocating new items and scheduling deferred deletes.
+ *
+ * Released items are handled from the event loop, as a deferred delete would be, so an item can safely be released
+ * while the scene is being iterated or painted.  The item is then removed from its scene and parent, has its children
+ * detached and is reset before being retained.  Pools are bounded.  Items released to a full pool are deleted as
+ * before.
+ *
+ * Only types whose entire state is restored by a \ref GraphicsItemPoolBase::resetItem overload can be pooled.
+ *
+ * Pools are intended for use from the thread performing placement.
+ */
+class APP_PUBLIC_API GraphicsItemPoolBase {
+    public:
+        /**
+         * The default maximum number of items retained by each pool.
+         */
+        static constexpr unsigned defaultMaximumPoolSize = 256;
+
+        /**
+         * Class that holds usage statistics for a single pool.
+         */
+        class APP_PUBLIC_API Statistics {
+            friend class GraphicsItemPoolBase;
+
+            public:
+                Statistics();
+
+                /**
+                 * Copy constructor.
+                 *
+                 * \param[in] other The instance to be copied.
+                 */
+                Statistics(const Statistics& other);
+
+                ~Statistics();
+
+                /**
+                 * Method you can use to obtain the name of the pooled type.
+                 *
+                 * \return Returns the name of the pooled type.
+                 */
+                const QString& typeName() const;
+
+                /**
+                 * Method you can use to obtain the number of items acquired from the pool.
+                 *
+                 * \return Returns the number of acquired items.
+                 */
+                unsigned long long numberAcquisitions() const;
+
+                /**
+                 * Method you can use to obtain the number of acquisitions satisfied by a pooled item.
+                 *
+                 * \return Returns the number of pool hits.
+                 */
+                unsigned long long numberHits() const;
+
+                /**
+                 * Method you can use to obtain the number of items released to the pool.
+                 *
+                 * \return Returns the number of released items.
+                 */
+                unsigned long long numberReleases() const;
+
+                /**
+                 * Method you can use to obtain the number of released items that were deleted rather than retained
+                 * because the pool was full or the item was not of the pooled type.
+                 *
+                 * \return Returns the number of discarded items.
+                 */
+                unsigned long long numberDiscards() const;
+
+                /**
+                 * Method you can use to obtain the number of items currently retained by the pool.
+                 *
+                 * \return Returns the number of retained items.
+                 */
+                unsigned long numberRetained() const;
+
+                /**
+                 * Method you can use to obtain the fraction of acquisitions satisfied by a pooled item.
+                 *
+                 * \return Returns the hit rate, between 0 and 1.
+                 */
+                double hitRate() const;
+
+                /**
+                 * Assignment operator.
+                 *
+                 * \param[in] other The instance to be copied.
+                 *
+                 * \return Returns a reference to this instance.
+                 */
+                Statistics& operator=(const Statistics& other);
+
+            private:
+                /**
+                 * The name of the pooled type.
+                 */
+                QString currentTypeName;
+
+                /**
+                 * The number of acquisitions.
+                 */
+                unsigned long long currentNumberAcquisitions;
+
+                /**
+                 * The number of pool hits.
+                 */
+                unsigned long long currentNumberHits;
+
+                /**
+                 * The number of releases.
+                 */
+                unsigned long long currentNumberReleases;
+
+                /**
+                 * The number of discarded items.
+                 */
+                unsigned long long currentNumberDiscards;
+
+                /**
+                 * The number of retained items.
+                 */
+                unsigned long currentNumberRetained;
+        };
+
+        /**
+         * Method you can use to obtain statistics for every pool that has been used.
+         *
+         * \return Returns a list of statistics, one entry per pool.
+         */
+        static QList<Statistics> statistics();
+
+        /**
+         * Method you can use to delete every retained item in every pool.  Items released but not yet handled by the
+         * event loop are deleted, rather than retained, once they are handled.  Statistics are preserved.
+         */
+        static void clearAll();
+
+    protected:
+        /**
+         * Constructor
+         *
+         * \param[in] typeName The name of the pooled type.
+         */
+        GraphicsItemPoolBase(const QString& typeName);
+
+        virtual ~GraphicsItemPoolBase();
+
+        /**
+         * Method that deletes every retained item and marks every released item not yet handled for deletion.
+         */
+        virtual void clear() = 0;
+
+        /**
+         * Method that obtains the number of retained items.
+         *
+         * \return Returns the number of retained items.
+         */
+        virtual unsigned long numberRetained() const = 0;
+
+        /**
+         * Method that removes an item from its scene and parent and detaches any remaining children.  Children are
+         * left outside of any scene so that their owning presentations can either place them again or delete them.
+         *
+         * \param[in] item The item to be detached.
+         */
+        static void detach(QGraphicsItem* item);
+
+        /**
+         * Method that resets the state common to all graphics items.
+         *
+         * \param[in] item The item to be reset.
+         */
+        static void resetItem(QGraphicsItem* item);
+
+        /**
+         * Method that resets a text item so that it can be reused.
+         *
+         * \param[in] item The item to be reset.
+         */
+        static void resetItem(EQt::GraphicsTextItem* item);
+
+        /**
+         * Method that records an acquisition.
+         *
+         * \param[in] hit If true, the acquisition was satisfied by a pooled item.
+         */
+        inline void recordAcquisition(bool hit) {
+            ++currentStatistics.currentNumberAcquisitions;
+            if (hit) {
+                ++currentStatistics.currentNumberHits;
+            }
+        }
+
+        /**
+         * Method that records a release.
+         *
+         * \param[in] retained If true, the item was retained.  If false, the item was discarded.
+         */
+        inline void recordRelease(bool retained) {
+            ++currentStatistics.currentNumberReleases;
+            if (!retained) {
+                ++currentStatistics.currentNumberDiscards;
+            }
+        }
+
+    private:
+        /**
+         * The statistics for this pool.
+         */
+        Statistics currentStatistics;
+
+        /**
+         * List of every pool that has been constructed.
+         */
+        static QList<GraphicsItemPoolBase*> pools;
+};
+
+/**
+ * Class template that provides a bounded pool of graphics items of a single type.  Only items whose dynamic type
+ * matches the pooled type are retained.  Items of derived types are deleted on release.
+ *
+ * \param T The pooled graphics item type.  A \ref GraphicsItemPoolBase::resetItem overload must exist for the type.
+ */
+template<class T> class GraphicsItemPool:public GraphicsItemPoolBase {
+    public:
+        /**
+         * Method you can use to acquire an item.  A pooled item is returned if available, otherwise a new item is
+         * created.
+         *
+         * \return Returns a detached, reset, item.  The caller takes ownership of the item.
+         */
+        static T* acquire() {
+            GraphicsItemPool<T>& pool = instance();
+
+            T* result;
+            if (pool.items.isEmpty()) {
+                result = new T;
+                pool.recordAcquisition(false);
+            } else {
+                result = pool.items.takeLast();
+                pool.recordAcquisition(true);
+            }
+
+            return result;
+        }
+
+        /**
+         * Method you can use to release an item to the pool.  The item is left untouched until control returns to the
+         * event loop, where it is detached and reset, or deleted if the pool is full.
+         *
+         * \param[in] item The item to be released.  Ownership passes to the pool.
+         */
+        static void release(T* item) {
+            GraphicsItemPool<T>& pool = instance();
+
+            if (pool.releasedItems.isEmpty()) {
+                QTimer::singleShot(0, &GraphicsItemPool<T>::processReleasedItems);
+            }
+
+            pool.releasedItems.append(QPointer<T>(item));
+        }
+
+        /**
+         * Method you can use to change the maximum number of items retained by this pool.  Excess items are deleted.
+         *
+         * \param[in] newMaximumPoolSize The new maximum number of retained items.
+         */
+        static void setMaximumPoolSize(unsigned newMaximumPoolSize) {
+            GraphicsItemPool<T>& pool = instance();
+
+            pool.currentMaximumPoolSize = newMaximumPoolSize;
+            while (static_cast<unsigned>(pool.items.size()) > newMaximumPoolSize) {
+                delete pool.items.takeLast();
+            }
+        }
+
+        /**
+         * Method you can use to determine the maximum number of items retained by this pool.
+         *
+         * \return Returns the maximum number of retained items.
+         */
+        static unsigned maximumPoolSize() {
+            return instance().currentMaximumPoolSize;
+        }
+
+    protected:
+        void clear() override {
+            while (!items.isEmpty()) {
+                delete items.takeLast();
+            }
+
+            numberReleasedToDiscard = releasedItems.size();
+        }
+
+        unsigned long numberRetained() const override {
+            return static_cast<unsigned long>(items.size());
+        }
+
+    private:
+        /**
+         * Constructor
+         */
+        GraphicsItemPool():GraphicsItemPoolBase(QString::fromLatin1(typeid(T).name())) {
+            currentMaximumPoolSize  = defaultMaximumPoolSize;
+            numberReleasedToDiscard = 0;
+        }
+
+        ~GraphicsItemPool() override {}
+
+        /**
+         * Method that retains or deletes the items released since the last call.  Items destroyed in the meantime,
+         * for example along with their scene, are skipped.
+         */
+        static void processReleasedItems() {
+            GraphicsItemPool<T>& pool = instance();
+
+            QVector<QPointer<T>> released;
+            released.swap(pool.releasedItems);
+
+            int numberToDiscard = pool.numberReleasedToDiscard;
+            pool.numberReleasedToDiscard = 0;
+
+            int index = 0;
+            for (  typename QVector<QPointer<T>>::const_iterator it = released.constBegin(), end = released.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                T* item = it->data();
+                if (item != Q_NULLPTR) {
+                    bool retain = (
+                           index >= numberToDiscard
+                        && static_cast<unsigned>(pool.items.size()) < pool.currentMaximumPoolSize
+                        && typeid(*item) == typeid(T)
+                    );
+
+                    if (retain) {
+                        detach(item);
+                        resetItem(item);
+                        pool.items.append(item);
+                    } else {
+                        item->deleteLater();
+                    }
+
+                    pool.recordRelease(retain);
+                }
+
+                ++index;
+            }
+        }
+
+        /**
+         * Method that obtains the pool for this type.  The pool is created on first use.
+         *
+         * \return Returns a reference to the pool.
+         */
+        static GraphicsItemPool<T>& instance() {
+            static GraphicsItemPool<T>* pool = new GraphicsItemPool<T>;
+            return *pool;
+        }
+
+        /**
+         * The retained items.
+         */
+        QVector<T*> items;
+
+        /**
+         * Items released but not yet retained or deleted.
+         */
+        QVector<QPointer<T>> releasedItems;
+
+        /**
+         * The number of released items, from the start of the released item list, to be deleted rather than
+         * retained.
+         */
+        int numberReleasedToDiscard;
+
+        /**
+         * The maximum number of retained items.
+         */
+        unsigned currentMaximumPoolSize;
+};
+
+#endif
@@ -15,6 +15,7 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QList>
 #include <QSharedPointer>
 #include <QSizeF>
 #include <QRectF>
@@ -64,6 +65,12 @@ class APP_PUBLIC_API GroupingOperatorPresentationBase:public PresentationWithFix
          */
         void requestRepositioning(Presentation* childPresentation) override;
 
+        /**
+         * Method you can call to indicate this presentation needs to be repositioned.  A flagged presentation always
+         * rebuilds its graphics item on the next placement pass.
+         */
+        void flagPendingRepositioning() override;
+
         /**
          * Method that is called by a parent to a child to tell the child to start the placement operation,
          * recalculating sizes and positions.  This method will repeatedly call the parent's instance of
@@ -343,6 +350,24 @@ class APP_PUBLIC_API GroupingOperatorPresentationBase:public PresentationWithFix
         void clearChildPresentationAreas();
 
     private:
+        /**
+         * Method that determines if a re-placed child reports the same layout as before.  If so, the child's graphics
+         * items are moved back to their previous positions.
+         *
+         * \param[in] relativeScale The relative scale for this placement pass.
+         *
+         * \return Returns true if the graphics item does not need to be rebuilt.  Returns false if the graphics item
+         *         must be rebuilt.
+         */
+        bool restoreCommittedPlacement(float relativeScale);
+
+        /**
+         * Method that discards the committed child layout and marks the placement as committed.
+         *
+         * \param[in] relativeScale The relative scale used for the committed placement.
+         */
+        void commitPlacement(float relativeScale);
+
         /**
          * The group used to contain this widget.
          */
@@ -362,6 +387,27 @@ class APP_PUBLIC_API GroupingOperatorPresentationBase:public PresentationWithFix
          * The required ascent for the area.
          */
         float requiredAscent;
+
+        /**
+         * Flag indicating that this presentation, rather than just the child, must be repositioned.
+         */
+        bool currentSelfRepositioningPending;
+
+        /**
+         * The relative scale used for the last committed placement.
+         */
+        float committedRelativeScale;
+
+        /**
+         * The last committed layout of the child.  The tracker only holds data if the child has requested
+         * repositioning since the last placement pass.
+         */
+        PresentationAreaTracker committedChildPresentationArea;
+
+        /**
+         * The last committed position of each of the child's presentation areas.
+         */
+        QList<QPointF> committedChildPositions;
 };
 
 #endif
@@ -0,0 +1,334 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref ImageCache class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QSize>
+#include <QSizeF>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSharedPointer>
+#include <QWeakPointer>
+#include <QFutureWatcher>
+
+#include "app_common.h"
+
+/**
+ * Class that decodes embedded images off the GUI thread and shares the decoded images between presentations.
+ *
+ * Images are keyed by a hash of their encoded content so identical images embedded multiple times, or displayed by
+ * multiple views, are decoded once.  The image dimensions are read from the image header so that placement can
+ * proceed immediately.  The full decode, and the construction of a pyramid of progressively halved images, is then
+ * performed by a worker thread.  The first pyramid level is the full decoded image.  Presentations paint using the
+ * pyramid level closest to the resolution of the device being painted.
+ *
+ * Decoded images are retained only while at least one presentation holds a reference to them.  This class is
+ * intended for use from the GUI thread.
+ */
+class APP_PUBLIC_API ImageCache:public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * The largest dimension, in pixels, of the smallest pyramid level.
+         */
+        static constexpr int minimumPyramidDimension = 128;
+
+        /**
+         * Enumeration of image decode states.
+         */
+        enum class State {
+            /**
+             * Indicates the image is being decoded.
+             */
+            PENDING,
+
+            /**
+             * Indicates the image has been decoded.
+             */
+            DECODED,
+
+            /**
+             * Indicates the image could not be decoded.
+             */
+            FAILED
+        };
+
+        /**
+         * Class that holds a single shared image.
+         */
+        class APP_PUBLIC_API Image {
+            friend class ImageCache;
+
+            public:
+                /**
+                 * Constructor
+                 *
+                 * \param[in] contentHash The hash of the encoded image.
+                 *
+                 * \param[in] sizePixels  The full size of the image, in pixels, as reported by the image header.
+                 */
+                Image(const QByteArray& contentHash, const QSize& sizePixels);
+
+                ~Image();
+
+                /**
+                 * Method you can use to obtain the hash of the encoded image.
+                 *
+                 * \return Returns the content hash.
+                 */
+                const QByteArray& contentHash() const;
+
+                /**
+                 * Method you can use to determine the decode state of the image.
+                 *
+                 * \return Returns the decode state.
+                 */
+                State state() const;
+
+                /**
+                 * Method you can use to obtain the full size of the image, as reported by the image header.
+                 *
+                 * \return Returns the full image size, in pixels.
+                 */
+                const QSize& sizePixels() const;
+
+                /**
+                 * Method you can use to obtain the image resolution.  The resolution is only available once the image
+                 * is decoded.
+                 *
+                 * \return Returns the image resolution in dots per point.  An invalid size is returned if the image
+                 *         has not been decoded.
+                 */
+                const QSizeF& dotsPerPoint() const;
+
+                /**
+                 * Method you can use to obtain a description of why the image could not be decoded.
+                 *
+                 * \return Returns an error string.  An empty string is returned if the image was decoded.
+                 */
+                const QString& errorString() const;
+
+                /**
+                 * Method you can use to determine the number of pyramid levels.
+                 *
+                 * \return Returns the number of pyramid levels.  Zero is returned if the image is not decoded.
+                 */
+                unsigned numberLevels() const;
+
+                /**
+                 * Method you can use to obtain the size of a pyramid level.
+                 *
+                 * \param[in] level The zero based pyramid level.  Level 0 is the largest level.
+                 *
+                 * \return Returns the size of the level, in pixels.
+                 */
+                QSize levelSize(unsigned level) const;
+
+                /**
+                 * Method you can use to obtain the image for a pyramid level.
+                 *
+                 * \param[in] level The zero based pyramid level.  Level 0 is the full decoded image.
+                 *
+                 * \return Returns a reference to the image.
+                 */
+                const QImage& levelImage(unsigned level) const;
+
+                /**
+                 * Method you can use to select the smallest pyramid level that is at least a given size.
+                 *
+                 * \param[in] requiredSizePixels The required size, in pixels, in the orientation of the encoded image.
+                 *
+                 * \return Returns the zero based pyramid level.  Level 0 is returned if no level is large enough.
+                 */
+                unsigned levelForSize(const QSizeF& requiredSizePixels) const;
+
+                /**
+                 * Method you can use to obtain a pixmap for a pyramid level.  Pixmaps are created on first use and
+                 * shared by every presentation displaying the image.
+                 *
+                 * \param[in] level The zero based pyramid level.
+                 *
+                 * \return Returns a reference to the pixmap.
+                 */
+                const QPixmap& pixmap(unsigned level);
+
+            private:
+                /**
+                 * The hash of the encoded image.
+                 */
+                QByteArray currentContentHash;
+
+                /**
+                 * The decode state.
+                 */
+                State currentState;
+
+                /**
+                 * The full image size.
+                 */
+                QSize currentSizePixels;
+
+                /**
+                 * The image resolution.
+                 */
+                QSizeF currentDotsPerPoint;
+
+                /**
+                 * The decode error, if any.
+                 */
+                QString currentErrorString;
+
+                /**
+                 * The pyramid levels, largest first.
+                 */
+                QList<QImage> currentLevels;
+
+                /**
+                 * Pixmaps created from the pyramid levels.  Null pixmaps have not yet been created.
+                 */
+                QVector<QPixmap> currentPixmaps;
+        };
+
+        /**
+         * Type used to reference a shared image.
+         */
+        typedef QSharedPointer<Image> ImagePointer;
+
+        /**
+         * Method you can use to obtain the cache instance.  The instance is used to deliver decode notifications.
+         *
+         * \return Returns a pointer to the cache instance.
+         */
+        static ImageCache* instance();
+
+        /**
+         * Method you can use to obtain the shared image for an encoded image.  If the image is not cached, the image
+         * header is read and a decode is started on a worker thread.
+         *
+         * \param[in]  imageData   The encoded image.
+         *
+         * \param[out] errorString A description of why the image header could not be read.
+         *
+         * \return Returns a shared pointer to the image.  A null pointer is returned if the image header could not be
+         *         read.
+         */
+        static ImagePointer image(const QByteArray& imageData, QString& errorString);
+
+        /**
+         * Method you can use to block until every pending decode is complete.  Decode notifications are delivered
+         * before this method returns.  You should call this method before rendering images to a printer or file.
+         */
+        static void waitForPendingDecodes();
+
+        /**
+         * Method you can use to determine the number of images currently held by the cache.
+         *
+         * \return Returns the number of images in use.
+         */
+        static unsigned long numberImages();
+
+    signals:
+        /**
+         * Signal that is emitted when an image has been decoded or has failed to decode.
+         *
+         * \param[out] contentHash The hash of the encoded image.
+         */
+        void imageDecoded(const QByteArray& contentHash);
+
+    private slots:
+        /**
+         * Slot that is triggered when a worker thread completes a decode.
+         */
+        void decodeFinished();
+
+    private:
+        /**
+         * Class that holds the result of a decode operation.
+         */
+        class DecodeResult {
+            public:
+                /**
+                 * Flag indicating if the decode succeeded.
+                 */
+                bool success;
+
+                /**
+                 * The decode error, if any.
+                 */
+                QString errorString;
+
+                /**
+                 * The image resolution, in dots per point.
+                 */
+                QSizeF dotsPerPoint;
+
+                /**
+                 * The pyramid levels, largest first.
+                 */
+                QList<QImage> levels;
+        };
+
+        /**
+         * Type used to watch pending decodes.
+         */
+        typedef QFutureWatcher<DecodeResult> DecodeWatcher;
+
+        ImageCache();
+
+        ~ImageCache() override;
+
+        /**
+         * Method that decodes an image and builds the pyramid.  This method is run on a worker thread.
+         *
+         * \param[in] imageData  The encoded image.
+         *
+         * \param[in] isSvg      If true, the image is an SVG image.
+         *
+         * \param[in] sizePixels The full size of the image.
+         *
+         * \return Returns the decode result.
+         */
+        static DecodeResult decode(const QByteArray& imageData, bool isSvg, const QSize& sizePixels);
+
+        /**
+         * Method that applies a decode result to a cached image and emits the \ref ImageCache::imageDecoded signal.
+         *
+         * \param[in] contentHash The hash of the encoded image.
+         *
+         * \param[in] result      The decode result.
+         */
+        void applyDecodeResult(const QByteArray& contentHash, const DecodeResult& result);
+
+        /**
+         * Method that removes expired images from the cache.
+         */
+        void purgeExpiredImages();
+
+        /**
+         * The cached images, by content hash.
+         */
+        QHash<QByteArray, QWeakPointer<Image>> images;
+
+        /**
+         * Pending decodes, by content hash.
+         */
+        QHash<DecodeWatcher*, QByteArray> pendingDecodes;
+};
+
+#endif
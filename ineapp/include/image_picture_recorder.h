@@ -0,0 +1,120 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref ImagePictureRecorder class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef IMAGE_PICTURE_RECORDER_H
+#define IMAGE_PICTURE_RECORDER_H
+
+#include <QPaintDevice>
+#include <QPaintEngine>
+#include <QPainter>
+#include <QPicture>
+#include <QPixmap>
+#include <QImage>
+#include <QRectF>
+#include <QPointF>
+#include <QPainterPath>
+
+#include "app_common.h"
+
+/**
+ * Class that records painting into a QPicture, storing every pixmap as an image.  Playing a QPicture back creates a
+ * QPixmap for every recorded pixmap, which Qt only supports on the GUI thread.  A picture recorded through this class
+ * only holds images and can be played back onto an image from any thread.
+ *
+ * Text is recorded as filled outlines so the picture is only suitable for raster output.  This class must be used on
+ * the GUI thread.
+ */
+class APP_PUBLIC_API ImagePictureRecorder:public QPaintDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * \param[in] picture The picture to record into.  The picture must outlive any painter active on this device.
+         */
+        ImagePictureRecorder(QPicture* picture);
+
+        ~ImagePictureRecorder() override;
+
+        /**
+         * Method that returns the paint engine used to record into the picture.
+         *
+         * \return Returns a pointer to the paint engine.
+         */
+        QPaintEngine* paintEngine() const override;
+
+    protected:
+        /**
+         * Method that reports the metrics of this device.  The metrics of the underlying picture are reported.
+         *
+         * \param[in] metric The metric of interest.
+         *
+         * \return Returns the requested metric.
+         */
+        int metric(QPaintDevice::PaintDeviceMetric metric) const override;
+
+    private:
+        /**
+         * Paint engine that forwards every operation to a painter on the underlying picture, converting pixmaps to
+         * images.
+         */
+        class Engine:public QPaintEngine {
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * \param[in] picture The picture to record into.
+                 */
+                Engine(QPicture* picture);
+
+                ~Engine() override;
+
+                bool begin(QPaintDevice* device) override;
+                bool end() override;
+                void updateState(const QPaintEngineState& state) override;
+                void drawRects(const QRectF* rectangles, int numberRectangles) override;
+                void drawLines(const QLineF* lines, int numberLines) override;
+                void drawPath(const QPainterPath& path) override;
+                void drawPolygon(const QPointF* points, int numberPoints, PolygonDrawMode mode) override;
+                void drawPixmap(const QRectF& rectangle, const QPixmap& pixmap, const QRectF& sourceRectangle) override;
+
+                void drawImage(
+                    const QRectF&                rectangle,
+                    const QImage&                image,
+                    const QRectF&                sourceRectangle,
+                    Qt::ImageConversionFlags     flags = Qt::AutoColor
+                ) override;
+
+                QPaintEngine::Type type() const override;
+
+            private:
+                /**
+                 * The picture being recorded into.
+                 */
+                QPicture* currentPicture;
+
+                /**
+                 * Painter used to record into the picture.
+                 */
+                QPainter recordingPainter;
+        };
+
+        /**
+         * The picture being recorded into.
+         */
+        QPicture* currentPicture;
+
+        /**
+         * The paint engine for this device.
+         */
+        mutable Engine currentEngine;
+};
+
+#endif
@@ -26,6 +26,7 @@
 
 #include "app_common.h"
 #include "scene_units.h"
+#include "image_cache.h"
 #include "leaf_presentation.h"
 
 namespace EQt {
@@ -281,6 +282,13 @@ class APP_PUBLIC_API ImagePresentation:public LeafPresentation, public virtual L
          */
         virtual void reportPayloadCouldNotBeLoaded();
 
+        /**
+         * Slot that is triggered when the image cache completes decoding an image.
+         *
+         * \param[in] contentHash The hash of the decoded image.
+         */
+        void imageDecoded(const QByteArray& contentHash);
+
     private:
         /**
          * Static value used to indicate the size of an error pixmap, in points.
@@ -347,6 +355,17 @@ class APP_PUBLIC_API ImagePresentation:public LeafPresentation, public virtual L
             float                        otherScaleFactor = 0.0F
         );
 
+        /**
+         * Method that determines the resolution used to size an image.  Images that report no resolution, or whose
+         * resolution is not yet known because they are still being decoded, are sized using
+         * \ref ImagePresentation::defaultDotsPerPoint.
+         *
+         * \param[in] dotsPerPoint The resolution reported for the image, in dots per point.
+         *
+         * \return Returns the resolution to use, in dots per point.
+         */
+        static QSizeF effectiveDotsPerPoint(const QSizeF& dotsPerPoint);
+
         /**
          * Method that loads and properly adjusts the image based on the current format.
          *
@@ -354,6 +373,17 @@ class APP_PUBLIC_API ImagePresentation:public LeafPresentation, public virtual L
          */
         bool loadAndAdjustImage();
 
+        /**
+         * Method that selects the pyramid level used for the graphics item's geometry and updates the graphics item's
+         * pixmap and transform.  The level actually painted is selected by the item when it is painted.
+         *
+         * \param[in] displayedSize      The displayed image size, in scene units.
+         *
+         * \param[in] placementTransform The transform used to scale the full sized, oriented, image to its displayed
+         *                               size.
+         */
+        void updatePixmap(const QSizeF& displayedSize, const QTransform& placementTransform);
+
         /**
          * Method that can be called to clear the list of simple graphics items.
          */
@@ -388,6 +418,36 @@ class APP_PUBLIC_API ImagePresentation:public LeafPresentation, public virtual L
          * A flag that is used to determine if we have a valid image.
          */
         bool currentImageValid;
+
+        /**
+         * The shared, decoded, image.  A null pointer indicates that an error image is being displayed.
+         */
+        ImageCache::ImagePointer currentImage;
+
+        /**
+         * The rotation applied to the image.
+         */
+        Ld::ImageFormat::Rotation currentRotation;
+
+        /**
+         * Transformation that rotates the full sized image into its displayed orientation.
+         */
+        QTransform currentOrientationTransform;
+
+        /**
+         * The displayed image size used to select the current pyramid level.
+         */
+        QSizeF currentDisplayedSize;
+
+        /**
+         * The transform applied during placement.
+         */
+        QTransform currentPlacementTransform;
+
+        /**
+         * The cache key of the pixmap currently assigned to the graphics item.
+         */
+        qint64 currentPixmapKey;
 };
 
 #endif
@@ -0,0 +1,83 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref ImagePyramidItem class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef IMAGE_PYRAMID_ITEM_H
+#define IMAGE_PYRAMID_ITEM_H
+
+#include <QSizeF>
+
+#include <eqt_graphics_pixmap_item.h>
+
+#include "app_common.h"
+#include "image_cache.h"
+
+class QPainter;
+class QPaintDevice;
+class QStyleOptionGraphicsItem;
+class QWidget;
+
+/**
+ * Pixmap item that paints a decoded image using the pyramid level matching the resolution of the device being painted.
+ *
+ * The item's pixmap determines the item's geometry in the item's coordinate system.  When painting, the level is
+ * selected from the painter's device transform so that view zoom and display resolution are accounted for.  Printers,
+ * PDF files, and display lists captured for printing always receive the full decoded image.
+ */
+class APP_PUBLIC_API ImagePyramidItem:public EQt::GraphicsPixmapItem {
+    public:
+        ImagePyramidItem();
+
+        ~ImagePyramidItem() override;
+
+        /**
+         * Method you can use to set the decoded image to be painted.  The image is only painted once it has been
+         * decoded.  Until then, the item's pixmap is painted.
+         *
+         * \param[in] image The shared image.  A null pointer causes the item's pixmap to be painted.
+         */
+        void setImage(ImageCache::ImagePointer image);
+
+        /**
+         * Method you can use to obtain the decoded image being painted.
+         *
+         * \return Returns the shared image.
+         */
+        ImageCache::ImagePointer image() const;
+
+        /**
+         * Method that paints the image.
+         *
+         * \param[in] painter The painter to use to draw the image.
+         *
+         * \param[in] option  Style options for the item.
+         *
+         * \param[in] widget  The widget being painted on.
+         */
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = Q_NULLPTR) override;
+
+    private:
+        /**
+         * Method that determines if a paint device is a printer or a display list that may be played back onto a
+         * printer.
+         *
+         * \param[in] device The device to check.
+         *
+         * \return Returns true if the device should receive the full decoded image.
+         */
+        static bool isPrintingDevice(const QPaintDevice* device);
+
+        /**
+         * The image being painted.
+         */
+        ImageCache::ImagePointer currentImage;
+};
+
+#endif
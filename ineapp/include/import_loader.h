@@ -0,0 +1,292 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref ImportLoader class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef IMPORT_LOADER_H
+#define IMPORT_LOADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QSharedPointer>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+
+#include <ld_element_structures.h>
+#include <ld_plug_in_manager.h>
+#include <ld_root_element.h>
+
+#include "app_common.h"
+
+/**
+ * Class that opens imported documents and maintains a process-wide cache of parsed imports.
+ *
+ * Cache entries are keyed by the canonical path of the imported file and are considered valid only while the file's
+ * modification time matches the time recorded when the file was parsed.  Cached root elements are kept alive after
+ * they are purged from the root element registry so reopening a document, or sharing an import across windows, does
+ * not require the file to be parsed again.
+ *
+ * The cache also records the imports of each parsed file.  Once the import graph below a document is known, the
+ * loader re-registers every reusable cached import and opens every stale or missing import leaves first, so that each
+ * import is registered, and cached, before the documents that depend on it are parsed.
+ *
+ * All parsing is performed on the GUI thread.  Ld opens and registers any import it can not find while parsing a
+ * document and it creates visuals as elements are built, so neither can safely be moved to a worker thread.  The
+ * import graph of a document is only known once the document has been parsed, so a document's first open is resolved
+ * entirely by Ld.
+ */
+class APP_PUBLIC_API ImportLoader {
+    public:
+        /**
+         * The default maximum number of unreferenced imports retained by the cache.
+         */
+        static constexpr int defaultMaximumCachedImports = 64;
+
+        /**
+         * Method you can use to change the maximum number of imports retained by the cache.  Imports that are still
+         * registered are never evicted.
+         *
+         * \param[in] newMaximumCachedImports The new maximum number of cached imports.
+         */
+        static void setMaximumCachedImports(int newMaximumCachedImports);
+
+        /**
+         * Method you can use to determine the maximum number of imports retained by the cache.
+         *
+         * \return Returns the maximum number of cached imports.
+         */
+        static int maximumCachedImports();
+
+        /**
+         * Method that obtains the cache key for a file.
+         *
+         * \param[in] filename The filename of the file.
+         *
+         * \return Returns the canonical path to the file.  The absolute path is returned if the file does not exist.
+         */
+        static QString cacheKey(const QString& filename);
+
+        /**
+         * Method that locates an already parsed root element for a file.  Registered root elements are returned
+         * directly.  Cached root elements are returned, and re-registered, only if the file has not changed since it
+         * was parsed.
+         *
+         * \param[in] filename The filename of the desired file.
+         *
+         * \return Returns the root element for the file.  A null pointer is returned if the file must be parsed.
+         */
+        static QSharedPointer<Ld::RootElement> cachedRootElement(const QString& filename);
+
+        /**
+         * Method that opens an import, using the cache when possible.  The resulting root element is registered and
+         * added to the cache.
+         *
+         * \param[in]  filename    The filename of the import to open.
+         *
+         * \param[out] errorString Optional location to receive a description of any error.
+         *
+         * \return Returns the root element for the import.  A null pointer is returned on error.
+         */
+        static QSharedPointer<Ld::RootElement> openImport(const QString& filename, QString* errorString = Q_NULLPTR);
+
+        /**
+         * Method that opens every stale or missing import below a document, using the import graph recorded by
+         * earlier loads.  Imports are opened in topological order, leaves first, and registered as they are opened.
+         * This method does nothing if the document's imports have not yet been recorded.  Must be called from the
+         * GUI thread.
+         *
+         * \param[in] filename The filename of the document whose imports should be opened.
+         *
+         * \return Returns true if every import was opened or was already available.  Returns false if one or more
+         *         imports could not be opened.
+         */
+        static bool preloadImports(const QString& filename);
+
+        /**
+         * Method that opens a document without consulting the cache and without registering the resulting root
+         * element.  Known imports are opened first, as with \ref preloadImports.  Must be called from the GUI thread
+         * as Ld registers any import it has to open while parsing the document.
+         *
+         * \param[in]  filename      The filename of the document to open.
+         *
+         * \param[in]  plugInsByName The plug-ins used to parse the document.
+         *
+         * \param[out] errorString   Optional location to receive a description of any error.
+         *
+         * \return Returns the root element for the document.  A null pointer is returned on error.
+         */
+        static QSharedPointer<Ld::RootElement> loadDocument(
+            const QString&           filename,
+            const Ld::PlugInsByName& plugInsByName,
+            QString*                 errorString = Q_NULLPTR
+        );
+
+        /**
+         * Method that records a parsed root element, and every root element it depends on, in the cache.  You should
+         * call this method after a document is opened or saved.
+         *
+         * \param[in] rootElement The root element to be recorded.
+         */
+        static void updateCache(QSharedPointer<Ld::RootElement> rootElement);
+
+        /**
+         * Method that removes a file from the cache.
+         *
+         * \param[in] filename The filename of the file to remove.
+         */
+        static void invalidate(const QString& filename);
+
+        /**
+         * Method that removes every entry from the cache.
+         */
+        static void clear();
+
+    private:
+        /**
+         * Class used to track a single cached import.
+         */
+        class Entry {
+            public:
+                /**
+                 * The modification time of the file when it was parsed.
+                 */
+                QDateTime lastModified;
+
+                /**
+                 * The parsed root element.
+                 */
+                QSharedPointer<Ld::RootElement> rootElement;
+
+                /**
+                 * Value used to determine the least recently used entry.
+                 */
+                unsigned long long lastUsed;
+        };
+
+        /**
+         * Class used to track the imports of a file.  Records outlive cache entries so that the import graph is still
+         * known after an entry is evicted.
+         */
+        class ImportRecord {
+            public:
+                /**
+                 * The modification time of the file when its imports were recorded.
+                 */
+                QDateTime lastModified;
+
+                /**
+                 * The cache keys of the files directly imported by this file.
+                 */
+                QStringList importKeys;
+        };
+
+        /**
+         * Class used to track a single load.
+         */
+        class LoadJob {
+            public:
+                /**
+                 * The cache key of the file to be loaded.
+                 */
+                QString key;
+
+                /**
+                 * The plug-ins used to parse the file.
+                 */
+                Ld::PlugInsByName plugInsByName;
+
+                /**
+                 * The loaded root element.
+                 */
+                QSharedPointer<Ld::RootElement> rootElement;
+
+                /**
+                 * The reported error, if any.
+                 */
+                QString errorString;
+        };
+
+        /**
+         * Method that performs a single load.
+         *
+         * \param[in,out] job The job to be performed.
+         */
+        static void performLoad(LoadJob& job);
+
+        /**
+         * Method that determines if a cache entry is still valid.  Assumes the cache mutex is locked.
+         *
+         * \param[in] key The cache key of the entry.
+         *
+         * \return Returns true if the entry exists and the file has not changed since it was parsed.
+         */
+        static bool entryIsCurrent(const QString& key);
+
+        /**
+         * Method that re-registers a cached root element.  Entries whose root element is closed or holds unsaved
+         * modifications are discarded instead.  Assumes the cache mutex is locked.
+         *
+         * \param[in] key The cache key of the entry.
+         *
+         * \return Returns the re-registered root element.  A null pointer is returned if the entry can not be reused.
+         */
+        static QSharedPointer<Ld::RootElement> reuseEntry(const QString& key);
+
+        /**
+         * Method that determines if the recorded imports of a file are still valid.  Assumes the cache mutex is
+         * locked.
+         *
+         * \param[in] key The cache key of the file.
+         *
+         * \return Returns true if the imports were recorded and the file has not changed since.
+         */
+        static bool importsAreCurrent(const QString& key);
+
+        /**
+         * Method that records a single root element.  Assumes the cache mutex is locked.
+         *
+         * \param[in] rootElement The root element to be recorded.
+         */
+        static void recordEntry(QSharedPointer<Ld::RootElement> rootElement);
+
+        /**
+         * Method that evicts least recently used, unregistered entries until the cache is within its limit.  Assumes
+         * the cache mutex is locked.
+         */
+        static void trimCache();
+
+        /**
+         * Mutex used to guard the cache.
+         */
+        static QMutex cacheMutex;
+
+        /**
+         * The cache entries, by cache key.
+         */
+        static QMap<QString, Entry> entries;
+
+        /**
+         * The recorded imports, by cache key.
+         */
+        static QMap<QString, ImportRecord> importRecords;
+
+        /**
+         * Counter used to order cache entries by use.
+         */
+        static unsigned long long useCounter;
+
+        /**
+         * The current maximum number of unreferenced cached imports.
+         */
+        static int currentMaximumCachedImports;
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref InspectorCellCache class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef INSPECTOR_CELL_CACHE_H
+#define INSPECTOR_CELL_CACHE_H
+
+#include <QString>
+#include <QCache>
+#include <QSet>
+
+#include <util_hash_functions.h>
+
+#include "app_common.h"
+
+/**
+ * Class that provides a small least-recently-used cache of formatted cell strings for the inspector models.  Entries
+ * are keyed by row, column and a format identifier so that a model can hold, for example, both the display and edit
+ * representation of a cell.
+ *
+ * Views only request data for the cells they paint so the cache naturally holds the visible region plus whatever was
+ * recently scrolled past.
+ */
+class APP_PUBLIC_API InspectorCellCache {
+    public:
+        /**
+         * The default maximum number of cached cells.
+         */
+        static constexpr int defaultMaximumNumberEntries = 16384;
+
+        /**
+         * Constructor
+         *
+         * \param[in] maximumNumberEntries The maximum number of formatted cells to retain.
+         */
+        InspectorCellCache(int maximumNumberEntries = defaultMaximumNumberEntries);
+
+        ~InspectorCellCache();
+
+        /**
+         * Method you can use to change the maximum number of cached cells.
+         *
+         * \param[in] newMaximumNumberEntries The new maximum number of formatted cells to retain.
+         */
+        void setMaximumNumberEntries(int newMaximumNumberEntries);
+
+        /**
+         * Method you can use to determine the maximum number of cached cells.
+         *
+         * \return Returns the maximum number of cached cells.
+         */
+        int maximumNumberEntries() const;
+
+        /**
+         * Method you can use to locate a formatted cell.  A successful lookup marks the entry as most recently used.
+         *
+         * \param[in]  rowIndex    The zero based row index of the cell.
+         *
+         * \param[in]  columnIndex The zero based column index of the cell.
+         *
+         * \param[in]  format      The format identifier for the cell.
+         *
+         * \param[out] text        The formatted text.  The value is unchanged if the cell is not cached.
+         *
+         * \return Returns true if the cell was cached.  Returns false if the cell was not cached.
+         */
+        bool lookup(unsigned long rowIndex, unsigned long columnIndex, unsigned format, QString& text) const;
+
+        /**
+         * Method you can use to add a formatted cell to the cache.  The least recently used entry will be evicted if
+         * the cache is full.
+         *
+         * \param[in] rowIndex    The zero based row index of the cell.
+         *
+         * \param[in] columnIndex The zero based column index of the cell.
+         *
+         * \param[in] format      The format identifier for the cell.
+         *
+         * \param[in] text        The formatted text.
+         */
+        void insert(unsigned long rowIndex, unsigned long columnIndex, unsigned format, const QString& text);
+
+        /**
+         * Method you can use to remove every format of a single cell from the cache.
+         *
+         * \param[in] rowIndex    The zero based row index of the cell.
+         *
+         * \param[in] columnIndex The zero based column index of the cell.
+         */
+        void invalidate(unsigned long rowIndex, unsigned long columnIndex);
+
+        /**
+         * Method you can use to remove every entry from the cache.
+         */
+        void clear();
+
+        /**
+         * Method you can use to determine the number of cached cells.
+         *
+         * \return Returns the number of cached cells.
+         */
+        int size() const;
+
+    private:
+        /**
+         * Trivial class used as a key into the cache.
+         */
+        class Key {
+            public:
+                Key(unsigned long newRowIndex, unsigned long newColumnIndex, unsigned newFormat);
+
+                bool operator==(const Key& other) const;
+
+                friend Util::HashResult qHash(const Key& key, Util::HashSeed seed) {
+                    return ::qHash(key.rowIndex, seed) ^ ::qHash(key.columnIndex, seed) ^ ::qHash(key.format, seed);
+                }
+
+                unsigned long rowIndex;
+                unsigned long columnIndex;
+                unsigned      format;
+        };
+
+        /**
+         * The underlying LRU cache.  Declared mutable so that lookups can update the recently used order.
+         */
+        mutable QCache<Key, QString> cache;
+
+        /**
+         * The set of format identifiers currently in use.  Used to invalidate every format of a cell.
+         */
+        QSet<unsigned> formats;
+};
+
+#endif
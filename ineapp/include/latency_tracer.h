@@ -0,0 +1,291 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref LatencyTracer class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef LATENCY_TRACER_H
+#define LATENCY_TRACER_H
+
+#include <QString>
+#include <QRect>
+#include <QRectF>
+
+#include "app_common.h"
+
+class QGraphicsView;
+class RootPresentation;
+
+/**
+ * Class that traces the latency between user input and the paint that displays the result.  When enabled, the tracer
+ * timestamps each input event, the execution of the command issued in response, the start and end of the repositioning
+ * pass that places the change and the first paint that covers the cursor once placement is complete.
+ *
+ * Inputs that arrive before a repositioning pass starts are placed by the same pass and are traced individually so
+ * that coalesced typing is reported the way the user experiences it.  Inputs that issue no command, such as cursor
+ * movement, complete at the first paint that covers the cursor.
+ *
+ * Each document keeps a rolling window of recent samples, used to calculate percentiles, and a histogram of every
+ * sample with logarithmically sized buckets.  Documents that are closed retain their data until the tracer is reset.
+ *
+ * The tracer is disabled by default.  When disabled, each hook costs a single test of a static flag.  The tracer is
+ * intended for use from the GUI thread.
+ */
+class APP_PUBLIC_API LatencyTracer {
+    public:
+        /**
+         * The number of recent samples used to calculate percentiles.
+         */
+        static constexpr unsigned rollingWindowSize = 1024;
+
+        /**
+         * The maximum number of incomplete traces held per document.  Older traces are abandoned if input arrives
+         * faster than it can be displayed for longer than this.
+         */
+        static constexpr unsigned maximumPendingTraces = 256;
+
+        /**
+         * The number of histogram buckets.  Bucket N holds samples below 2^N microseconds.  The last bucket holds
+         * every larger sample.
+         */
+        static constexpr unsigned numberHistogramBuckets = 24;
+
+        /**
+         * Enumeration of traced stages.
+         */
+        enum class Stage {
+            /**
+             * Indicates the time from the input event to the end of command execution.
+             */
+            INPUT_TO_COMMAND,
+
+            /**
+             * Indicates the time from the end of command execution, or the input event, to the start of placement.
+             */
+            COMMAND_TO_PLACEMENT,
+
+            /**
+             * Indicates the time spent in repositioning passes.
+             */
+            PLACEMENT,
+
+            /**
+             * Indicates the time from the end of placement, or the input event, to the paint.
+             */
+            PLACEMENT_TO_PAINT,
+
+            /**
+             * Indicates the time from the input event to the paint.
+             */
+            INPUT_TO_PAINT,
+
+            /**
+             * Value used to indicate the number of stages.
+             */
+            NUMBER_STAGES
+        };
+
+        /**
+         * Method you can use to determine if the tracer is enabled.
+         *
+         * \return Returns true if the tracer is enabled.  Returns false if the tracer is disabled.
+         */
+        static inline bool isEnabled() {
+            return currentEnabled;
+        }
+
+        /**
+         * Method you can use to enable or disable the tracer.  Disabling the tracer discards incomplete traces but
+         * retains collected data.
+         *
+         * \param[in] nowEnabled If true, the tracer will be enabled.  If false, the tracer will be disabled.
+         */
+        static void setEnabled(bool nowEnabled = true);
+
+        /**
+         * Method you can use to discard all collected data.
+         */
+        static void reset();
+
+        /**
+         * Method that is called when an editor receives an input event.
+         *
+         * \param[in] rootPresentation The document receiving the input.
+         */
+        static inline void inputReceived(const RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordInputReceived(rootPresentation);
+            }
+        }
+
+        /**
+         * Method that is called when an editor has executed a command.
+         *
+         * \param[in] rootPresentation The document the command was issued against.
+         */
+        static inline void commandExecuted(const RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordCommandExecuted(rootPresentation);
+            }
+        }
+
+        /**
+         * Method that is called when the root presentation starts a repositioning pass.
+         *
+         * \param[in] rootPresentation The document being placed.
+         */
+        static inline void placementStarted(const RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordPlacementStarted(rootPresentation);
+            }
+        }
+
+        /**
+         * Method that is called when the root presentation completes a repositioning pass.
+         *
+         * \param[in] rootPresentation The document being placed.
+         */
+        static inline void placementCompleted(const RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordPlacementCompleted(rootPresentation);
+            }
+        }
+
+        /**
+         * Method that is called when an editor has painted its viewport.
+         *
+         * \param[in] rootPresentation       The document being displayed.
+         *
+         * \param[in] view                   The view that was painted.
+         *
+         * \param[in] paintedRectangle       The painted area, in viewport coordinates.
+         *
+         * \param[in] affectedSceneRectangle The area that must be painted to display the result of the input, in scene
+         *                                   coordinates.  An empty rectangle indicates any paint suffices.
+         */
+        static inline void paintCompleted(
+                const RootPresentation* rootPresentation,
+                const QGraphicsView*    view,
+                const QRect&            paintedRectangle,
+                const QRectF&           affectedSceneRectangle
+            ) {
+            if (currentEnabled) {
+                recordPaintCompleted(rootPresentation, view, paintedRectangle, affectedSceneRectangle);
+            }
+        }
+
+        /**
+         * Method that is called when a document is destroyed.  The document's data is retained under its last known
+         * name.
+         *
+         * \param[in] rootPresentation The document being destroyed.
+         */
+        static inline void documentClosed(const RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordDocumentClosed(rootPresentation);
+            }
+        }
+
+        /**
+         * Method you can use to obtain the number of completed traces for an open document.
+         *
+         * \param[in] rootPresentation The document of interest.
+         *
+         * \return Returns the number of completed traces.
+         */
+        static unsigned long long numberTraces(const RootPresentation* rootPresentation);
+
+        /**
+         * Method you can use to obtain a percentile over the rolling window for an open document.
+         *
+         * \param[in] rootPresentation The document of interest.
+         *
+         * \param[in] stage            The stage of interest.
+         *
+         * \param[in] percentile       The percentile, from 0 to 100.
+         *
+         * \return Returns the latency at the requested percentile, in nanoseconds.  Zero is returned if no samples
+         *         have been collected.
+         */
+        static unsigned long long percentileNanoseconds(
+            const RootPresentation* rootPresentation,
+            Stage                   stage,
+            double                  percentile
+        );
+
+        /**
+         * Method you can use to write the collected data to a file, in JSON format.  The report includes the 50th,
+         * 90th, 99th percentile and maximum latency of each stage for every document along with the histograms.
+         *
+         * \param[in] filename The file to be written.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        static bool writeReport(const QString& filename);
+
+    private:
+        /**
+         * Method that records an input event.
+         *
+         * \param[in] rootPresentation The document receiving the input.
+         */
+        static void recordInputReceived(const RootPresentation* rootPresentation);
+
+        /**
+         * Method that records command execution.
+         *
+         * \param[in] rootPresentation The document the command was issued against.
+         */
+        static void recordCommandExecuted(const RootPresentation* rootPresentation);
+
+        /**
+         * Method that records the start of a repositioning pass.
+         *
+         * \param[in] rootPresentation The document being placed.
+         */
+        static void recordPlacementStarted(const RootPresentation* rootPresentation);
+
+        /**
+         * Method that records the end of a repositioning pass.
+         *
+         * \param[in] rootPresentation The document being placed.
+         */
+        static void recordPlacementCompleted(const RootPresentation* rootPresentation);
+
+        /**
+         * Method that records a paint.
+         *
+         * \param[in] rootPresentation       The document being displayed.
+         *
+         * \param[in] view                   The view that was painted.
+         *
+         * \param[in] paintedRectangle       The painted area, in viewport coordinates.
+         *
+         * \param[in] affectedSceneRectangle The area that must be painted, in scene coordinates.
+         */
+        static void recordPaintCompleted(
+            const RootPresentation* rootPresentation,
+            const QGraphicsView*    view,
+            const QRect&            paintedRectangle,
+            const QRectF&           affectedSceneRectangle
+        );
+
+        /**
+         * Method that records a document being destroyed.
+         *
+         * \param[in] rootPresentation The document being destroyed.
+         */
+        static void recordDocumentClosed(const RootPresentation* rootPresentation);
+
+        /**
+         * Flag indicating if the tracer is enabled.
+         */
+        static bool currentEnabled;
+};
+
+#endif
@@ -14,6 +14,8 @@
 
 #include <QObject>
 #include <QList>
+#include <QSizeF>
+#include <QPointF>
 
 #include <eqt_graphics_math_group.h>
 
@@ -53,6 +55,12 @@ class APP_PUBLIC_API ListPresentationBase:public PresentationWithPositionalChild
          */
         void requestRepositioning(Presentation* childPresentation) override;
 
+        /**
+         * Method you can call to indicate this presentation needs to be repositioned.  A flagged presentation always
+         * rebuilds its graphics item on the next placement pass.
+         */
+        void flagPendingRepositioning() override;
+
         /**
          * Method that is called by a parent to a child to tell the child to start the placement operation,
          * recalculating sizes and positions.  This method will repeatedly call the parent's instance of
@@ -400,6 +408,30 @@ class APP_PUBLIC_API ListPresentationBase:public PresentationWithPositionalChild
         void processChildPresentationInsertedAfter(unsigned long childIndex, Presentation* childPresentation) override;
 
     private:
+        /**
+         * Method that determines if every child reports the same layout as when we last committed our placement.  If
+         * so, the children's graphics items are moved back to their previous positions.
+         *
+         * \param[in] minimumTopSpacing The minimum top spacing for this placement pass.
+         *
+         * \param[in] relativeScale     The relative scale for this placement pass.
+         *
+         * \return Returns true if the graphics item does not need to be rebuilt.  Returns false if the graphics item
+         *         must be rebuilt.
+         */
+        bool restoreCommittedPlacement(float minimumTopSpacing, float relativeScale);
+
+        /**
+         * Method that records the current placement so that later placement passes can be compared against it.
+         *
+         * \param[in] size              The size of this presentation.
+         *
+         * \param[in] minimumTopSpacing The minimum top spacing used for the placement.
+         *
+         * \param[in] relativeScale     The relative scale used for the placement.
+         */
+        void commitPlacement(const QSizeF& size, float minimumTopSpacing, float relativeScale);
+
         /**
          * The child presentation areas.
          */
@@ -414,6 +446,41 @@ class APP_PUBLIC_API ListPresentationBase:public PresentationWithPositionalChild
          * The graphics item.
          */
         EQt::GraphicsMathGroup* currentGraphicsItem;
+
+        /**
+         * Flag indicating that this presentation, rather than just one or more children, must be repositioned.
+         */
+        bool currentSelfRepositioningPending;
+
+        /**
+         * Flag indicating that a child has requested repositioning since the last placement pass.
+         */
+        bool currentChildRepositioningPending;
+
+        /**
+         * The size reported for the last committed placement.
+         */
+        QSizeF committedSize;
+
+        /**
+         * The minimum top spacing used for the last committed placement.
+         */
+        float committedMinimumTopSpacing;
+
+        /**
+         * The relative scale used for the last committed placement.
+         */
+        float committedRelativeScale;
+
+        /**
+         * The child layouts from the last committed placement.
+         */
+        QList<PresentationAreaTracker> committedChildPresentationAreas;
+
+        /**
+         * The position of each child's presentation areas from the last committed placement.
+         */
+        QList<QList<QPointF>> committedChildPositions;
 };
 
 #endif
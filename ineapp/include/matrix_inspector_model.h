@@ -19,6 +19,8 @@
 
 #include <ld_calculated_value.h>
 
+#include "inspector_cell_cache.h"
+
 /**
  * Class that provides a base class for the matrix inspector models.  You can extend this class to customize it for
  * specific data types.
@@ -307,6 +309,19 @@ class MatrixInspectorModel:public QAbstractTableModel {
          * \return Returns true on success, returns false on error.
          */
         virtual bool insertMatrixRows(int row, int rowCount) = 0;
+
+    private slots:
+        /**
+         * Slot that discards all cached cell text.  Triggered whenever the model is reset.
+         */
+        void clearCellCache();
+
+    private:
+        /**
+         * Cache of formatted cell text, keyed by row, column and display role.  Cells are only formatted when a view
+         * requests them so large matrices never pay the formatting cost for cells that are not displayed.
+         */
+        mutable InspectorCellCache cellCache;
 };
 
 #endif
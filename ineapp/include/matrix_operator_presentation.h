@@ -14,11 +14,13 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
 
 #include <ld_format_structures.h>
 #include <ld_matrix_operator_visual.h>
 
 #include "app_common.h"
+#include "maximum_tracker.h"
 #include "matrix_operator_presentation_base.h"
 #include "presentation_with_grid_children.h"
 
@@ -32,6 +34,10 @@ namespace Ld {
  * This class provides a presentation for the Ld::MatrixOperatorElement class.  Note that this class' inheritance is
  * rather odd in that it inherits from \ref PresentationWithFixedChildren rather than the more expected
  * \ref PresentationWithGridChildren class.
+ *
+ * The grid is laid out incrementally.  Row and column extents are tracked by \ref MaximumTracker instances so a change
+ * to a single coefficient only updates the extents of its row and column and only coefficients whose row or column
+ * moved are repositioned.  Inserting or removing rows or columns forces a full layout.
  */
 class APP_PUBLIC_API MatrixOperatorPresentation:public         MatrixOperatorPresentationBase,
                                                 public virtual Ld::MatrixOperatorVisual {
@@ -273,6 +279,84 @@ class APP_PUBLIC_API MatrixOperatorPresentation:public         MatrixOperatorPre
          * Method that is called to trigger repositioning of this element.
          */
         void forceRepositioning();
+
+        /**
+         * Method that is called to force every coefficient to be measured and positioned on the next layout pass.
+         */
+        void forceFullLayout();
+
+        /**
+         * Method that records the extents of a single coefficient in the row and column trackers.
+         *
+         * \param[in] childPresentationAreaData The presentation areas of every coefficient.
+         *
+         * \param[in] childIndex                The zero based index of the coefficient, in row major order.
+         *
+         * \param[in] numberColumns             The number of columns in the matrix.
+         */
+        void updateCoefficientExtents(
+            const QList<PresentationAreaTracker>& childPresentationAreaData,
+            unsigned long                         childIndex,
+            unsigned long                         numberColumns
+        );
+
+        /**
+         * Method that positions a single coefficient using the row and column edges from the current layout pass.
+         *
+         * \param[in] childPresentationAreaData The presentation areas of every coefficient.
+         *
+         * \param[in] childIndex                The zero based index of the coefficient, in row major order.
+         *
+         * \param[in] numberColumns             The number of columns in the matrix.
+         *
+         * \param[in] graphicsItem              The graphics item to receive the coefficient.
+         */
+        void placeCoefficient(
+            const QList<PresentationAreaTracker>& childPresentationAreaData,
+            unsigned long                         childIndex,
+            unsigned long                         numberColumns,
+            EQt::GraphicsMathGroup*               graphicsItem
+        );
+
+        /**
+         * Flag indicating that the next layout pass must measure and position every coefficient.
+         */
+        bool fullLayoutNeeded;
+
+        /**
+         * Trackers holding the width of every coefficient, one tracker per column, indexed by row.
+         */
+        QVector<MaximumTracker> columnWidthTrackers;
+
+        /**
+         * Trackers holding the ascent of every coefficient, one tracker per row, indexed by column.
+         */
+        QVector<MaximumTracker> rowAscentTrackers;
+
+        /**
+         * Trackers holding the descent of every coefficient, one tracker per row, indexed by column.
+         */
+        QVector<MaximumTracker> rowDescentTrackers;
+
+        /**
+         * The left edge of every column from the last layout pass.
+         */
+        QVector<float> currentColumnLeftEdges;
+
+        /**
+         * The width of every column from the last layout pass.
+         */
+        QVector<float> currentColumnWidths;
+
+        /**
+         * The top edge of every row from the last layout pass.
+         */
+        QVector<float> currentRowTopEdges;
+
+        /**
+         * The ascent of every row from the last layout pass.
+         */
+        QVector<float> currentRowAscents;
 };
 
 #endif
@@ -0,0 +1,109 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref MaximumTracker class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef MAXIMUM_TRACKER_H
+#define MAXIMUM_TRACKER_H
+
+#include <QVector>
+
+#include "app_common.h"
+
+/**
+ * Class that tracks the maximum of a fixed length list of non-negative values.  Values are held in the leaves of a
+ * binary tree so changing a single value and recalculating the maximum both take O(log n) time.
+ *
+ * Grid layouts use this class to track row and column extents so a change to a single cell does not require the
+ * extents of every cell in the row and column to be revisited.
+ */
+class APP_PUBLIC_API MaximumTracker {
+    public:
+        MaximumTracker();
+
+        /**
+         * Constructor.
+         *
+         * \param[in] numberValues The number of values to be tracked.  All values are initially zero.
+         */
+        MaximumTracker(unsigned long numberValues);
+
+        /**
+         * Copy constructor.
+         *
+         * \param[in] other The instance to be copied.
+         */
+        MaximumTracker(const MaximumTracker& other);
+
+        ~MaximumTracker();
+
+        /**
+         * Method you can use to change the number of tracked values.  All values are reset to zero.
+         *
+         * \param[in] numberValues The new number of values.
+         */
+        void resize(unsigned long numberValues);
+
+        /**
+         * Method you can use to obtain the number of tracked values.
+         *
+         * \return Returns the number of tracked values.
+         */
+        unsigned long size() const;
+
+        /**
+         * Method you can use to update a single value.
+         *
+         * \param[in] index    The zero based index of the value to be updated.
+         *
+         * \param[in] newValue The new value.
+         *
+         * \return Returns true if the maximum changed.  Returns false if the maximum is unchanged.
+         */
+        bool setValue(unsigned long index, float newValue);
+
+        /**
+         * Method you can use to obtain a single value.
+         *
+         * \param[in] index The zero based index of the desired value.
+         *
+         * \return Returns the requested value.
+         */
+        float value(unsigned long index) const;
+
+        /**
+         * Method you can use to obtain the maximum value.
+         *
+         * \return Returns the maximum of all values.  A value of zero is returned if no values are tracked.
+         */
+        float maximum() const;
+
+        /**
+         * Assignment operator.
+         *
+         * \param[in] other The instance to be copied.
+         *
+         * \return Returns a reference to this instance.
+         */
+        MaximumTracker& operator=(const MaximumTracker& other);
+
+    private:
+        /**
+         * The number of tracked values.
+         */
+        unsigned long currentSize;
+
+        /**
+         * The tree nodes.  Node 1 is the root, node n holds the larger of nodes 2n and 2n+1.  The values are held
+         * in the last \ref MaximumTracker::currentSize entries.  Entry 0 is unused.
+         */
+        QVector<float> currentNodes;
+};
+
+#endif
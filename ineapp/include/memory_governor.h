@@ -0,0 +1,210 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref MemoryGovernor class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef MEMORY_GOVERNOR_H
+#define MEMORY_GOVERNOR_H
+
+#include <QString>
+
+#include "app_common.h"
+
+class RootPresentation;
+
+/**
+ * Class that limits the memory held by the scenes of open documents.  The governor tracks an estimate of the scene
+ * memory used by each document.  When the total exceeds the configured budget, the governor releases the graphics
+ * items and pixmaps of documents whose editors are all hidden, least recently shown first, until the total is within
+ * budget.  The element tree of a released document is kept.  A released document is laid out again when one of its
+ * editors is shown.  The graphics item pools are trimmed after documents are released so that released items are
+ * deleted rather than retained for reuse.
+ *
+ * Documents with no editor, such as imports and documents loaded for export, are never released.
+ *
+ * The governor tracks the memory reclaimed and the time needed to restore each document.  The governor is enabled by
+ * default and is intended for use from the GUI thread.
+ */
+class APP_PUBLIC_API MemoryGovernor {
+    public:
+        /**
+         * The default scene memory budget, in bytes.
+         */
+        static constexpr unsigned long long defaultBudgetBytes = 1024ULL * 1024ULL * 1024ULL;
+
+        /**
+         * Method you can use to determine if the governor is enabled.
+         *
+         * \return Returns true if the governor is enabled.  Returns false if the governor is disabled.
+         */
+        static inline bool isEnabled() {
+            return currentEnabled;
+        }
+
+        /**
+         * Method you can use to enable or disable the governor.  Disabling the governor does not restore released
+         * documents.  Released documents are still restored when shown.
+         *
+         * \param[in] nowEnabled If true, the governor will be enabled.  If false, the governor will be disabled.
+         */
+        static void setEnabled(bool nowEnabled = true);
+
+        /**
+         * Method you can use to set the scene memory budget.  The budget is enforced the next time an editor is
+         * hidden or a document finishes repositioning.
+         *
+         * \param[in] newBudgetBytes The new budget, in bytes.
+         */
+        static void setBudgetBytes(unsigned long long newBudgetBytes);
+
+        /**
+         * Method you can use to obtain the scene memory budget.
+         *
+         * \return Returns the budget, in bytes.
+         */
+        static unsigned long long budgetBytes();
+
+        /**
+         * Method you can use to obtain the most recent estimate of the scene memory used by every open document.
+         *
+         * \return Returns the estimated scene memory, in bytes.
+         */
+        static unsigned long long sceneBytesInUse();
+
+        /**
+         * Method you can use to obtain the number of times a document has been released.
+         *
+         * \return Returns the number of releases.
+         */
+        static unsigned long numberReleases();
+
+        /**
+         * Method you can use to obtain the total memory reclaimed by releasing documents.
+         *
+         * \return Returns the reclaimed memory, in bytes.
+         */
+        static unsigned long long bytesReclaimed();
+
+        /**
+         * Method you can use to obtain the number of completed restores.
+         *
+         * \return Returns the number of restores.
+         */
+        static unsigned long numberRestores();
+
+        /**
+         * Method you can use to obtain the total time spent restoring released documents.
+         *
+         * \return Returns the time from the editor being shown to the document being laid out, summed over every
+         *         restore, in nanoseconds.
+         */
+        static unsigned long long restoreNanoseconds();
+
+        /**
+         * Method you can use to discard collected statistics.
+         */
+        static void resetStatistics();
+
+        /**
+         * Method you can use to write the collected statistics to a file, in JSON format.
+         *
+         * \param[in] filename The file to be written.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        static bool writeReport(const QString& filename);
+
+        /**
+         * Method that is called when an editor is shown.
+         *
+         * \param[in] rootPresentation The document presented by the editor.
+         */
+        static inline void editorShown(RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordEditorShown(rootPresentation);
+            } else {
+                restore(rootPresentation);
+            }
+        }
+
+        /**
+         * Method that is called when an editor is hidden.
+         *
+         * \param[in] rootPresentation The document presented by the editor.
+         */
+        static inline void editorHidden(RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordEditorHidden(rootPresentation);
+            }
+        }
+
+        /**
+         * Method that is called when a root presentation finishes repositioning.
+         *
+         * \param[in] rootPresentation The document that was placed.
+         */
+        static inline void repositioningFinished(RootPresentation* rootPresentation) {
+            if (currentEnabled) {
+                recordRepositioningFinished(rootPresentation);
+            }
+        }
+
+        /**
+         * Method that is called when a document is destroyed.
+         *
+         * \param[in] rootPresentation The document being destroyed.
+         */
+        static void documentClosed(const RootPresentation* rootPresentation);
+
+    private:
+        /**
+         * Method that restores a released document.
+         *
+         * \param[in] rootPresentation The document to be restored.
+         */
+        static void restore(RootPresentation* rootPresentation);
+
+        /**
+         * Method that records an editor being shown and restores the document, if needed.
+         *
+         * \param[in] rootPresentation The document presented by the editor.
+         */
+        static void recordEditorShown(RootPresentation* rootPresentation);
+
+        /**
+         * Method that records an editor being hidden.
+         *
+         * \param[in] rootPresentation The document presented by the editor.
+         */
+        static void recordEditorHidden(RootPresentation* rootPresentation);
+
+        /**
+         * Method that records the end of repositioning.
+         *
+         * \param[in] rootPresentation The document that was placed.
+         */
+        static void recordRepositioningFinished(RootPresentation* rootPresentation);
+
+        /**
+         * Method that schedules the budget to be enforced once control returns to the event loop.
+         */
+        static void scheduleEnforcement();
+
+        /**
+         * Method that releases hidden documents until the scene memory is within budget.
+         */
+        static void enforceBudget();
+
+        /**
+         * Flag indicating if the governor is enabled.
+         */
+        static bool currentEnabled;
+};
+
+#endif
@@ -0,0 +1,577 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref NativePlotItem class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef NATIVE_PLOT_ITEM_H
+#define NATIVE_PLOT_ITEM_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPointF>
+#include <QSizeF>
+#include <QRectF>
+#include <QPen>
+#include <QBrush>
+#include <QFont>
+#include <QPainterPath>
+
+#include <eqt_charts.h>
+#include <eqt_graphics_item_group.h>
+
+#include <ld_plot_format.h>
+
+#include "app_common.h"
+#include "scene_units.h"
+
+class QPainter;
+class QStyleOptionGraphicsItem;
+class QWidget;
+
+/**
+ * Lightweight graphics item that renders a two dimensional plot directly rather than through a QtCharts::QChart.
+ *
+ * The item uses detached QtCharts::QAbstractAxis and QtCharts::QXYSeries instances purely as containers for ranges,
+ * tick settings, pens, fonts, and data points so the existing plot presentation data classes can drive it unchanged.
+ * Axes, ticks, grid lines, labels, the legend, and the series are converted to cached painter paths when any of these
+ * change and are painted in a single pass, avoiding the per-series and per-axis graphics items a QChart creates.
+ */
+class APP_PUBLIC_API NativePlotItem:public EQt::GraphicsItemGroup, private SceneUnits {
+    public:
+        /**
+         * Typedef indicating the axis locations.
+         */
+        typedef Ld::PlotFormat::AxisLocation AxisLocation;
+
+        /**
+         * Typedef indicating the legend locations.
+         */
+        typedef Ld::PlotFormat::LegendLocation LegendLocation;
+
+        NativePlotItem();
+
+        ~NativePlotItem() override;
+
+        /**
+         * Method you can use to set the geometry of the plot.
+         *
+         * \param[in] x      The left edge of the plot, in scene units.
+         *
+         * \param[in] y      The top edge of the plot, in scene units.
+         *
+         * \param[in] width  The width of the plot, in scene units.
+         *
+         * \param[in] height The height of the plot, in scene units.
+         */
+        void setGeometry(double x, double y, double width, double height);
+
+        /**
+         * Method you can use to set the pen used to draw the plot border.
+         *
+         * \param[in] newPen The new border pen.
+         */
+        void setBackgroundPen(const QPen& newPen);
+
+        /**
+         * Method you can use to set the brush used to fill the plot background.
+         *
+         * \param[in] newBrush The new background brush.
+         */
+        void setBackgroundBrush(const QBrush& newBrush);
+
+        /**
+         * Method you can use to set the plot title.
+         *
+         * \param[in] newTitle The new plot title.  An empty string will hide the title.
+         */
+        void setTitle(const QString& newTitle);
+
+        /**
+         * Method you can use to set the plot title font.
+         *
+         * \param[in] newFont The new title font.
+         */
+        void setTitleFont(const QFont& newFont);
+
+        /**
+         * Method you can use to set the brush used to draw the plot title.
+         *
+         * \param[in] newBrush The new title brush.
+         */
+        void setTitleBrush(const QBrush& newBrush);
+
+        /**
+         * Method you can use to set the legend location.
+         *
+         * \param[in] newLegendLocation The new legend location.  A value of LegendLocation::NO_LEGEND will hide the
+         *                              legend.
+         */
+        void setLegendLocation(LegendLocation newLegendLocation);
+
+        /**
+         * Method you can use to set the legend font.
+         *
+         * \param[in] newFont The new legend font.
+         */
+        void setLegendFont(const QFont& newFont);
+
+        /**
+         * Method you can use to set the brush used to draw the legend labels.
+         *
+         * \param[in] newBrush The new legend label brush.
+         */
+        void setLegendLabelBrush(const QBrush& newBrush);
+
+        /**
+         * Method you can use to set the pen used to draw the legend border.
+         *
+         * \param[in] newPen The new legend border pen.
+         */
+        void setLegendPen(const QPen& newPen);
+
+        /**
+         * Method you can use to set the brush used to fill the legend background.
+         *
+         * \param[in] newBrush The new legend background brush.  A brush with no style will leave the legend
+         *                     background transparent.
+         */
+        void setLegendBrush(const QBrush& newBrush);
+
+        /**
+         * Method you can use to add an axis to the plot.  The plot takes ownership of the axis.
+         *
+         * \param[in] axis         The axis to be added.
+         *
+         * \param[in] axisLocation The location of the axis.
+         */
+        void addAxis(QAbstractAxis* axis, AxisLocation axisLocation);
+
+        /**
+         * Method you can use to add a series to the plot.  The plot takes ownership of the series.  The series is
+         * removed from the plot automatically if it is deleted.
+         *
+         * \param[in] series The series to be added.
+         */
+        void addSeries(QXYSeries* series);
+
+        /**
+         * Method you can use to tie a series to a previously added axis.  Series values are mapped against the axes
+         * at the bottom and left edges of the plot until attached to a different axis.
+         *
+         * \param[in] series       The series to be tied to the axis.
+         *
+         * \param[in] axisLocation The location of the axis.
+         */
+        void attachAxis(QXYSeries* series, AxisLocation axisLocation);
+
+        /**
+         * Method you can use to obtain the area used to draw the plot series.
+         *
+         * \return Returns the plot area, in item coordinates.
+         */
+        QRectF plotArea() const;
+
+        /**
+         * Method that paints the plot.
+         *
+         * \param[in] painter The painter to use to draw the plot.
+         *
+         * \param[in] option  Style options for the item.
+         *
+         * \param[in] widget  The widget being painted on.
+         */
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = Q_NULLPTR) override;
+
+    private:
+        /**
+         * Value indicating the length of the axis ticks, in points.
+         */
+        static constexpr double tickLengthPoints = 4.0;
+
+        /**
+         * Value indicating the spacing between plot elements, in points.
+         */
+        static constexpr double spacingPoints = 4.0;
+
+        /**
+         * Value indicating the width of the line drawn in legend entries, in multiples of the legend font height.
+         */
+        static constexpr double legendSwatchWidthScaleFactor = 2.0;
+
+        /**
+         * Value indicating the maximum number of major or minor ticks we will generate for any axis.  The limit
+         * protects against degenerate tick intervals.
+         */
+        static constexpr unsigned maximumNumberTicks = 1000;
+
+        /**
+         * Value indicating the largest field width or precision accepted in an axis label format.  Formats exceeding
+         * this value are ignored.
+         */
+        static constexpr unsigned maximumLabelFieldWidth = 32;
+
+        /**
+         * Class used internally to track an axis and its cached geometry.
+         */
+        class AxisEntry {
+            public:
+                AxisEntry();
+
+                /**
+                 * Constructor
+                 *
+                 * \param[in] axis         The axis being tracked.
+                 *
+                 * \param[in] axisLocation The location of the axis.
+                 */
+                AxisEntry(QAbstractAxis* axis, AxisLocation axisLocation);
+
+                /**
+                 * The axis being tracked.
+                 */
+                QAbstractAxis* axis;
+
+                /**
+                 * The location of the axis.
+                 */
+                AxisLocation axisLocation;
+
+                /**
+                 * The values of each major tick.
+                 */
+                QList<double> majorValues;
+
+                /**
+                 * The values of each minor tick.
+                 */
+                QList<double> minorValues;
+
+                /**
+                 * The label for each major tick.
+                 */
+                QStringList labels;
+
+                /**
+                 * The rectangle holding each label.  Rotated labels hold the rectangle before rotation, centered on
+                 * the label anchor.
+                 */
+                QList<QRectF> labelRectangles;
+
+                /**
+                 * The rectangle holding the axis title.  Vertical axis titles hold the rectangle before rotation,
+                 * centered on the title anchor.
+                 */
+                QRectF titleRectangle;
+
+                /**
+                 * The space required by the axis outside of the plot area.
+                 */
+                double extent;
+
+                /**
+                 * Path holding the axis line and tick marks.
+                 */
+                QPainterPath linePath;
+
+                /**
+                 * Path holding the major grid lines.
+                 */
+                QPainterPath majorGridPath;
+
+                /**
+                 * Path holding the minor grid lines.
+                 */
+                QPainterPath minorGridPath;
+        };
+
+        /**
+         * Class used internally to track a series and its cached geometry.
+         */
+        class SeriesEntry {
+            public:
+                SeriesEntry();
+
+                /**
+                 * Constructor
+                 *
+                 * \param[in] series The series being tracked.
+                 */
+                SeriesEntry(QXYSeries* series);
+
+                /**
+                 * The series being tracked.
+                 */
+                QXYSeries* series;
+
+                /**
+                 * The location of the horizontal axis used by this series.
+                 */
+                AxisLocation horizontalAxisLocation;
+
+                /**
+                 * The location of the vertical axis used by this series.
+                 */
+                AxisLocation verticalAxisLocation;
+
+                /**
+                 * Path holding the series line or markers.
+                 */
+                QPainterPath path;
+
+                /**
+                 * The marker locations, populated for series using image markers.
+                 */
+                QList<QPointF> markerLocations;
+        };
+
+        /**
+         * Class used internally to track a legend entry.  Consecutive series sharing a name, such as the line and
+         * markers of a single plot series, share a legend entry.
+         */
+        class LegendEntry {
+            public:
+                /**
+                 * The series shown by this legend entry.
+                 */
+                QList<QXYSeries*> series;
+
+                /**
+                 * The rectangle holding the legend swatch.
+                 */
+                QRectF swatchRectangle;
+
+                /**
+                 * The rectangle holding the legend label.
+                 */
+                QRectF labelRectangle;
+        };
+
+        /**
+         * Method that is called when the plot contents change.
+         */
+        void invalidateLayout();
+
+        /**
+         * Method that is called when a series is deleted.
+         *
+         * \param[in] series The series being deleted.
+         */
+        void seriesDestroyed(QXYSeries* series);
+
+        /**
+         * Method that recalculates the cached layout and paths, if needed.
+         */
+        void updateLayout() const;
+
+        /**
+         * Method that calculates the tick values and labels for an axis.
+         *
+         * \param[in] axisEntry The axis entry to be updated.
+         */
+        static void calculateTicks(AxisEntry& axisEntry);
+
+        /**
+         * Method that generates the label for a tick value.  Label formats are read from the document so they are
+         * parsed here and never passed to a printf style function.  A format is used only if it contains exactly one
+         * %d, %i, %f, %e or %g conversion with optional flags, field width, precision and "l" length modifier.  Any
+         * other text is copied with "%%" producing a percent sign.  Invalid formats select the general format.
+         *
+         * \param[in] labelFormat The printf style label format for the axis.  An empty string selects a general
+         *                        format.
+         *
+         * \param[in] value       The tick value.
+         *
+         * \param[in] span        The span of the axis.  Values that are negligible relative to the span are shown as
+         *                        zero.
+         *
+         * \return Returns the label text.
+         */
+        static QString formatLabel(const QString& labelFormat, double value, double span);
+
+        /**
+         * Method that calculates the space required for an axis and populates the label sizes.
+         *
+         * \param[in] axisEntry The axis entry to be updated.
+         */
+        void calculateAxisExtent(AxisEntry& axisEntry) const;
+
+        /**
+         * Method that calculates the axis paths and label positions once the plot area is known.
+         *
+         * \param[in] axisEntry The axis entry to be updated.
+         */
+        void placeAxis(AxisEntry& axisEntry) const;
+
+        /**
+         * Method that calculates the path for a series once the plot area is known.
+         *
+         * \param[in] seriesEntry The series entry to be updated.
+         */
+        void placeSeries(SeriesEntry& seriesEntry) const;
+
+        /**
+         * Method that builds the legend entries and determines the space they require.
+         *
+         * \return Returns the size required by the legend.
+         */
+        QSizeF calculateLegendSize() const;
+
+        /**
+         * Method that positions the legend entries within a legend rectangle.
+         *
+         * \param[in] legendRectangle The rectangle to hold the legend.
+         */
+        void placeLegend(const QRectF& legendRectangle) const;
+
+        /**
+         * Method that locates the axis at a given location.
+         *
+         * \param[in] axisLocation The axis location of interest.
+         *
+         * \return Returns a pointer to the axis entry.  A null pointer is returned if there is no axis at the
+         *         location.
+         */
+        const AxisEntry* axisEntryAt(AxisLocation axisLocation) const;
+
+        /**
+         * Method that maps a value onto an axis.
+         *
+         * \param[in] axis  The axis to map against.
+         *
+         * \param[in] value The value to be mapped.
+         *
+         * \return Returns the fractional position of the value along the axis, with 0 at the axis minimum and 1 at
+         *         the axis maximum.  NaN is returned if the value can not be represented on the axis.
+         */
+        static double axisFraction(const QAbstractAxis* axis, double value);
+
+        /**
+         * Method that determines if an axis is horizontal.
+         *
+         * \param[in] axisLocation The axis location.
+         *
+         * \return Returns true if the axis is horizontal.  Returns false if the axis is vertical.
+         */
+        static bool isHorizontal(AxisLocation axisLocation);
+
+        /**
+         * Method that draws a legend swatch for a series.
+         *
+         * \param[in] painter   The painter to use to draw the swatch.
+         *
+         * \param[in] series    The series to draw the swatch for.
+         *
+         * \param[in] rectangle The rectangle to hold the swatch.
+         */
+        static void paintSwatch(QPainter* painter, const QXYSeries* series, const QRectF& rectangle);
+
+        /**
+         * Method that draws a single marker.
+         *
+         * \param[in] painter  The painter to use to draw the marker.
+         *
+         * \param[in] series   The scatter series providing the marker settings.
+         *
+         * \param[in] location The center of the marker.
+         */
+        static void paintMarker(QPainter* painter, const QScatterSeries* series, const QPointF& location);
+
+        /**
+         * The plot geometry.
+         */
+        QRectF currentGeometry;
+
+        /**
+         * The plot border pen.
+         */
+        QPen currentBackgroundPen;
+
+        /**
+         * The plot background brush.
+         */
+        QBrush currentBackgroundBrush;
+
+        /**
+         * The plot title.
+         */
+        QString currentTitle;
+
+        /**
+         * The plot title font.
+         */
+        QFont currentTitleFont;
+
+        /**
+         * The plot title brush.
+         */
+        QBrush currentTitleBrush;
+
+        /**
+         * The legend location.
+         */
+        LegendLocation currentLegendLocation;
+
+        /**
+         * The legend font.
+         */
+        QFont currentLegendFont;
+
+        /**
+         * The legend label brush.
+         */
+        QBrush currentLegendLabelBrush;
+
+        /**
+         * The legend border pen.
+         */
+        QPen currentLegendPen;
+
+        /**
+         * The legend background brush.
+         */
+        QBrush currentLegendBrush;
+
+        /**
+         * The axes, in the order they were added.
+         */
+        mutable QList<AxisEntry> currentAxes;
+
+        /**
+         * The series, in the order they were added.
+         */
+        mutable QList<SeriesEntry> currentSeries;
+
+        /**
+         * Flag indicating if the cached layout is valid.
+         */
+        mutable bool layoutValid;
+
+        /**
+         * The cached plot area.
+         */
+        mutable QRectF currentPlotArea;
+
+        /**
+         * The cached title rectangle.
+         */
+        mutable QRectF currentTitleRectangle;
+
+        /**
+         * The cached legend rectangle.
+         */
+        mutable QRectF currentLegendRectangle;
+
+        /**
+         * The cached legend entries.
+         */
+        mutable QList<LegendEntry> currentLegendEntries;
+};
+
+#endif
@@ -15,6 +15,9 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QSet>
 #include <QSharedPointer>
 #include <QSizeF>
 #include <QRectF>
@@ -67,6 +70,12 @@ class APP_PUBLIC_API OperatorPresentationBase:public PresentationWithFixedChildr
          */
         void requestRepositioning(Presentation* childPresentation) override;
 
+        /**
+         * Method you can call to indicate this presentation needs to be repositioned.  A flagged presentation always
+         * rebuilds its graphics item on the next placement pass.
+         */
+        void flagPendingRepositioning() override;
+
         /**
          * Method that is called by a parent to a child to tell the child to start the placement operation,
          * recalculating sizes and positions.  This method will repeatedly call the parent's instance of
@@ -504,12 +513,38 @@ class APP_PUBLIC_API OperatorPresentationBase:public PresentationWithFixedChildr
          */
         void populateTrackers(PlacementTracker* placementTracker, float relativeScale);
 
+        /**
+         * Method you can use to determine which children were placed by the last call to \ref populateTrackers.
+         * Derived classes can use this to limit an update to the children that may have changed.
+         *
+         * \return Returns the indexes of the children placed during the current placement pass.
+         */
+        const QSet<unsigned long>& placedChildren() const;
+
         /**
          * Method that adjusts the number of trackers to match the number of children.
          */
         void reallocateTrackers();
 
     private:
+        /**
+         * Method that determines if the children re-placed during this placement pass report the same layout as
+         * before.  If so, the re-placed children's graphics items are moved back to their previous positions.
+         *
+         * \param[in] relativeScale The relative scale for this placement pass.
+         *
+         * \return Returns true if the graphics item does not need to be rebuilt.  Returns false if the graphics item
+         *         must be rebuilt.
+         */
+        bool restoreCommittedPlacement(float relativeScale);
+
+        /**
+         * Method that discards the committed child layouts and marks the placement as committed.
+         *
+         * \param[in] relativeScale The relative scale used for the committed placement.
+         */
+        void commitPlacement(float relativeScale);
+
         /**
          * The group used to contain this widget.
          */
@@ -529,6 +564,33 @@ class APP_PUBLIC_API OperatorPresentationBase:public PresentationWithFixedChildr
          * The required ascent for the area.
          */
         float requiredAscent;
+
+        /**
+         * Flag indicating that this presentation, rather than just one or more children, must be repositioned.
+         */
+        bool currentSelfRepositioningPending;
+
+        /**
+         * The relative scale used for the last committed placement.
+         */
+        float committedRelativeScale;
+
+        /**
+         * The last committed layout of each child that has requested repositioning since the last placement pass,
+         * keyed by child index.
+         */
+        QHash<unsigned long, PresentationAreaTracker> committedChildPresentationAreas;
+
+        /**
+         * The last committed position of each presentation area of each child that has requested repositioning
+         * since the last placement pass, keyed by child index.
+         */
+        QHash<unsigned long, QList<QPointF>> committedChildPositions;
+
+        /**
+         * The indexes of the children placed during the current placement pass.
+         */
+        QSet<unsigned long> currentPlacedChildren;
 };
 
 #endif
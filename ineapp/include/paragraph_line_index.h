@@ -0,0 +1,213 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref ParagraphLineIndex class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef PARAGRAPH_LINE_INDEX_H
+#define PARAGRAPH_LINE_INDEX_H
+
+#include <QList>
+#include <QRectF>
+
+#include "app_common.h"
+
+/**
+ * Class that indexes the lines of a placed paragraph.  Each line records the active area holding it, its vertical band
+ * and the presentation areas placed on it, sorted left to right.  Positions are relative to the active area so the
+ * index remains valid when the paragraph is moved without being placed again.
+ *
+ * Lines are appended in placement order which is sorted by active area and then by vertical position.  Lookups use
+ * binary searches.
+ */
+class APP_PUBLIC_API ParagraphLineIndex {
+    public:
+        /**
+         * Value returned when no line or entry can be located.
+         */
+        static constexpr long notFound = -1;
+
+        /**
+         * Class that describes one presentation area placed on a line.
+         */
+        class APP_PUBLIC_API Entry {
+            public:
+                Entry();
+
+                /**
+                 * Constructor
+                 *
+                 * \param[in] childIdentifier    The index of the child presentation.
+                 *
+                 * \param[in] presentationAreaId The child's presentation area ID.
+                 *
+                 * \param[in] rectangle          The area covered by the presentation area, relative to the active
+                 *                               area.
+                 */
+                Entry(unsigned long childIdentifier, unsigned long presentationAreaId, const QRectF& rectangle);
+
+                ~Entry();
+
+                /**
+                 * Method you can use to obtain the index of the child presentation.
+                 *
+                 * \return Returns the child index.
+                 */
+                unsigned long childIdentifier() const;
+
+                /**
+                 * Method you can use to obtain the child's presentation area ID.
+                 *
+                 * \return Returns the presentation area ID.
+                 */
+                unsigned long presentationAreaId() const;
+
+                /**
+                 * Method you can use to obtain the area covered by the presentation area.
+                 *
+                 * \return Returns the covered area, relative to the active area.
+                 */
+                const QRectF& rectangle() const;
+
+            private:
+                unsigned long currentChildIdentifier;
+                unsigned long currentPresentationAreaId;
+                QRectF        currentRectangle;
+        };
+
+        /**
+         * Class that describes one line.
+         */
+        class APP_PUBLIC_API Line {
+            public:
+                Line();
+
+                /**
+                 * Constructor
+                 *
+                 * \param[in] areaIdentifier The active area holding the line.
+                 *
+                 * \param[in] top            The top of the line, relative to the active area.
+                 *
+                 * \param[in] bottom         The bottom of the line, relative to the active area.
+                 */
+                Line(unsigned long areaIdentifier, double top, double bottom);
+
+                ~Line();
+
+                /**
+                 * Method you can use to append a presentation area.  Presentation areas must be appended left to
+                 * right.
+                 *
+                 * \param[in] entry The presentation area to append.
+                 */
+                void append(const Entry& entry);
+
+                /**
+                 * Method you can use to obtain the active area holding the line.
+                 *
+                 * \return Returns the active area identifier.
+                 */
+                unsigned long areaIdentifier() const;
+
+                /**
+                 * Method you can use to obtain the top of the line.
+                 *
+                 * \return Returns the top of the line, relative to the active area.
+                 */
+                double top() const;
+
+                /**
+                 * Method you can use to obtain the bottom of the line.
+                 *
+                 * \return Returns the bottom of the line, relative to the active area.
+                 */
+                double bottom() const;
+
+                /**
+                 * Method you can use to obtain the presentation areas on the line.
+                 *
+                 * \return Returns the presentation areas, sorted left to right.
+                 */
+                const QList<Entry>& entries() const;
+
+                /**
+                 * Method you can use to locate the presentation area closest to a horizontal position.
+                 *
+                 * \param[in] x The horizontal position, relative to the active area.
+                 *
+                 * \return Returns the index of the presentation area containing the position.  The first or last
+                 *         presentation area is returned if the position lies before or after the line.
+                 *         \ref ParagraphLineIndex::notFound is returned if the line is empty.
+                 */
+                long entryAt(double x) const;
+
+            private:
+                unsigned long currentAreaIdentifier;
+                double        currentTop;
+                double        currentBottom;
+                QList<Entry>  currentEntries;
+        };
+
+        ParagraphLineIndex();
+
+        ~ParagraphLineIndex();
+
+        /**
+         * Method you can use to discard every line.
+         */
+        void clear();
+
+        /**
+         * Method you can use to append a line.  Lines must be appended in placement order.
+         *
+         * \param[in] line The line to append.
+         */
+        void append(const Line& line);
+
+        /**
+         * Method you can use to discard the lines held in an active area and in every following active area.
+         *
+         * \param[in] areaIdentifier The first active area to discard.
+         */
+        void truncateAreasStartingAt(unsigned long areaIdentifier);
+
+        /**
+         * Method you can use to determine the number of indexed lines.
+         *
+         * \return Returns the number of lines.
+         */
+        unsigned long numberLines() const;
+
+        /**
+         * Method you can use to obtain a line.
+         *
+         * \param[in] lineNumber The zero based line number.
+         *
+         * \return Returns the requested line.
+         */
+        const Line& line(unsigned long lineNumber) const;
+
+        /**
+         * Method you can use to locate the line at a vertical position.
+         *
+         * \param[in] areaIdentifier The active area to search.
+         *
+         * \param[in] y              The vertical position, relative to the active area.
+         *
+         * \return Returns the line number of the last line in the active area whose top is at or above the position.
+         *         \ref ParagraphLineIndex::notFound is returned if the position is above the first line of the area
+         *         or below the last line of the area.
+         */
+        long lineAt(unsigned long areaIdentifier, double y) const;
+
+    private:
+        QList<Line> lines;
+};
+
+#endif
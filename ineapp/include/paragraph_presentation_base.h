@@ -15,12 +15,14 @@
 #include <QObject>
 #include <QSizeF>
 #include <QRectF>
+#include <QPointF>
 #include <QList>
 
 #include <ld_paragraph_format.h>
 
 #include "app_common.h"
 #include "placement_line_data.h"
+#include "paragraph_line_index.h"
 #include "presentation_with_positional_children.h"
 
 class QGraphicsItem;
@@ -261,6 +263,35 @@ class APP_PUBLIC_API ParagraphPresentationBase:public PresentationWithPositional
             QPointF*             closestPoint = Q_NULLPTR
         ) const override;
 
+        /**
+         * Method you can use to determine the number of lines in this paragraph.
+         *
+         * \return Returns the number of lines placed by the last placement pass.
+         */
+        unsigned long numberLines() const;
+
+        /**
+         * Method you can use to locate the line at a given location.
+         *
+         * \param[in] location The location to query, in scene units.
+         *
+         * \return Returns the zero based line number of the line holding the location.  A value of
+         *         \ref ParagraphLineIndex::notFound is returned if the location is not within a line.
+         */
+        long lineAtLocation(const QPointF& location) const;
+
+        /**
+         * Method you can use to obtain the location on a line closest to a given horizontal position.  The location
+         * is placed within the presentation area nearest the horizontal position, at the area's vertical center.
+         *
+         * \param[in] lineNumber The zero based line number.
+         *
+         * \param[in] x          The horizontal position, in scene units.
+         *
+         * \return Returns the location on the line, in scene units.
+         */
+        QPointF locationOnLine(unsigned long lineNumber, double x) const;
+
         /**
          * Method that is called by the cursor logic to determine if this element should be highlighted during
          * selection.
@@ -562,6 +593,11 @@ class APP_PUBLIC_API ParagraphPresentationBase:public PresentationWithPositional
          */
         QList<EQt::GraphicsItemGroup*> activeAreas;
 
+        /**
+         * Index of the lines placed in each active area.
+         */
+        ParagraphLineIndex lineIndex;
+
         /**
          * Graphics text item used to display list text.
          */
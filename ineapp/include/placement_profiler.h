@@ -0,0 +1,349 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref PlacementProfiler class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef PLACEMENT_PROFILER_H
+#define PLACEMENT_PROFILER_H
+
+#include <QString>
+#include <QList>
+
+#include <ld_element_structures.h>
+
+#include "app_common.h"
+
+class Presentation;
+class QGraphicsScene;
+
+/**
+ * Class that collects opt-in placement profiling data.  When enabled, the profiler records the time spent placing
+ * each presentation type and each element, the number of recalculatePlacement and redoPlacement calls, the number of
+ * areaInsufficient retries and the number of graphics items created and destroyed during repositioning.
+ *
+ * Time is recorded both inclusive of, and exclusive of, the time spent placing child presentations.
+ *
+ * The profiler is disabled by default.  When disabled, each hook costs a single test of a static flag.
+ */
+class APP_PUBLIC_API PlacementProfiler {
+    public:
+        /**
+         * Enumeration of profiled placement operations.
+         */
+        enum class Operation {
+            /**
+             * Indicates a call to PlacementNegotiator::recalculatePlacement.
+             */
+            RECALCULATE_PLACEMENT,
+
+            /**
+             * Indicates a call to PlacementNegotiator::redoPlacement.
+             */
+            REDO_PLACEMENT
+        };
+
+        /**
+         * Class that holds the statistics for a single presentation type or element.
+         */
+        class APP_PUBLIC_API Statistics {
+            friend class PlacementProfiler;
+
+            public:
+                Statistics();
+
+                /**
+                 * Copy constructor.
+                 *
+                 * \param[in] other The instance to be copied.
+                 */
+                Statistics(const Statistics& other);
+
+                ~Statistics();
+
+                /**
+                 * Method you can use to obtain the presentation type name.
+                 *
+                 * \return Returns the class name of the presentation.
+                 */
+                const QString& typeName() const;
+
+                /**
+                 * Method you can use to obtain the element tied to the presentation.  The element is only reported
+                 * for per-element statistics.
+                 *
+                 * \return Returns a weak pointer to the element.  A null pointer is returned for per-type statistics
+                 *         and for elements that have since been deleted.
+                 */
+                Ld::ElementWeakPointer element() const;
+
+                /**
+                 * Method you can use to obtain the total placement time, including time spent placing children.
+                 *
+                 * \return Returns the inclusive placement time, in nanoseconds.
+                 */
+                unsigned long long inclusiveNanoseconds() const;
+
+                /**
+                 * Method you can use to obtain the total placement time, excluding time spent placing children.
+                 *
+                 * \return Returns the exclusive placement time, in nanoseconds.
+                 */
+                unsigned long long exclusiveNanoseconds() const;
+
+                /**
+                 * Method you can use to obtain the number of recalculatePlacement calls.
+                 *
+                 * \return Returns the number of recalculatePlacement calls.
+                 */
+                unsigned long numberRecalculatePlacementCalls() const;
+
+                /**
+                 * Method you can use to obtain the number of redoPlacement calls.
+                 *
+                 * \return Returns the number of redoPlacement calls.
+                 */
+                unsigned long numberRedoPlacementCalls() const;
+
+                /**
+                 * Method you can use to obtain the number of times the presentation reported that the area it was
+                 * given was insufficient.
+                 *
+                 * \return Returns the number of areaInsufficient retries.
+                 */
+                unsigned long numberAreaInsufficientRetries() const;
+
+                /**
+                 * Assignment operator.
+                 *
+                 * \param[in] other The instance to be copied.
+                 *
+                 * \return Returns a reference to this instance.
+                 */
+                Statistics& operator=(const Statistics& other);
+
+            private:
+                /**
+                 * The presentation type name.
+                 */
+                QString currentTypeName;
+
+                /**
+                 * The element tied to the presentation.
+                 */
+                Ld::ElementWeakPointer currentElement;
+
+                /**
+                 * The inclusive placement time.
+                 */
+                unsigned long long currentInclusiveNanoseconds;
+
+                /**
+                 * The exclusive placement time.
+                 */
+                unsigned long long currentExclusiveNanoseconds;
+
+                /**
+                 * The number of recalculatePlacement calls.
+                 */
+                unsigned long currentNumberRecalculatePlacementCalls;
+
+                /**
+                 * The number of redoPlacement calls.
+                 */
+                unsigned long currentNumberRedoPlacementCalls;
+
+                /**
+                 * The number of areaInsufficient retries.
+                 */
+                unsigned long currentNumberAreaInsufficientRetries;
+        };
+
+        /**
+         * Class that profiles a single placement operation for the lifetime of the instance.  Create an instance
+         * immediately before calling a child's recalculatePlacement or redoPlacement method.
+         */
+        class APP_PUBLIC_API Scope {
+            public:
+                /**
+                 * Constructor.
+                 *
+                 * \param[in] presentation The presentation being placed.
+                 *
+                 * \param[in] operation    The placement operation being performed.
+                 */
+                inline Scope(
+                        Presentation* presentation,
+                        Operation     operation = Operation::RECALCULATE_PLACEMENT
+                    ):currentActive(
+                        currentEnabled
+                    ) {
+                    if (currentActive) {
+                        startOperation(presentation, operation);
+                    }
+                }
+
+                inline ~Scope() {
+                    if (currentActive) {
+                        endOperation();
+                    }
+                }
+
+            private:
+                /**
+                 * Flag indicating if this scope is being profiled.
+                 */
+                bool currentActive;
+        };
+
+        /**
+         * Method you can use to determine if the profiler is enabled.
+         *
+         * \return Returns true if the profiler is enabled.  Returns false if the profiler is disabled.
+         */
+        static inline bool isEnabled() {
+            return currentEnabled;
+        }
+
+        /**
+         * Method you can use to enable or disable the profiler.  Enabling the profiler does not clear previously
+         * collected data.
+         *
+         * \param[in] nowEnabled If true, the profiler will be enabled.  If false, the profiler will be disabled.
+         */
+        static void setEnabled(bool nowEnabled = true);
+
+        /**
+         * Method you can use to discard all collected data.
+         */
+        static void reset();
+
+        /**
+         * Method that is called by a placement negotiator when a child reports that the area it was given is
+         * insufficient.  The retry is charged to the presentation currently being placed.
+         */
+        static inline void areaInsufficient() {
+            if (currentEnabled) {
+                recordAreaInsufficient();
+            }
+        }
+
+        /**
+         * Method that is called when the root presentation starts a repositioning pass.
+         *
+         * \param[in] scene The scene holding the graphics items being placed.
+         */
+        static inline void repositioningStarted(const QGraphicsScene* scene) {
+            if (currentEnabled) {
+                recordRepositioningStarted(scene);
+            }
+        }
+
+        /**
+         * Method that is called when the root presentation completes a repositioning pass.
+         *
+         * \param[in] scene The scene holding the graphics items being placed.
+         */
+        static inline void repositioningCompleted(const QGraphicsScene* scene) {
+            if (currentEnabled) {
+                recordRepositioningCompleted(scene);
+            }
+        }
+
+        /**
+         * Method you can use to obtain the statistics for each presentation type.
+         *
+         * \return Returns a list of statistics, sorted by decreasing exclusive time.
+         */
+        static QList<Statistics> statisticsByType();
+
+        /**
+         * Method you can use to obtain the statistics for each element.
+         *
+         * \return Returns a list of statistics, sorted by decreasing inclusive time.
+         */
+        static QList<Statistics> statisticsByElement();
+
+        /**
+         * Method you can use to obtain the number of repositioning passes.
+         *
+         * \return Returns the number of repositioning passes performed by root presentations.
+         */
+        static unsigned long numberRepositioningPasses();
+
+        /**
+         * Method you can use to obtain the total time spent in repositioning passes.
+         *
+         * \return Returns the total repositioning time, in nanoseconds.
+         */
+        static unsigned long long repositioningNanoseconds();
+
+        /**
+         * Method you can use to obtain the number of graphics items added to scenes during repositioning.
+         *
+         * \return Returns the number of graphics items added.
+         */
+        static unsigned long long numberGraphicsItemsAdded();
+
+        /**
+         * Method you can use to obtain the number of graphics items removed from scenes during repositioning.
+         *
+         * \return Returns the number of graphics items removed.
+         */
+        static unsigned long long numberGraphicsItemsRemoved();
+
+        /**
+         * Method you can use to write the collected data to a file, in JSON format.
+         *
+         * \param[in] filename The file to be written.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        static bool writeReport(const QString& filename);
+
+    private:
+        /**
+         * Method that starts profiling a placement operation.
+         *
+         * \param[in] presentation The presentation being placed.
+         *
+         * \param[in] operation    The placement operation being performed.
+         */
+        static void startOperation(Presentation* presentation, Operation operation);
+
+        /**
+         * Method that ends profiling of the most recently started placement operation.
+         */
+        static void endOperation();
+
+        /**
+         * Method that records an areaInsufficient retry.
+         */
+        static void recordAreaInsufficient();
+
+        /**
+         * Method that records the start of a repositioning pass.
+         *
+         * \param[in] scene The scene holding the graphics items being placed.
+         */
+        static void recordRepositioningStarted(const QGraphicsScene* scene);
+
+        /**
+         * Method that records the end of a repositioning pass.
+         *
+         * \param[in] scene The scene holding the graphics items being placed.
+         */
+        static void recordRepositioningCompleted(const QGraphicsScene* scene);
+
+        /**
+         * Flag indicating if the profiler is enabled.
+         */
+        static bool currentEnabled;
+};
+
+#endif
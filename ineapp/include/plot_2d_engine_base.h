@@ -34,6 +34,7 @@
 class QGraphicsItem;
 class QColor;
 
+class NativePlotItem;
 class PlotPresentationData;
 class Plot2DPresentationData;
 
@@ -85,6 +86,24 @@ class APP_PUBLIC_API Plot2DEngineBase:public PlotWrappedEngineBase, public PlotM
             QSharedPointer<Ld::PlotFormat>  plotFormat
         ) const;
 
+        /**
+         * Method that configures a \ref NativePlotItem object using the supplied element and format.
+         *
+         * \param[in] plotItem         The native plot item to be configured.
+         *
+         * \param[in] presentationData The presentation data instance to be configured with the plot.
+         *
+         * \param[in] plotElement      The plot element used to create the plot.
+         *
+         * \param[in] plotFormat       The plot format instance used to create the plot.
+         */
+        void configureChart(
+            NativePlotItem*                 plotItem,
+            Plot2DPresentationData*         presentationData,
+            QSharedPointer<Ld::PlotElement> plotElement,
+            QSharedPointer<Ld::PlotFormat>  plotFormat
+        ) const;
+
         /**
          * Method that configures the markers for a series.
          *
@@ -112,7 +131,7 @@ class APP_PUBLIC_API Plot2DEngineBase:public PlotWrappedEngineBase, public PlotM
          *
          * \param[in] plotFormat       A shared pointer to the plot format instance.
          *
-         * \param[in] chartItem        The QChart instance to be configured.
+         * \param[in] plotItem         The QChart or \ref NativePlotItem instance to be configured.
          *
          * \param[in] presentationData The \ref Plot2DPresentationData instance to be configured.
          *
@@ -123,10 +142,38 @@ class APP_PUBLIC_API Plot2DEngineBase:public PlotWrappedEngineBase, public PlotM
         static QString configureSeries(
             const Ld::PlotElement&                                    plotElement,
             const Ld::PlotFormat&                                     plotFormat,
-            QChart*                                                   chartItem,
+            QGraphicsItem*                                            plotItem,
             Plot2DPresentationData*                                   presentationData,
             const QMap<Ld::PlotFormat::AxisLocation, QAbstractAxis*>& axisByLocation
         );
+
+    private:
+        /**
+         * Method that adds a series to a QChart or \ref NativePlotItem instance.
+         *
+         * \param[in] plotItem The QChart or \ref NativePlotItem instance to receive the series.
+         *
+         * \param[in] series   The series to be added.
+         */
+        static void addSeries(QGraphicsItem* plotItem, QXYSeries* series);
+
+        /**
+         * Method that ties a series to an axis in a QChart or \ref NativePlotItem instance.
+         *
+         * \param[in] plotItem     The QChart or \ref NativePlotItem instance holding the series.
+         *
+         * \param[in] series       The series to be tied to the axis.
+         *
+         * \param[in] axis         The Qt axis.
+         *
+         * \param[in] axisLocation The location of the axis.
+         */
+        static void attachAxis(
+            QGraphicsItem*               plotItem,
+            QXYSeries*                   series,
+            QAbstractAxis*               axis,
+            Ld::PlotFormat::AxisLocation axisLocation
+        );
 };
 
 #endif
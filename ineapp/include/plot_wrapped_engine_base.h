@@ -16,6 +16,7 @@
 #include <QSharedPointer>
 #include <QList>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QIcon>
 #include <QImage>
@@ -34,6 +35,7 @@
 class QGraphicsItem;
 class QColor;
 
+class NativePlotItem;
 class PlotPresentationData;
 class Plot2DPresentationData;
 
@@ -54,6 +56,32 @@ class APP_PUBLIC_API PlotWrappedEngineBase:public PlotEngine {
 
         ~PlotWrappedEngineBase() override;
 
+        /**
+         * Method you can use to select the renderer used by an engine.  The setting is ignored by engines that do not
+         * support the \ref NativePlotItem renderer.
+         *
+         * \param[in] engineName The name of the engine to be configured.
+         *
+         * \param[in] nowEnabled If true, new plots from the engine will be rendered using a \ref NativePlotItem.  If
+         *                       false, new plots from the engine will be rendered using a QChart.
+         */
+        static void setNativeRendererEnabled(const QString& engineName, bool nowEnabled = true);
+
+        /**
+         * Method you can use to determine if this engine supports rendering through a \ref NativePlotItem.
+         *
+         * \return Returns true if the engine can render plots using a \ref NativePlotItem.  This version returns
+         *         false.
+         */
+        virtual bool supportsNativeRenderer() const;
+
+        /**
+         * Method you can use to determine if this engine will render new plots using a \ref NativePlotItem.
+         *
+         * \return Returns true if the native renderer is supported and has been selected for this engine.
+         */
+        bool nativeRendererEnabled() const;
+
     protected:
         /**
          * Method that configures a QChart object using the supplied element and format.  This method will configure
@@ -71,6 +99,22 @@ class APP_PUBLIC_API PlotWrappedEngineBase:public PlotEngine {
             QSharedPointer<Ld::PlotFormat>  plotFormat
         ) const;
 
+        /**
+         * Method that configures a \ref NativePlotItem object using the supplied element and format.  This method
+         * will configure plot borders, background colors, and the plot title.
+         *
+         * \param[in] plotItem    The native plot item to be configured.
+         *
+         * \param[in] plotElement The plot element used to create the plot.
+         *
+         * \param[in] plotFormat  The plot format instance used to create the plot.
+         */
+        void configureChart(
+            NativePlotItem*                 plotItem,
+            QSharedPointer<Ld::PlotElement> plotElement,
+            QSharedPointer<Ld::PlotFormat>  plotFormat
+        ) const;
+
         /**
          * Method that configures a Qt axis from a Ld::ChartAxisFormat instance.
          *
@@ -124,6 +168,15 @@ class APP_PUBLIC_API PlotWrappedEngineBase:public PlotEngine {
             bool                  honorMarkerShape = true
         );
 
+        /**
+         * Method that configures the legend of a \ref NativePlotItem.
+         *
+         * \param[in] plotItem   The native plot item holding the legend.
+         *
+         * \param[in] plotFormat The plot format instance providing the configuration data for the legend.
+         */
+        static void configureLegend(NativePlotItem* plotItem, const Ld::PlotFormat& plotFormat);
+
         /**
          * Method that determines the Qt axis alignment setting for an axis.
          *
@@ -150,6 +203,12 @@ class APP_PUBLIC_API PlotWrappedEngineBase:public PlotEngine {
          * \return Returns the clarified color.
          */
         static QColor validateBackgroundColor(const QColor& inputColor);
+
+    private:
+        /**
+         * The names of the engines that should render using a \ref NativePlotItem.
+         */
+        static QSet<QString> nativeRendererEngineNames;
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include "plot_presentation_data.h"
 
 class QGraphicsItem;
+class NativePlotItem;
 
 namespace EQt {
     class GraphicsItem;
@@ -32,15 +33,16 @@ namespace Ld {
 
 /**
  * Pure virtual base class you can use to manage plots.  The class wraps the actual chart instance within a group
- * allowing for the displaying of error messages as well as error borders.
+ * allowing for the displaying of error messages as well as error borders.  The chart instance can either be a
+ * QtCharts::QChart or a \ref NativePlotItem.
  */
 class APP_PUBLIC_API PlotWrappedPresentationData:public PlotPresentationData {
     public:
         /**
          * Constructor
          *
-         * \param[in] graphicsItem The graphics item to be managed.  This instance must be derived from both
-         *                         EQt::GraphicsItem and QChart
+         * \param[in] graphicsItem The graphics item to be managed.  This instance must be derived from
+         *                         EQt::GraphicsItem and either QChart or \ref NativePlotItem.
          */
         PlotWrappedPresentationData(EQt::GraphicsItem* graphicsItem = Q_NULLPTR);
 
@@ -62,6 +64,13 @@ class APP_PUBLIC_API PlotWrappedPresentationData:public PlotPresentationData {
          */
         QRectF sceneBoundingRectangle() const override;
 
+        /**
+         * Method you can use to obtain the area used to draw the plot series.
+         *
+         * \return Returns the plot area, in chart item coordinates.
+         */
+        QRectF plotArea() const;
+
         /**
          * Method you can use to set an error message.
          *
@@ -174,10 +183,26 @@ class APP_PUBLIC_API PlotWrappedPresentationData:public PlotPresentationData {
         /**
          * Method you can use to get the underlying chart item.
          *
-         * \return Returns a pointer to the chart item.
+         * \return Returns a pointer to the chart item.  A null pointer is returned if the plot is rendered by a
+         *         \ref NativePlotItem.
          */
         QChart* chartItem() const;
 
+        /**
+         * Method you can use to get the underlying native plot item.
+         *
+         * \return Returns a pointer to the native plot item.  A null pointer is returned if the plot is rendered by
+         *         a QChart.
+         */
+        NativePlotItem* nativePlotItem() const;
+
+        /**
+         * Method you can use to get the underlying chart or native plot item as a graphics item.
+         *
+         * \return Returns a pointer to the graphics item used to render the plot.
+         */
+        QGraphicsItem* plotGraphicsItem() const;
+
     private:
         /**
          * The current chart item.
@@ -188,6 +213,11 @@ class APP_PUBLIC_API PlotWrappedPresentationData:public PlotPresentationData {
          * The current chart item, cast as a QtChart::QChart instance.
          */
         QChart* currentChartItem;
+
+        /**
+         * The current chart item, cast as a \ref NativePlotItem instance.
+         */
+        NativePlotItem* currentNativePlotItem;
 };
 
 #endif
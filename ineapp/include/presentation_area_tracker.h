@@ -15,11 +15,16 @@
 #include <QObject>
 #include <QList>
 #include <QSizeF>
+#include <QPointF>
 
 #include "app_common.h"
 
 class QGraphicsItem;
 
+namespace EQt {
+    class GraphicsItemGroup;
+}
+
 class Presentation;
 
 /**
@@ -245,6 +250,39 @@ class APP_PUBLIC_API PresentationAreaTracker {
          */
         void removeFromScene();
 
+        /**
+         * Method you can use to determine if this tracker describes the same layout as another tracker.  Two trackers
+         * describe the same layout if they track the same child presentation and hold the same presentation areas with
+         * identical sizes and ascents.  A parent can skip rebuilding its graphics item when every re-placed child
+         * reports the same layout as before.
+         *
+         * \param[in] other The tracker to compare against.
+         *
+         * \return Returns true if the layouts are identical.  Returns false if the layouts differ.
+         */
+        bool hasSameLayout(const PresentationAreaTracker& other) const;
+
+        /**
+         * Method you can use to obtain the current position of each presentation area's graphics item.
+         *
+         * \return Returns the position of each presentation area, in order.  An empty list is returned if any
+         *         presentation area does not have a graphics item.
+         */
+        QList<QPointF> positions() const;
+
+        /**
+         * Method you can use to place each presentation area's graphics item at a previously recorded position.  The
+         * graphics items are added to the supplied group if needed.
+         *
+         * \param[in] graphicsItemGroup The group that should hold the graphics items.
+         *
+         * \param[in] positions         The positions, as returned by \ref PresentationAreaTracker::positions.
+         *
+         * \return Returns true on success.  Returns false if the number of positions does not match the number of
+         *         presentation areas or a presentation area does not have a graphics item.
+         */
+        bool restorePositions(EQt::GraphicsItemGroup* graphicsItemGroup, const QList<QPointF>& positions) const;
+
         /**
          * Method you can use to obtain the number of tracked presentation areas for a given child.
          *
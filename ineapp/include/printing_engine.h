@@ -18,6 +18,11 @@
 #include <QSharedPointer>
 #include <QWeakPointer>
 #include <QSizeF>
+#include <QRectF>
+#include <QPicture>
+#include <QImage>
+#include <QSemaphore>
+#include <QAtomicInt>
 
 #include "app_common.h"
 
@@ -27,11 +32,18 @@ class QPainter;
 
 namespace Ld {
     class RootElement;
+    class PageFormat;
 };
 
+class RootPresentation;
+
 /**
  * Class you can use to perform printing operations in a background thread.  Note that this class does not take
  * ownership of any object and assumes objects remain valid and invariant during an entire printing operation.
+ *
+ * When one of the display list rendering modes is selected, page contents are captured on the thread that owns the
+ * document scene and the printing thread only ever sees the captured display lists.  The thread owning the scene must
+ * be running an event loop while printing is in progress.
  */
 class APP_PUBLIC_API PrintingEngine:public QThread {
     Q_OBJECT
@@ -62,11 +74,43 @@ class APP_PUBLIC_API PrintingEngine:public QThread {
             ABORTED
         };
 
+        /**
+         * Enumeration of supported page rendering modes.
+         */
+        enum class RenderingMode {
+            /**
+             * Indicates pages are rendered from the document scene directly onto the printer, one page at a time.
+             */
+            DIRECT,
+
+            /**
+             * Indicates pages are captured into display lists on the scene's thread and played back onto the printer
+             * in page order.  Capture of later pages overlaps output of earlier pages.  Output remains vector.
+             *
+             * Playback onto the printer, including PDF output, is performed serially by the printing thread.  Pages
+             * are not rendered in parallel in this mode.
+             */
+            VECTOR_DISPLAY_LISTS,
+
+            /**
+             * Indicates pages are captured into display lists on the scene's thread, rasterized in parallel by worker
+             * threads, and streamed to the printer in page order.  Pixmaps are recorded as images so the display
+             * lists can be played back off the GUI thread.  Output is raster and text is not selectable so this mode
+             * must be explicitly selected.
+             */
+            RASTER_DISPLAY_LISTS
+        };
+
         /**
          * Type used to represent a list of pages to be printed.
          */
         typedef QList<unsigned> PageList;
 
+        /**
+         * The default resolution used to rasterize pages, in dots per inch.
+         */
+        static const unsigned defaultRasterResolution = 300;
+
         /**
          * Constructor.
          *
@@ -182,6 +226,35 @@ class APP_PUBLIC_API PrintingEngine:public QThread {
          */
         void clearPageList();
 
+        /**
+         * Method you can use to determine how pages will be rendered.
+         *
+         * \return Returns the current rendering mode.
+         */
+        RenderingMode renderingMode() const;
+
+        /**
+         * Method you can use to select how pages will be rendered on the next run.
+         *
+         * \param[in] newRenderingMode The new rendering mode.
+         */
+        void setRenderingMode(RenderingMode newRenderingMode);
+
+        /**
+         * Method you can use to obtain the resolution used to rasterize pages.
+         *
+         * \return Returns the raster resolution, in dots per inch.
+         */
+        unsigned rasterResolution() const;
+
+        /**
+         * Method you can use to set the resolution used to rasterize pages when the rendering mode is
+         * \ref PrintingEngine::RenderingMode::RASTER_DISPLAY_LISTS.
+         *
+         * \param[in] newRasterResolution The new raster resolution, in dots per inch.
+         */
+        void setRasterResolution(unsigned newRasterResolution);
+
         /**
          * Method you can call to determine if this printing engine is active.
          *
@@ -267,6 +340,137 @@ class APP_PUBLIC_API PrintingEngine:public QThread {
         void abort();
 
     private:
+        /**
+         * Class that holds the captured contents of a single page.  Instances are created on the thread owning the
+         * document scene and are not modified once they are handed to other threads, other than to attach the
+         * rasterized page.
+         */
+        class PageDisplayList {
+            public:
+                PageDisplayList();
+
+                /**
+                 * Constructor.
+                 *
+                 * \param[in] pageNumber       The one-based page number of the captured page.
+                 *
+                 * \param[in] pageFormat       The page format of the captured page.
+                 *
+                 * \param[in] pictureRectangle The area of the picture holding the page, in points.
+                 *
+                 * \param[in] picture          The captured page contents.
+                 */
+                PageDisplayList(
+                    unsigned                       pageNumber,
+                    QSharedPointer<Ld::PageFormat> pageFormat,
+                    const QRectF&                  pictureRectangle,
+                    const QPicture&                picture
+                );
+
+                ~PageDisplayList();
+
+                /**
+                 * Method you can use to obtain the page number of the captured page.
+                 *
+                 * \return Returns the one-based page number.
+                 */
+                unsigned pageNumber() const;
+
+                /**
+                 * Method you can use to obtain the page format of the captured page.
+                 *
+                 * \return Returns the page format.
+                 */
+                QSharedPointer<Ld::PageFormat> pageFormat() const;
+
+                /**
+                 * Method you can use to obtain the area of the picture holding the page.
+                 *
+                 * \return Returns the picture area, in points.
+                 */
+                const QRectF& pictureRectangle() const;
+
+                /**
+                 * Method you can use to obtain the captured page contents.
+                 *
+                 * \return Returns the captured page contents.
+                 */
+                const QPicture& picture() const;
+
+                /**
+                 * Method you can use to obtain the rasterized page.
+                 *
+                 * \return Returns the rasterized page.  A null image is returned if the page has not been rasterized.
+                 */
+                const QImage& image() const;
+
+                /**
+                 * Method that rasterizes the captured page contents.  This method can be called from any thread.
+                 *
+                 * \param[in] resolution The resolution to rasterize at, in dots per inch.
+                 */
+                void rasterize(unsigned resolution);
+
+            private:
+                /**
+                 * The one-based page number.
+                 */
+                unsigned currentPageNumber;
+
+                /**
+                 * The page format.
+                 */
+                QSharedPointer<Ld::PageFormat> currentPageFormat;
+
+                /**
+                 * The picture area, in points.
+                 */
+                QRectF currentPictureRectangle;
+
+                /**
+                 * The captured page contents.
+                 */
+                QPicture currentPicture;
+
+                /**
+                 * The rasterized page contents.
+                 */
+                QImage currentImage;
+        };
+
+        /**
+         * Class that holds a single capture request.  The request is shared between the printing thread and the
+         * capture queued to the scene's thread so that either side can safely outlive the other.
+         */
+        class CaptureRequest {
+            public:
+                /**
+                 * The captured pages.
+                 */
+                QList<PageDisplayList> displayLists;
+
+                /**
+                 * Semaphore that is released once when the capture completes.
+                 */
+                QSemaphore completed;
+
+                /**
+                 * Flag set by the printing thread when it stops waiting for the capture.  A capture that has not yet
+                 * run is skipped.
+                 */
+                QAtomicInt cancelled;
+        };
+
+        /**
+         * Interval used to check for an abort while waiting for a capture, in milliseconds.
+         */
+        static const int captureAbortPollingIntervalMSec = 50;
+
+        /**
+         * Interval used to check if the document scene has settled before a capture, in milliseconds.
+         */
+        static const int captureSettlePollingIntervalMSec = 10;
+
         /**
          * Value indicating the allowed error in page sizes before page scaling is applied.
          */
@@ -297,6 +501,134 @@ class APP_PUBLIC_API PrintingEngine:public QThread {
             unsigned                        pageIndex
         );
 
+        /**
+         * Method that configures the printer for a new page and, if needed, starts a new page.
+         *
+         * \param[in]     printer    A pointer to the printer object to be used by this class.
+         *
+         * \param[in,out] painter    A pointer to the painter we should paint on.  The painter is created on the first
+         *                           page.
+         *
+         * \param[in]     pageFormat The format of the page to be started.
+         *
+         * \return Returns the paper rectangle, in device pixels.
+         */
+        QRectF startPage(QPrinter* printer, QPainter*& painter, QSharedPointer<Ld::PageFormat> pageFormat);
+
+        /**
+         * Method that prints pages using display lists.  This method emits the \ref PrintingEngine::completedPage
+         * signal as each page is spooled.
+         *
+         * \param[in]     printer     A pointer to the printer object to be used by this class.
+         *
+         * \param[in,out] painter     A pointer to the painter we should paint on.
+         *
+         * \param[in]     rootElement The root element of the program to be printed.
+         *
+         * \param[in]     pageList    The one-based page numbers to be printed, in printing order.
+         *
+         * \return Returns a string indicating the print error that occurred.  An empty string indicates no error.
+         */
+        QString printDisplayLists(
+            QPrinter*                       printer,
+            QPainter*&                      painter,
+            QSharedPointer<Ld::RootElement> rootElement,
+            const PageList&                 pageList
+        );
+
+        /**
+         * Method that requests capture of a batch of pages on the thread owning the document scene.  The capture is
+         * always queued to that thread's event loop so the method returns immediately.
+         *
+         * \param[in] rootPresentation The root presentation holding the pages.
+         *
+         * \param[in] rootElement      The root element of the program to be printed.
+         *
+         * \param[in] pageNumbers      The one-based page numbers of the pages to be captured.
+         *
+         * \param[in] forRaster        If true, the pages are captured for rasterization on worker threads.
+         *
+         * \return Returns the capture request.  Use \ref waitForCapture to wait for the captured pages.
+         */
+        QSharedPointer<CaptureRequest> requestDisplayLists(
+            RootPresentation*               rootPresentation,
+            QSharedPointer<Ld::RootElement> rootElement,
+            const PageList&                 pageNumbers,
+            bool                            forRaster
+        );
+
+        /**
+         * Method that waits for a capture to complete.  The wait ends early if an abort is requested so that a thread
+         * waiting for this engine never blocks a capture queued to the same thread.
+         *
+         * \param[in] rootPresentation The root presentation holding the pages.  Events are processed while waiting if
+         *                             this method is called on the thread owning the document scene.
+         *
+         * \param[in] request          The capture request to wait for.
+         *
+         * \return Returns true if the capture completed.  Returns false if the wait was abandoned due to an abort.
+         */
+        bool waitForCapture(RootPresentation* rootPresentation, QSharedPointer<CaptureRequest> request);
+
+        /**
+         * Method that captures a batch of pages once the document scene has settled.  Pending image decodes are
+         * applied first.  Applying a decode can replace graphics items and request repositioning so the capture is
+         * retried from the event loop until the repositioning has completed.  This method must be called on the
+         * thread owning the document scene.
+         *
+         * \param[in] rootPresentation The root presentation holding the pages.
+         *
+         * \param[in] rootElement      The root element of the program to be printed.
+         *
+         * \param[in] pageNumbers      The one-based page numbers of the pages to be captured.
+         *
+         * \param[in] forRaster        If true, the pages are captured for rasterization on worker threads.
+         *
+         * \param[in] request          The capture request to receive the captured pages.
+         */
+        static void captureWhenSettled(
+            RootPresentation*               rootPresentation,
+            QSharedPointer<Ld::RootElement> rootElement,
+            const PageList&                 pageNumbers,
+            bool                            forRaster,
+            QSharedPointer<CaptureRequest>  request
+        );
+
+        /**
+         * Method that captures a single page into a display list.  This method must be called on the thread owning the
+         * document scene.
+         *
+         * \param[in] rootPresentation The root presentation holding the page.
+         *
+         * \param[in] rootElement      The root element of the program to be printed.
+         *
+         * \param[in] pageNumber       The one-based page number of the page to capture.
+         *
+         * \param[in] forRaster        If true, pixmaps are recorded as images.  QPicture creates a QPixmap for every
+         *                             recorded pixmap on playback and pixmaps can only be used on the GUI thread.
+         *
+         * \return Returns the captured page.
+         */
+        static PageDisplayList captureDisplayList(
+            RootPresentation*               rootPresentation,
+            QSharedPointer<Ld::RootElement> rootElement,
+            unsigned                        pageNumber,
+            bool                            forRaster
+        );
+
+        /**
+         * Method that spools a single captured page to the printer.
+         *
+         * \param[in]     printer     A pointer to the printer object to be used by this class.
+         *
+         * \param[in,out] painter     A pointer to the painter we should paint on.
+         *
+         * \param[in]     displayList The captured page.
+         *
+         * \return Returns a string indicating the print error that occurred.  An empty string indicates no error.
+         */
+        QString printDisplayList(QPrinter* printer, QPainter*& painter, const PageDisplayList& displayList);
+
         /**
          * The currently selected printer.
          */
@@ -317,6 +649,16 @@ class APP_PUBLIC_API PrintingEngine:public QThread {
          */
         PageList currentPageList;
 
+        /**
+         * The current rendering mode.
+         */
+        RenderingMode currentRenderingMode;
+
+        /**
+         * The current raster resolution, in dots per inch.
+         */
+        unsigned currentRasterResolution;
+
         /**
          * Flag that is used to signal that an abort has been requested.
          */
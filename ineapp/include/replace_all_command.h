@@ -0,0 +1,219 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref ReplaceAllCommand class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef REPLACE_ALL_COMMAND_H
+#define REPLACE_ALL_COMMAND_H
+
+#include <QCoreApplication> // For Q_DECLARE_TR_FUNCTIONS macro.
+#include <QString>
+#include <QList>
+
+#include <ld_element_cursor.h>
+
+#include "app_common.h"
+#include "cursor.h"
+#include "command_base.h"
+
+namespace Ld {
+    class CursorStateCollection;
+}
+
+class CommandContainer;
+
+/**
+ * Command that replaces any number of text ranges as a single undoable operation.  Every range must lie within a
+ * single text region.  Because every edit is applied by one command, the document is repositioned once after the
+ * command completes rather than once per replacement.
+ */
+class APP_PUBLIC_API ReplaceAllCommand:public CommandBase {
+    Q_DECLARE_TR_FUNCTIONS(ReplaceAllCommand)
+
+    public:
+        /**
+         * Class that describes a single replacement.
+         */
+        class APP_PUBLIC_API Replacement {
+            public:
+                Replacement();
+
+                /**
+                 * Constructor.
+                 *
+                 * \param[in] position The position of the first character to be replaced.
+                 *
+                 * \param[in] oldText  The text to be replaced.
+                 *
+                 * \param[in] newText  The replacement text.
+                 */
+                Replacement(const Ld::ElementCursor& position, const QString& oldText, const QString& newText);
+
+                /**
+                 * Copy constructor.
+                 *
+                 * \param[in] other The instance to be copied.
+                 */
+                Replacement(const Replacement& other);
+
+                ~Replacement();
+
+                /**
+                 * Method you can use to obtain the position of the replaced text.
+                 *
+                 * \return Returns the position of the first character to be replaced.
+                 */
+                const Ld::ElementCursor& position() const;
+
+                /**
+                 * Method you can use to obtain the text to be replaced.
+                 *
+                 * \return Returns the text to be replaced.
+                 */
+                const QString& oldText() const;
+
+                /**
+                 * Method you can use to obtain the replacement text.
+                 *
+                 * \return Returns the replacement text.
+                 */
+                const QString& newText() const;
+
+                /**
+                 * Assignment operator.
+                 *
+                 * \param[in] other The instance to be copied.
+                 *
+                 * \return Returns a reference to this instance.
+                 */
+                Replacement& operator=(const Replacement& other);
+
+            private:
+                /**
+                 * The position of the first replaced character.
+                 */
+                Ld::ElementCursor currentPosition;
+
+                /**
+                 * The text to be replaced.
+                 */
+                QString currentOldText;
+
+                /**
+                 * The replacement text.
+                 */
+                QString currentNewText;
+        };
+
+        /**
+         * Constructor
+         *
+         * \param[in] replacements The replacements to be performed, in document order.
+         */
+        ReplaceAllCommand(const QList<Replacement>& replacements);
+
+        /**
+         * Constructor
+         *
+         * \param[in] replacements The replacements to be performed, in document order.
+         *
+         * \param[in] newCursor    Cursor being used to track the position in the document.
+         */
+        ReplaceAllCommand(const QList<Replacement>& replacements, CursorPointer newCursor);
+
+        ~ReplaceAllCommand() override;
+
+        /**
+         * Method that returns the command type.
+         *
+         * \return Returns the command type value.
+         */
+        CommandType commandType() const final;
+
+        /**
+         * Method that executes the command.  If a replacement fails, the replacements already applied are reverted
+         * before the method returns.
+         *
+         * \param[in,out] cursorStateCollection The collection of every cursor that may need adjustment for this
+         *                                      command.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        bool execute(Ld::CursorStateCollection* cursorStateCollection) final;
+
+        /**
+         * Method that performs an undo of the command using stored information.  Only replacements that are
+         * currently applied are reverted.
+         *
+         * \param[in,out] cursorStateCollection The collection of every cursor that may need adjustment for this
+         *                                      command.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        bool undo(Ld::CursorStateCollection* cursorStateCollection) final;
+
+        /**
+         * Method that returns a description of the command suitable for displaying in an undo/redo stack window.
+         *
+         * \return Returns a description of the command.
+         */
+        QString description() const final;
+
+        /**
+         * Method you can use to obtain the replacements performed by this command.
+         *
+         * \return Returns the replacements, in document order.
+         */
+        const QList<Replacement>& replacements() const;
+
+    private:
+        /**
+         * Method that replaces a single range of text.
+         *
+         * \param[in]     position              The position of the first character to be replaced.
+         *
+         * \param[in]     oldText               The text currently at the position.
+         *
+         * \param[in]     newText               The text to be placed at the position.
+         *
+         * \param[in,out] cursorStateCollection The collection of every cursor that may need adjustment.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        static bool replaceText(
+            const Ld::ElementCursor&   position,
+            const QString&             oldText,
+            const QString&             newText,
+            Ld::CursorStateCollection* cursorStateCollection
+        );
+
+        /**
+         * Method that reverts the applied replacements, first to last.  Once the earlier replacements in a region are
+         * restored, each later replacement is back at its recorded position.
+         *
+         * \param[in,out] cursorStateCollection The collection of every cursor that may need adjustment.
+         *
+         * \return Returns true on success, returns false on error.  On error, \ref numberApplied holds the number
+         *         of replacements that remain applied.
+         */
+        bool revertApplied(Ld::CursorStateCollection* cursorStateCollection);
+
+        /**
+         * The replacements, in document order.
+         */
+        QList<Replacement> currentReplacements;
+
+        /**
+         * The number of replacements currently applied.  Replacements are applied last to first so the applied
+         * replacements are always the last entries of \ref currentReplacements.
+         */
+        int numberApplied;
+};
+
+#endif
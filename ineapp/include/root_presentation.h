@@ -40,6 +40,7 @@
 #include "scene_units.h"
 #include "placement_status_notifier.h"
 #include "placement_negotiator.h"
+#include "document_text_index.h"
 
 class QGraphicsItem;
 class QPainter;
@@ -148,6 +149,19 @@ class APP_PUBLIC_API RootPresentation:public EQt::GraphicsScene,
          */
         void requestRepositioning(Presentation* childPresentation) final;
 
+        /**
+         * Method you can use to start a batch of edits.  While a batch is open, repositioning requests from children
+         * are recorded rather than acted on.  Batches can be nested.
+         */
+        void beginRepositioningBatch();
+
+        /**
+         * Method you can use to end a batch of edits started with \ref RootPresentation::beginRepositioningBatch.
+         * Ending the outermost batch issues a single repositioning request covering every child that requested
+         * repositioning during the batch.
+         */
+        void endRepositioningBatch();
+
         /**
          * Method that is called by a parent to a child to tell the child to start the placement operation,
          * recalculating sizes and positions.  This method will repeatedly call the parent's instance of
@@ -329,6 +343,13 @@ class APP_PUBLIC_API RootPresentation:public EQt::GraphicsScene,
          */
         bool arePresentationUpdatesPending() const;
 
+        /**
+         * Method you can use to obtain the searchable text index for this document.
+         *
+         * \return Returns a reference to the text index.
+         */
+        DocumentTextIndex& textIndex();
+
         /**
          * Method you can use to identify every view that is showing part or all of an element.
          *
@@ -471,6 +492,47 @@ class APP_PUBLIC_API RootPresentation:public EQt::GraphicsScene,
          */
         bool isDisplayCoherent() const;
 
+        /**
+         * Method you can use to estimate the memory held by the graphics items in this scene.  The estimate includes
+         * a fixed overhead per item plus the pixels held by pixmap items.
+         *
+         * \return Returns the estimated scene memory, in bytes.
+         */
+        unsigned long long estimatedSceneBytes() const;
+
+        /**
+         * Method you can use to release the graphics items and pages of this document while keeping the element
+         * tree.  Repositioning requests received while the scene is released are deferred until
+         * \ref RootPresentation::restoreScene is called.  The call is ignored if repositioning is in progress.
+         *
+         * \return Returns true if the scene was released.  Returns false if the scene was already released or
+         *         repositioning is in progress.
+         */
+        bool releaseScene();
+
+        /**
+         * Method you can use to lay out a released scene again.  The scene is rebuilt asynchronously, in the same way
+         * as \ref RootPresentation::redraw.
+         */
+        void restoreScene();
+
+        /**
+         * Method you can use to determine if the scene has been released.
+         *
+         * \return Returns true if the scene has been released.  Returns false if the scene is laid out, or is being
+         *         laid out.
+         */
+        bool isSceneReleased() const;
+
+        /**
+         * Method you can use to determine if the scene may have been rearranged.  The value changes each time this
+         * presentation starts repositioning or releases the scene and can be used to validate geometry cached
+         * outside of the presentations.
+         *
+         * \return Returns the current placement generation.
+         */
+        unsigned long long placementGeneration() const;
+
     signals:
         /**
          * Signal that is emitted when presentation updates first become pending.
@@ -1269,6 +1331,15 @@ class APP_PUBLIC_API RootPresentation:public EQt::GraphicsScene,
          */
         void removeFromScene() final;
 
+        /**
+         * Method that removes the presentations of every descendant of an element from the scene, deepest
+         * descendants first.  Used when the scene is released since \ref RootPresentation::resetPlacement leaves
+         * graphics items owned by nested presentations, such as operators, in place.
+         *
+         * \param[in] element The element whose descendants should be removed from the scene.
+         */
+        static void removeDescendantsFromScene(Ld::ElementPointer element);
+
         /**
          * Method that is used to obtain an active area rectangle.
          *
@@ -1376,6 +1447,11 @@ class APP_PUBLIC_API RootPresentation:public EQt::GraphicsScene,
          */
         PlacementStatusNotifier* placementStatusNotifier;
 
+        /**
+         * The searchable text index.
+         */
+        DocumentTextIndex currentTextIndex;
+
         /**
          * The index of the first child to perform repositioning on.
          */
@@ -1407,6 +1483,26 @@ class APP_PUBLIC_API RootPresentation:public EQt::GraphicsScene,
          */
         bool repositionRequestPending;
 
+        /**
+         * The current repositioning batch nesting depth.  A value of zero indicates no batch is open.
+         */
+        unsigned long repositioningBatchDepth;
+
+        /**
+         * Flag that indicates that the scene has been released.
+         */
+        bool currentSceneReleased;
+
+        /**
+         * Value that is incremented each time the scene may have been rearranged.
+         */
+        unsigned long long currentPlacementGeneration;
+
+        /**
+         * The children that requested repositioning while a batch was open.
+         */
+        QSet<Ld::ElementPointer> batchedRepositioningRequests;
+
         /**
          * List of locations for each child of the root presentation.  This list is used to short-circuit processing
          * of placement.
@@ -0,0 +1,386 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref SceneTileCache class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef SCENE_TILE_CACHE_H
+#define SCENE_TILE_CACHE_H
+
+#include <QRect>
+#include <QRectF>
+#include <QPointF>
+#include <QRegion>
+#include <QPixmap>
+#include <QHash>
+#include <QMap>
+#include <QList>
+#include <QSet>
+#include <QBrush>
+
+#include <util_hash_functions.h>
+
+#include "app_common.h"
+#include "page_list.h"
+
+class QPainter;
+class QGraphicsView;
+class RootPresentation;
+
+/**
+ * Class that caches rendered tiles of the pages of a document so that scrolling and zooming a view does not require
+ * the scene to be rendered again.
+ *
+ * Tiles are square, \ref SceneTileCache::tileSize viewport pixels on a side, and are aligned to the top-left corner of
+ * each page.  Tiles are keyed by page, tile column, tile row and zoom level so that returning to a previous zoom level
+ * reuses the tiles rendered at that level.  Tiles are discarded when the scene areas they cover change, when their
+ * page moves and, least recently used first, when the cache exceeds its memory budget.
+ *
+ * When the zoom level changes, tiles cached at another zoom level are scaled to cover the area and the sharp tiles are
+ * queued.  The owner renders queued tiles a few at a time, while the application is otherwise idle, by calling
+ * \ref SceneTileCache::refine.  Areas outside of any page are not cached.
+ *
+ * Scene items can only be rendered on the GUI thread so this class is intended for use from the GUI thread.
+ */
+class APP_PUBLIC_API SceneTileCache {
+    public:
+        /**
+         * The size of a tile, in viewport pixels.
+         */
+        static constexpr int tileSize = 256;
+
+        /**
+         * The default memory budget for cached tiles, in bytes.
+         */
+        static constexpr unsigned long long defaultMaximumBytes = 128ULL * 1024ULL * 1024ULL;
+
+        /**
+         * The number of queued tiles rendered by each call to \ref SceneTileCache::refine.
+         */
+        static constexpr unsigned tilesPerRefinement = 4;
+
+        SceneTileCache();
+
+        ~SceneTileCache();
+
+        /**
+         * Method you can use to set the memory budget for cached tiles.
+         *
+         * \param[in] newMaximumBytes The new memory budget, in bytes.
+         */
+        void setMaximumBytes(unsigned long long newMaximumBytes);
+
+        /**
+         * Method you can use to obtain the memory budget for cached tiles.
+         *
+         * \return Returns the memory budget, in bytes.
+         */
+        unsigned long long maximumBytes() const;
+
+        /**
+         * Method you can use to obtain the memory currently used by cached tiles.
+         *
+         * \return Returns the memory in use, in bytes.
+         */
+        unsigned long long bytesInUse() const;
+
+        /**
+         * Method you can use to obtain the number of cached tiles.
+         *
+         * \return Returns the number of cached tiles.
+         */
+        unsigned long numberTiles() const;
+
+        /**
+         * Method you can use to draw the pages visible in a portion of a view from cached tiles.  Missing tiles are
+         * rendered, or drawn scaled from another zoom level and queued for refinement.
+         *
+         * \param[in] painter          The painter to receive the tiles.  The painter must use viewport coordinates.
+         *
+         * \param[in] viewportRegion   The region to be drawn, in viewport coordinates.
+         *
+         * \param[in] view             The view being drawn.
+         *
+         * \param[in] rootPresentation The document displayed by the view.
+         *
+         * \param[in] background       The brush used to fill tiles before the scene is rendered.
+         *
+         * \return Returns the portion of the region that is not covered by any page.  The caller is responsible for
+         *         rendering this portion.
+         */
+        QRegion draw(
+            QPainter*             painter,
+            const QRegion&        viewportRegion,
+            const QGraphicsView*  view,
+            RootPresentation*     rootPresentation,
+            const QBrush&         background
+        );
+
+        /**
+         * Method you can use to determine if tiles are queued for refinement.
+         *
+         * \return Returns true if tiles are queued.  Returns false if every drawn tile is sharp.
+         */
+        bool refinementPending() const;
+
+        /**
+         * Method you can use to render queued tiles.  At most \ref SceneTileCache::tilesPerRefinement tiles are
+         * rendered.  Tiles queued at a zoom level other than the view's current zoom level are discarded.
+         *
+         * \param[in] view             The view being drawn.
+         *
+         * \param[in] rootPresentation The document displayed by the view.
+         *
+         * \param[in] background       The brush used to fill tiles before the scene is rendered.
+         *
+         * \return Returns the region of the view, in viewport coordinates, covered by the newly rendered tiles.  The
+         *         caller should draw this region again.
+         */
+        QRegion refine(const QGraphicsView* view, RootPresentation* rootPresentation, const QBrush& background);
+
+        /**
+         * Method you can use to discard tiles covering a portion of the scene, at every zoom level.
+         *
+         * \param[in] sceneRectangle The changed area, in scene coordinates.
+         */
+        void invalidate(const QRectF& sceneRectangle);
+
+        /**
+         * Method you can use to discard every tile.
+         */
+        void clear();
+
+    private:
+        /**
+         * Class used to identify a tile.
+         */
+        class Key {
+            public:
+                Key();
+
+                /**
+                 * Constructor
+                 *
+                 * \param[in] pageIndex The zero based page index.
+                 *
+                 * \param[in] column    The zero based tile column within the page.
+                 *
+                 * \param[in] row       The zero based tile row within the page.
+                 *
+                 * \param[in] zoomKey   The quantized zoom level.
+                 */
+                Key(PageList::Index pageIndex, int column, int row, int zoomKey);
+
+                /**
+                 * Comparison operator.
+                 *
+                 * \param[in] other The instance to compare against.
+                 *
+                 * \return Returns true if the instances identify the same tile.
+                 */
+                bool operator==(const Key& other) const;
+
+                /**
+                 * Hash function.
+                 *
+                 * \param[in] key  The key to be hashed.
+                 *
+                 * \param[in] seed An optional seed value.
+                 *
+                 * \return Returns a hash of the key.
+                 */
+                friend Util::HashResult qHash(const Key& key, Util::HashSeed seed) {
+                    return (
+                          ::qHash(static_cast<qulonglong>(key.pageIndex), seed)
+                        ^ ::qHash((key.column << 16) ^ key.row, seed)
+                        ^ ::qHash(key.zoomKey, seed)
+                    );
+                }
+
+                /**
+                 * The zero based page index.
+                 */
+                PageList::Index pageIndex;
+
+                /**
+                 * The tile column.
+                 */
+                int column;
+
+                /**
+                 * The tile row.
+                 */
+                int row;
+
+                /**
+                 * The quantized zoom level.
+                 */
+                int zoomKey;
+        };
+
+        /**
+         * Class that holds a rendered tile.
+         */
+        class Tile {
+            public:
+                /**
+                 * The rendered tile.
+                 */
+                QPixmap pixmap;
+
+                /**
+                 * The area covered by the tile, in scene coordinates.
+                 */
+                QRectF sceneRectangle;
+
+                /**
+                 * The position of the page when the tile was rendered, in scene coordinates.
+                 */
+                QPointF pageOrigin;
+
+                /**
+                 * Value used to order tiles by use.
+                 */
+                unsigned long long lastUse;
+        };
+
+        /**
+         * Method that calculates the quantized zoom level for a view.
+         *
+         * \param[in] view The view of interest.
+         *
+         * \return Returns the quantized zoom level.
+         */
+        static int zoomKey(const QGraphicsView* view);
+
+        /**
+         * Method that calculates the scale between scene units and viewport pixels for a quantized zoom level.
+         *
+         * \param[in] zoomKey The quantized zoom level.
+         *
+         * \return Returns the scale, in viewport pixels per scene unit.
+         */
+        static double scaleForZoomKey(int zoomKey);
+
+        /**
+         * Method that calculates the scene area covered by a tile.
+         *
+         * \param[in] key        The tile key.
+         *
+         * \param[in] pageOrigin The page origin, in scene coordinates.
+         *
+         * \return Returns the scene area covered by the tile.
+         */
+        static QRectF tileSceneRectangle(const Key& key, const QPointF& pageOrigin);
+
+        /**
+         * Method that renders a tile and adds it to the cache.
+         *
+         * \param[in] key              The tile key.
+         *
+         * \param[in] pageOrigin       The page origin, in scene coordinates.
+         *
+         * \param[in] view             The view being drawn.
+         *
+         * \param[in] rootPresentation The document displayed by the view.
+         *
+         * \param[in] background       The brush used to fill the tile.
+         *
+         * \return Returns a reference to the new tile.
+         */
+        const Tile& renderTile(
+            const Key&            key,
+            const QPointF&        pageOrigin,
+            const QGraphicsView*  view,
+            RootPresentation*     rootPresentation,
+            const QBrush&         background
+        );
+
+        /**
+         * Method that draws a tile scaled from tiles cached at other zoom levels.
+         *
+         * \param[in] painter            The painter to receive the tile.
+         *
+         * \param[in] key                The tile key.
+         *
+         * \param[in] pageOrigin         The page origin, in scene coordinates.
+         *
+         * \param[in] viewportRectangle  The area to be covered, in viewport coordinates.
+         *
+         * \param[in] view               The view being drawn.
+         *
+         * \return Returns true if the area was fully covered.  Returns false if the tile must be rendered.
+         */
+        bool drawScaled(
+            QPainter*             painter,
+            const Key&            key,
+            const QPointF&        pageOrigin,
+            const QRect&          viewportRectangle,
+            const QGraphicsView*  view
+        );
+
+        /**
+         * Method that marks a tile as most recently used.
+         *
+         * \param[in] key  The tile key.
+         *
+         * \param[in] tile The tile.
+         */
+        void touch(const Key& key, Tile& tile);
+
+        /**
+         * Method that removes a tile.
+         *
+         * \param[in] it Iterator to the tile to be removed.
+         *
+         * \return Returns an iterator to the next tile.
+         */
+        QHash<Key, Tile>::iterator removeTile(QHash<Key, Tile>::iterator it);
+
+        /**
+         * Method that discards least recently used tiles until the cache is within budget.
+         */
+        void trim();
+
+        /**
+         * The cached tiles.
+         */
+        QHash<Key, Tile> tiles;
+
+        /**
+         * Tile keys ordered by use, least recently used first.
+         */
+        QMap<unsigned long long, Key> tilesByUse;
+
+        /**
+         * Tiles queued for refinement, in the order they were drawn.
+         */
+        QList<Key> pendingRefinements;
+
+        /**
+         * Set used to avoid queueing a tile more than once.
+         */
+        QSet<Key> queuedTiles;
+
+        /**
+         * Counter used to order tiles by use.
+         */
+        unsigned long long useCounter;
+
+        /**
+         * The memory budget, in bytes.
+         */
+        unsigned long long currentMaximumBytes;
+
+        /**
+         * The memory in use, in bytes.
+         */
+        unsigned long long currentBytesInUse;
+};
+
+#endif
@@ -17,6 +17,7 @@
 #include <QSizeF>
 #include <QFont>
 #include <QColor>
+#include <QVector>
 
 #include <model_set.h>
 #include <model_variant.h>
@@ -170,6 +171,11 @@ class APP_PUBLIC_API SetDataTypePresentationGenerator:public virtual Ld::SetData
         Presentation::ReflowHint reflowHint(bool afterAbort) const override;
 
     private:
+        /**
+         * Type used to hold the visible members of a set, leading members first.
+         */
+        typedef QVector<Model::Variant> MemberList;
+
         /**
          * Method that is called to render a set using the wrapped format.
          *
@@ -180,7 +186,7 @@ class APP_PUBLIC_API SetDataTypePresentationGenerator:public virtual Ld::SetData
          *
          * \param[in]     presenter                Pointer to the presenter requesting the rendering operation.
          *
-         * \param[in]     set                      The set to be rendered.
+         * \param[in]     members                  The visible members of the set.
          *
          * \param[in]     format                   The format to use for the child elements.
          *
@@ -221,7 +227,7 @@ class APP_PUBLIC_API SetDataTypePresentationGenerator:public virtual Ld::SetData
             PlacementTracker*                     placementTracker,
             DataTypePresenter::PresentationAreas& currentPresentationAreas,
             DataTypePresenter*                    presenter,
-            const Model::Set&                     set,
+            const MemberList&                     members,
             Ld::FormatPointer                     format,
             const QFont&                          font,
             const QColor&                         fontColor,
@@ -236,35 +242,58 @@ class APP_PUBLIC_API SetDataTypePresentationGenerator:public virtual Ld::SetData
         ) const;
 
         /**
-         * Method that is called to calculate the maximum ascent and descent across a range of set entries.
+         * Method that is called to collect the visible members of a set.  The set is walked once, skipping the hidden
+         * members.
          *
-         * \param[in]     placementTracker A pointer to the placement tracker that can be used to track and update
-         *                                 status during a time-consuming placement operation.
+         * \param[in] set                 The set to be rendered.
          *
-         * \param[in,out] setIterator      Iterator to the first member of the set to be rendered.
+         * \param[in] leadingMemberCount  The number of children at the front of the set to be rendered.
          *
-         * \param[in]     memberCount      The number of set members to be rendered.
+         * \param[in] hiddenMemberCount   The number of unrendered children.
          *
-         * \param[in]     format           The format to use for the child elements.
+         * \param[in] trailingMemberCount The number of children at the end of the set to be rendered.
          *
-         * \param[in]     relativeScale    A hint value used to indicate if this child should try to scale smaller than
-         *                                 usual. This value is intended for cases where an equation element needs to
-         *                                 be rendered in a smaller than usual font.  A value of 1.0 indicates normal
-         *                                 scale.  The value is intended as a hint, children are not required to honor
-         *                                 this parameter.
+         * \return Returns the visible members, leading members first.
+         */
+        static MemberList visibleMembers(
+            const Model::Set& set,
+            unsigned long     leadingMemberCount,
+            unsigned long     hiddenMemberCount,
+            unsigned long     trailingMemberCount
+        );
+
+        /**
+         * Method that is called to calculate the maximum ascent and descent across the visible members of a set.
          *
-         * \param[in,out] maximumAscent  The working maximum ascent value.
+         * \param[in]     placementTracker  A pointer to the placement tracker that can be used to track and update
+         *                                  status during a time-consuming placement operation.
          *
-         * \param[in,out] maximumDescent The working maximum descent value.
+         * \param[in]     members           The visible members of the set.
+         *
+         * \param[in]     format            The format to use for the child elements.
+         *
+         * \param[in]     relativeScale     A hint value used to indicate if this child should try to scale smaller
+         *                                  than usual. This value is intended for cases where an equation element
+         *                                  needs to be rendered in a smaller than usual font.  A value of 1.0
+         *                                  indicates normal scale.  The value is intended as a hint, children are not
+         *                                  required to honor this parameter.
+         *
+         * \param[in]     cacheMeasurements If true, the member heights are recorded so they can be reused when the
+         *                                  members are rendered.  The member list must remain in place for the
+         *                                  lifetime of the current measurement scope.
+         *
+         * \param[in,out] maximumAscent     The working maximum ascent value.
+         *
+         * \param[in,out] maximumDescent    The working maximum descent value.
          */
         static void calculateMaximumChildHeight(
-            PlacementTracker*          placementTracker,
-            Model::Set::ConstIterator& setIterator,
-            unsigned long              memberCount,
-            Ld::FormatPointer          format,
-            float                      relativeScale,
-            float&                     maximumAscent,
-            float&                     maximumDescent
+            PlacementTracker* placementTracker,
+            const MemberList& members,
+            Ld::FormatPointer format,
+            float             relativeScale,
+            bool              cacheMeasurements,
+            float&            maximumAscent,
+            float&            maximumDescent
         );
 
         /**
@@ -273,7 +302,9 @@ class APP_PUBLIC_API SetDataTypePresentationGenerator:public virtual Ld::SetData
          * \param[in]     placementTracker         A pointer to the placement tracker that can be used to track and
          *                                         update status during a time-consuming placement operation.
          *
-         * \param[in,out] setIterator              Iterator to the first member of the set to be rendered.
+         * \param[in]     members                  The visible members of the set.
+         *
+         * \param[in]     firstIndex               The zero based index of the first member to be rendered.
          *
          * \param[in]     memberCount              The number of set members to be rendered.
          *
@@ -308,7 +339,8 @@ class APP_PUBLIC_API SetDataTypePresentationGenerator:public virtual Ld::SetData
          */
         static void renderSetMembers(
             PlacementTracker*                     placementTracker,
-            Model::Set::ConstIterator&            setIterator,
+            const MemberList&                     members,
+            unsigned long                         firstIndex,
             unsigned long                         memberCount,
             bool&                                 isFirstEntry,
             DataTypePresenter::PresentationAreas& currentPresentationAreas,
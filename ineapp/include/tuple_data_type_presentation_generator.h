@@ -17,6 +17,7 @@
 #include <QSizeF>
 #include <QFont>
 #include <QColor>
+#include <QVector>
 
 #include <model_tuple.h>
 #include <model_variant.h>
@@ -172,6 +173,11 @@ class APP_PUBLIC_API TupleDataTypePresentationGenerator:public virtual Ld::Tuple
         Presentation::ReflowHint reflowHint(bool afterAbort) const override;
 
     private:
+        /**
+         * Type used to hold the visible members of a tuple, leading members first.
+         */
+        typedef QVector<Model::Variant> MemberList;
+
         /**
          * Method that is called to render a tuple using the wrapped format.
          *
@@ -182,7 +188,7 @@ class APP_PUBLIC_API TupleDataTypePresentationGenerator:public virtual Ld::Tuple
          *
          * \param[in]     presenter                Pointer to the presenter requesting the rendering operation.
          *
-         * \param[in]     tuple                    The tuple to be rendered.
+         * \param[in]     members                  The visible members of the tuple.
          *
          * \param[in]     format                   The format to use for the child elements.
          *
@@ -223,7 +229,7 @@ class APP_PUBLIC_API TupleDataTypePresentationGenerator:public virtual Ld::Tuple
             PlacementTracker*                     placementTracker,
             DataTypePresenter::PresentationAreas& currentPresentationAreas,
             DataTypePresenter*                    presenter,
-            const Model::Tuple&                   tuple,
+            const MemberList&                     members,
             Ld::FormatPointer                     format,
             const QFont&                          font,
             const QColor&                         fontColor,
@@ -238,35 +244,58 @@ class APP_PUBLIC_API TupleDataTypePresentationGenerator:public virtual Ld::Tuple
         ) const;
 
         /**
-         * Method that is called to calculate the maximum ascent and descent across a range of tuple entries.
+         * Method that is called to collect the visible members of a tuple.  The trailing members are accessed
+         * directly so the hidden members are never visited.
          *
-         * \param[in]     placementTracker A pointer to the placement tracker that can be used to track and update
-         *                                 status during a time-consuming placement operation.
+         * \param[in] tuple               The tuple to be rendered.
          *
-         * \param[in,out] tupleIterator    Iterator to the first member of the tuple to be rendered.
+         * \param[in] leadingMemberCount  The number of children at the front of the tuple to be rendered.
          *
-         * \param[in]     memberCount      The number of tuple members to be rendered.
+         * \param[in] hiddenMemberCount   The number of unrendered children.
          *
-         * \param[in]     format           The format to use for the child elements.
+         * \param[in] trailingMemberCount The number of children at the end of the tuple to be rendered.
          *
-         * \param[in]     relativeScale    A hint value used to indicate if this child should try to scale smaller than
-         *                                 usual. This value is intended for cases where an equation element needs to
-         *                                 be rendered in a smaller than usual font.  A value of 1.0 indicates normal
-         *                                 scale.  The value is intended as a hint, children are not required to honor
-         *                                 this parameter.
+         * \return Returns the visible members, leading members first.
+         */
+        static MemberList visibleMembers(
+            const Model::Tuple& tuple,
+            unsigned long       leadingMemberCount,
+            unsigned long       hiddenMemberCount,
+            unsigned long       trailingMemberCount
+        );
+
+        /**
+         * Method that is called to calculate the maximum ascent and descent across the visible members of a tuple.
          *
-         * \param[in,out] maximumAscent  The working maximum ascent value.
+         * \param[in]     placementTracker  A pointer to the placement tracker that can be used to track and update
+         *                                  status during a time-consuming placement operation.
          *
-         * \param[in,out] maximumDescent The working maximum descent value.
+         * \param[in]     members           The visible members of the tuple.
+         *
+         * \param[in]     format            The format to use for the child elements.
+         *
+         * \param[in]     relativeScale     A hint value used to indicate if this child should try to scale smaller
+         *                                  than usual. This value is intended for cases where an equation element
+         *                                  needs to be rendered in a smaller than usual font.  A value of 1.0
+         *                                  indicates normal scale.  The value is intended as a hint, children are not
+         *                                  required to honor this parameter.
+         *
+         * \param[in]     cacheMeasurements If true, the member heights are recorded so they can be reused when the
+         *                                  members are rendered.  The member list must remain in place for the
+         *                                  lifetime of the current measurement scope.
+         *
+         * \param[in,out] maximumAscent     The working maximum ascent value.
+         *
+         * \param[in,out] maximumDescent    The working maximum descent value.
          */
         static void calculateMaximumChildHeight(
-            PlacementTracker*            placementTracker,
-            Model::Tuple::ConstIterator& tupleIterator,
-            unsigned long                memberCount,
-            Ld::FormatPointer            format,
-            float                        relativeScale,
-            float&                       maximumAscent,
-            float&                       maximumDescent
+            PlacementTracker* placementTracker,
+            const MemberList& members,
+            Ld::FormatPointer format,
+            float             relativeScale,
+            bool              cacheMeasurements,
+            float&            maximumAscent,
+            float&            maximumDescent
         );
 
         /**
@@ -275,7 +304,9 @@ class APP_PUBLIC_API TupleDataTypePresentationGenerator:public virtual Ld::Tuple
          * \param[in]     placementTracker         A pointer to the placement tracker that can be used to track and
          *                                         update status during a time-consuming placement operation.
          *
-         * \param[in,out] tupleIterator            Iterator to the first member of the tuple tobe rendered.
+         * \param[in]     members                  The visible members of the tuple.
+         *
+         * \param[in]     firstIndex               The zero based index of the first member to be rendered.
          *
          * \param[in]     memberCount              The number of tuple members to be rendered.
          *
@@ -310,7 +341,8 @@ class APP_PUBLIC_API TupleDataTypePresentationGenerator:public virtual Ld::Tuple
          */
         static void renderTupleMembers(
             PlacementTracker*                     placementTracker,
-            Model::Tuple::ConstIterator&          tupleIterator,
+            const MemberList&                     members,
+            unsigned long                         firstIndex,
             unsigned long                         memberCount,
             bool&                                 isFirstEntry,
             DataTypePresenter::PresentationAreas& currentPresentationAreas,
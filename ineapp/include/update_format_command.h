@@ -17,6 +17,7 @@
 #include <QWeakPointer>
 #include <QString>
 #include <QMap>
+#include <QList>
 
 #include <ld_element_structures.h>
 #include <ld_format_structures.h>
@@ -191,6 +192,28 @@ class APP_PUBLIC_API UpdateFormatCommand:public CommandBase {
          */
         typedef QMap<Ld::ElementPosition, Ld::FormatPointer> FormatsByPosition;
 
+        /**
+         * Class that records a single merge so that the merge can be reversed before formats are restored by
+         * position.
+         */
+        class MergeRecord {
+            public:
+                /**
+                 * The position of the element that absorbed its sibling.
+                 */
+                Ld::ElementPosition position;
+
+                /**
+                 * The text index, in the surviving element, where the absorbed sibling starts.
+                 */
+                unsigned long textIndex;
+
+                /**
+                 * The region index, in the surviving element, where the absorbed sibling starts.
+                 */
+                unsigned regionIndex;
+        };
+
         /**
          * Method that converts formats by element to formats by position.
          *
@@ -209,9 +232,21 @@ class APP_PUBLIC_API UpdateFormatCommand:public CommandBase {
          */
         static FormatsByElement toFormatsByElement(const FormatsByPosition& formatsByPosition);
 
+        /**
+         * Method that replaces identical formats with a single shared instance.  Used to reduce the memory held by
+         * commands that touch large numbers of elements.  Formats are cloned again when they are assigned back to
+         * elements.
+         *
+         * \param[in] formatsByPosition A map of formats, by position.
+         *
+         * \return Returns the map with identical formats sharing a single instance.
+         */
+        static FormatsByPosition shareIdenticalFormats(const FormatsByPosition& formatsByPosition);
+
         /**
          * Method that is called to update a collection of formats based on a map of formats by position
-         * information.
+         * information.  All formats are assigned before any merges are attempted and repositioning requests are
+         * batched so that the document is repositioned once for the entire update.
          *
          * \param[in]     formatsByPosition     A map of formats to be updated based on element positions.
          *
@@ -224,15 +259,33 @@ class APP_PUBLIC_API UpdateFormatCommand:public CommandBase {
          * \param[in,out] cursorStateCollection The collection of every cursor that may need adjustment for this
          *                                      command.
          *
-         * \return Returns an updated list of formats by position that can be used later to undo this operation.
+         * \param[out]    merges                A list to receive the merges that were performed, in the order they
+         *                                      were performed.
+         *
+         * \return Returns an updated list of formats by position that can be used later to undo this operation.  The
+         *         positions are those from before any merges were performed.
          */
         static FormatsByPosition updateFormats(
             const FormatsByPosition&   formatsByPosition,
             bool                       mergesAllowed,
             const Cursor&              cursor,
-            Ld::CursorStateCollection* cursorStateCollection
+            Ld::CursorStateCollection* cursorStateCollection,
+            QList<MergeRecord>*        merges
         );
 
+        /**
+         * Method that reverses merges performed by \ref UpdateFormatCommand::updateFormats, last merge first, so that
+         * positions recorded before the merges are valid again.
+         *
+         * \param[in]     merges                The merges to be reversed, in the order they were performed.
+         *
+         * \param[in,out] cursorStateCollection The collection of every cursor that may need adjustment for this
+         *                                      command.
+         *
+         * \return Returns true on success, returns false if a merge could not be reversed.
+         */
+        static bool reverseMerges(const QList<MergeRecord>& merges, Ld::CursorStateCollection* cursorStateCollection);
+
         /**
          * The current map of page formats by page index.
          */
@@ -248,6 +301,11 @@ class APP_PUBLIC_API UpdateFormatCommand:public CommandBase {
          * actually modified.
          */
         FormatsByPosition deletedFormats;
+
+        /**
+         * The merges performed by the last execute or undo.  These are reversed before the next execute or undo.
+         */
+        QList<MergeRecord> currentMerges;
 };
 
 #endif
@@ -32,6 +32,7 @@
 #include "app_common.h"
 #include "command.h"
 #include "command_container.h"
+#include "document_text_index.h"
 
 #include "cursor.h"
 #include "page_list.h"
@@ -1086,6 +1087,61 @@ class APP_PUBLIC_API ViewWidget:public EQt::ProgrammaticView {
             bool           okToLoop = true
         );
 
+        /**
+         * Method you can use to locate every match in the document.  The search uses the document's text index
+         * rather than walking the document from the cursor.
+         *
+         * \param[in] searchText        The search text to be located.
+         *
+         * \param[in] caseSensitive     If true, the search will require an exact case match.  If false, the search
+         *                              will ignore case.
+         *
+         * \param[in] wholeWordsOnly    If true, the search will require that the search string represent an entire
+         *                              word or group of words.  Strings making up a part of a word will be
+         *                              ignored.
+         *
+         * \param[in] regularExpression If true, the search string will be treated as a regular expression.  If
+         *                              false, the search string will be treated as normal text.
+         *
+         * \return Returns every match, in document order.
+         */
+        QList<DocumentTextIndex::Match> findAll(
+            const QString& searchText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
+        /**
+         * Slot you can use to replace every match in the document.  All replacements are applied by a single
+         * command so they can be undone in one step and the document is repositioned once.
+         *
+         * \param[in] searchText        The search text to be located.
+         *
+         * \param[in] replacementText   The replacement text.  When performing a regular expression search, the
+         *                              replacement text can reference captured groups.
+         *
+         * \param[in] caseSensitive     If true, the search will require an exact case match.  If false, the search
+         *                              will ignore case.
+         *
+         * \param[in] wholeWordsOnly    If true, the search will require that the search string represent an entire
+         *                              word or group of words.  Strings making up a part of a word will be
+         *                              ignored.
+         *
+         * \param[in] regularExpression If true, the search string will be treated as a regular expression.  If
+         *                              false, the search string will be treated as normal text.
+         *
+         * \return Returns the number of replacements performed.  Matches that span multiple text regions are not
+         *         replaced.
+         */
+        unsigned long replaceAll(
+            const QString& searchText,
+            const QString& replacementText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
         /**
          * Changes the current zoom factor for the editor.
          *
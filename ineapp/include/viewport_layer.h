@@ -0,0 +1,142 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref ViewportLayer class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineapp */
+
+#ifndef VIEWPORT_LAYER_H
+#define VIEWPORT_LAYER_H
+
+#include <QSize>
+#include <QRect>
+#include <QRegion>
+#include <QPixmap>
+
+#include "app_common.h"
+
+/**
+ * Class that holds a cached, viewport sized, rendering of one layer of a view.  The class tracks which portions of the
+ * layer are out of date so that only those portions need to be rendered again.  Contents can be scrolled in place so
+ * that scrolling the view only requires the newly exposed areas to be rendered.
+ */
+class APP_PUBLIC_API ViewportLayer {
+    public:
+        /**
+         * Constructor.
+         *
+         * \param[in] transparent If true, the layer will have an alpha channel and dirty areas will be cleared to
+         *                        transparent before they are rendered.  If false, the layer is opaque.
+         */
+        ViewportLayer(bool transparent = false);
+
+        ~ViewportLayer();
+
+        /**
+         * Method you can use to set the size of the layer.  The layer is reallocated, and marked dirty, only if the
+         * size or device pixel ratio changes.
+         *
+         * \param[in] newSize          The new size of the layer, in viewport coordinates.
+         *
+         * \param[in] devicePixelRatio The device pixel ratio of the viewport.
+         *
+         * \return Returns true if the layer was reallocated.  Returns false if the layer is unchanged.
+         */
+        bool resize(const QSize& newSize, qreal devicePixelRatio);
+
+        /**
+         * Method you can use to obtain the size of the layer.
+         *
+         * \return Returns the size of the layer, in viewport coordinates.
+         */
+        const QSize& size() const;
+
+        /**
+         * Method you can use to scroll the contents of the layer.  Areas exposed by the scroll are marked dirty.
+         *
+         * \param[in] dx The horizontal distance to scroll, in viewport coordinates.
+         *
+         * \param[in] dy The vertical distance to scroll, in viewport coordinates.
+         */
+        void scroll(int dx, int dy);
+
+        /**
+         * Method you can use to mark the entire layer dirty.
+         */
+        void invalidate();
+
+        /**
+         * Method you can use to mark a portion of the layer dirty.
+         *
+         * \param[in] rectangle The rectangle to mark dirty, in viewport coordinates.
+         */
+        void invalidate(const QRect& rectangle);
+
+        /**
+         * Method you can use to determine if any portion of the layer is dirty.
+         *
+         * \return Returns true if a portion of the layer is dirty.  Returns false if the layer is up to date.
+         */
+        bool isDirty() const;
+
+        /**
+         * Method you can use to obtain the dirty portion of the layer.
+         *
+         * \return Returns the dirty region, in viewport coordinates.
+         */
+        const QRegion& dirtyRegion() const;
+
+        /**
+         * Method you can use to indicate that the dirty portion of the layer has been rendered.
+         */
+        void markClean();
+
+        /**
+         * Method you can use to determine if this layer is transparent.
+         *
+         * \return Returns true if the layer has an alpha channel.  Returns false if the layer is opaque.
+         */
+        bool isTransparent() const;
+
+        /**
+         * Method you can use to obtain the pixmap holding the layer.  The pixmap's device pixel ratio is set so that
+         * painting onto it uses viewport coordinates.
+         *
+         * \return Returns a reference to the pixmap.
+         */
+        QPixmap& pixmap();
+
+        /**
+         * Method you can use to obtain the pixmap holding the layer.
+         *
+         * \return Returns a reference to the pixmap.
+         */
+        const QPixmap& pixmap() const;
+
+    private:
+        /**
+         * Flag indicating if the layer is transparent.
+         */
+        bool currentTransparent;
+
+        /**
+         * The layer size, in viewport coordinates.
+         */
+        QSize currentSize;
+
+        /**
+         * The pixmap holding the layer contents.
+         */
+        QPixmap currentPixmap;
+
+        /**
+         * The portion of the layer that must be rendered again.
+         */
+        QRegion currentDirtyRegion;
+};
+
+#endif
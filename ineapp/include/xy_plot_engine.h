@@ -133,6 +133,13 @@ class APP_PUBLIC_API XyPlotEngine:public Plot2DEngineBase {
          */
         QSet<AxisScale> supportedAxisScales(AxisLocation axisLocation) const override;
 
+        /**
+         * Method you can use to determine if this engine supports rendering through a \ref NativePlotItem.
+         *
+         * \return Returns true.
+         */
+        bool supportsNativeRenderer() const override;
+
         /**
          * Method that creates a new plot graphics item.
          *
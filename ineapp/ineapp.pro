@@ -9,7 +9,7 @@
 
 TEMPLATE = lib
 
-QT += core gui widgets svg network printsupport multimedia charts
+QT += core gui widgets svg network printsupport multimedia charts concurrent
 CONFIG += shared c++14
 
 equals(QT_MAJOR_VERSION, 6) {
@@ -92,14 +92,31 @@ API_HEADERS = include/app_common.h \
               include/update_format_command.h \
               include/cut_copy_command.h \
               include/paste_command.h \
+              include/replace_all_command.h \
               include/main_window.h \
               include/view_widget.h \
               include/view_proxy.h \
               include/math_view_proxy_base.h \
               include/scene_units.h \
+              include/font_metrics_cache.h \
+              include/graphics_item_pool.h \
+              include/image_cache.h \
+              include/image_picture_recorder.h \
+              include/image_pyramid_item.h \
+              include/autosave_journal.h \
+              include/batch_exporter.h \
+              include/latency_tracer.h \
+              include/scene_tile_cache.h \
+              include/memory_governor.h \
+              include/paragraph_line_index.h \
+              include/function_search_index.h \
+              include/native_plot_item.h \
               include/command_queue.h \
               include/document.h \
+              include/import_loader.h \
+              include/document_text_index.h \
               include/page_list.h \
+              include/viewport_layer.h \
               include/editor.h \
               include/document_file_dialog.h \
               include/image_file_dialog.h \
@@ -135,6 +152,7 @@ API_HEADERS = include/app_common.h \
               include/cursor.h \
               include/placement_negotiator.h \
               include/placement_tracker.h \
+              include/placement_profiler.h \
               include/placement_status_notifier.h \
               include/application_status_bar.h \
               include/placement_line_data.h \
@@ -154,6 +172,7 @@ API_HEADERS = include/app_common.h \
               include/leaf_presentation.h \
               include/presentation_locator.h \
               include/presentation_area_tracker.h \
+              include/maximum_tracker.h \
               include/root_child_location.h \
               include/root_presentation.h \
               include/text_presentation_helper.h \
@@ -184,6 +203,7 @@ API_HEADERS = include/app_common.h \
               include/inspector_widget.h \
               include/matrix_inspector_widget.h \
               include/matrix_inspector_model.h \
+              include/inspector_cell_cache.h \
               include/boolean_inspector_widget.h \
               include/integer_inspector_widget.h \
               include/real_inspector_widget.h \
@@ -390,6 +410,7 @@ SOURCES = source/metatypes.cpp \
           source/function_fixer.cpp \
           source/console_device.cpp \
           source/function_browser_model.cpp \
+          source/function_search_index.cpp \
           source/function_browser_delegate.cpp \
           source/runtime_diagnostic.cpp \
           source/build_execute_state_machine.cpp \
@@ -421,13 +442,28 @@ SOURCES = source/metatypes.cpp \
           source/update_format_command.cpp \
           source/cut_copy_command.cpp \
           source/paste_command.cpp \
+          source/replace_all_command.cpp \
           source/configure.cpp \
           source/main_window.cpp \
           source/view_widget.cpp \
           source/view_proxy.cpp \
           source/scene_units.cpp \
+          source/font_metrics_cache.cpp \
+          source/graphics_item_pool.cpp \
+          source/image_cache.cpp \
+          source/image_picture_recorder.cpp \
+          source/image_pyramid_item.cpp \
+          source/autosave_journal.cpp \
+          source/batch_exporter.cpp \
+          source/latency_tracer.cpp \
+          source/scene_tile_cache.cpp \
+          source/memory_governor.cpp \
+          source/paragraph_line_index.cpp \
+          source/native_plot_item.cpp \
           source/command_queue.cpp \
           source/document.cpp \
+          source/import_loader.cpp \
+          source/document_text_index.cpp \
           source/cursor_position_setting.cpp \
           source/zoom_setting.cpp \
           source/page_list_page.cpp \
@@ -466,6 +502,7 @@ SOURCES = source/metatypes.cpp \
           source/special_characters_marshaller.cpp \
           source/special_characters_main_window_proxy.cpp \
           source/special_characters_view_proxy.cpp \
+          source/viewport_layer.cpp \
           source/editor.cpp \
           source/document_file_dialog.cpp \
           source/image_file_dialog.cpp \
@@ -505,6 +542,7 @@ SOURCES = source/metatypes.cpp \
           source/cursor.cpp \
           source/placement_negotiator.cpp \
           source/placement_tracker.cpp \
+          source/placement_profiler.cpp \
           source/placement_status_notifier.cpp \
           source/application_status_bar.cpp \
           source/placement_line_data.cpp \
@@ -525,6 +563,7 @@ SOURCES = source/metatypes.cpp \
           source/leaf_presentation.cpp \
           source/presentation_locator.cpp \
           source/presentation_area_tracker.cpp \
+          source/maximum_tracker.cpp \
           source/root_child_location.cpp \
           source/root_presentation.cpp \
           source/text_presentation_helper.cpp \
@@ -573,6 +612,7 @@ SOURCES = source/metatypes.cpp \
           source/inspector_widget.cpp \
           source/matrix_inspector_widget.cpp \
           source/matrix_inspector_model.cpp \
+          source/inspector_cell_cache.cpp \
           source/boolean_inspector_widget.cpp \
           source/integer_inspector_widget.cpp \
           source/real_inspector_widget.cpp \
@@ -13,6 +13,7 @@
 #include <QStyle>
 #include <QSharedPointer>
 #include <QString>
+#include <QStringList>
 #include <QSize>
 #include <QDateTime>
 #include <QGridLayout>
@@ -75,6 +76,7 @@
 #include "splash_screen.h"
 #include "registrar.h"
 #include "plug_in_manager.h"
+#include "function_search_index.h"
 #include "document_file_dialog.h"
 #include "image_file_dialog.h"
 #include "clipboard.h"
@@ -82,12 +84,24 @@
 #include "console_device.h"
 #include "configure.h"
 #include "scene_units.h"
+#include "font_metrics_cache.h"
+#include "graphics_item_pool.h"
+#include "placement_profiler.h"
+#include "latency_tracer.h"
+#include "memory_governor.h"
+#include "plot_wrapped_engine_base.h"
 #include "tool_button_sizing_dialog.h"
+#include "batch_exporter.h"
 #include "application.h"
 
-const char Application::environmentVariableEnableDebug[]     = "INESONIC_DEBUG";
-const char Application::environmentVariableEnvironmentType[] = "INESONIC_ENVIRONMENT_MODE";
-const char Application::globalMathFontName[]                 = "STIXMath";
+const char Application::environmentVariableEnableDebug[]       = "INESONIC_DEBUG";
+const char Application::environmentVariableEnvironmentType[]   = "INESONIC_ENVIRONMENT_MODE";
+const char Application::environmentVariablePlacementProfile[]  = "INESONIC_PLACEMENT_PROFILE";
+const char Application::environmentVariableLatencyTrace[]      = "INESONIC_LATENCY_TRACE";
+const char Application::environmentVariableSceneMemoryBudget[] = "INESONIC_SCENE_MEMORY_BUDGET";
+const char Application::environmentVariableSceneMemoryReport[] = "INESONIC_SCENE_MEMORY_REPORT";
+const char Application::environmentVariableNativePlots[]       = "INESONIC_NATIVE_PLOTS";
+const char Application::globalMathFontName[]                  = "STIXMath";
 
 #if (defined(Q_OS_WIN))
 
@@ -178,6 +192,10 @@ Application::Application(
 
     registerMetaTypes();
     checkDebugSupport();
+    checkPlacementProfiling();
+    checkLatencyTracing();
+    checkSceneMemoryBudget();
+    checkNativePlotRenderer();
     setupEnvironment();
     customizeForPlatform();
 
@@ -291,6 +309,20 @@ Application::Application(
 Application::~Application() {
     MainWindow::deleteAllMainWindows();
 
+    if (!currentPlacementProfileFilename.isEmpty()) {
+        PlacementProfiler::setEnabled(false);
+        PlacementProfiler::writeReport(currentPlacementProfileFilename);
+    }
+
+    if (!currentLatencyTraceFilename.isEmpty()) {
+        LatencyTracer::setEnabled(false);
+        LatencyTracer::writeReport(currentLatencyTraceFilename);
+    }
+
+    if (!currentSceneMemoryReportFilename.isEmpty()) {
+        MemoryGovernor::writeReport(currentSceneMemoryReportFilename);
+    }
+
     if (currentRegistrar != Q_NULLPTR) {
         delete currentRegistrar;
     }
@@ -306,6 +338,8 @@ Application::~Application() {
     if (currentToolButtonSizingDialog != Q_NULLPTR) {
         delete currentToolButtonSizingDialog;
     }
+
+    GraphicsItemPoolBase::clearAll();
 }
 
 
@@ -476,8 +510,12 @@ bool Application::debugModeEnabled() {
 int Application::exec() {
     int exitStatus;
 
-    startNormalApplication();
-    exitStatus = EQt::ProgrammaticApplication::exec();
+    if (BatchExporter::isBatchExportRequested(arguments())) {
+        exitStatus = runBatchExport();
+    } else {
+        startNormalApplication();
+        exitStatus = EQt::ProgrammaticApplication::exec();
+    }
 
     if (currentUsageData != nullptr) {
         if (exitStatus == 0) {
@@ -491,6 +529,17 @@ int Application::exec() {
 }
 
 
+bool Application::writeLatencyTraceReport() {
+    bool success = false;
+
+    if (!currentLatencyTraceFilename.isEmpty()) {
+        success = LatencyTracer::writeReport(currentLatencyTraceFilename);
+    }
+
+    return success;
+}
+
+
 void Application::startUserInterface(EQt::UniqueApplication::StartupCondition) {
     splashScreen->startedInitializationStep(tr("Initializaing core language definition"));
     processEvents();
@@ -691,6 +740,42 @@ void Application::startNormalApplication() {
 }
 
 
+int Application::runBatchExport() {
+    int           exitStatus;
+    BatchExporter batchExporter;
+
+    // The splash screen is never shown for a batch export.  We discard it so that plug-in loading does not report
+    // progress to it.
+
+    splashScreen->deleteLater();
+    splashScreen = Q_NULLPTR;
+
+    bool success = batchExporter.configure(arguments());
+    if (!success) {
+        std::cerr << batchExporter.errorString().toLocal8Bit().constData() << std::endl;
+        exitStatus = 2;
+    } else {
+        initializeCoreLanguageDefinition();
+        initializePlugIns();
+        finalizeLanguageDefinition();
+        loadApplicationFonts();
+        setApplicationDefaultFonts();
+        createGlobalSettingData();
+        updateScreenSettings();
+
+        connect(&batchExporter, &BatchExporter::finished, this, &Application::quit, Qt::QueuedConnection);
+        QTimer::singleShot(0, &batchExporter, &BatchExporter::start);
+
+        exitStatus = QApplication::exec();
+        if (exitStatus == 0 && batchExporter.numberFailures() > 0) {
+            exitStatus = 1;
+        }
+    }
+
+    return exitStatus;
+}
+
+
 void Application::customizeForPlatform() {
     #if (defined(Q_OS_WIN))
 
@@ -946,6 +1031,8 @@ void Application::initializeCoreLanguageDefinition() {
 void Application::initializePlugIns() {
     QList<QString> plugInList = Ld::Environment::plugInFiles();
     plugInManager()->loadPlugIns(plugInList, registrar());
+
+    FunctionSearchIndex::build();
 }
 
 
@@ -1051,6 +1138,7 @@ void Application::updateScreenSettings() {
 
     currentFontScaleFactor = averagePhysical / averageLogical;
     SceneUnits::update(physicalDpi());
+    FontMetricsCache::clear();
 
     updateToolButtonSizes();
 
@@ -1108,6 +1196,50 @@ void Application::checkDebugSupport() {
 }
 
 
+void Application::checkPlacementProfiling() {
+    currentPlacementProfileFilename = qEnvironmentVariable(environmentVariablePlacementProfile).trimmed();
+    if (!currentPlacementProfileFilename.isEmpty()) {
+        PlacementProfiler::setEnabled();
+    }
+}
+
+
+void Application::checkLatencyTracing() {
+    currentLatencyTraceFilename = qEnvironmentVariable(environmentVariableLatencyTrace).trimmed();
+    if (!currentLatencyTraceFilename.isEmpty()) {
+        LatencyTracer::setEnabled();
+    }
+}
+
+
+void Application::checkSceneMemoryBudget() {
+    QString budgetSetting = qEnvironmentVariable(environmentVariableSceneMemoryBudget).trimmed();
+    if (!budgetSetting.isEmpty()) {
+        bool               ok;
+        unsigned long long budgetMegabytes = budgetSetting.toULongLong(&ok);
+
+        if (ok) {
+            MemoryGovernor::setEnabled(budgetMegabytes > 0);
+            MemoryGovernor::setBudgetBytes(budgetMegabytes * 1024ULL * 1024ULL);
+        }
+    }
+
+    currentSceneMemoryReportFilename = qEnvironmentVariable(environmentVariableSceneMemoryReport).trimmed();
+}
+
+
+void Application::checkNativePlotRenderer() {
+    QStringList engineNames = qEnvironmentVariable(environmentVariableNativePlots).split(
+        QChar(','),
+        Qt::SplitBehaviorFlags::SkipEmptyParts
+    );
+
+    for (QStringList::const_iterator it=engineNames.constBegin(),end=engineNames.constEnd() ; it!=end ; ++it) {
+        PlotWrappedEngineBase::setNativeRendererEnabled(it->trimmed().toLower());
+    }
+}
+
+
 void Application::setupEnvironment() {
     QString value = qEnvironmentVariable(environmentVariableEnvironmentType);
 
@@ -45,6 +45,7 @@ void AssignmentOperatorPresentation::processInstructionBreakpointUpdated(bool) {
         if (!parent.isNull()) {
             PlacementNegotiator* parentPlacementNegotiator = dynamic_cast<PlacementNegotiator*>(parent->visual());
             if (parentPlacementNegotiator != Q_NULLPTR) {
+                flagPendingRepositioning();
                 parentPlacementNegotiator->requestRepositioning(this);
             }
         }
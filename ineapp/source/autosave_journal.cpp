@@ -0,0 +1,629 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref AutosaveJournal class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QSharedPointer>
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#include <ld_element_structures.h>
+#include <ld_element.h>
+#include <ld_element_cursor.h>
+#include <ld_root_element.h>
+
+#include "application.h"
+#include "plug_in_manager.h"
+#include "cursor.h"
+#include "command.h"
+#include "command_container.h"
+#include "insert_string_command.h"
+#include "delete_command.h"
+#include "document.h"
+#include "autosave_journal.h"
+
+/***********************************************************************************************************************
+ * AutosaveJournal::Position
+ */
+
+AutosaveJournal::Position::Position() {
+    currentValid         = false;
+    currentChildPosition = false;
+    currentChildIndex    = 0;
+    currentWholeElement  = true;
+    currentTextIndex     = 0;
+    currentRegionIndex   = 0;
+}
+
+
+AutosaveJournal::Position::Position(const Ld::ElementCursor& elementCursor) {
+    currentValid         = elementCursor.isValid();
+    currentChildPosition = false;
+    currentChildIndex    = 0;
+    currentWholeElement  = true;
+    currentTextIndex     = 0;
+    currentRegionIndex   = 0;
+
+    if (currentValid) {
+        Ld::ElementPointer element = elementCursor.element();
+        if (element.isNull()) {
+            element              = elementCursor.parent();
+            currentChildPosition = true;
+            currentChildIndex    = static_cast<quint32>(elementCursor.childIndex());
+        } else if (!elementCursor.isWholeElement()) {
+            currentWholeElement = false;
+            currentTextIndex    = static_cast<quint32>(elementCursor.textIndex());
+            currentRegionIndex  = static_cast<quint32>(elementCursor.regionIndex());
+        }
+
+        Ld::ElementPointer parent = element->parent();
+        while (!parent.isNull()) {
+            currentPath.prepend(static_cast<quint32>(parent->indexOfChild(element)));
+
+            element = parent;
+            parent  = element->parent();
+        }
+    }
+}
+
+
+AutosaveJournal::Position::~Position() {}
+
+
+Ld::ElementCursor AutosaveJournal::Position::elementCursor(QSharedPointer<Ld::RootElement> rootElement) const {
+    Ld::ElementCursor result;
+
+    if (currentValid) {
+        Ld::ElementPointer element = rootElement;
+
+        QList<quint32>::const_iterator it  = currentPath.constBegin();
+        QList<quint32>::const_iterator end = currentPath.constEnd();
+        while (it != end && !element.isNull()) {
+            if (*it < element->numberChildren()) {
+                element = element->child(*it);
+            } else {
+                element.reset();
+            }
+
+            ++it;
+        }
+
+        if (!element.isNull()) {
+            if (currentChildPosition) {
+                result = Ld::ElementCursor(element, currentChildIndex);
+            } else if (currentWholeElement) {
+                result = Ld::ElementCursor(element);
+            } else {
+                result = Ld::ElementCursor(currentTextIndex, currentRegionIndex, element);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+void AutosaveJournal::Position::write(QDataStream& stream) const {
+    stream << currentValid
+           << currentPath
+           << currentChildPosition
+           << currentChildIndex
+           << currentWholeElement
+           << currentTextIndex
+           << currentRegionIndex;
+}
+
+
+void AutosaveJournal::Position::read(QDataStream& stream) {
+    stream >> currentValid
+           >> currentPath
+           >> currentChildPosition
+           >> currentChildIndex
+           >> currentWholeElement
+           >> currentTextIndex
+           >> currentRegionIndex;
+}
+
+/***********************************************************************************************************************
+ * AutosaveJournal
+ */
+
+AutosaveJournal::AutosaveJournal(Document* document):QObject(document) {
+    currentDocument                 = document;
+    currentJournalStarted           = false;
+    currentJournalValid             = true;
+    currentSnapshotSlot             = 0;
+    currentRecordsSinceSnapshot     = 0;
+    currentSnapshotStallNanoseconds = 0;
+    currentSnapshotWriteNanoseconds = 0;
+    currentRecoveryNanoseconds      = 0;
+    currentNumberRecoveredRecords   = 0;
+    currentRecoveryFromSnapshot     = false;
+
+    writerPool.setMaxThreadCount(1);
+
+    flushTimer            = new QTimer(this);
+    snapshotTimer         = new QTimer(this);
+    periodicSnapshotTimer = new QTimer(this);
+
+    flushTimer->setSingleShot(true);
+    snapshotTimer->setSingleShot(true);
+
+    connect(flushTimer, &QTimer::timeout, this, &AutosaveJournal::flush);
+    connect(snapshotTimer, &QTimer::timeout, this, &AutosaveJournal::writeSnapshot);
+    connect(periodicSnapshotTimer, &QTimer::timeout, this, &AutosaveJournal::periodicSnapshot);
+}
+
+
+AutosaveJournal::~AutosaveJournal() {
+    stop();
+}
+
+
+bool AutosaveJournal::recoveryAvailable(const QString& filename) {
+    bool result = false;
+
+    QFile journalFile(journalFilename(filename));
+    if (journalFile.open(QFile::ReadOnly)) {
+        QDataStream stream(&journalFile);
+
+        quint32 payloadSize;
+        quint16 checksum;
+        quint32 magic;
+        stream >> payloadSize >> checksum >> magic;
+
+        result = (stream.status() == QDataStream::Ok && magic == journalMagic);
+    }
+
+    return result;
+}
+
+
+void AutosaveJournal::discard(const QString& filename) {
+    QFile::remove(journalFilename(filename));
+    QFile::remove(snapshotFilename(filename, 0));
+    QFile::remove(snapshotFilename(filename, 1));
+}
+
+
+void AutosaveJournal::start(const QString& filename) {
+    stop();
+
+    currentFilename = filename;
+    if (!currentFilename.isEmpty()) {
+        periodicSnapshotTimer->start(snapshotIntervalMSec);
+    }
+}
+
+
+void AutosaveJournal::stop() {
+    if (!currentFilename.isEmpty()) {
+        writerPool.waitForDone();
+
+        discard(currentFilename);
+        QFile::remove(recoveryFilename(currentFilename));
+
+        currentFilename.clear();
+    }
+
+    reset();
+}
+
+
+bool AutosaveJournal::recover(const QString& filename) {
+    QElapsedTimer timer;
+    timer.start();
+
+    stop();
+
+    bool                            success      = false;
+    bool                            fromSnapshot = false;
+    QList<QByteArray>               records;
+    QSharedPointer<Ld::RootElement> rootElement  = currentDocument->element();
+
+    QFile journalFile(journalFilename(filename));
+    if (journalFile.open(QFile::ReadOnly)) {
+        QByteArray  contents = journalFile.readAll();
+        QDataStream stream(contents);
+        bool        torn     = false;
+
+        // Read framed blocks until the end of the journal or the first block torn by a crash.
+
+        while (!torn && !stream.atEnd()) {
+            quint32 payloadSize;
+            quint16 checksum;
+            stream >> payloadSize >> checksum;
+
+            QByteArray payload(static_cast<int>(qMin<quint32>(payloadSize, contents.size())), '\0');
+            if (stream.status() != QDataStream::Ok                                                ||
+                stream.readRawData(payload.data(), payload.size()) != static_cast<int>(payloadSize) ||
+                qChecksum(payload.constData(), payload.size()) != checksum                            ) {
+                torn = true;
+            } else {
+                records.append(payload);
+            }
+        }
+
+        if (!records.isEmpty()) {
+            QDataStream headerStream(records.takeFirst());
+
+            quint32 magic;
+            quint32 version;
+            qint32  base;
+            quint32 snapshotSlot;
+            headerStream >> magic >> version >> base >> snapshotSlot;
+
+            if (magic == journalMagic && version == journalVersion) {
+                fromSnapshot = (static_cast<Base>(base) == Base::SNAPSHOT);
+
+                // A snapshot is copied before it is loaded.  The element tree keeps reading from the file it was
+                // loaded from and the snapshot slots are reused once journaling restarts.
+
+                QString baseFilename = filename;
+                bool    baseReady    = true;
+                if (fromSnapshot) {
+                    baseFilename = recoveryFilename(filename);
+
+                    QFile::remove(baseFilename);
+                    baseReady = QFile::copy(snapshotFilename(filename, snapshotSlot), baseFilename);
+                }
+
+                if (baseReady) {
+                    Ld::PlugInsByName plugInsByName = Application::plugInManager()->plugInsByName();
+                    success = rootElement->openExisting(baseFilename, false, plugInsByName);
+                }
+            }
+        }
+    }
+
+    unsigned long numberRecords = 0;
+    if (success) {
+        CursorPointer cursor(new Cursor(currentDocument));
+        currentDocument->addCursor(cursor);
+
+        bool                              replaying = true;
+        QList<QByteArray>::const_iterator it        = records.constBegin();
+        QList<QByteArray>::const_iterator end       = records.constEnd();
+        while (replaying && it != end) {
+            QDataStream recordStream(*it);
+
+            quint8   recordType;
+            Position position;
+            Position selectionPosition;
+
+            recordStream >> recordType;
+            position.read(recordStream);
+            selectionPosition.read(recordStream);
+
+            Ld::ElementCursor elementCursor   = position.elementCursor(rootElement);
+            Ld::ElementCursor selectionCursor = selectionPosition.elementCursor(rootElement);
+
+            if (elementCursor.isValid()) {
+                if (selectionCursor.isValid()) {
+                    cursor->updateFromElementCursor(elementCursor);
+                    cursor->updateSelectionFromElementCursor(selectionCursor);
+                } else {
+                    cursor->updateFromElementCursor(elementCursor, false);
+                }
+
+                if (static_cast<RecordType>(recordType) == RecordType::INSERT_STRING) {
+                    QString text;
+                    recordStream >> text;
+                    currentDocument->insertCommand(new InsertStringCommand(text, cursor));
+                } else if (static_cast<RecordType>(recordType) == RecordType::DELETE_CONTENT) {
+                    bool deleteBehindCursor;
+                    recordStream >> deleteBehindCursor;
+                    currentDocument->insertCommand(new DeleteCommand(deleteBehindCursor, cursor));
+                } else {
+                    replaying = false;
+                }
+
+                ++numberRecords;
+            } else {
+                replaying = false;
+            }
+
+            ++it;
+        }
+
+        currentDocument->removeCursor(cursor);
+
+        // A partially replayed journal still leaves the document in a state the user had seen, so we keep what we
+        // have recovered.  The recovered document is never saved here; saving over the original file is left to the
+        // user.
+
+        discard(filename);
+
+        currentFilename = filename;
+        periodicSnapshotTimer->start(snapshotIntervalMSec);
+
+        if (fromSnapshot || numberRecords > 0) {
+            snapshotRequired();
+        }
+    }
+
+    currentRecoveryNanoseconds    = static_cast<unsigned long long>(timer.nsecsElapsed());
+    currentNumberRecoveredRecords = numberRecords;
+    currentRecoveryFromSnapshot   = success && fromSnapshot;
+
+    return success;
+}
+
+
+unsigned long long AutosaveJournal::lastSnapshotStallNanoseconds() const {
+    return currentSnapshotStallNanoseconds;
+}
+
+
+unsigned long long AutosaveJournal::lastSnapshotWriteNanoseconds() const {
+    return currentSnapshotWriteNanoseconds;
+}
+
+
+unsigned long long AutosaveJournal::lastRecoveryNanoseconds() const {
+    return currentRecoveryNanoseconds;
+}
+
+
+unsigned long AutosaveJournal::lastNumberRecoveredRecords() const {
+    return currentNumberRecoveredRecords;
+}
+
+
+bool AutosaveJournal::lastRecoveryFromSnapshot() const {
+    return currentRecoveryFromSnapshot;
+}
+
+
+void AutosaveJournal::commandExecuted(const CommandContainer& executedCommand) {
+    if (!currentFilename.isEmpty() && currentJournalValid) {
+        Command::CommandType commandType = executedCommand.commandType();
+
+        if (commandType == Command::CommandType::INSERT_STRING || commandType == Command::CommandType::DELETE_CONTENT) {
+            const Cursor& cursorAtIssue = executedCommand.cursorAtIssue();
+
+            QByteArray  payload;
+            QDataStream stream(&payload, QIODevice::WriteOnly);
+
+            if (commandType == Command::CommandType::INSERT_STRING) {
+                const InsertStringCommand* command = dynamic_cast<const InsertStringCommand*>(
+                    executedCommand.operator->()
+                );
+
+                stream << static_cast<quint8>(RecordType::INSERT_STRING);
+                Position(cursorAtIssue.elementCursor()).write(stream);
+                Position(cursorAtIssue.selectionCursor()).write(stream);
+                stream << command->text();
+            } else {
+                const DeleteCommand* command = dynamic_cast<const DeleteCommand*>(executedCommand.operator->());
+
+                stream << static_cast<quint8>(RecordType::DELETE_CONTENT);
+                Position(cursorAtIssue.elementCursor()).write(stream);
+                Position(cursorAtIssue.selectionCursor()).write(stream);
+                stream << command->deleteMode();
+            }
+
+            pendingRecords.append(frame(payload));
+            ++currentRecordsSinceSnapshot;
+
+            if (!flushTimer->isActive()) {
+                flushTimer->start(flushDelayMSec);
+            }
+
+            if (currentRecordsSinceSnapshot >= maximumRecordsBetweenSnapshots && !snapshotTimer->isActive()) {
+                snapshotTimer->start(snapshotDelayMSec);
+            }
+        } else {
+            snapshotRequired();
+        }
+    }
+}
+
+
+void AutosaveJournal::snapshotRequired() {
+    if (!currentFilename.isEmpty()) {
+        // Records issued after this point would be replayed against a tree that lacks this change so we stop
+        // journaling until the snapshot captures it.  Records already pending remain valid and are written now.
+
+        flush();
+        currentJournalValid = false;
+
+        if (!snapshotTimer->isActive()) {
+            snapshotTimer->start(snapshotDelayMSec);
+        }
+    }
+}
+
+
+void AutosaveJournal::flush() {
+    flushTimer->stop();
+
+    if (!pendingRecords.isEmpty() && !currentFilename.isEmpty()) {
+        QString    journal = journalFilename(currentFilename);
+        QByteArray records = pendingRecords;
+
+        if (currentJournalStarted) {
+            QtConcurrent::run(&writerPool, &AutosaveJournal::appendJournal, journal, records);
+        } else {
+            QByteArray contents = header(Base::DOCUMENT_FILE, 0) + records;
+            QtConcurrent::run(&writerPool, &AutosaveJournal::replaceJournal, journal, contents);
+            currentJournalStarted = true;
+        }
+
+        pendingRecords.clear();
+    }
+}
+
+
+void AutosaveJournal::writeSnapshot() {
+    snapshotTimer->stop();
+
+    if (!currentFilename.isEmpty()) {
+        QElapsedTimer timer;
+        timer.start();
+
+        // The snapshot captures any records not yet written.  Journal writes already queued must complete before the
+        // journal is replaced or removed so that nothing is appended after the snapshot's header.
+
+        flushTimer->stop();
+        pendingRecords.clear();
+        writerPool.waitForDone();
+
+        QSharedPointer<Ld::RootElement> rootElement  = currentDocument->element();
+        QSharedPointer<Ld::RootElement> snapshotRoot = rootElement->clone(true).dynamicCast<Ld::RootElement>();
+        unsigned                        snapshotSlot = 1 - currentSnapshotSlot;
+
+        currentSnapshotWriteNanoseconds = saveSnapshot(snapshotRoot, currentFilename, snapshotSlot);
+        currentSnapshotStallNanoseconds = static_cast<unsigned long long>(timer.nsecsElapsed());
+
+        if (currentSnapshotWriteNanoseconds != 0) {
+            currentSnapshotSlot         = snapshotSlot;
+            currentJournalStarted       = true;
+            currentJournalValid         = true;
+            currentRecordsSinceSnapshot = 0;
+        } else {
+            // The journal was removed.  Nothing is journaled until a snapshot succeeds so no record can be written
+            // to a journal without a header.  Try again so the document is protected once the problem clears.
+
+            currentJournalStarted = false;
+            currentJournalValid   = false;
+
+            snapshotTimer->start(snapshotIntervalMSec);
+        }
+    }
+}
+
+
+void AutosaveJournal::periodicSnapshot() {
+    if (currentRecordsSinceSnapshot > 0 && !snapshotTimer->isActive()) {
+        writeSnapshot();
+    }
+}
+
+
+QString AutosaveJournal::journalFilename(const QString& filename) {
+    return filename + QString(".journal");
+}
+
+
+QString AutosaveJournal::snapshotFilename(const QString& filename, unsigned slot) {
+    return filename + QString(".snapshot%1").arg(slot);
+}
+
+
+QString AutosaveJournal::recoveryFilename(const QString& filename) {
+    return filename + QString(".recovered");
+}
+
+
+QByteArray AutosaveJournal::frame(const QByteArray& payload) {
+    QByteArray  result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+
+    stream << static_cast<quint32>(payload.size()) << qChecksum(payload.constData(), payload.size());
+    stream.writeRawData(payload.constData(), payload.size());
+
+    return result;
+}
+
+
+QByteArray AutosaveJournal::header(AutosaveJournal::Base base, unsigned snapshotSlot) {
+    QByteArray  payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+
+    stream << journalMagic << journalVersion << static_cast<qint32>(base) << static_cast<quint32>(snapshotSlot);
+
+    return frame(payload);
+}
+
+
+bool AutosaveJournal::replaceJournal(const QString& journalFilename, const QByteArray& contents) {
+    QSaveFile journalFile(journalFilename);
+
+    bool success = journalFile.open(QFile::WriteOnly);
+    if (success) {
+        success = (journalFile.write(contents) == contents.size());
+        if (success) {
+            success = journalFile.commit();
+        } else {
+            journalFile.cancelWriting();
+        }
+    }
+
+    return success;
+}
+
+
+bool AutosaveJournal::appendJournal(const QString& journalFilename, const QByteArray& records) {
+    QFile journalFile(journalFilename);
+
+    bool success = journalFile.open(QFile::WriteOnly | QFile::Append);
+    if (success) {
+        success = (journalFile.write(records) == records.size());
+        journalFile.flush();
+    }
+
+    return success;
+}
+
+
+unsigned long long AutosaveJournal::saveSnapshot(
+        QSharedPointer<Ld::RootElement> rootElement,
+        const QString&                  filename,
+        unsigned                        slot
+    ) {
+    QElapsedTimer timer;
+    timer.start();
+
+    // The snapshot is written to the slot the journal does not reference so a crash while saving leaves the current
+    // journal and its snapshot intact.  The journal is then replaced atomically and the old slot removed.
+
+    bool success = rootElement->saveAs(snapshotFilename(filename, slot));
+    if (success) {
+        success = replaceJournal(journalFilename(filename), header(Base::SNAPSHOT, slot));
+    }
+
+    unsigned long long result;
+    if (success) {
+        QFile::remove(snapshotFilename(filename, 1 - slot));
+        result = std::max(static_cast<unsigned long long>(timer.nsecsElapsed()), 1ULL);
+    } else {
+        // The document has changed in ways the existing journal can not describe.  It is better to lose the journal
+        // than to replay it against the wrong base.
+
+        QFile::remove(journalFilename(filename));
+        result = 0;
+    }
+
+    return result;
+}
+
+
+void AutosaveJournal::reset() {
+    flushTimer->stop();
+    snapshotTimer->stop();
+    periodicSnapshotTimer->stop();
+
+    pendingRecords.clear();
+
+    currentJournalStarted       = false;
+    currentJournalValid         = true;
+    currentSnapshotSlot         = 0;
+    currentRecordsSinceSnapshot = 0;
+}
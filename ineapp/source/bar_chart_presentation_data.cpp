@@ -14,6 +14,8 @@
 #include <QValueAxis>
 #include <QBarCategoryAxis>
 #include <QHorizontalBarSeries>
+#include <QAbstractBarSeries>
+#include <QAbstractSeries>
 #include <QLegend>
 #include <QLegendMarker>
 #include <QColor>
@@ -275,33 +277,37 @@ void BarChartPresentationData::performDeferredUpdates() {
     }
 
     if (errorString.isEmpty()) {
-        baselineAxis->clear();
-        chart->removeAllSeries();
-
-        QFontMetrics fontMetrics(chart->legend()->font());
-        unsigned     markerSize = fontMetrics.ascent();
+        // The existing bar series and bar sets are reused and updated in place.  Objects are only created or destroyed
+        // when the orientation or the number of bar sets changes.
 
-        if (numberGroups == 1 || numberDataSeries == 1) {
-            if (numberProgrammaticLabels > 0) {
-                seriesLabels = programmaticLabels;
-            }
+        bool                horizontal     = (currentBaselineAxisLocation != AxisLocation::BOTTOM_X_A_GM);
+        QAbstractBarSeries* existingSeries = chartBarSeries(chart, horizontal);
+        bool                newSeries      = (existingSeries == Q_NULLPTR);
+        QAbstractBarSeries* barSeries;
 
-            QAbstractBarSeries* barSeries;
-            if (currentBaselineAxisLocation == AxisLocation::BOTTOM_X_A_GM) {
+        if (newSeries) {
+            if (!horizontal) {
                 barSeries = new QBarSeries;
             } else {
                 barSeries = new QHorizontalBarSeries;
             }
+        } else {
+            barSeries = existingSeries;
+        }
+
+        QList<QBarSet*> existingSets = barSeries->barSets();
+        unsigned        numberSets   = 0;
+        QStringList     categories;
+
+        if (numberGroups == 1 || numberDataSeries == 1) {
+            if (numberProgrammaticLabels > 0) {
+                seriesLabels = programmaticLabels;
+            }
 
             if (numberGroups > 1) {
                 if (static_cast<unsigned>(seriesLabels.size()) == numberGroups) {
                     // Single dimension based on a single data series.
 
-                    unsigned seriesIndex = 0;
-                    while (seriesIndex == currentLabelSeriesIndex) {
-                        ++seriesIndex;
-                    }
-
                     const QVector<double>& values       = valuesBySeries.at(0);
                     unsigned               numberPoints = static_cast<unsigned>(values.size());
 
@@ -310,19 +316,14 @@ void BarChartPresentationData::performDeferredUpdates() {
                         const QString& seriesLabel = seriesLabels.at(index);
                         double         value       = values.at(index);
 
-                        QBarSet* barSet = new QBarSet(seriesLabel);
-                        barSet->setBrush(QBrush(barColor));
-                        barSet->setBorderColor(barColor);
+                        updateBarSet(barSeries, existingSets, index, seriesLabel, barColor, QVector<double>() << value);
+                    }
 
-                        barSet->append(value);
+                    numberSets = numberPoints;
 
-                        barSeries->append(barSet);
-                        setMarkerColor(markerSize, chart->legend()->markers(barSeries), barColor);
+                    if (newSeries) {
+                        barSeries->attachAxis(scaleAxis);
                     }
-
-                    barSeries->attachAxis(scaleAxis);
-//                    baselineAxis->append(seriesLabels);
-                    chart->addSeries(barSeries);
                 } else {
                     errorString = tr(
                         "Number of labels must match either the number of values in each series or number of series "
@@ -333,7 +334,9 @@ void BarChartPresentationData::performDeferredUpdates() {
                 if (static_cast<unsigned>(seriesLabels.size()) == numberDataSeries) {
                     // Single dimension based on a independent data series.
 
-                    barSeries->attachAxis(scaleAxis);
+                    if (newSeries) {
+                        barSeries->attachAxis(scaleAxis);
+                    }
 
                     unsigned valueIndex = 0;
                     for (unsigned seriesIndex=0 ; seriesIndex<numberSeries ; ++seriesIndex) {
@@ -342,19 +345,14 @@ void BarChartPresentationData::performDeferredUpdates() {
                             const QColor&          barColor    = seriesData.barColor();
                             const QString&         seriesLabel = seriesLabels.at(valueIndex);
                             const QVector<double>& values      = valuesBySeries.at(valueIndex);
-                            QBarSet*               barSet      = new QBarSet(seriesLabel);
 
-                            barSet->setBrush(QBrush(barColor));
-                            barSet->setBorderColor(barColor);
-                            barSet->append(values.at(0));
-                            barSeries->append(barSet);
+                            updateBarSet(barSeries, existingSets, valueIndex, seriesLabel, barColor, values.mid(0, 1));
 
                             ++valueIndex;
                         }
                     }
 
-                    chart->addSeries(barSeries);
-//                    baselineAxis->append(seriesLabels);
+                    numberSets = valueIndex;
                 } else {
                     errorString = tr(
                         "Number of labels must match either the number of values in each series or number of series "
@@ -368,15 +366,10 @@ void BarChartPresentationData::performDeferredUpdates() {
 
                 unsigned valueIndex = 0;
 
-                QAbstractBarSeries* barSeries;
-                if (currentBaselineAxisLocation == AxisLocation::BOTTOM_X_A_GM) {
-                    barSeries = new QBarSeries;
-                } else {
-                    barSeries = new QHorizontalBarSeries;
+                if (newSeries) {
+                    barSeries->attachAxis(scaleAxis);
                 }
 
-                barSeries->attachAxis(scaleAxis);
-
                 for (unsigned seriesIndex=0 ; seriesIndex<numberSeries ; ++seriesIndex) {
                     if (seriesIndex != currentLabelSeriesIndex) {
                         if (valueIndex < static_cast<unsigned>(valuesBySeries.size()) &&
@@ -386,25 +379,15 @@ void BarChartPresentationData::performDeferredUpdates() {
                             const QVector<double>& values      = valuesBySeries.at(valueIndex);
                             const QString&         seriesLabel = seriesLabels.at(valueIndex);
 
-                            QBarSet* barSet = new QBarSet(seriesLabel);
-
-                            barSet->setBrush(QBrush(barColor));
-                            barSet->setBorderColor(barColor);
-
-                            for (unsigned groupIndex=0 ; groupIndex<numberGroups ; ++groupIndex) {
-                                barSet->append(values.at(groupIndex));
-                            }
-
-                            barSeries->append(barSet);
-                            setMarkerColor(markerSize, chart->legend()->markers(barSeries), barColor);
+                            updateBarSet(barSeries, existingSets, valueIndex, seriesLabel, barColor, values);
 
                             ++valueIndex;
                         }
                     }
                 }
 
-                chart->addSeries(barSeries);
-                baselineAxis->append(programmaticLabels);
+                numberSets = valueIndex;
+                categories = programmaticLabels;
             } else {
                 errorString = tr(
                     "Number of labels must match either the number of values in each series or number of series "
@@ -412,9 +395,32 @@ void BarChartPresentationData::performDeferredUpdates() {
                 );
             }
         }
+
+        if (baselineAxis->categories() != categories) {
+            baselineAxis->clear();
+            if (!categories.isEmpty()) {
+                baselineAxis->append(categories);
+            }
+        }
+
+        if (errorString.isEmpty()) {
+            unsigned numberExistingSets = static_cast<unsigned>(existingSets.size());
+            for (unsigned setIndex=numberSets ; setIndex<numberExistingSets ; ++setIndex) {
+                barSeries->remove(existingSets.at(setIndex));
+            }
+
+            if (newSeries) {
+                chart->addSeries(barSeries);
+            }
+        } else if (newSeries) {
+            delete barSeries;
+        }
     }
 
     if (!errorString.isEmpty()) {
+        // Stale series must not stay on screen behind the error message.
+
+        chart->removeAllSeries();
         showErrorMessage(errorString);
     } else {
         clearErrorMessage();
@@ -432,6 +438,94 @@ unsigned BarChartPresentationData::numberSeriesDataValues() const {
 }
 
 
+QAbstractBarSeries* BarChartPresentationData::chartBarSeries(EQt::ChartItem* chart, bool horizontal) {
+    QAbstractBarSeries*     result      = Q_NULLPTR;
+    QList<QAbstractSeries*> chartSeries = chart->series();
+
+    for (  QList<QAbstractSeries*>::const_iterator it = chartSeries.constBegin(), end = chartSeries.constEnd()
+         ; it != end
+         ; ++it
+         ) {
+        QAbstractSeries* series = *it;
+        bool             keep   = false;
+
+        if (result == Q_NULLPTR) {
+            if (horizontal) {
+                keep = (dynamic_cast<QHorizontalBarSeries*>(series) != Q_NULLPTR);
+            } else {
+                keep = (dynamic_cast<QBarSeries*>(series) != Q_NULLPTR);
+            }
+        }
+
+        if (keep) {
+            result = dynamic_cast<QAbstractBarSeries*>(series);
+        } else {
+            chart->removeSeries(series);
+            delete series;
+        }
+    }
+
+    return result;
+}
+
+
+void BarChartPresentationData::updateBarSet(
+        QAbstractBarSeries*    barSeries,
+        const QList<QBarSet*>& existingSets,
+        unsigned               setIndex,
+        const QString&         label,
+        const QColor&          barColor,
+        const QVector<double>& values
+    ) {
+    QBarSet* barSet;
+
+    if (setIndex < static_cast<unsigned>(existingSets.size())) {
+        barSet = existingSets.at(setIndex);
+
+        if (barSet->label() != label) {
+            barSet->setLabel(label);
+        }
+
+        int numberExistingValues = barSet->count();
+        int numberValues         = values.size();
+
+        if (numberExistingValues > numberValues) {
+            barSet->remove(numberValues, numberExistingValues - numberValues);
+            numberExistingValues = numberValues;
+        }
+
+        for (int valueIndex=0 ; valueIndex<numberExistingValues ; ++valueIndex) {
+            double value = values.at(valueIndex);
+            if (barSet->at(valueIndex) != value) {
+                barSet->replace(valueIndex, value);
+            }
+        }
+
+        for (int valueIndex=numberExistingValues ; valueIndex<numberValues ; ++valueIndex) {
+            barSet->append(values.at(valueIndex));
+        }
+    } else {
+        barSet = new QBarSet(label);
+        for (  QVector<double>::const_iterator it = values.constBegin(), end = values.constEnd()
+             ; it != end
+             ; ++it
+             ) {
+            barSet->append(*it);
+        }
+
+        barSeries->append(barSet);
+    }
+
+    if (barSet->brush() != QBrush(barColor)) {
+        barSet->setBrush(QBrush(barColor));
+    }
+
+    if (barSet->borderColor() != barColor) {
+        barSet->setBorderColor(barColor);
+    }
+}
+
+
 void BarChartPresentationData::setMarkerColor(
         unsigned                     markerSize,
         const QList<QLegendMarker*>& markerList,
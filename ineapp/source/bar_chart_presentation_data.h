@@ -15,6 +15,10 @@
 #include <QObject>
 #include <QList>
 #include <QLegendMarker>
+#include <QColor>
+#include <QVector>
+#include <QAbstractBarSeries>
+#include <QBarSet>
 
 #include <eqt_charts.h>
 
@@ -228,6 +232,43 @@ class APP_PUBLIC_API BarChartPresentationData:public Plot2DCategorizedPresentati
          */
         unsigned numberSeriesDataValues() const override;
 
+        /**
+         * Method that locates the bar series currently held by a chart.  Any series that can not be reused, including
+         * series with the wrong orientation, are removed from the chart and destroyed.
+         *
+         * \param[in] chart      The chart to be queried.
+         *
+         * \param[in] horizontal If true, a horizontal bar series is required.  If false, a vertical bar series is
+         *                       required.
+         *
+         * \return Returns the reusable bar series.  A null pointer is returned if no series can be reused.
+         */
+        static QAbstractBarSeries* chartBarSeries(EQt::ChartItem* chart, bool horizontal);
+
+        /**
+         * Method that updates an existing bar set in place or appends a new bar set if needed.
+         *
+         * \param[in] barSeries    The series holding the bar set.
+         *
+         * \param[in] existingSets The bar sets held by the series before the update.
+         *
+         * \param[in] setIndex     The zero based index of the bar set.
+         *
+         * \param[in] label        The bar set label.
+         *
+         * \param[in] barColor     The bar color.
+         *
+         * \param[in] values       The bar set values.
+         */
+        static void updateBarSet(
+            QAbstractBarSeries*    barSeries,
+            const QList<QBarSet*>& existingSets,
+            unsigned               setIndex,
+            const QString&         label,
+            const QColor&          barColor,
+            const QVector<double>& values
+        );
+
         /**
          * Method that updates the marker color for one or more markers.
          *
@@ -0,0 +1,774 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref BatchExporter class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QSet>
+#include <QMap>
+#include <QSharedPointer>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QPixmap>
+#include <QPrinter>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+
+#include <algorithm>
+#include <iostream>
+
+#include <util_hash_functions.h>
+
+#include <ld_element_structures.h>
+#include <ld_element.h>
+#include <ld_root_element.h>
+#include <ld_diagnostic_structures.h>
+#include <ld_diagnostic.h>
+#include <ld_code_generator.h>
+#include <ld_code_generator_visual.h>
+#include <ld_code_generator_output_type.h>
+#include <ld_code_generator_output_type_container.h>
+#include <ld_html_code_generator.h>
+#include <ld_latex_code_generator.h>
+
+#include "application.h"
+#include "plug_in_manager.h"
+#include "import_loader.h"
+#include "image_cache.h"
+#include "root_presentation.h"
+#include "printing_engine.h"
+#include "batch_exporter.h"
+
+/***********************************************************************************************************************
+ * BatchExporter::Lane
+ */
+
+BatchExporter::Lane::Lane() {
+    activeJob = Q_NULLPTR;
+}
+
+/***********************************************************************************************************************
+ * BatchExporter::TranslationMonitor
+ */
+
+BatchExporter::TranslationMonitor::TranslationMonitor(BatchExporter* exporter, BatchExporter::Format format) {
+    currentExporter = exporter;
+    currentFormat   = format;
+}
+
+
+BatchExporter::TranslationMonitor::~TranslationMonitor() {}
+
+
+void BatchExporter::TranslationMonitor::translationCompleted(
+        bool                                        success,
+        QSharedPointer<Ld::RootElement>             /* rootElement */,
+        const Ld::CodeGeneratorOutputTypeContainer& /* outputType */
+    ) {
+    report(success);
+}
+
+
+void BatchExporter::TranslationMonitor::translationAborted(
+        QSharedPointer<Ld::RootElement>             /* rootElement */,
+        const Ld::CodeGeneratorOutputTypeContainer& /* outputType */
+    ) {
+    report(false);
+}
+
+
+void BatchExporter::TranslationMonitor::report(bool success) {
+    BatchExporter* exporter = currentExporter;
+    Format         format   = currentFormat;
+
+    QMetaObject::invokeMethod(
+        exporter,
+        [exporter, format, success]() {
+            exporter->exportCompleted(format, success);
+        },
+        Qt::QueuedConnection
+    );
+}
+
+/***********************************************************************************************************************
+ * BatchExporter
+ */
+
+BatchExporter::BatchExporter(
+        QObject* parent
+    ):QObject(
+        parent
+    ),htmlMonitor(
+        this,
+        Format::HTML
+    ),latexMonitor(
+        this,
+        Format::LATEX
+    ) {
+    currentMaximumJobs     = static_cast<unsigned>(std::max(1, QThread::idealThreadCount()));
+    currentImageDpi        = defaultImageDpi;
+    currentIncludeImports  = false;
+    currentPrinter         = Q_NULLPTR;
+    currentPrintingEngine  = Q_NULLPTR;
+    currentNumberFailures  = 0;
+    currentFinished        = false;
+
+    layoutTimer = new QTimer(this);
+    layoutTimer->setSingleShot(false);
+    layoutTimer->setInterval(static_cast<int>(layoutPollingIntervalMSec));
+
+    connect(layoutTimer, &QTimer::timeout, this, &BatchExporter::checkLayouts);
+}
+
+
+BatchExporter::~BatchExporter() {
+    for (QList<Job*>::const_iterator it=pendingLoads.constBegin(),end=pendingLoads.constEnd() ; it!=end ; ++it) {
+        delete *it;
+    }
+
+    if (currentPrintingEngine != Q_NULLPTR) {
+        currentPrintingEngine->abort();
+        currentPrintingEngine->waitComplete();
+        delete currentPrintingEngine;
+        delete currentPrinter;
+    }
+
+    for (  QMap<Format, QSharedPointer<Ld::CodeGenerator>>::const_iterator
+               it  = activeCodeGenerators.constBegin(),
+               end = activeCodeGenerators.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        it.value()->abort();
+        it.value()->setVisual(Q_NULLPTR);
+    }
+
+    QSet<Job*> jobs = loadedJobs;
+    for (QSet<Job*>::const_iterator it=jobs.constBegin(),end=jobs.constEnd() ; it!=end ; ++it) {
+        Job* job = *it;
+        job->remainingFormats.clear();
+        finishJob(job);
+    }
+}
+
+
+bool BatchExporter::isBatchExportRequested(const QStringList& arguments) {
+    bool result = false;
+
+    for (  QStringList::const_iterator it = arguments.constBegin(), end = arguments.constEnd()
+         ; it != end && !result
+         ; ++it
+        ) {
+        result = (*it == QString("--export") || it->startsWith(QString("--export=")));
+    }
+
+    return result;
+}
+
+
+bool BatchExporter::configure(const QStringList& arguments) {
+    QCommandLineParser parser;
+
+    QCommandLineOption exportOption(
+        QString("export"),
+        tr("Comma separated list of formats to export: html, latex, pdf, images."),
+        tr("formats")
+    );
+    QCommandLineOption outputOption(QString("output"), tr("Directory to receive the exported files."), tr("directory"));
+    QCommandLineOption jobsOption(QString("jobs"), tr("Maximum number of documents in flight."), tr("count"));
+    QCommandLineOption dpiOption(QString("dpi"), tr("Image export resolution."), tr("resolution"));
+    QCommandLineOption includeImportsOption(QString("include-imports"), tr("Include imports in the export."));
+
+    parser.addOption(exportOption);
+    parser.addOption(outputOption);
+    parser.addOption(jobsOption);
+    parser.addOption(dpiOption);
+    parser.addOption(includeImportsOption);
+    parser.addPositionalArgument(QString("files"), tr("Documents to export."), tr("files..."));
+
+    bool success = parser.parse(arguments);
+    if (!success) {
+        currentErrorString = parser.errorText();
+    } else {
+        currentFormats = parseFormats(parser.value(exportOption));
+        if (currentFormats.isEmpty()) {
+            currentErrorString = tr("Invalid export format list \"%1\".").arg(parser.value(exportOption));
+            success            = false;
+        }
+    }
+
+    if (success) {
+        currentOutputDirectory = QDir(parser.isSet(outputOption) ? parser.value(outputOption) : QDir::currentPath())
+                                 .absolutePath();
+
+        if (parser.isSet(jobsOption)) {
+            unsigned maximumJobs = parser.value(jobsOption).toUInt(&success);
+            if (!success || maximumJobs == 0) {
+                currentErrorString = tr("Invalid job count \"%1\".").arg(parser.value(jobsOption));
+                success            = false;
+            } else {
+                currentMaximumJobs = maximumJobs;
+            }
+        }
+    }
+
+    if (success && parser.isSet(dpiOption)) {
+        double imageDpi = parser.value(dpiOption).toDouble(&success);
+        if (!success || imageDpi <= 0) {
+            currentErrorString = tr("Invalid resolution \"%1\".").arg(parser.value(dpiOption));
+            success            = false;
+        } else {
+            currentImageDpi = imageDpi;
+        }
+    }
+
+    if (success) {
+        currentIncludeImports = parser.isSet(includeImportsOption);
+        pendingFilenames      = parser.positionalArguments();
+
+        if (pendingFilenames.isEmpty()) {
+            currentErrorString = tr("No documents to export.");
+            success            = false;
+        }
+    }
+
+    return success;
+}
+
+
+QString BatchExporter::errorString() const {
+    return currentErrorString;
+}
+
+
+unsigned long BatchExporter::numberFailures() const {
+    return currentNumberFailures;
+}
+
+
+void BatchExporter::start() {
+    lanes.clear();
+    for (QSet<Format>::const_iterator it=currentFormats.constBegin(),end=currentFormats.constEnd() ; it!=end ; ++it) {
+        lanes.insert(*it, Lane());
+    }
+
+    currentFinished = false;
+
+    startLoads();
+    checkFinished();
+}
+
+
+void BatchExporter::loadNext() {
+    if (!pendingLoads.isEmpty()) {
+        Job*    job = pendingLoads.takeFirst();
+        QString errorString;
+
+        job->rootElement = ImportLoader::loadDocument(
+            job->filename,
+            Application::plugInManager()->plugInsByName(),
+            &errorString
+        );
+
+        if (job->rootElement.isNull()) {
+            if (!errorString.isEmpty()) {
+                job->errors.append(errorString);
+            } else {
+                job->errors.append(tr("Could not load document."));
+            }
+
+            job->remainingFormats.clear();
+            loadedJobs.insert(job);
+            finishJob(job);
+        } else {
+            Ld::RootElement::registerRootElement(job->rootElement);
+            loadedJobs.insert(job);
+
+            QSet<Format> needsLayout;
+            for (  QSet<Format>::const_iterator it = job->remainingFormats.constBegin(),
+                                                end = job->remainingFormats.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                Format format = *it;
+                if (format == Format::HTML || format == Format::LATEX) {
+                    lanes[format].queue.append(job);
+                } else {
+                    needsLayout.insert(format);
+                }
+            }
+
+            if (!needsLayout.isEmpty()) {
+                RootPresentation* rootPresentation = dynamic_cast<RootPresentation*>(job->rootElement->visual());
+                if (rootPresentation != Q_NULLPTR) {
+                    rootPresentation->redraw();
+                    job->layoutTimer.start();
+                    awaitingLayout.append(job);
+
+                    if (!layoutTimer->isActive()) {
+                        layoutTimer->start();
+                    }
+                } else {
+                    job->errors.append(tr("Document has no presentation, can not export PDF or images."));
+                    job->remainingFormats.subtract(needsLayout);
+                }
+            }
+
+            if (job->remainingFormats.isEmpty()) {
+                finishJob(job);
+            }
+        }
+
+        dispatch();
+        startLoads();
+        checkFinished();
+    }
+}
+
+
+void BatchExporter::checkLayouts() {
+    // Applying a decode can replace graphics items and request repositioning.  Decodes are applied before we check
+    // for a coherent display so a layout is only considered complete once it reflects every decoded image.
+
+    ImageCache::waitForPendingDecodes();
+
+    QList<Job*>::iterator it = awaitingLayout.begin();
+    while (it != awaitingLayout.end()) {
+        Job*              job              = *it;
+        RootPresentation* rootPresentation = dynamic_cast<RootPresentation*>(job->rootElement->visual());
+
+        if (rootPresentation->isDisplayCoherent() && !rootPresentation->arePresentationUpdatesPending()) {
+            if (job->remainingFormats.contains(Format::PDF)) {
+                lanes[Format::PDF].queue.append(job);
+            }
+
+            if (job->remainingFormats.contains(Format::IMAGES)) {
+                lanes[Format::IMAGES].queue.append(job);
+            }
+
+            it = awaitingLayout.erase(it);
+        } else if (job->layoutTimer.hasExpired(layoutTimeoutMSec)) {
+            rootPresentation->abortRepositioning();
+
+            job->errors.append(
+                tr("Layout did not complete within %1 seconds, can not export PDF or images.")
+                .arg(layoutTimeoutMSec / 1000)
+            );
+
+            job->remainingFormats.remove(Format::PDF);
+            job->remainingFormats.remove(Format::IMAGES);
+
+            it = awaitingLayout.erase(it);
+
+            if (job->remainingFormats.isEmpty()) {
+                finishJob(job);
+            }
+        } else {
+            ++it;
+        }
+    }
+
+    if (awaitingLayout.isEmpty()) {
+        layoutTimer->stop();
+    }
+
+    dispatch();
+    startLoads();
+    checkFinished();
+}
+
+
+QSet<BatchExporter::Format> BatchExporter::parseFormats(const QString& formatList) {
+    QSet<Format> result;
+    bool         valid   = true;
+    QStringList  entries = formatList.toLower().split(QChar(','), Qt::SplitBehaviorFlags::SkipEmptyParts);
+
+    for (  QStringList::const_iterator it = entries.constBegin(), end = entries.constEnd()
+         ; it != end && valid
+         ; ++it
+        ) {
+        QString entry = it->trimmed();
+        if (entry == QString("html")) {
+            result.insert(Format::HTML);
+        } else if (entry == QString("latex")) {
+            result.insert(Format::LATEX);
+        } else if (entry == QString("pdf")) {
+            result.insert(Format::PDF);
+        } else if (entry == QString("images")) {
+            result.insert(Format::IMAGES);
+        } else {
+            valid = false;
+        }
+    }
+
+    if (!valid) {
+        result.clear();
+    }
+
+    return result;
+}
+
+
+QString BatchExporter::formatName(BatchExporter::Format format) {
+    QString result;
+
+    switch (format) {
+        case Format::HTML:   { result = tr("HTML");   break; }
+        case Format::LATEX:  { result = tr("LaTeX");  break; }
+        case Format::PDF:    { result = tr("PDF");    break; }
+        case Format::IMAGES: { result = tr("images"); break; }
+
+        default: {
+            Q_ASSERT(false);
+            break;
+        }
+    }
+
+    return result;
+}
+
+
+void BatchExporter::startLoads() {
+    while (!pendingFilenames.isEmpty()                                                                &&
+           static_cast<unsigned>(pendingLoads.size() + loadedJobs.size()) < currentMaximumJobs    ) {
+        QString   filename = pendingFilenames.takeFirst();
+        QFileInfo fileInformation(filename);
+
+        Job* job = new Job;
+        job->filename         = fileInformation.absoluteFilePath();
+        job->outputDirectory  = currentOutputDirectory + "/" + fileInformation.completeBaseName();
+        job->remainingFormats = currentFormats;
+        job->busy             = false;
+
+        if (!QDir().mkpath(job->outputDirectory)) {
+            job->errors.append(tr("Could not create directory %1.").arg(job->outputDirectory));
+            job->remainingFormats.clear();
+            loadedJobs.insert(job);
+            finishJob(job);
+        } else {
+            // Ld registers imports as it parses so documents are loaded on this thread.  Loading one document per
+            // pass through the event loop lets the lanes keep exporting documents that are already loaded.
+
+            pendingLoads.append(job);
+            QTimer::singleShot(0, this, &BatchExporter::loadNext);
+        }
+    }
+}
+
+
+void BatchExporter::dispatch() {
+    for (QMap<Format, Lane>::iterator laneIterator=lanes.begin(),end=lanes.end() ; laneIterator!=end ; ++laneIterator) {
+        Lane& lane = laneIterator.value();
+        if (lane.activeJob == Q_NULLPTR) {
+            QList<Job*>::iterator jobIterator = lane.queue.begin();
+            while (jobIterator != lane.queue.end() && (*jobIterator)->busy) {
+                ++jobIterator;
+            }
+
+            if (jobIterator != lane.queue.end()) {
+                Job* job = *jobIterator;
+                lane.queue.erase(jobIterator);
+
+                lane.activeJob = job;
+                job->busy      = true;
+
+                startExport(laneIterator.key(), job);
+            }
+        }
+    }
+}
+
+
+void BatchExporter::startExport(BatchExporter::Format format, BatchExporter::Job* job) {
+    bool started;
+
+    switch (format) {
+        case Format::HTML: {
+            started = startHtmlExport(job);
+            break;
+        }
+
+        case Format::LATEX: {
+            started = startLaTeXExport(job);
+            break;
+        }
+
+        case Format::PDF: {
+            startPdfExport(job);
+            started = true;
+            break;
+        }
+
+        case Format::IMAGES: {
+            // Image exports run on this thread.  We report completion through the event loop so that other lanes
+            // are serviced between documents.
+
+            bool success = exportImages(job);
+            QMetaObject::invokeMethod(
+                this,
+                [this, success]() {
+                    exportCompleted(Format::IMAGES, success);
+                },
+                Qt::QueuedConnection
+            );
+
+            started = true;
+            break;
+        }
+
+        default: {
+            Q_ASSERT(false);
+            started = false;
+            break;
+        }
+    }
+
+    if (!started) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, format]() {
+                exportCompleted(format, false);
+            },
+            Qt::QueuedConnection
+        );
+    }
+}
+
+
+bool BatchExporter::startHtmlExport(BatchExporter::Job* job) {
+    QSharedPointer<Ld::HtmlCodeGenerator>
+        codeGenerator = Ld::CodeGenerator::codeGenerator(Ld::HtmlCodeGenerator::codeGeneratorName)
+                        .dynamicCast<Ld::HtmlCodeGenerator>();
+
+    Q_ASSERT(!codeGenerator.isNull());
+    codeGenerator->setVisual(&htmlMonitor);
+    codeGenerator->setProcessImports(currentIncludeImports);
+    codeGenerator->setReportMissingPerElementTranslators();
+
+    activeCodeGenerators.insert(Format::HTML, codeGenerator);
+
+    QString primaryFile = job->outputDirectory + "/html/index.html";
+    return codeGenerator->translate(
+        job->rootElement,
+        primaryFile,
+        Ld::CodeGeneratorOutputType::ExportMode::EXPORT_AS_DIRECTORY
+    );
+}
+
+
+bool BatchExporter::startLaTeXExport(BatchExporter::Job* job) {
+    QSharedPointer<Ld::LaTeXCodeGenerator>
+        codeGenerator = Ld::CodeGenerator::codeGenerator(Ld::LaTeXCodeGenerator::codeGeneratorName)
+                        .dynamicCast<Ld::LaTeXCodeGenerator>();
+
+    Q_ASSERT(!codeGenerator.isNull());
+    codeGenerator->setVisual(&latexMonitor);
+    codeGenerator->setSingleFile(true);
+    codeGenerator->setCopyrightIncluded();
+    codeGenerator->setProcessImports(currentIncludeImports);
+    codeGenerator->setReportMissingPerElementTranslators();
+
+    activeCodeGenerators.insert(Format::LATEX, codeGenerator);
+
+    QString primaryFile = job->outputDirectory + "/latex/" + Ld::LaTeXCodeGenerator::latexTopFilename;
+    return codeGenerator->translate(
+        job->rootElement,
+        primaryFile,
+        Ld::CodeGeneratorOutputType::ExportMode::EXPORT_AS_DIRECTORY
+    );
+}
+
+
+void BatchExporter::startPdfExport(BatchExporter::Job* job) {
+    QString baseName = QFileInfo(job->filename).completeBaseName();
+
+    // Every image was decoded, and the document repositioned, before the job left BatchExporter::checkLayouts.  The
+    // printing engine also settles the scene before each capture.
+
+    currentPrinter = new QPrinter(QPrinter::HighResolution);
+    currentPrinter->setOutputFormat(QPrinter::PdfFormat);
+    currentPrinter->setDocName(baseName);
+    currentPrinter->setCreator(Application::applicationName());
+    currentPrinter->setOutputFileName(job->outputDirectory + "/" + baseName + ".pdf");
+
+    currentPrintingEngine = new PrintingEngine(currentPrinter, job->rootElement, this);
+    currentPrintingEngine->setRenderingMode(PrintingEngine::RenderingMode::VECTOR_DISPLAY_LISTS);
+
+    connect(
+        currentPrintingEngine,
+        &PrintingEngine::completed,
+        this,
+        [this](bool success) {
+            exportCompleted(Format::PDF, success);
+        },
+        Qt::QueuedConnection
+    );
+    connect(
+        currentPrintingEngine,
+        &PrintingEngine::aborted,
+        this,
+        [this](bool) {
+            exportCompleted(Format::PDF, false);
+        },
+        Qt::QueuedConnection
+    );
+    connect(
+        currentPrintingEngine,
+        &PrintingEngine::errorDetected,
+        this,
+        [job](const QString& errorMessage) {
+            job->errors.append(errorMessage);
+        }
+    );
+
+    currentPrintingEngine->start();
+}
+
+
+bool BatchExporter::exportImages(BatchExporter::Job* job) {
+    QString imageDirectory = job->outputDirectory + "/images";
+    bool    success        = QDir().mkpath(imageDirectory);
+
+    if (success) {
+        unsigned long imageIndex = 0;
+        QStringList   errors;
+
+        exportImages(job->rootElement, imageDirectory, imageIndex, errors);
+
+        success = errors.isEmpty();
+        job->errors.append(errors);
+    } else {
+        job->errors.append(tr("Could not create directory %1.").arg(imageDirectory));
+    }
+
+    return success;
+}
+
+
+void BatchExporter::exportImages(
+        Ld::ElementPointer element,
+        const QString&     imageDirectory,
+        unsigned long&     imageIndex,
+        QStringList&       errors
+    ) {
+    if (element->exportImageCapability() != Ld::Element::ExportImageCapability::NONE) {
+        QByteArray imageData = element->exportImage(currentImageDpi);
+        QPixmap    pixmap;
+        QString    imageFilename = QString("%1/image-%2.png").arg(imageDirectory).arg(imageIndex);
+
+        ++imageIndex;
+
+        if (imageData.isEmpty() || !pixmap.loadFromData(imageData) || !pixmap.save(imageFilename)) {
+            errors.append(tr("Could not export image %1.").arg(imageFilename));
+        }
+    } else {
+        unsigned long numberChildren = element->numberChildren();
+        for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+            Ld::ElementPointer child = element->child(childIndex);
+            if (!child.isNull()) {
+                exportImages(child, imageDirectory, imageIndex, errors);
+            }
+        }
+    }
+}
+
+
+void BatchExporter::exportCompleted(BatchExporter::Format format, bool success) {
+    Lane& lane = lanes[format];
+    Job*  job  = lane.activeJob;
+
+    if (job != Q_NULLPTR) {
+        lane.activeJob = Q_NULLPTR;
+        job->busy      = false;
+
+        if (activeCodeGenerators.contains(format)) {
+            QSharedPointer<Ld::CodeGenerator> codeGenerator = activeCodeGenerators.take(format);
+
+            Ld::DiagnosticPointerList diagnostics = codeGenerator->reportedDiagnostics();
+            for (  Ld::DiagnosticPointerList::const_iterator it = diagnostics.constBegin(), end = diagnostics.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                job->errors.append((*it)->diagnosticMessage());
+            }
+
+            success = success && diagnostics.isEmpty();
+            codeGenerator->setVisual(Q_NULLPTR);
+        }
+
+        if (format == Format::PDF && currentPrintingEngine != Q_NULLPTR) {
+            currentPrintingEngine->disconnect(this);
+            currentPrintingEngine->deleteLater();
+            currentPrintingEngine = Q_NULLPTR;
+
+            delete currentPrinter;
+            currentPrinter = Q_NULLPTR;
+        }
+
+        if (!success) {
+            job->errors.append(tr("%1 export failed.").arg(formatName(format)));
+        }
+
+        job->remainingFormats.remove(format);
+        if (job->remainingFormats.isEmpty()) {
+            finishJob(job);
+        }
+
+        dispatch();
+        startLoads();
+        checkFinished();
+    }
+}
+
+
+void BatchExporter::finishJob(BatchExporter::Job* job) {
+    loadedJobs.remove(job);
+
+    if (job->errors.isEmpty()) {
+        std::cout << tr("Exported %1 to %2").arg(job->filename).arg(job->outputDirectory).toLocal8Bit().constData()
+                  << std::endl;
+    } else {
+        ++currentNumberFailures;
+
+        for (  QStringList::const_iterator it = job->errors.constBegin(), end = job->errors.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            std::cerr << QString("%1: %2").arg(job->filename).arg(*it).toLocal8Bit().constData() << std::endl;
+        }
+    }
+
+    if (!job->rootElement.isNull()) {
+        Ld::RootElement::unregisterRootElement(job->rootElement);
+        job->rootElement->close();
+    }
+
+    delete job;
+}
+
+
+void BatchExporter::checkFinished() {
+    if (!currentFinished            &&
+        pendingFilenames.isEmpty()  &&
+        pendingLoads.isEmpty()      &&
+        loadedJobs.isEmpty()           ) {
+        currentFinished = true;
+        emit finished();
+    }
+}
+
+
+Util::HashResult qHash(BatchExporter::Format value, Util::HashSeed seed) {
+    return qHash(static_cast<int>(value), seed);
+}
@@ -35,6 +35,7 @@
 #include <ld_operator_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "presentation.h"
 #include "presentation_with_fixed_children.h"
 #include "scene_units.h"
@@ -81,7 +82,7 @@ EQt::GraphicsMathGroup* BinaryOperatorPresentationBase::updateGraphicsItem(
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     // Note that the order that we insert into the GraphicsMathGroup matters as we depend on the order later.
 
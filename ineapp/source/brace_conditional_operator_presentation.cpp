@@ -19,6 +19,7 @@
 #include <ld_brace_conditional_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "operator_presentation_base.h"
 #include "brace_conditional_operator_presentation.h"
 
@@ -63,7 +64,7 @@ EQt::GraphicsMathGroup* BraceConditionalOperatorPresentation::updateGraphicsItem
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     QSharedPointer<Ld::BraceConditionalOperatorElement>
         element = BraceConditionalOperatorPresentation::element().dynamicCast<Ld::BraceConditionalOperatorElement>();
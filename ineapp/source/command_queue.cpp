@@ -57,3 +57,18 @@ void CommandQueue::undoFailed(const CommandContainer& failedCommand) {
 void CommandQueue::redoFailed(const CommandContainer& failedCommand) {
     emit redoHasFailed(failedCommand);
 }
+
+
+void CommandQueue::commandExecuted(const CommandContainer& executedCommand) {
+    emit commandHasExecuted(executedCommand);
+}
+
+
+void CommandQueue::undoCompleted(const CommandContainer& undoneCommand) {
+    emit undoHasCompleted(undoneCommand);
+}
+
+
+void CommandQueue::redoCompleted(const CommandContainer& redoneCommand) {
+    emit redoHasCompleted(redoneCommand);
+}
@@ -159,6 +159,8 @@ void CommandQueueBase::insertCommand(const CommandContainer& newCommand) {
     if (!success) {
         commandFailed(newCommand);
     } else {
+        commandExecuted(container);
+
         unsigned long oldRedoStackSize = static_cast<unsigned long>(currentRedoStack.size());
         unsigned long oldUndoStackSize = static_cast<unsigned long>(currentUndoStack.size());
         bool          forceCallbacks   = false;
@@ -204,6 +206,7 @@ void CommandQueueBase::undo() {
             currentUndoStack.removeFirst();
             currentRedoStack.prepend(container);
 
+            undoCompleted(container);
             generateUndoRedoSignals(oldUndoStackSize, oldRedoStackSize);
         } else {
             undoFailed(container);
@@ -229,6 +232,7 @@ void CommandQueueBase::redo() {
             currentRedoStack.removeFirst();
             currentUndoStack.prepend(container);
 
+            redoCompleted(container);
             generateUndoRedoSignals(oldUndoStackSize, oldRedoStackSize);
         } else {
             redoFailed(container);
@@ -257,6 +261,15 @@ void CommandQueueBase::undoFailed(const CommandContainer&) {}
 void CommandQueueBase::redoFailed(const CommandContainer&) {}
 
 
+void CommandQueueBase::commandExecuted(const CommandContainer&) {}
+
+
+void CommandQueueBase::undoCompleted(const CommandContainer&) {}
+
+
+void CommandQueueBase::redoCompleted(const CommandContainer&) {}
+
+
 void CommandQueueBase::generateUndoRedoSignals(
         unsigned long oldUndoStackSize,
         unsigned long oldRedoStackSize,
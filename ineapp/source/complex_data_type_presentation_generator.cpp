@@ -25,6 +25,7 @@
 #include <ld_value_field_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_tracker.h"
 #include "data_type_presentation_generator.h"
 #include "complex_data_type_presentation_generator.h"
@@ -131,7 +132,7 @@ float ComplexDataTypePresentationGenerator::calculateHeight(
     }
 
     font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     if (hasExponent) {
         float        baseFontHeight = fontMetrics.height();
@@ -344,8 +345,8 @@ EQt::GraphicsMultiTextGroup* ComplexDataTypePresentationGenerator::updateGraphic
             }
         }
     } else {
-        QFontMetricsF fontMetrics(font);
-        QPointF       position(0, fontMetrics.ascent());
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+        QPointF              position(0, fontMetrics.ascent());
         addText(graphicsItem, tr("* ERROR *"), font, position, index);
     }
 
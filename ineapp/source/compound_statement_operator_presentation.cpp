@@ -20,6 +20,7 @@
 #include <ld_compound_statement_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_tracker.h"
 #include "presentation_area_tracker.h"
 #include "list_presentation_base.h"
@@ -69,8 +70,8 @@ void CompoundStatementOperatorPresentation::recalculatePlacement(
     QPen   fontPen(color.isValid() ? color : QColor(Qt::black));
     QBrush fontBackgroundBrush(backgroundColor.isValid() ? backgroundColor : QColor(255, 255, 255, 0));
 
-    QFontMetricsF fontMetrics(font);
-    float leftSideMargin    = fontMetrics.horizontalAdvance(tr("M"));
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+    float leftSideMargin    = FontMetricsCache::entry(font).mWidth();
     float verticalSeparator = 0; // fontMetrics.height() / 2.0;
     float fontAscent        = fontMetrics.ascent();
 
@@ -303,233 +303,233 @@
 
 void configure(Registrar* registrar) {
 
-    Ld::Visual::registerCreator(Ld::RootElement::elementName, Document::creator);
-    Ld::Visual::registerCreator(Ld::ParagraphElement::elementName, ParagraphPresentation::creator);
-    Ld::Visual::registerCreator(Ld::TextElement::elementName, TextPresentation::creator);
-    Ld::Visual::registerCreator(Ld::ImageElement::elementName, ImagePresentation::creator);
-    Ld::Visual::registerCreator(Ld::PageBreakElement::elementName, PageBreakPresentation::creator);
-    Ld::Visual::registerCreator(Ld::TableFrameElement::elementName, TableFramePresentation::creator);
-    Ld::Visual::registerCreator(Ld::ValueFieldElement::elementName, ValueFieldPresentation::creator);
-    Ld::Visual::registerCreator(Ld::PlaceholderElement::elementName, PlaceholderPresentation::creator);
-    Ld::Visual::registerCreator(Ld::ListPlaceholderElement::elementName, ListPlaceholderPresentation::creator);
-    Ld::Visual::registerCreator(Ld::FunctionPlaceholderElement::elementName, FunctionPlaceholderPresentation::creator);
-    Ld::Visual::registerCreator(Ld::AssignmentOperatorElement::elementName, AssignmentOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::VariableElement::elementName, VariablePresentation::creator);
-    Ld::Visual::registerCreator(Ld::LiteralElement::elementName, LiteralPresentation::creator);
-    Ld::Visual::registerCreator(Ld::SetElement::elementName, SetPresentation::creator);
-    Ld::Visual::registerCreator(Ld::TupleElement::elementName, TuplePresentation::creator);
-    Ld::Visual::registerCreator(Ld::Range2Element::elementName, Range2Presentation::creator);
-    Ld::Visual::registerCreator(Ld::Range3Element::elementName, Range3Presentation::creator);
-    Ld::Visual::registerCreator(Ld::PiSpecialValueElement::elementName, PiSpecialValuePresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::RootElement::elementName, Document::creator);
+    registrar->registerVisual(Ld::ParagraphElement::elementName, ParagraphPresentation::creator);
+    registrar->registerVisual(Ld::TextElement::elementName, TextPresentation::creator);
+    registrar->registerVisual(Ld::ImageElement::elementName, ImagePresentation::creator);
+    registrar->registerVisual(Ld::PageBreakElement::elementName, PageBreakPresentation::creator);
+    registrar->registerVisual(Ld::TableFrameElement::elementName, TableFramePresentation::creator);
+    registrar->registerVisual(Ld::ValueFieldElement::elementName, ValueFieldPresentation::creator);
+    registrar->registerVisual(Ld::PlaceholderElement::elementName, PlaceholderPresentation::creator);
+    registrar->registerVisual(Ld::ListPlaceholderElement::elementName, ListPlaceholderPresentation::creator);
+    registrar->registerVisual(Ld::FunctionPlaceholderElement::elementName, FunctionPlaceholderPresentation::creator);
+    registrar->registerVisual(Ld::AssignmentOperatorElement::elementName, AssignmentOperatorPresentation::creator);
+    registrar->registerVisual(Ld::VariableElement::elementName, VariablePresentation::creator);
+    registrar->registerVisual(Ld::LiteralElement::elementName, LiteralPresentation::creator);
+    registrar->registerVisual(Ld::SetElement::elementName, SetPresentation::creator);
+    registrar->registerVisual(Ld::TupleElement::elementName, TuplePresentation::creator);
+    registrar->registerVisual(Ld::Range2Element::elementName, Range2Presentation::creator);
+    registrar->registerVisual(Ld::Range3Element::elementName, Range3Presentation::creator);
+    registrar->registerVisual(Ld::PiSpecialValueElement::elementName, PiSpecialValuePresentation::creator);
+    registrar->registerVisual(
         Ld::EulersNumberSpecialValueElement::elementName,
         EulersNumberSpecialValuePresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::EpsilonSpecialValueElement::elementName,
         EpsilonSpecialValuePresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::InfinitySpecialValueElement::elementName,
         InfinitySpecialValuePresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::NullSetSpecialValueElement::elementName, NullSetSpecialValuePresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::NullSetSpecialValueElement::elementName, NullSetSpecialValuePresentation::creator);
+    registrar->registerVisual(
         Ld::ElementOfSetOperatorElement::elementName,
         ElementOfSetOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::BooleanTypeElement::elementName, BooleanTypePresentation::creator);
-    Ld::Visual::registerCreator(Ld::IntegerTypeElement::elementName, IntegerTypePresentation::creator);
-    Ld::Visual::registerCreator(Ld::RealTypeElement::elementName, RealTypePresentation::creator);
-    Ld::Visual::registerCreator(Ld::ComplexTypeElement::elementName, ComplexTypePresentation::creator);
-    Ld::Visual::registerCreator(Ld::AdditionOperatorElement::elementName, AdditionOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::SubtractionOperatorElement::elementName, SubtractionOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::BooleanTypeElement::elementName, BooleanTypePresentation::creator);
+    registrar->registerVisual(Ld::IntegerTypeElement::elementName, IntegerTypePresentation::creator);
+    registrar->registerVisual(Ld::RealTypeElement::elementName, RealTypePresentation::creator);
+    registrar->registerVisual(Ld::ComplexTypeElement::elementName, ComplexTypePresentation::creator);
+    registrar->registerVisual(Ld::AdditionOperatorElement::elementName, AdditionOperatorPresentation::creator);
+    registrar->registerVisual(Ld::SubtractionOperatorElement::elementName, SubtractionOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::MultiplicationOperatorElement::elementName,
         MultiplicationOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::DivisionOperatorElement::elementName, DivisionOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::FractionOperatorElement::elementName, FractionOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::UnaryPlusOperatorElement::elementName, UnaryPlusOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::UnaryMinusOperatorElement::elementName, UnaryMinusOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::DivisionOperatorElement::elementName, DivisionOperatorPresentation::creator);
+    registrar->registerVisual(Ld::FractionOperatorElement::elementName, FractionOperatorPresentation::creator);
+    registrar->registerVisual(Ld::UnaryPlusOperatorElement::elementName, UnaryPlusOperatorPresentation::creator);
+    registrar->registerVisual(Ld::UnaryMinusOperatorElement::elementName, UnaryMinusOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::GroupingParenthesisOperatorElement::elementName,
         GroupingParenthesisOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::GroupingBracketsOperatorElement::elementName,
         GroupingBracketsOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::GroupingBracesOperatorElement::elementName,
         GroupingBracesOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::PowerOperatorElement::elementName, PowerOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::SquareRootOperatorElement::elementName, SquareRootOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::RootOperatorElement::elementName, RootOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::PowerOperatorElement::elementName, PowerOperatorPresentation::creator);
+    registrar->registerVisual(Ld::SquareRootOperatorElement::elementName, SquareRootOperatorPresentation::creator);
+    registrar->registerVisual(Ld::RootOperatorElement::elementName, RootOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::ComplexConjugateOperatorElement::elementName,
         ComplexConjugateOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::FactorialOperatorElement::elementName, FactorialOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::FactorialOperatorElement::elementName, FactorialOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::AbsoluteValueOperatorElement::elementName,
         AbsoluteValueOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::FloorOperatorElement::elementName, FloorOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::CeilingOperatorElement::elementName, CeilingOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::FloorOperatorElement::elementName, FloorOperatorPresentation::creator);
+    registrar->registerVisual(Ld::CeilingOperatorElement::elementName, CeilingOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::NearestIntegerOperatorElement::elementName,
         NearestIntegerOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::NotEqualToOperatorElement::elementName, NotEqualToOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::LessThanOperatorElement::elementName, LessThanOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::GreaterThanOperatorElement::elementName, GreaterThanOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::NotEqualToOperatorElement::elementName, NotEqualToOperatorPresentation::creator);
+    registrar->registerVisual(Ld::LessThanOperatorElement::elementName, LessThanOperatorPresentation::creator);
+    registrar->registerVisual(Ld::GreaterThanOperatorElement::elementName, GreaterThanOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::LessThanOrEqualToOperatorElement::elementName,
         LessThanOrEqualToOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::GreaterThanOrEqualToOperatorElement::elementName,
         GreaterThanOrEqualToOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::UnionOperatorElement::elementName, UnionOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::UnionOperatorElement::elementName, UnionOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::IntersectionOperatorElement::elementName,
         IntersectionOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::DisjointUnionOperatorElement::elementName,
         DisjointUnionOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::CartesianProductOperatorElement::elementName,
         CartesianProductOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::SetDifferenceOperatorElement::elementName,
         SetDifferenceOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::SymmetricDifferenceOperatorElement::elementName,
         SymmetricDifferenceOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::NaryUnionOperatorElement::elementName, NaryUnionOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::NaryUnionOperatorElement::elementName, NaryUnionOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::NaryDisjointUnionOperatorElement::elementName,
         NaryDisjointUnionOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::NotElementOfSetOperatorElement::elementName,
         NotElementOfSetOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::SetContainsAsMemberOperatorElement::elementName,
         SetContainsAsMemberOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::NotSetContainsAsMemberOperatorElement::elementName,
         NotSetContainsAsMemberOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::SubsetOperatorElement::elementName, SubsetOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::SubsetOperatorElement::elementName, SubsetOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::ProperSubsetOperatorElement::elementName,
         ProperSubsetOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::SupersetOperatorElement::elementName, SupersetOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::SupersetOperatorElement::elementName, SupersetOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::ProperSupersetOperatorElement::elementName,
         ProperSupersetOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::NotSubsetOperatorElement::elementName, NotSubsetOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::NotSubsetOperatorElement::elementName, NotSubsetOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::NotProperSubsetOperatorElement::elementName,
         NotProperSubsetOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::NotSupersetOperatorElement::elementName, NotSupersetOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::NotSupersetOperatorElement::elementName, NotSupersetOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::NotProperSupersetOperatorElement::elementName,
         NotProperSupersetOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::LogicalUnaryNotOperatorElement::elementName,
         LogicalUnaryNotOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::LogicalOverbarNotOperatorElement::elementName,
         LogicalOverbarNotOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::LogicalAndOperatorElement::elementName, LogicalAndOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::LogicalOrOperatorElement::elementName, LogicalOrOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::LogicalAndOperatorElement::elementName, LogicalAndOperatorPresentation::creator);
+    registrar->registerVisual(Ld::LogicalOrOperatorElement::elementName, LogicalOrOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::LogicalExclusiveOrOperatorElement::elementName,
         LogicalExclusiveOrOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::LogicalConditionalOperatorElement::elementName,
         LogicalConditionalOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::LogicalBiconditionalOperatorElement::elementName,
         LogicalBiconditionalOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::LogicalTrueSpecialValueElement::elementName,
         LogicalTrueSpecialValuePresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::LogicalFalseSpecialValueElement::elementName,
         LogicalFalseSpecialValuePresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::SubscriptIndexOperatorElement::elementName,
         SubscriptIndexOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::SubscriptRowColumnOperatorElement::elementName,
         SubscriptRowColumnOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::MatrixOperatorElement::elementName, MatrixOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::MatrixOperatorElement::elementName, MatrixOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::MatrixCombineLeftToRightOperatorElement::elementName,
         MatrixCombineLeftToRightOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::MatrixCombineTopToBottomOperatorElement::elementName,
         MatrixCombineTopToBottomOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::HadamardProductOperatorElement::elementName,
         HadamardProductOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::KroneckerProductOperatorElement::elementName,
         KroneckerProductOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::MatrixTransposeOperatorElement::elementName,
         MatrixTransposeOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(
         Ld::MatrixConjugateTransposeOperatorElement::elementName,
         MatrixConjugateTransposeOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::ForAllInOperatorElement::elementName, ForAllInOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::WhileOperatorElement::elementName, WhileOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::ForAllInOperatorElement::elementName, ForAllInOperatorPresentation::creator);
+    registrar->registerVisual(Ld::WhileOperatorElement::elementName, WhileOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::CompoundStatementOperatorElement::elementName,
         CompoundStatementOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::IfOperatorElement::elementName, IfOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::ElseIfOperatorElement::elementName, ElseIfOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::ElseOperatorElement::elementName, ElseOperatorPresentation::creator);
-    Ld::Visual::registerCreator(
+    registrar->registerVisual(Ld::IfOperatorElement::elementName, IfOperatorPresentation::creator);
+    registrar->registerVisual(Ld::ElseIfOperatorElement::elementName, ElseIfOperatorPresentation::creator);
+    registrar->registerVisual(Ld::ElseOperatorElement::elementName, ElseOperatorPresentation::creator);
+    registrar->registerVisual(
         Ld::BraceConditionalOperatorElement::elementName,
         BraceConditionalOperatorPresentation::creator
     );
-    Ld::Visual::registerCreator(Ld::ThereforeOperatorElement::elementName, ThereforeOperatorPresentation::creator);
-    Ld::Visual::registerCreator(Ld::FunctionElement::elementName, FunctionPresentation::creator);
-    Ld::Visual::registerCreator(Ld::PlotElement::elementName, PlotPresentation::creator);
+    registrar->registerVisual(Ld::ThereforeOperatorElement::elementName, ThereforeOperatorPresentation::creator);
+    registrar->registerVisual(Ld::FunctionElement::elementName, FunctionPresentation::creator);
+    registrar->registerVisual(Ld::PlotElement::elementName, PlotPresentation::creator);
 
     Ld::DataType::registerDecoder(Model::ValueType::BOOLEAN, &BooleanDataTypePresentationGenerator::instance);
     Ld::DataType::registerDecoder(Model::ValueType::INTEGER, &IntegerDataTypePresentationGenerator::instance);
@@ -38,6 +38,7 @@ void ControlFlowOperatorPresentationBase::processInstructionBreakpointUpdated(bo
         if (!parent.isNull()) {
             PlacementNegotiator* parentPlacementNegotiator = dynamic_cast<PlacementNegotiator*>(parent->visual());
             if (parentPlacementNegotiator != Q_NULLPTR) {
+                flagPendingRepositioning();
                 parentPlacementNegotiator->requestRepositioning(this);
             }
         }
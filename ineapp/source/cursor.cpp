@@ -12,6 +12,8 @@
 #include <QPainter>
 #include <QPointF>
 #include <QRectF>
+#include <QString>
+#include <QStringList>
 
 #include <ld_element_structures.h>
 #include <ld_element.h>
@@ -32,12 +34,15 @@
 #include <ld_element_with_grid_children.h>
 #include <ld_element_with_floating_children.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
 #include <QDebug>
 
 #include "presentation.h"
+#include "paragraph_line_index.h"
+#include "paragraph_presentation_base.h"
 #include "fixer.h"
 #include "root_presentation.h"
 #include "cursor.h"
@@ -47,8 +52,9 @@ const QBrush                    Cursor::cursorBrush(Qt::GlobalColor::white);
 const QPainter::CompositionMode Cursor::compositionMode = QPainter::CompositionMode::CompositionMode_Difference;
 
 Cursor::Cursor() {
-    currentCursorType = Type::INVALID;
-    lastCursorType    = Type::INVALID;
+    currentCursorType                 = Type::INVALID;
+    lastCursorType                    = Type::INVALID;
+    selectionRectangleCacheGeneration = 0;
 
     lastSelectedElement.clear();
 }
@@ -64,22 +70,25 @@ Cursor::Cursor(
         ? newRootPresentation->element().dynamicCast<Ld::RootElement>().toWeakRef()
         : QWeakPointer<Ld::RootElement>()
     ) {
-    currentCursorType    = Type::INVALID;
-    lastCursorType       = Type::INVALID;
-    currentSelectionType = SelectionType::NO_SELECTION;
+    currentCursorType                 = Type::INVALID;
+    lastCursorType                    = Type::INVALID;
+    currentSelectionType              = SelectionType::NO_SELECTION;
+    selectionRectangleCacheGeneration = 0;
 
     lastSelectedElement.clear();
 }
 
 
 Cursor::Cursor(const Cursor& other):QObject(), Ld::Cursor(other) {
-    currentCursorType          = other.currentCursorType;
-    lastCursorType             = other.lastCursorType;
-    currentSelectionType       = other.currentSelectionType;
-    reportedSelectionCursor    = other.reportedSelectionCursor;
-    lastSelectedElement        = other.lastSelectedElement;
-    currentSelectionRectangles = other.currentSelectionRectangles;
-    currentBoundingRectangle   = other.currentBoundingRectangle;
+    currentCursorType                 = other.currentCursorType;
+    lastCursorType                    = other.lastCursorType;
+    currentSelectionType              = other.currentSelectionType;
+    reportedSelectionCursor           = other.reportedSelectionCursor;
+    lastSelectedElement               = other.lastSelectedElement;
+    currentSelectionRectangles        = other.currentSelectionRectangles;
+    currentBoundingRectangle          = other.currentBoundingRectangle;
+    selectionRectangleCache           = other.selectionRectangleCache;
+    selectionRectangleCacheGeneration = other.selectionRectangleCacheGeneration;
 }
 
 
@@ -239,41 +248,48 @@ bool Cursor::moveForwardByLine(bool selection) {
     bool isLast = false;
 
     if (okToAdjustCursor(isLast)) {
-        Ld::ElementCursor newCursor        = Cursor::elementCursor();
-        QPointF           startingLocation = locationOfCursor(newCursor);
-        QPointF           newLocation      = startingLocation;
-        Ld::ElementCursor lastCursor;
-        QPointF           lastLocation;
+        Ld::ElementCursor newCursor;
+        if (cursorOnAdjacentLine(Cursor::elementCursor(), true, newCursor)) {
+            isLast = newCursor.fixPosition(false, false);
+        } else {
+            newCursor = Cursor::elementCursor();
 
-        do {
-            lastCursor   = newCursor;
-            lastLocation = newLocation;
+            QPointF           startingLocation = locationOfCursor(newCursor);
+            QPointF           newLocation      = startingLocation;
+            Ld::ElementCursor lastCursor;
+            QPointF           lastLocation;
 
-            isLast      = newCursor.moveForwardByCharacter();
-            newLocation = locationOfCursor(newCursor);
-        } while (!isLast && newLocation.x() >= lastLocation.x());
+            do {
+                lastCursor   = newCursor;
+                lastLocation = newLocation;
 
-        bool iterated = false;
-        lastCursor    = newCursor;
-        lastLocation  = newLocation;
+                isLast      = newCursor.moveForwardByCharacter();
+                newLocation = locationOfCursor(newCursor);
+            } while (!isLast && newLocation.x() >= lastLocation.x());
 
-        while (!isLast && newLocation.x() < startingLocation.x() && newLocation.x() >= lastLocation.x()) {
-            iterated = true;
+            bool iterated = false;
+            lastCursor    = newCursor;
+            lastLocation  = newLocation;
 
-            lastCursor   = newCursor;
-            lastLocation = newLocation;
+            while (!isLast && newLocation.x() < startingLocation.x() && newLocation.x() >= lastLocation.x()) {
+                iterated = true;
 
-            isLast      = newCursor.moveForwardByCharacter();
-            newLocation = locationOfCursor(newCursor);
-        }
+                lastCursor   = newCursor;
+                lastLocation = newLocation;
 
-        if (!isLast && iterated                                                                    &&
-            (lastLocation.x() > newLocation.x()                                               ||
-             startingLocation.x() - lastLocation.x() < newLocation.x() - startingLocation.x()    )    ) {
-            newCursor = lastCursor;
+                isLast      = newCursor.moveForwardByCharacter();
+                newLocation = locationOfCursor(newCursor);
+            }
+
+            if (!isLast && iterated                                                                    &&
+                (lastLocation.x() > newLocation.x()                                               ||
+                 startingLocation.x() - lastLocation.x() < newLocation.x() - startingLocation.x()    )    ) {
+                newCursor = lastCursor;
+            }
+
+            isLast = newCursor.fixPosition(false, isLast); // False keeps us from moving past the end of the next line.
         }
 
-        isLast = newCursor.fixPosition(false, isLast);  // False keeps us from moving past the end of the next line.
         updateFromElementCursor(newCursor, true);
     }
 
@@ -287,41 +303,48 @@ bool Cursor::moveBackwardByLine(bool selection) {
     bool isFirst = false;
 
     if (okToAdjustCursor(isFirst)) {
-        Ld::ElementCursor newCursor        = Cursor::elementCursor();
-        QPointF           startingLocation = locationOfCursor(newCursor);
-        QPointF           newLocation      = startingLocation;
-        Ld::ElementCursor lastCursor;
-        QPointF           lastLocation;
+        Ld::ElementCursor newCursor;
+        if (cursorOnAdjacentLine(Cursor::elementCursor(), false, newCursor)) {
+            isFirst = newCursor.fixPosition(true, false);
+        } else {
+            newCursor = Cursor::elementCursor();
 
-        do {
-            lastCursor   = newCursor;
-            lastLocation = newLocation;
+            QPointF           startingLocation = locationOfCursor(newCursor);
+            QPointF           newLocation      = startingLocation;
+            Ld::ElementCursor lastCursor;
+            QPointF           lastLocation;
 
-            isFirst      = newCursor.moveBackwardByCharacter();
-            newLocation  = locationOfCursor(newCursor);
-        } while (!isFirst && newLocation.x() <= lastLocation.x());
+            do {
+                lastCursor   = newCursor;
+                lastLocation = newLocation;
 
-        bool iterated = false;
-        lastCursor    = newCursor;
-        lastLocation  = newLocation;
+                isFirst      = newCursor.moveBackwardByCharacter();
+                newLocation  = locationOfCursor(newCursor);
+            } while (!isFirst && newLocation.x() <= lastLocation.x());
 
-        while (!isFirst && newLocation.x() > startingLocation.x() && newLocation.x() <= lastLocation.x()) {
-            iterated = true;
+            bool iterated = false;
+            lastCursor    = newCursor;
+            lastLocation  = newLocation;
 
-            lastCursor   = newCursor;
-            lastLocation = newLocation;
+            while (!isFirst && newLocation.x() > startingLocation.x() && newLocation.x() <= lastLocation.x()) {
+                iterated = true;
 
-            isFirst      = newCursor.moveBackwardByCharacter();
-            newLocation  = locationOfCursor(newCursor);
-        }
+                lastCursor   = newCursor;
+                lastLocation = newLocation;
+
+                isFirst      = newCursor.moveBackwardByCharacter();
+                newLocation  = locationOfCursor(newCursor);
+            }
+
+            if (!isFirst && iterated                                                                   &&
+                (lastLocation.x() < newLocation.x()                                               ||
+                 lastLocation.x() - startingLocation.x() < startingLocation.x() - newLocation.x()    )    ) {
+                newCursor = lastCursor;
+            }
 
-        if (!isFirst && iterated                                                                   &&
-            (lastLocation.x() < newLocation.x()                                               ||
-             lastLocation.x() - startingLocation.x() < startingLocation.x() - newLocation.x()    )    ) {
-            newCursor = lastCursor;
+            isFirst = newCursor.fixPosition(true, isFirst); // true keeps us from moving past the start of the line.
         }
 
-        isFirst = newCursor.fixPosition(true, isFirst); // true keeps us from moving past the start of the line.
         updateFromElementCursor(newCursor, true);
     }
 
@@ -952,8 +975,9 @@ void Cursor::drawCursor(QPainter* painter, const QRectF& sceneRectangle, bool ma
 
 
 QString Cursor::selectionAsText(bool* ok, QMap<unsigned long, Ld::ElementCursor>* breakdown) const {
-    QString result;
-    bool    valid = true;
+    QString     result;
+    QStringList pieces;
+    bool        valid = true;
 
     if (breakdown != nullptr) {
         breakdown->clear();
@@ -969,12 +993,12 @@ QString Cursor::selectionAsText(bool* ok, QMap<unsigned long, Ld::ElementCursor>
         Ld::ElementCursor  activeCursor = startCursor;
         Ld::ElementPointer previousElement;
         unsigned           previousRegionIndex = 0;
+        unsigned long      resultLength        = 0;
 
         while (valid && activeCursor != endCursor) {
             Ld::ElementPointer element = activeCursor.element();
             if (element.isNull() || activeCursor.isWholeElement()) {
                 valid = false;
-                result.clear();
             } else {
                 unsigned regionIndex = activeCursor.regionIndex();
 
@@ -986,22 +1010,18 @@ QString Cursor::selectionAsText(bool* ok, QMap<unsigned long, Ld::ElementCursor>
                     )                                                      ) {
                     unsigned long textIndex = activeCursor.textIndex();
 
-                    QString newText;
-                    if (textIndex == 0) {
-                        newText = element->text(regionIndex);
-                    } else {
-                        newText = element->text(regionIndex).mid(textIndex);
-                    }
+                    QString regionText = element->text(regionIndex);
 
                     if (breakdown != nullptr) {
-                        breakdown->insert(static_cast<unsigned long>(result.size()), activeCursor);
+                        breakdown->insert(resultLength, activeCursor);
                     }
 
                     if (element == endCursor.element() && regionIndex == endCursor.regionIndex()) {
-                        result += newText.left(endCursor.textIndex() - textIndex);
+                        pieces.append(regionText.mid(textIndex, endCursor.textIndex() - textIndex));
                         activeCursor = endCursor;
                     } else {
-                        result += newText;
+                        pieces.append(textIndex == 0 ? regionText : regionText.mid(textIndex));
+                        resultLength += static_cast<unsigned long>(pieces.last().size());
 
                         activeCursor.moveForwardByRegion();
                         activeCursor.fixPosition(true, false);
@@ -1011,10 +1031,14 @@ QString Cursor::selectionAsText(bool* ok, QMap<unsigned long, Ld::ElementCursor>
                     }
                 } else {
                     valid = false;
-                    result.clear();
                 }
             }
         }
+
+        if (valid) {
+            // QStringList::join sizes the result once rather than growing it region by region.
+            result = pieces.join(QString());
+        }
     } else {
         valid = false;
     }
@@ -1057,13 +1081,15 @@ void Cursor::cursorChanged(bool movingForward) {
 Cursor& Cursor::operator=(const Cursor& other) {
     Ld::Cursor::operator=(other);
 
-    currentCursorType          = other.currentCursorType;
-    lastCursorType             = other.lastCursorType;
-    currentSelectionType       = other.currentSelectionType;
-    reportedSelectionCursor    = other.reportedSelectionCursor;
-    lastSelectedElement        = other.lastSelectedElement;
-    currentSelectionRectangles = other.currentSelectionRectangles;
-    currentBoundingRectangle   = other.currentBoundingRectangle;
+    currentCursorType                 = other.currentCursorType;
+    lastCursorType                    = other.lastCursorType;
+    currentSelectionType              = other.currentSelectionType;
+    reportedSelectionCursor           = other.reportedSelectionCursor;
+    lastSelectedElement               = other.lastSelectedElement;
+    currentSelectionRectangles        = other.currentSelectionRectangles;
+    currentBoundingRectangle          = other.currentBoundingRectangle;
+    selectionRectangleCache           = other.selectionRectangleCache;
+    selectionRectangleCacheGeneration = other.selectionRectangleCacheGeneration;
 
     return *this;
 }
@@ -1268,6 +1294,78 @@ Ld::Location Cursor::locationOfCursor(const Ld::ElementCursor& cursor) const {
 }
 
 
+bool Cursor::cursorOnAdjacentLine(const Ld::ElementCursor& cursor, bool forward, Ld::ElementCursor& result) const {
+    bool found = false;
+
+    Ld::ElementPointer element = cursor.isValid() ? cursor.element() : Ld::ElementPointer();
+    if (!element.isNull() && !element->parent().isNull()) {
+        Ld::ElementPointer               paragraphElement = element->parent();
+        const Presentation*              presentation     = dynamic_cast<const Presentation*>(element->visual());
+        const ParagraphPresentationBase* paragraph        = dynamic_cast<const ParagraphPresentationBase*>(
+            paragraphElement->visual()
+        );
+
+        if (presentation != Q_NULLPTR && paragraph != Q_NULLPTR) {
+            QList<QRectF> cursorRectangles = presentation->cursorRangeToScene(cursor);
+            long          lineNumber       = (
+                  cursorRectangles.isEmpty()
+                ? ParagraphLineIndex::notFound
+                : paragraph->lineAtLocation(cursorRectangles.first().center())
+            );
+
+            if (lineNumber != ParagraphLineIndex::notFound) {
+                const ParagraphPresentationBase* targetParagraph = paragraph;
+                long                             targetLine      = forward ? lineNumber + 1 : lineNumber - 1;
+
+                if (targetLine < 0 || targetLine >= static_cast<long>(paragraph->numberLines())) {
+                    Ld::ElementPointer sibling = (
+                          forward
+                        ? paragraphElement->nextSibling()
+                        : paragraphElement->previousSibling()
+                    );
+
+                    targetParagraph = (
+                          sibling.isNull()
+                        ? Q_NULLPTR
+                        : dynamic_cast<const ParagraphPresentationBase*>(sibling->visual())
+                    );
+
+                    if (targetParagraph != Q_NULLPTR && targetParagraph->numberLines() > 0) {
+                        targetLine = forward ? 0 : static_cast<long>(targetParagraph->numberLines()) - 1;
+                    } else {
+                        targetParagraph = Q_NULLPTR;
+                    }
+                }
+
+                if (targetParagraph != Q_NULLPTR) {
+                    QPointF lineLocation = targetParagraph->locationOnLine(
+                        static_cast<unsigned long>(targetLine),
+                        cursorRectangles.first().left()
+                    );
+
+                    const Presentation* bestPresentation = Q_NULLPTR;
+                    unsigned long       bestPresentationArea;
+                    QPointF             bestLocation;
+                    targetParagraph->distanceToClosestPresentationArea(
+                        lineLocation,
+                        &bestPresentation,
+                        &bestPresentationArea,
+                        &bestLocation
+                    );
+
+                    if (bestPresentation != Q_NULLPTR) {
+                        result = bestPresentation->presentationAtLocation(bestLocation, true);
+                        found  = result.isValid();
+                    }
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+
 void Cursor::updateSelectionRectangles() const {
     const Ld::ElementCursor elementCursor = Cursor::elementCursor();
     if (elementCursor.isValid()) {
@@ -1279,11 +1377,21 @@ void Cursor::updateSelectionRectangles() const {
             Q_ASSERT(presentation != Q_NULLPTR);
 
             currentSelectionRectangles = presentation->cursorRangeToScene(elementCursor);
+            selectionRectangleCache.clear();
         } else {
+            RootPresentation* rootPresentation = Cursor::rootPresentation();
+            if (rootPresentation != Q_NULLPTR                                                    &&
+                rootPresentation->placementGeneration() != selectionRectangleCacheGeneration    ) {
+                selectionRectangleCache.clear();
+                selectionRectangleCacheGeneration = rootPresentation->placementGeneration();
+            }
+
             const Ld::ElementCursor& leftElementCursor  = startCursor();
             const Ld::ElementCursor& rightElementCursor = endCursor();
             Ld::ElementPointer       cursorElement      = leftElementCursor.element();
             Ld::ElementPointer       endingElement      = rightElementCursor.element();
+            QList<QRectF>            rectangles;
+            SelectionRectangleCache  updatedCache;
 
             if (cursorElement != endingElement) {
                 Ld::ElementCursor        cursor       = leftElementCursor;
@@ -1292,28 +1400,42 @@ void Cursor::updateSelectionRectangles() const {
                 Ld::ElementPointerSet    endingStackSet(endingStack.constBegin(), endingStack.constEnd());
 
                 while (!endingStackSet.contains(cursorElement)) {
-                    currentSelectionRectangles += selectionRectanglesForElement(cursor, cursorElement, endingCursor);
+                    rectangles += cachedSelectionRectanglesForElement(
+                        cursor,
+                        cursorElement,
+                        endingCursor,
+                        updatedCache
+                    );
                 }
 
                 while (cursorElement != endingElement && cursor < endingCursor) {
-                    currentSelectionRectangles += selectionRectanglesForElement(cursor, cursorElement, endingElement);
+                    if (endingStackSet.contains(cursorElement)) {
+                        rectangles += selectionRectanglesForElement(cursor, cursorElement, endingElement);
+                    } else {
+                        rectangles += cachedSelectionRectanglesForElement(
+                            cursor,
+                            cursorElement,
+                            endingElement,
+                            updatedCache
+                        );
+                    }
                 }
 
                 if (cursorElement == endingElement) {
                     cursor.moveToFirstPositionInElement();
-                    currentSelectionRectangles += calculateSelectionRectanglesForElement(
-                        cursorElement,
-                        cursor,
-                        endingCursor
-                    );
+                    rectangles += calculateSelectionRectanglesForElement(cursorElement, cursor, endingCursor);
                 }
             } else {
-                currentSelectionRectangles += calculateSelectionRectanglesForElement(
+                rectangles = calculateSelectionRectanglesForElement(
                     cursorElement,
                     leftElementCursor,
                     rightElementCursor
                 );
             }
+
+            // Elements that left the selection are dropped from the cache.
+            selectionRectangleCache.swap(updatedCache);
+            currentSelectionRectangles = mergeSelectionRectangles(rectangles);
         }
 
         unsigned long numberRectangles = static_cast<unsigned long>(currentSelectionRectangles.size());
@@ -1326,10 +1448,75 @@ void Cursor::updateSelectionRectangles() const {
     } else {
         currentSelectionRectangles.clear();
         currentBoundingRectangle = QRectF();
+        selectionRectangleCache.clear();
     }
 }
 
 
+QList<QRectF> Cursor::cachedSelectionRectanglesForElement(
+        Ld::ElementCursor&       cursor,
+        Ld::ElementPointer&      element,
+        const Ld::ElementCursor& endingCursor,
+        SelectionRectangleCache& updatedCache
+    ) const {
+    QList<QRectF> result;
+
+    Presentation* presentation = dynamic_cast<Presentation*>(element->visual());
+    if (presentation->cursorCanHighlight()) {
+        const Ld::Element* key = element.data();
+
+        SelectionRectangleCache::const_iterator cached = selectionRectangleCache.constFind(key);
+        if (cached != selectionRectangleCache.constEnd() && cached->first == cursor) {
+            result = cached->second;
+        } else {
+            result = presentation->cursorRangeToScene(endingCursor, cursor);
+        }
+
+        updatedCache.insert(key, CachedSelectionRectangles(cursor, result));
+        advanceSelectionCursor(cursor, element);
+    } else {
+        cursor.moveForwardByElement();
+        element = cursor.element();
+    }
+
+    return result;
+}
+
+
+QList<QRectF> Cursor::mergeSelectionRectangles(const QList<QRectF>& rectangles) {
+    static constexpr double tolerance = 0.5;
+
+    QList<QRectF> result;
+
+    for (QList<QRectF>::const_iterator it=rectangles.constBegin(),end=rectangles.constEnd() ; it!=end ; ++it) {
+        const QRectF& rectangle = *it;
+
+        if (result.isEmpty()) {
+            result.append(rectangle);
+        } else {
+            QRectF& last     = result.last();
+            bool    sameLine = (
+                   std::abs(last.top() - rectangle.top()) < tolerance
+                && std::abs(last.bottom() - rectangle.bottom()) < tolerance
+            );
+            bool    touching = (
+                   rectangle.left() <= last.right() + tolerance
+                && rectangle.right() >= last.left() - tolerance
+            );
+
+            if (sameLine && touching) {
+                last.setLeft(std::min(last.left(), rectangle.left()));
+                last.setRight(std::max(last.right(), rectangle.right()));
+            } else {
+                result.append(rectangle);
+            }
+        }
+    }
+
+    return result;
+}
+
+
 void Cursor::advanceSelectionCursor(Ld::ElementCursor& cursor, Ld::ElementPointer& element) {
     Ld::ElementPointer nextSibling = element->nextSibling();
     if (nextSibling.isNull()) {
@@ -13,6 +13,8 @@
 #include <QFontMetricsF>
 #include <QPen>
 #include <QBrush>
+#include <QHash>
+#include <QVector>
 
 #include <eqt_graphics_text_item.h>
 #include <eqt_graphics_math_group.h>
@@ -23,11 +25,76 @@
 #include "ld_data_type_decoder.h"
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
 #include "data_type_presenter.h"
 #include "data_type_presentation_generator.h"
 
+/***********************************************************************************************************************
+ * DataTypePresentationGenerator::MeasurementScope
+ */
+
+namespace {
+    /**
+     * Key used to locate a cached measurement.
+     */
+    struct MeasurementKey {
+        const Model::Variant* value;
+        const Ld::Format*     format;
+        float                 relativeScale;
+
+        bool operator==(const MeasurementKey& other) const {
+            return value == other.value && format == other.format && relativeScale == other.relativeScale;
+        }
+    };
+
+    inline uint qHash(const MeasurementKey& key, uint seed = 0) {
+        return ::qHash(key.value, seed) ^ ::qHash(key.format, seed) ^ ::qHash(key.relativeScale, seed);
+    }
+
+    /**
+     * A cached measurement.
+     */
+    struct Measurement {
+        float height;
+        float ascent;
+    };
+
+    /**
+     * The keys recorded under each active measurement scope on this thread, innermost scope last.
+     */
+    thread_local QVector<QVector<MeasurementKey>> scopeKeys;
+
+    /**
+     * The measurements cached on this thread.
+     */
+    thread_local QHash<MeasurementKey, Measurement> measurements;
+}
+
+DataTypePresentationGenerator::MeasurementScope::MeasurementScope() {
+    scopeKeys.append(QVector<MeasurementKey>());
+}
+
+
+DataTypePresentationGenerator::MeasurementScope::~MeasurementScope() {
+    // Values measured under this scope may not outlive it so we discard their measurements.
+
+    const QVector<MeasurementKey>& keys = scopeKeys.last();
+    for (  QVector<MeasurementKey>::const_iterator it = keys.constBegin(), end = keys.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        measurements.remove(*it);
+    }
+
+    scopeKeys.removeLast();
+}
+
+/***********************************************************************************************************************
+ * DataTypePresentationGenerator
+ */
+
 DataTypePresentationGenerator::DataTypePresentationGenerator() {}
 
 
@@ -156,7 +223,7 @@ void DataTypePresentationGenerator::addText(
         const QColor&                         fontBackgroundColor,
         float                                 lineSpacing
     ) {
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float baseFontHeight    = fontMetrics.height();
     float baseFontAscent    = fontMetrics.ascent();
     float width             = fontMetrics.horizontalAdvance(text);
@@ -193,9 +260,9 @@ void DataTypePresentationGenerator::addLeftParenthesis(
         const QColor&                            fontColor,
         const QColor&                            fontBackgroundColor
     ) {
-    QFontMetricsF fontMetrics(font);
-    float         fontHeight = fontMetrics.height();
-    float         fontAscent = fontMetrics.ascent();
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+    float                fontHeight = fontMetrics.height();
+    float                fontAscent = fontMetrics.ascent();
 
     QSizeF leftParenthesisSize;
     if (contentsHeight <= fontHeight * (1.0F + Presentation::parenthesisHeightMargin)) {
@@ -240,7 +307,7 @@ void DataTypePresentationGenerator::addLeftParenthesis(
         leftParenthesisItem->setRightParenthesisStyle(EQt::GraphicsMathGroup::ParenthesisStyle::NONE);
 
         float descent        = fontMetrics.descent();
-        float fontBasedWidth = fontMetrics.horizontalAdvance(QString("M")) / 2.0F;
+        float fontBasedWidth = FontMetricsCache::entry(font).mWidth() / 2.0F;
 
         float leftParenthesisTop = fontMetrics.ascent() - fontMetrics.capHeight();
         float leftInternalHeight = contentsHeight - leftParenthesisTop - descent / 2.0F;
@@ -283,9 +350,9 @@ void DataTypePresentationGenerator::addRightParenthesis(
         const QColor&                            fontColor,
         const QColor&                            fontBackgroundColor
     ) {
-    QFontMetricsF fontMetrics(font);
-    float         fontHeight = fontMetrics.height();
-    float         fontAscent = fontMetrics.ascent();
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+    float                fontHeight = fontMetrics.height();
+    float                fontAscent = fontMetrics.ascent();
 
     QSizeF rightParenthesisSize;
     if (contentsHeight <= fontHeight * (1.0F + Presentation::parenthesisHeightMargin)) {
@@ -330,7 +397,7 @@ void DataTypePresentationGenerator::addRightParenthesis(
         rightParenthesisItem->setLeftParenthesisStyle(EQt::GraphicsMathGroup::ParenthesisStyle::NONE);
 
         float descent        = fontMetrics.descent();
-        float fontBasedWidth = fontMetrics.horizontalAdvance(QString("M")) / 2.0F;
+        float fontBasedWidth = FontMetricsCache::entry(font).mWidth() / 2.0F;
 
         float rightParenthesisTop = fontMetrics.ascent() - fontMetrics.capHeight();
         float rightInternalHeight = contentsHeight - rightParenthesisTop - descent / 2.0F;
@@ -382,3 +449,46 @@ void DataTypePresentationGenerator::addText(
 
     ++index;
 }
+
+
+bool DataTypePresentationGenerator::cachedHeight(
+        const Model::Variant& value,
+        Ld::FormatPointer     format,
+        float                 relativeScale,
+        float&                height,
+        float&                ascent
+    ) {
+    bool success = false;
+
+    if (!scopeKeys.isEmpty()) {
+        QHash<MeasurementKey, Measurement>::const_iterator it = measurements.constFind(
+            MeasurementKey { &value, format.data(), relativeScale }
+        );
+
+        if (it != measurements.constEnd()) {
+            height  = it.value().height;
+            ascent  = it.value().ascent;
+            success = true;
+        }
+    }
+
+    return success;
+}
+
+
+void DataTypePresentationGenerator::cacheHeight(
+        const Model::Variant& value,
+        Ld::FormatPointer     format,
+        float                 relativeScale,
+        float                 height,
+        float                 ascent
+    ) {
+    if (!scopeKeys.isEmpty()) {
+        MeasurementKey key = { &value, format.data(), relativeScale };
+        if (!measurements.contains(key)) {
+            scopeKeys.last().append(key);
+        }
+
+        measurements.insert(key, Measurement { height, ascent });
+    }
+}
@@ -26,6 +26,7 @@
 #include <ld_division_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "binary_operator_presentation_base.h"
 #include "division_operator_presentation_base.h"
 
@@ -261,7 +262,7 @@ EQt::GraphicsMathGroupWithLine* DivisionOperatorPresentationBase::updateFraction
         float&                                             requiredAscent
     ) {
     QFont font  = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     // TODO: Rendering might be improved by setting this value to a small value with some elements for child 1.
     float child1AscentAdjust   = 0; // fontMetrics.ascent() - fontMetrics.capHeight() - fontMetrics.descent();
@@ -40,6 +40,8 @@
 #include "command_queue.h"
 #include "editor.h"
 #include "scene_units.h"
+#include "import_loader.h"
+#include "autosave_journal.h"
 #include "document.h"
 
 Document::Document(QObject* parent):RootPresentation(parent) {
@@ -57,6 +59,27 @@ Document::Document(QObject* parent):RootPresentation(parent) {
     connect(currentCommandQueue, &CommandQueue::undoHasFailed, this, &Document::undoFailed);
     connect(currentCommandQueue, &CommandQueue::redoHasFailed, this, &Document::redoFailed);
 
+    currentAutosaveJournal = new AutosaveJournal(this);
+
+    connect(
+        currentCommandQueue,
+        &CommandQueue::commandHasExecuted,
+        currentAutosaveJournal,
+        &AutosaveJournal::commandExecuted
+    );
+    connect(
+        currentCommandQueue,
+        &CommandQueue::undoHasCompleted,
+        currentAutosaveJournal,
+        &AutosaveJournal::snapshotRequired
+    );
+    connect(
+        currentCommandQueue,
+        &CommandQueue::redoHasCompleted,
+        currentAutosaveJournal,
+        &AutosaveJournal::snapshotRequired
+    );
+
     currentMaximumHorizontalExtentPoints = 0;
     modified                             = false;
 
@@ -221,8 +244,20 @@ bool Document::loadDocument(const QString& filename) {
     }
 
     if (success) {
+        // Open any imports we already know about up front, leaves first, so that reusable imports come from the
+        // cache and Ld finds every known import registered.
+
+        ImportLoader::preloadImports(filename);
+
         Ld::PlugInsByName plugInsByName = Application::plugInManager()->plugInsByName();
         success = rootElement->openExisting(filename, false, plugInsByName);
+
+        if (success) {
+            currentRecoveredFilename.clear();
+
+            ImportLoader::updateCache(rootElement);
+            currentAutosaveJournal->start(rootElement->filename());
+        }
     }
 
     fillEmptyDocument(); // This exists here in case the load fails.
@@ -231,9 +266,53 @@ bool Document::loadDocument(const QString& filename) {
 }
 
 
-bool Document::saveDocument() {
+bool Document::recoverDocument(const QString& filename) {
+    bool                            success     = true;
     QSharedPointer<Ld::RootElement> rootElement = element();
-    return rootElement->save();
+
+    if (rootElement->openMode() != Ld::RootElement::OpenMode::CLOSED) {
+        success = rootElement->close();
+    }
+
+    if (success) {
+        ImportLoader::preloadImports(filename);
+
+        success = currentAutosaveJournal->recover(filename);
+        if (success) {
+            if (currentAutosaveJournal->lastRecoveryFromSnapshot()) {
+                currentRecoveredFilename = filename;
+            } else {
+                currentRecoveredFilename.clear();
+            }
+
+            ImportLoader::updateCache(rootElement);
+            setModified(true);
+        }
+    }
+
+    fillEmptyDocument(); // This exists here in case the recovery fails.
+
+    return success;
+}
+
+
+bool Document::saveDocument() {
+    bool success;
+
+    if (!currentRecoveredFilename.isEmpty()) {
+        // The element tree refers to the recovered copy of a snapshot.  Save over the file the user opened instead.
+        success = saveDocument(currentRecoveredFilename);
+    } else {
+        QSharedPointer<Ld::RootElement> rootElement = element();
+        success = rootElement->save();
+
+        if (success) {
+            ImportLoader::updateCache(rootElement);
+            currentAutosaveJournal->start(rootElement->filename());
+        }
+    }
+
+    return success;
 }
 
 
@@ -241,17 +320,37 @@ bool Document::saveDocument(const QString& newFilename) {
     QSharedPointer<Ld::RootElement> rootElement = element();
     bool success = rootElement->saveAs(newFilename);
 
+    if (success) {
+        currentRecoveredFilename.clear();
+
+        ImportLoader::updateCache(rootElement);
+        currentAutosaveJournal->start(rootElement->filename());
+    }
+
     return success;
 }
 
 
+AutosaveJournal* Document::autosaveJournal() const {
+    return currentAutosaveJournal;
+}
+
+
 QString Document::filename() const {
-    return element()->filename();
+    return currentRecoveredFilename.isEmpty() ? element()->filename() : currentRecoveredFilename;
 }
 
 
 QString Document::shortformName() const {
-    return element()->shortformName();
+    QString result;
+
+    if (currentRecoveredFilename.isEmpty()) {
+        result = element()->shortformName();
+    } else {
+        result = QFileInfo(currentRecoveredFilename).fileName();
+    }
+
+    return result;
 }
 
 
@@ -386,6 +485,13 @@ void Document::purgeUnreferenced(const QList<Document*>& referencedDocuments) {
         QString                         identifier  = rootElement->identifier();
 
         if (!allRequiredDependencies.contains(identifier)) {
+            // Unsaved edits are discarded when a document is released so a modified root element must not be reused
+            // the next time the file is opened.
+
+            if (rootElement->isModified()) {
+                ImportLoader::invalidate(rootElement->filename());
+            }
+
             Ld::RootElement::unregisterRootElement(rootElement);
         }
     }
@@ -0,0 +1,462 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref DocumentTextIndex class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QRegularExpression>
+#include <QRegularExpressionMatch>
+#include <QRegularExpressionMatchIterator>
+
+#include <algorithm>
+
+#include <ld_element_structures.h>
+#include <ld_element.h>
+#include <ld_element_cursor.h>
+
+#include "document_text_index.h"
+
+/***********************************************************************************************************************
+ * DocumentTextIndex::Match
+ */
+
+DocumentTextIndex::Match::Match() {}
+
+
+DocumentTextIndex::Match::Match(
+        const Ld::ElementCursor& startCursor,
+        const Ld::ElementCursor& endCursor,
+        const QString&           text,
+        const QStringList&       capturedTexts
+    ) {
+    currentStartCursor   = startCursor;
+    currentEndCursor     = endCursor;
+    currentText          = text;
+    currentCapturedTexts = capturedTexts;
+}
+
+
+DocumentTextIndex::Match::Match(const DocumentTextIndex::Match& other) {
+    currentStartCursor   = other.currentStartCursor;
+    currentEndCursor     = other.currentEndCursor;
+    currentText          = other.currentText;
+    currentCapturedTexts = other.currentCapturedTexts;
+}
+
+
+DocumentTextIndex::Match::~Match() {}
+
+
+const Ld::ElementCursor& DocumentTextIndex::Match::startCursor() const {
+    return currentStartCursor;
+}
+
+
+const Ld::ElementCursor& DocumentTextIndex::Match::endCursor() const {
+    return currentEndCursor;
+}
+
+
+const QString& DocumentTextIndex::Match::text() const {
+    return currentText;
+}
+
+
+const QStringList& DocumentTextIndex::Match::capturedTexts() const {
+    return currentCapturedTexts;
+}
+
+
+QString DocumentTextIndex::Match::expandReplacement(const QString& replacementText) const {
+    QString result;
+    int     numberCaptures = currentCapturedTexts.size();
+    int     length         = replacementText.size();
+    int     index          = 0;
+
+    result.reserve(length);
+
+    while (index < length) {
+        QChar c = replacementText.at(index);
+        if (c == QChar('\\') && index + 1 < length && replacementText.at(index + 1).isDigit()) {
+            // Prefer a two digit reference when that capture exists, matching QString::replace.
+
+            int captureIndex    = replacementText.at(index + 1).digitValue();
+            int referenceLength = 2;
+
+            if (index + 2 < length && replacementText.at(index + 2).isDigit()) {
+                int twoDigitIndex = 10 * captureIndex + replacementText.at(index + 2).digitValue();
+                if (twoDigitIndex < numberCaptures) {
+                    captureIndex    = twoDigitIndex;
+                    referenceLength = 3;
+                }
+            }
+
+            if (captureIndex < numberCaptures) {
+                result += currentCapturedTexts.at(captureIndex);
+                index  += referenceLength;
+            } else {
+                result += c;
+                ++index;
+            }
+        } else {
+            result += c;
+            ++index;
+        }
+    }
+
+    return result;
+}
+
+
+bool DocumentTextIndex::Match::isWithinRegion() const {
+    return (
+           currentStartCursor.element() == currentEndCursor.element()
+        && currentStartCursor.regionIndex() == currentEndCursor.regionIndex()
+    );
+}
+
+
+DocumentTextIndex::Match& DocumentTextIndex::Match::operator=(const DocumentTextIndex::Match& other) {
+    currentStartCursor   = other.currentStartCursor;
+    currentEndCursor     = other.currentEndCursor;
+    currentText          = other.currentText;
+    currentCapturedTexts = other.currentCapturedTexts;
+
+    return *this;
+}
+
+/***********************************************************************************************************************
+ * DocumentTextIndex
+ */
+
+DocumentTextIndex::DocumentTextIndex() {
+    structureChanged   = true;
+    verificationNeeded = false;
+}
+
+
+DocumentTextIndex::~DocumentTextIndex() {}
+
+
+void DocumentTextIndex::setRootElement(Ld::ElementPointer rootElement) {
+    if (currentRootElement.toStrongRef() != rootElement) {
+        currentRootElement = rootElement.toWeakRef();
+        clear();
+    }
+}
+
+
+void DocumentTextIndex::elementChanged(Ld::ElementPointer element) {
+    const Ld::Element* blockElement = topLevelElement(element);
+    if (blockElement != Q_NULLPTR) {
+        staleBlocks.insert(blockElement);
+    } else {
+        structureChanged = true;
+    }
+}
+
+
+void DocumentTextIndex::elementAdded(Ld::ElementPointer element) {
+    const Ld::Element* blockElement = topLevelElement(element);
+    if (blockElement != Q_NULLPTR) {
+        staleBlocks.insert(blockElement);
+
+        if (blockElement == element.data()) {
+            structureChanged = true;
+        }
+    } else {
+        structureChanged = true;
+    }
+}
+
+
+void DocumentTextIndex::elementRemoved(Ld::ElementPointer element) {
+    const Ld::Element* blockElement = topLevelElement(element);
+    if (blockElement == element.data()) {
+        structureChanged = true;
+    } else if (blockElement != Q_NULLPTR) {
+        staleBlocks.insert(blockElement);
+    } else {
+        structureChanged   = true;
+        verificationNeeded = true;
+    }
+}
+
+
+void DocumentTextIndex::clear() {
+    currentBlocks.clear();
+    blockIndexByElement.clear();
+    staleBlocks.clear();
+
+    structureChanged   = true;
+    verificationNeeded = false;
+}
+
+
+QList<DocumentTextIndex::Match> DocumentTextIndex::findAll(
+        const QString& searchText,
+        bool           caseSensitive,
+        bool           wholeWordsOnly,
+        bool           regularExpression
+    ) {
+    QList<Match>       result;
+    QRegularExpression expression = searchExpression(searchText, caseSensitive, wholeWordsOnly, regularExpression);
+
+    if (!searchText.isEmpty() && expression.isValid()) {
+        update();
+
+        for (  QList<Block>::const_iterator blockIterator    = currentBlocks.constBegin(),
+                                            blockEndIterator = currentBlocks.constEnd()
+             ; blockIterator != blockEndIterator
+             ; ++blockIterator
+            ) {
+            for (  QList<Run>::const_iterator runIterator    = blockIterator->runs.constBegin(),
+                                              runEndIterator = blockIterator->runs.constEnd()
+                 ; runIterator != runEndIterator
+                 ; ++runIterator
+                ) {
+                const Run& run = *runIterator;
+
+                QRegularExpressionMatchIterator matchIterator = expression.globalMatch(run.text);
+                while (matchIterator.hasNext()) {
+                    QRegularExpressionMatch match  = matchIterator.next();
+                    unsigned long           start  = static_cast<unsigned long>(match.capturedStart());
+                    unsigned long           length = static_cast<unsigned long>(match.capturedLength());
+
+                    if (length > 0) {
+                        unsigned long end = start + length;
+
+                        // The last region starting at or before the first character, and at or before the last
+                        // character, of the match.
+
+                        unsigned startRegion = static_cast<unsigned>(
+                            std::upper_bound(run.offsets.constBegin(), run.offsets.constEnd(), start)
+                            - run.offsets.constBegin() - 1
+                        );
+
+                        unsigned endRegion = static_cast<unsigned>(
+                            std::upper_bound(run.offsets.constBegin(), run.offsets.constEnd(), end - 1)
+                            - run.offsets.constBegin() - 1
+                        );
+
+                        const Region&      startRegionData = run.regions.at(startRegion);
+                        const Region&      endRegionData   = run.regions.at(endRegion);
+                        Ld::ElementPointer startElement    = startRegionData.element.toStrongRef();
+                        Ld::ElementPointer endElement      = endRegionData.element.toStrongRef();
+
+                        if (!startElement.isNull() && !endElement.isNull()) {
+                            result.append(
+                                Match(
+                                    Ld::ElementCursor(
+                                        start - run.offsets.at(startRegion),
+                                        startRegionData.regionIndex,
+                                        startElement
+                                    ),
+                                    Ld::ElementCursor(
+                                        end - run.offsets.at(endRegion),
+                                        endRegionData.regionIndex,
+                                        endElement
+                                    ),
+                                    match.captured(),
+                                    regularExpression ? match.capturedTexts() : QStringList()
+                                )
+                            );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+
+QRegularExpression DocumentTextIndex::searchExpression(
+        const QString& searchText,
+        bool           caseSensitive,
+        bool           wholeWordsOnly,
+        bool           regularExpression
+    ) {
+    QString                            pattern;
+    QRegularExpression::PatternOptions options = QRegularExpression::UseUnicodePropertiesOption;
+
+    if (regularExpression) {
+        pattern = searchText;
+    } else {
+        pattern = QRegularExpression::escape(searchText);
+
+        if (wholeWordsOnly) {
+            pattern = QString("\\b%1\\b").arg(pattern);
+        }
+
+        if (!caseSensitive) {
+            options |= QRegularExpression::CaseInsensitiveOption;
+        }
+    }
+
+    return QRegularExpression(pattern, options);
+}
+
+
+void DocumentTextIndex::update() {
+    Ld::ElementPointer rootElement = currentRootElement.toStrongRef();
+
+    if (rootElement.isNull()) {
+        currentBlocks.clear();
+        blockIndexByElement.clear();
+        staleBlocks.clear();
+    } else if (structureChanged) {
+        // Rebuild the block list, reusing every block whose top level element is unchanged.
+
+        QList<Block>                   newBlocks;
+        QHash<const Ld::Element*, int> newBlockIndexByElement;
+
+        unsigned long numberChildren = rootElement->numberChildren();
+        for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+            Ld::ElementPointer child = rootElement->child(childIndex);
+            if (!child.isNull()) {
+                const Ld::Element*                             key           = child.data();
+                QHash<const Ld::Element*, int>::const_iterator indexIterator = blockIndexByElement.constFind(key);
+
+                if (indexIterator != blockIndexByElement.constEnd()                                     &&
+                    !staleBlocks.contains(key)                                                          &&
+                    (!verificationNeeded || blockIsCurrent(currentBlocks.at(indexIterator.value())))    ) {
+                    newBlocks.append(currentBlocks.at(indexIterator.value()));
+                } else {
+                    newBlocks.append(buildBlock(child));
+                }
+
+                newBlockIndexByElement.insert(key, newBlocks.size() - 1);
+            }
+        }
+
+        currentBlocks       = newBlocks;
+        blockIndexByElement = newBlockIndexByElement;
+    } else {
+        for (  QSet<const Ld::Element*>::const_iterator it  = staleBlocks.constBegin(),
+                                                        end = staleBlocks.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            QHash<const Ld::Element*, int>::const_iterator indexIterator = blockIndexByElement.constFind(*it);
+            if (indexIterator != blockIndexByElement.constEnd()) {
+                Block&             block   = currentBlocks[indexIterator.value()];
+                Ld::ElementPointer element = block.element.toStrongRef();
+
+                if (!element.isNull()) {
+                    block = buildBlock(element);
+                } else {
+                    block.runs.clear();
+                }
+            }
+        }
+    }
+
+    staleBlocks.clear();
+    structureChanged   = false;
+    verificationNeeded = false;
+}
+
+
+DocumentTextIndex::Block DocumentTextIndex::buildBlock(Ld::ElementPointer element) {
+    Block block;
+    block.element = element.toWeakRef();
+
+    Ld::ElementPointer previousElement;
+    unsigned           previousRegionIndex = 0;
+    appendRegions(element, block, previousElement, previousRegionIndex);
+
+    return block;
+}
+
+
+void DocumentTextIndex::appendRegions(
+        Ld::ElementPointer  element,
+        Block&              block,
+        Ld::ElementPointer& previousElement,
+        unsigned&           previousRegionIndex
+    ) {
+    unsigned numberRegions = element->numberTextRegions();
+    for (unsigned regionIndex=0 ; regionIndex<numberRegions ; ++regionIndex) {
+        if (previousElement.isNull()                                                                      ||
+            !previousElement->aggregateTextDuringSearchAllowed(element, regionIndex, previousRegionIndex)    ) {
+            block.runs.append(Run());
+        }
+
+        Run&   run = block.runs.last();
+        Region region;
+        region.element     = element.toWeakRef();
+        region.regionIndex = regionIndex;
+
+        run.offsets.append(static_cast<unsigned long>(run.text.size()));
+        run.regions.append(region);
+        run.text += element->text(regionIndex);
+
+        previousElement     = element;
+        previousRegionIndex = regionIndex;
+    }
+
+    unsigned long numberChildren = element->numberChildren();
+    for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+        Ld::ElementPointer child = element->child(childIndex);
+        if (!child.isNull()) {
+            appendRegions(child, block, previousElement, previousRegionIndex);
+        }
+    }
+}
+
+
+bool DocumentTextIndex::blockIsCurrent(const DocumentTextIndex::Block& block) {
+    bool               isCurrent    = true;
+    Ld::ElementPointer blockElement = block.element.toStrongRef();
+
+    QList<Run>::const_iterator runIterator    = block.runs.constBegin();
+    QList<Run>::const_iterator runEndIterator = block.runs.constEnd();
+    while (isCurrent && runIterator != runEndIterator) {
+        QVector<Region>::const_iterator regionIterator    = runIterator->regions.constBegin();
+        QVector<Region>::const_iterator regionEndIterator = runIterator->regions.constEnd();
+        while (isCurrent && regionIterator != regionEndIterator) {
+            Ld::ElementPointer element = regionIterator->element.toStrongRef();
+            while (!element.isNull() && element != blockElement) {
+                element = element->parent();
+            }
+
+            isCurrent = !element.isNull();
+            ++regionIterator;
+        }
+
+        ++runIterator;
+    }
+
+    return isCurrent;
+}
+
+
+const Ld::Element* DocumentTextIndex::topLevelElement(Ld::ElementPointer element) const {
+    const Ld::Element* result      = Q_NULLPTR;
+    Ld::ElementPointer rootElement = currentRootElement.toStrongRef();
+
+    if (!rootElement.isNull() && !element.isNull() && element != rootElement) {
+        Ld::ElementPointer parent = element->parent();
+        while (!parent.isNull() && parent != rootElement) {
+            element = parent;
+            parent  = element->parent();
+        }
+
+        if (!parent.isNull()) {
+            result = element.data();
+        }
+    }
+
+    return result;
+}
@@ -11,12 +11,20 @@
 #include <QWidget>
 #include <QOpenGLWidget>
 #include <QResizeEvent>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QPaintEvent>
 #include <QList>
 #include <QColor>
 #include <QPen>
 #include <QBrush>
 #include <QPainter>
 #include <QRectF>
+#include <QRect>
+#include <QRegion>
+#include <QTransform>
+#include <QPixmap>
+#include <QElapsedTimer>
 #include <QScrollBar>
 #include <QDragEnterEvent>
 #include <QDragLeaveEvent>
@@ -29,8 +37,10 @@
 #include <QGraphicsView>
 #include <QPointF>
 #include <QPoint>
+#include <QString>
 
 #include <limits>
+#include <cmath>
 
 #include <eqt_signal_aggregator.h>
 
@@ -53,6 +63,8 @@
 #include "insert_string_command.h"
 #include "insert_element_command.h"
 #include "delete_command.h"
+#include "replace_all_command.h"
+#include "document_text_index.h"
 #include "command_popup_dialog.h"
 #include "view_widget.h"
 #include "page_list.h"
@@ -60,6 +72,10 @@
 #include "document.h"
 #include "cursor.h"
 #include "page_list.h"
+#include "viewport_layer.h"
+#include "scene_tile_cache.h"
+#include "latency_tracer.h"
+#include "memory_governor.h"
 #include "editor.h"
 
 Editor::Editor(ViewWidget* parent):QGraphicsView(parent) {
@@ -98,6 +114,12 @@ Editor::~Editor() {
 void Editor::setDocument(Document* newDocument) {
     Document* oldDocument = document();
 
+    sceneTileCache.clear();
+
+    dragTimer->stop();
+    dragUpdatePending = false;
+    previousSelectionRectangles.clear();
+
     newDocument->registerEditor(this);
     newDocument->addCursor(currentCursor);
 
@@ -336,6 +358,22 @@ bool Editor::guidesEnabled() const {
 }
 
 
+bool Editor::overlayLayerEnabled() const {
+    return currentOverlayLayerEnabled;
+}
+
+
+unsigned long long Editor::numberPaintEvents() const {
+    return currentNumberPaintEvents;
+}
+
+
+double Editor::paintLoad() const {
+    qint64 elapsedNanoseconds = paintStatisticsTimer.nsecsElapsed();
+    return elapsedNanoseconds > 0 ? static_cast<double>(currentPaintNanoseconds) / elapsedNanoseconds : 0.0;
+}
+
+
 const Cursor& Editor::cursor() const {
     return *currentCursor;
 }
@@ -510,22 +548,50 @@ bool Editor::isDisplayCoherent() const {
 
 void Editor::setMarginsEnabled(bool nowEnabled) {
     marginsAreEnabled = nowEnabled;
+    decorationLayer.invalidate();
     viewport()->update();
 }
 
 
 void Editor::setGuidesEnabled(bool nowEnabled) {
     guidesAreEnabled = nowEnabled;
+    decorationLayer.invalidate();
     viewport()->update();
 }
 
 
+void Editor::setOverlayLayerEnabled(bool nowEnabled) {
+    if (nowEnabled != currentOverlayLayerEnabled) {
+        currentOverlayLayerEnabled = nowEnabled;
+
+        if (!nowEnabled) {
+            // Release the cached layers.  They are reallocated, and fully rendered, if the overlay is enabled again.
+            sceneLayer      = ViewportLayer(false);
+            decorationLayer = ViewportLayer(true);
+
+            tileRefinementTimer->stop();
+            sceneTileCache.clear();
+        }
+
+        viewport()->update();
+    }
+}
+
+
+void Editor::resetPaintStatistics() {
+    currentNumberPaintEvents = 0;
+    currentPaintNanoseconds  = 0;
+    paintStatisticsTimer.start();
+}
+
+
 void Editor::insertCommand(Command* newCommand) {
     currentNextTextInsertionFormat.clear();
     currentNextTextInsertionElementCursor.setInvalid();
 
     newCommand->setCursor(currentCursor);
     document()->insertCommand(newCommand);
+    LatencyTracer::commandExecuted(document());
 }
 
 
@@ -535,6 +601,7 @@ void Editor::insertCommand(QSharedPointer<Command> newCommand) {
 
     newCommand->setCursor(currentCursor);
     document()->insertCommand(newCommand);
+    LatencyTracer::commandExecuted(document());
 }
 
 
@@ -546,6 +613,7 @@ void Editor::insertCommand(const CommandContainer& newCommand) {
     container->setCursor(currentCursor);
 
     document()->insertCommand(newCommand);
+    LatencyTracer::commandExecuted(document());
 }
 
 
@@ -601,6 +669,47 @@ Editor::SearchResult Editor::searchBackward(
 }
 
 
+QList<DocumentTextIndex::Match> Editor::findAll(
+        const QString& searchText,
+        bool           caseSensitive,
+        bool           wholeWordsOnly,
+        bool           regularExpression
+    ) {
+    return document()->textIndex().findAll(searchText, caseSensitive, wholeWordsOnly, regularExpression);
+}
+
+
+unsigned long Editor::replaceAll(
+        const QString& searchText,
+        const QString& replacementText,
+        bool           caseSensitive,
+        bool           wholeWordsOnly,
+        bool           regularExpression
+    ) {
+    QList<DocumentTextIndex::Match> matches = findAll(searchText, caseSensitive, wholeWordsOnly, regularExpression);
+
+    QList<ReplaceAllCommand::Replacement> replacements;
+    for (  QList<DocumentTextIndex::Match>::const_iterator it  = matches.constBegin(),
+                                                           end = matches.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        const DocumentTextIndex::Match& match = *it;
+        if (match.isWithinRegion()) {
+            QString newText = regularExpression ? match.expandReplacement(replacementText) : replacementText;
+
+            replacements.append(ReplaceAllCommand::Replacement(match.startCursor(), match.text(), newText));
+        }
+    }
+
+    if (!replacements.isEmpty()) {
+        insertCommand(new ReplaceAllCommand(replacements));
+    }
+
+    return static_cast<unsigned long>(replacements.size());
+}
+
+
 void Editor::setZoom(float newZoomFactor) {
     setTransform(QTransform(newZoomFactor, 0, 0, newZoomFactor, 0, 0));
 
@@ -624,6 +733,10 @@ void Editor::abortRepositioning() {
 
 
 void Editor::drawForeground(QPainter *painter, const QRectF& rect) {
+    if (renderingSceneLayer) {
+        return; // Decorations and the cursor are drawn on the overlay.
+    }
+
     Document* document = Editor::document();
     painter->save();
     if (marginsAreEnabled || guidesAreEnabled) {
@@ -638,6 +751,42 @@ void Editor::drawForeground(QPainter *painter, const QRectF& rect) {
 }
 
 
+void Editor::paintEvent(QPaintEvent* event) {
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+
+    if (currentOverlayLayerEnabled) {
+        updateLayers();
+
+        QPainter painter(viewport());
+        painter.setClipRegion(event->region());
+        painter.drawPixmap(0, 0, sceneLayer.pixmap());
+
+        if (marginsAreEnabled || guidesAreEnabled) {
+            painter.drawPixmap(0, 0, decorationLayer.pixmap());
+        }
+
+        Document* document = Editor::document();
+        if (document->isDisplayCoherent()) {
+            painter.setRenderHints(renderHints());
+            painter.setWorldTransform(viewportTransform());
+
+            QRectF sceneRectangle = mapToScene(event->rect()).boundingRect();
+            currentCursor->drawCursor(&painter, sceneRectangle, currentShowCursor);
+        }
+    } else {
+        QGraphicsView::paintEvent(event);
+    }
+
+    ++currentNumberPaintEvents;
+    currentPaintNanoseconds += paintTimer.nsecsElapsed();
+
+    if (LatencyTracer::isEnabled()) {
+        LatencyTracer::paintCompleted(document(), this, event->rect(), currentCursor->boundingRectangle());
+    }
+}
+
+
 void Editor::dragEnterEvent(QDragEnterEvent* event) {
     QGraphicsView::dragEnterEvent(event);
 }
@@ -672,7 +821,7 @@ bool Editor::focusNextPrevChild(bool next) {
 void Editor::focusOutEvent(QFocusEvent* event) {
     cursorTimer->stop();
     currentShowCursor = true;
-    updateScene(QList<QRectF>() << previousCursorBoundingRectangle);
+    updateCursorArea(previousCursorBoundingRectangle);
 
     QGraphicsView::focusOutEvent(event);
 }
@@ -682,6 +831,8 @@ void Editor::focusOutEvent(QFocusEvent* event) {
 
 
 void Editor::keyPressEvent(QKeyEvent* event) {
+    LatencyTracer::inputReceived(document());
+
     if        (event->matches(QKeySequence::AddTab)) {
         emit addTabKeyPressed();
     } else if (event->matches(QKeySequence::Back)) {
@@ -997,10 +1148,15 @@ void Editor::mouseDoubleClickEvent(QMouseEvent* event) {
 
 void Editor::mouseMoveEvent(QMouseEvent* event) {
     if (event->buttons() == Qt::LeftButton) {
-        QPoint  viewportPosition = event->pos();
-        QPointF scenePosition    = mapToScene(viewportPosition);
+        QPoint viewportPosition = event->pos();
+
+        // Moves received while the drag timer is running are coalesced into a single update when the timer expires.
+        pendingDragPosition = mapToScene(viewportPosition);
+        dragUpdatePending   = true;
 
-        currentCursor->moveToPosition(scenePosition, true);
+        if (!dragTimer->isActive()) {
+            applyPendingDrag();
+        }
     }
 
     QGraphicsView::mouseMoveEvent(event);
@@ -1008,6 +1164,9 @@ void Editor::mouseMoveEvent(QMouseEvent* event) {
 
 
 void Editor::mousePressEvent(QMouseEvent* event) {
+    dragTimer->stop();
+    dragUpdatePending = false;
+
     if (event->button() == Qt::LeftButton) {
         Qt::KeyboardModifiers modifiers = Application::keyboardModifiers();
         bool                  shiftDown = ((modifiers & Qt::ShiftModifier) != 0);
@@ -1039,6 +1198,9 @@ void Editor::mousePressEvent(QMouseEvent* event) {
 
 void Editor::mouseReleaseEvent(QMouseEvent* event) {
     if (event->button() == Qt::LeftButton) {
+        applyPendingDrag();
+        dragTimer->stop();
+
         const Ld::ElementCursor& elementCursor   = currentCursor->elementCursor();
         const Ld::ElementCursor& selectionCursor = currentCursor->selectionCursor();
 
@@ -1059,6 +1221,18 @@ void Editor::resizeEvent(QResizeEvent* event) {
 }
 
 
+void Editor::showEvent(QShowEvent* event) {
+    QGraphicsView::showEvent(event);
+    MemoryGovernor::editorShown(document());
+}
+
+
+void Editor::hideEvent(QHideEvent* event) {
+    QGraphicsView::hideEvent(event);
+    MemoryGovernor::editorHidden(document());
+}
+
+
 void Editor::presentationUpdatesCompleted() {
     if (cursorUpdatePending) {
         cursorUpdatePending = false;
@@ -1104,6 +1278,16 @@ void Editor::documentSceneRectangleChanged(const QRectF& rectangle) {
 
 
 void Editor::sceneAreasChanged(const QList<QRectF>& regionList) {
+    if (currentOverlayLayerEnabled) {
+        for (  QList<QRectF>::const_iterator it  = regionList.constBegin(), end = regionList.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            sceneTileCache.invalidate(*it);
+            invalidateLayers(*it);
+        }
+    }
+
     // TODO: With other stuff we're doing, do we really need this function now ?
 
     if (!cursorUpdatePending) {
@@ -1161,7 +1345,46 @@ void Editor::blinkCursor() {
         currentShowCursor = true;
     }
 
-    updateScene(QList<QRectF>() << previousCursorBoundingRectangle);
+    updateCursorArea(previousCursorBoundingRectangle);
+}
+
+
+void Editor::applyPendingDrag() {
+    if (dragUpdatePending) {
+        dragUpdatePending = false;
+        currentCursor->moveToPosition(pendingDragPosition, true);
+
+        dragTimer->start();
+    }
+}
+
+
+void Editor::refineTiles() {
+    if (currentOverlayLayerEnabled) {
+        QWidget* viewportWidget = viewport();
+        QRegion  refinedRegion  = sceneTileCache.refine(
+            this,
+            document(),
+            viewportWidget->palette().brush(viewportWidget->backgroundRole())
+        );
+
+        if (!refinedRegion.isEmpty()) {
+            synchronizeLayers();
+
+            for (  QRegion::const_iterator it  = refinedRegion.begin(), end = refinedRegion.end()
+                 ; it != end
+                 ; ++it
+                ) {
+                sceneLayer.invalidate(*it);
+            }
+
+            viewportWidget->update(refinedRegion);
+        }
+
+        if (sceneTileCache.refinementPending()) {
+            tileRefinementTimer->start();
+        }
+    }
 }
 
 
@@ -1204,6 +1427,25 @@ void Editor::configureWidget(Document* newDocument) {
 
     currentShowCursor = true;
 
+    currentOverlayLayerEnabled = true;
+    renderingSceneLayer        = false;
+    decorationLayer            = ViewportLayer(true);
+
+    tileRefinementTimer = new QTimer(this);
+    tileRefinementTimer->setSingleShot(true);
+    tileRefinementTimer->setInterval(0);
+
+    connect(tileRefinementTimer, &QTimer::timeout, this, &Editor::refineTiles);
+
+    dragTimer = new QTimer(this);
+    dragTimer->setSingleShot(true);
+    dragTimer->setInterval(dragUpdateIntervalMilliseconds);
+    dragUpdatePending = false;
+
+    connect(dragTimer, &QTimer::timeout, this, &Editor::applyPendingDrag);
+
+    resetPaintStatistics();
+
     currentCursor.reset(new Cursor(newDocument));
     connect(currentCursor.data(), &Cursor::cursorUpdated,       this, &Editor::processCursorUpdate);
     connect(currentCursor.data(), &Cursor::elementStackChanged, this, &Editor::elementStackChanged);
@@ -1261,17 +1503,31 @@ void Editor::updateCursorPosition() {
     QRectF cursorBoundingRectangle = currentCursor->boundingRectangle().marginsAdded(QMarginsF(1, 1, 1, 1));
     QRectF sceneBoundingRectangle;
 
+    const QList<QRectF>& selectionRectangles = currentCursor->selectionRectangles();
+
     ensureVisible(cursorBoundingRectangle, cursorMarginX, cursorMarginY);
 
     if (previousCursorBoundingRectangle.isNull()) {
         sceneBoundingRectangle = cursorBoundingRectangle;
     } else {
-        sceneBoundingRectangle = cursorBoundingRectangle.united(previousCursorBoundingRectangle);
+        // Only the lines whose selection changed are repainted.  The text cursor is always repainted so that it is
+        // shown immediately if it was hidden by the blink timer.
+        sceneBoundingRectangle = changedSelectionArea(previousSelectionRectangles, selectionRectangles);
+        if (!sceneBoundingRectangle.isNull()) {
+            sceneBoundingRectangle = sceneBoundingRectangle.marginsAdded(QMarginsF(1, 1, 1, 1));
+        }
+
+        if (!currentShowCursor) {
+            sceneBoundingRectangle = sceneBoundingRectangle.united(cursorBoundingRectangle);
+        }
     }
 
     previousCursorBoundingRectangle = cursorBoundingRectangle;
+    previousSelectionRectangles     = selectionRectangles;
 
-    updateScene(QList<QRectF>() << sceneBoundingRectangle);
+    if (!sceneBoundingRectangle.isNull()) {
+        updateCursorArea(sceneBoundingRectangle);
+    }
 
     currentShowCursor = true;
 
@@ -1283,3 +1539,153 @@ void Editor::updateCursorPosition() {
     emit cursorSceneCoordinatePositionChanged(cursorBoundingRectangle.left());
     emit cursorUpdated();
 }
+
+
+void Editor::updateCursorArea(const QRectF& sceneRectangle) {
+    if (currentOverlayLayerEnabled) {
+        // Only the overlay changes so the cached scene layer is simply recomposited under the cursor.
+        viewport()->update(mapFromScene(sceneRectangle).boundingRect().adjusted(-1, -1, 1, 1));
+    } else {
+        updateScene(QList<QRectF>() << sceneRectangle);
+    }
+}
+
+
+QRectF Editor::changedSelectionArea(const QList<QRectF>& oldRectangles, const QList<QRectF>& newRectangles) {
+    int numberOld = oldRectangles.size();
+    int numberNew = newRectangles.size();
+
+    int numberLeading = 0;
+    while (numberLeading < numberOld                                                &&
+           numberLeading < numberNew                                                &&
+           oldRectangles.at(numberLeading) == newRectangles.at(numberLeading)    ) {
+        ++numberLeading;
+    }
+
+    int numberTrailing = 0;
+    while (numberTrailing < numberOld - numberLeading                                                         &&
+           numberTrailing < numberNew - numberLeading                                                         &&
+           oldRectangles.at(numberOld - numberTrailing - 1) == newRectangles.at(numberNew - numberTrailing - 1)    ) {
+        ++numberTrailing;
+    }
+
+    QRectF result;
+
+    for (int index=numberLeading ; index<numberOld-numberTrailing ; ++index) {
+        result = result.united(oldRectangles.at(index));
+    }
+
+    for (int index=numberLeading ; index<numberNew-numberTrailing ; ++index) {
+        result = result.united(newRectangles.at(index));
+    }
+
+    return result;
+}
+
+
+void Editor::invalidateLayers(const QRectF& sceneRectangle, bool invalidateScene, bool invalidateDecorations) {
+    synchronizeLayers();
+
+    // Anti-aliased edges can extend just past the reported area so we grow the invalidated area slightly.
+    QRect viewportRectangle = mapFromScene(sceneRectangle).boundingRect().adjusted(-2, -2, 2, 2);
+
+    if (invalidateScene) {
+        sceneLayer.invalidate(viewportRectangle);
+    }
+
+    if (invalidateDecorations) {
+        decorationLayer.invalidate(viewportRectangle);
+    }
+}
+
+
+void Editor::synchronizeLayers() {
+    QWidget* viewportWidget   = viewport();
+    QSize    viewportSize     = viewportWidget->size();
+    qreal    devicePixelRatio = viewportWidget->devicePixelRatioF();
+
+    sceneLayer.resize(viewportSize, devicePixelRatio);
+    decorationLayer.resize(viewportSize, devicePixelRatio);
+
+    QTransform transform = viewportTransform();
+    if (transform != layerTransform) {
+        double dx = transform.dx() - layerTransform.dx();
+        double dy = transform.dy() - layerTransform.dy();
+
+        bool translationOnly = (
+               transform.type() <= QTransform::TxScale
+            && layerTransform.type() <= QTransform::TxScale
+            && transform.m11() == layerTransform.m11()
+            && transform.m22() == layerTransform.m22()
+            && dx == std::round(dx)
+            && dy == std::round(dy)
+        );
+
+        if (translationOnly) {
+            sceneLayer.scroll(static_cast<int>(dx), static_cast<int>(dy));
+            decorationLayer.scroll(static_cast<int>(dx), static_cast<int>(dy));
+        } else {
+            sceneLayer.invalidate();
+            decorationLayer.invalidate();
+        }
+
+        layerTransform = transform;
+    }
+}
+
+
+void Editor::updateLayers() {
+    synchronizeLayers();
+
+    if (sceneLayer.isDirty()) {
+        const QRegion& dirtyRegion    = sceneLayer.dirtyRegion();
+        QWidget*       viewportWidget = viewport();
+
+        const QBrush&  background     = viewportWidget->palette().brush(viewportWidget->backgroundRole());
+
+        QPainter painter(&sceneLayer.pixmap());
+        painter.setRenderHints(renderHints());
+        painter.setClipRegion(dirtyRegion);
+        painter.fillRect(dirtyRegion.boundingRect(), background);
+
+        // Pages are drawn from the tile cache.  Only the area around the pages is rendered directly.
+        QRegion untiledRegion = sceneTileCache.draw(&painter, dirtyRegion, this, document(), background);
+
+        renderingSceneLayer = true;
+
+        for (  QRegion::const_iterator it  = untiledRegion.begin(), end = untiledRegion.end()
+             ; it != end
+             ; ++it
+            ) {
+            render(&painter, QRectF(*it), *it, Qt::IgnoreAspectRatio);
+        }
+
+        renderingSceneLayer = false;
+
+        painter.end();
+        sceneLayer.markClean();
+
+        if (sceneTileCache.refinementPending() && !tileRefinementTimer->isActive()) {
+            tileRefinementTimer->start();
+        }
+    }
+
+    if (decorationLayer.isDirty() && (marginsAreEnabled || guidesAreEnabled)) {
+        const QRegion& dirtyRegion = decorationLayer.dirtyRegion();
+
+        QPainter painter(&decorationLayer.pixmap());
+        painter.setClipRegion(dirtyRegion);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(dirtyRegion.boundingRect(), Qt::transparent);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+        painter.setRenderHints(renderHints());
+        painter.setWorldTransform(viewportTransform());
+
+        QRectF sceneRectangle = mapToScene(dirtyRegion.boundingRect()).boundingRect();
+        document()->drawPageDecorations(sceneRectangle, &painter, marginsAreEnabled, guidesAreEnabled);
+
+        painter.end();
+        decorationLayer.markClean();
+    }
+}
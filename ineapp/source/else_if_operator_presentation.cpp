@@ -20,6 +20,7 @@
 #include <ld_else_if_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "operator_presentation_base.h"
 #include "else_if_operator_presentation.h"
 
@@ -64,7 +65,7 @@ EQt::GraphicsMathGroup* ElseIfOperatorPresentation::updateGraphicsItem(
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     QString s1 = tr("else if ");
     QString s2 = tr(" : ");
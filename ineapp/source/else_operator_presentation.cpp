@@ -20,6 +20,7 @@
 #include <ld_else_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "operator_presentation_base.h"
 #include "else_operator_presentation.h"
 
@@ -64,7 +65,7 @@ EQt::GraphicsMathGroup* ElseOperatorPresentation::updateGraphicsItem(
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     QString operatorString = tr("else: ");
 
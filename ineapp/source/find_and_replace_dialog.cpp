@@ -215,6 +215,7 @@ void FindAndReplaceDialog::bind() {
     QPushButton* replaceAndFindPreviousPushButton = widget<QPushButton>("replace_and_find_previous_push_button");
     QPushButton* replacePushButton                = widget<QPushButton>("replace_push_button");
     QPushButton* replaceAndFindNextPushButton     = widget<QPushButton>("replace_and_find_next_push_button");
+    QPushButton* replaceAllPushButton             = widget<QPushButton>("replace_all_push_button");
     QPushButton* closePushButton                  = widget<QPushButton>("close_push_button");
 
     connect(searchLineEdit, &QLineEdit::textChanged, this, &FindAndReplaceDialog::searchTextChanged);
@@ -260,6 +261,12 @@ void FindAndReplaceDialog::bind() {
         this,
         &FindAndReplaceDialog::replaceAndSearchForwardsButtonClicked
     );
+    connect(
+        replaceAllPushButton,
+        &QPushButton::clicked,
+        this,
+        &FindAndReplaceDialog::replaceAllButtonClicked
+    );
     connect(
         closePushButton,
         &QPushButton::clicked,
@@ -299,6 +306,7 @@ void FindAndReplaceDialog::searchTextChanged(const QString& newText) {
     QPushButton* replaceAndFindPreviousPushButton = widget<QPushButton>("replace_and_find_previous_push_button");
     QPushButton* replacePushButton                = widget<QPushButton>("replace_push_button");
     QPushButton* replaceAndFindNextPushButton     = widget<QPushButton>("replace_and_find_next_push_button");
+    QPushButton* replaceAllPushButton             = widget<QPushButton>("replace_all_push_button");
 
     if (newText.isEmpty()) {
         replaceLineEdit->setEnabled(false);
@@ -311,6 +319,7 @@ void FindAndReplaceDialog::searchTextChanged(const QString& newText) {
         replaceAndFindPreviousPushButton->setEnabled(false);
         replacePushButton->setEnabled(false);
         replaceAndFindNextPushButton->setEnabled(false);
+        replaceAllPushButton->setEnabled(false);
 
         QPalette palette;
         palette.setColor(QPalette::Text, Qt::black);
@@ -353,6 +362,7 @@ void FindAndReplaceDialog::searchTextChanged(const QString& newText) {
         replaceAndFindPreviousPushButton->setEnabled(controlsEnabled);
         replacePushButton->setEnabled(controlsEnabled);
         replaceAndFindNextPushButton->setEnabled(controlsEnabled);
+        replaceAllPushButton->setEnabled(controlsEnabled);
     }
 }
 
@@ -399,11 +409,13 @@ void FindAndReplaceDialog::advancedButtonClicked(bool nowChecked) {
     QPushButton* replaceAndFindPreviousPushButton = widget<QPushButton>("replace_and_find_previous_push_button");
     QPushButton* replacePushButton                = widget<QPushButton>("replace_push_button");
     QPushButton* replaceAndFindNextPushButton     = widget<QPushButton>("replace_and_find_next_push_button");
+    QPushButton* replaceAllPushButton             = widget<QPushButton>("replace_all_push_button");
 
     replaceGroupBox->setVisible(nowChecked);
     replaceAndFindPreviousPushButton->setVisible(nowChecked);
     replacePushButton->setVisible(nowChecked);
     replaceAndFindNextPushButton->setVisible(nowChecked);
+    replaceAllPushButton->setVisible(nowChecked);
 
     if (nowChecked) {
         advancedToolButton->setIcon(Application::icon("advanced_controls_visible"));
@@ -466,6 +478,23 @@ void FindAndReplaceDialog::replaceAndSearchForwardsButtonClicked() {
 }
 
 
+void FindAndReplaceDialog::replaceAllButtonClicked() {
+    QLineEdit* searchLineEdit             = widget<QLineEdit>("search_line_edit");
+    QLineEdit* replaceLineEdit            = widget<QLineEdit>("replace_line_edit");
+    QCheckBox* caseSensitiveCheckBox      = widget<QCheckBox>("case_sensitive_check_box");
+    QCheckBox* wholeWordsOnlyCheckBox     = widget<QCheckBox>("whole_words_only_check_box");
+    QCheckBox* regularExpressionsCheckBox = widget<QCheckBox>("regular_expressions_check_box");
+
+    QString searchText         = searchLineEdit->text();
+    QString replacementText    = replaceLineEdit->text();
+    bool    caseSensitive      = caseSensitiveCheckBox->isChecked();
+    bool    wholeWordsOnly     = wholeWordsOnlyCheckBox->isChecked();
+    bool    regularExpressions = regularExpressionsCheckBox->isChecked();
+
+    emit replaceAll(searchText, replacementText, caseSensitive, wholeWordsOnly, regularExpressions);
+}
+
+
 void FindAndReplaceDialog::closeButtonClicked() {
     emit closeRequested();
 }
@@ -613,6 +642,19 @@ void FindAndReplaceDialog::configureWidget() {
 
     replaceButtonLayout->addStretch(1);
 
+    QPushButton* replaceAllPushButton = new QPushButton(tr("Replace All"));
+    replaceAllPushButton->setToolTip(tr("Click to replace every occurrence in the document."));
+    replaceAllPushButton->setWhatsThis(
+        tr(
+            "You can click this button to replace every occurrence of the search text in the document.  All of the "
+            "replacements can be undone in a single step."
+        )
+    );
+    registerWidget(replaceAllPushButton, "replace_all_push_button");
+    replaceButtonLayout->addWidget(replaceAllPushButton);
+
+    replaceButtonLayout->addStretch(1);
+
     QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
     registerWidget(buttonBox, "dialog_button_box");
     registerWidget(buttonBox->button(QDialogButtonBox::Close), "close_push_button");
@@ -628,12 +670,14 @@ void FindAndReplaceDialog::configureWidget() {
     replaceAndFindPreviousPushButton->setEnabled(false);
     replacePushButton->setEnabled(false);
     replaceAndFindNextPushButton->setEnabled(false);
+    replaceAllPushButton->setEnabled(false);
 
     advancedToolButton->setChecked(false);
     replaceGroupBox->setVisible(false);
     replaceAndFindPreviousPushButton->setVisible(false);
     replacePushButton->setVisible(false);
     replaceAndFindNextPushButton->setVisible(false);
+    replaceAllPushButton->setVisible(false);
 
     searchLineEdit->setFocus();
 }
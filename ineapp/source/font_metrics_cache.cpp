@@ -0,0 +1,177 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref FontMetricsCache class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <QFont>
+#include <QFontMetricsF>
+
+#include "font_metrics_cache.h"
+
+/***********************************************************************************************************************
+ * FontMetricsCache::Entry
+ */
+
+FontMetricsCache::Entry::Entry(const QFont& font):currentFont(font),currentFontMetrics(font) {
+    currentAscent     = currentFontMetrics.ascent();
+    currentDescent    = currentFontMetrics.descent();
+    currentHeight     = currentFontMetrics.height();
+    currentMWidth     = currentFontMetrics.horizontalAdvance(QString("M"));
+    currentSpaceWidth = currentFontMetrics.horizontalAdvance(QString(" "));
+}
+
+
+FontMetricsCache::Entry::~Entry() {}
+
+
+const QFont& FontMetricsCache::Entry::font() const {
+    return currentFont;
+}
+
+
+const QFontMetricsF& FontMetricsCache::Entry::fontMetrics() const {
+    return currentFontMetrics;
+}
+
+
+float FontMetricsCache::Entry::ascent() const {
+    return currentAscent;
+}
+
+
+float FontMetricsCache::Entry::descent() const {
+    return currentDescent;
+}
+
+
+float FontMetricsCache::Entry::height() const {
+    return currentHeight;
+}
+
+
+float FontMetricsCache::Entry::mWidth() const {
+    return currentMWidth;
+}
+
+
+float FontMetricsCache::Entry::spaceWidth() const {
+    return currentSpaceWidth;
+}
+
+
+float FontMetricsCache::Entry::horizontalAdvance(const QString& text) const {
+    float result;
+
+    QHash<QString, float>::const_iterator it = currentAdvances.constFind(text);
+    if (it != currentAdvances.constEnd()) {
+        result = it.value();
+    } else {
+        result = currentFontMetrics.horizontalAdvance(text);
+
+        if (currentAdvances.size() >= maximumNumberAdvances) {
+            currentAdvances.clear();
+        }
+
+        currentAdvances.insert(text, result);
+    }
+
+    return result;
+}
+
+/***********************************************************************************************************************
+ * FontMetricsCache
+ */
+
+QHash<QFont, FontMetricsCache::Slot> FontMetricsCache::entries;
+QList<FontMetricsCache::Entry*>      FontMetricsCache::retiredEntries;
+unsigned long                        FontMetricsCache::currentGeneration = 0;
+unsigned long long                   FontMetricsCache::currentUseCount   = 0;
+
+const FontMetricsCache::Entry& FontMetricsCache::entry(const QFont& font) {
+    Entry* result;
+
+    ++currentUseCount;
+
+    QHash<QFont, Slot>::iterator it = entries.find(font);
+    if (it != entries.end()) {
+        it.value().lastUse = currentUseCount;
+        result             = it.value().entry;
+    } else {
+        if (entries.size() >= maximumNumberEntries) {
+            evictLeastRecentlyUsed();
+        }
+
+        Slot slot;
+        slot.entry   = new Entry(font);
+        slot.lastUse = currentUseCount;
+
+        entries.insert(font, slot);
+        result = slot.entry;
+    }
+
+    return *result;
+}
+
+
+void FontMetricsCache::clear() {
+    for (QHash<QFont, Slot>::const_iterator it=entries.constBegin(),end=entries.constEnd() ; it!=end ; ++it) {
+        retire(it.value().entry);
+    }
+
+    entries.clear();
+    ++currentGeneration;
+}
+
+
+unsigned long FontMetricsCache::generation() {
+    return currentGeneration;
+}
+
+
+unsigned long FontMetricsCache::numberEntries() {
+    return static_cast<unsigned long>(entries.size());
+}
+
+
+void FontMetricsCache::evictLeastRecentlyUsed() {
+    QHash<QFont, Slot>::iterator oldest = entries.begin();
+    for (QHash<QFont, Slot>::iterator it=entries.begin(),end=entries.end() ; it!=end ; ++it) {
+        if (it.value().lastUse < oldest.value().lastUse) {
+            oldest = it;
+        }
+    }
+
+    if (oldest != entries.end()) {
+        retire(oldest.value().entry);
+        entries.erase(oldest);
+    }
+}
+
+
+void FontMetricsCache::retire(FontMetricsCache::Entry* entry) {
+    // Placement code holds references to entries while it runs.  Entries are therefore only destroyed once control
+    // returns to the event loop.
+
+    if (retiredEntries.isEmpty()) {
+        QTimer::singleShot(0, &FontMetricsCache::releaseRetiredEntries);
+    }
+
+    retiredEntries.append(entry);
+}
+
+
+void FontMetricsCache::releaseRetiredEntries() {
+    for (QList<Entry*>::const_iterator it=retiredEntries.constBegin(),end=retiredEntries.constEnd() ; it!=end ; ++it) {
+        delete *it;
+    }
+
+    retiredEntries.clear();
+}
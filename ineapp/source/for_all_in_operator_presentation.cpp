@@ -18,6 +18,7 @@
 #include <ld_for_all_in_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "operator_presentation_base.h"
 #include "control_flow_operator_presentation_base.h"
 #include "for_all_in_operator_presentation.h"
@@ -63,7 +64,7 @@ EQt::GraphicsMathGroup* ForAllInOperatorPresentation::updateGraphicsItem(
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     QSharedPointer<Ld::ForAllInOperatorElement>
         element = ForAllInOperatorPresentation::element().dynamicCast<Ld::ForAllInOperatorElement>();
@@ -25,6 +25,7 @@
 
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
 #include "presentation.h"
 #include "presentation_with_positional_children.h"
 #include "frame_presentation_base.h"
@@ -87,6 +88,7 @@ void FramePresentationBase::recalculatePlacement(
                 minimumTopSpacing = imposeNoTopSpacing;
             }
 
+            PlacementProfiler::Scope profilerScope(childPresentation);
             childPresentation->recalculatePlacement(
                 placementTracker,
                 this,
@@ -150,6 +152,8 @@ void FramePresentationBase::allocateArea(
 
 
 void FramePresentationBase::areaInsufficient(unsigned long, const QSizeF& size) {
+    PlacementProfiler::areaInsufficient();
+
     cursorY += size.height();
 
     if (cursorY >= currentActiveArea.bottom()) {
@@ -13,6 +13,8 @@
 #include <QVariant>
 #include <QMap>
 #include <QList>
+#include <QVector>
+#include <QBitArray>
 #include <QFont>
 #include <QFontMetrics>
 #include <QColor>
@@ -27,11 +29,14 @@
 
 #include "metatypes.h"
 #include "application.h"
+#include "function_search_index.h"
 #include "function_browser_model.h"
 
 FunctionBrowserModel::FunctionBrowserModel(QObject* parent):QAbstractItemModel(parent) {
-    geometryUpdateNeeded = true;
-    currentFunctionList  = Ld::FunctionDatabase::search(Ld::Capabilities(), QString(), QList<QString>());
+    geometryUpdateNeeded   = true;
+    currentIndexGeneration = 0;
+
+    updateFunctionList();
 }
 
 
@@ -45,15 +50,17 @@ FunctionBrowserModel::FunctionBrowserModel(
     currentFunctionFont    = functionFont;
     currentDescriptionFont = descriptionFont;
     geometryUpdateNeeded   = true;
-    currentFunctionList    = Ld::FunctionDatabase::search(Ld::Capabilities(), QString(), QList<QString>());
+    currentIndexGeneration = 0;
+
+    updateFunctionList();
 }
 
 
 FunctionBrowserModel::~FunctionBrowserModel() {}
 
 
-const QList<Ld::FunctionData>& FunctionBrowserModel::presentedFunctions() const {
-    return currentFunctionList;
+unsigned FunctionBrowserModel::numberPresentedFunctions() const {
+    return static_cast<unsigned>(currentEntryIndexes.size());
 }
 
 
@@ -121,9 +128,12 @@ bool FunctionBrowserModel::identifyFunction(
             variantIndex  = 0;
         }
 
-        functionData = currentFunctionList.at(functionIndex);
+        const FunctionSearchIndex::Entry& entry            = FunctionSearchIndex::entry(
+            currentEntryIndexes.at(functionIndex)
+        );
+        const QList<QStringList>&         functionVariants = entry.variantParameters;
 
-        QList<QStringList> functionVariants = variants(functionData);
+        functionData = entry.functionData;
 
         if (variantIndex >= static_cast<unsigned>(functionVariants.size())) {
             variantIndex = 0;
@@ -142,15 +152,14 @@ QModelIndex FunctionBrowserModel::index(int row, int column, const QModelIndex&
 
     if (parent.isValid()) {
         unsigned parentRow = static_cast<unsigned>(parent.row());
-        if (parentRow < static_cast<unsigned>(currentFunctionList.size())) {
-            const Ld::FunctionData& functionData = currentFunctionList.at(parentRow);
-            QList<QStringList> functionVariants = variants(functionData);
-            if (row < functionVariants.size()) {
+        if (parentRow < static_cast<unsigned>(currentEntryIndexes.size())) {
+            const FunctionSearchIndex::Entry& entry = FunctionSearchIndex::entry(currentEntryIndexes.at(parentRow));
+            if (row < entry.variantParameters.size()) {
                 result = createIndex(row, column, static_cast<quintptr>(parentRow));
             }
         }
     } else {
-        if (row < currentFunctionList.size() && column < 2) {
+        if (row < currentEntryIndexes.size() && column < 2) {
             result = createIndex(row, column, static_cast<quintptr>(-1));
         }
     }
@@ -191,77 +200,23 @@ QVariant FunctionBrowserModel::data(const QModelIndex& index, int role) const {
             unsigned row = static_cast<unsigned>(index.row());
 
             if (index.internalId() == static_cast<quintptr>(-1)) {
-                const Ld::FunctionData& functionData = currentFunctionList.at(row);
+                const FunctionSearchIndex::Entry& entry = FunctionSearchIndex::entry(currentEntryIndexes.at(row));
 
                 if (column == 0) {
-                    const Ld::VariableName& variableName = functionData.userVisibleName();
-
-                    if (variableName.text2().isEmpty()) {
-                        result = tr("%1  ").arg(variableName.text1());
-                    } else {
-                        result = tr("%1<sub>%2</sub>  ").arg(variableName.text1(), variableName.text2());
-                    }
+                    result = entry.functionText;
                 } else {
-                    result = functionData.description();
+                    result = entry.description;
                 }
             } else {
                 if (column == 0) {
                     unsigned functionIndex = static_cast<unsigned>(index.internalId());
-                    if (functionIndex < static_cast<unsigned>(currentFunctionList.size())) {
-                        const Ld::FunctionData& functionData = currentFunctionList.at(functionIndex);
-                        QList<QStringList> functionVariants = variants(functionData);
-
-                        if (row < static_cast<unsigned>(functionVariants.size())) {
-                            QString            text1            = functionData.userVisibleName().text1();
-                            QString            text2            = functionData.userVisibleName().text2();
-                            bool               hasSubscript     = functionData.includeSubscriptParameter();
-
-                            const QStringList& parameters       = functionVariants.at(row);
-                            unsigned           numberParameters = static_cast<unsigned>(parameters.size());
-                            QString            str              =   text2.isEmpty()
-                                                                  ? text1
-                                                                  : tr("%1<sub>%2</sub>").arg(text1).arg(text2);
-
-                            unsigned p;
-                            bool     includeParenthesis;
-                            if (hasSubscript && numberParameters > 0) {
-                                if (text2.isEmpty()) {
-                                    str += tr("<sub><%1></sub>").arg(parameters.first());
-                                } else {
-                                    str += tr("<sub>,<%1></sub>").arg(parameters.first());
-                                }
-
-                                p = 1;
-
-                                includeParenthesis = (numberParameters > 2);
-                            } else {
-                                p = 0;
-                                includeParenthesis = (numberParameters >= 2);
-                            }
-
-                            if (includeParenthesis) {
-                                str += tr("(");
-                            } else {
-                                str += tr("%1").arg(QChar(0x200A));
-                            }
-
-                            bool firstParameter = true;
-                            while (p < numberParameters) {
-                                if (!firstParameter) {
-                                    str += tr(", ");
-                                } else {
-                                    firstParameter = false;
-                                }
-
-                                str += tr("<%1>").arg(parameters.at(p));
-                                ++p;
-                            }
-
-                            if (includeParenthesis) {
-                                str += tr(")");
-                            }
-
-                            result = str;
+                    if (functionIndex < static_cast<unsigned>(currentEntryIndexes.size())) {
+                        const FunctionSearchIndex::Entry& entry = FunctionSearchIndex::entry(
+                            currentEntryIndexes.at(functionIndex)
+                        );
+
+                        if (row < static_cast<unsigned>(entry.variantText.size())) {
+                            result = entry.variantText.at(row);
                         }
                     }
                 }
@@ -318,10 +273,8 @@ int FunctionBrowserModel::rowCount(const QModelIndex& parent) const {
     if (parent.isValid()) {
         if (parent.internalId() == static_cast<quintptr>(-1)) {
             unsigned functionIndex = static_cast<unsigned>(parent.row());
-            if (functionIndex < static_cast<unsigned>(currentFunctionList.size())) {
-                const Ld::FunctionData& functionData = currentFunctionList.at(functionIndex);
-                QList<QStringList> functionVariants = variants(functionData);
-                result = functionVariants.size();
+            if (functionIndex < static_cast<unsigned>(currentEntryIndexes.size())) {
+                result = FunctionSearchIndex::entry(currentEntryIndexes.at(functionIndex)).variantParameters.size();
             } else {
                 result = 0;
             }
@@ -329,7 +282,7 @@ int FunctionBrowserModel::rowCount(const QModelIndex& parent) const {
             result = 0;
         }
     } else {
-        result = currentFunctionList.size();
+        result = currentEntryIndexes.size();
     }
 
     return result;
@@ -339,14 +292,11 @@ int FunctionBrowserModel::rowCount(const QModelIndex& parent) const {
 void FunctionBrowserModel::setCapabilities(const Ld::Capabilities& newCapabilities) {
     beginResetModel();
 
-    currentCapabilities = newCapabilities;
-    currentFunctionList = Ld::FunctionDatabase::search(
-        newCapabilities,
-        currentSearchString,
-        currentSelectedCategories
-    );
+    currentCapabilities      = newCapabilities;
+    currentCapabilityMatches = FunctionSearchIndex::capabilityMatches(newCapabilities);
+    currentCandidates        = currentCapabilityMatches & currentCategoryMatches;
 
-    geometryUpdateNeeded = true;
+    updateFunctionList();
 
     endResetModel();
 }
@@ -356,13 +306,10 @@ void FunctionBrowserModel::setSelectedCategories(const QList<QString>& categoryL
     beginResetModel();
 
     currentSelectedCategories = categoryList;
-    currentFunctionList       = Ld::FunctionDatabase::search(
-        currentCapabilities,
-        currentSearchString,
-        categoryList
-    );
+    currentCategoryMatches    = FunctionSearchIndex::categoryMatches(categoryList);
+    currentCandidates         = currentCapabilityMatches & currentCategoryMatches;
 
-    geometryUpdateNeeded = true;
+    updateFunctionList();
 
     endResetModel();
 }
@@ -372,13 +319,7 @@ void FunctionBrowserModel::setSelectionString(const QString& selectionString) {
     beginResetModel();
 
     currentSearchString = selectionString;
-    currentFunctionList = Ld::FunctionDatabase::search(
-        currentCapabilities,
-        selectionString,
-        currentSelectedCategories
-    );
-
-    geometryUpdateNeeded = true;
+    updateFunctionList();
 
     endResetModel();
 }
@@ -391,12 +332,12 @@ void FunctionBrowserModel::calculateRecommendedGeometryData() {
     unsigned column1Width = 0;
     unsigned column2Width = 0;
 
-    for (  QList<Ld::FunctionData>::const_iterator it  = currentFunctionList.constBegin(),
-                                                   end = currentFunctionList.constEnd()
+    for (  QVector<unsigned>::const_iterator it  = currentEntryIndexes.constBegin(),
+                                             end = currentEntryIndexes.constEnd()
          ; it != end
          ; ++it
         ) {
-        const Ld::FunctionData& functionData      = *it;
+        const Ld::FunctionData& functionData      = FunctionSearchIndex::entry(*it).functionData;
         const Ld::VariableName& variableName      = functionData.userVisibleName();
         unsigned functionNameWidth = (
               functionFontMetrics.horizontalAdvance(variableName.text1())
@@ -418,40 +359,15 @@ void FunctionBrowserModel::calculateRecommendedGeometryData() {
 }
 
 
-QList<QStringList> FunctionBrowserModel::variants(const Ld::FunctionData& functionData) {
-    QMap<unsigned, QMap<QStringList, unsigned>> resultMap;
-
-    QList<Ld::FunctionVariant> functionVariants = functionData.variants();
-    for (  QList<Ld::FunctionVariant>::const_iterator variantIterator    = functionVariants.constBegin(),
-                                                      variantEndIterator = functionVariants.constEnd()
-         ; variantIterator != variantEndIterator
-         ; ++variantIterator
-        ) {
-        const Ld::FunctionVariant&            variant          = *variantIterator;
-        unsigned                              numberParameters = variant.numberParameters();
-        QList<QString>                        descriptions     = variant.parameterDescriptions();
-        const QList<Ld::DataType::ValueType>& parameterTypes   = variant.parameterTypes();
-
-        Q_ASSERT(numberParameters == static_cast<unsigned>(descriptions.size()));
-        Q_ASSERT(numberParameters == static_cast<unsigned>(parameterTypes.size()));
-
-        if (variant.allowsVariadicParameters()) {
-            descriptions.append(tr("%1").arg(QChar(0x2026)));
-        }
-
-        QMap<QStringList, unsigned>& resultMap2 = resultMap[numberParameters];
-        resultMap2.insert(descriptions, 1);
+void FunctionBrowserModel::updateFunctionList() {
+    unsigned long indexGeneration = FunctionSearchIndex::generation();
+    if (indexGeneration != currentIndexGeneration) {
+        currentCapabilityMatches = FunctionSearchIndex::capabilityMatches(currentCapabilities);
+        currentCategoryMatches   = FunctionSearchIndex::categoryMatches(currentSelectedCategories);
+        currentCandidates        = currentCapabilityMatches & currentCategoryMatches;
+        currentIndexGeneration   = indexGeneration;
     }
 
-    QList<QStringList> result;
-    for (  QMap<unsigned, QMap<QStringList, unsigned>>::const_iterator resultIterator    = resultMap.constBegin(),
-                                                                       resultEndIterator = resultMap.constEnd()
-         ; resultIterator != resultEndIterator
-         ; ++resultIterator
-        ) {
-        const QMap<QStringList, unsigned>& resultMap2 = resultIterator.value();
-        result.append(resultMap2.keys());
-    }
-
-    return result;
+    currentEntryIndexes  = FunctionSearchIndex::search(currentCandidates, currentSearchString);
+    geometryUpdateNeeded = true;
 }
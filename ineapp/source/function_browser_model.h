@@ -15,6 +15,8 @@
 #include <QString>
 #include <QStringList>
 #include <QList>
+#include <QVector>
+#include <QBitArray>
 #include <QVariant>
 #include <QFont>
 #include <QModelIndex>
@@ -55,11 +57,11 @@ class FunctionBrowserModel:public QAbstractItemModel {
         ~FunctionBrowserModel() override;
 
         /**
-         * Method you can use to obtain a list of all the functions presented in the model view.
+         * Method you can use to determine the number of functions presented in the model view.
          *
-         * \return Returns a reference to a list of function instances.
+         * \return Returns the number of presented functions.
          */
-        const QList<Ld::FunctionData>& presentedFunctions() const;
+        unsigned numberPresentedFunctions() const;
 
         /**
          * Method you can use to obtain a list of the active capabilities in the search.
@@ -240,13 +242,10 @@ class FunctionBrowserModel:public QAbstractItemModel {
         void calculateRecommendedGeometryData();
 
         /**
-         * Method that calculates all the variants of a given function.
-         *
-         * \param[in] functionData The function data to calculate the variants for.
-         *
-         * \return Returns a list of all the variant descriptions.
+         * Method that updates the presented functions from the search index.  The capability and category bitsets
+         * are recalculated if the index was rebuilt.  The model must be reset by the caller.
          */
-        static QList<QStringList> variants(const Ld::FunctionData& functionData);
+        void updateFunctionList();
 
         /**
          * Method that provides a string description of a type.
@@ -283,9 +282,29 @@ class FunctionBrowserModel:public QAbstractItemModel {
         QFont currentDescriptionFont;
 
         /**
-         * The current list of functions.
+         * The search index entries for the presented functions.
+         */
+        QVector<unsigned> currentEntryIndexes;
+
+        /**
+         * Bitset of the functions available with the current capabilities.
+         */
+        QBitArray currentCapabilityMatches;
+
+        /**
+         * Bitset of the functions in the currently selected categories.
+         */
+        QBitArray currentCategoryMatches;
+
+        /**
+         * Bitset of the functions available with the current capabilities and selected categories.
+         */
+        QBitArray currentCandidates;
+
+        /**
+         * The search index generation the bitsets and entry indexes were obtained from.
          */
-        QList<Ld::FunctionData> currentFunctionList;
+        unsigned long currentIndexGeneration;
 
         /**
          * Flag that indicates if geometry data needs to be updated.
@@ -122,7 +122,7 @@ void FunctionDockWidget::requirementsChanged(const Ld::Capabilities& newRequirem
     functionBrowserModel->setSelectionString(QString());
     functionBrowserModel->setSelectedCategories(QList<QString>());
 
-    if (functionBrowserModel->presentedFunctions().isEmpty()) {
+    if (functionBrowserModel->numberPresentedFunctions() == 0) {
         horizontalBrowserTable->setEnabled(false);
         horizontalLineEdit->setEnabled(false);
         horizontalInsertStandardFunctionButton->setEnabled(false);
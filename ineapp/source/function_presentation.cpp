@@ -45,8 +45,10 @@
 #include <ld_function_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
 #include "presentation_with_positional_children.h"
 #include "presentation_area_tracker.h"
 #include "function_presentation.h"
@@ -152,13 +154,13 @@ void FunctionPresentation::recalculatePlacement(
         functionSubscript += tr(",");
     }
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float functionNameWidth   = fontMetrics.horizontalAdvance(functionName);
     float functionNameHeight  = fontMetrics.height();
     float functionNameAscent  = fontMetrics.ascent();
     float functionNameDescent = fontMetrics.descent();
 
-    QFontMetricsF subscriptFontMetrics(subscriptFont);
+    const QFontMetricsF& subscriptFontMetrics = FontMetricsCache::fontMetrics(subscriptFont);
 
     float functionSubscriptWidth              = subscriptFontMetrics.horizontalAdvance(functionSubscript);
     float functionSubscriptPositionAdjustment = functionNameHeight * subscriptBaseline;
@@ -536,6 +538,7 @@ void FunctionPresentation::populatePresentationAreaTrackers(
         Presentation*      childPresentation   = dynamic_cast<Presentation*>(childElement->visual());
         Presentation*      siblingPresentation = dynamic_cast<Presentation*>(nextSibling->visual());
 
+        PlacementProfiler::Scope profilerScope(childPresentation);
         childPresentation->recalculatePlacement(
             placementTracker,
             this,
@@ -554,6 +557,7 @@ void FunctionPresentation::populatePresentationAreaTrackers(
         Ld::ElementPointer childElement      = element->child(numberChildren - 1);
         Presentation*      childPresentation = dynamic_cast<Presentation*>(childElement->visual());
 
+        PlacementProfiler::Scope profilerScope(childPresentation);
         childPresentation->recalculatePlacement(
             placementTracker,
             this,
@@ -729,10 +733,10 @@ QRectF FunctionPresentation::cursorToScene(unsigned long textIndex, unsigned reg
     QString                                  entryText     = entry.text().left(textIndex);
     QPointF                                  entryPosition = entry.position();
 
-    QFontMetricsF entryFontMetrics(entry.font());
-    float         cursorXOffset = entryFontMetrics.horizontalAdvance(entryText);
-    float         cursorAscent  = entryFontMetrics.ascent();
-    float         cursorHeight  = entryFontMetrics.height();
+    const QFontMetricsF& entryFontMetrics = FontMetricsCache::fontMetrics(entry.font());
+    float                cursorXOffset = entryFontMetrics.horizontalAdvance(entryText);
+    float                cursorAscent  = entryFontMetrics.ascent();
+    float                cursorHeight  = entryFontMetrics.height();
 
     QPointF cursorRelativeTopPosition = QPointF(
         entryPosition.x() + cursorXOffset,
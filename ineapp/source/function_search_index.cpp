@@ -0,0 +1,322 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref FunctionSearchIndex class.
+***********************************************************************************************************************/
+
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+#include <QChar>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QBitArray>
+
+#include <algorithm>
+
+#include <ld_variable_name.h>
+#include <ld_data_type.h>
+#include <ld_capabilities.h>
+#include <ld_function_data.h>
+#include <ld_function_database.h>
+
+#include "function_search_index.h"
+
+bool                              FunctionSearchIndex::currentlyBuilt    = false;
+unsigned long                     FunctionSearchIndex::currentGeneration = 0;
+QList<FunctionSearchIndex::Entry> FunctionSearchIndex::entries;
+QHash<QString, unsigned>          FunctionSearchIndex::entryIndexByCommand;
+QMap<QString, QBitArray>          FunctionSearchIndex::categoryBits;
+QHash<QString, QBitArray>         FunctionSearchIndex::searchMatches;
+
+void FunctionSearchIndex::build() {
+    entries.clear();
+    entryIndexByCommand.clear();
+    categoryBits.clear();
+    searchMatches.clear();
+
+    QList<Ld::FunctionData> functions = Ld::FunctionDatabase::search(
+        Ld::Capabilities(),
+        QString(),
+        QList<QString>()
+    );
+
+    unsigned numberFunctions = static_cast<unsigned>(functions.size());
+    for (unsigned entryIndex=0 ; entryIndex<numberFunctions ; ++entryIndex) {
+        const Ld::FunctionData& functionData = functions.at(entryIndex);
+        const Ld::VariableName& variableName = functionData.userVisibleName();
+
+        Entry entry;
+        entry.functionData = functionData;
+        entry.description  = functionData.description();
+
+        if (variableName.text2().isEmpty()) {
+            entry.functionText = tr("%1  ").arg(variableName.text1());
+        } else {
+            entry.functionText = tr("%1<sub>%2</sub>  ").arg(variableName.text1(), variableName.text2());
+        }
+
+        entry.variantParameters = variants(functionData);
+        for (  QList<QStringList>::const_iterator it  = entry.variantParameters.constBegin(),
+                                                  end = entry.variantParameters.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            entry.variantText.append(variantText(functionData, *it));
+        }
+
+        entryIndexByCommand.insert(functionData.functionCommand(), entryIndex);
+        entries.append(entry);
+    }
+
+    QList<QString> categories = Ld::FunctionDatabase::categories();
+    for (QList<QString>::const_iterator it=categories.constBegin(),end=categories.constEnd() ; it!=end ; ++it) {
+        QBitArray               bits(static_cast<int>(numberFunctions));
+        QList<Ld::FunctionData> categoryFunctions = Ld::FunctionDatabase::search(
+            Ld::Capabilities(),
+            QString(),
+            QList<QString>() << *it
+        );
+
+        for (  QList<Ld::FunctionData>::const_iterator functionIterator    = categoryFunctions.constBegin(),
+                                                       functionEndIterator = categoryFunctions.constEnd()
+             ; functionIterator != functionEndIterator
+             ; ++functionIterator
+            ) {
+            QHash<QString, unsigned>::const_iterator indexIterator = entryIndexByCommand.constFind(
+                functionIterator->functionCommand()
+            );
+
+            if (indexIterator != entryIndexByCommand.constEnd()) {
+                bits.setBit(static_cast<int>(indexIterator.value()));
+            }
+        }
+
+        categoryBits.insert(*it, bits);
+    }
+
+    currentlyBuilt = true;
+    ++currentGeneration;
+}
+
+
+void FunctionSearchIndex::invalidate() {
+    currentlyBuilt = false;
+}
+
+
+unsigned long FunctionSearchIndex::generation() {
+    ensureBuilt();
+    return currentGeneration;
+}
+
+
+unsigned FunctionSearchIndex::numberEntries() {
+    ensureBuilt();
+    return static_cast<unsigned>(entries.size());
+}
+
+
+const FunctionSearchIndex::Entry& FunctionSearchIndex::entry(unsigned entryIndex) {
+    return entries.at(entryIndex);
+}
+
+
+QBitArray FunctionSearchIndex::capabilityMatches(const Ld::Capabilities& capabilities) {
+    ensureBuilt();
+
+    QBitArray               result(entries.size());
+    QList<Ld::FunctionData> functions = Ld::FunctionDatabase::search(capabilities, QString(), QList<QString>());
+
+    for (QList<Ld::FunctionData>::const_iterator it=functions.constBegin(),end=functions.constEnd() ; it!=end ; ++it) {
+        QHash<QString, unsigned>::const_iterator indexIterator = entryIndexByCommand.constFind(it->functionCommand());
+        if (indexIterator != entryIndexByCommand.constEnd()) {
+            result.setBit(static_cast<int>(indexIterator.value()));
+        }
+    }
+
+    return result;
+}
+
+
+QBitArray FunctionSearchIndex::categoryMatches(const QList<QString>& categories) {
+    ensureBuilt();
+
+    QBitArray result;
+
+    if (categories.isEmpty()) {
+        result = QBitArray(entries.size(), true);
+    } else {
+        result = QBitArray(entries.size());
+        for (QList<QString>::const_iterator it=categories.constBegin(),end=categories.constEnd() ; it!=end ; ++it) {
+            QMap<QString, QBitArray>::const_iterator bitsIterator = categoryBits.constFind(*it);
+            if (bitsIterator != categoryBits.constEnd()) {
+                result |= bitsIterator.value();
+            }
+        }
+    }
+
+    return result;
+}
+
+
+QVector<unsigned> FunctionSearchIndex::search(const QBitArray& candidates, const QString& searchString) {
+    ensureBuilt();
+
+    QVector<unsigned> result;
+    QBitArray         matches    = candidates;
+    unsigned          numberBits = std::min(static_cast<unsigned>(candidates.size()), numberEntries());
+
+    if (!searchString.isEmpty()) {
+        matches.resize(entries.size());
+        matches &= searchStringMatches(searchString);
+    }
+
+    for (unsigned entryIndex=0 ; entryIndex<numberBits ; ++entryIndex) {
+        if (matches.testBit(static_cast<int>(entryIndex))) {
+            result.append(entryIndex);
+        }
+    }
+
+    return result;
+}
+
+
+void FunctionSearchIndex::ensureBuilt() {
+    if (!currentlyBuilt) {
+        build();
+    }
+}
+
+
+QBitArray FunctionSearchIndex::searchStringMatches(const QString& searchString) {
+    QBitArray result;
+
+    QHash<QString, QBitArray>::const_iterator matchIterator = searchMatches.constFind(searchString);
+    if (matchIterator != searchMatches.constEnd()) {
+        result = matchIterator.value();
+    } else {
+        result = QBitArray(entries.size());
+
+        QList<Ld::FunctionData> functions = Ld::FunctionDatabase::search(
+            Ld::Capabilities(),
+            searchString,
+            QList<QString>()
+        );
+
+        for (  QList<Ld::FunctionData>::const_iterator it  = functions.constBegin(), end = functions.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            QHash<QString, unsigned>::const_iterator indexIterator = entryIndexByCommand.constFind(
+                it->functionCommand()
+            );
+
+            if (indexIterator != entryIndexByCommand.constEnd()) {
+                result.setBit(static_cast<int>(indexIterator.value()));
+            }
+        }
+
+        if (searchMatches.size() >= maximumCachedSearchStrings) {
+            searchMatches.clear();
+        }
+
+        searchMatches.insert(searchString, result);
+    }
+
+    return result;
+}
+
+
+QList<QStringList> FunctionSearchIndex::variants(const Ld::FunctionData& functionData) {
+    QMap<unsigned, QMap<QStringList, unsigned>> resultMap;
+
+    QList<Ld::FunctionVariant> functionVariants = functionData.variants();
+    for (  QList<Ld::FunctionVariant>::const_iterator variantIterator    = functionVariants.constBegin(),
+                                                      variantEndIterator = functionVariants.constEnd()
+         ; variantIterator != variantEndIterator
+         ; ++variantIterator
+        ) {
+        const Ld::FunctionVariant&            variant          = *variantIterator;
+        unsigned                              numberParameters = variant.numberParameters();
+        QList<QString>                        descriptions     = variant.parameterDescriptions();
+        const QList<Ld::DataType::ValueType>& parameterTypes   = variant.parameterTypes();
+
+        Q_ASSERT(numberParameters == static_cast<unsigned>(descriptions.size()));
+        Q_ASSERT(numberParameters == static_cast<unsigned>(parameterTypes.size()));
+
+        if (variant.allowsVariadicParameters()) {
+            descriptions.append(tr("%1").arg(QChar(0x2026)));
+        }
+
+        QMap<QStringList, unsigned>& resultMap2 = resultMap[numberParameters];
+        resultMap2.insert(descriptions, 1);
+    }
+
+    QList<QStringList> result;
+    for (  QMap<unsigned, QMap<QStringList, unsigned>>::const_iterator resultIterator    = resultMap.constBegin(),
+                                                                       resultEndIterator = resultMap.constEnd()
+         ; resultIterator != resultEndIterator
+         ; ++resultIterator
+        ) {
+        const QMap<QStringList, unsigned>& resultMap2 = resultIterator.value();
+        result.append(resultMap2.keys());
+    }
+
+    return result;
+}
+
+
+QString FunctionSearchIndex::variantText(const Ld::FunctionData& functionData, const QStringList& parameters) {
+    QString  text1            = functionData.userVisibleName().text1();
+    QString  text2            = functionData.userVisibleName().text2();
+    bool     hasSubscript     = functionData.includeSubscriptParameter();
+    unsigned numberParameters = static_cast<unsigned>(parameters.size());
+    QString  str              = text2.isEmpty() ? text1 : tr("%1<sub>%2</sub>").arg(text1).arg(text2);
+
+    unsigned p;
+    bool     includeParenthesis;
+    if (hasSubscript && numberParameters > 0) {
+        if (text2.isEmpty()) {
+            str += tr("<sub><%1></sub>").arg(parameters.first());
+        } else {
+            str += tr("<sub>,<%1></sub>").arg(parameters.first());
+        }
+
+        p = 1;
+
+        includeParenthesis = (numberParameters > 2);
+    } else {
+        p = 0;
+        includeParenthesis = (numberParameters >= 2);
+    }
+
+    if (includeParenthesis) {
+        str += tr("(");
+    } else {
+        str += tr("%1").arg(QChar(0x200A));
+    }
+
+    bool firstParameter = true;
+    while (p < numberParameters) {
+        if (!firstParameter) {
+            str += tr(", ");
+        } else {
+            firstParameter = false;
+        }
+
+        str += tr("<%1>").arg(parameters.at(p));
+        ++p;
+    }
+
+    if (includeParenthesis) {
+        str += tr(")");
+    }
+
+    return str;
+}
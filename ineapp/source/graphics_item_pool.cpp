@@ -0,0 +1,186 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref GraphicsItemPoolBase class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+#include <QPointF>
+#include <QTransform>
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+
+#include <eqt_graphics_text_item.h>
+
+#include "graphics_item_pool.h"
+
+/***********************************************************************************************************************
+ * GraphicsItemPoolBase::Statistics
+ */
+
+GraphicsItemPoolBase::Statistics::Statistics() {
+    currentNumberAcquisitions = 0;
+    currentNumberHits         = 0;
+    currentNumberReleases     = 0;
+    currentNumberDiscards     = 0;
+    currentNumberRetained     = 0;
+}
+
+
+GraphicsItemPoolBase::Statistics::Statistics(const GraphicsItemPoolBase::Statistics& other) {
+    currentTypeName           = other.currentTypeName;
+    currentNumberAcquisitions = other.currentNumberAcquisitions;
+    currentNumberHits         = other.currentNumberHits;
+    currentNumberReleases     = other.currentNumberReleases;
+    currentNumberDiscards     = other.currentNumberDiscards;
+    currentNumberRetained     = other.currentNumberRetained;
+}
+
+
+GraphicsItemPoolBase::Statistics::~Statistics() {}
+
+
+const QString& GraphicsItemPoolBase::Statistics::typeName() const {
+    return currentTypeName;
+}
+
+
+unsigned long long GraphicsItemPoolBase::Statistics::numberAcquisitions() const {
+    return currentNumberAcquisitions;
+}
+
+
+unsigned long long GraphicsItemPoolBase::Statistics::numberHits() const {
+    return currentNumberHits;
+}
+
+
+unsigned long long GraphicsItemPoolBase::Statistics::numberReleases() const {
+    return currentNumberReleases;
+}
+
+
+unsigned long long GraphicsItemPoolBase::Statistics::numberDiscards() const {
+    return currentNumberDiscards;
+}
+
+
+unsigned long GraphicsItemPoolBase::Statistics::numberRetained() const {
+    return currentNumberRetained;
+}
+
+
+double GraphicsItemPoolBase::Statistics::hitRate() const {
+    double result;
+
+    if (currentNumberAcquisitions > 0) {
+        result = static_cast<double>(currentNumberHits) / static_cast<double>(currentNumberAcquisitions);
+    } else {
+        result = 0;
+    }
+
+    return result;
+}
+
+
+GraphicsItemPoolBase::Statistics& GraphicsItemPoolBase::Statistics::operator=(
+        const GraphicsItemPoolBase::Statistics& other
+    ) {
+    currentTypeName           = other.currentTypeName;
+    currentNumberAcquisitions = other.currentNumberAcquisitions;
+    currentNumberHits         = other.currentNumberHits;
+    currentNumberReleases     = other.currentNumberReleases;
+    currentNumberDiscards     = other.currentNumberDiscards;
+    currentNumberRetained     = other.currentNumberRetained;
+
+    return *this;
+}
+
+/***********************************************************************************************************************
+ * GraphicsItemPoolBase
+ */
+
+QList<GraphicsItemPoolBase*> GraphicsItemPoolBase::pools;
+
+QList<GraphicsItemPoolBase::Statistics> GraphicsItemPoolBase::statistics() {
+    QList<Statistics> result;
+
+    for (  QList<GraphicsItemPoolBase*>::const_iterator it = pools.constBegin(), end = pools.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        GraphicsItemPoolBase* pool  = *it;
+        Statistics            entry = pool->currentStatistics;
+
+        entry.currentNumberRetained = pool->numberRetained();
+        result.append(entry);
+    }
+
+    return result;
+}
+
+
+void GraphicsItemPoolBase::clearAll() {
+    for (  QList<GraphicsItemPoolBase*>::const_iterator it = pools.constBegin(), end = pools.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        (*it)->clear();
+    }
+}
+
+
+GraphicsItemPoolBase::GraphicsItemPoolBase(const QString& typeName) {
+    currentStatistics.currentTypeName = typeName;
+    pools.append(this);
+}
+
+
+GraphicsItemPoolBase::~GraphicsItemPoolBase() {
+    pools.removeAll(this);
+}
+
+
+void GraphicsItemPoolBase::detach(QGraphicsItem* item) {
+    if (item->parentItem() != Q_NULLPTR) {
+        item->setParentItem(Q_NULLPTR);
+    }
+
+    QGraphicsScene* scene = item->scene();
+    if (scene != Q_NULLPTR) {
+        scene->removeItem(item);
+    }
+
+    // Children belong to other presentations.  Removing the item from the scene also removed the children so they
+    // are left unparented, outside of any scene, until their presentations place or delete them.
+
+    QList<QGraphicsItem*> children = item->childItems();
+    for (  QList<QGraphicsItem*>::const_iterator it = children.constBegin(), end = children.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        (*it)->setParentItem(Q_NULLPTR);
+    }
+}
+
+
+void GraphicsItemPoolBase::resetItem(QGraphicsItem* item) {
+    item->setPos(QPointF(0, 0));
+    item->setTransform(QTransform());
+    item->setZValue(0);
+    item->setOpacity(1.0);
+    item->setToolTip(QString());
+    item->setVisible(true);
+}
+
+
+void GraphicsItemPoolBase::resetItem(EQt::GraphicsTextItem* item) {
+    resetItem(static_cast<QGraphicsItem*>(item));
+
+    item->setText(QString());
+    item->clearBackgroundBrush();
+}
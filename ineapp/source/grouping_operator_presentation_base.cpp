@@ -38,7 +38,9 @@
 #include <ld_operator_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
 #include "presentation.h"
 #include "presentation_with_fixed_children.h"
 #include "scene_units.h"
@@ -57,7 +59,9 @@ static_assert(
 );
 
 GroupingOperatorPresentationBase::GroupingOperatorPresentationBase() {
-    currentGraphicsItem = Q_NULLPTR;
+    currentGraphicsItem             = Q_NULLPTR;
+    currentSelfRepositioningPending = true;
+    committedRelativeScale          = 0.0F;
 }
 
 
@@ -66,8 +70,21 @@ GroupingOperatorPresentationBase::~GroupingOperatorPresentationBase() {
 }
 
 
-void GroupingOperatorPresentationBase::requestRepositioning(Presentation* /* childPresentation */) {
-    // We have only one child so we know which child we care about.
+void GroupingOperatorPresentationBase::requestRepositioning(Presentation* childPresentation) {
+    // We have only one child so we know which child we care about.  We keep the layout the child had when we last
+    // committed our placement.  If the child reports the same layout once re-placed, we can skip rebuilding our
+    // graphics item.
+
+    if (childPresentation == this || childPresentation == Q_NULLPTR) {
+        currentSelfRepositioningPending = true;
+    } else if (!committedChildPresentationArea.containsChildData()) {
+        if (currentChildPresentationArea.containsChildData()) {
+            committedChildPresentationArea = currentChildPresentationArea;
+            committedChildPositions        = currentChildPresentationArea.positions();
+        } else {
+            currentSelfRepositioningPending = true;
+        }
+    }
 
     currentChildPresentationArea.clear();
 
@@ -81,6 +98,11 @@ void GroupingOperatorPresentationBase::requestRepositioning(Presentation* /* chi
 }
 
 
+void GroupingOperatorPresentationBase::flagPendingRepositioning() {
+    currentSelfRepositioningPending = true;
+}
+
+
 void GroupingOperatorPresentationBase::recalculatePlacement(
         PlacementTracker*    placementTracker,
         PlacementNegotiator* parent,
@@ -100,6 +122,7 @@ void GroupingOperatorPresentationBase::recalculatePlacement(
             Presentation* childPresentation = dynamic_cast<Presentation*>(childElement->visual());
             if (childPresentation != Q_NULLPTR) {
                 currentChildPresentationArea.setChildPresentation(childPresentation);
+                PlacementProfiler::Scope profilerScope(childPresentation);
                 childPresentation->recalculatePlacement(
                     placementTracker,
                     this,
@@ -114,86 +137,93 @@ void GroupingOperatorPresentationBase::recalculatePlacement(
         }
     }
 
-    float childMaximumAscent  = currentChildPresentationArea.maximumAscent();
-    float childMaximumDescent = currentChildPresentationArea.maximumDescent();
-    float childHeight         = childMaximumAscent + childMaximumDescent;
+    // If the child reports the same layout as before, our size and ascent are unchanged.  We only move the child back
+    // into position and our parent will, in turn, find that our layout is unchanged.
 
-    if (currentGraphicsItem == Q_NULLPTR) {
-        currentGraphicsItem = new EQt::GraphicsMathGroup;
-    }
+    if (!restoreCommittedPlacement(relativeScale)) {
+        float childMaximumAscent  = currentChildPresentationArea.maximumAscent();
+        float childMaximumDescent = currentChildPresentationArea.maximumDescent();
+        float childHeight         = childMaximumAscent + childMaximumDescent;
 
-    Ld::FormatPointer format = element->format();
-    QFont             font;
-    QColor            parenthesisColor;
-    QColor            backgroundColor;
-    if (!format.isNull() && format->capabilities().contains(Ld::FontFormat::formatName)) {
-        QSharedPointer<Ld::FontFormat> fontFormat = format.dynamicCast<Ld::FontFormat>();
+        if (currentGraphicsItem == Q_NULLPTR) {
+            currentGraphicsItem = new EQt::GraphicsMathGroup;
+        }
 
-        font             = fontFormat->toQFont();
-        parenthesisColor = fontFormat->fontColor();
-        backgroundColor  = fontFormat->fontBackgroundColor();
-    } else {
-        QSharedPointer<Ld::FontFormat> fontFormat = Ld::CharacterFormat::applicationDefaultMathFont();
+        Ld::FormatPointer format = element->format();
+        QFont             font;
+        QColor            parenthesisColor;
+        QColor            backgroundColor;
+        if (!format.isNull() && format->capabilities().contains(Ld::FontFormat::formatName)) {
+            QSharedPointer<Ld::FontFormat> fontFormat = format.dynamicCast<Ld::FontFormat>();
 
-        font             = fontFormat->toQFont();
-        parenthesisColor = fontFormat->fontColor();
-        backgroundColor  = fontFormat->fontBackgroundColor();
-    }
+            font             = fontFormat->toQFont();
+            parenthesisColor = fontFormat->fontColor();
+            backgroundColor  = fontFormat->fontBackgroundColor();
+        } else {
+            QSharedPointer<Ld::FontFormat> fontFormat = Ld::CharacterFormat::applicationDefaultMathFont();
 
-    if (!parenthesisColor.isValid()) {
-        parenthesisColor = QColor(Qt::black);
-    }
+            font             = fontFormat->toQFont();
+            parenthesisColor = fontFormat->fontColor();
+            backgroundColor  = fontFormat->fontBackgroundColor();
+        }
 
-    if (!backgroundColor.isValid()) {
-        backgroundColor = QColor(255, 255, 255, 0);
-    }
+        if (!parenthesisColor.isValid()) {
+            parenthesisColor = QColor(Qt::black);
+        }
+
+        if (!backgroundColor.isValid()) {
+            backgroundColor = QColor(255, 255, 255, 0);
+        }
+
+        currentGraphicsItem->setBackgroundBrush(QBrush(backgroundColor));
+        currentGraphicsItem->setParenthesisPen(QPen(parenthesisColor));
 
-    currentGraphicsItem->setBackgroundBrush(QBrush(backgroundColor));
-    currentGraphicsItem->setParenthesisPen(QPen(parenthesisColor));
+        EQt::GraphicsMathGroup::ParenthesisStyle leftParenStyle  = leftParenthesisStyle(format);
+        EQt::GraphicsMathGroup::ParenthesisStyle rightParenStyle = rightParenthesisStyle(format);
 
-    EQt::GraphicsMathGroup::ParenthesisStyle leftParenStyle  = leftParenthesisStyle(format);
-    EQt::GraphicsMathGroup::ParenthesisStyle rightParenStyle = rightParenthesisStyle(format);
+        ParenthesisData leftParenthesisData  = leftParenthesisSize(font, childHeight, leftParenStyle);
+        ParenthesisData rightParenthesisData = rightParenthesisSize(font, childHeight, rightParenStyle);
 
-    ParenthesisData leftParenthesisData  = leftParenthesisSize(font, childHeight, leftParenStyle);
-    ParenthesisData rightParenthesisData = rightParenthesisSize(font, childHeight, rightParenStyle);
+        float currentX = leftParenthesisData.width();
+        for (  PresentationAreaTracker::Iterator presentationAreaIterator    = currentChildPresentationArea.begin(),
+                                                 presentationAreaEndIterator = currentChildPresentationArea.end()
+             ; presentationAreaIterator != presentationAreaEndIterator
+             ; ++presentationAreaIterator
+            ) {
+            const PresentationAreaTracker::Entry& areaEntry = *presentationAreaIterator;
+            QGraphicsItem* childItem   = areaEntry.graphicsItem();
+            float          childAscent = areaEntry.ascent();
 
-    float currentX = leftParenthesisData.width();
-    for (  PresentationAreaTracker::Iterator presentationAreaIterator    = currentChildPresentationArea.begin(),
-                                             presentationAreaEndIterator = currentChildPresentationArea.end()
-         ; presentationAreaIterator != presentationAreaEndIterator
-         ; ++presentationAreaIterator
-        ) {
-        const PresentationAreaTracker::Entry& areaEntry = *presentationAreaIterator;
-        QGraphicsItem* childItem   = areaEntry.graphicsItem();
-        float          childAscent = areaEntry.ascent();
+            if (childItem->parentItem() != currentGraphicsItem) {
+                currentGraphicsItem->addToGroup(childItem);
+            }
 
-        if (childItem->parentItem() != currentGraphicsItem) {
-            currentGraphicsItem->addToGroup(childItem);
+            childItem->setPos(currentX, childMaximumAscent - childAscent);
+            currentX += areaEntry.areaSize().width();
         }
 
-        childItem->setPos(currentX, childMaximumAscent - childAscent);
-        currentX += areaEntry.areaSize().width();
-    }
+        unsigned parenthesisIndex = 0;
+        insertLeftParenthesis(leftParenthesisData, 0.0F, 0.0F, currentGraphicsItem, parenthesisIndex);
+        insertRightParenthesis(rightParenthesisData, currentX, 0.0F, currentGraphicsItem, parenthesisIndex);
 
-    unsigned parenthesisIndex = 0;
-    insertLeftParenthesis(leftParenthesisData, 0.0F, 0.0F, currentGraphicsItem, parenthesisIndex);
-    insertRightParenthesis(rightParenthesisData, currentX, 0.0F, currentGraphicsItem, parenthesisIndex);
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+        currentGraphicsItem->setParenthesisCenterLine(
+            childMaximumAscent - fontMetrics.ascent() / 4.0 - leftParenthesisData.relativePosition()
+        );
 
-    QFontMetricsF fontMetrics(font);
-    currentGraphicsItem->setParenthesisCenterLine(
-        childMaximumAscent - fontMetrics.ascent() / 4.0 - leftParenthesisData.relativePosition()
-    );
+        currentX += rightParenthesisData.width();
 
-    currentX += rightParenthesisData.width();
+        requiredSize   = QSizeF(currentX, childHeight);
+        requiredAscent = childMaximumAscent;
+    }
+
+    commitPlacement(relativeScale);
 
     Ld::DiagnosticPointer diagnostic = element->diagnostic();
 
     currentGraphicsItem->setBorderPen(updateBorder(diagnostic));
     currentGraphicsItem->setToolTip(updateToolTip(diagnostic));
 
-    requiredSize   = QSizeF(currentX, childHeight);
-    requiredAscent = childMaximumAscent;
-
     bool placed = false;
     do {
         SpaceQualifier spaceQualifier;
@@ -279,6 +309,8 @@ QGraphicsItem* GroupingOperatorPresentationBase::graphicsItem(unsigned long pres
 
 void GroupingOperatorPresentationBase::resetPlacement() {
     currentChildPresentationArea.resetPlacement();
+    currentSelfRepositioningPending = true;
+
     PresentationWithFixedChildren::resetPlacement();
 }
 
@@ -290,6 +322,7 @@ void GroupingOperatorPresentationBase::removeFromScene() {
         currentGraphicsItem->deleteLater();
         currentGraphicsItem = Q_NULLPTR;
     }
+    currentSelfRepositioningPending = true;
 }
 
 
@@ -350,4 +383,26 @@ QList<QRectF> GroupingOperatorPresentationBase::cursorRangeToScene(
 
 void GroupingOperatorPresentationBase::clearChildPresentationAreas() {
     currentChildPresentationArea.clear();
+    currentSelfRepositioningPending = true;
+}
+
+
+bool GroupingOperatorPresentationBase::restoreCommittedPlacement(float relativeScale) {
+    return (
+           currentGraphicsItem != Q_NULLPTR
+        && !currentSelfRepositioningPending
+        && committedChildPresentationArea.containsChildData()
+        && relativeScale == committedRelativeScale
+        && currentChildPresentationArea.hasSameLayout(committedChildPresentationArea)
+        && currentChildPresentationArea.restorePositions(currentGraphicsItem, committedChildPositions)
+    );
+}
+
+
+void GroupingOperatorPresentationBase::commitPlacement(float relativeScale) {
+    committedChildPresentationArea.clear();
+    committedChildPositions.clear();
+
+    currentSelfRepositioningPending = false;
+    committedRelativeScale          = relativeScale;
 }
@@ -36,6 +36,7 @@
 #include <eqt_graphics_pixmap_item.h>
 #include <eqt_graphics_item_group.h>
 
+#include "font_metrics_cache.h"
 #include "presentation.h"
 #include "plot_wrapped_presentation_data.h"
 #include "heat_chart_presentation_data.h"
@@ -533,7 +534,7 @@ void HeatChartPresentationData::configureAxis(
         axis->setRange(minimum, maximum);
     }
 
-    QFontMetricsF numberFontMetrics(numberFont);
+    const QFontMetricsF& numberFontMetrics = FontMetricsCache::fontMetrics(numberFont);
 
     float  requiredNumberTicks = 0;
     double span                = std::abs(maximum - minimum);
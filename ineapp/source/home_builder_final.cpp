@@ -31,6 +31,7 @@
 #include <eqt_recent_files_popup_menu.h>
 #include <eqt_tool_button.h>
 
+#include "latency_tracer.h"
 #include "main_window.h"
 #include "home_builder_final.h"
 
@@ -154,6 +155,18 @@ void HomeBuilderFinal::buildMainWindowGui(EQt::ProgrammaticMainWindow* window) {
         tr("Use this option to open an example to use as a starting point or as inspiration.")
     );
 
+    if (LatencyTracer::isEnabled()) {
+        window->addMenuAction(tr("&Help | Write &Latency Report"), "help_write_latency_report");
+        window->setToolTip("help_write_latency_report", tr("Write the collected input latency trace"));
+        window->setWhatsThis(
+            "help_write_latency_report",
+            tr(
+                "Use this option to write the keystroke to paint latency measurements collected so far to the "
+                "latency trace file."
+            )
+        );
+    }
+
     window->addSeparator(tr("&Help"));
 
     window->addMenuAction(tr("&Help | Send &Feedback..."), "help_send_feedback");
@@ -290,4 +303,10 @@ void HomeBuilderFinal::buildMainWindowFinal(EQt::ProgrammaticMainWindow* window)
     QAction* helpAboutAction = mainWindow->action("help_about");
     success = mainWindow->setCommand(tr("about"), helpAboutAction);
     Q_ASSERT(success);
+
+    if (LatencyTracer::isEnabled()) {
+        QAction* helpWriteLatencyReportAction = mainWindow->action("help_write_latency_report");
+        success = mainWindow->setCommand(tr("latencyreport"), helpWriteLatencyReportAction);
+        Q_ASSERT(success);
+    }
 }
@@ -36,6 +36,8 @@
 #include <ld_root_element.h>
 
 #include "document.h"
+#include "import_loader.h"
+#include "autosave_journal.h"
 #include "application.h"
 #include "application_settings.h"
 #include "build_execute_state_machine.h"
@@ -47,6 +49,7 @@
 #include "about_dialog.h"
 #include "document_file_dialog.h"
 #include "home_builder_initial.h"
+#include "latency_tracer.h"
 #include "home_main_window_proxy.h"
 
 HomeMainWindowProxy::HomeMainWindowProxy(
@@ -261,6 +264,15 @@ void HomeMainWindowProxy::bind() {
     connect(window->action("help_send_feedback"), &QAction::triggered, this, &HomeMainWindowProxy::helpSendFeedback);
     connect(window->action("help_about"), &QAction::triggered, this, &HomeMainWindowProxy::helpAbout);
 
+    if (LatencyTracer::isEnabled()) {
+        connect(
+            window->action("help_write_latency_report"),
+            &QAction::triggered,
+            this,
+            &HomeMainWindowProxy::helpWriteLatencyReport
+        );
+    }
+
     connect(window, &MainWindow::tabBarContextMenuRequested, this, &HomeMainWindowProxy::displayTabBarContextMenu);
 
     #if (defined(Q_OS_DARWIN) || defined(Q_OS_LINUX))
@@ -616,6 +628,18 @@ void HomeMainWindowProxy::helpOpenExamples() {
 }
 
 
+void HomeMainWindowProxy::helpWriteLatencyReport() {
+    bool success = Application::instance()->writeLatencyTraceReport();
+    if (!success) {
+        QMessageBox::warning(
+            window(),
+            tr("Unable to write latency report"),
+            tr("Could not write the latency trace report.")
+        );
+    }
+}
+
+
 void HomeMainWindowProxy::helpSendFeedback() {
     unsigned long long customerId = 0; //Application::customerId();
 
@@ -643,13 +667,47 @@ bool HomeMainWindowProxy::openFile(const QString& fileName) {
     QFileInfo fileInformation(fileName);
     Document*   document = Document::document(fileInformation);
 
+    if (document == Q_NULLPTR) {
+        // Documents that were previously opened, either directly or as an import, and have not changed on disk can be
+        // reused without parsing them again.
+
+        QSharedPointer<Ld::RootElement> cachedRootElement = ImportLoader::cachedRootElement(fileName);
+        if (!cachedRootElement.isNull()) {
+            document = dynamic_cast<Document*>(cachedRootElement->visual());
+        }
+    }
+
     if (document == Q_NULLPTR) {
         QSharedPointer<Ld::RootElement> rootElement = Ld::Element::create(Ld::RootElement::elementName)
                                                       .dynamicCast<Ld::RootElement>();
         Ld::RootElement::registerRootElement(rootElement);
         document = dynamic_cast<Document*>(rootElement->visual());
 
-        success = document->loadDocument(fileName);
+        bool recover = false;
+        if (AutosaveJournal::recoveryAvailable(fileName)) {
+            QMessageBox::StandardButton button = QMessageBox::question(
+                window,
+                tr("Recover unsaved changes"),
+                tr(
+                    "%1 was not closed cleanly and has unsaved changes.  Do you want to recover them?\n"
+                    "Recovered changes are not written to the file until you save it."
+                ).arg(fileName),
+                QMessageBox::Yes | QMessageBox::No,
+                QMessageBox::Yes
+            );
+
+            recover = (button == QMessageBox::Yes);
+            if (!recover) {
+                AutosaveJournal::discard(fileName);
+            }
+        }
+
+        if (recover) {
+            success = document->recoverDocument(fileName);
+        } else {
+            success = document->loadDocument(fileName);
+        }
+
         if (!success) {
             QMessageBox::information(
                 window,
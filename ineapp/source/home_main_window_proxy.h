@@ -177,6 +177,11 @@ class HomeMainWindowProxy:public EQt::ProgrammaticMainWindowProxy {
          */
         void helpOpenExamples();
 
+        /**
+         * Slot that is triggered for the Help | Write Latency Report menu item.
+         */
+        void helpWriteLatencyReport();
+
         /**
          * Slot that is triggered for the Help | Send Feedback... menu item.
          */
@@ -654,6 +654,7 @@ void HomeViewProxy::fileExportPdf() {
             statusDialog.setLeaderText(tr("Exporting PDF to:\n%1").arg(pdfExportDialog.selectedFile()));
 
             PrintingEngine printingEngine(&printer, rootElement, pdfExportDialog.pageList());
+            printingEngine.setRenderingMode(PrintingEngine::RenderingMode::VECTOR_DISPLAY_LISTS);
 
             connect(&printingEngine, &PrintingEngine::started, &statusDialog, &PrintingStatusDialog::started);
             connect(
@@ -711,6 +712,7 @@ void HomeViewProxy::filePrint() {
 
         PrintingEngine printingEngine(&printer, rootElement);
         printingEngine.setCurrentPageNumber(currentPage);
+        printingEngine.setRenderingMode(PrintingEngine::RenderingMode::VECTOR_DISPLAY_LISTS);
 
         connect(&printingEngine, &PrintingEngine::started, &statusDialog, &PrintingStatusDialog::started);
         connect(
@@ -1104,6 +1106,40 @@ void HomeViewProxy::replaceAndSearchBackward(
 }
 
 
+void HomeViewProxy::replaceAll(
+        const QString& searchText,
+        const QString& replacementText,
+        bool           caseSensitive,
+        bool           wholeWordsOnly,
+        bool           regularExpression
+    ) {
+    ViewWidget*   view               = HomeViewProxy::view();
+    unsigned long numberReplacements = view->replaceAll(
+        searchText,
+        replacementText,
+        caseSensitive,
+        wholeWordsOnly,
+        regularExpression
+    );
+
+    lowerFindAndReplaceDialog();
+    if (numberReplacements == 0) {
+        QMessageBox::information(
+            window(),
+            tr("Could Not Perform Replace"),
+            tr("Could not find\n\"%1\"").arg(searchText)
+        );
+    } else {
+        QMessageBox::information(
+            window(),
+            tr("Replace All"),
+            tr("Replaced %1 occurrence(s) of\n\"%2\"").arg(numberReplacements).arg(searchText)
+        );
+    }
+    raiseFindAndReplaceDialog();
+}
+
+
 void HomeViewProxy::findAndReplaceDialogCloseRequested() {
     MainWindow* window = HomeViewProxy::window();
 
@@ -1671,6 +1707,13 @@ void HomeViewProxy::displayFindReplaceDialog(bool showReplaceOptions) {
         &HomeViewProxy::replaceAndSearchBackward
     );
 
+    connect(
+        currentFindAndReplaceDialog,
+        &FindAndReplaceDialog::replaceAll,
+        this,
+        &HomeViewProxy::replaceAll
+    );
+
     connect(
         currentFindAndReplaceDialog,
         &FindAndReplaceDialog::closeRequested,
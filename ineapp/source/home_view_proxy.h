@@ -599,6 +599,30 @@ class HomeViewProxy:public ViewProxy {
             bool           regularExpression
         );
 
+        /**
+         * Slot that is triggered when the user clicks the replace all button in the find and replace dialog.
+         *
+         * \param[in] searchText        The text to be located.
+         *
+         * \param[in] replacementText   The text to replace the search text.
+         *
+         * \param[in] caseSensitive     If true, the search should be case sensitive.  If false, the search should
+         *                              case insensitive.
+         *
+         * \param[in] wholeWordsOnly    If true, the search should look for whole words only.  If false, the search
+         *                              can identify text in words.
+         *
+         * \param[in] regularExpression If true, the search should be treated as a regular expression search.  if
+         *                              false, the search should be a normal search.
+         */
+        void replaceAll(
+            const QString& searchText,
+            const QString& replacementText,
+            bool           caseSensitive,
+            bool           wholeWordsOnly,
+            bool           regularExpression
+        );
+
         /**
          * Slot that is triggered when the user clicks either the close button or the dialog X in the title bar in the
          * find and replace dialog.
@@ -0,0 +1,309 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref ImageCache class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QSize>
+#include <QSizeF>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QPainter>
+#include <QBuffer>
+#include <QImageReader>
+#include <QSvgRenderer>
+#include <QCryptographicHash>
+#include <QSharedPointer>
+#include <QWeakPointer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#include <util_units.h>
+
+#include "image_cache.h"
+
+/***********************************************************************************************************************
+ * ImageCache::Image
+ */
+
+ImageCache::Image::Image(const QByteArray& contentHash, const QSize& sizePixels) {
+    currentContentHash = contentHash;
+    currentSizePixels  = sizePixels;
+    currentState       = State::PENDING;
+}
+
+
+ImageCache::Image::~Image() {}
+
+
+const QByteArray& ImageCache::Image::contentHash() const {
+    return currentContentHash;
+}
+
+
+ImageCache::State ImageCache::Image::state() const {
+    return currentState;
+}
+
+
+const QSize& ImageCache::Image::sizePixels() const {
+    return currentSizePixels;
+}
+
+
+const QSizeF& ImageCache::Image::dotsPerPoint() const {
+    return currentDotsPerPoint;
+}
+
+
+const QString& ImageCache::Image::errorString() const {
+    return currentErrorString;
+}
+
+
+unsigned ImageCache::Image::numberLevels() const {
+    return static_cast<unsigned>(currentLevels.size());
+}
+
+
+QSize ImageCache::Image::levelSize(unsigned level) const {
+    return currentLevels.at(level).size();
+}
+
+
+const QImage& ImageCache::Image::levelImage(unsigned level) const {
+    return currentLevels.at(level);
+}
+
+
+unsigned ImageCache::Image::levelForSize(const QSizeF& requiredSizePixels) const {
+    unsigned result       = 0;
+    unsigned numberLevels = static_cast<unsigned>(currentLevels.size());
+
+    while (result + 1 < numberLevels) {
+        QSize nextLevelSize = currentLevels.at(result + 1).size();
+        if (nextLevelSize.width()  < requiredSizePixels.width()  ||
+            nextLevelSize.height() < requiredSizePixels.height()    ) {
+            break;
+        }
+
+        ++result;
+    }
+
+    return result;
+}
+
+
+const QPixmap& ImageCache::Image::pixmap(unsigned level) {
+    QPixmap& result = currentPixmaps[level];
+    if (result.isNull()) {
+        result = QPixmap::fromImage(currentLevels.at(level));
+    }
+
+    return result;
+}
+
+/***********************************************************************************************************************
+ * ImageCache
+ */
+
+ImageCache* ImageCache::instance() {
+    static ImageCache* cache = new ImageCache;
+    return cache;
+}
+
+
+ImageCache::ImagePointer ImageCache::image(const QByteArray& imageData, QString& errorString) {
+    ImageCache*  cache       = instance();
+    QByteArray   contentHash = QCryptographicHash::hash(imageData, QCryptographicHash::Sha1);
+    ImagePointer result      = cache->images.value(contentHash).toStrongRef();
+
+    if (result.isNull()) {
+        bool  isSvg      = (imageData.startsWith("<?xml") && imageData.contains("<svg"));
+        bool  headerRead = false;
+        QSize sizePixels;
+
+        if (isSvg) {
+            QSvgRenderer renderer(imageData);
+
+            if (renderer.animated()) {
+                errorString = tr("Animated .SVG files not supported.");
+            } else if (!renderer.isValid()) {
+                errorString = tr("Invalid .SVG contents.");
+            } else {
+                sizePixels = renderer.defaultSize();
+                headerRead = true;
+            }
+        } else {
+            QBuffer buffer;
+            buffer.setData(imageData);
+            buffer.open(QBuffer::ReadOnly);
+
+            QImageReader reader(&buffer);
+            headerRead = reader.canRead();
+            if (headerRead) {
+                sizePixels = reader.size();
+            }
+        }
+
+        if (headerRead) {
+            cache->purgeExpiredImages();
+
+            if (!sizePixels.isEmpty()) {
+                result = ImagePointer(new Image(contentHash, sizePixels));
+                cache->images.insert(contentHash, result.toWeakRef());
+
+                DecodeWatcher* watcher = new DecodeWatcher(cache);
+                cache->pendingDecodes.insert(watcher, contentHash);
+                connect(watcher, &DecodeWatcher::finished, cache, &ImageCache::decodeFinished);
+
+                watcher->setFuture(QtConcurrent::run(&ImageCache::decode, imageData, isSvg, sizePixels));
+            } else {
+                // Some formats do not report their size without a full decode.  We decode these immediately.
+
+                DecodeResult decodeResult = decode(imageData, isSvg, sizePixels);
+                if (decodeResult.success) {
+                    result = ImagePointer(new Image(contentHash, decodeResult.levels.first().size()));
+                    cache->images.insert(contentHash, result.toWeakRef());
+                    cache->applyDecodeResult(contentHash, decodeResult);
+                } else {
+                    errorString = decodeResult.errorString;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+
+void ImageCache::waitForPendingDecodes() {
+    ImageCache* cache = instance();
+
+    while (!cache->pendingDecodes.isEmpty()) {
+        DecodeWatcher* watcher     = cache->pendingDecodes.constBegin().key();
+        QByteArray     contentHash = cache->pendingDecodes.take(watcher);
+
+        watcher->waitForFinished();
+        cache->applyDecodeResult(contentHash, watcher->result());
+        watcher->deleteLater();
+    }
+}
+
+
+unsigned long ImageCache::numberImages() {
+    ImageCache* cache = instance();
+    cache->purgeExpiredImages();
+
+    return static_cast<unsigned long>(cache->images.size());
+}
+
+
+void ImageCache::decodeFinished() {
+    DecodeWatcher* watcher = dynamic_cast<DecodeWatcher*>(sender());
+
+    // The decode may have already been applied by waitForPendingDecodes.
+
+    if (watcher != Q_NULLPTR && pendingDecodes.contains(watcher)) {
+        QByteArray contentHash = pendingDecodes.take(watcher);
+        applyDecodeResult(contentHash, watcher->result());
+        watcher->deleteLater();
+    }
+}
+
+
+ImageCache::ImageCache() {}
+
+
+ImageCache::~ImageCache() {}
+
+
+ImageCache::DecodeResult ImageCache::decode(const QByteArray& imageData, bool isSvg, const QSize& sizePixels) {
+    DecodeResult result;
+    QImage       image;
+
+    if (isSvg) {
+        QSvgRenderer renderer(imageData);
+
+        image = QImage(sizePixels, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        renderer.render(&painter);
+        painter.end();
+
+        result.success = true;
+    } else {
+        QBuffer buffer;
+        buffer.setData(imageData);
+        buffer.open(QBuffer::ReadOnly);
+
+        QImageReader reader(&buffer);
+        result.success = reader.read(&image);
+        if (!result.success) {
+            result.errorString = tr("Could not load image.");
+        }
+    }
+
+    if (result.success) {
+        result.dotsPerPoint = QSizeF(
+            image.dotsPerMeterX() * Util::Units::mmPerPoint / 1000.0,
+            image.dotsPerMeterY() * Util::Units::mmPerPoint / 1000.0
+        );
+
+        result.levels.append(image);
+        while (std::max(image.width(), image.height()) > minimumPyramidDimension) {
+            image = image.scaled(
+                std::max(1, image.width() / 2),
+                std::max(1, image.height() / 2),
+                Qt::IgnoreAspectRatio,
+                Qt::SmoothTransformation
+            );
+
+            result.levels.append(image);
+        }
+    }
+
+    return result;
+}
+
+
+void ImageCache::applyDecodeResult(const QByteArray& contentHash, const DecodeResult& result) {
+    ImagePointer image = images.value(contentHash).toStrongRef();
+    if (!image.isNull()) {
+        if (result.success) {
+            image->currentState        = State::DECODED;
+            image->currentDotsPerPoint = result.dotsPerPoint;
+            image->currentLevels       = result.levels;
+            image->currentPixmaps      = QVector<QPixmap>(result.levels.size());
+        } else {
+            image->currentState       = State::FAILED;
+            image->currentErrorString = result.errorString;
+        }
+
+        emit imageDecoded(contentHash);
+    }
+}
+
+
+void ImageCache::purgeExpiredImages() {
+    QHash<QByteArray, QWeakPointer<Image>>::iterator it = images.begin();
+    while (it != images.end()) {
+        if (it.value().isNull()) {
+            it = images.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,218 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref ImagePictureRecorder class.
+***********************************************************************************************************************/
+
+#include <QPaintDevice>
+#include <QPaintEngine>
+#include <QPainter>
+#include <QPicture>
+#include <QPixmap>
+#include <QImage>
+#include <QRectF>
+#include <QLineF>
+#include <QPointF>
+#include <QPainterPath>
+
+#include "image_picture_recorder.h"
+
+/***********************************************************************************************************************
+ * ImagePictureRecorder::Engine
+ */
+
+ImagePictureRecorder::Engine::Engine(QPicture* picture):QPaintEngine(QPaintEngine::AllFeatures) {
+    currentPicture = picture;
+}
+
+
+ImagePictureRecorder::Engine::~Engine() {}
+
+
+bool ImagePictureRecorder::Engine::begin(QPaintDevice*) {
+    return recordingPainter.begin(currentPicture);
+}
+
+
+bool ImagePictureRecorder::Engine::end() {
+    return recordingPainter.end();
+}
+
+
+void ImagePictureRecorder::Engine::updateState(const QPaintEngineState& state) {
+    QPaintEngine::DirtyFlags flags = state.state();
+
+    if (flags & QPaintEngine::DirtyPen) {
+        recordingPainter.setPen(state.pen());
+    }
+
+    if (flags & QPaintEngine::DirtyBrush) {
+        recordingPainter.setBrush(state.brush());
+    }
+
+    if (flags & QPaintEngine::DirtyBrushOrigin) {
+        recordingPainter.setBrushOrigin(state.brushOrigin());
+    }
+
+    if (flags & QPaintEngine::DirtyBackground) {
+        recordingPainter.setBackground(state.backgroundBrush());
+    }
+
+    if (flags & QPaintEngine::DirtyBackgroundMode) {
+        recordingPainter.setBackgroundMode(state.backgroundMode());
+    }
+
+    if (flags & QPaintEngine::DirtyFont) {
+        recordingPainter.setFont(state.font());
+    }
+
+    // The clip is interpreted using the transform in effect when it is set so the transform must be applied first.
+
+    if (flags & QPaintEngine::DirtyTransform) {
+        recordingPainter.setTransform(state.transform());
+    }
+
+    if (flags & QPaintEngine::DirtyClipPath) {
+        recordingPainter.setClipPath(state.clipPath(), state.clipOperation());
+    }
+
+    if (flags & QPaintEngine::DirtyClipRegion) {
+        recordingPainter.setClipRegion(state.clipRegion(), state.clipOperation());
+    }
+
+    if (flags & QPaintEngine::DirtyClipEnabled) {
+        recordingPainter.setClipping(state.isClipEnabled());
+    }
+
+    if (flags & QPaintEngine::DirtyHints) {
+        recordingPainter.setRenderHints(recordingPainter.renderHints(), false);
+        recordingPainter.setRenderHints(state.renderHints(), true);
+    }
+
+    if (flags & QPaintEngine::DirtyCompositionMode) {
+        recordingPainter.setCompositionMode(state.compositionMode());
+    }
+
+    if (flags & QPaintEngine::DirtyOpacity) {
+        recordingPainter.setOpacity(state.opacity());
+    }
+}
+
+
+void ImagePictureRecorder::Engine::drawRects(const QRectF* rectangles, int numberRectangles) {
+    recordingPainter.drawRects(rectangles, numberRectangles);
+}
+
+
+void ImagePictureRecorder::Engine::drawLines(const QLineF* lines, int numberLines) {
+    recordingPainter.drawLines(lines, numberLines);
+}
+
+
+void ImagePictureRecorder::Engine::drawPath(const QPainterPath& path) {
+    recordingPainter.drawPath(path);
+}
+
+
+void ImagePictureRecorder::Engine::drawPolygon(const QPointF* points, int numberPoints, PolygonDrawMode mode) {
+    switch (mode) {
+        case QPaintEngine::OddEvenMode: {
+            recordingPainter.drawPolygon(points, numberPoints, Qt::OddEvenFill);
+            break;
+        }
+
+        case QPaintEngine::WindingMode: {
+            recordingPainter.drawPolygon(points, numberPoints, Qt::WindingFill);
+            break;
+        }
+
+        case QPaintEngine::ConvexMode: {
+            recordingPainter.drawConvexPolygon(points, numberPoints);
+            break;
+        }
+
+        case QPaintEngine::PolylineMode: {
+            recordingPainter.drawPolyline(points, numberPoints);
+            break;
+        }
+
+        default: {
+            Q_ASSERT(false);
+            break;
+        }
+    }
+}
+
+
+void ImagePictureRecorder::Engine::drawPixmap(
+        const QRectF&  rectangle,
+        const QPixmap& pixmap,
+        const QRectF&  sourceRectangle
+    ) {
+    recordingPainter.drawImage(rectangle, pixmap.toImage(), sourceRectangle);
+}
+
+
+void ImagePictureRecorder::Engine::drawImage(
+        const QRectF&            rectangle,
+        const QImage&            image,
+        const QRectF&            sourceRectangle,
+        Qt::ImageConversionFlags flags
+    ) {
+    recordingPainter.drawImage(rectangle, image, sourceRectangle, flags);
+}
+
+
+QPaintEngine::Type ImagePictureRecorder::Engine::type() const {
+    return QPaintEngine::User;
+}
+
+/***********************************************************************************************************************
+ * ImagePictureRecorder
+ */
+
+ImagePictureRecorder::ImagePictureRecorder(QPicture* picture):currentEngine(picture) {
+    currentPicture = picture;
+}
+
+
+ImagePictureRecorder::~ImagePictureRecorder() {}
+
+
+QPaintEngine* ImagePictureRecorder::paintEngine() const {
+    return &currentEngine;
+}
+
+
+int ImagePictureRecorder::metric(QPaintDevice::PaintDeviceMetric metric) const {
+    int result;
+
+    switch (metric) {
+        case QPaintDevice::PdmWidth:                  { result = currentPicture->width();                   break; }
+        case QPaintDevice::PdmHeight:                 { result = currentPicture->height();                  break; }
+        case QPaintDevice::PdmWidthMM:                { result = currentPicture->widthMM();                 break; }
+        case QPaintDevice::PdmHeightMM:               { result = currentPicture->heightMM();                break; }
+        case QPaintDevice::PdmNumColors:              { result = currentPicture->colorCount();              break; }
+        case QPaintDevice::PdmDepth:                  { result = currentPicture->depth();                   break; }
+        case QPaintDevice::PdmDpiX:                   { result = currentPicture->logicalDpiX();             break; }
+        case QPaintDevice::PdmDpiY:                   { result = currentPicture->logicalDpiY();             break; }
+        case QPaintDevice::PdmPhysicalDpiX:           { result = currentPicture->physicalDpiX();            break; }
+        case QPaintDevice::PdmPhysicalDpiY:           { result = currentPicture->physicalDpiY();            break; }
+        case QPaintDevice::PdmDevicePixelRatio:       { result = currentPicture->devicePixelRatio();        break; }
+
+        case QPaintDevice::PdmDevicePixelRatioScaled: {
+            result = static_cast<int>(currentPicture->devicePixelRatioF() * QPaintDevice::devicePixelRatioFScale());
+            break;
+        }
+
+        default: {
+            result = QPaintDevice::metric(metric);
+            break;
+        }
+    }
+
+    return result;
+}
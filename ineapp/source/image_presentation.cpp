@@ -13,7 +13,6 @@
 #include <QRectF>
 #include <QPointF>
 #include <QPixmap>
-#include <QSvgRenderer>
 #include <QPainter>
 #include <QPen>
 #include <QBrush>
@@ -23,7 +22,6 @@
 #include <algorithm>
 #include <cmath>
 
-#include <eqt_graphics_pixmap_item.h>
 #include <eqt_graphics_svg_item.h>
 
 #include <util_units.h>
@@ -39,6 +37,9 @@
 #include "application.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
+#include "image_cache.h"
+#include "image_pyramid_item.h"
 #include "leaf_presentation.h"
 #include "image_presentation.h"
 
@@ -48,10 +49,13 @@ const QSizeF ImagePresentation::defaultDotsPerPoint(96.0F / 72.0F, 96.0F / 72.0F
 ImagePresentation::ImagePresentation() {
     connect(this, SIGNAL(payloadWasChanged()), SLOT(processDataChange()), connectionType);
     connect(this, SIGNAL(payloadFailedToLoad()), SLOT(reportPayloadCouldNotBeLoaded()), connectionType);
+    connect(ImageCache::instance(), &ImageCache::imageDecoded, this, &ImagePresentation::imageDecoded);
 
     currentGraphicsItem        = Q_NULLPTR;
     currentPrescaledResolution = QSizeF();
     currentImageValid          = false;
+    currentRotation            = Ld::ImageFormat::Rotation::NO_ROTATION;
+    currentPixmapKey           = 0;
 }
 
 
@@ -79,6 +83,7 @@ void ImagePresentation::recalculatePlacement(
         currentImageValid = loadAndAdjustImage();
     }
 
+    PlacementProfiler::Scope profilerScope(this, PlacementProfiler::Operation::REDO_PLACEMENT);
     redoPlacement(parent, childIdentifier, 0);
 }
 
@@ -123,7 +128,7 @@ void ImagePresentation::redoPlacement(
         if (!fits) {
             parent->areaInsufficient(childIdentifier, availableSpace);
         } else {
-            dynamic_cast<QGraphicsItem*>(currentGraphicsItem)->setTransform(transform);
+            updatePixmap(adjustedImageSize, transform);
             parent->allocateArea(childIdentifier, 0, adjustedImageSize);
         }
     } while (!fits);
@@ -178,9 +183,7 @@ QSizeF ImagePresentation::prescaledImageSizePoints() {
     }
 
     if (currentImageValid) {
-        QSizeF scalingFactor =   currentPrescaledResolution.isNull()
-                               ? defaultDotsPerPoint
-                               : currentPrescaledResolution;
+        QSizeF scalingFactor = effectiveDotsPerPoint(currentPrescaledResolution);
 
         result = QSizeF(
             currentPrescaledSizePixels.width() / scalingFactor.width(),
@@ -224,6 +227,44 @@ void ImagePresentation::processPayloadChange() {
 void ImagePresentation::reportPayloadCouldNotBeLoaded() {}
 
 
+void ImagePresentation::imageDecoded(const QByteArray& contentHash) {
+    if (!currentImage.isNull() && currentImage->contentHash() == contentHash && currentGraphicsItem != Q_NULLPTR) {
+        QSizeF decodedResolution = effectiveDotsPerPoint(currentImage->dotsPerPoint());
+        if (currentRotation == Ld::ImageFormat::Rotation::ROTATE_CCW_90 ||
+            currentRotation == Ld::ImageFormat::Rotation::ROTATE_CW_90     ) {
+            decodedResolution.transpose();
+        }
+
+        // Images still being decoded are placed using the default resolution so only images whose actual resolution
+        // differs need to be placed again.
+
+        QSizeF placedResolution = effectiveDotsPerPoint(currentPrescaledResolution);
+        if (currentImage->state() == ImageCache::State::FAILED || decodedResolution != placedResolution) {
+            // The image was placed using a size that is no longer correct.  Rebuild the graphics item and request
+            // that our parent reposition us.
+
+            clearGraphicsItem();
+
+            if (graftedToRoot()) {
+                Ld::ElementPointer parent = element()->parent();
+                if (!parent.isNull()) {
+                    PlacementNegotiator* parentPlacementNegotiator = dynamic_cast<PlacementNegotiator*>(
+                        parent->visual()
+                    );
+
+                    if (parentPlacementNegotiator != Q_NULLPTR) {
+                        flagPendingRepositioning();
+                        parentPlacementNegotiator->requestRepositioning(this);
+                    }
+                }
+            }
+        } else {
+            updatePixmap(currentDisplayedSize, currentPlacementTransform);
+        }
+    }
+}
+
+
 void ImagePresentation::payloadChanged() {
     emit payloadWasChanged();
 }
@@ -240,91 +281,112 @@ bool ImagePresentation::createGraphicsItem(
         const Ld::ImageFormat::Axis& verticalAxisScaling,
         Ld::ImageFormat::Rotation    rotation
     ) {
-    bool    validImage;
-    QString errorString;
-
-    QPixmap unrotated;
+    bool                     validImage;
+    QString                  errorString;
+    ImageCache::ImagePointer image;
 
     currentPrescaledResolution = QSizeF();
     currentPrescaledSizePixels = QSize();
+    currentRotation            = rotation;
+    currentPixmapKey           = 0;
+
+    currentOrientationTransform.reset();
 
     if (imageData.isEmpty()) {
         errorString = tr("No image data.");
-    } else if (imageData.startsWith("<?xml") && imageData.contains("<svg")) {
-        QSvgRenderer renderer(imageData);
-
-        if (renderer.animated()) {
-            errorString = tr("Animated .SVG files not supported.");
-        } else if (!renderer.isValid()) {
-            errorString = tr("Invalid .SVG contents.");
-        } else {
-            unrotated = QPixmap(renderer.defaultSize());
-            QPainter painter(&unrotated);
-            renderer.render(&painter);
-        }
     } else {
-        QImage rawImage;
-        validImage = rawImage.loadFromData(imageData);
-        if (!validImage) {
-            Ld::ElementPointer rawRoot = element()->root();
-            if (!rawRoot.isNull() && rawRoot->typeName() == Ld::RootElement::elementName) {
-                QSharedPointer<Ld::RootElement> root = rawRoot.dynamicCast<Ld::RootElement>();
-                errorString = root->errorString();
-            } else {
-                errorString = tr("Could not load image.");
+        image = ImageCache::image(imageData, errorString);
+        if (image.isNull()) {
+            if (errorString.isEmpty()) {
+                Ld::ElementPointer rawRoot = element()->root();
+                if (!rawRoot.isNull() && rawRoot->typeName() == Ld::RootElement::elementName) {
+                    QSharedPointer<Ld::RootElement> root = rawRoot.dynamicCast<Ld::RootElement>();
+                    errorString = root->errorString();
+                } else {
+                    errorString = tr("Could not load image.");
+                }
             }
-
-            unrotated = QPixmap();
-        } else {
-            currentPrescaledResolution = QSizeF(
-                rawImage.dotsPerMeterX() * Util::Units::mmPerPoint / 1000.0,
-                rawImage.dotsPerMeterY() * Util::Units::mmPerPoint / 1000.0
-            );
-
-            unrotated = QPixmap::fromImage(rawImage);
+        } else if (image->state() == ImageCache::State::FAILED) {
+            errorString = image->errorString();
+            image.reset();
         }
     }
 
-    if (unrotated.isNull()) {
+    // We replace the image only after the cache lookup so that an image we're already displaying remains cached.
+
+    currentImage = image;
+
+    ImagePyramidItem* graphicsPixmapItem = new ImagePyramidItem;
+    graphicsPixmapItem->setImage(currentImage);
+
+    if (currentImage.isNull()) {
         QSizeF   errorPixmapSizeSceneUnits = toScene(errorImageSizePoints);
-        unrotated = QPixmap(
+        QPixmap  errorPixmap(
             static_cast<int>(errorPixmapSizeSceneUnits.width() + 0.5),
             static_cast<int>(errorPixmapSizeSceneUnits.height() + 0.5)
         );
-        QPainter painter(&unrotated);
+        QPainter painter(&errorPixmap);
 
-        QRectF boundingRect(QPointF(0, 0), QSize(unrotated.size().width() - 1, unrotated.size().height() - 1));
+        QRectF boundingRect(QPointF(0, 0), QSize(errorPixmap.size().width() - 1, errorPixmap.size().height() - 1));
 
         painter.setPen(QPen(QColor(Qt::red)));
         painter.setBrush(QBrush(QColor(Qt::white)));
         painter.drawRect(boundingRect);
 
         painter.drawText(boundingRect, Qt::AlignCenter | Qt::AlignVCenter, tr("Error\n%1").arg(errorString));
+        painter.end();
+
+        graphicsPixmapItem->setPixmap(errorPixmap);
 
         validImage = false;
     } else {
-        validImage = true;
-    }
+        QSize unrotatedSizePixels = currentImage->sizePixels();
+
+        currentPrescaledSizePixels = unrotatedSizePixels;
+        currentPrescaledResolution = currentImage->dotsPerPoint();
+        if (!currentPrescaledResolution.isValid()) {
+            // The image is still being decoded so its resolution is not yet known.
+            currentPrescaledResolution = QSizeF(0.0, 0.0);
+        }
 
-    QPixmap rotated;
-    if (validImage && rotation != Ld::ImageFormat::Rotation::NO_ROTATION) {
-        QTransform transform;
         switch (rotation) {
+            case Ld::ImageFormat::Rotation::NO_ROTATION: {
+                break;
+            }
+
             case Ld::ImageFormat::Rotation::ROTATE_CCW_90: {
                 currentPrescaledResolution.transpose();
-                transform = QTransform(0.0F, -1.0F, 1.0F, 0.0F, 0.0F, 0.0F);
+                currentPrescaledSizePixels.transpose();
+
+                currentOrientationTransform = QTransform(
+                    0.0F, -1.0F,
+                    1.0F, 0.0F,
+                    0.0F, unrotatedSizePixels.width()
+                );
+
                 break;
             }
 
             case Ld::ImageFormat::Rotation::ROTATE_CW_90: {
                 currentPrescaledResolution.transpose();
+                currentPrescaledSizePixels.transpose();
+
+                currentOrientationTransform = QTransform(
+                    0.0F, 1.0F,
+                    -1.0F, 0.0F,
+                    unrotatedSizePixels.height(), 0.0F
+                );
 
-                transform = QTransform(0.0F, 1.0F, -1.0F, 0.0F, 0.0F, 0.0F);
                 break;
             }
 
             case Ld::ImageFormat::Rotation::FLIP: {
-                transform = QTransform(-1.0F, 0.0F, 0.0F, -1.0F, 0.0F, 0.0F);
+                currentOrientationTransform = QTransform(
+                    -1.0F, 0.0F,
+                    0.0F, -1.0F,
+                    unrotatedSizePixels.width(), unrotatedSizePixels.height()
+                );
+
                 break;
             }
 
@@ -334,24 +396,16 @@ bool ImagePresentation::createGraphicsItem(
             }
         }
 
-        rotated = unrotated.transformed(transform);
-    } else {
-        rotated = unrotated;
+        validImage = true;
     }
 
-    EQt::GraphicsPixmapItem* graphicsPixmapItem = new EQt::GraphicsPixmapItem;
-    graphicsPixmapItem->setPixmap(rotated);
-
     if (validImage) {
         Ld::ImageFormat::ImageScalingMode horizontalScalingMode = horizontalAxisScaling.scalingMode();
         Ld::ImageFormat::ImageScalingMode verticalScalingMode   = verticalAxisScaling.scalingMode();
 
-        currentPrescaledSizePixels = rotated.size();
         QSizeF rawImageSizePoints = fromScene(currentPrescaledSizePixels);
 
-        QSizeF scalingFactor =   currentPrescaledResolution.isNull()
-                               ? defaultDotsPerPoint
-                               : currentPrescaledResolution;
+        QSizeF scalingFactor = effectiveDotsPerPoint(currentPrescaledResolution);
 
         QSizeF prescaledSizePoints(
             currentPrescaledSizePixels.width() / scalingFactor.width(),
@@ -450,6 +504,11 @@ float ImagePresentation::calculateScaleFactor(
 }
 
 
+QSizeF ImagePresentation::effectiveDotsPerPoint(const QSizeF& dotsPerPoint) {
+    return dotsPerPoint.isEmpty() ? defaultDotsPerPoint : dotsPerPoint;
+}
+
+
 bool ImagePresentation::loadAndAdjustImage() {
     QSharedPointer<Ld::ImageElement> imageElement = element();
     Q_ASSERT(!imageElement.isNull());
@@ -487,9 +546,68 @@ bool ImagePresentation::loadAndAdjustImage() {
 }
 
 
+void ImagePresentation::updatePixmap(const QSizeF& displayedSize, const QTransform& placementTransform) {
+    currentDisplayedSize      = displayedSize;
+    currentPlacementTransform = placementTransform;
+
+    ImagePyramidItem* graphicsPixmapItem = dynamic_cast<ImagePyramidItem*>(currentGraphicsItem);
+    Q_ASSERT(graphicsPixmapItem != Q_NULLPTR);
+
+    if (currentImage.isNull()) {
+        graphicsPixmapItem->setTransform(placementTransform);
+    } else {
+        QSize unrotatedSizePixels = currentImage->sizePixels();
+
+        if (currentImage->state() != ImageCache::State::DECODED) {
+            // Until the decode completes, we display a neutral placeholder stretched to the image's full size.
+
+            if (currentPixmapKey == 0) {
+                QPixmap placeholder(1, 1);
+                placeholder.fill(QColor(Qt::lightGray));
+
+                graphicsPixmapItem->setPixmap(placeholder);
+                currentPixmapKey = placeholder.cacheKey();
+            }
+
+            QTransform levelTransform = QTransform::fromScale(
+                unrotatedSizePixels.width(),
+                unrotatedSizePixels.height()
+            );
+
+            graphicsPixmapItem->setTransform(levelTransform * currentOrientationTransform * placementTransform);
+        } else {
+            // The pixmap sets the item's geometry.  The item selects the level it paints from the resolution of the
+            // device it is painted on.
+
+            QSizeF requiredSizePixels = displayedSize;
+            if (currentRotation == Ld::ImageFormat::Rotation::ROTATE_CCW_90 ||
+                currentRotation == Ld::ImageFormat::Rotation::ROTATE_CW_90     ) {
+                requiredSizePixels.transpose();
+            }
+
+            unsigned       level  = currentImage->levelForSize(requiredSizePixels);
+            const QPixmap& pixmap = currentImage->pixmap(level);
+
+            if (pixmap.cacheKey() != currentPixmapKey) {
+                graphicsPixmapItem->setPixmap(pixmap);
+                currentPixmapKey = pixmap.cacheKey();
+            }
+
+            QTransform levelTransform = QTransform::fromScale(
+                static_cast<double>(unrotatedSizePixels.width()) / pixmap.width(),
+                static_cast<double>(unrotatedSizePixels.height()) / pixmap.height()
+            );
+
+            graphicsPixmapItem->setTransform(levelTransform * currentOrientationTransform * placementTransform);
+        }
+    }
+}
+
+
 void ImagePresentation::clearGraphicsItem() {
     if (currentGraphicsItem != Q_NULLPTR) {
         currentGraphicsItem->deleteLater();
         currentGraphicsItem = Q_NULLPTR;
+        currentPixmapKey    = 0;
     }
 }
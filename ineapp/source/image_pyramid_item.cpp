@@ -0,0 +1,109 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref ImagePyramidItem class.
+***********************************************************************************************************************/
+
+#include <QSizeF>
+#include <QRectF>
+#include <QTransform>
+#include <QPixmap>
+#include <QImage>
+#include <QPainter>
+#include <QPaintDevice>
+#include <QPaintEngine>
+#include <QStyleOptionGraphicsItem>
+#include <QWidget>
+
+#include <cmath>
+
+#include <eqt_graphics_pixmap_item.h>
+
+#include "image_cache.h"
+#include "image_pyramid_item.h"
+
+ImagePyramidItem::ImagePyramidItem() {}
+
+
+ImagePyramidItem::~ImagePyramidItem() {}
+
+
+void ImagePyramidItem::setImage(ImageCache::ImagePointer image) {
+    currentImage = image;
+    update();
+}
+
+
+ImageCache::ImagePointer ImagePyramidItem::image() const {
+    return currentImage;
+}
+
+
+void ImagePyramidItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    const QPixmap& itemPixmap = pixmap();
+
+    if (currentImage.isNull() || currentImage->state() != ImageCache::State::DECODED || itemPixmap.isNull()) {
+        EQt::GraphicsPixmapItem::paint(painter, option, widget);
+    } else {
+        QRectF targetRectangle(offset(), QSizeF(itemPixmap.size()));
+
+        painter->save();
+        painter->setRenderHint(
+            QPainter::RenderHint::SmoothPixmapTransform,
+            transformationMode() == Qt::TransformationMode::SmoothTransformation
+        );
+
+        if (isPrintingDevice(painter->device())) {
+            const QImage& levelImage = currentImage->levelImage(0);
+            painter->drawImage(targetRectangle, levelImage, QRectF(levelImage.rect()));
+        } else {
+            // The item is in the orientation of the encoded image so the scale along each item axis gives the number
+            // of device pixels covered by the image along that axis.
+
+            QTransform deviceTransform = painter->deviceTransform();
+            double     xScale          = std::sqrt(
+                  deviceTransform.m11() * deviceTransform.m11()
+                + deviceTransform.m12() * deviceTransform.m12()
+            );
+            double     yScale          = std::sqrt(
+                  deviceTransform.m21() * deviceTransform.m21()
+                + deviceTransform.m22() * deviceTransform.m22()
+            );
+
+            QSizeF         requiredSizePixels(targetRectangle.width() * xScale, targetRectangle.height() * yScale);
+            unsigned       level       = currentImage->levelForSize(requiredSizePixels);
+            const QPixmap& levelPixmap = currentImage->pixmap(level);
+
+            painter->drawPixmap(targetRectangle, levelPixmap, QRectF(levelPixmap.rect()));
+        }
+
+        painter->restore();
+    }
+}
+
+
+bool ImagePyramidItem::isPrintingDevice(const QPaintDevice* device) {
+    bool result = false;
+
+    if (device != Q_NULLPTR) {
+        int devType = device->devType();
+        if (devType == QInternal::Printer || devType == QInternal::Picture) {
+            result = true;
+        } else {
+            QPaintEngine* engine = device->paintEngine();
+            if (engine != Q_NULLPTR) {
+                QPaintEngine::Type engineType = engine->type();
+                result = (
+                       engineType == QPaintEngine::Type::Pdf
+                    || engineType == QPaintEngine::Type::Picture
+                    || engineType == QPaintEngine::Type::User
+                );
+            }
+        }
+    }
+
+    return result;
+}
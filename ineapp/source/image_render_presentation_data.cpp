@@ -37,6 +37,7 @@
 #include <eqt_graphics_item_group.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "presentation.h"
 #include "plot_wrapped_presentation_data.h"
 #include "image_render_presentation_data.h"
@@ -202,7 +203,7 @@ void ImageRenderPresentationData::showErrorMessage(const QString& errorMessage)
     group->setBorderPen(QPen(Presentation::errorBorderColor));
 
     messageFont.setPointSizeF((messageFont.pointSizeF() - 2) * Application::fontScaleFactor());
-    QFontMetricsF messageFontMetrics(messageFont);
+    const QFontMetricsF& messageFontMetrics = FontMetricsCache::fontMetrics(messageFont);
     float messageWidth  = messageFontMetrics.horizontalAdvance(errorMessage);
     float messageAscent = messageFontMetrics.ascent();
     float messageHeight = messageFontMetrics.height();
@@ -0,0 +1,370 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref ImportLoader class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QStringList>
+#include <QSharedPointer>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <ld_element_structures.h>
+#include <ld_element.h>
+#include <ld_root_import.h>
+#include <ld_root_element.h>
+
+#include "application.h"
+#include "plug_in_manager.h"
+#include "import_loader.h"
+
+QMutex                                    ImportLoader::cacheMutex;
+QMap<QString, ImportLoader::Entry>        ImportLoader::entries;
+QMap<QString, ImportLoader::ImportRecord> ImportLoader::importRecords;
+unsigned long long                        ImportLoader::useCounter                  = 0;
+int                                       ImportLoader::currentMaximumCachedImports = defaultMaximumCachedImports;
+
+void ImportLoader::setMaximumCachedImports(int newMaximumCachedImports) {
+    QMutexLocker locker(&cacheMutex);
+
+    currentMaximumCachedImports = newMaximumCachedImports;
+    trimCache();
+}
+
+
+int ImportLoader::maximumCachedImports() {
+    return currentMaximumCachedImports;
+}
+
+
+QString ImportLoader::cacheKey(const QString& filename) {
+    QFileInfo fileInformation(filename);
+    QString   result = fileInformation.canonicalFilePath();
+
+    if (result.isEmpty()) {
+        result = fileInformation.absoluteFilePath();
+    }
+
+    return result;
+}
+
+
+QSharedPointer<Ld::RootElement> ImportLoader::cachedRootElement(const QString& filename) {
+    QString                         key    = cacheKey(filename);
+    QSharedPointer<Ld::RootElement> result = Ld::RootElement::byIdentifier(Ld::RootElement::identifier(key));
+
+    if (result.isNull()) {
+        QMutexLocker locker(&cacheMutex);
+        result = reuseEntry(key);
+    }
+
+    return result;
+}
+
+
+QSharedPointer<Ld::RootElement> ImportLoader::openImport(const QString& filename, QString* errorString) {
+    QSharedPointer<Ld::RootElement> result = cachedRootElement(filename);
+
+    if (result.isNull()) {
+        preloadImports(filename);
+
+        LoadJob job;
+        job.key           = cacheKey(filename);
+        job.plugInsByName = Application::plugInManager()->plugInsByName();
+
+        performLoad(job);
+
+        if (!job.rootElement.isNull()) {
+            result = job.rootElement;
+            Ld::RootElement::registerRootElement(result);
+            updateCache(result);
+        } else if (errorString != Q_NULLPTR) {
+            *errorString = job.errorString;
+        }
+    }
+
+    return result;
+}
+
+
+bool ImportLoader::preloadImports(const QString& filename) {
+    bool    success = true;
+    QString rootKey = cacheKey(filename);
+
+    // Assign each import that must be opened to a topological level.  Level 0 holds imports whose own imports are
+    // all available, level 1 holds imports that depend only on level 0 and available imports, and so on.  Imports
+    // that are still current are treated as available along with everything below them.
+
+    QMap<QString, unsigned>    levels;
+    QMap<QString, QStringList> importsByKey;
+    {
+        QMutexLocker locker(&cacheMutex);
+
+        QList<QString> pending = importRecords.value(rootKey).importKeys;
+        QSet<QString>  visited;
+
+        while (!pending.isEmpty()) {
+            QString key = pending.takeFirst();
+            if (!visited.contains(key)) {
+                visited.insert(key);
+
+                QSharedPointer<Ld::RootElement> registered = Ld::RootElement::byIdentifier(
+                    Ld::RootElement::identifier(key)
+                );
+
+                if (registered.isNull() && reuseEntry(key).isNull()) {
+                    QStringList importKeys = importRecords.value(key).importKeys;
+                    importsByKey.insert(key, importKeys);
+                    pending.append(importKeys);
+                }
+            }
+        }
+    }
+
+    // Longest path to an available import.  Iterate to a fixed point so that cycles, which Ld resolves itself, do not
+    // stall the computation.
+
+    for (  QMap<QString, QStringList>::const_iterator it  = importsByKey.constBegin(),
+                                                      end = importsByKey.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        levels.insert(it.key(), 0);
+    }
+
+    bool     changed       = true;
+    unsigned maximumLevel  = 0;
+    unsigned numberPasses  = 0;
+    unsigned maximumPasses = static_cast<unsigned>(importsByKey.size());
+    while (changed && numberPasses < maximumPasses) {
+        changed = false;
+        for (  QMap<QString, QStringList>::const_iterator it  = importsByKey.constBegin(),
+                                                          end = importsByKey.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            unsigned level = 0;
+            for (  QStringList::const_iterator importIterator    = it.value().constBegin(),
+                                               importEndIterator = it.value().constEnd()
+                 ; importIterator != importEndIterator
+                 ; ++importIterator
+                ) {
+                if (levels.contains(*importIterator)) {
+                    level = qMax(level, levels.value(*importIterator) + 1);
+                }
+            }
+
+            if (level != levels.value(it.key())) {
+                levels[it.key()] = level;
+                maximumLevel     = qMax(maximumLevel, level);
+                changed          = true;
+            }
+        }
+
+        ++numberPasses;
+    }
+
+    if (!levels.isEmpty()) {
+        Ld::PlugInsByName plugInsByName = Application::plugInManager()->plugInsByName();
+
+        for (unsigned level=0 ; level<=maximumLevel ; ++level) {
+            for (  QMap<QString, unsigned>::const_iterator it = levels.constBegin(), end = levels.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                // A file opened by Ld while parsing an earlier import at this level is already registered.
+
+                QString key = it.key();
+                if (it.value() == level && Ld::RootElement::byIdentifier(Ld::RootElement::identifier(key)).isNull()) {
+                    LoadJob job;
+                    job.key           = key;
+                    job.plugInsByName = plugInsByName;
+
+                    performLoad(job);
+
+                    if (!job.rootElement.isNull()) {
+                        Ld::RootElement::registerRootElement(job.rootElement);
+
+                        QMutexLocker locker(&cacheMutex);
+                        recordEntry(job.rootElement);
+                    } else {
+                        success = false;
+                    }
+                }
+            }
+        }
+
+        QMutexLocker locker(&cacheMutex);
+        trimCache();
+    }
+
+    return success;
+}
+
+
+QSharedPointer<Ld::RootElement> ImportLoader::loadDocument(
+        const QString&           filename,
+        const Ld::PlugInsByName& plugInsByName,
+        QString*                 errorString
+    ) {
+    preloadImports(filename);
+
+    LoadJob job;
+    job.key           = cacheKey(filename);
+    job.plugInsByName = plugInsByName;
+
+    performLoad(job);
+
+    if (job.rootElement.isNull() && errorString != Q_NULLPTR) {
+        *errorString = job.errorString;
+    }
+
+    return job.rootElement;
+}
+
+
+void ImportLoader::updateCache(QSharedPointer<Ld::RootElement> rootElement) {
+    QMutexLocker locker(&cacheMutex);
+
+    recordEntry(rootElement);
+
+    Ld::RootElement::RootElementList allDependencies = rootElement->allDependencies();
+    for (  Ld::RootElement::RootElementList::const_iterator it  = allDependencies.constBegin(),
+                                                            end = allDependencies.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        recordEntry(*it);
+    }
+
+    trimCache();
+}
+
+
+void ImportLoader::invalidate(const QString& filename) {
+    QMutexLocker locker(&cacheMutex);
+    entries.remove(cacheKey(filename));
+}
+
+
+void ImportLoader::clear() {
+    QMutexLocker locker(&cacheMutex);
+    entries.clear();
+    importRecords.clear();
+}
+
+
+void ImportLoader::performLoad(ImportLoader::LoadJob& job) {
+    QSharedPointer<Ld::RootElement> rootElement = Ld::Element::create(Ld::RootElement::elementName)
+                                                  .dynamicCast<Ld::RootElement>();
+
+    bool success = rootElement->openExisting(job.key, false, job.plugInsByName);
+    if (success) {
+        job.rootElement = rootElement;
+    } else {
+        job.errorString = rootElement->errorString();
+    }
+}
+
+
+bool ImportLoader::entryIsCurrent(const QString& key) {
+    bool result = false;
+
+    QMap<QString, Entry>::const_iterator it = entries.constFind(key);
+    if (it != entries.constEnd()) {
+        QFileInfo fileInformation(key);
+        result = fileInformation.exists() && fileInformation.lastModified() == it.value().lastModified;
+    }
+
+    return result;
+}
+
+
+QSharedPointer<Ld::RootElement> ImportLoader::reuseEntry(const QString& key) {
+    QSharedPointer<Ld::RootElement> result;
+
+    if (entryIsCurrent(key)) {
+        Entry& entry = entries[key];
+
+        if (entry.rootElement->openMode() != Ld::RootElement::OpenMode::CLOSED && !entry.rootElement->isModified()) {
+            result         = entry.rootElement;
+            entry.lastUsed = ++useCounter;
+
+            Ld::RootElement::registerRootElement(result);
+        } else {
+            entries.remove(key);
+        }
+    }
+
+    return result;
+}
+
+
+bool ImportLoader::importsAreCurrent(const QString& key) {
+    bool result = false;
+
+    QMap<QString, ImportRecord>::const_iterator it = importRecords.constFind(key);
+    if (it != importRecords.constEnd()) {
+        QFileInfo fileInformation(key);
+        result = fileInformation.exists() && fileInformation.lastModified() == it.value().lastModified;
+    }
+
+    return result;
+}
+
+
+void ImportLoader::recordEntry(QSharedPointer<Ld::RootElement> rootElement) {
+    QString filename = rootElement->filename();
+    if (!filename.isEmpty()) {
+        QString key = cacheKey(filename);
+
+        Entry entry;
+        entry.lastModified = QFileInfo(key).lastModified();
+        entry.rootElement  = rootElement;
+        entry.lastUsed     = ++useCounter;
+
+        ImportRecord record;
+        record.lastModified = entry.lastModified;
+
+        QList<Ld::RootImport> imports = rootElement->imports();
+        for (QList<Ld::RootImport>::const_iterator it=imports.constBegin(),end=imports.constEnd() ; it!=end ; ++it) {
+            if (!it->isInvalid() && it->hasFilename()) {
+                record.importKeys.append(cacheKey(it->absolutePath()));
+            }
+        }
+
+        entries.insert(key, entry);
+        importRecords.insert(key, record);
+    }
+}
+
+
+void ImportLoader::trimCache() {
+    // Only entries that are no longer registered count against the limit.  Registered entries are in use and cost
+    // nothing extra to retain.
+
+    QMap<unsigned long long, QString> unregisteredByUse;
+    for (QMap<QString, Entry>::const_iterator it=entries.constBegin(),end=entries.constEnd() ; it!=end ; ++it) {
+        QSharedPointer<Ld::RootElement> registered = Ld::RootElement::byIdentifier(
+            Ld::RootElement::identifier(it.key())
+        );
+
+        if (registered.isNull()) {
+            unregisteredByUse.insert(it.value().lastUsed, it.key());
+        }
+    }
+
+    while (unregisteredByUse.size() > currentMaximumCachedImports) {
+        entries.remove(unregisteredByUse.first());
+        unregisteredByUse.remove(unregisteredByUse.firstKey());
+    }
+}
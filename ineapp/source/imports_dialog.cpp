@@ -38,7 +38,7 @@
 
 #include "document.h"
 #include "application.h"
-#include "plug_in_manager.h"
+#include "import_loader.h"
 #include "document_file_dialog.h"
 #include "imports_model.h"
 #include "imports_delegate.h"
@@ -190,18 +190,9 @@ void ImportsDialog::addImportsMenuItemTriggered(QAction* action) {
             QString filename   = fileDialog->selectedFiles().at(0);
             QString identifier = Ld::RootElement::identifier(filename);
 
-            rootElement = Ld::RootElement::byIdentifier(identifier);
+            rootElement = ImportLoader::openImport(filename);
             if (rootElement.isNull()) {
-                rootElement = Ld::Element::createElement<Ld::RootElement>();
-                Ld::RootElement::registerRootElement(rootElement);
-
-                Ld::PlugInsByName plugInsByName = Application::plugInManager()->plugInsByName();
-                bool success = rootElement->openExisting(filename, false, plugInsByName);
-
-                if (!success) {
-                    rootElement.clear();
-                    failedToOpen(identifier);
-                }
+                failedToOpen(identifier);
             }
         }
     } else {
@@ -25,7 +25,7 @@
 
 #include "metatypes.h"
 #include "application.h"
-#include "plug_in_manager.h"
+#include "import_loader.h"
 #include "imports_model.h"
 
 
@@ -238,10 +238,8 @@ bool ImportsModel::setData(const QModelIndex& index, const QVariant& value, int
             if (!rootElement.isNull()) {
                 result = true;
             } else {
-                Ld::PlugInsByName plugInsByName = Application::plugInManager()->plugInsByName();
-
-                rootElement = Ld::Element::createElement<Ld::RootElement>();
-                result      = rootElement->openExisting(stringValue, false, plugInsByName);
+                rootElement = ImportLoader::openImport(stringValue);
+                result      = !rootElement.isNull();
 
                 if (result == false) {
                     emit failedToAccess(identifier);
@@ -0,0 +1,90 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref InspectorCellCache class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QCache>
+#include <QSet>
+
+#include <util_hash_functions.h>
+
+#include "inspector_cell_cache.h"
+
+InspectorCellCache::Key::Key(unsigned long newRowIndex, unsigned long newColumnIndex, unsigned newFormat) {
+    rowIndex    = newRowIndex;
+    columnIndex = newColumnIndex;
+    format      = newFormat;
+}
+
+
+bool InspectorCellCache::Key::operator==(const InspectorCellCache::Key& other) const {
+    return rowIndex == other.rowIndex && columnIndex == other.columnIndex && format == other.format;
+}
+
+
+InspectorCellCache::InspectorCellCache(int maximumNumberEntries):cache(maximumNumberEntries) {}
+
+
+InspectorCellCache::~InspectorCellCache() {}
+
+
+void InspectorCellCache::setMaximumNumberEntries(int newMaximumNumberEntries) {
+    cache.setMaxCost(newMaximumNumberEntries);
+}
+
+
+int InspectorCellCache::maximumNumberEntries() const {
+    return cache.maxCost();
+}
+
+
+bool InspectorCellCache::lookup(
+        unsigned long rowIndex,
+        unsigned long columnIndex,
+        unsigned      format,
+        QString&      text
+    ) const {
+    bool           found  = false;
+    const QString* cached = cache.object(Key(rowIndex, columnIndex, format));
+
+    if (cached != Q_NULLPTR) {
+        text  = *cached;
+        found = true;
+    }
+
+    return found;
+}
+
+
+void InspectorCellCache::insert(
+        unsigned long  rowIndex,
+        unsigned long  columnIndex,
+        unsigned       format,
+        const QString& text
+    ) {
+    formats.insert(format);
+    cache.insert(Key(rowIndex, columnIndex, format), new QString(text), 1);
+}
+
+
+void InspectorCellCache::invalidate(unsigned long rowIndex, unsigned long columnIndex) {
+    for (QSet<unsigned>::const_iterator it=formats.constBegin(),end=formats.constEnd() ; it!=end ; ++it) {
+        cache.remove(Key(rowIndex, columnIndex, *it));
+    }
+}
+
+
+void InspectorCellCache::clear() {
+    cache.clear();
+    formats.clear();
+}
+
+
+int InspectorCellCache::size() const {
+    return cache.size();
+}
@@ -0,0 +1,563 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref LatencyTracer class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QRect>
+#include <QRectF>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QGraphicsView>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFile>
+
+#include <algorithm>
+#include <cmath>
+
+#include "root_presentation.h"
+#include "document.h"
+#include "latency_tracer.h"
+
+/***********************************************************************************************************************
+ * Tracer state:
+ */
+
+namespace {
+    /**
+     * Value used to mark a timestamp that has not been recorded.
+     */
+    constexpr unsigned long long unsetTimestamp = ~0ULL;
+
+    /**
+     * Class that tracks a single input event until it is displayed.
+     */
+    class Trace {
+        public:
+            /**
+             * The time of the input event, in nanoseconds.
+             */
+            unsigned long long inputNanoseconds;
+
+            /**
+             * The time command execution completed, in nanoseconds.
+             */
+            unsigned long long commandNanoseconds;
+
+            /**
+             * The time the first repositioning pass started, in nanoseconds.
+             */
+            unsigned long long placementStartNanoseconds;
+
+            /**
+             * The time the last repositioning pass completed, in nanoseconds.
+             */
+            unsigned long long placementEndNanoseconds;
+    };
+
+    /**
+     * Class that holds the samples for a single stage.
+     */
+    class StageSamples {
+        public:
+            StageSamples():histogram(LatencyTracer::numberHistogramBuckets, 0) {
+                nextWindowIndex    = 0;
+                numberSamples      = 0;
+                maximumNanoseconds = 0;
+            }
+
+            /**
+             * Method that adds a sample.
+             *
+             * \param[in] nanoseconds The sample, in nanoseconds.
+             */
+            void add(unsigned long long nanoseconds) {
+                if (static_cast<unsigned>(window.size()) < LatencyTracer::rollingWindowSize) {
+                    window.append(nanoseconds);
+                } else {
+                    window[nextWindowIndex] = nanoseconds;
+                }
+
+                nextWindowIndex = (nextWindowIndex + 1) % LatencyTracer::rollingWindowSize;
+
+                unsigned long long microseconds = nanoseconds / 1000;
+                unsigned           bucket       = 0;
+                while (bucket + 1 < LatencyTracer::numberHistogramBuckets && microseconds >= (1ULL << bucket)) {
+                    ++bucket;
+                }
+
+                ++histogram[bucket];
+                ++numberSamples;
+                maximumNanoseconds = std::max(maximumNanoseconds, nanoseconds);
+            }
+
+            /**
+             * Method that calculates a percentile over the rolling window.
+             *
+             * \param[in] value The percentile, from 0 to 100.
+             *
+             * \return Returns the sample at the percentile.
+             */
+            unsigned long long percentile(double value) const {
+                unsigned long long result = 0;
+
+                if (!window.isEmpty()) {
+                    QVector<unsigned long long> sorted = window;
+                    std::sort(sorted.begin(), sorted.end());
+
+                    double clamped = std::min(100.0, std::max(0.0, value));
+                    int    index   = static_cast<int>(std::ceil(clamped / 100.0 * sorted.size())) - 1;
+
+                    result = sorted.at(std::max(0, index));
+                }
+
+                return result;
+            }
+
+            /**
+             * The most recent samples.
+             */
+            QVector<unsigned long long> window;
+
+            /**
+             * Index of the window entry to be replaced next.
+             */
+            unsigned nextWindowIndex;
+
+            /**
+             * Histogram of every sample.
+             */
+            QVector<unsigned long long> histogram;
+
+            /**
+             * The total number of samples.
+             */
+            unsigned long long numberSamples;
+
+            /**
+             * The largest sample.
+             */
+            unsigned long long maximumNanoseconds;
+    };
+
+    /**
+     * Class that holds the traces for a single document.
+     */
+    class DocumentTraces {
+        public:
+            DocumentTraces():stages(static_cast<int>(LatencyTracer::Stage::NUMBER_STAGES)) {
+                numberTraces          = 0;
+                numberAbandonedTraces = 0;
+            }
+
+            /**
+             * The document name.
+             */
+            QString name;
+
+            /**
+             * Traces awaiting a paint.
+             */
+            QList<Trace> pending;
+
+            /**
+             * Samples, by stage.
+             */
+            QVector<StageSamples> stages;
+
+            /**
+             * The number of completed traces.
+             */
+            unsigned long long numberTraces;
+
+            /**
+             * The number of traces abandoned because too many were pending.
+             */
+            unsigned long long numberAbandonedTraces;
+    };
+
+    /**
+     * Mutex used to protect the collected data.
+     */
+    QMutex tracerMutex;
+
+    /**
+     * Timer used to timestamp events.  The timer is started the first time the tracer is enabled.
+     */
+    QElapsedTimer tracerTimer;
+
+    /**
+     * Traces for open documents.
+     */
+    QHash<const RootPresentation*, DocumentTraces> openDocuments;
+
+    /**
+     * Traces for documents that have been closed.
+     */
+    QList<DocumentTraces> closedDocuments;
+
+    /**
+     * Function that returns the name used to report a stage.
+     *
+     * \param[in] stage The stage of interest.
+     *
+     * \return Returns the stage name.
+     */
+    QString stageName(LatencyTracer::Stage stage) {
+        QString result;
+
+        switch (stage) {
+            case LatencyTracer::Stage::INPUT_TO_COMMAND:     { result = QString("input_to_command");     break; }
+            case LatencyTracer::Stage::COMMAND_TO_PLACEMENT: { result = QString("command_to_placement"); break; }
+            case LatencyTracer::Stage::PLACEMENT:            { result = QString("placement");            break; }
+            case LatencyTracer::Stage::PLACEMENT_TO_PAINT:   { result = QString("placement_to_paint");   break; }
+            case LatencyTracer::Stage::INPUT_TO_PAINT:       { result = QString("input_to_paint");       break; }
+
+            default: {
+                Q_ASSERT(false);
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * Function that records the samples for a completed trace.
+     *
+     * \param[in] traces           The document traces.
+     *
+     * \param[in] trace            The completed trace.
+     *
+     * \param[in] paintNanoseconds The time of the paint.
+     */
+    void recordTrace(DocumentTraces& traces, const Trace& trace, unsigned long long paintNanoseconds) {
+        unsigned long long placementReadyNanoseconds = trace.inputNanoseconds;
+
+        if (trace.commandNanoseconds != unsetTimestamp) {
+            traces.stages[static_cast<int>(LatencyTracer::Stage::INPUT_TO_COMMAND)].add(
+                trace.commandNanoseconds - trace.inputNanoseconds
+            );
+
+            placementReadyNanoseconds = trace.commandNanoseconds;
+        }
+
+        unsigned long long paintReadyNanoseconds = placementReadyNanoseconds;
+        if (trace.placementStartNanoseconds != unsetTimestamp && trace.placementEndNanoseconds != unsetTimestamp) {
+            traces.stages[static_cast<int>(LatencyTracer::Stage::COMMAND_TO_PLACEMENT)].add(
+                trace.placementStartNanoseconds - std::min(placementReadyNanoseconds, trace.placementStartNanoseconds)
+            );
+            traces.stages[static_cast<int>(LatencyTracer::Stage::PLACEMENT)].add(
+                trace.placementEndNanoseconds - trace.placementStartNanoseconds
+            );
+
+            paintReadyNanoseconds = trace.placementEndNanoseconds;
+        }
+
+        traces.stages[static_cast<int>(LatencyTracer::Stage::PLACEMENT_TO_PAINT)].add(
+            paintNanoseconds - paintReadyNanoseconds
+        );
+        traces.stages[static_cast<int>(LatencyTracer::Stage::INPUT_TO_PAINT)].add(
+            paintNanoseconds - trace.inputNanoseconds
+        );
+
+        ++traces.numberTraces;
+    }
+
+    /**
+     * Function that converts the traces for a document to a JSON object.
+     *
+     * \param[in] traces The traces to be converted.
+     *
+     * \param[in] isOpen If true, the document is still open.
+     *
+     * \return Returns a JSON object.
+     */
+    QJsonObject toJson(const DocumentTraces& traces, bool isOpen) {
+        QJsonObject stageObject;
+
+        for (unsigned stageIndex=0 ; stageIndex<static_cast<unsigned>(traces.stages.size()) ; ++stageIndex) {
+            const StageSamples& samples = traces.stages.at(stageIndex);
+
+            QJsonArray histogramArray;
+            for (unsigned bucket=0 ; bucket<LatencyTracer::numberHistogramBuckets ; ++bucket) {
+                QJsonObject bucketObject;
+                if (bucket + 1 < LatencyTracer::numberHistogramBuckets) {
+                    bucketObject.insert("below_us", static_cast<double>(1ULL << bucket));
+                }
+
+                bucketObject.insert("count", static_cast<double>(samples.histogram.at(bucket)));
+                histogramArray.append(bucketObject);
+            }
+
+            QJsonObject samplesObject;
+            samplesObject.insert("samples", static_cast<double>(samples.numberSamples));
+            samplesObject.insert("p50_ns", static_cast<double>(samples.percentile(50)));
+            samplesObject.insert("p90_ns", static_cast<double>(samples.percentile(90)));
+            samplesObject.insert("p99_ns", static_cast<double>(samples.percentile(99)));
+            samplesObject.insert("max_ns", static_cast<double>(samples.maximumNanoseconds));
+            samplesObject.insert("histogram", histogramArray);
+
+            stageObject.insert(stageName(static_cast<LatencyTracer::Stage>(stageIndex)), samplesObject);
+        }
+
+        QJsonObject result;
+        result.insert("name", traces.name);
+        result.insert("open", isOpen);
+        result.insert("traces", static_cast<double>(traces.numberTraces));
+        result.insert("abandoned_traces", static_cast<double>(traces.numberAbandonedTraces));
+        result.insert("stages", stageObject);
+
+        return result;
+    }
+}
+
+/***********************************************************************************************************************
+ * LatencyTracer
+ */
+
+bool LatencyTracer::currentEnabled = false;
+
+void LatencyTracer::setEnabled(bool nowEnabled) {
+    QMutexLocker locker(&tracerMutex);
+
+    if (nowEnabled && !tracerTimer.isValid()) {
+        tracerTimer.start();
+    }
+
+    for (  QHash<const RootPresentation*, DocumentTraces>::iterator it = openDocuments.begin(),
+                                                                     end = openDocuments.end()
+         ; it != end
+         ; ++it
+        ) {
+        it.value().pending.clear();
+    }
+
+    currentEnabled = nowEnabled;
+}
+
+
+void LatencyTracer::reset() {
+    QMutexLocker locker(&tracerMutex);
+
+    openDocuments.clear();
+    closedDocuments.clear();
+}
+
+
+unsigned long long LatencyTracer::numberTraces(const RootPresentation* rootPresentation) {
+    QMutexLocker locker(&tracerMutex);
+    return openDocuments.value(rootPresentation).numberTraces;
+}
+
+
+unsigned long long LatencyTracer::percentileNanoseconds(
+        const RootPresentation* rootPresentation,
+        LatencyTracer::Stage    stage,
+        double                  percentile
+    ) {
+    QMutexLocker locker(&tracerMutex);
+
+    unsigned long long                                             result = 0;
+    QHash<const RootPresentation*, DocumentTraces>::const_iterator it     = openDocuments.constFind(rootPresentation);
+    if (it != openDocuments.constEnd()) {
+        result = it.value().stages.at(static_cast<int>(stage)).percentile(percentile);
+    }
+
+    return result;
+}
+
+
+bool LatencyTracer::writeReport(const QString& filename) {
+    QJsonArray documentArray;
+
+    {
+        QMutexLocker locker(&tracerMutex);
+
+        for (  QList<DocumentTraces>::const_iterator it = closedDocuments.constBegin(), end = closedDocuments.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            documentArray.append(toJson(*it, false));
+        }
+
+        for (  QHash<const RootPresentation*, DocumentTraces>::const_iterator it  = openDocuments.constBegin(),
+                                                                           end = openDocuments.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            documentArray.append(toJson(it.value(), true));
+        }
+    }
+
+    QJsonObject rootObject;
+    rootObject.insert("rolling_window", static_cast<double>(rollingWindowSize));
+    rootObject.insert("documents", documentArray);
+
+    QFile reportFile(filename);
+    bool  success = reportFile.open(QFile::WriteOnly | QFile::Truncate);
+    if (success) {
+        QByteArray json = QJsonDocument(rootObject).toJson(QJsonDocument::Indented);
+        success = (reportFile.write(json) == json.size());
+        reportFile.close();
+    }
+
+    return success;
+}
+
+
+void LatencyTracer::recordInputReceived(const RootPresentation* rootPresentation) {
+    const Document* document = dynamic_cast<const Document*>(rootPresentation);
+    QString         name     = document != Q_NULLPTR ? document->shortformName() : QString();
+
+    QMutexLocker locker(&tracerMutex);
+
+    DocumentTraces& traces = openDocuments[rootPresentation];
+    if (!name.isEmpty()) {
+        traces.name = name;
+    }
+
+    if (static_cast<unsigned>(traces.pending.size()) >= maximumPendingTraces) {
+        traces.pending.removeFirst();
+        ++traces.numberAbandonedTraces;
+    }
+
+    Trace trace;
+    trace.inputNanoseconds          = static_cast<unsigned long long>(tracerTimer.nsecsElapsed());
+    trace.commandNanoseconds        = unsetTimestamp;
+    trace.placementStartNanoseconds = unsetTimestamp;
+    trace.placementEndNanoseconds   = unsetTimestamp;
+
+    traces.pending.append(trace);
+}
+
+
+void LatencyTracer::recordCommandExecuted(const RootPresentation* rootPresentation) {
+    QMutexLocker locker(&tracerMutex);
+
+    QHash<const RootPresentation*, DocumentTraces>::iterator documentIterator = openDocuments.find(rootPresentation);
+    if (documentIterator != openDocuments.end()) {
+        unsigned long long now = static_cast<unsigned long long>(tracerTimer.nsecsElapsed());
+
+        QList<Trace>& pending = documentIterator.value().pending;
+        for (QList<Trace>::iterator it=pending.begin(),end=pending.end() ; it!=end ; ++it) {
+            if (it->commandNanoseconds == unsetTimestamp && it->placementStartNanoseconds == unsetTimestamp) {
+                it->commandNanoseconds = now;
+            }
+        }
+    }
+}
+
+
+void LatencyTracer::recordPlacementStarted(const RootPresentation* rootPresentation) {
+    QMutexLocker locker(&tracerMutex);
+
+    QHash<const RootPresentation*, DocumentTraces>::iterator documentIterator = openDocuments.find(rootPresentation);
+    if (documentIterator != openDocuments.end()) {
+        unsigned long long now = static_cast<unsigned long long>(tracerTimer.nsecsElapsed());
+
+        QList<Trace>& pending = documentIterator.value().pending;
+        for (QList<Trace>::iterator it=pending.begin(),end=pending.end() ; it!=end ; ++it) {
+            if (it->placementStartNanoseconds == unsetTimestamp) {
+                it->placementStartNanoseconds = now;
+            }
+        }
+    }
+}
+
+
+void LatencyTracer::recordPlacementCompleted(const RootPresentation* rootPresentation) {
+    QMutexLocker locker(&tracerMutex);
+
+    QHash<const RootPresentation*, DocumentTraces>::iterator documentIterator = openDocuments.find(rootPresentation);
+    if (documentIterator != openDocuments.end()) {
+        unsigned long long now = static_cast<unsigned long long>(tracerTimer.nsecsElapsed());
+
+        // Repositioning may take several passes.  The placement of a trace ends with the last pass.
+
+        QList<Trace>& pending = documentIterator.value().pending;
+        for (QList<Trace>::iterator it=pending.begin(),end=pending.end() ; it!=end ; ++it) {
+            if (it->placementStartNanoseconds != unsetTimestamp) {
+                it->placementEndNanoseconds = now;
+            }
+        }
+    }
+}
+
+
+void LatencyTracer::recordPaintCompleted(
+        const RootPresentation* rootPresentation,
+        const QGraphicsView*    view,
+        const QRect&            paintedRectangle,
+        const QRectF&           affectedSceneRectangle
+    ) {
+    bool covered = (
+           affectedSceneRectangle.isEmpty()
+        || view->mapToScene(paintedRectangle).boundingRect().intersects(affectedSceneRectangle)
+    );
+
+    if (covered) {
+        bool placementIdle = (
+               rootPresentation->isDisplayCoherent()
+            && !rootPresentation->arePresentationUpdatesPending()
+        );
+
+        QMutexLocker locker(&tracerMutex);
+
+        QHash<const RootPresentation*, DocumentTraces>::iterator documentIterator = openDocuments.find(
+            rootPresentation
+        );
+
+        if (documentIterator != openDocuments.end()) {
+            unsigned long long now    = static_cast<unsigned long long>(tracerTimer.nsecsElapsed());
+            DocumentTraces&    traces = documentIterator.value();
+
+            // A trace is displayed once its placement has completed.  Traces that never required placement, either
+            // because no command was issued or because the command left the layout untouched, are displayed by the
+            // first covering paint.
+
+            QList<Trace>::iterator it = traces.pending.begin();
+            while (it != traces.pending.end()) {
+                bool displayed;
+                if (it->placementStartNanoseconds != unsetTimestamp) {
+                    displayed = (it->placementEndNanoseconds != unsetTimestamp && placementIdle);
+                } else {
+                    displayed = (it->commandNanoseconds == unsetTimestamp || placementIdle);
+                }
+
+                if (displayed) {
+                    recordTrace(traces, *it, now);
+                    it = traces.pending.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+}
+
+
+void LatencyTracer::recordDocumentClosed(const RootPresentation* rootPresentation) {
+    QMutexLocker locker(&tracerMutex);
+
+    QHash<const RootPresentation*, DocumentTraces>::iterator it = openDocuments.find(rootPresentation);
+    if (it != openDocuments.end()) {
+        DocumentTraces& traces = it.value();
+        if (traces.numberTraces > 0) {
+            traces.pending.clear();
+            closedDocuments.append(traces);
+        }
+
+        openDocuments.erase(it);
+    }
+}
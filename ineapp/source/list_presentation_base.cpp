@@ -40,14 +40,20 @@
 #include <ld_element_cursor.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
 #include "presentation_with_positional_children.h"
 #include "presentation_area_tracker.h"
 #include "list_presentation_base.h"
 
 ListPresentationBase::ListPresentationBase() {
-    currentGraphicsItem = Q_NULLPTR;
+    currentGraphicsItem              = Q_NULLPTR;
+    currentSelfRepositioningPending  = true;
+    currentChildRepositioningPending = false;
+    committedMinimumTopSpacing       = 0.0F;
+    committedRelativeScale           = 0.0F;
 }
 
 
@@ -56,7 +62,13 @@ ListPresentationBase::~ListPresentationBase() {
 }
 
 
-void ListPresentationBase::requestRepositioning(Presentation* /* childPresentation */) {
+void ListPresentationBase::requestRepositioning(Presentation* childPresentation) {
+    if (childPresentation == this || childPresentation == Q_NULLPTR) {
+        currentSelfRepositioningPending = true;
+    } else {
+        currentChildRepositioningPending = true;
+    }
+
     Ld::ElementPointer element = ListPresentationBase::element();
     if (!element.isNull()) {
         Ld::ElementPointer parent = element->parent();
@@ -70,6 +82,11 @@ void ListPresentationBase::requestRepositioning(Presentation* /* childPresentati
 }
 
 
+void ListPresentationBase::flagPendingRepositioning() {
+    currentSelfRepositioningPending = true;
+}
+
+
 void ListPresentationBase::recalculatePlacement(
         PlacementTracker*    placementTracker,
         PlacementNegotiator* parent,
@@ -92,87 +109,96 @@ void ListPresentationBase::recalculatePlacement(
 
     (void) populatePresentationAreaTrackers(placementTracker, minimumTopSpacing, relativeScale);
 
-    QFont   font            = format->toQFont();
-    QColor  color           = format->fontColor();
-    QColor  backgroundColor = format->fontBackgroundColor();
-    float   fontPointSize   = font.pointSizeF();
-    float   fontScaleFactor = Application::fontScaleFactor();
+    // If every child reports the same layout as before, our size and ascent are unchanged.  We only move the
+    // children back into position and our parent will, in turn, find that our layout is unchanged.
 
-    if (fontScaleFactor != 1.0F || relativeScale != 1.0F) {
-        font.setPointSizeF(fontPointSize * fontScaleFactor * relativeScale);
-    }
-
-    QPen   fontPen(color.isValid() ? color : QColor(Qt::black));
-    QBrush fontBackgroundBrush(backgroundColor.isValid() ? backgroundColor : QColor(255, 255, 255, 0));
+    if (restoreCommittedPlacement(minimumTopSpacing, relativeScale)) {
+        currentSelfRepositioningPending  = false;
+        currentChildRepositioningPending = false;
 
-    QString                                  separator  = separatorCharacters();
-    EQt::GraphicsMathGroup::ParenthesisStyle parenStyle = parenthesisStyle();
+        allocateSpaceForThisPresentation(parent, childIdentifier, committedSize, requiredAscent);
+    } else {
+        QFont   font            = format->toQFont();
+        QColor  color           = format->fontColor();
+        QColor  backgroundColor = format->fontBackgroundColor();
+        float   fontPointSize   = font.pointSizeF();
+        float   fontScaleFactor = Application::fontScaleFactor();
+
+        if (fontScaleFactor != 1.0F || relativeScale != 1.0F) {
+            font.setPointSizeF(fontPointSize * fontScaleFactor * relativeScale);
+        }
 
-    QFontMetricsF fontMetrics(font);
-    float fontHeight       = fontMetrics.height();
-    float fontAscent       = fontMetrics.ascent();
-    float separatorWidth   = fontMetrics.horizontalAdvance(separator);
+        QPen   fontPen(color.isValid() ? color : QColor(Qt::black));
+        QBrush fontBackgroundBrush(backgroundColor.isValid() ? backgroundColor : QColor(255, 255, 255, 0));
 
-    float maximumAscent  = fontAscent;
-    float maximumDescent = fontHeight - fontAscent;
+        QString                                  separator  = separatorCharacters();
+        EQt::GraphicsMathGroup::ParenthesisStyle parenStyle = parenthesisStyle();
 
-    calculateMaximumPresentationAreaAscentAndDescent(maximumAscent, maximumDescent);
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+        float fontHeight       = fontMetrics.height();
+        float fontAscent       = fontMetrics.ascent();
+        float separatorWidth   = fontMetrics.horizontalAdvance(separator);
 
-    float maximumHeight = maximumAscent + maximumDescent;
+        float maximumAscent  = fontAscent;
+        float maximumDescent = fontHeight - fontAscent;
 
-    ParenthesisData leftParenthesisData  = leftParenthesisSize(font, maximumHeight, parenStyle);
-    ParenthesisData rightParenthesisData = rightParenthesisSize(font, maximumHeight, parenStyle);
+        calculateMaximumPresentationAreaAscentAndDescent(maximumAscent, maximumDescent);
 
-    if (currentGraphicsItem == Q_NULLPTR) {
-        currentGraphicsItem = new EQt::GraphicsMathGroup;
-    } else {
-        currentGraphicsItem->clearText();
-    }
+        float maximumHeight = maximumAscent + maximumDescent;
 
-    currentGraphicsItem->setTextPen(fontPen);
-    currentGraphicsItem->setBackgroundBrush(fontBackgroundBrush);
+        ParenthesisData leftParenthesisData  = leftParenthesisSize(font, maximumHeight, parenStyle);
+        ParenthesisData rightParenthesisData = rightParenthesisSize(font, maximumHeight, parenStyle);
 
-    unsigned long numberChildren = element()->numberChildren();
-    float         currentX       = leftParenthesisData.width();
-    for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
-        if (childIndex > 0 && listElement->child(childIndex)->typeName() != Ld::ListPlaceholderElement::elementName) {
-            currentGraphicsItem->append(separator, font, QPointF(currentX, maximumAscent));
-            currentX += separatorWidth;
+        if (currentGraphicsItem == Q_NULLPTR) {
+            currentGraphicsItem = new EQt::GraphicsMathGroup;
+        } else {
+            currentGraphicsItem->clearText();
         }
 
-        const PresentationAreaTracker& presentationAreas       = childPresentationAreas.at(childIndex);
-        unsigned long                  numberPresentationAreas = presentationAreas.numberPresentationAreas();
+        currentGraphicsItem->setTextPen(fontPen);
+        currentGraphicsItem->setBackgroundBrush(fontBackgroundBrush);
+
+        unsigned long numberChildren = element()->numberChildren();
+        float         currentX       = leftParenthesisData.width();
+        for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+            if (childIndex > 0                                                                          &&
+                listElement->child(childIndex)->typeName() != Ld::ListPlaceholderElement::elementName    ) {
+                currentGraphicsItem->append(separator, font, QPointF(currentX, maximumAscent));
+                currentX += separatorWidth;
+            }
 
-        for (unsigned long areaIndex=0 ; areaIndex<numberPresentationAreas ; ++areaIndex) {
-            const PresentationAreaTracker::Entry& entry        = presentationAreas.entry(areaIndex);
-            QGraphicsItem*                        graphicsItem = entry.graphicsItem();
+            const PresentationAreaTracker& presentationAreas       = childPresentationAreas.at(childIndex);
+            unsigned long                  numberPresentationAreas = presentationAreas.numberPresentationAreas();
 
-            currentGraphicsItem->addToGroup(graphicsItem);
-            graphicsItem->setPos(currentX, minimumTopSpacing + maximumAscent - entry.ascent());
+            for (unsigned long areaIndex=0 ; areaIndex<numberPresentationAreas ; ++areaIndex) {
+                const PresentationAreaTracker::Entry& entry        = presentationAreas.entry(areaIndex);
+                QGraphicsItem*                        graphicsItem = entry.graphicsItem();
 
-            currentX += entry.areaSize().width();
+                currentGraphicsItem->addToGroup(graphicsItem);
+                graphicsItem->setPos(currentX, minimumTopSpacing + maximumAscent - entry.ascent());
+
+                currentX += entry.areaSize().width();
+            }
         }
-    }
 
-    if (numberChildren == 0) {
-        currentX += fontMetrics.horizontalAdvance(tr(" "));
-    }
+        if (numberChildren == 0) {
+            currentX += FontMetricsCache::entry(font).spaceWidth();
+        }
 
-    unsigned parenthesisIndex = currentGraphicsItem->numberTextEntries();
-    insertLeftParenthesis(leftParenthesisData, 0.0F, 0.0F, currentGraphicsItem, parenthesisIndex);
-    insertRightParenthesis(rightParenthesisData, currentX, 0.0F, currentGraphicsItem, parenthesisIndex);
-    currentGraphicsItem->setParenthesisCenterLine(
-        maximumAscent - fontMetrics.ascent() / 4.0 - leftParenthesisData.relativePosition()
-    );
+        unsigned parenthesisIndex = currentGraphicsItem->numberTextEntries();
+        insertLeftParenthesis(leftParenthesisData, 0.0F, 0.0F, currentGraphicsItem, parenthesisIndex);
+        insertRightParenthesis(rightParenthesisData, currentX, 0.0F, currentGraphicsItem, parenthesisIndex);
+        currentGraphicsItem->setParenthesisCenterLine(
+            maximumAscent - fontMetrics.ascent() / 4.0 - leftParenthesisData.relativePosition()
+        );
 
-    currentX += rightParenthesisData.width();
+        currentX += rightParenthesisData.width();
 
-    allocateSpaceForThisPresentation(
-        parent,
-        childIdentifier,
-        QSizeF(currentX, minimumTopSpacing + maximumHeight),
-        maximumAscent + minimumTopSpacing
-    );
+        QSizeF size(currentX, minimumTopSpacing + maximumHeight);
+        commitPlacement(size, minimumTopSpacing, relativeScale);
+
+        allocateSpaceForThisPresentation(parent, childIdentifier, size, maximumAscent + minimumTopSpacing);
+    }
 }
 
 
@@ -253,6 +279,7 @@ void ListPresentationBase::removeFromScene() {
         currentGraphicsItem->deleteLater();
         currentGraphicsItem = Q_NULLPTR;
     }
+    currentSelfRepositioningPending = true;
 }
 
 
@@ -316,6 +343,7 @@ QList<PresentationAreaTracker>& ListPresentationBase::populatePresentationAreaTr
         Presentation*      childPresentation   = dynamic_cast<Presentation*>(childElement->visual());
         Presentation*      siblingPresentation = dynamic_cast<Presentation*>(nextSibling->visual());
 
+        PlacementProfiler::Scope profilerScope(childPresentation);
         childPresentation->recalculatePlacement(
             placementTracker,
             this,
@@ -334,6 +362,7 @@ QList<PresentationAreaTracker>& ListPresentationBase::populatePresentationAreaTr
         Ld::ElementPointer childElement      = element->child(numberChildren - 1);
         Presentation*      childPresentation = dynamic_cast<Presentation*>(childElement->visual());
 
+        PlacementProfiler::Scope profilerScope(childPresentation);
         childPresentation->recalculatePlacement(
             placementTracker,
             this,
@@ -357,6 +386,57 @@ QList<PresentationAreaTracker>& ListPresentationBase::presentationAreaTrackers()
 }
 
 
+bool ListPresentationBase::restoreCommittedPlacement(float minimumTopSpacing, float relativeScale) {
+    bool unchanged = (
+           currentGraphicsItem != Q_NULLPTR
+        && !currentSelfRepositioningPending
+        && currentChildRepositioningPending
+        && minimumTopSpacing == committedMinimumTopSpacing
+        && relativeScale == committedRelativeScale
+        && childPresentationAreas.size() == committedChildPresentationAreas.size()
+    );
+
+    int numberChildren = childPresentationAreas.size();
+    int childIndex     = 0;
+    while (unchanged && childIndex < numberChildren) {
+        unchanged = childPresentationAreas.at(childIndex).hasSameLayout(committedChildPresentationAreas.at(childIndex));
+        ++childIndex;
+    }
+
+    childIndex = 0;
+    while (unchanged && childIndex < numberChildren) {
+        unchanged = childPresentationAreas.at(childIndex).restorePositions(
+            currentGraphicsItem,
+            committedChildPositions.at(childIndex)
+        );
+
+        ++childIndex;
+    }
+
+    return unchanged;
+}
+
+
+void ListPresentationBase::commitPlacement(const QSizeF& size, float minimumTopSpacing, float relativeScale) {
+    committedChildPresentationAreas = childPresentationAreas;
+
+    committedChildPositions.clear();
+    for (  QList<PresentationAreaTracker>::const_iterator it  = childPresentationAreas.constBegin(),
+                                                          end = childPresentationAreas.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        committedChildPositions.append(it->positions());
+    }
+
+    committedSize                    = size;
+    committedMinimumTopSpacing       = minimumTopSpacing;
+    committedRelativeScale           = relativeScale;
+    currentSelfRepositioningPending  = false;
+    currentChildRepositioningPending = false;
+}
+
+
 void ListPresentationBase::calculateMaximumPresentationAreaAscentAndDescent(
         float& maximumAscent,
         float& maximumDescent
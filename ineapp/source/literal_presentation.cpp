@@ -37,6 +37,7 @@
 #include <ld_element_cursor.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
 #include "leaf_presentation.h"
@@ -107,11 +108,11 @@ void LiteralPresentation::recalculatePlacement(
     superscriptFont.setPointSizeF(fontPointSize * fontScaleFactor * relativeScale * superscriptSizeAdjustment);
     superscriptFont.setWeight(static_cast<QFont::Weight>(superscriptFont.weight() + superscriptWeightAdjustment));
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float fontHeight = fontMetrics.height();
     float fontAscent = fontMetrics.ascent();
 
-    QFontMetricsF superscriptFontMetrics(superscriptFont);
+    const QFontMetricsF& superscriptFontMetrics = FontMetricsCache::fontMetrics(superscriptFont);
 
     Ld::LiteralElement::SectionList sections       = literalElement->section();
     unsigned                        numberSections = static_cast<unsigned>(sections.size());
@@ -390,10 +391,10 @@ QList<QRectF> LiteralPresentation::cursorRangeToScene(
                 format = Ld::CharacterFormat::applicationDefaultMathFont();
             }
 
-            QFont         font = format->toQFont();
-            QFontMetricsF fontMetrics(font);
-            float         height       = fontMetrics.height();
-            QPointF       sceneTopLeft = currentGraphicsItem->scenePos();
+            QFont                font = format->toQFont();
+            const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+            float                height       = fontMetrics.height();
+            QPointF              sceneTopLeft = currentGraphicsItem->scenePos();
 
             boundingRectangles << QRectF(sceneTopLeft, QSizeF(0, height));
         } else {
@@ -411,9 +412,9 @@ QList<QRectF> LiteralPresentation::cursorRangeToScene(
                 QPointF                                  baseline  = textEntry.position();
                 const QFont&                             font      = textEntry.font();
 
-                QFontMetricsF fontMetrics(font);
-                float         ascent = fontMetrics.ascent();
-                float         height = fontMetrics.height();
+                const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+                float                ascent = fontMetrics.ascent();
+                float                height = fontMetrics.height();
 
                 QPointF localTopLeft;
                 QPointF localBottomRight;
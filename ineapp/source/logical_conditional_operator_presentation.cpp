@@ -36,6 +36,7 @@ void LogicalConditionalOperatorPresentation::processInstructionBreakpointUpdated
         if (!parent.isNull()) {
             PlacementNegotiator* parentPlacementNegotiator = dynamic_cast<PlacementNegotiator*>(parent->visual());
             if (parentPlacementNegotiator != Q_NULLPTR) {
+                flagPendingRepositioning();
                 parentPlacementNegotiator->requestRepositioning(this);
             }
         }
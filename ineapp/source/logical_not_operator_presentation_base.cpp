@@ -21,6 +21,7 @@
 #include <ld_logical_unary_not_operator_format.h>
 #include <ld_visual.h>
 
+#include "font_metrics_cache.h"
 #include "unary_operator_presentation_base.h"
 #include "logical_not_operator_presentation_base.h"
 
@@ -143,7 +144,7 @@ EQt::GraphicsMathGroupWithLine* LogicalNotOperatorPresentationBase::updateOverba
         float&                                requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     float childMaximumAscent  = childPresentationAreaData[0].maximumAscent();
     float childMaximumDescent = childPresentationAreaData[0].maximumDescent();
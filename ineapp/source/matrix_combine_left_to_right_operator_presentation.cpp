@@ -21,6 +21,7 @@
 #include <ld_operator_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "operator_presentation_base.h"
 #include "matrix_combine_left_to_right_operator_presentation.h"
 
@@ -69,9 +70,9 @@ EQt::GraphicsMathGroup* MatrixCombineLeftToRightOperatorPresentation::updateGrap
     EQt::GraphicsMathGroupWithLine* graphicsItem = dynamic_cast<EQt::GraphicsMathGroupWithLine*>(currentItem);
     QFont                           font         = operatorFont(format, relativeScale);
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float fontAscent       = fontMetrics.ascent();
-    float valueSpacing     = fontMetrics.horizontalAdvance(tr("M"));
+    float valueSpacing     = FontMetricsCache::entry(font).mWidth();
     float parenthesisWidth = parenthesisStyle == ParenthesisStyle::INVALID_OR_NONE ? 0 : valueSpacing / 2.0;
 
     const PresentationAreaTracker& child0 = childPresentationAreaData.at(0);
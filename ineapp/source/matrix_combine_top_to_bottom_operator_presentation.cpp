@@ -20,6 +20,7 @@
 #include <ld_operator_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "scene_units.h"
 #include "operator_presentation_base.h"
 #include "matrix_combine_top_to_bottom_operator_presentation.h"
@@ -69,11 +70,11 @@ EQt::GraphicsMathGroup* MatrixCombineTopToBottomOperatorPresentation::updateGrap
     EQt::GraphicsMathGroupWithLine* graphicsItem = dynamic_cast<EQt::GraphicsMathGroupWithLine*>(currentItem);
     QFont                           font         = operatorFont(format, relativeScale);
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float  fontAscent       = fontMetrics.ascent();
     QSizeF resolution       = sceneUnitsPerPoint();
     float  aspectRatio      = resolution.height() / resolution.width();
-    float  valueSpacing     = fontMetrics.horizontalAdvance(tr("M")) * aspectRatio;
+    float  valueSpacing     = FontMetricsCache::entry(font).mWidth() * aspectRatio;
     float  parenthesisWidth = parenthesisStyle == ParenthesisStyle::INVALID_OR_NONE ? 0 : valueSpacing / 2.0;
 
     const PresentationAreaTracker& child0 = childPresentationAreaData.at(0);
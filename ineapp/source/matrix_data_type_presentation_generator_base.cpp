@@ -24,6 +24,7 @@
 #include <ld_value_field_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "data_type_presentation_generator.h"
 #include "matrix_data_type_presentation_generator_base.h"
 
@@ -50,7 +51,7 @@ MatrixDataTypePresentationGeneratorBase::Context::Context(
     font.setPointSizeF(pointSize * scaleFactor);
 
     currentFont        = font;
-    currentFontMetrics = QFontMetricsF(font);
+    currentFontMetrics = FontMetricsCache::fontMetrics(font);
 }
 
 
@@ -297,7 +298,7 @@ EQt::GraphicsMathGroup* MatrixDataTypePresentationGeneratorBase::updateMatrixGra
         }
     }
 
-    float coefficientSpacing = context.fontMetrics().horizontalAdvance(tr("M"));
+    float coefficientSpacing = FontMetricsCache::entry(context.font()).mWidth();
     float parenthesisWidth   = coefficientSpacing / 2.0;
 
     bool          tooWideToFit = (minimumNumberColumns < totalNumberColumns);
@@ -430,7 +431,7 @@ float MatrixDataTypePresentationGeneratorBase::calculateRowHeight(
         QFont superscriptFont = context.font();
         float pointSize       = superscriptFont.pointSizeF();
         superscriptFont.setPointSizeF(pointSize * Presentation::superscriptSizeAdjustment);
-        QFontMetricsF superscriptFontMetrics(superscriptFont);
+        const QFontMetricsF& superscriptFontMetrics = FontMetricsCache::fontMetrics(superscriptFont);
 
         float positionAdjustment = baseHeight * Presentation::superscriptBaseline;
         float superscriptHeight  = baseHeight + positionAdjustment;
@@ -450,7 +451,7 @@ float MatrixDataTypePresentationGeneratorBase::calculateRowHeight(
         QFont subscriptFont = context.font();
         float pointSize     = subscriptFont.pointSizeF();
         subscriptFont.setPointSizeF(pointSize * Presentation::subscriptSizeAdjustment);
-        QFontMetricsF subscriptFontMetrics(subscriptFont);
+        const QFontMetricsF& subscriptFontMetrics = FontMetricsCache::fontMetrics(subscriptFont);
 
         float positionAdjustment = baseHeight * Presentation::subscriptBaseline;
         float subscriptHeight    = baseHeight + positionAdjustment;
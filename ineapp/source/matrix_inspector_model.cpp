@@ -20,9 +20,12 @@
 
 #include "metatypes.h"
 #include "application.h"
+#include "inspector_cell_cache.h"
 #include "matrix_inspector_model.h"
 
-MatrixInspectorModel::MatrixInspectorModel(QObject* parent):QAbstractTableModel(parent) {}
+MatrixInspectorModel::MatrixInspectorModel(QObject* parent):QAbstractTableModel(parent) {
+    connect(this, &MatrixInspectorModel::modelAboutToBeReset, this, &MatrixInspectorModel::clearCellCache);
+}
 
 
 MatrixInspectorModel::~MatrixInspectorModel() {}
@@ -55,7 +58,15 @@ QVariant MatrixInspectorModel::data(const QModelIndex& index, int role) const {
             unsigned long row    = static_cast<unsigned long>(index.row());
             unsigned long column = static_cast<unsigned long>(index.column());
 
-            result = cellValue(row, column);
+            QString text;
+            if (cellCache.lookup(row, column, static_cast<unsigned>(role), text)) {
+                result = QVariant::fromValue(text);
+            } else {
+                result = cellValue(row, column);
+                if (result.isValid()) {
+                    cellCache.insert(row, column, static_cast<unsigned>(role), result.toString());
+                }
+            }
 
             break;
         }
@@ -77,6 +88,8 @@ bool MatrixInspectorModel::setData(const QModelIndex& index, const QVariant& var
         unsigned long row    = static_cast<unsigned long>(index.row());
         unsigned long column = static_cast<unsigned long>(index.column());
 
+        cellCache.invalidate(row, column);
+
         result = updateCellValue(row, column, variant);
         if (result) {
             emit dataChanged(index, index, { role });
@@ -149,3 +162,8 @@ bool MatrixInspectorModel::loadValue(const QString& /* filename */, bool /* bina
 bool MatrixInspectorModel::saveValue(const QString& /* filename */, bool /* binaryFormat */) {
     return false;
 }
+
+
+void MatrixInspectorModel::clearCellCache() {
+    cellCache.clear();
+}
@@ -11,16 +11,24 @@
 #include <QString>
 #include <QFont>
 #include <QFontMetricsF>
+#include <QVector>
+#include <QBitArray>
+#include <QSet>
 
 #include <eqt_graphics_math_group.h>
 #include <ld_format_structures.h>
 #include <ld_matrix_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "binary_operator_presentation_base.h"
+#include "presentation_area_tracker.h"
+#include "maximum_tracker.h"
 #include "matrix_operator_presentation.h"
 
 MatrixOperatorPresentation::MatrixOperatorPresentation() {
+    fullLayoutNeeded = true;
+
     connect(
         this,
         &MatrixOperatorPresentation::geometryWasChanged,
@@ -82,26 +90,31 @@ void MatrixOperatorPresentation::processGeometryChanged(
         unsigned long /* newNumberRows */,
         unsigned long /* newNumberColumns */
     ) {
+    forceFullLayout();
     forceRepositioning();
 }
 
 
 void MatrixOperatorPresentation::processRemovedRow(unsigned long /* rowIndex */) {
+    forceFullLayout();
     forceRepositioning();
 }
 
 
 void MatrixOperatorPresentation::processRemovedColumn(unsigned long /* columnIndex */) {
+    forceFullLayout();
     forceRepositioning();
 }
 
 
 void MatrixOperatorPresentation::processRowInserted(unsigned long /* rowIndex */) {
+    forceFullLayout();
     forceRepositioning();
 }
 
 
 void MatrixOperatorPresentation::processColumnInserted(unsigned long /* columnIndex */) {
+    forceFullLayout();
     forceRepositioning();
 }
 
@@ -114,6 +127,8 @@ EQt::GraphicsMathGroup* MatrixOperatorPresentation::buildGraphicsItem(
         QSizeF&                                      requiredSize,
         float&                                       requiredAscent
     ) {
+    forceFullLayout();
+
     return updateGraphicsItem(
         format,
         new EQt::GraphicsMathGroup,
@@ -141,48 +156,53 @@ EQt::GraphicsMathGroup* MatrixOperatorPresentation::updateGraphicsItem(
     unsigned long numberRows    = element->numberRows();
     unsigned long numberColumns = element->numberColumns();
 
-    QList<float> columnWidths;
-    for (unsigned long columnIndex=0 ; columnIndex<numberColumns ; ++columnIndex) {
-        columnWidths.append(0);
-    }
+    bool fullLayout = (
+           fullLayoutNeeded
+        || numberRows != static_cast<unsigned long>(rowAscentTrackers.size())
+        || numberColumns != static_cast<unsigned long>(columnWidthTrackers.size())
+    );
 
-    unsigned long long childIndex = 0;
-    QList<float>       rowAscents;
-    QList<float>       rowDescents;
-    for (unsigned long rowIndex=0 ; rowIndex<numberRows ; ++rowIndex) {
-        float maximumAscent  = 0;
-        float maximumDescent = 0;
+    if (fullLayout) {
+        columnWidthTrackers = QVector<MaximumTracker>(static_cast<int>(numberColumns), MaximumTracker(numberRows));
+        rowAscentTrackers   = QVector<MaximumTracker>(static_cast<int>(numberRows), MaximumTracker(numberColumns));
+        rowDescentTrackers  = QVector<MaximumTracker>(static_cast<int>(numberRows), MaximumTracker(numberColumns));
 
-        for (unsigned long columnIndex=0 ; columnIndex<numberColumns ; ++columnIndex) {
-            const PresentationAreaTracker& childPresentationArea = childPresentationAreaData.at(childIndex);
-            float                          childWidth            = childPresentationArea.width();
-            float                          childAscent           = childPresentationArea.maximumAscent();
-            float                          childDescent          = childPresentationArea.maximumDescent();
+        currentColumnLeftEdges.clear();
+        currentColumnWidths.clear();
+        currentRowTopEdges.clear();
+        currentRowAscents.clear();
+    }
 
-            if (childWidth > columnWidths[columnIndex]) {
-                columnWidths[columnIndex] = childWidth;
-            }
+    // Update the extents of the coefficients that were placed during this pass.  Other coefficients kept their
+    // layout and their graphics items.  A full layout visits every coefficient.
 
-            if (childAscent > maximumAscent) {
-                maximumAscent = childAscent;
-            }
+    unsigned long long  numberCoefficients = static_cast<unsigned long long>(numberRows) * numberColumns;
+    QSet<unsigned long> coefficientsToPlace;
 
-            if (childDescent > maximumDescent) {
-                maximumDescent = childDescent;
+    if (fullLayout) {
+        for (unsigned long long childIndex=0 ; childIndex<numberCoefficients ; ++childIndex) {
+            updateCoefficientExtents(childPresentationAreaData, childIndex, numberColumns);
+        }
+    } else {
+        const QSet<unsigned long>& placedChildren = OperatorPresentationBase::placedChildren();
+        for (  QSet<unsigned long>::const_iterator it  = placedChildren.constBegin(),
+                                                   end = placedChildren.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            unsigned long childIndex = *it;
+            if (childIndex < numberCoefficients) {
+                updateCoefficientExtents(childPresentationAreaData, childIndex, numberColumns);
+                coefficientsToPlace.insert(childIndex);
             }
-
-            ++childIndex;
         }
-
-        rowAscents.append(maximumAscent);
-        rowDescents.append(maximumDescent);
     }
 
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     float fontAscent         = fontMetrics.ascent();
-    float coefficientSpacing = fontMetrics.horizontalAdvance(tr("M"));
+    float coefficientSpacing = FontMetricsCache::entry(font).mWidth();
     float y                  = 0;
 
     float parenthesisWidth;
@@ -199,33 +219,81 @@ EQt::GraphicsMathGroup* MatrixOperatorPresentation::updateGraphicsItem(
         currentX         = parenthesisWidth + coefficientSpacing; // For zero row case
     }
 
-    childIndex = 0;
-    for (unsigned long rowIndex=0 ; rowIndex<numberRows ; ++rowIndex) {
-        float rowAscent  = rowAscents.at(rowIndex);
-        float rowDescent = rowDescents.at(rowIndex);
-        float rowHeight  = rowAscent + rowDescent;
+    // Determine which columns and rows moved or changed size.  A change in the font or parenthesis style shifts every
+    // column and is caught here as well.
+
+    QBitArray movedColumns(static_cast<int>(numberColumns), fullLayout);
+    if (numberRows > 0) {
+        currentColumnLeftEdges.resize(static_cast<int>(numberColumns));
+        currentColumnWidths.resize(static_cast<int>(numberColumns));
 
         currentX = contentsLeftEdge;
         for (unsigned long columnIndex=0 ; columnIndex<numberColumns ; ++columnIndex) {
-            const PresentationAreaTracker& childPresentationArea = childPresentationAreaData.at(childIndex);
-            float                          columnWidth           = columnWidths[columnIndex];
+            int   index       = static_cast<int>(columnIndex);
+            float columnWidth = columnWidthTrackers.at(index).maximum();
 
             currentX += coefficientSpacing;
-            float coefficientX = currentX + (columnWidth - childPresentationArea.width()) / 2.0;
-            (void) addPresentationAreas(
-                childPresentationAreaData[childIndex],
-                currentItem,
-                QPointF(coefficientX, y),
-                rowAscent
-            );
+            if (currentColumnLeftEdges.at(index) != currentX || currentColumnWidths.at(index) != columnWidth) {
+                currentColumnLeftEdges[index] = currentX;
+                currentColumnWidths[index]    = columnWidth;
+                movedColumns.setBit(index);
+            }
 
             currentX += columnWidth;
-            ++childIndex;
+        }
+    }
+
+    QBitArray movedRows(static_cast<int>(numberRows), fullLayout);
+    currentRowTopEdges.resize(static_cast<int>(numberRows));
+    currentRowAscents.resize(static_cast<int>(numberRows));
+    for (unsigned long rowIndex=0 ; rowIndex<numberRows ; ++rowIndex) {
+        int   index     = static_cast<int>(rowIndex);
+        float rowAscent = rowAscentTrackers.at(index).maximum();
+
+        if (currentRowTopEdges.at(index) != y || currentRowAscents.at(index) != rowAscent) {
+            currentRowTopEdges[index] = y;
+            currentRowAscents[index]  = rowAscent;
+            movedRows.setBit(index);
+        }
+
+        y += rowAscent + rowDescentTrackers.at(index).maximum();
+    }
+
+    // Only reposition coefficients whose row or column moved or that were re-placed.  The moved rows and columns are
+    // folded into the placed coefficients so that each coefficient is repositioned at most once.
+
+    if (fullLayout) {
+        for (unsigned long long childIndex=0 ; childIndex<numberCoefficients ; ++childIndex) {
+            placeCoefficient(childPresentationAreaData, childIndex, numberColumns, currentItem);
+        }
+    } else {
+        for (unsigned long rowIndex=0 ; rowIndex<numberRows ; ++rowIndex) {
+            if (movedRows.testBit(static_cast<int>(rowIndex))) {
+                for (unsigned long columnIndex=0 ; columnIndex<numberColumns ; ++columnIndex) {
+                    coefficientsToPlace.insert(rowIndex * numberColumns + columnIndex);
+                }
+            }
         }
 
-        y += rowHeight;
+        for (unsigned long columnIndex=0 ; columnIndex<numberColumns ; ++columnIndex) {
+            if (movedColumns.testBit(static_cast<int>(columnIndex))) {
+                for (unsigned long rowIndex=0 ; rowIndex<numberRows ; ++rowIndex) {
+                    coefficientsToPlace.insert(rowIndex * numberColumns + columnIndex);
+                }
+            }
+        }
+
+        for (  QSet<unsigned long>::const_iterator it  = coefficientsToPlace.constBegin(),
+                                                   end = coefficientsToPlace.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            placeCoefficient(childPresentationAreaData, *it, numberColumns, currentItem);
+        }
     }
 
+    fullLayoutNeeded = false;
+
     requiredSize   = QSizeF(currentX + parenthesisWidth, y);
     requiredAscent = y / 2.0 + fontAscent / 4.0;
 
@@ -247,6 +315,46 @@ EQt::GraphicsMathGroup* MatrixOperatorPresentation::updateGraphicsItem(
 }
 
 
+void MatrixOperatorPresentation::updateCoefficientExtents(
+        const QList<PresentationAreaTracker>& childPresentationAreaData,
+        unsigned long                         childIndex,
+        unsigned long                         numberColumns
+    ) {
+    const PresentationAreaTracker& childPresentationArea = childPresentationAreaData.at(static_cast<int>(childIndex));
+    unsigned long                  rowIndex              = childIndex / numberColumns;
+    unsigned long                  columnIndex           = childIndex % numberColumns;
+
+    columnWidthTrackers[static_cast<int>(columnIndex)].setValue(rowIndex, childPresentationArea.width());
+    rowAscentTrackers[static_cast<int>(rowIndex)].setValue(columnIndex, childPresentationArea.maximumAscent());
+    rowDescentTrackers[static_cast<int>(rowIndex)].setValue(columnIndex, childPresentationArea.maximumDescent());
+}
+
+
+void MatrixOperatorPresentation::placeCoefficient(
+        const QList<PresentationAreaTracker>& childPresentationAreaData,
+        unsigned long                         childIndex,
+        unsigned long                         numberColumns,
+        EQt::GraphicsMathGroup*               graphicsItem
+    ) {
+    const PresentationAreaTracker& childPresentationArea = childPresentationAreaData.at(static_cast<int>(childIndex));
+    int                            rowIndex              = static_cast<int>(childIndex / numberColumns);
+    int                            columnIndex           = static_cast<int>(childIndex % numberColumns);
+    float                          columnLeftEdge        = currentColumnLeftEdges.at(columnIndex);
+    float                          columnWidth           = currentColumnWidths.at(columnIndex);
+    float                          coefficientX          = (
+          columnLeftEdge
+        + (columnWidth - childPresentationArea.width()) / 2.0
+    );
+
+    (void) addPresentationAreas(
+        childPresentationArea,
+        graphicsItem,
+        QPointF(coefficientX, currentRowTopEdges.at(rowIndex)),
+        currentRowAscents.at(rowIndex)
+    );
+}
+
+
 void MatrixOperatorPresentation::geometryChanged(
         unsigned long oldNumberRows,
         unsigned long oldNumberColumns,
@@ -284,8 +392,14 @@ void MatrixOperatorPresentation::forceRepositioning() {
         if (!parent.isNull()) {
             PlacementNegotiator* parentPlacementNegotiator = dynamic_cast<PlacementNegotiator*>(parent->visual());
             if (parentPlacementNegotiator != Q_NULLPTR) {
+                flagPendingRepositioning();
                 parentPlacementNegotiator->requestRepositioning(this);
             }
         }
     }
 }
+
+
+void MatrixOperatorPresentation::forceFullLayout() {
+    fullLayoutNeeded = true;
+}
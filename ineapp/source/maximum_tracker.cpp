@@ -0,0 +1,85 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref MaximumTracker class.
+***********************************************************************************************************************/
+
+#include <QVector>
+
+#include <algorithm>
+
+#include "maximum_tracker.h"
+
+MaximumTracker::MaximumTracker() {
+    currentSize = 0;
+}
+
+
+MaximumTracker::MaximumTracker(unsigned long numberValues) {
+    resize(numberValues);
+}
+
+
+MaximumTracker::MaximumTracker(const MaximumTracker& other) {
+    currentSize  = other.currentSize;
+    currentNodes = other.currentNodes;
+}
+
+
+MaximumTracker::~MaximumTracker() {}
+
+
+void MaximumTracker::resize(unsigned long numberValues) {
+    currentSize = numberValues;
+    currentNodes.fill(0.0F, static_cast<int>(2 * numberValues));
+}
+
+
+unsigned long MaximumTracker::size() const {
+    return currentSize;
+}
+
+
+bool MaximumTracker::setValue(unsigned long index, float newValue) {
+    Q_ASSERT(index < currentSize);
+
+    float oldMaximum = maximum();
+
+    unsigned long nodeIndex = currentSize + index;
+    currentNodes[static_cast<int>(nodeIndex)] = newValue;
+
+    while (nodeIndex > 1) {
+        nodeIndex /= 2;
+
+        float nodeValue = std::max(
+            currentNodes.at(static_cast<int>(2 * nodeIndex)),
+            currentNodes.at(static_cast<int>(2 * nodeIndex + 1))
+        );
+
+        currentNodes[static_cast<int>(nodeIndex)] = nodeValue;
+    }
+
+    return maximum() != oldMaximum;
+}
+
+
+float MaximumTracker::value(unsigned long index) const {
+    Q_ASSERT(index < currentSize);
+    return currentNodes.at(static_cast<int>(currentSize + index));
+}
+
+
+float MaximumTracker::maximum() const {
+    return currentSize > 0 ? currentNodes.at(1) : 0.0F;
+}
+
+
+MaximumTracker& MaximumTracker::operator=(const MaximumTracker& other) {
+    currentSize  = other.currentSize;
+    currentNodes = other.currentNodes;
+
+    return *this;
+}
@@ -0,0 +1,450 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref MemoryGovernor class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFile>
+
+#include <algorithm>
+
+#include "root_presentation.h"
+#include "document.h"
+#include "editor.h"
+#include "graphics_item_pool.h"
+#include "memory_governor.h"
+
+/***********************************************************************************************************************
+ * Governor state:
+ */
+
+namespace {
+    /**
+     * Class that tracks the scene memory and statistics for a single document.
+     */
+    class DocumentState {
+        public:
+            DocumentState();
+
+            /**
+             * The document's short-form name, used in reports.
+             */
+            QString name;
+
+            /**
+             * The most recent estimate of the document's scene memory, in bytes.
+             */
+            unsigned long long sceneBytes;
+
+            /**
+             * Flag indicating if the scene may have changed since the estimate was made.
+             */
+            bool estimateStale;
+
+            /**
+             * Value used to order documents by the time one of their editors was last shown.
+             */
+            unsigned long long lastShown;
+
+            /**
+             * Flag indicating that the document is being laid out after being released.
+             */
+            bool restoring;
+
+            /**
+             * Timer used to measure the time needed to restore the document.
+             */
+            QElapsedTimer restoreTimer;
+
+            /**
+             * The number of times the document was released.
+             */
+            unsigned long numberReleases;
+
+            /**
+             * The memory reclaimed by releasing the document, in bytes.
+             */
+            unsigned long long bytesReclaimed;
+
+            /**
+             * The number of completed restores.
+             */
+            unsigned long numberRestores;
+
+            /**
+             * The total time spent restoring the document, in nanoseconds.
+             */
+            unsigned long long restoreNanoseconds;
+
+            /**
+             * The longest restore, in nanoseconds.
+             */
+            unsigned long long maximumRestoreNanoseconds;
+    };
+
+    DocumentState::DocumentState() {
+        sceneBytes                = 0;
+        estimateStale             = true;
+        lastShown                 = 0;
+        restoring                 = false;
+        numberReleases            = 0;
+        bytesReclaimed            = 0;
+        numberRestores            = 0;
+        restoreNanoseconds        = 0;
+        maximumRestoreNanoseconds = 0;
+    }
+
+    /**
+     * The scene memory budget, in bytes.
+     */
+    unsigned long long currentBudgetBytes = MemoryGovernor::defaultBudgetBytes;
+
+    /**
+     * State for each open document.
+     */
+    QHash<const RootPresentation*, DocumentState> openDocuments;
+
+    /**
+     * State for documents that have been closed after being released at least once.
+     */
+    QList<DocumentState> closedDocuments;
+
+    /**
+     * Counter used to order documents by use.
+     */
+    unsigned long long useCounter = 0;
+
+    /**
+     * Flag indicating that the budget will be enforced once control returns to the event loop.
+     */
+    bool enforcementScheduled = false;
+
+    /**
+     * Method that determines if every editor presenting a document is hidden.
+     *
+     * \param[in] document The document of interest.
+     *
+     * \return Returns true if the document has at least one editor and no editor is visible.
+     */
+    bool editorsHidden(Document* document) {
+        bool hidden = document->countEditors() > 0;
+
+        Document::EditorIterator it  = document->beginEditors();
+        Document::EditorIterator end = document->endEditors();
+        while (hidden && it != end) {
+            hidden = !(*it)->isVisible();
+            ++it;
+        }
+
+        return hidden;
+    }
+
+    /**
+     * Method that sums the statistics for every open and closed document.
+     *
+     * \return Returns a document state holding the sums.
+     */
+    DocumentState totals() {
+        DocumentState result;
+
+        QList<DocumentState> states = closedDocuments + openDocuments.values();
+        for (QList<DocumentState>::const_iterator it=states.constBegin(),end=states.constEnd() ; it!=end ; ++it) {
+            result.sceneBytes         += it->sceneBytes;
+            result.numberReleases     += it->numberReleases;
+            result.bytesReclaimed     += it->bytesReclaimed;
+            result.numberRestores     += it->numberRestores;
+            result.restoreNanoseconds += it->restoreNanoseconds;
+            result.maximumRestoreNanoseconds = std::max(
+                result.maximumRestoreNanoseconds,
+                it->maximumRestoreNanoseconds
+            );
+        }
+
+        return result;
+    }
+
+    /**
+     * Method that converts the state for a document to JSON.
+     *
+     * \param[in] state The document state.
+     *
+     * \param[in] open  Holds true if the document is still open.
+     *
+     * \return Returns the JSON object.
+     */
+    QJsonObject toJson(const DocumentState& state, bool open) {
+        double meanRestoreMilliseconds = (
+              state.numberRestores > 0
+            ? state.restoreNanoseconds / (1.0E6 * state.numberRestores)
+            : 0
+        );
+
+        QJsonObject documentObject;
+        documentObject.insert("name", state.name);
+        documentObject.insert("open", open);
+        documentObject.insert("scene_bytes", static_cast<double>(state.sceneBytes));
+        documentObject.insert("releases", static_cast<double>(state.numberReleases));
+        documentObject.insert("bytes_reclaimed", static_cast<double>(state.bytesReclaimed));
+        documentObject.insert("restores", static_cast<double>(state.numberRestores));
+        documentObject.insert("mean_restore_ms", meanRestoreMilliseconds);
+        documentObject.insert("max_restore_ms", state.maximumRestoreNanoseconds / 1.0E6);
+
+        return documentObject;
+    }
+}
+
+/***********************************************************************************************************************
+ * MemoryGovernor:
+ */
+
+bool MemoryGovernor::currentEnabled = true;
+
+void MemoryGovernor::setEnabled(bool nowEnabled) {
+    currentEnabled = nowEnabled;
+}
+
+
+void MemoryGovernor::setBudgetBytes(unsigned long long newBudgetBytes) {
+    currentBudgetBytes = newBudgetBytes;
+}
+
+
+unsigned long long MemoryGovernor::budgetBytes() {
+    return currentBudgetBytes;
+}
+
+
+unsigned long long MemoryGovernor::sceneBytesInUse() {
+    unsigned long long result = 0;
+
+    for (  QHash<const RootPresentation*, DocumentState>::const_iterator it  = openDocuments.constBegin(),
+                                                                        end = openDocuments.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        result += it->sceneBytes;
+    }
+
+    return result;
+}
+
+
+unsigned long MemoryGovernor::numberReleases() {
+    return totals().numberReleases;
+}
+
+
+unsigned long long MemoryGovernor::bytesReclaimed() {
+    return totals().bytesReclaimed;
+}
+
+
+unsigned long MemoryGovernor::numberRestores() {
+    return totals().numberRestores;
+}
+
+
+unsigned long long MemoryGovernor::restoreNanoseconds() {
+    return totals().restoreNanoseconds;
+}
+
+
+void MemoryGovernor::resetStatistics() {
+    closedDocuments.clear();
+
+    for (  QHash<const RootPresentation*, DocumentState>::iterator it = openDocuments.begin(), end = openDocuments.end()
+         ; it != end
+         ; ++it
+        ) {
+        DocumentState& state = it.value();
+
+        state.numberReleases            = 0;
+        state.bytesReclaimed            = 0;
+        state.numberRestores            = 0;
+        state.restoreNanoseconds        = 0;
+        state.maximumRestoreNanoseconds = 0;
+    }
+}
+
+
+bool MemoryGovernor::writeReport(const QString& filename) {
+    QJsonArray documentArray;
+
+    for (  QList<DocumentState>::const_iterator it = closedDocuments.constBegin(), end = closedDocuments.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        documentArray.append(toJson(*it, false));
+    }
+
+    for (  QHash<const RootPresentation*, DocumentState>::const_iterator it  = openDocuments.constBegin(),
+                                                                        end = openDocuments.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        documentArray.append(toJson(it.value(), true));
+    }
+
+    DocumentState sums = totals();
+
+    QJsonObject rootObject;
+    rootObject.insert("budget_bytes", static_cast<double>(currentBudgetBytes));
+    rootObject.insert("scene_bytes", static_cast<double>(sceneBytesInUse()));
+    rootObject.insert("releases", static_cast<double>(sums.numberReleases));
+    rootObject.insert("bytes_reclaimed", static_cast<double>(sums.bytesReclaimed));
+    rootObject.insert("restores", static_cast<double>(sums.numberRestores));
+    rootObject.insert("restore_ms", sums.restoreNanoseconds / 1.0E6);
+    rootObject.insert("max_restore_ms", sums.maximumRestoreNanoseconds / 1.0E6);
+    rootObject.insert("documents", documentArray);
+
+    QFile reportFile(filename);
+    bool  success = reportFile.open(QFile::WriteOnly | QFile::Truncate);
+    if (success) {
+        QByteArray json = QJsonDocument(rootObject).toJson(QJsonDocument::Indented);
+        success = (reportFile.write(json) == json.size());
+        reportFile.close();
+    }
+
+    return success;
+}
+
+
+void MemoryGovernor::documentClosed(const RootPresentation* rootPresentation) {
+    QHash<const RootPresentation*, DocumentState>::iterator it = openDocuments.find(rootPresentation);
+    if (it != openDocuments.end()) {
+        if (it->numberReleases > 0) {
+            closedDocuments.append(it.value());
+        }
+
+        openDocuments.erase(it);
+    }
+}
+
+
+void MemoryGovernor::restore(RootPresentation* rootPresentation) {
+    if (rootPresentation->isSceneReleased()) {
+        rootPresentation->restoreScene();
+    }
+}
+
+
+void MemoryGovernor::recordEditorShown(RootPresentation* rootPresentation) {
+    DocumentState& state = openDocuments[rootPresentation];
+    state.lastShown = ++useCounter;
+
+    if (rootPresentation->isSceneReleased()) {
+        state.restoring = true;
+        state.restoreTimer.start();
+
+        rootPresentation->restoreScene();
+    }
+}
+
+
+void MemoryGovernor::recordEditorHidden(RootPresentation*) {
+    scheduleEnforcement();
+}
+
+
+void MemoryGovernor::recordRepositioningFinished(RootPresentation* rootPresentation) {
+    DocumentState& state = openDocuments[rootPresentation];
+    state.estimateStale = true;
+
+    if (state.restoring && rootPresentation->isDisplayCoherent()) {
+        unsigned long long elapsed = static_cast<unsigned long long>(state.restoreTimer.nsecsElapsed());
+
+        state.restoring                 = false;
+        state.restoreNanoseconds       += elapsed;
+        state.maximumRestoreNanoseconds = std::max(state.maximumRestoreNanoseconds, elapsed);
+        ++state.numberRestores;
+    }
+
+    scheduleEnforcement();
+}
+
+
+void MemoryGovernor::scheduleEnforcement() {
+    // Enforcement is deferred so that a document is never released from within its own repositioning pass or an
+    // editor's event handler.
+    if (!enforcementScheduled) {
+        enforcementScheduled = true;
+        QTimer::singleShot(0, &MemoryGovernor::enforceBudget);
+    }
+}
+
+
+void MemoryGovernor::enforceBudget() {
+    enforcementScheduled = false;
+
+    if (currentEnabled) {
+        QList<Document*>                            documents  = Document::documents();
+        QList<QPair<unsigned long long, Document*>> candidates;
+        unsigned long long                          totalBytes = 0;
+
+        for (QList<Document*>::const_iterator it=documents.constBegin(),end=documents.constEnd() ; it!=end ; ++it) {
+            Document*      document = *it;
+            DocumentState& state    = openDocuments[document];
+
+            state.name = document->shortformName();
+            if (state.estimateStale) {
+                state.sceneBytes    = document->estimatedSceneBytes();
+                state.estimateStale = false;
+            }
+
+            totalBytes += state.sceneBytes;
+
+            if (!document->isSceneReleased() && !document->isRepositioning() && editorsHidden(document)) {
+                candidates.append(qMakePair(state.lastShown, document));
+            }
+        }
+
+        if (totalBytes > currentBudgetBytes) {
+            std::sort(candidates.begin(), candidates.end());
+
+            QList<QPair<unsigned long long, Document*>>::const_iterator it       = candidates.constBegin();
+            QList<QPair<unsigned long long, Document*>>::const_iterator end      = candidates.constEnd();
+            bool                                                        released = false;
+            while (totalBytes > currentBudgetBytes && it != end) {
+                Document*      document = it->second;
+                DocumentState& state    = openDocuments[document];
+
+                if (document->releaseScene()) {
+                    unsigned long long remainingBytes = document->estimatedSceneBytes();
+                    unsigned long long reclaimed      = (
+                          state.sceneBytes > remainingBytes
+                        ? state.sceneBytes - remainingBytes
+                        : 0
+                    );
+
+                    state.sceneBytes      = remainingBytes;
+                    state.bytesReclaimed += reclaimed;
+                    ++state.numberReleases;
+
+                    totalBytes -= std::min(totalBytes, reclaimed);
+                    released    = true;
+                }
+
+                ++it;
+            }
+
+            // Released scenes return their text items to the graphics item pools.  Trim the pools so that the
+            // reclaimed memory is actually returned rather than retained for reuse.
+
+            if (released) {
+                GraphicsItemPoolBase::clearAll();
+            }
+        }
+    }
+}
@@ -0,0 +1,1257 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref NativePlotItem class.
+***********************************************************************************************************************/
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QPointF>
+#include <QSizeF>
+#include <QRectF>
+#include <QPen>
+#include <QBrush>
+#include <QFont>
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QPainterPath>
+#include <QStyleOptionGraphicsItem>
+#include <QWidget>
+#include <QAbstractAxis>
+#include <QValueAxis>
+#include <QLogValueAxis>
+#include <QXYSeries>
+#include <QScatterSeries>
+#include <QSplineSeries>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <eqt_charts.h>
+#include <eqt_graphics_item_group.h>
+
+#include <ld_plot_format.h>
+
+#include "font_metrics_cache.h"
+#include "scene_units.h"
+#include "native_plot_item.h"
+
+/***********************************************************************************************************************
+ * NativePlotItem::AxisEntry
+ */
+
+NativePlotItem::AxisEntry::AxisEntry() {
+    axis         = Q_NULLPTR;
+    axisLocation = AxisLocation::BOTTOM_X_A_GM;
+    extent       = 0;
+}
+
+
+NativePlotItem::AxisEntry::AxisEntry(QAbstractAxis* axis, NativePlotItem::AxisLocation axisLocation) {
+    this->axis         = axis;
+    this->axisLocation = axisLocation;
+    extent             = 0;
+}
+
+/***********************************************************************************************************************
+ * NativePlotItem::SeriesEntry
+ */
+
+NativePlotItem::SeriesEntry::SeriesEntry() {
+    series                 = Q_NULLPTR;
+    horizontalAxisLocation = AxisLocation::BOTTOM_X_A_GM;
+    verticalAxisLocation   = AxisLocation::LEFT_Y_R_RC;
+}
+
+
+NativePlotItem::SeriesEntry::SeriesEntry(QXYSeries* series) {
+    this->series           = series;
+    horizontalAxisLocation = AxisLocation::BOTTOM_X_A_GM;
+    verticalAxisLocation   = AxisLocation::LEFT_Y_R_RC;
+}
+
+/***********************************************************************************************************************
+ * NativePlotItem
+ */
+
+NativePlotItem::NativePlotItem() {
+    currentBackgroundPen  = QPen(Qt::PenStyle::NoPen);
+    currentTitleBrush     = QBrush(Qt::GlobalColor::black);
+    currentLegendLocation = LegendLocation::NO_LEGEND;
+    currentLegendPen      = QPen(Qt::PenStyle::NoPen);
+    layoutValid           = false;
+}
+
+
+NativePlotItem::~NativePlotItem() {
+    QList<SeriesEntry> seriesToDelete = currentSeries;
+    QList<AxisEntry>   axesToDelete   = currentAxes;
+
+    currentSeries.clear();
+    currentAxes.clear();
+
+    for (  QList<SeriesEntry>::const_iterator it  = seriesToDelete.constBegin(),
+                                              end = seriesToDelete.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        delete it->series;
+    }
+
+    for (  QList<AxisEntry>::const_iterator it = axesToDelete.constBegin(), end = axesToDelete.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        delete it->axis;
+    }
+}
+
+
+void NativePlotItem::setGeometry(double x, double y, double width, double height) {
+    currentGeometry = QRectF(x, y, width, height);
+    setForcedGeometry(x, y, width, height);
+
+    invalidateLayout();
+}
+
+
+void NativePlotItem::setBackgroundPen(const QPen& newPen) {
+    currentBackgroundPen = newPen;
+    update();
+}
+
+
+void NativePlotItem::setBackgroundBrush(const QBrush& newBrush) {
+    currentBackgroundBrush = newBrush;
+    update();
+}
+
+
+void NativePlotItem::setTitle(const QString& newTitle) {
+    currentTitle = newTitle;
+    invalidateLayout();
+}
+
+
+void NativePlotItem::setTitleFont(const QFont& newFont) {
+    currentTitleFont = newFont;
+    invalidateLayout();
+}
+
+
+void NativePlotItem::setTitleBrush(const QBrush& newBrush) {
+    currentTitleBrush = newBrush;
+    update();
+}
+
+
+void NativePlotItem::setLegendLocation(NativePlotItem::LegendLocation newLegendLocation) {
+    currentLegendLocation = newLegendLocation;
+    invalidateLayout();
+}
+
+
+void NativePlotItem::setLegendFont(const QFont& newFont) {
+    currentLegendFont = newFont;
+    invalidateLayout();
+}
+
+
+void NativePlotItem::setLegendLabelBrush(const QBrush& newBrush) {
+    currentLegendLabelBrush = newBrush;
+    update();
+}
+
+
+void NativePlotItem::setLegendPen(const QPen& newPen) {
+    currentLegendPen = newPen;
+    update();
+}
+
+
+void NativePlotItem::setLegendBrush(const QBrush& newBrush) {
+    currentLegendBrush = newBrush;
+    update();
+}
+
+
+void NativePlotItem::addAxis(QAbstractAxis* axis, NativePlotItem::AxisLocation axisLocation) {
+    currentAxes.append(AxisEntry(axis, axisLocation));
+
+    auto invalidate = [this]() {
+        invalidateLayout();
+    };
+
+    QObject::connect(axis, &QAbstractAxis::reverseChanged, invalidate);
+    QObject::connect(axis, &QAbstractAxis::labelsAngleChanged, invalidate);
+    QObject::connect(axis, &QAbstractAxis::labelsVisibleChanged, invalidate);
+    QObject::connect(axis, &QAbstractAxis::titleTextChanged, invalidate);
+    QObject::connect(axis, &QAbstractAxis::titleVisibleChanged, invalidate);
+
+    QValueAxis* valueAxis = dynamic_cast<QValueAxis*>(axis);
+    if (valueAxis != Q_NULLPTR) {
+        QObject::connect(valueAxis, &QValueAxis::rangeChanged, invalidate);
+        QObject::connect(valueAxis, &QValueAxis::tickCountChanged, invalidate);
+        QObject::connect(valueAxis, &QValueAxis::minorTickCountChanged, invalidate);
+        QObject::connect(valueAxis, &QValueAxis::tickTypeChanged, invalidate);
+        QObject::connect(valueAxis, &QValueAxis::tickIntervalChanged, invalidate);
+        QObject::connect(valueAxis, &QValueAxis::tickAnchorChanged, invalidate);
+        QObject::connect(valueAxis, &QValueAxis::labelFormatChanged, invalidate);
+    } else {
+        QLogValueAxis* logAxis = dynamic_cast<QLogValueAxis*>(axis);
+        if (logAxis != Q_NULLPTR) {
+            QObject::connect(logAxis, &QLogValueAxis::rangeChanged, invalidate);
+            QObject::connect(logAxis, &QLogValueAxis::baseChanged, invalidate);
+            QObject::connect(logAxis, &QLogValueAxis::minorTickCountChanged, invalidate);
+            QObject::connect(logAxis, &QLogValueAxis::labelFormatChanged, invalidate);
+        }
+    }
+
+    invalidateLayout();
+}
+
+
+void NativePlotItem::addSeries(QXYSeries* series) {
+    currentSeries.append(SeriesEntry(series));
+
+    auto invalidate = [this]() {
+        invalidateLayout();
+    };
+
+    QObject::connect(series, &QXYSeries::pointAdded, invalidate);
+    QObject::connect(series, &QXYSeries::pointRemoved, invalidate);
+    QObject::connect(series, &QXYSeries::pointReplaced, invalidate);
+    QObject::connect(series, &QXYSeries::pointsRemoved, invalidate);
+    QObject::connect(series, &QXYSeries::pointsReplaced, invalidate);
+    QObject::connect(series, &QXYSeries::nameChanged, invalidate);
+    QObject::connect(series, &QXYSeries::visibleChanged, invalidate);
+
+    QObject::connect(series, &QObject::destroyed, [this, series]() {
+        seriesDestroyed(series);
+    });
+
+    invalidateLayout();
+}
+
+
+void NativePlotItem::attachAxis(QXYSeries* series, NativePlotItem::AxisLocation axisLocation) {
+    for (  QList<SeriesEntry>::iterator it = currentSeries.begin(), end = currentSeries.end()
+         ; it != end
+         ; ++it
+        ) {
+        if (it->series == series) {
+            if (isHorizontal(axisLocation)) {
+                it->horizontalAxisLocation = axisLocation;
+            } else {
+                it->verticalAxisLocation = axisLocation;
+            }
+        }
+    }
+
+    invalidateLayout();
+}
+
+
+QRectF NativePlotItem::plotArea() const {
+    updateLayout();
+    return currentPlotArea;
+}
+
+
+void NativePlotItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    updateLayout();
+
+    painter->save();
+    painter->setRenderHint(QPainter::RenderHint::Antialiasing, true);
+
+    painter->setPen(currentBackgroundPen);
+    painter->setBrush(currentBackgroundBrush);
+    painter->drawRect(currentGeometry);
+
+    if (!currentTitle.isEmpty()) {
+        painter->setFont(currentTitleFont);
+        painter->setPen(QPen(currentTitleBrush, 0));
+        painter->drawText(currentTitleRectangle, Qt::AlignmentFlag::AlignCenter, currentTitle);
+    }
+
+    for (QList<AxisEntry>::const_iterator it=currentAxes.constBegin(),end=currentAxes.constEnd() ; it!=end ; ++it) {
+        const QAbstractAxis* axis = it->axis;
+        if (axis->isVisible()) {
+            if (axis->isMinorGridLineVisible()) {
+                painter->strokePath(it->minorGridPath, axis->minorGridLinePen());
+            }
+
+            if (axis->isGridLineVisible()) {
+                painter->strokePath(it->majorGridPath, axis->gridLinePen());
+            }
+        }
+    }
+
+    painter->save();
+    painter->setClipRect(currentPlotArea);
+
+    for (  QList<SeriesEntry>::const_iterator it = currentSeries.constBegin(), end = currentSeries.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        const QScatterSeries* scatterSeries = dynamic_cast<const QScatterSeries*>(it->series);
+        if (scatterSeries != Q_NULLPTR) {
+            if (it->markerLocations.isEmpty()) {
+                painter->setPen(scatterSeries->pen());
+                painter->setBrush(scatterSeries->brush());
+                painter->drawPath(it->path);
+            } else {
+                for (  QList<QPointF>::const_iterator markerIterator    = it->markerLocations.constBegin(),
+                                                      markerEndIterator = it->markerLocations.constEnd()
+                     ; markerIterator != markerEndIterator
+                     ; ++markerIterator
+                    ) {
+                    paintMarker(painter, scatterSeries, *markerIterator);
+                }
+            }
+        } else {
+            painter->strokePath(it->path, it->series->pen());
+        }
+    }
+
+    painter->restore();
+
+    for (QList<AxisEntry>::const_iterator it=currentAxes.constBegin(),end=currentAxes.constEnd() ; it!=end ; ++it) {
+        const QAbstractAxis* axis = it->axis;
+        if (axis->isVisible()) {
+            if (axis->isLineVisible()) {
+                painter->strokePath(it->linePath, axis->linePen());
+            }
+
+            if (axis->labelsVisible()) {
+                int    labelsAngle = axis->labelsAngle();
+                double angle       = static_cast<double>(labelsAngle);
+
+                painter->setFont(axis->labelsFont());
+                painter->setPen(QPen(axis->labelsColor()));
+
+                unsigned numberLabels = static_cast<unsigned>(it->labels.size());
+                for (unsigned labelIndex=0 ; labelIndex<numberLabels ; ++labelIndex) {
+                    const QRectF& labelRectangle = it->labelRectangles.at(labelIndex);
+                    if (labelRectangle.isValid()) {
+                        const QString& label = it->labels.at(labelIndex);
+                        if (labelsAngle == 0) {
+                            painter->drawText(labelRectangle, Qt::AlignmentFlag::AlignCenter, label);
+                        } else {
+                            painter->save();
+                            painter->translate(labelRectangle.center());
+                            painter->rotate(angle);
+                            painter->drawText(
+                                labelRectangle.translated(-labelRectangle.center()),
+                                Qt::AlignmentFlag::AlignCenter,
+                                label
+                            );
+                            painter->restore();
+                        }
+                    }
+                }
+            }
+
+            if (it->titleRectangle.isValid()) {
+                painter->setFont(axis->titleFont());
+                painter->setPen(QPen(axis->titleBrush(), 0));
+
+                if (isHorizontal(it->axisLocation)) {
+                    painter->drawText(it->titleRectangle, Qt::AlignmentFlag::AlignCenter, axis->titleText());
+                } else {
+                    painter->save();
+                    painter->translate(it->titleRectangle.center());
+                    painter->rotate(it->axisLocation == AxisLocation::RIGHT_Y_R_RY ? 90.0 : -90.0);
+                    painter->drawText(
+                        it->titleRectangle.translated(-it->titleRectangle.center()),
+                        Qt::AlignmentFlag::AlignCenter,
+                        axis->titleText()
+                    );
+                    painter->restore();
+                }
+            }
+        }
+    }
+
+    if (!currentLegendEntries.isEmpty()) {
+        painter->setPen(currentLegendPen);
+        painter->setBrush(currentLegendBrush);
+        painter->drawRect(currentLegendRectangle);
+
+        painter->setFont(currentLegendFont);
+
+        for (  QList<LegendEntry>::const_iterator it  = currentLegendEntries.constBegin(),
+                                                  end = currentLegendEntries.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            for (  QList<QXYSeries*>::const_iterator seriesIterator    = it->series.constBegin(),
+                                                     seriesEndIterator = it->series.constEnd()
+                 ; seriesIterator != seriesEndIterator
+                 ; ++seriesIterator
+                ) {
+                paintSwatch(painter, *seriesIterator, it->swatchRectangle);
+            }
+
+            painter->setPen(QPen(currentLegendLabelBrush, 0));
+            painter->drawText(
+                it->labelRectangle,
+                Qt::AlignmentFlag::AlignLeft | Qt::AlignmentFlag::AlignVCenter,
+                it->series.first()->name()
+            );
+        }
+    }
+
+    painter->restore();
+
+    EQt::GraphicsItemGroup::paint(painter, option, widget);
+}
+
+
+void NativePlotItem::invalidateLayout() {
+    layoutValid = false;
+    update();
+}
+
+
+void NativePlotItem::seriesDestroyed(QXYSeries* series) {
+    bool found = false;
+
+    QList<SeriesEntry>::iterator it = currentSeries.begin();
+    while (it != currentSeries.end()) {
+        if (it->series == series) {
+            it    = currentSeries.erase(it);
+            found = true;
+        } else {
+            ++it;
+        }
+    }
+
+    if (found) {
+        invalidateLayout();
+    }
+}
+
+
+void NativePlotItem::updateLayout() const {
+    if (!layoutValid) {
+        double spacing   = toScene(QSizeF(spacingPoints, spacingPoints)).height();
+        QRectF available = currentGeometry.adjusted(spacing, spacing, -spacing, -spacing);
+
+        if (!currentTitle.isEmpty()) {
+            const QFontMetricsF& titleFontMetrics = FontMetricsCache::fontMetrics(currentTitleFont);
+
+            currentTitleRectangle = QRectF(
+                available.left(),
+                available.top(),
+                available.width(),
+                titleFontMetrics.height()
+            );
+
+            available.setTop(currentTitleRectangle.bottom() + spacing);
+        } else {
+            currentTitleRectangle = QRectF();
+        }
+
+        currentLegendEntries.clear();
+        currentLegendRectangle = QRectF();
+
+        if (currentLegendLocation != LegendLocation::NO_LEGEND) {
+            QSizeF legendSize = calculateLegendSize();
+            if (!currentLegendEntries.isEmpty()) {
+                double width  = legendSize.width();
+                double height = legendSize.height();
+                double left   = std::max(available.left(), available.center().x() - width / 2.0);
+                double top    = std::max(available.top(), available.center().y() - height / 2.0);
+
+                switch (currentLegendLocation) {
+                    case LegendLocation::NO_LEGEND: {
+                        Q_ASSERT(false);
+                        break;
+                    }
+
+                    case LegendLocation::TOP: {
+                        currentLegendRectangle = QRectF(left, available.top(), width, height);
+                        available.setTop(currentLegendRectangle.bottom() + spacing);
+
+                        break;
+                    }
+
+                    case LegendLocation::BOTTOM: {
+                        currentLegendRectangle = QRectF(left, available.bottom() - height, width, height);
+                        available.setBottom(currentLegendRectangle.top() - spacing);
+
+                        break;
+                    }
+
+                    case LegendLocation::LEFT: {
+                        currentLegendRectangle = QRectF(available.left(), top, width, height);
+                        available.setLeft(currentLegendRectangle.right() + spacing);
+
+                        break;
+                    }
+
+                    case LegendLocation::RIGHT: {
+                        currentLegendRectangle = QRectF(available.right() - width, top, width, height);
+                        available.setRight(currentLegendRectangle.left() - spacing);
+
+                        break;
+                    }
+
+                    default: {
+                        Q_ASSERT(false);
+                        break;
+                    }
+                }
+
+                placeLegend(currentLegendRectangle);
+            }
+        }
+
+        double leftExtent   = 0;
+        double rightExtent  = 0;
+        double topExtent    = 0;
+        double bottomExtent = 0;
+
+        for (QList<AxisEntry>::iterator it=currentAxes.begin(),end=currentAxes.end() ; it!=end ; ++it) {
+            calculateTicks(*it);
+            calculateAxisExtent(*it);
+
+            switch (it->axisLocation) {
+                case AxisLocation::LEFT_Y_R_RC:   { leftExtent   = std::max(leftExtent, it->extent);     break; }
+                case AxisLocation::BOTTOM_X_A_GM: { bottomExtent = std::max(bottomExtent, it->extent);   break; }
+                case AxisLocation::RIGHT_Y_R_RY:  { rightExtent  = std::max(rightExtent, it->extent);    break; }
+                case AxisLocation::TOP_X_A_GM:    { topExtent    = std::max(topExtent, it->extent);      break; }
+                default:                          {                                                      break; }
+            }
+        }
+
+        currentPlotArea = available.adjusted(leftExtent, topExtent, -rightExtent, -bottomExtent);
+        if (currentPlotArea.width() < 0) {
+            currentPlotArea.setWidth(0);
+        }
+
+        if (currentPlotArea.height() < 0) {
+            currentPlotArea.setHeight(0);
+        }
+
+        for (QList<AxisEntry>::iterator it=currentAxes.begin(),end=currentAxes.end() ; it!=end ; ++it) {
+            placeAxis(*it);
+        }
+
+        for (QList<SeriesEntry>::iterator it=currentSeries.begin(),end=currentSeries.end() ; it!=end ; ++it) {
+            placeSeries(*it);
+        }
+
+        layoutValid = true;
+    }
+}
+
+
+void NativePlotItem::calculateTicks(NativePlotItem::AxisEntry& axisEntry) {
+    axisEntry.majorValues.clear();
+    axisEntry.minorValues.clear();
+    axisEntry.labels.clear();
+
+    const QValueAxis* valueAxis = dynamic_cast<const QValueAxis*>(axisEntry.axis);
+    if (valueAxis != Q_NULLPTR) {
+        double minimum = valueAxis->min();
+        double maximum = valueAxis->max();
+
+        if (std::isfinite(minimum) && std::isfinite(maximum) && maximum > minimum) {
+            double span = maximum - minimum;
+
+            if (valueAxis->tickType() == QValueAxis::TickType::TicksDynamic && valueAxis->tickInterval() > 0) {
+                double interval  = valueAxis->tickInterval();
+                double anchor    = valueAxis->tickAnchor();
+                double tolerance = 1.0E-9 * interval;
+                double value     = anchor + std::ceil((minimum - anchor) / interval - 1.0E-9) * interval;
+
+                while (value <= maximum + tolerance
+                       && static_cast<unsigned>(axisEntry.majorValues.size()) < maximumNumberTicks) {
+                    axisEntry.majorValues.append(value);
+                    value += interval;
+                }
+            } else {
+                unsigned tickCount = static_cast<unsigned>(std::max(valueAxis->tickCount(), 2));
+                for (unsigned tickIndex=0 ; tickIndex<tickCount ; ++tickIndex) {
+                    axisEntry.majorValues.append(minimum + (span * tickIndex) / (tickCount - 1));
+                }
+            }
+
+            unsigned minorTickCount = static_cast<unsigned>(std::max(valueAxis->minorTickCount(), 0));
+            unsigned numberMajor    = static_cast<unsigned>(axisEntry.majorValues.size());
+            if (minorTickCount > 0 && numberMajor * minorTickCount <= maximumNumberTicks) {
+                for (unsigned majorIndex=1 ; majorIndex<numberMajor ; ++majorIndex) {
+                    double lower    = axisEntry.majorValues.at(majorIndex - 1);
+                    double upper    = axisEntry.majorValues.at(majorIndex);
+                    double stepSize = (upper - lower) / (minorTickCount + 1);
+
+                    for (unsigned minorIndex=1 ; minorIndex<=minorTickCount ; ++minorIndex) {
+                        axisEntry.minorValues.append(lower + minorIndex * stepSize);
+                    }
+                }
+            }
+
+            QString labelFormat = valueAxis->labelFormat();
+            for (  QList<double>::const_iterator it  = axisEntry.majorValues.constBegin(),
+                                                end = axisEntry.majorValues.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                axisEntry.labels.append(formatLabel(labelFormat, *it, span));
+            }
+        }
+    } else {
+        const QLogValueAxis* logAxis = dynamic_cast<const QLogValueAxis*>(axisEntry.axis);
+        if (logAxis != Q_NULLPTR) {
+            double minimum = logAxis->min();
+            double maximum = logAxis->max();
+            double base    = logAxis->base() > 1 ? logAxis->base() : 10.0;
+
+            if (minimum > 0 && std::isfinite(maximum) && maximum > minimum) {
+                double logBase     = std::log(base);
+                double logMinimum  = std::log(minimum) / logBase;
+                double logMaximum  = std::log(maximum) / logBase;
+                double firstPower  = std::ceil(logMinimum - 1.0E-9);
+                double lastPower   = std::floor(logMaximum + 1.0E-9);
+
+                if (lastPower - firstPower < maximumNumberTicks) {
+                    for (double power=firstPower ; power<=lastPower ; power+=1.0) {
+                        axisEntry.majorValues.append(std::pow(base, power));
+                    }
+
+                    unsigned minorTickCount = static_cast<unsigned>(std::max(logAxis->minorTickCount(), 0));
+                    if (minorTickCount > 0 && (lastPower - firstPower + 2) * minorTickCount <= maximumNumberTicks) {
+                        for (double power=firstPower-1.0 ; power<=lastPower ; power+=1.0) {
+                            double lower    = std::pow(base, power);
+                            double upper    = lower * base;
+                            double stepSize = (upper - lower) / (minorTickCount + 1);
+
+                            for (unsigned minorIndex=1 ; minorIndex<=minorTickCount ; ++minorIndex) {
+                                double value = lower + minorIndex * stepSize;
+                                if (value >= minimum && value <= maximum) {
+                                    axisEntry.minorValues.append(value);
+                                }
+                            }
+                        }
+                    }
+
+                    QString labelFormat = logAxis->labelFormat();
+                    for (  QList<double>::const_iterator it  = axisEntry.majorValues.constBegin(),
+                                                        end = axisEntry.majorValues.constEnd()
+                         ; it != end
+                         ; ++it
+                        ) {
+                        axisEntry.labels.append(formatLabel(labelFormat, *it, 0));
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+QString NativePlotItem::formatLabel(const QString& labelFormat, double value, double span) {
+    QString result;
+
+    if (std::abs(value) < 1.0E-12 * span) {
+        value = 0;
+    }
+
+    QString  prefix;
+    QString  suffix;
+    bool     valid             = !labelFormat.isEmpty();
+    unsigned numberConversions = 0;
+    bool     leftAlign         = false;
+    bool     showSign          = false;
+    bool     spaceSign         = false;
+    bool     zeroPad           = false;
+    unsigned width             = 0;
+    int      precision         = -1;
+    char     conversion        = '\0';
+    int      length            = labelFormat.size();
+    int      index             = 0;
+
+    while (valid && index < length) {
+        QChar c = labelFormat.at(index);
+        if (c != QChar('%')) {
+            (numberConversions == 0 ? prefix : suffix).append(c);
+            ++index;
+        } else if (index + 1 < length && labelFormat.at(index + 1) == QChar('%')) {
+            (numberConversions == 0 ? prefix : suffix).append(c);
+            index += 2;
+        } else if (numberConversions > 0) {
+            valid = false;
+        } else {
+            ++index;
+
+            while (index < length && QString("-+ #0").contains(labelFormat.at(index))) {
+                char flag = labelFormat.at(index).toLatin1();
+                leftAlign = leftAlign || flag == '-';
+                showSign  = showSign  || flag == '+';
+                spaceSign = spaceSign || flag == ' ';
+                zeroPad   = zeroPad   || flag == '0';
+                ++index;
+            }
+
+            while (valid && index < length && labelFormat.at(index).isDigit()) {
+                width = 10 * width + static_cast<unsigned>(labelFormat.at(index).digitValue());
+                valid = (width <= maximumLabelFieldWidth);
+                ++index;
+            }
+
+            if (valid && index < length && labelFormat.at(index) == QChar('.')) {
+                precision = 0;
+                ++index;
+
+                while (valid && index < length && labelFormat.at(index).isDigit()) {
+                    precision = 10 * precision + labelFormat.at(index).digitValue();
+                    valid     = (static_cast<unsigned>(precision) <= maximumLabelFieldWidth);
+                    ++index;
+                }
+            }
+
+            if (valid && index < length && labelFormat.at(index) == QChar('l')) {
+                ++index;
+            }
+
+            if (valid && index < length && QString("dieEfFgG").contains(labelFormat.at(index))) {
+                conversion = labelFormat.at(index).toLatin1();
+                ++numberConversions;
+                ++index;
+            } else {
+                valid = false;
+            }
+        }
+    }
+
+    if (valid && numberConversions == 1) {
+        QString number;
+
+        switch (conversion) {
+            case 'd':
+            case 'i': {
+                number = QString::number(std::round(value), 'f', 0);
+                break;
+            }
+
+            case 'e':
+            case 'E': {
+                number = QString::number(value, 'e', precision < 0 ? 6 : precision);
+                break;
+            }
+
+            case 'f':
+            case 'F': {
+                number = QString::number(value, 'f', precision < 0 ? 6 : precision);
+                break;
+            }
+
+            case 'g':
+            case 'G': {
+                number = QString::number(value, 'g', precision < 0 ? 6 : std::max(1, precision));
+                break;
+            }
+
+            default: {
+                Q_ASSERT(false);
+                break;
+            }
+        }
+
+        if (conversion == 'E' || conversion == 'F' || conversion == 'G') {
+            number = number.toUpper();
+        }
+
+        if (!number.startsWith(QChar('-'))) {
+            if (showSign) {
+                number.prepend(QChar('+'));
+            } else if (spaceSign) {
+                number.prepend(QChar(' '));
+            }
+        }
+
+        if (static_cast<unsigned>(number.size()) < width) {
+            if (leftAlign) {
+                number = number.leftJustified(static_cast<int>(width), QChar(' '));
+            } else if (zeroPad) {
+                int signLength = (
+                       number.startsWith(QChar('-'))
+                    || number.startsWith(QChar('+'))
+                    || number.startsWith(QChar(' '))
+                ) ? 1 : 0;
+
+                number.insert(signLength, QString(static_cast<int>(width) - number.size(), QChar('0')));
+            } else {
+                number = number.rightJustified(static_cast<int>(width), QChar(' '));
+            }
+        }
+
+        result = (prefix + number + suffix).trimmed();
+    } else {
+        result = QString::number(value, 'g', 6);
+    }
+
+    return result;
+}
+
+
+void NativePlotItem::calculateAxisExtent(NativePlotItem::AxisEntry& axisEntry) const {
+    const QAbstractAxis* axis       = axisEntry.axis;
+    double               tickLength = toScene(QSizeF(tickLengthPoints, tickLengthPoints)).height();
+    double               spacing    = toScene(QSizeF(spacingPoints, spacingPoints)).height();
+
+    axisEntry.labelRectangles.clear();
+    axisEntry.titleRectangle = QRectF();
+    axisEntry.extent         = 0;
+
+    if (axis->isVisible()) {
+        bool horizontal = isHorizontal(axisEntry.axisLocation);
+        bool rotated    = (axis->labelsAngle() % 180) != 0;
+
+        axisEntry.extent = tickLength;
+
+        if (axis->labelsVisible() && !axisEntry.labels.isEmpty()) {
+            const QFontMetricsF& labelFontMetrics = FontMetricsCache::fontMetrics(axis->labelsFont());
+            double               labelHeight      = labelFontMetrics.height();
+            double               labelExtent      = 0;
+
+            for (  QStringList::const_iterator it = axisEntry.labels.constBegin(), end = axisEntry.labels.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                double labelWidth = labelFontMetrics.horizontalAdvance(*it);
+                axisEntry.labelRectangles.append(QRectF(0, 0, labelWidth, labelHeight));
+
+                if (horizontal != rotated) {
+                    labelExtent = std::max(labelExtent, labelHeight);
+                } else {
+                    labelExtent = std::max(labelExtent, labelWidth);
+                }
+            }
+
+            axisEntry.extent += spacing + labelExtent;
+        }
+
+        QString titleText = axis->titleText();
+        if (axis->isTitleVisible() && !titleText.isEmpty()) {
+            const QFontMetricsF& titleFontMetrics = FontMetricsCache::fontMetrics(axis->titleFont());
+
+            axisEntry.titleRectangle  = QRectF(
+                0,
+                0,
+                titleFontMetrics.horizontalAdvance(titleText),
+                titleFontMetrics.height()
+            );
+            axisEntry.extent         += spacing + titleFontMetrics.height();
+        }
+    }
+}
+
+
+void NativePlotItem::placeAxis(NativePlotItem::AxisEntry& axisEntry) const {
+    const QAbstractAxis* axis       = axisEntry.axis;
+    AxisLocation         location   = axisEntry.axisLocation;
+    bool                 horizontal = isHorizontal(location);
+    bool                 rotated    = (axis->labelsAngle() % 180) != 0;
+    double               tickLength = toScene(QSizeF(tickLengthPoints, tickLengthPoints)).height();
+    double               spacing    = toScene(QSizeF(spacingPoints, spacingPoints)).height();
+    const QRectF&        area       = currentPlotArea;
+
+    double direction;
+    double edge;
+    switch (location) {
+        case AxisLocation::LEFT_Y_R_RC:   { direction = -1.0;   edge = area.left();     break; }
+        case AxisLocation::BOTTOM_X_A_GM: { direction = +1.0;   edge = area.bottom();   break; }
+        case AxisLocation::RIGHT_Y_R_RY:  { direction = +1.0;   edge = area.right();    break; }
+        case AxisLocation::TOP_X_A_GM:    { direction = -1.0;   edge = area.top();      break; }
+        default: {
+            direction = +1.0;
+            edge      = area.bottom();
+
+            Q_ASSERT(false);
+            break;
+        }
+    }
+
+    axisEntry.linePath      = QPainterPath();
+    axisEntry.majorGridPath = QPainterPath();
+    axisEntry.minorGridPath = QPainterPath();
+
+    if (horizontal) {
+        axisEntry.linePath.moveTo(area.left(), edge);
+        axisEntry.linePath.lineTo(area.right(), edge);
+    } else {
+        axisEntry.linePath.moveTo(edge, area.top());
+        axisEntry.linePath.lineTo(edge, area.bottom());
+    }
+
+    double   labelOffset   = tickLength + spacing;
+    unsigned numberLabels  = static_cast<unsigned>(axisEntry.labelRectangles.size());
+    unsigned numberMajor   = static_cast<unsigned>(axisEntry.majorValues.size());
+
+    for (unsigned majorIndex=0 ; majorIndex<numberMajor ; ++majorIndex) {
+        double fraction = axisFraction(axis, axisEntry.majorValues.at(majorIndex));
+        QRectF labelRectangle;
+
+        if (!std::isnan(fraction)) {
+            double labelWidth  = majorIndex < numberLabels ? axisEntry.labelRectangles.at(majorIndex).width() : 0;
+            double labelHeight = majorIndex < numberLabels ? axisEntry.labelRectangles.at(majorIndex).height() : 0;
+
+            QPointF labelCenter;
+            if (horizontal) {
+                double x = area.left() + fraction * area.width();
+
+                axisEntry.majorGridPath.moveTo(x, area.top());
+                axisEntry.majorGridPath.lineTo(x, area.bottom());
+
+                axisEntry.linePath.moveTo(x, edge);
+                axisEntry.linePath.lineTo(x, edge + direction * tickLength);
+
+                double labelExtent = rotated ? labelWidth : labelHeight;
+                labelCenter = QPointF(x, edge + direction * (labelOffset + labelExtent / 2.0));
+            } else {
+                double y = area.bottom() - fraction * area.height();
+
+                axisEntry.majorGridPath.moveTo(area.left(), y);
+                axisEntry.majorGridPath.lineTo(area.right(), y);
+
+                axisEntry.linePath.moveTo(edge, y);
+                axisEntry.linePath.lineTo(edge + direction * tickLength, y);
+
+                double labelExtent = rotated ? labelHeight : labelWidth;
+                labelCenter = QPointF(edge + direction * (labelOffset + labelExtent / 2.0), y);
+            }
+
+            labelRectangle = QRectF(
+                labelCenter.x() - labelWidth / 2.0,
+                labelCenter.y() - labelHeight / 2.0,
+                labelWidth,
+                labelHeight
+            );
+        }
+
+        if (majorIndex < numberLabels) {
+            axisEntry.labelRectangles[majorIndex] = labelRectangle;
+        }
+    }
+
+    for (  QList<double>::const_iterator it  = axisEntry.minorValues.constBegin(),
+                                        end = axisEntry.minorValues.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        double fraction = axisFraction(axis, *it);
+        if (!std::isnan(fraction)) {
+            if (horizontal) {
+                double x = area.left() + fraction * area.width();
+                axisEntry.minorGridPath.moveTo(x, area.top());
+                axisEntry.minorGridPath.lineTo(x, area.bottom());
+            } else {
+                double y = area.bottom() - fraction * area.height();
+                axisEntry.minorGridPath.moveTo(area.left(), y);
+                axisEntry.minorGridPath.lineTo(area.right(), y);
+            }
+        }
+    }
+
+    if (axisEntry.titleRectangle.isValid()) {
+        double  titleWidth  = axisEntry.titleRectangle.width();
+        double  titleHeight = axisEntry.titleRectangle.height();
+        double  distance    = axisEntry.extent - titleHeight / 2.0;
+        QPointF titleCenter;
+
+        if (horizontal) {
+            titleCenter = QPointF(area.center().x(), edge + direction * distance);
+        } else {
+            titleCenter = QPointF(edge + direction * distance, area.center().y());
+        }
+
+        axisEntry.titleRectangle = QRectF(
+            titleCenter.x() - titleWidth / 2.0,
+            titleCenter.y() - titleHeight / 2.0,
+            titleWidth,
+            titleHeight
+        );
+    }
+}
+
+
+void NativePlotItem::placeSeries(NativePlotItem::SeriesEntry& seriesEntry) const {
+    seriesEntry.path = QPainterPath();
+    seriesEntry.markerLocations.clear();
+
+    const QXYSeries* series         = seriesEntry.series;
+    const AxisEntry* horizontalAxis = axisEntryAt(seriesEntry.horizontalAxisLocation);
+    const AxisEntry* verticalAxis   = axisEntryAt(seriesEntry.verticalAxisLocation);
+
+    if (series->isVisible() && horizontalAxis != Q_NULLPTR && verticalAxis != Q_NULLPTR) {
+        const QRectF&    area   = currentPlotArea;
+        QVector<QPointF> points = series->pointsVector();
+
+        QVector<QPointF> mapped;
+        mapped.reserve(points.size());
+
+        for (QVector<QPointF>::const_iterator it=points.constBegin(),end=points.constEnd() ; it!=end ; ++it) {
+            double xFraction = axisFraction(horizontalAxis->axis, it->x());
+            double yFraction = axisFraction(verticalAxis->axis, it->y());
+
+            mapped.append(
+                QPointF(
+                    area.left() + xFraction * area.width(),
+                    area.bottom() - yFraction * area.height()
+                )
+            );
+        }
+
+        const QScatterSeries* scatterSeries = dynamic_cast<const QScatterSeries*>(series);
+        if (scatterSeries != Q_NULLPTR) {
+            double markerSize   = scatterSeries->markerSize();
+            QRectF visibleArea  = area.adjusted(-markerSize, -markerSize, markerSize, markerSize);
+            bool   imageMarkers = (scatterSeries->brush().style() == Qt::BrushStyle::TexturePattern);
+            bool   circles      = (scatterSeries->markerShape() == QScatterSeries::MarkerShape::MarkerShapeCircle);
+
+            for (QVector<QPointF>::const_iterator it=mapped.constBegin(),end=mapped.constEnd() ; it!=end ; ++it) {
+                const QPointF& point = *it;
+                if (!std::isnan(point.x()) && !std::isnan(point.y()) && visibleArea.contains(point)) {
+                    if (imageMarkers) {
+                        seriesEntry.markerLocations.append(point);
+                    } else if (circles) {
+                        seriesEntry.path.addEllipse(point, markerSize / 2.0, markerSize / 2.0);
+                    } else {
+                        seriesEntry.path.addRect(
+                            QRectF(point.x() - markerSize / 2.0, point.y() - markerSize / 2.0, markerSize, markerSize)
+                        );
+                    }
+                }
+            }
+        } else {
+            bool spline       = (dynamic_cast<const QSplineSeries*>(series) != Q_NULLPTR);
+            int  numberPoints = mapped.size();
+            int  runStart     = 0;
+
+            // Walk runs of representable points, breaking the curve wherever a point can not be mapped.
+            while (runStart < numberPoints) {
+                while (runStart < numberPoints
+                       && (std::isnan(mapped.at(runStart).x()) || std::isnan(mapped.at(runStart).y()))) {
+                    ++runStart;
+                }
+
+                int runEnd = runStart;
+                while (runEnd < numberPoints
+                       && !std::isnan(mapped.at(runEnd).x())
+                       && !std::isnan(mapped.at(runEnd).y())) {
+                    ++runEnd;
+                }
+
+                if (runEnd > runStart) {
+                    seriesEntry.path.moveTo(mapped.at(runStart));
+
+                    for (int index=runStart+1 ; index<runEnd ; ++index) {
+                        if (spline) {
+                            // Catmull-Rom segments expressed as cubic Bezier curves.
+                            const QPointF& p0 = mapped.at(std::max(index - 2, runStart));
+                            const QPointF& p1 = mapped.at(index - 1);
+                            const QPointF& p2 = mapped.at(index);
+                            const QPointF& p3 = mapped.at(std::min(index + 1, runEnd - 1));
+
+                            seriesEntry.path.cubicTo(p1 + (p2 - p0) / 6.0, p2 - (p3 - p1) / 6.0, p2);
+                        } else {
+                            seriesEntry.path.lineTo(mapped.at(index));
+                        }
+                    }
+                }
+
+                runStart = runEnd;
+            }
+        }
+    }
+}
+
+
+QSizeF NativePlotItem::calculateLegendSize() const {
+    currentLegendEntries.clear();
+
+    for (  QList<SeriesEntry>::const_iterator it = currentSeries.constBegin(), end = currentSeries.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        QXYSeries* series = it->series;
+        QString    name   = series->name();
+
+        if (!name.isEmpty() && series->isVisible()) {
+            if (!currentLegendEntries.isEmpty() && currentLegendEntries.last().series.last()->name() == name) {
+                currentLegendEntries.last().series.append(series);
+            } else {
+                LegendEntry entry;
+                entry.series.append(series);
+
+                currentLegendEntries.append(entry);
+            }
+        }
+    }
+
+    QSizeF result;
+
+    unsigned numberEntries = static_cast<unsigned>(currentLegendEntries.size());
+    if (numberEntries > 0) {
+        const QFontMetricsF& legendFontMetrics = FontMetricsCache::fontMetrics(currentLegendFont);
+        double               spacing           = toScene(QSizeF(spacingPoints, spacingPoints)).height();
+        double               entryHeight       = legendFontMetrics.height();
+        double               swatchWidth       = legendSwatchWidthScaleFactor * entryHeight;
+        bool                 horizontal        = (
+               currentLegendLocation == LegendLocation::TOP
+            || currentLegendLocation == LegendLocation::BOTTOM
+        );
+
+        double totalWidth   = 0;
+        double maximumWidth = 0;
+
+        for (  QList<LegendEntry>::const_iterator it  = currentLegendEntries.constBegin(),
+                                                  end = currentLegendEntries.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            double entryWidth = swatchWidth + spacing + legendFontMetrics.horizontalAdvance(it->series.first()->name());
+
+            totalWidth   += entryWidth;
+            maximumWidth  = std::max(maximumWidth, entryWidth);
+        }
+
+        if (horizontal) {
+            result = QSizeF(
+                totalWidth + (numberEntries - 1) * spacing + 2.0 * spacing,
+                entryHeight + 2.0 * spacing
+            );
+        } else {
+            result = QSizeF(
+                maximumWidth + 2.0 * spacing,
+                numberEntries * entryHeight + (numberEntries - 1) * spacing + 2.0 * spacing
+            );
+        }
+    }
+
+    return result;
+}
+
+
+void NativePlotItem::placeLegend(const QRectF& legendRectangle) const {
+    const QFontMetricsF& legendFontMetrics = FontMetricsCache::fontMetrics(currentLegendFont);
+    double               spacing           = toScene(QSizeF(spacingPoints, spacingPoints)).height();
+    double               entryHeight       = legendFontMetrics.height();
+    double               swatchWidth       = legendSwatchWidthScaleFactor * entryHeight;
+    bool                 horizontal        = (
+           currentLegendLocation == LegendLocation::TOP
+        || currentLegendLocation == LegendLocation::BOTTOM
+    );
+
+    double x = legendRectangle.left() + spacing;
+    double y = legendRectangle.top() + spacing;
+
+    for (QList<LegendEntry>::iterator it=currentLegendEntries.begin(),end=currentLegendEntries.end() ; it!=end ; ++it) {
+        double labelWidth = legendFontMetrics.horizontalAdvance(it->series.first()->name());
+
+        it->swatchRectangle = QRectF(x, y, swatchWidth, entryHeight);
+        it->labelRectangle  = QRectF(x + swatchWidth + spacing, y, labelWidth, entryHeight);
+
+        if (horizontal) {
+            x = it->labelRectangle.right() + spacing;
+        } else {
+            y += entryHeight + spacing;
+        }
+    }
+}
+
+
+const NativePlotItem::AxisEntry* NativePlotItem::axisEntryAt(NativePlotItem::AxisLocation axisLocation) const {
+    const AxisEntry* result = Q_NULLPTR;
+
+    QList<AxisEntry>::const_iterator it  = currentAxes.constBegin();
+    QList<AxisEntry>::const_iterator end = currentAxes.constEnd();
+    while (result == Q_NULLPTR && it != end) {
+        if (it->axisLocation == axisLocation) {
+            result = &(*it);
+        }
+
+        ++it;
+    }
+
+    return result;
+}
+
+
+double NativePlotItem::axisFraction(const QAbstractAxis* axis, double value) {
+    double result = std::numeric_limits<double>::quiet_NaN();
+
+    const QValueAxis* valueAxis = dynamic_cast<const QValueAxis*>(axis);
+    if (valueAxis != Q_NULLPTR) {
+        double minimum = valueAxis->min();
+        double maximum = valueAxis->max();
+
+        if (std::isfinite(value) && maximum > minimum) {
+            result = (value - minimum) / (maximum - minimum);
+        }
+    } else {
+        const QLogValueAxis* logAxis = dynamic_cast<const QLogValueAxis*>(axis);
+        if (logAxis != Q_NULLPTR) {
+            double minimum = logAxis->min();
+            double maximum = logAxis->max();
+
+            if (std::isfinite(value) && value > 0 && minimum > 0 && maximum > minimum) {
+                result = (std::log(value) - std::log(minimum)) / (std::log(maximum) - std::log(minimum));
+            }
+        }
+    }
+
+    if (!std::isnan(result) && axis->isReverse()) {
+        result = 1.0 - result;
+    }
+
+    return result;
+}
+
+
+bool NativePlotItem::isHorizontal(NativePlotItem::AxisLocation axisLocation) {
+    return axisLocation == AxisLocation::BOTTOM_X_A_GM || axisLocation == AxisLocation::TOP_X_A_GM;
+}
+
+
+void NativePlotItem::paintSwatch(QPainter* painter, const QXYSeries* series, const QRectF& rectangle) {
+    const QScatterSeries* scatterSeries = dynamic_cast<const QScatterSeries*>(series);
+    if (scatterSeries != Q_NULLPTR) {
+        paintMarker(painter, scatterSeries, rectangle.center());
+    } else {
+        double y = rectangle.center().y();
+
+        painter->setPen(series->pen());
+        painter->drawLine(QPointF(rectangle.left(), y), QPointF(rectangle.right(), y));
+    }
+}
+
+
+void NativePlotItem::paintMarker(QPainter* painter, const QScatterSeries* series, const QPointF& location) {
+    double        markerSize = series->markerSize();
+    QRectF        rectangle(location.x() - markerSize / 2.0, location.y() - markerSize / 2.0, markerSize, markerSize);
+    const QBrush& brush      = series->brush();
+
+    if (brush.style() == Qt::BrushStyle::TexturePattern) {
+        painter->drawImage(rectangle, brush.textureImage());
+    } else {
+        painter->setPen(series->pen());
+        painter->setBrush(brush);
+
+        if (series->markerShape() == QScatterSeries::MarkerShape::MarkerShapeCircle) {
+            painter->drawEllipse(rectangle);
+        } else {
+            painter->drawRect(rectangle);
+        }
+    }
+}
@@ -14,6 +14,8 @@
 #include <QRectF>
 #include <QPointF>
 #include <QList>
+#include <QHash>
+#include <QSet>
 #include <QBitArray>
 #include <QFontMetricsF>
 #include <QGraphicsItem>
@@ -40,6 +42,7 @@
 
 #include "application.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
 #include "presentation.h"
 #include "presentation_with_fixed_children.h"
 #include "scene_units.h"
@@ -58,7 +61,9 @@ static_assert(
 );
 
 OperatorPresentationBase::OperatorPresentationBase() {
-    currentGraphicsItem = Q_NULLPTR;
+    currentGraphicsItem             = Q_NULLPTR;
+    currentSelfRepositioningPending = true;
+    committedRelativeScale          = 0.0F;
 }
 
 
@@ -74,16 +79,36 @@ void OperatorPresentationBase::requestRepositioning(Presentation* childPresentat
     reallocateTrackers();
 
     if (!element.isNull()) {
+        bool isChild = false;
         for (unsigned childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
             Ld::ElementPointer childElement = element->child(childIndex);
             if (!childElement.isNull()) {
                 Presentation* presentation = dynamic_cast<Presentation*>(childElement->visual());
                 if (presentation != Q_NULLPTR && childPresentation == presentation) {
-                    currentChildPresentationAreas[childIndex].clear();
+                    PresentationAreaTracker& tracker = currentChildPresentationAreas[childIndex];
+
+                    // Keep the layout the child had when we last committed our placement.  If the child reports the
+                    // same layout once re-placed, we can skip rebuilding our graphics item.
+
+                    if (!committedChildPresentationAreas.contains(childIndex)) {
+                        if (tracker.containsChildData()) {
+                            committedChildPresentationAreas.insert(childIndex, tracker);
+                            committedChildPositions.insert(childIndex, tracker.positions());
+                        } else {
+                            currentSelfRepositioningPending = true;
+                        }
+                    }
+
+                    tracker.clear();
+                    isChild = true;
                 }
             }
         }
 
+        if (!isChild) {
+            currentSelfRepositioningPending = true;
+        }
+
         Ld::ElementPointer parent = element->parent();
         if (!parent.isNull()) {
             PlacementNegotiator* parentPlacementNegotiator = dynamic_cast<PlacementNegotiator*>(parent->visual());
@@ -95,6 +120,11 @@ void OperatorPresentationBase::requestRepositioning(Presentation* childPresentat
 }
 
 
+void OperatorPresentationBase::flagPendingRepositioning() {
+    currentSelfRepositioningPending = true;
+}
+
+
 void OperatorPresentationBase::recalculatePlacement(
         PlacementTracker*    placementTracker,
         PlacementNegotiator* parent,
@@ -113,27 +143,34 @@ void OperatorPresentationBase::recalculatePlacement(
 
     populateTrackers(placementTracker, relativeScale);
 
-    if (currentGraphicsItem == Q_NULLPTR) {
-        currentGraphicsItem = buildGraphicsItem(
-            format,
-            parenStyle,
-            relativeScale,
-            currentChildPresentationAreas,
-            requiredSize,
-            requiredAscent
-        );
-    } else {
-        currentGraphicsItem = updateGraphicsItem(
-            format,
-            currentGraphicsItem,
-            parenStyle,
-            relativeScale,
-            currentChildPresentationAreas,
-            requiredSize,
-            requiredAscent
-        );
+    // If every re-placed child reports the same layout as before, our size and ascent are unchanged.  We only move
+    // the re-placed children back into position and our parent will, in turn, find that our layout is unchanged.
+
+    if (!restoreCommittedPlacement(relativeScale)) {
+        if (currentGraphicsItem == Q_NULLPTR) {
+            currentGraphicsItem = buildGraphicsItem(
+                format,
+                parenStyle,
+                relativeScale,
+                currentChildPresentationAreas,
+                requiredSize,
+                requiredAscent
+            );
+        } else {
+            currentGraphicsItem = updateGraphicsItem(
+                format,
+                currentGraphicsItem,
+                parenStyle,
+                relativeScale,
+                currentChildPresentationAreas,
+                requiredSize,
+                requiredAscent
+            );
+        }
     }
 
+    commitPlacement(relativeScale);
+
     Ld::DiagnosticPointer diagnostic = element->diagnostic();
 
     QPen borderPen = updateBorder(diagnostic);
@@ -232,6 +269,7 @@ void OperatorPresentationBase::resetPlacement() {
         currentChildPresentationAreas[index].resetPlacement();
     }
 
+    currentSelfRepositioningPending = true;
     PresentationWithFixedChildren::resetPlacement();
 }
 
@@ -250,6 +288,8 @@ void OperatorPresentationBase::removeFromScene() {
         currentGraphicsItem->deleteLater();
         currentGraphicsItem = Q_NULLPTR;
     }
+
+    currentSelfRepositioningPending = true;
 }
 
 
@@ -441,6 +481,8 @@ void OperatorPresentationBase::clearChildPresentationAreas() {
     for (unsigned childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
         currentChildPresentationAreas[childIndex].clear();
     }
+
+    currentSelfRepositioningPending = true;
 }
 
 
@@ -451,6 +493,7 @@ void OperatorPresentationBase::populateTrackers(PlacementTracker* placementTrack
     placementTracker->addNewJobs(element->numberChildren());
 
     reallocateTrackers();
+    currentPlacedChildren.clear();
 
     unsigned long numberChildren = element->numberChildren();
     for (unsigned childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
@@ -460,6 +503,7 @@ void OperatorPresentationBase::populateTrackers(PlacementTracker* placementTrack
                 Presentation* childPresentation = dynamic_cast<Presentation*>(childElement->visual());
                 if (childPresentation != Q_NULLPTR) {
                     currentChildPresentationAreas[childIndex].setChildPresentation(childPresentation);
+                    currentPlacedChildren.insert(childIndex);
 
                     Presentation* nextSiblingPresentation = Q_NULLPTR;
 
@@ -470,6 +514,7 @@ void OperatorPresentationBase::populateTrackers(PlacementTracker* placementTrack
                         }
                     }
 
+                    PlacementProfiler::Scope profilerScope(childPresentation);
                     childPresentation->recalculatePlacement(
                         placementTracker,
                         this,
@@ -489,6 +534,11 @@ void OperatorPresentationBase::populateTrackers(PlacementTracker* placementTrack
 }
 
 
+const QSet<unsigned long>& OperatorPresentationBase::placedChildren() const {
+    return currentPlacedChildren;
+}
+
+
 void OperatorPresentationBase::reallocateTrackers() {
     unsigned long numberChildren = element()->numberChildren();
     if (numberChildren != static_cast<unsigned long>(currentChildPresentationAreas.size())) {
@@ -502,5 +552,51 @@ void OperatorPresentationBase::reallocateTrackers() {
                 currentChildPresentationAreas.end()
             );
         }
+
+        currentSelfRepositioningPending = true;
+    }
+}
+
+
+bool OperatorPresentationBase::restoreCommittedPlacement(float relativeScale) {
+    bool unchanged = (
+           currentGraphicsItem != Q_NULLPTR
+        && !currentSelfRepositioningPending
+        && !committedChildPresentationAreas.isEmpty()
+        && relativeScale == committedRelativeScale
+    );
+
+    QHash<unsigned long, PresentationAreaTracker>::const_iterator it  = committedChildPresentationAreas.constBegin();
+    QHash<unsigned long, PresentationAreaTracker>::const_iterator end = committedChildPresentationAreas.constEnd();
+    while (unchanged && it != end) {
+        unsigned long childIndex = it.key();
+        unchanged = (
+               childIndex < static_cast<unsigned long>(currentChildPresentationAreas.size())
+            && currentChildPresentationAreas.at(childIndex).hasSameLayout(it.value())
+        );
+
+        ++it;
+    }
+
+    it = committedChildPresentationAreas.constBegin();
+    while (unchanged && it != end) {
+        unsigned long childIndex = it.key();
+        unchanged = currentChildPresentationAreas.at(childIndex).restorePositions(
+            currentGraphicsItem,
+            committedChildPositions.value(childIndex)
+        );
+
+        ++it;
     }
+
+    return unchanged;
+}
+
+
+void OperatorPresentationBase::commitPlacement(float relativeScale) {
+    committedChildPresentationAreas.clear();
+    committedChildPositions.clear();
+
+    currentSelfRepositioningPending = false;
+    committedRelativeScale          = relativeScale;
 }
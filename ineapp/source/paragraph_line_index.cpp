@@ -0,0 +1,196 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref ParagraphLineIndex class.
+***********************************************************************************************************************/
+
+#include <QList>
+#include <QPair>
+#include <QRectF>
+
+#include <algorithm>
+
+#include "paragraph_line_index.h"
+
+/***********************************************************************************************************************
+ * ParagraphLineIndex::Entry
+ */
+
+ParagraphLineIndex::Entry::Entry() {
+    currentChildIdentifier    = 0;
+    currentPresentationAreaId = 0;
+}
+
+
+ParagraphLineIndex::Entry::Entry(
+        unsigned long childIdentifier,
+        unsigned long presentationAreaId,
+        const QRectF& rectangle
+    ) {
+    currentChildIdentifier    = childIdentifier;
+    currentPresentationAreaId = presentationAreaId;
+    currentRectangle          = rectangle;
+}
+
+
+ParagraphLineIndex::Entry::~Entry() {}
+
+
+unsigned long ParagraphLineIndex::Entry::childIdentifier() const {
+    return currentChildIdentifier;
+}
+
+
+unsigned long ParagraphLineIndex::Entry::presentationAreaId() const {
+    return currentPresentationAreaId;
+}
+
+
+const QRectF& ParagraphLineIndex::Entry::rectangle() const {
+    return currentRectangle;
+}
+
+/***********************************************************************************************************************
+ * ParagraphLineIndex::Line
+ */
+
+ParagraphLineIndex::Line::Line() {
+    currentAreaIdentifier = 0;
+    currentTop            = 0;
+    currentBottom         = 0;
+}
+
+
+ParagraphLineIndex::Line::Line(unsigned long areaIdentifier, double top, double bottom) {
+    currentAreaIdentifier = areaIdentifier;
+    currentTop            = top;
+    currentBottom         = bottom;
+}
+
+
+ParagraphLineIndex::Line::~Line() {}
+
+
+void ParagraphLineIndex::Line::append(const Entry& entry) {
+    currentEntries.append(entry);
+}
+
+
+unsigned long ParagraphLineIndex::Line::areaIdentifier() const {
+    return currentAreaIdentifier;
+}
+
+
+double ParagraphLineIndex::Line::top() const {
+    return currentTop;
+}
+
+
+double ParagraphLineIndex::Line::bottom() const {
+    return currentBottom;
+}
+
+
+const QList<ParagraphLineIndex::Entry>& ParagraphLineIndex::Line::entries() const {
+    return currentEntries;
+}
+
+
+long ParagraphLineIndex::Line::entryAt(double x) const {
+    long result;
+
+    if (currentEntries.isEmpty()) {
+        result = notFound;
+    } else {
+        // Locate the first presentation area whose right edge is past the position.
+        QList<Entry>::const_iterator it = std::lower_bound(
+            currentEntries.constBegin(),
+            currentEntries.constEnd(),
+            x,
+            [](const Entry& entry, double position) {
+                return entry.rectangle().right() <= position;
+            }
+        );
+
+        if (it == currentEntries.constEnd()) {
+            result = static_cast<long>(currentEntries.size()) - 1;
+        } else {
+            result = static_cast<long>(it - currentEntries.constBegin());
+        }
+    }
+
+    return result;
+}
+
+/***********************************************************************************************************************
+ * ParagraphLineIndex
+ */
+
+ParagraphLineIndex::ParagraphLineIndex() {}
+
+
+ParagraphLineIndex::~ParagraphLineIndex() {}
+
+
+void ParagraphLineIndex::clear() {
+    lines.clear();
+}
+
+
+void ParagraphLineIndex::append(const Line& line) {
+    lines.append(line);
+}
+
+
+void ParagraphLineIndex::truncateAreasStartingAt(unsigned long areaIdentifier) {
+    QList<Line>::iterator firstToDelete = std::lower_bound(
+        lines.begin(),
+        lines.end(),
+        areaIdentifier,
+        [](const Line& line, unsigned long identifier) {
+            return line.areaIdentifier() < identifier;
+        }
+    );
+
+    lines.erase(firstToDelete, lines.end());
+}
+
+
+unsigned long ParagraphLineIndex::numberLines() const {
+    return static_cast<unsigned long>(lines.size());
+}
+
+
+const ParagraphLineIndex::Line& ParagraphLineIndex::line(unsigned long lineNumber) const {
+    return lines.at(static_cast<int>(lineNumber));
+}
+
+
+long ParagraphLineIndex::lineAt(unsigned long areaIdentifier, double y) const {
+    long result = notFound;
+
+    // Locate the first line that follows the position, then step back to the line containing it.
+    QList<Line>::const_iterator it = std::upper_bound(
+        lines.constBegin(),
+        lines.constEnd(),
+        qMakePair(areaIdentifier, y),
+        [](const QPair<unsigned long, double>& position, const Line& line) {
+            return (
+                   position.first < line.areaIdentifier()
+                || (position.first == line.areaIdentifier() && position.second < line.top())
+            );
+        }
+    );
+
+    if (it != lines.constBegin()) {
+        --it;
+        if (it->areaIdentifier() == areaIdentifier && y <= it->bottom()) {
+            result = static_cast<long>(it - lines.constBegin());
+        }
+    }
+
+    return result;
+}
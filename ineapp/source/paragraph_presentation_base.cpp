@@ -33,9 +33,12 @@
 #include <ld_paragraph_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
 #include "placement_line_start.h"
+#include "paragraph_line_index.h"
 #include "presentation.h"
 #include "presentation_with_positional_children.h"
 #include "paragraph_presentation_base.h"
@@ -88,6 +91,7 @@ void ParagraphPresentationBase::recalculatePlacement(
                                                                     .dynamicCast<Ld::ElementWithPositionalChildren>();
 
     clearLineData();
+    lineIndex.clear();
 
     if (currentListTextItem != Q_NULLPTR) {
         currentListTextItem->deleteLater();
@@ -144,6 +148,7 @@ void ParagraphPresentationBase::recalculatePlacement(
         Ld::ElementPointer childElement      = thisElement->child(childIndex);
         Presentation*      childPresentation = dynamic_cast<Presentation*>(childElement->visual());
 
+        PlacementProfiler::Scope profilerScope(childPresentation);
         childPresentation->recalculatePlacement(
             placementTracker,
             this,
@@ -233,6 +238,7 @@ void ParagraphPresentationBase::allocateArea(
 
 
 void ParagraphPresentationBase::areaInsufficient(unsigned long, const QSizeF& size) {
+    PlacementProfiler::areaInsufficient();
     adjustCursor(size, false);
 }
 
@@ -267,7 +273,87 @@ double ParagraphPresentationBase::distanceToClosestPresentationArea(
         unsigned long*       presentationAreaId,
         QPointF*             closestPoint
     ) const {
-    return distanceToClosestChild(location, bestPresentation, presentationAreaId, closestPoint);
+    double closestDistance = -1;
+
+    // The line index lets us go directly to the child under the location.  We fall back to checking every child when
+    // the location is between lines or between presentation areas.
+    long lineNumber = lineAtLocation(location);
+    if (lineNumber != ParagraphLineIndex::notFound) {
+        const ParagraphLineIndex::Line& line         = lineIndex.line(static_cast<unsigned long>(lineNumber));
+        QPointF                         areaLocation = activeAreas.at(line.areaIdentifier())->mapFromScene(location);
+        long                            entryIndex   = line.entryAt(areaLocation.x());
+
+        if (entryIndex != ParagraphLineIndex::notFound) {
+            unsigned long      childIndex   = line.entries().at(static_cast<int>(entryIndex)).childIdentifier();
+            Ld::ElementPointer thisElement  = element();
+            Ld::ElementPointer childElement = (
+                  childIndex < thisElement->numberChildren()
+                ? thisElement->child(childIndex)
+                : Ld::ElementPointer()
+            );
+
+            if (!childElement.isNull()) {
+                const Presentation* childPresentation = dynamic_cast<const Presentation*>(childElement->visual());
+                if (childPresentation != Q_NULLPTR) {
+                    closestDistance = childPresentation->distanceToClosestPresentationArea(
+                        location,
+                        bestPresentation,
+                        presentationAreaId,
+                        closestPoint
+                    );
+                }
+            }
+        }
+    }
+
+    if (closestDistance != 0) {
+        closestDistance = distanceToClosestChild(location, bestPresentation, presentationAreaId, closestPoint);
+    }
+
+    return closestDistance;
+}
+
+
+unsigned long ParagraphPresentationBase::numberLines() const {
+    return lineIndex.numberLines();
+}
+
+
+long ParagraphPresentationBase::lineAtLocation(const QPointF& location) const {
+    long          result         = ParagraphLineIndex::notFound;
+    unsigned long numberAreas    = static_cast<unsigned long>(activeAreas.size());
+    unsigned long areaIdentifier = 0;
+
+    while (result == ParagraphLineIndex::notFound && areaIdentifier < numberAreas) {
+        QPointF areaLocation = activeAreas.at(areaIdentifier)->mapFromScene(location);
+        result = lineIndex.lineAt(areaIdentifier, areaLocation.y());
+
+        ++areaIdentifier;
+    }
+
+    return result;
+}
+
+
+QPointF ParagraphPresentationBase::locationOnLine(unsigned long lineNumber, double x) const {
+    const ParagraphLineIndex::Line& line       = lineIndex.line(lineNumber);
+    const EQt::GraphicsItemGroup*   activeArea = activeAreas.at(line.areaIdentifier());
+
+    double areaX      = activeArea->mapFromScene(QPointF(x, 0)).x();
+    long   entryIndex = line.entryAt(areaX);
+
+    QPointF areaLocation;
+    if (entryIndex == ParagraphLineIndex::notFound) {
+        areaLocation = QPointF(areaX, (line.top() + line.bottom()) / 2.0);
+    } else {
+        const QRectF& rectangle = line.entries().at(static_cast<int>(entryIndex)).rectangle();
+        areaLocation = QPointF(
+            std::max(rectangle.left(), std::min(rectangle.right(), areaX)),
+            rectangle.center().y()
+        );
+    }
+
+    return activeArea->mapToScene(areaLocation);
 }
 
 
@@ -425,7 +511,7 @@ void ParagraphPresentationBase::positionPresentationAreas() {
     if (!currentLinePresentations.isEmpty()) {
         if (currentLineIndex == 0 && currentListTextItem != Q_NULLPTR) {
             QFont font = currentListTextItem->font();
-            QFontMetricsF fontMetrics(font);
+            const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
             float height = fontMetrics.height();
             float ascent = fontMetrics.ascent();
 
@@ -506,6 +592,8 @@ void ParagraphPresentationBase::positionPresentationAreas() {
         QSharedPointer<Ld::ElementWithPositionalChildren> thisElement = element()
                                                                         .dynamicCast<Ld::ElementWithPositionalChildren>();
 
+        ParagraphLineIndex::Line line(currentAreaIdentifier, cursorY, cursorY + currentMaximumHeight);
+
         for (  QList<PlacementLineData>::const_iterator it  = currentLinePresentations.constBegin(),
                                                         end = currentLinePresentations.constEnd()
              ; it != end
@@ -529,9 +617,19 @@ void ParagraphPresentationBase::positionPresentationAreas() {
             activeAreas.at(currentAreaIdentifier)->addToGroup(graphicsItem);
             graphicsItem->setPos(left, presentationAreaY);
 
+            line.append(
+                ParagraphLineIndex::Entry(
+                    childIndex,
+                    presentationAreaId,
+                    QRectF(left, presentationAreaY, width, it->height())
+                )
+            );
+
             left += width;
         }
 
+        lineIndex.append(line);
+
         currentMinimumTopSpacing = nextMinimumTopSpacing;
         nextMinimumTopSpacing    = 0;
     }
@@ -570,6 +668,8 @@ void ParagraphPresentationBase::activeAreaClosed(unsigned long areaIdentifier, c
 
 
 void ParagraphPresentationBase::truncateActiveAreasStartingAt(unsigned long newListSize) {
+    lineIndex.truncateAreasStartingAt(newListSize);
+
     if (newListSize == 0 && currentListTextItem != Q_NULLPTR) {
         currentListTextItem->deleteLater();
         currentListTextItem = Q_NULLPTR;
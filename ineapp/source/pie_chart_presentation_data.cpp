@@ -11,6 +11,7 @@
 #include <QString>
 #include <QPieSlice>
 #include <QPieSeries>
+#include <QAbstractSeries>
 #include <QLegend>
 #include <QLegendMarker>
 #include <QColor>
@@ -221,11 +222,14 @@ void PieChartPresentationData::performDeferredUpdates() {
         }
     }
 
+    QSet<QPieSlice*> customLabelSlices;
+
     if (errorString.isEmpty()) {
-        chart->removeAllSeries();
+        // Existing series and slices are reused and updated in place.  Objects are only created or destroyed when the
+        // number of series or slices changes.
 
-        QFontMetrics fontMetrics(chart->legend()->font());
-        unsigned     markerSize = fontMetrics.ascent();
+        QList<QPieSeries*> existingSeries  = chartPieSeries(chart);
+        unsigned           numberPieSeries = 0;
 
         if (numberGroups == 1 || numberDataSeries == 1) {
             // Single pie chart
@@ -234,14 +238,14 @@ void PieChartPresentationData::performDeferredUpdates() {
                 seriesLabels = programmaticLabels;
             }
 
-            QPieSeries* pieSeries = new QPieSeries;
+            bool        newSeries = existingSeries.isEmpty();
+            QPieSeries* pieSeries = newSeries ? new QPieSeries : existingSeries.at(0);
+
+            QList<QPieSlice*> existingSlices = pieSeries->slices();
+            unsigned          numberSlices   = 0;
+
             if (numberGroups > 1) {
                 if (static_cast<unsigned>(seriesLabels.size()) == numberGroups) {
-                    unsigned seriesIndex = 0;
-                    while (seriesIndex == currentLabelSeriesIndex) {
-                        ++seriesIndex;
-                    }
-
                     const QVector<double>& values       = valuesBySeries.at(0);
                     unsigned               numberPoints = static_cast<unsigned>(values.size());
 
@@ -250,24 +254,19 @@ void PieChartPresentationData::performDeferredUpdates() {
                         const QString& seriesLabel = seriesLabels.at(index);
                         double         value       = values.at(index);
 
-                        QPieSlice* pieSlice = new QPieSlice(
-                            addValueToLabel(seriesLabel, value),
-                            value
+                        updateSlice(
+                            pieSeries,
+                            existingSlices,
+                            index,
+                            seriesLabel,
+                            value,
+                            sliceColor,
+                            QColor(),
+                            &customLabelSlices
                         );
-
-                        pieSlice->setColor(sliceColor);
-                        pieSeries->append(pieSlice);
-
-                        setMarkerColor(markerSize, chart->legend()->markers(pieSeries), sliceColor);
                     }
 
-                    pieSeries->setLabelsPosition(QPieSlice::LabelPosition::LabelOutside);
-                    pieSeries->setLabelsVisible(!chart->legend()->isVisible());
-
-                    pieSeries->setPieSize(pieRelativeSize(0, 1));
-                    pieSeries->setHoleSize(holeRelativeSize(0, 1));
-
-                    chart->addSeries(pieSeries);
+                    numberSlices = numberPoints;
                 } else {
                     errorString = tr(
                         "Number of labels must match either the number of values in each series or number of series "
@@ -285,27 +284,22 @@ void PieChartPresentationData::performDeferredUpdates() {
                             const QVector<double>& values      = valuesBySeries.at(valueIndex);
                             double                 value       = values.at(0);
 
-                            QPieSlice* pieSlice = new QPieSlice(
-                                addValueToLabel(seriesLabel, value),
-                                value
+                            updateSlice(
+                                pieSeries,
+                                existingSlices,
+                                valueIndex,
+                                seriesLabel,
+                                value,
+                                sliceColor,
+                                QColor(),
+                                &customLabelSlices
                             );
 
-                            pieSlice->setColor(sliceColor);
-                            pieSeries->append(pieSlice);
-
-                            setMarkerColor(markerSize, chart->legend()->markers(pieSeries), sliceColor);
-
                             ++valueIndex;
                         }
                     }
 
-                    pieSeries->setLabelsPosition(QPieSlice::LabelPosition::LabelOutside);
-                    pieSeries->setLabelsVisible(!chart->legend()->isVisible());
-
-                    pieSeries->setPieSize(pieRelativeSize(0, 1));
-                    pieSeries->setHoleSize(holeRelativeSize(0, 1));
-
-                    chart->addSeries(pieSeries);
+                    numberSlices = valueIndex;
                 } else {
                     errorString = tr(
                         "Number of labels must match either the number of values in each series or number of series "
@@ -313,29 +307,50 @@ void PieChartPresentationData::performDeferredUpdates() {
                     );
                 }
             }
+
+            if (errorString.isEmpty()) {
+                removeExcessSlices(pieSeries, existingSlices, numberSlices);
+
+                pieSeries->setLabelsPosition(QPieSlice::LabelPosition::LabelOutside);
+                pieSeries->setLabelsVisible(!chart->legend()->isVisible());
+
+                pieSeries->setPieSize(pieRelativeSize(0, 1));
+                pieSeries->setHoleSize(holeRelativeSize(0, 1));
+
+                if (newSeries) {
+                    chart->addSeries(pieSeries);
+                }
+
+                numberPieSeries = 1;
+            } else if (newSeries) {
+                delete pieSeries;
+            }
         } else {
             if (currentLabelSeriesIndex == static_cast<unsigned>(-1)) {
                 for (unsigned groupIndex=0 ; groupIndex<numberGroups ; ++groupIndex) {
-                    QPieSeries* pieSeries = new QPieSeries;
+                    bool        newSeries = (groupIndex >= static_cast<unsigned>(existingSeries.size()));
+                    QPieSeries* pieSeries = newSeries ? new QPieSeries : existingSeries.at(groupIndex);
+
+                    QList<QPieSlice*> existingSlices = pieSeries->slices();
                     for (unsigned seriesIndex=0 ; seriesIndex<numberSeries ; ++seriesIndex) {
                         const SeriesData& seriesData  = currentSeriesData.at(seriesIndex);
                         const QColor&     sliceColor  = seriesData.sliceColor();
                         const QString&    seriesLabel = seriesData.seriesLabel();
                         double            value       = valuesBySeries.at(seriesIndex).at(groupIndex);
 
-                        QPieSlice* pieSlice = new QPieSlice(
-                            addValueToLabel(seriesLabel, value),
-                            value
+                        updateSlice(
+                            pieSeries,
+                            existingSlices,
+                            seriesIndex,
+                            seriesLabel,
+                            value,
+                            sliceColor,
+                            groupIndex != 0 ? sliceTextColor(sliceColor) : QColor(),
+                            &customLabelSlices
                         );
-
-                        if (groupIndex != 0) {
-                            pieSlice->setLabelColor(sliceTextColor(sliceColor));
-                        }
-
-                        pieSlice->setColor(sliceColor);
-                        pieSeries->append(pieSlice);
                     }
 
+                    removeExcessSlices(pieSeries, existingSlices, numberSeries);
 
                     if (groupIndex == 0) {
                         pieSeries->setLabelsPosition(QPieSlice::LabelPosition::LabelOutside);
@@ -348,34 +363,44 @@ void PieChartPresentationData::performDeferredUpdates() {
                     pieSeries->setPieSize(pieRelativeSize(groupIndex, numberGroups));
                     pieSeries->setHoleSize(holeRelativeSize(groupIndex, numberGroups));
 
-                    chart->addSeries(pieSeries);
+                    if (newSeries) {
+                        chart->addSeries(pieSeries);
+                    }
                 }
+
+                numberPieSeries = numberGroups;
             } else {
                 unsigned valueIndex = 0;
                 for (unsigned seriesIndex=0 ; seriesIndex<numberSeries ; ++seriesIndex) {
                     if (seriesIndex != currentLabelSeriesIndex) {
-                        const SeriesData&      seriesData = currentSeriesData.at(seriesIndex);
-                        const QColor&          sliceColor = seriesData.sliceColor();
-                        const QVector<double>& values     = valuesBySeries.at(valueIndex);
-                        QPieSeries*            pieSeries  = new QPieSeries;
-
+                        const SeriesData&      seriesData     = currentSeriesData.at(seriesIndex);
+                        const QColor&          sliceColor     = seriesData.sliceColor();
+                        const QVector<double>& values         = valuesBySeries.at(valueIndex);
+                        unsigned               numberExisting = static_cast<unsigned>(existingSeries.size());
+                        bool                   newSeries      = (valueIndex >= numberExisting);
+                        QPieSeries*            pieSeries      = newSeries
+                                                                ? new QPieSeries
+                                                                : existingSeries.at(valueIndex);
+
+                        QList<QPieSlice*> existingSlices = pieSeries->slices();
                         for (unsigned groupIndex=0 ; groupIndex<numberGroups ; ++groupIndex) {
                             const QString& label = programmaticLabels.at(groupIndex);
                             double         value = values.at(groupIndex);
 
-                            QPieSlice* pieSlice = new QPieSlice(
-                                addValueToLabel(label, value),
-                                value
+                            updateSlice(
+                                pieSeries,
+                                existingSlices,
+                                groupIndex,
+                                label,
+                                value,
+                                sliceColor,
+                                valueIndex != 0 ? sliceTextColor(sliceColor) : QColor(),
+                                &customLabelSlices
                             );
-
-                            if (valueIndex != 0) {
-                                pieSlice->setLabelColor(sliceTextColor(sliceColor));
-                            }
-
-                            pieSlice->setColor(sliceColor);
-                            pieSeries->append(pieSlice);
                         }
 
+                        removeExcessSlices(pieSeries, existingSlices, numberGroups);
+
                         if (valueIndex == 0) {
                             pieSeries->setLabelsPosition(QPieSlice::LabelPosition::LabelOutside);
                         } else {
@@ -387,20 +412,33 @@ void PieChartPresentationData::performDeferredUpdates() {
                         pieSeries->setPieSize(pieRelativeSize(valueIndex, numberDataSeries));
                         pieSeries->setHoleSize(holeRelativeSize(valueIndex, numberDataSeries));
 
-                        chart->addSeries(pieSeries);
+                        if (newSeries) {
+                            chart->addSeries(pieSeries);
+                        }
 
                         ++valueIndex;
                     }
                 }
+
+                numberPieSeries = valueIndex;
             }
         }
+
+        removeExcessSeries(chart, existingSeries, numberPieSeries);
     }
 
     if (!errorString.isEmpty()) {
+        // Stale series must not stay on screen behind the error message.
+
+        chart->removeAllSeries();
+        customLabelSlices.clear();
+
         showErrorMessage(errorString);
     } else {
         clearErrorMessage();
     }
+
+    currentCustomLabelSlices.swap(customLabelSlices);
 }
 
 
@@ -414,6 +452,104 @@ unsigned PieChartPresentationData::numberSeriesDataValues() const {
 }
 
 
+QList<QPieSeries*> PieChartPresentationData::chartPieSeries(EQt::ChartItem* chart) {
+    QList<QPieSeries*>      result;
+    QList<QAbstractSeries*> chartSeries = chart->series();
+
+    for (  QList<QAbstractSeries*>::const_iterator it = chartSeries.constBegin(), end = chartSeries.constEnd()
+         ; it != end
+         ; ++it
+         ) {
+        QPieSeries* pieSeries = dynamic_cast<QPieSeries*>(*it);
+        if (pieSeries != Q_NULLPTR) {
+            result.append(pieSeries);
+        }
+    }
+
+    return result;
+}
+
+
+void PieChartPresentationData::removeExcessSeries(
+        EQt::ChartItem*           chart,
+        const QList<QPieSeries*>& existingSeries,
+        unsigned                  numberSeries
+    ) {
+    unsigned numberExistingSeries = static_cast<unsigned>(existingSeries.size());
+    for (unsigned seriesIndex=numberSeries ; seriesIndex<numberExistingSeries ; ++seriesIndex) {
+        QPieSeries* pieSeries = existingSeries.at(seriesIndex);
+
+        chart->removeSeries(pieSeries);
+        delete pieSeries;
+    }
+}
+
+
+QPieSlice* PieChartPresentationData::updateSlice(
+        QPieSeries*              pieSeries,
+        const QList<QPieSlice*>& existingSlices,
+        unsigned                 sliceIndex,
+        const QString&           label,
+        double                   value,
+        const QColor&            sliceColor,
+        const QColor&            labelColor,
+        QSet<QPieSlice*>*        customLabelSlices
+    ) const {
+    QPieSlice* pieSlice;
+    QString    sliceLabel = addValueToLabel(label, value);
+
+    if (sliceIndex < static_cast<unsigned>(existingSlices.size())) {
+        pieSlice = existingSlices.at(sliceIndex);
+
+        if (!labelColor.isValid() && currentCustomLabelSlices.contains(pieSlice)) {
+            // Qt Charts offers no way to return a slice's label color to the theme so the slice is replaced.
+
+            pieSeries->remove(pieSlice);
+
+            pieSlice = new QPieSlice(sliceLabel, value);
+            pieSeries->insert(static_cast<int>(sliceIndex), pieSlice);
+        } else {
+            if (pieSlice->label() != sliceLabel) {
+                pieSlice->setLabel(sliceLabel);
+            }
+
+            if (pieSlice->value() != value) {
+                pieSlice->setValue(value);
+            }
+        }
+    } else {
+        pieSlice = new QPieSlice(sliceLabel, value);
+        pieSeries->append(pieSlice);
+    }
+
+    if (pieSlice->color() != sliceColor) {
+        pieSlice->setColor(sliceColor);
+    }
+
+    if (labelColor.isValid()) {
+        if (pieSlice->labelColor() != labelColor) {
+            pieSlice->setLabelColor(labelColor);
+        }
+
+        customLabelSlices->insert(pieSlice);
+    }
+
+    return pieSlice;
+}
+
+
+void PieChartPresentationData::removeExcessSlices(
+        QPieSeries*              pieSeries,
+        const QList<QPieSlice*>& existingSlices,
+        unsigned                 numberSlices
+    ) {
+    unsigned numberExistingSlices = static_cast<unsigned>(existingSlices.size());
+    for (unsigned sliceIndex=numberSlices ; sliceIndex<numberExistingSlices ; ++sliceIndex) {
+        pieSeries->remove(existingSlices.at(sliceIndex));
+    }
+}
+
+
 void PieChartPresentationData::setMarkerColor(
         unsigned                     markerSize,
         const QList<QLegendMarker*>& markerList,
@@ -14,7 +14,10 @@
 
 #include <QObject>
 #include <QList>
+#include <QSet>
 #include <QLegendMarker>
+#include <QPieSeries>
+#include <QPieSlice>
 
 #include <eqt_charts.h>
 
@@ -194,6 +197,80 @@ class APP_PUBLIC_API PieChartPresentationData:public Plot2DCategorizedPresentati
          */
         unsigned numberSeriesDataValues() const override;
 
+        /**
+         * Method that obtains the pie series currently held by a chart, in the order they were added.
+         *
+         * \param[in] chart The chart to be queried.
+         *
+         * \return Returns a list of pie series.
+         */
+        static QList<QPieSeries*> chartPieSeries(EQt::ChartItem* chart);
+
+        /**
+         * Method that removes and destroys pie series that are no longer needed.
+         *
+         * \param[in] chart          The chart holding the series.
+         *
+         * \param[in] existingSeries The pie series held by the chart before the update.
+         *
+         * \param[in] numberSeries   The number of series to be kept.
+         */
+        static void removeExcessSeries(
+            EQt::ChartItem*           chart,
+            const QList<QPieSeries*>& existingSeries,
+            unsigned                  numberSeries
+        );
+
+        /**
+         * Method that updates an existing pie slice in place or appends a new slice if needed.  A slice that carries
+         * an explicit label color that is no longer wanted is replaced so that it picks up the chart theme's label
+         * color again.
+         *
+         * \param[in]     pieSeries         The series holding the slice.
+         *
+         * \param[in]     existingSlices    The slices held by the series before the update.
+         *
+         * \param[in]     sliceIndex        The zero based index of the slice.
+         *
+         * \param[in]     label             The slice label, without the value.
+         *
+         * \param[in]     value             The slice value.
+         *
+         * \param[in]     sliceColor        The slice color.
+         *
+         * \param[in]     labelColor        The label color.  An invalid color indicates that the chart theme's label
+         *                                  color should be used.
+         *
+         * \param[in,out] customLabelSlices Set to receive the slice if it is given an explicit label color.
+         *
+         * \return Returns a pointer to the updated slice.
+         */
+        QPieSlice* updateSlice(
+            QPieSeries*              pieSeries,
+            const QList<QPieSlice*>& existingSlices,
+            unsigned                 sliceIndex,
+            const QString&           label,
+            double                   value,
+            const QColor&            sliceColor,
+            const QColor&            labelColor,
+            QSet<QPieSlice*>*        customLabelSlices
+        ) const;
+
+        /**
+         * Method that removes slices that are no longer needed.
+         *
+         * \param[in] pieSeries      The series holding the slices.
+         *
+         * \param[in] existingSlices The slices held by the series before the update.
+         *
+         * \param[in] numberSlices   The number of slices to be kept.
+         */
+        static void removeExcessSlices(
+            QPieSeries*              pieSeries,
+            const QList<QPieSlice*>& existingSlices,
+            unsigned                 numberSlices
+        );
+
         /**
          * Method that updates the marker color for one or more markers.
          *
@@ -256,6 +333,12 @@ class APP_PUBLIC_API PieChartPresentationData:public Plot2DCategorizedPresentati
          */
         QHash<AxisLocation, AxisData> axisDataByLocation;
 
+        /**
+         * The slices given an explicit label color by the last update.  Used only for comparison; the pointers are
+         * never dereferenced.
+         */
+        QSet<QPieSlice*> currentCustomLabelSlices;
+
         /**
          * The current list of plot series.
          */
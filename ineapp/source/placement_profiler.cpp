@@ -0,0 +1,515 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref PlacementProfiler class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QGraphicsScene>
+#include <QGraphicsItem>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFile>
+
+#include <algorithm>
+
+#include <ld_element_structures.h>
+#include <ld_element.h>
+
+#include "presentation.h"
+#include "placement_profiler.h"
+
+/***********************************************************************************************************************
+ * Profiler state:
+ */
+
+namespace {
+    /**
+     * Class that tracks a placement operation that is in progress.
+     */
+    class Frame {
+        public:
+            /**
+             * Key used to locate the per-type statistics.
+             */
+            const char* typeKey;
+
+            /**
+             * Key used to locate the per-element statistics.
+             */
+            const Ld::Element* elementKey;
+
+            /**
+             * The time the operation started, in nanoseconds.
+             */
+            unsigned long long startNanoseconds;
+
+            /**
+             * The time spent placing children, in nanoseconds.
+             */
+            unsigned long long childNanoseconds;
+    };
+
+    /**
+     * Class that holds the state of a repositioning pass that is in progress.
+     */
+    class RepositioningPass {
+        public:
+            /**
+             * The time the pass started, in nanoseconds.
+             */
+            unsigned long long startNanoseconds;
+
+            /**
+             * The graphics items in the scene when the pass started.
+             */
+            QSet<const QGraphicsItem*> graphicsItems;
+    };
+
+    /**
+     * Stack of placement operations in progress on this thread.
+     */
+    thread_local QVector<Frame> frames;
+
+    /**
+     * Mutex used to protect the collected data.
+     */
+    QMutex profilerMutex;
+
+    /**
+     * Timer used to time placement operations.  The timer is started the first time the profiler is enabled.
+     */
+    QElapsedTimer profilerTimer;
+
+    /**
+     * The collected per-type statistics.
+     */
+    QHash<const char*, PlacementProfiler::Statistics> typeStatistics;
+
+    /**
+     * The collected per-element statistics.
+     */
+    QHash<const Ld::Element*, PlacementProfiler::Statistics> elementStatistics;
+
+    /**
+     * Repositioning passes in progress, by scene.
+     */
+    QHash<const QGraphicsScene*, RepositioningPass> repositioningPasses;
+
+    /**
+     * The number of completed repositioning passes.
+     */
+    unsigned long currentNumberRepositioningPasses = 0;
+
+    /**
+     * The time spent in completed repositioning passes.
+     */
+    unsigned long long currentRepositioningNanoseconds = 0;
+
+    /**
+     * The number of graphics items added during repositioning passes.
+     */
+    unsigned long long currentNumberGraphicsItemsAdded = 0;
+
+    /**
+     * The number of graphics items removed during repositioning passes.
+     */
+    unsigned long long currentNumberGraphicsItemsRemoved = 0;
+
+    /**
+     * Function that captures the graphics items currently held by a scene.
+     *
+     * \param[in] scene The scene of interest.
+     *
+     * \return Returns a set of graphics items.
+     */
+    QSet<const QGraphicsItem*> sceneItems(const QGraphicsScene* scene) {
+        QSet<const QGraphicsItem*> result;
+        QList<QGraphicsItem*>      items = scene->items();
+
+        result.reserve(items.size());
+        for (  QList<QGraphicsItem*>::const_iterator it = items.constBegin(), end = items.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            result.insert(*it);
+        }
+
+        return result;
+    }
+
+    /**
+     * Function that converts statistics to a JSON object.
+     *
+     * \param[in] statistics The statistics to be converted.
+     *
+     * \return Returns a JSON object.
+     */
+    QJsonObject toJson(const PlacementProfiler::Statistics& statistics) {
+        QJsonObject result;
+
+        result.insert("type", statistics.typeName());
+
+        Ld::ElementPointer element = statistics.element().toStrongRef();
+        if (!element.isNull()) {
+            result.insert("element_type", element->typeName());
+        }
+
+        result.insert("inclusive_ns", static_cast<double>(statistics.inclusiveNanoseconds()));
+        result.insert("exclusive_ns", static_cast<double>(statistics.exclusiveNanoseconds()));
+        result.insert("recalculate_placement_calls", static_cast<double>(statistics.numberRecalculatePlacementCalls()));
+        result.insert("redo_placement_calls", static_cast<double>(statistics.numberRedoPlacementCalls()));
+        result.insert("area_insufficient_retries", static_cast<double>(statistics.numberAreaInsufficientRetries()));
+
+        return result;
+    }
+}
+
+/***********************************************************************************************************************
+ * PlacementProfiler::Statistics
+ */
+
+PlacementProfiler::Statistics::Statistics() {
+    currentInclusiveNanoseconds            = 0;
+    currentExclusiveNanoseconds            = 0;
+    currentNumberRecalculatePlacementCalls = 0;
+    currentNumberRedoPlacementCalls        = 0;
+    currentNumberAreaInsufficientRetries   = 0;
+}
+
+
+PlacementProfiler::Statistics::Statistics(const PlacementProfiler::Statistics& other) {
+    currentTypeName                        = other.currentTypeName;
+    currentElement                         = other.currentElement;
+    currentInclusiveNanoseconds            = other.currentInclusiveNanoseconds;
+    currentExclusiveNanoseconds            = other.currentExclusiveNanoseconds;
+    currentNumberRecalculatePlacementCalls = other.currentNumberRecalculatePlacementCalls;
+    currentNumberRedoPlacementCalls        = other.currentNumberRedoPlacementCalls;
+    currentNumberAreaInsufficientRetries   = other.currentNumberAreaInsufficientRetries;
+}
+
+
+PlacementProfiler::Statistics::~Statistics() {}
+
+
+const QString& PlacementProfiler::Statistics::typeName() const {
+    return currentTypeName;
+}
+
+
+Ld::ElementWeakPointer PlacementProfiler::Statistics::element() const {
+    return currentElement;
+}
+
+
+unsigned long long PlacementProfiler::Statistics::inclusiveNanoseconds() const {
+    return currentInclusiveNanoseconds;
+}
+
+
+unsigned long long PlacementProfiler::Statistics::exclusiveNanoseconds() const {
+    return currentExclusiveNanoseconds;
+}
+
+
+unsigned long PlacementProfiler::Statistics::numberRecalculatePlacementCalls() const {
+    return currentNumberRecalculatePlacementCalls;
+}
+
+
+unsigned long PlacementProfiler::Statistics::numberRedoPlacementCalls() const {
+    return currentNumberRedoPlacementCalls;
+}
+
+
+unsigned long PlacementProfiler::Statistics::numberAreaInsufficientRetries() const {
+    return currentNumberAreaInsufficientRetries;
+}
+
+
+PlacementProfiler::Statistics& PlacementProfiler::Statistics::operator=(const PlacementProfiler::Statistics& other) {
+    currentTypeName                        = other.currentTypeName;
+    currentElement                         = other.currentElement;
+    currentInclusiveNanoseconds            = other.currentInclusiveNanoseconds;
+    currentExclusiveNanoseconds            = other.currentExclusiveNanoseconds;
+    currentNumberRecalculatePlacementCalls = other.currentNumberRecalculatePlacementCalls;
+    currentNumberRedoPlacementCalls        = other.currentNumberRedoPlacementCalls;
+    currentNumberAreaInsufficientRetries   = other.currentNumberAreaInsufficientRetries;
+
+    return *this;
+}
+
+/***********************************************************************************************************************
+ * PlacementProfiler
+ */
+
+bool PlacementProfiler::currentEnabled = false;
+
+void PlacementProfiler::setEnabled(bool nowEnabled) {
+    QMutexLocker locker(&profilerMutex);
+
+    if (nowEnabled && !profilerTimer.isValid()) {
+        profilerTimer.start();
+    }
+
+    repositioningPasses.clear();
+    currentEnabled = nowEnabled;
+}
+
+
+void PlacementProfiler::reset() {
+    QMutexLocker locker(&profilerMutex);
+
+    typeStatistics.clear();
+    elementStatistics.clear();
+    repositioningPasses.clear();
+
+    currentNumberRepositioningPasses  = 0;
+    currentRepositioningNanoseconds   = 0;
+    currentNumberGraphicsItemsAdded   = 0;
+    currentNumberGraphicsItemsRemoved = 0;
+}
+
+
+QList<PlacementProfiler::Statistics> PlacementProfiler::statisticsByType() {
+    QMutexLocker locker(&profilerMutex);
+
+    QList<Statistics> result = typeStatistics.values();
+    std::sort(
+        result.begin(),
+        result.end(),
+        [](const Statistics& a, const Statistics& b) {
+            return a.exclusiveNanoseconds() > b.exclusiveNanoseconds();
+        }
+    );
+
+    return result;
+}
+
+
+QList<PlacementProfiler::Statistics> PlacementProfiler::statisticsByElement() {
+    QMutexLocker locker(&profilerMutex);
+
+    QList<Statistics> result = elementStatistics.values();
+    std::sort(
+        result.begin(),
+        result.end(),
+        [](const Statistics& a, const Statistics& b) {
+            return a.inclusiveNanoseconds() > b.inclusiveNanoseconds();
+        }
+    );
+
+    return result;
+}
+
+
+unsigned long PlacementProfiler::numberRepositioningPasses() {
+    QMutexLocker locker(&profilerMutex);
+    return currentNumberRepositioningPasses;
+}
+
+
+unsigned long long PlacementProfiler::repositioningNanoseconds() {
+    QMutexLocker locker(&profilerMutex);
+    return currentRepositioningNanoseconds;
+}
+
+
+unsigned long long PlacementProfiler::numberGraphicsItemsAdded() {
+    QMutexLocker locker(&profilerMutex);
+    return currentNumberGraphicsItemsAdded;
+}
+
+
+unsigned long long PlacementProfiler::numberGraphicsItemsRemoved() {
+    QMutexLocker locker(&profilerMutex);
+    return currentNumberGraphicsItemsRemoved;
+}
+
+
+bool PlacementProfiler::writeReport(const QString& filename) {
+    QList<Statistics> byType    = statisticsByType();
+    QList<Statistics> byElement = statisticsByElement();
+
+    QJsonArray typeArray;
+    for (  QList<Statistics>::const_iterator it = byType.constBegin(), end = byType.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        typeArray.append(toJson(*it));
+    }
+
+    QJsonArray elementArray;
+    for (  QList<Statistics>::const_iterator it = byElement.constBegin(), end = byElement.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        elementArray.append(toJson(*it));
+    }
+
+    QJsonObject rootObject;
+    rootObject.insert("repositioning_passes", static_cast<double>(numberRepositioningPasses()));
+    rootObject.insert("repositioning_ns", static_cast<double>(repositioningNanoseconds()));
+    rootObject.insert("graphics_items_added", static_cast<double>(numberGraphicsItemsAdded()));
+    rootObject.insert("graphics_items_removed", static_cast<double>(numberGraphicsItemsRemoved()));
+    rootObject.insert("types", typeArray);
+    rootObject.insert("elements", elementArray);
+
+    QFile reportFile(filename);
+    bool  success = reportFile.open(QFile::WriteOnly | QFile::Truncate);
+    if (success) {
+        QByteArray json = QJsonDocument(rootObject).toJson(QJsonDocument::Indented);
+        success = (reportFile.write(json) == json.size());
+        reportFile.close();
+    }
+
+    return success;
+}
+
+
+void PlacementProfiler::startOperation(Presentation* presentation, PlacementProfiler::Operation operation) {
+    const char*        typeKey = presentation->metaObject()->className();
+    Ld::ElementPointer element = presentation->element();
+
+    {
+        QMutexLocker locker(&profilerMutex);
+
+        Statistics& typeEntry = typeStatistics[typeKey];
+        if (typeEntry.currentTypeName.isEmpty()) {
+            typeEntry.currentTypeName = QString::fromLatin1(typeKey);
+        }
+
+        Statistics* elementEntry = Q_NULLPTR;
+        if (!element.isNull()) {
+            elementEntry = &elementStatistics[element.data()];
+            if (elementEntry->currentElement.toStrongRef() != element) {
+                // New element or a deleted element's address was reused.
+                *elementEntry                 = Statistics();
+                elementEntry->currentTypeName = typeEntry.currentTypeName;
+                elementEntry->currentElement  = element.toWeakRef();
+            }
+        }
+
+        if (operation == Operation::RECALCULATE_PLACEMENT) {
+            ++typeEntry.currentNumberRecalculatePlacementCalls;
+            if (elementEntry != Q_NULLPTR) {
+                ++elementEntry->currentNumberRecalculatePlacementCalls;
+            }
+        } else {
+            ++typeEntry.currentNumberRedoPlacementCalls;
+            if (elementEntry != Q_NULLPTR) {
+                ++elementEntry->currentNumberRedoPlacementCalls;
+            }
+        }
+    }
+
+    Frame frame;
+    frame.typeKey          = typeKey;
+    frame.elementKey       = element.data();
+    frame.childNanoseconds = 0;
+    frame.startNanoseconds = static_cast<unsigned long long>(profilerTimer.nsecsElapsed());
+
+    frames.append(frame);
+}
+
+
+void PlacementProfiler::endOperation() {
+    if (!frames.isEmpty()) {
+        unsigned long long now      = static_cast<unsigned long long>(profilerTimer.nsecsElapsed());
+        Frame              frame    = frames.takeLast();
+        unsigned long long duration = now - frame.startNanoseconds;
+        unsigned long long self     = duration > frame.childNanoseconds ? duration - frame.childNanoseconds : 0;
+
+        if (!frames.isEmpty()) {
+            frames.last().childNanoseconds += duration;
+        }
+
+        QMutexLocker locker(&profilerMutex);
+
+        QHash<const char*, Statistics>::iterator typeIterator = typeStatistics.find(frame.typeKey);
+        if (typeIterator != typeStatistics.end()) {
+            typeIterator->currentInclusiveNanoseconds += duration;
+            typeIterator->currentExclusiveNanoseconds += self;
+        }
+
+        if (frame.elementKey != Q_NULLPTR) {
+            QHash<const Ld::Element*, Statistics>::iterator elementIterator = elementStatistics.find(frame.elementKey);
+            if (elementIterator != elementStatistics.end()) {
+                elementIterator->currentInclusiveNanoseconds += duration;
+                elementIterator->currentExclusiveNanoseconds += self;
+            }
+        }
+    }
+}
+
+
+void PlacementProfiler::recordAreaInsufficient() {
+    if (!frames.isEmpty()) {
+        const Frame& frame = frames.last();
+
+        QMutexLocker locker(&profilerMutex);
+
+        QHash<const char*, Statistics>::iterator typeIterator = typeStatistics.find(frame.typeKey);
+        if (typeIterator != typeStatistics.end()) {
+            ++typeIterator->currentNumberAreaInsufficientRetries;
+        }
+
+        if (frame.elementKey != Q_NULLPTR) {
+            QHash<const Ld::Element*, Statistics>::iterator elementIterator = elementStatistics.find(frame.elementKey);
+            if (elementIterator != elementStatistics.end()) {
+                ++elementIterator->currentNumberAreaInsufficientRetries;
+            }
+        }
+    }
+}
+
+
+void PlacementProfiler::recordRepositioningStarted(const QGraphicsScene* scene) {
+    RepositioningPass pass;
+    pass.graphicsItems    = sceneItems(scene);
+    pass.startNanoseconds = static_cast<unsigned long long>(profilerTimer.nsecsElapsed());
+
+    QMutexLocker locker(&profilerMutex);
+    repositioningPasses.insert(scene, pass);
+}
+
+
+void PlacementProfiler::recordRepositioningCompleted(const QGraphicsScene* scene) {
+    unsigned long long now = static_cast<unsigned long long>(profilerTimer.nsecsElapsed());
+
+    QMutexLocker locker(&profilerMutex);
+
+    QHash<const QGraphicsScene*, RepositioningPass>::iterator passIterator = repositioningPasses.find(scene);
+    if (passIterator != repositioningPasses.end()) {
+        const QSet<const QGraphicsItem*>& itemsBefore = passIterator->graphicsItems;
+        QSet<const QGraphicsItem*>        itemsAfter  = sceneItems(scene);
+
+        unsigned long long numberRetained = 0;
+        for (  QSet<const QGraphicsItem*>::const_iterator it = itemsAfter.constBegin(), end = itemsAfter.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            if (itemsBefore.contains(*it)) {
+                ++numberRetained;
+            }
+        }
+
+        ++currentNumberRepositioningPasses;
+        currentRepositioningNanoseconds   += now - passIterator->startNanoseconds;
+        currentNumberGraphicsItemsAdded   += static_cast<unsigned long long>(itemsAfter.size()) - numberRetained;
+        currentNumberGraphicsItemsRemoved += static_cast<unsigned long long>(itemsBefore.size()) - numberRetained;
+
+        repositioningPasses.erase(passIterator);
+    }
+}
@@ -37,6 +37,7 @@
 #include <ld_plot_format.h>
 
 #include "application.h"
+#include "native_plot_item.h"
 #include "plot_2d_presentation_data.h"
 #include "plot_engine.h"
 #include "plot_2d_engine_base.h"
@@ -99,6 +100,51 @@ void Plot2DEngineBase::configureChart(
 }
 
 
+void Plot2DEngineBase::configureChart(
+        NativePlotItem*                 plotItem,
+        Plot2DPresentationData*         presentationData,
+        QSharedPointer<Ld::PlotElement> plotElement,
+        QSharedPointer<Ld::PlotFormat>  plotFormat
+    ) const {
+    PlotWrappedEngineBase::configureChart(plotItem, plotElement, plotFormat);
+
+    const Ld::ChartLineStyle activeAreaBorderLineStyle = plotFormat->drawingAreaOutlineStyle();
+
+    QList<Ld::PlotFormat::AxisLocation>                axisLocations = plotFormat->definedAxisLocations();
+    QMap<Ld::PlotFormat::AxisLocation, QAbstractAxis*> axisByLocation;
+
+    for (  QList<Ld::PlotFormat::AxisLocation>::const_iterator axisLocationIterator    = axisLocations.constBegin(),
+                                                               axisLocationEndIterator = axisLocations.constEnd()
+         ; axisLocationIterator != axisLocationEndIterator
+         ; ++axisLocationIterator
+        ) {
+        Ld::PlotFormat::AxisLocation axisLocation = *axisLocationIterator;
+        Ld::ChartAxisFormat          axisFormat   = plotFormat->axisFormat(axisLocation);
+
+        QAbstractAxis* axis = configureAxis(
+            axisFormat,
+            plotElement->axisTitle(axisLocation),
+            activeAreaBorderLineStyle
+        );
+
+        plotItem->addAxis(axis, axisLocation);
+        presentationData->setAxisFormat(axisLocation, axisFormat, axis);
+
+        axisByLocation.insert(axisLocation, axis);
+    }
+
+    configureLegend(plotItem, *plotFormat);
+
+    QString errorReason = configureSeries(*plotElement, *plotFormat, plotItem, presentationData, axisByLocation);
+
+    if (!errorReason.isEmpty()) {
+        presentationData->showErrorMessage(errorReason);
+    } else {
+        presentationData->clearErrorMessage();
+    }
+}
+
+
 void Plot2DEngineBase::configureMarkers(
         QScatterSeries*             series,
         Ld::PlotSeries::MarkerStyle markerStyle,
@@ -146,7 +192,7 @@ void Plot2DEngineBase::configureMarkers(
 QString Plot2DEngineBase::configureSeries(
         const Ld::PlotElement&                                    plotElement,
         const Ld::PlotFormat&                                     plotFormat,
-        QChart*                                                   chartItem,
+        QGraphicsItem*                                            plotItem,
         Plot2DPresentationData*                                   presentationData,
         const QMap<Ld::PlotFormat::AxisLocation, QAbstractAxis*>& axisByLocation
     ) {
@@ -173,7 +219,7 @@ QString Plot2DEngineBase::configureSeries(
             configureMarkers(scatterSeries, markerStyle, lineWidth, lineColor);
             scatterSeries->setName(seriesLegendTitle);
 
-            chartItem->addSeries(scatterSeries);
+            addSeries(plotItem, scatterSeries);
         } else {
             scatterSeries = Q_NULLPTR;
         }
@@ -190,7 +236,7 @@ QString Plot2DEngineBase::configureSeries(
                     lineSeries->setPen(QPen(QBrush(lineColor), lineWidth, static_cast<Qt::PenStyle>(lineStyle)));
                     lineSeries->setName(seriesLegendTitle);
 
-                    chartItem->addSeries(lineSeries);
+                    addSeries(plotItem, lineSeries);
 
                     break;
                 }
@@ -200,7 +246,7 @@ QString Plot2DEngineBase::configureSeries(
                     lineSeries->setPen(QPen(QBrush(lineColor), lineWidth, static_cast<Qt::PenStyle>(lineStyle)));
                     lineSeries->setName(seriesLegendTitle);
 
-                    chartItem->addSeries(lineSeries);
+                    addSeries(plotItem, lineSeries);
 
                     break;
                 }
@@ -210,7 +256,7 @@ QString Plot2DEngineBase::configureSeries(
                     lineSeries->setPen(QPen(QBrush(lineColor), lineWidth, static_cast<Qt::PenStyle>(lineStyle)));
                     lineSeries->setName(tr("(m=?, b=?)"));
 
-                    chartItem->addSeries(lineSeries);
+                    addSeries(plotItem, lineSeries);
 
                     break;
                 }
@@ -251,11 +297,11 @@ QString Plot2DEngineBase::configureSeries(
                     QAbstractAxis* abstractAxis = axisByLocation.value(axisLocation);
 
                     if (lineSeries != Q_NULLPTR) {
-                        lineSeries->attachAxis(abstractAxis);
+                        attachAxis(plotItem, lineSeries, abstractAxis, axisLocation);
                     }
 
                     if (scatterSeries != Q_NULLPTR) {
-                        scatterSeries->attachAxis(abstractAxis);
+                        attachAxis(plotItem, scatterSeries, abstractAxis, axisLocation);
                     }
 
                     presentationData->setDataSource(
@@ -288,3 +334,34 @@ QString Plot2DEngineBase::configureSeries(
 
     return errorReason;
 }
+
+
+void Plot2DEngineBase::addSeries(QGraphicsItem* plotItem, QXYSeries* series) {
+    QChart* chartItem = dynamic_cast<QChart*>(plotItem);
+    if (chartItem != Q_NULLPTR) {
+        chartItem->addSeries(series);
+    } else {
+        NativePlotItem* nativePlotItem = dynamic_cast<NativePlotItem*>(plotItem);
+        Q_ASSERT(nativePlotItem != Q_NULLPTR);
+
+        nativePlotItem->addSeries(series);
+    }
+}
+
+
+void Plot2DEngineBase::attachAxis(
+        QGraphicsItem*               plotItem,
+        QXYSeries*                   series,
+        QAbstractAxis*               axis,
+        Ld::PlotFormat::AxisLocation axisLocation
+    ) {
+    QChart* chartItem = dynamic_cast<QChart*>(plotItem);
+    if (chartItem != Q_NULLPTR) {
+        series->attachAxis(axis);
+    } else {
+        NativePlotItem* nativePlotItem = dynamic_cast<NativePlotItem*>(plotItem);
+        Q_ASSERT(nativePlotItem != Q_NULLPTR);
+
+        nativePlotItem->attachAxis(series, axisLocation);
+    }
+}
@@ -24,6 +24,7 @@
 
 #include "application.h"
 #include "placement_negotiator.h"
+#include "placement_profiler.h"
 #include "plot_engine.h"
 #include "plot_presentation_data.h"
 #include "special_symbol_presentation_base.h"
@@ -80,6 +81,7 @@ void PlotPresentation::recalculatePlacement(
         }
     }
 
+    PlacementProfiler::Scope profilerScope(this, PlacementProfiler::Operation::REDO_PLACEMENT);
     redoPlacement(
         parent,
         childIdentifier,
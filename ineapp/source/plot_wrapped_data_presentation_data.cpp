@@ -26,6 +26,7 @@
 #include <ld_calculated_value.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "presentation.h"
 #include "plot_wrapped_presentation_data.h"
 #include "plot_wrapped_data_presentation_data.h"
@@ -159,7 +160,7 @@ PlotWrappedDataPresentationData::SeriesMinMaxAndErrorStatus PlotWrappedDataPrese
         const PlotWrappedDataPresentationData::AxisData&     axisData,
         const PlotWrappedDataPresentationData::SeriesMinMax& measuredRange
     ) {
-    QRectF plotAreaRectangle = chartItem()->plotArea();
+    QRectF plotAreaRectangle = plotArea();
 
     AxisLocation               axisLocation  = axisData.axisLocation();
     const Ld::ChartAxisFormat& axisFormat    = axisData.axisFormat();
@@ -255,7 +256,7 @@ PlotWrappedDataPresentationData::SeriesMinMaxAndErrorStatus PlotWrappedDataPrese
 
         if (errorReason.isEmpty()) {
             if (axisFormat.axisScale() != AxisScale::LOG) {
-                QFontMetricsF numberFontMetrics(numberFont);
+                const QFontMetricsF& numberFontMetrics = FontMetricsCache::fontMetrics(numberFont);
 
                 double span = std::abs(displayMaximum - displayMinimum);
                 if (axisLocation == AxisLocation::BOTTOM_X_A_GM || axisLocation == AxisLocation::TOP_X_A_GM) {
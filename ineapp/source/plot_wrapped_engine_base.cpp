@@ -11,6 +11,7 @@
 #include <QSharedPointer>
 #include <QString>
 #include <QList>
+#include <QSet>
 #include <QStringList>
 #include <QPen>
 #include <QBrush>
@@ -37,11 +38,13 @@
 #include <ld_plot_format.h>
 
 #include "application.h"
+#include "native_plot_item.h"
 #include "plot_wrapped_presentation_data.h"
 #include "plot_engine.h"
 #include "plot_wrapped_engine_base.h"
 
 const float PlotWrappedEngineBase::minimumMarkerSizePoints = 9.0F;
+QSet<QString> PlotWrappedEngineBase::nativeRendererEngineNames;
 
 PlotWrappedEngineBase::PlotWrappedEngineBase() {}
 
@@ -49,6 +52,25 @@ PlotWrappedEngineBase::PlotWrappedEngineBase() {}
 PlotWrappedEngineBase::~PlotWrappedEngineBase() {}
 
 
+void PlotWrappedEngineBase::setNativeRendererEnabled(const QString& engineName, bool nowEnabled) {
+    if (nowEnabled) {
+        nativeRendererEngineNames.insert(engineName);
+    } else {
+        nativeRendererEngineNames.remove(engineName);
+    }
+}
+
+
+bool PlotWrappedEngineBase::supportsNativeRenderer() const {
+    return false;
+}
+
+
+bool PlotWrappedEngineBase::nativeRendererEnabled() const {
+    return supportsNativeRenderer() && nativeRendererEngineNames.contains(name());
+}
+
+
 void PlotWrappedEngineBase::configureChart(
         QChart*                         chartItem,
         QSharedPointer<Ld::PlotElement> plotElement,
@@ -80,6 +102,34 @@ void PlotWrappedEngineBase::configureChart(
 }
 
 
+void PlotWrappedEngineBase::configureChart(
+        NativePlotItem*                 plotItem,
+        QSharedPointer<Ld::PlotElement> plotElement,
+        QSharedPointer<Ld::PlotFormat>  plotFormat
+    ) const {
+    const Ld::ChartLineStyle& borderLineStyle = plotFormat->borderLineStyle();
+    QPen borderPen(
+        QBrush(validateForegroundColor(borderLineStyle.lineColor())),
+        borderLineStyle.lineWidth(),
+        static_cast<Qt::PenStyle>(borderLineStyle.lineStyle())
+    );
+
+    plotItem->setBackgroundPen(borderPen);
+
+    Ld::FontFormat titleFontFormat = plotFormat->titleFontFormat();
+    QColor         titleFontColor  = validateForegroundColor(titleFontFormat.fontColor());
+
+    float fontScaleFactor  = Application::fontScaleFactor();
+    QFont titleFont        = titleFontFormat.toQFont();
+    titleFont.setPointSizeF(titleFont.pointSizeF() * fontScaleFactor);
+
+    plotItem->setTitle(plotElement->plotTitle());
+    plotItem->setTitleFont(titleFont);
+    plotItem->setTitleBrush(QBrush(titleFontColor));
+    plotItem->setBackgroundBrush(QBrush(validateBackgroundColor(plotFormat->plotAreaBackgroundColor())));
+}
+
+
 QAbstractAxis* PlotWrappedEngineBase::configureAxis(
         const Ld::ChartAxisFormat& axisFormat,
         const QString&             axisTitle,
@@ -247,6 +297,38 @@ void PlotWrappedEngineBase::configureLegend(
 }
 
 
+void PlotWrappedEngineBase::configureLegend(NativePlotItem* plotItem, const Ld::PlotFormat& plotFormat) {
+    Ld::PlotFormat::LegendLocation legendLocation = plotFormat.legendLocation();
+    plotItem->setLegendLocation(legendLocation);
+
+    if (legendLocation != Ld::PlotFormat::LegendLocation::NO_LEGEND) {
+        Ld::ChartLineStyle legendLineStyle = plotFormat.legendBorderlineStyle();
+        QPen legendBorderPen(
+            QBrush(validateForegroundColor(legendLineStyle.lineColor())),
+            legendLineStyle.lineWidth(),
+            static_cast<Qt::PenStyle>(legendLineStyle.lineStyle())
+        );
+
+        QColor         legendBackgroundColor = plotFormat.legendBackgroundColor();
+        Ld::FontFormat legendFontFormat      = plotFormat.legendFontFormat();
+        QFont          legendFont            = legendFontFormat.toQFont();
+
+        float fontScaleFactor  = Application::fontScaleFactor();
+        legendFont.setPointSizeF(legendFont.pointSizeF() * fontScaleFactor);
+
+        if (legendBackgroundColor.isValid()) {
+            plotItem->setLegendBrush(QBrush(legendBackgroundColor));
+        } else {
+            plotItem->setLegendBrush(QBrush());
+        }
+
+        plotItem->setLegendFont(legendFont);
+        plotItem->setLegendLabelBrush(QBrush(validateForegroundColor(legendFontFormat.fontColor())));
+        plotItem->setLegendPen(legendBorderPen);
+    }
+}
+
+
 Qt::Alignment PlotWrappedEngineBase::qtAlignmentForAxis(PlotWrappedEngineBase::AxisLocation axisLocation) const {
     Qt::Alignment result;
     switch (axisLocation) {
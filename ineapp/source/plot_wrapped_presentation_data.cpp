@@ -25,7 +25,9 @@
 #include <ld_calculated_value.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "presentation.h"
+#include "native_plot_item.h"
 #include "plot_presentation_data.h"
 #include "plot_wrapped_presentation_data.h"
 
@@ -86,10 +88,12 @@ PlotWrappedPresentationData::PlotWrappedPresentationData(EQt::GraphicsItem* char
 
     currentChartGraphicsItem = chartItem;
     currentChartItem         = dynamic_cast<QChart*>(chartItem);
+    currentNativePlotItem    = dynamic_cast<NativePlotItem*>(chartItem);
 
-    if (currentChartItem != Q_NULLPTR) {
-        group->addToGroup(currentChartItem);
-        currentChartItem->setPos(0, 0);
+    QGraphicsItem* plotItem = plotGraphicsItem();
+    if (plotItem != Q_NULLPTR) {
+        group->addToGroup(plotItem);
+        plotItem->setPos(0, 0);
     }
 
     setGraphicsItem(group);
@@ -104,12 +108,25 @@ PlotWrappedPresentationData::~PlotWrappedPresentationData() {
 
 
 QRectF PlotWrappedPresentationData::boundingRectangle() const {
-    return chartItem()->boundingRect();
+    return plotGraphicsItem()->boundingRect();
 }
 
 
 QRectF PlotWrappedPresentationData::sceneBoundingRectangle() const {
-    return chartItem()->sceneBoundingRect();
+    return plotGraphicsItem()->sceneBoundingRect();
+}
+
+
+QRectF PlotWrappedPresentationData::plotArea() const {
+    QRectF result;
+
+    if (currentChartItem != Q_NULLPTR) {
+        result = currentChartItem->plotArea();
+    } else if (currentNativePlotItem != Q_NULLPTR) {
+        result = currentNativePlotItem->plotArea();
+    }
+
+    return result;
 }
 
 
@@ -121,12 +138,12 @@ void PlotWrappedPresentationData::showErrorMessage(const QString& errorMessage)
     group->setBorderPen(QPen(Presentation::errorBorderColor));
 
     messageFont.setPointSizeF((messageFont.pointSizeF() - 2) * Application::fontScaleFactor());
-    QFontMetricsF messageFontMetrics(messageFont);
+    const QFontMetricsF& messageFontMetrics = FontMetricsCache::fontMetrics(messageFont);
     float messageWidth  = messageFontMetrics.horizontalAdvance(errorMessage);
     float messageAscent = messageFontMetrics.ascent();
     float messageHeight = messageFontMetrics.height();
 
-    QRectF  boundingRectangle = chartItem()->boundingRect();
+    QRectF  boundingRectangle = plotGraphicsItem()->boundingRect();
     QPointF textLocation;
     if (boundingRectangle.isValid()) {
         textLocation = QPointF(
@@ -155,8 +172,9 @@ void PlotWrappedPresentationData::clearErrorMessage() {
 void PlotWrappedPresentationData::setChartItem(EQt::GraphicsItem* chartItem) {
     EQt::GraphicsMultiTextGroup* group = dynamic_cast<EQt::GraphicsMultiTextGroup*>(graphicsItem());
 
-    if (currentChartItem != Q_NULLPTR) {
-        group->removeFromGroup(currentChartItem);
+    QGraphicsItem* oldPlotItem = plotGraphicsItem();
+    if (oldPlotItem != Q_NULLPTR) {
+        group->removeFromGroup(oldPlotItem);
     }
 
     if (currentChartGraphicsItem != Q_NULLPTR) {
@@ -165,10 +183,12 @@ void PlotWrappedPresentationData::setChartItem(EQt::GraphicsItem* chartItem) {
 
     currentChartGraphicsItem = chartItem;
     currentChartItem         = dynamic_cast<QChart*>(chartItem);
+    currentNativePlotItem    = dynamic_cast<NativePlotItem*>(chartItem);
 
-    if (currentChartItem != Q_NULLPTR) {
-        group->addToGroup(currentChartItem);
-        currentChartItem->setPos(0, 0);
+    QGraphicsItem* newPlotItem = plotGraphicsItem();
+    if (newPlotItem != Q_NULLPTR) {
+        group->addToGroup(newPlotItem);
+        newPlotItem->setPos(0, 0);
     }
 }
 
@@ -176,3 +196,21 @@ void PlotWrappedPresentationData::setChartItem(EQt::GraphicsItem* chartItem) {
 QChart* PlotWrappedPresentationData::chartItem() const {
     return currentChartItem;
 }
+
+
+NativePlotItem* PlotWrappedPresentationData::nativePlotItem() const {
+    return currentNativePlotItem;
+}
+
+
+QGraphicsItem* PlotWrappedPresentationData::plotGraphicsItem() const {
+    QGraphicsItem* result;
+
+    if (currentChartItem != Q_NULLPTR) {
+        result = currentChartItem;
+    } else {
+        result = currentNativePlotItem;
+    }
+
+    return result;
+}
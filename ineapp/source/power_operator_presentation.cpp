@@ -14,6 +14,7 @@
 #include <ld_format_structures.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "binary_operator_presentation_base.h"
 #include "power_operator_presentation.h"
 
@@ -58,7 +59,7 @@ EQt::GraphicsMathGroup* PowerOperatorPresentation::updateGraphicsItem(
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     float child0MaximumAscent  = childPresentationAreaData[0].maximumAscent();
     float child0MaximumDescent = childPresentationAreaData[0].maximumDescent();
@@ -49,6 +49,7 @@
 #include <ld_data_type.h>
 #include <ld_element_cursor.h>
 
+#include "font_metrics_cache.h"
 #include "presentation.h"
 
 /***********************************************************************************************************************
@@ -694,7 +695,7 @@ Presentation::ParenthesisData Presentation::leftParenthesisSize(
 
     if (parenthesisStyle != EQt::GraphicsMathGroup::ParenthesisStyle::NONE    &&
         parenthesisStyle != EQt::GraphicsMathGroup::ParenthesisStyle::INVALID    ) {
-        QFontMetricsF fontMetrics(font);
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
         float fontHeight = fontMetrics.height();
         if (useFontBasedParenthesis && contentsHeight <= fontHeight * (1.0F + parenthesisHeightMargin)) {
@@ -717,7 +718,7 @@ Presentation::ParenthesisData Presentation::leftParenthesisSize(
             result.setDrawn();
 
             float descent        = fontMetrics.descent();
-            float fontBasedWidth = fontMetrics.horizontalAdvance(tr("M")) / 2.0F;
+            float fontBasedWidth = FontMetricsCache::entry(font).mWidth() / 2.0F;
 
             result.setRelativePosition(fontMetrics.ascent() - fontMetrics.capHeight());
 
@@ -1035,7 +1036,7 @@ QFont Presentation::scaleFontToHeight(const QFont& font, float height) {
     QFont result = font;
 
     float    fontPointSize    = font.pointSizeF();
-    float    fontHeight       = QFontMetricsF(font).height();
+    float    fontHeight       = FontMetricsCache::entry(font).height();
     unsigned newFontPointSize = static_cast<unsigned>(std::ceil(height * fontPointSize / fontHeight) + 0.5);
 
     result.setPointSize(newFontPointSize);
@@ -1045,8 +1046,8 @@ QFont Presentation::scaleFontToHeight(const QFont& font, float height) {
 
 
 unsigned Presentation::textIndexAtLocation(const QString& text, const QFont& font, float distanceFromLeft) {
-    unsigned      result;
-    QFontMetricsF fontMetrics(font);
+    unsigned             result;
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     unsigned left        = 0;
     unsigned right       = static_cast<unsigned>(text.length());
@@ -1151,13 +1152,13 @@ QPair<unsigned long, unsigned> Presentation::closestText(const QPointF& location
     QFont    bestFont;
 
     while (bestSquaredDistance > 0 && regionIndex < numberTextRegions) {
-        QPointF               position   = displayedTextPosition(regionIndex);
-        QPair<QString, QFont> regionData = textAtDisplayedRegion(regionIndex);
-        const QString&        text       = regionData.first;
-        const QFont&          font       = regionData.second;
-        QFontMetricsF fontMetrics(font);
-        float         width  = fontMetrics.horizontalAdvance(text);
-        float         height = fontMetrics.height();
+        QPointF               position    = displayedTextPosition(regionIndex);
+        QPair<QString, QFont> regionData  = textAtDisplayedRegion(regionIndex);
+        const QString&        text        = regionData.first;
+        const QFont&          font        = regionData.second;
+        const QFontMetricsF&  fontMetrics = FontMetricsCache::fontMetrics(font);
+        float                 width       = fontMetrics.horizontalAdvance(text);
+        float                 height      = fontMetrics.height();
 
         QRectF rectangle;
         if (positionIsBaseline) {
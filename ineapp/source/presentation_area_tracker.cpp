@@ -9,8 +9,11 @@
 
 #include <QList>
 #include <QSizeF>
+#include <QPointF>
 #include <QGraphicsItem>
 
+#include <eqt_graphics_item_group.h>
+
 #include "presentation.h"
 #include "presentation_area_tracker.h"
 
@@ -198,6 +201,77 @@ void PresentationAreaTracker::removeFromScene() {
 }
 
 
+bool PresentationAreaTracker::hasSameLayout(const PresentationAreaTracker& other) const {
+    bool sameLayout = (
+           currentPresentation == other.currentPresentation
+        && currentEntries.size() == other.currentEntries.size()
+    );
+
+    int numberEntries = currentEntries.size();
+    int index         = 0;
+    while (sameLayout && index < numberEntries) {
+        const Entry& entry      = currentEntries.at(index);
+        const Entry& otherEntry = other.currentEntries.at(index);
+
+        sameLayout = (
+               entry.areaId() == otherEntry.areaId()
+            && entry.areaSize() == otherEntry.areaSize()
+            && entry.ascent() == otherEntry.ascent()
+        );
+
+        ++index;
+    }
+
+    return sameLayout;
+}
+
+
+QList<QPointF> PresentationAreaTracker::positions() const {
+    QList<QPointF> result;
+
+    QList<Entry>::const_iterator it  = currentEntries.constBegin();
+    QList<Entry>::const_iterator end = currentEntries.constEnd();
+    while (it != end) {
+        QGraphicsItem* graphicsItem = it->graphicsItem();
+        if (graphicsItem != Q_NULLPTR) {
+            result.append(graphicsItem->pos());
+            ++it;
+        } else {
+            result.clear();
+            it = end;
+        }
+    }
+
+    return result;
+}
+
+
+bool PresentationAreaTracker::restorePositions(
+        EQt::GraphicsItemGroup* graphicsItemGroup,
+        const QList<QPointF>&   positions
+    ) const {
+    bool success = (positions.size() == currentEntries.size());
+
+    int numberEntries = currentEntries.size();
+    int index         = 0;
+    while (success && index < numberEntries) {
+        QGraphicsItem* graphicsItem = currentEntries.at(index).graphicsItem();
+        if (graphicsItem != Q_NULLPTR) {
+            if (graphicsItem->parentItem() != graphicsItemGroup) {
+                graphicsItemGroup->addToGroup(graphicsItem);
+            }
+
+            graphicsItem->setPos(positions.at(index));
+            ++index;
+        } else {
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+
 unsigned long PresentationAreaTracker::numberPresentationAreas() const {
     return static_cast<unsigned long>(currentEntries.size());
 }
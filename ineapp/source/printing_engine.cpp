@@ -17,6 +17,15 @@
 #include <QPageSize>
 #include <QPageLayout>
 #include <QPainter>
+#include <QPicture>
+#include <QImage>
+#include <QSemaphore>
+#include <QFuture>
+#include <QMetaObject>
+#include <QTimer>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QtConcurrent>
 
 #include <QDebug>
 
@@ -27,16 +36,97 @@
 #include <ld_root_element.h>
 #include <ld_page_format.h>
 
+#include "scene_units.h"
+#include "image_cache.h"
+#include "image_picture_recorder.h"
 #include "root_presentation.h"
 #include "printing_engine.h"
 
-const QSizeF PrintingEngine::maximumNoScalingPageSizeDifference(2, 2);
+/***********************************************************************************************************************
+ * PrintingEngine::PageDisplayList
+ */
+
+PrintingEngine::PageDisplayList::PageDisplayList() {
+    currentPageNumber = 0;
+}
+
+
+PrintingEngine::PageDisplayList::PageDisplayList(
+        unsigned                       pageNumber,
+        QSharedPointer<Ld::PageFormat> pageFormat,
+        const QRectF&                  pictureRectangle,
+        const QPicture&                picture
+    ) {
+    currentPageNumber       = pageNumber;
+    currentPageFormat       = pageFormat;
+    currentPictureRectangle = pictureRectangle;
+    currentPicture          = picture;
+}
+
+
+PrintingEngine::PageDisplayList::~PageDisplayList() {}
+
+
+unsigned PrintingEngine::PageDisplayList::pageNumber() const {
+    return currentPageNumber;
+}
+
+
+QSharedPointer<Ld::PageFormat> PrintingEngine::PageDisplayList::pageFormat() const {
+    return currentPageFormat;
+}
+
+
+const QRectF& PrintingEngine::PageDisplayList::pictureRectangle() const {
+    return currentPictureRectangle;
+}
+
+
+const QPicture& PrintingEngine::PageDisplayList::picture() const {
+    return currentPicture;
+}
+
+
+const QImage& PrintingEngine::PageDisplayList::image() const {
+    return currentImage;
+}
+
+
+void PrintingEngine::PageDisplayList::rasterize(unsigned resolution) {
+    double scaleFactor = resolution / 72.0;
+    QSize  imageSize(
+        static_cast<int>(std::ceil(currentPictureRectangle.width() * scaleFactor)),
+        static_cast<int>(std::ceil(currentPictureRectangle.height() * scaleFactor))
+    );
+
+    QImage image(imageSize, QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+    painter.scale(scaleFactor, scaleFactor);
+    painter.translate(-currentPictureRectangle.topLeft());
+    painter.drawPicture(QPointF(0, 0), currentPicture);
+    painter.end();
+
+    currentImage = image;
+}
+
+/***********************************************************************************************************************
+ * PrintingEngine
+ */
+
+const QSizeF   PrintingEngine::maximumNoScalingPageSizeDifference(2, 2);
+const unsigned PrintingEngine::defaultRasterResolution;
 
 PrintingEngine::PrintingEngine(QObject* parent):QThread(parent) {
     currentPrinter = Q_NULLPTR;
     currentRoot.clear();
     currentPageList.clear();
 
+    currentRenderingMode    = RenderingMode::DIRECT;
+    currentRasterResolution = defaultRasterResolution;
+
     abortRequested = false;
     currentStatus  = Status::IDLE;
 }
@@ -53,6 +143,9 @@ PrintingEngine::PrintingEngine(
     currentRoot    = rootElement.toWeakRef();
     currentPageList.clear();
 
+    currentRenderingMode    = RenderingMode::DIRECT;
+    currentRasterResolution = defaultRasterResolution;
+
     abortRequested = false;
     currentStatus  = Status::IDLE;
 }
@@ -70,6 +163,9 @@ PrintingEngine::PrintingEngine(
     currentRoot     = rootElement.toWeakRef();
     currentPageList = pageList;
 
+    currentRenderingMode    = RenderingMode::DIRECT;
+    currentRasterResolution = defaultRasterResolution;
+
     abortRequested = false;
     currentStatus  = Status::IDLE;
 }
@@ -128,6 +224,26 @@ void PrintingEngine::clearPageList() {
 }
 
 
+PrintingEngine::RenderingMode PrintingEngine::renderingMode() const {
+    return currentRenderingMode;
+}
+
+
+void PrintingEngine::setRenderingMode(PrintingEngine::RenderingMode newRenderingMode) {
+    currentRenderingMode = newRenderingMode;
+}
+
+
+unsigned PrintingEngine::rasterResolution() const {
+    return currentRasterResolution;
+}
+
+
+void PrintingEngine::setRasterResolution(unsigned newRasterResolution) {
+    currentRasterResolution = newRasterResolution;
+}
+
+
 bool PrintingEngine::isActive() const {
     return QThread::isRunning();
 }
@@ -235,17 +351,21 @@ void PrintingEngine::run() {
 
         QPainter* painter = Q_NULLPTR;
 
-        pageOrderIndex = 0;
-        while (!abortRequested && error.isEmpty() && pageOrderIndex < numberPagesToPrint) {
-            unsigned pageNumber  = pageList.at(pageOrderIndex);
-            unsigned pageIndex   = pageNumber - 1;
+        if (currentRenderingMode == RenderingMode::DIRECT) {
+            pageOrderIndex = 0;
+            while (!abortRequested && error.isEmpty() && pageOrderIndex < numberPagesToPrint) {
+                unsigned pageNumber  = pageList.at(pageOrderIndex);
+                unsigned pageIndex   = pageNumber - 1;
 
-            error = printPage(printer, painter, root, pageIndex);
+                error = printPage(printer, painter, root, pageIndex);
 
-            if (error.isEmpty()) {
-                emit completedPage(pageOrderIndex, pageNumber);
-                ++pageOrderIndex;
+                if (error.isEmpty()) {
+                    emit completedPage(pageOrderIndex, pageNumber);
+                    ++pageOrderIndex;
+                }
             }
+        } else if (error.isEmpty()) {
+            error = printDisplayLists(printer, painter, root, pageList);
         }
 
         if (painter != Q_NULLPTR) {
@@ -283,6 +403,21 @@ QString PrintingEngine::printPage(
     RootPresentation*              rootPresentation = dynamic_cast<RootPresentation*>(rootElement->visual());
     QSharedPointer<Ld::PageFormat> pageFormat       = rootElement->pageFormat(pageIndex);
 
+    QRectF paperRectangle         = startPage(printer, painter, pageFormat);
+    QRectF pageBoundarySceneUnits = rootPresentation->boundarySceneUnits(pageIndex);
+
+    rootPresentation->render(painter, paperRectangle, pageBoundarySceneUnits, Qt::KeepAspectRatio);
+
+    QString result;
+    if (printer->printerState() == QPrinter::Error) {
+        result = tr("Printer error");
+    }
+
+    return result;
+}
+
+
+QRectF PrintingEngine::startPage(QPrinter* printer, QPainter*& painter, QSharedPointer<Ld::PageFormat> pageFormat) {
     QPageSize requiredPaperSize = pageFormat->toQPageLayout().pageSize();
 
     if (printer->outputFormat() == QPrinter::PdfFormat) {
@@ -312,8 +447,6 @@ QString PrintingEngine::printPage(
         printer->setPageOrientation(requiresPortraitPaper ? QPageLayout::Portrait : QPageLayout::Landscape);
     }
 
-    QRectF pageBoundarySceneUnits = rootPresentation->boundarySceneUnits(pageIndex);
-
     QRectF paperRectangle = printer->paperRect(QPrinter::DevicePixel);
 
     if (painter == Q_NULLPTR) {
@@ -324,7 +457,234 @@ QString PrintingEngine::printPage(
         printer->newPage();
     }
 
-    rootPresentation->render(painter, paperRectangle, pageBoundarySceneUnits, Qt::KeepAspectRatio);
+    return paperRectangle;
+}
+
+
+QString PrintingEngine::printDisplayLists(
+        QPrinter*                       printer,
+        QPainter*&                      painter,
+        QSharedPointer<Ld::RootElement> rootElement,
+        const PageList&                 pageList
+    ) {
+    RootPresentation* rootPresentation = dynamic_cast<RootPresentation*>(rootElement->visual());
+    bool              rasterizePages   = (currentRenderingMode == RenderingMode::RASTER_DISPLAY_LISTS);
+    unsigned          resolution       = currentRasterResolution;
+    int               batchSize        = std::max(1, QThread::idealThreadCount());
+    int               numberPages      = pageList.size();
+    int               nextCaptureIndex = 0;
+    unsigned          pageOrderIndex   = 0;
+    bool              capturePending   = false;
+
+    QString                        error;
+    QSharedPointer<CaptureRequest> captureRequest;
+    QList<PageDisplayList>         currentBatch;
+    QFuture<void>                  rasterization;
+
+    // Pages are handled in batches.  While one batch is being rasterized and spooled, the next batch is captured on
+    // the scene's thread.  Spooling is always done here, in page order, as the printer is not reentrant.
+
+    if (numberPages > 0) {
+        captureRequest    = requestDisplayLists(
+            rootPresentation,
+            rootElement,
+            pageList.mid(0, batchSize),
+            rasterizePages
+        );
+        capturePending    = true;
+        nextCaptureIndex += batchSize;
+    }
+
+    while (capturePending) {
+        capturePending = false;
+
+        if (waitForCapture(rootPresentation, captureRequest)) {
+            currentBatch.swap(captureRequest->displayLists);
+        }
+
+        bool continuePrinting = (!abortRequested && error.isEmpty());
+
+        if (continuePrinting && rasterizePages) {
+            rasterization = QtConcurrent::map(
+                currentBatch,
+                [resolution](PageDisplayList& displayList) {
+                    displayList.rasterize(resolution);
+                }
+            );
+        }
+
+        if (continuePrinting && nextCaptureIndex < numberPages) {
+            PageList nextBatch = pageList.mid(nextCaptureIndex, batchSize);
+
+            captureRequest    = requestDisplayLists(rootPresentation, rootElement, nextBatch, rasterizePages);
+            capturePending    = true;
+            nextCaptureIndex += batchSize;
+        }
+
+        if (continuePrinting && rasterizePages) {
+            rasterization.waitForFinished();
+        }
+
+        for (  QList<PageDisplayList>::const_iterator it  = currentBatch.constBegin(), end = currentBatch.constEnd()
+             ; it != end && !abortRequested && error.isEmpty()
+             ; ++it
+            ) {
+            error = printDisplayList(printer, painter, *it);
+
+            if (error.isEmpty()) {
+                emit completedPage(pageOrderIndex, it->pageNumber());
+                ++pageOrderIndex;
+            }
+        }
+
+        currentBatch.clear();
+    }
+
+    return error;
+}
+
+
+QSharedPointer<PrintingEngine::CaptureRequest> PrintingEngine::requestDisplayLists(
+        RootPresentation*               rootPresentation,
+        QSharedPointer<Ld::RootElement> rootElement,
+        const PageList&                 pageNumbers,
+        bool                            forRaster
+    ) {
+    QSharedPointer<CaptureRequest> request(new CaptureRequest);
+
+    // The capture only holds the shared request.  It may run after this engine has stopped waiting for it, or after
+    // the engine is destroyed, in which case the cancelled flag causes it to do nothing.
+
+    QMetaObject::invokeMethod(
+        rootPresentation,
+        [rootPresentation, rootElement, pageNumbers, forRaster, request]() {
+            captureWhenSettled(rootPresentation, rootElement, pageNumbers, forRaster, request);
+        },
+        Qt::QueuedConnection
+    );
+
+    return request;
+}
+
+
+bool PrintingEngine::waitForCapture(
+        RootPresentation*                              rootPresentation,
+        QSharedPointer<PrintingEngine::CaptureRequest> request
+    ) {
+    bool onSceneThread = (QThread::currentThread() == rootPresentation->thread());
+    bool captured      = false;
+
+    while (!captured && !abortRequested) {
+        if (onSceneThread) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, captureAbortPollingIntervalMSec);
+            captured = request->completed.tryAcquire(1);
+        } else {
+            captured = request->completed.tryAcquire(1, captureAbortPollingIntervalMSec);
+        }
+    }
+
+    if (!captured) {
+        request->cancelled.storeRelease(1);
+    }
+
+    return captured;
+}
+
+
+void PrintingEngine::captureWhenSettled(
+        RootPresentation*                              rootPresentation,
+        QSharedPointer<Ld::RootElement>                rootElement,
+        const PrintingEngine::PageList&                pageNumbers,
+        bool                                           forRaster,
+        QSharedPointer<PrintingEngine::CaptureRequest> request
+    ) {
+    // Images are decoded in the background.  Make certain every image is available at full resolution and that any
+    // repositioning triggered by the decodes has completed before we render.
+
+    ImageCache::waitForPendingDecodes();
+
+    if (request->cancelled.loadAcquire() == 0 && !rootPresentation->isDisplayCoherent()) {
+        QTimer::singleShot(
+            captureSettlePollingIntervalMSec,
+            rootPresentation,
+            [rootPresentation, rootElement, pageNumbers, forRaster, request]() {
+                captureWhenSettled(rootPresentation, rootElement, pageNumbers, forRaster, request);
+            }
+        );
+    } else {
+        for (  PageList::const_iterator it  = pageNumbers.constBegin(), end = pageNumbers.constEnd()
+             ; it != end && request->cancelled.loadAcquire() == 0
+             ; ++it
+            ) {
+            request->displayLists.append(captureDisplayList(rootPresentation, rootElement, *it, forRaster));
+        }
+
+        request->completed.release();
+    }
+}
+
+
+PrintingEngine::PageDisplayList PrintingEngine::captureDisplayList(
+        RootPresentation*               rootPresentation,
+        QSharedPointer<Ld::RootElement> rootElement,
+        unsigned                        pageNumber,
+        bool                            forRaster
+    ) {
+    unsigned                       pageIndex              = pageNumber - 1;
+    QSharedPointer<Ld::PageFormat> pageFormat             = rootElement->pageFormat(pageIndex);
+    QRectF                         pageBoundarySceneUnits = rootPresentation->boundarySceneUnits(pageIndex);
+    QRectF                         pictureRectangle(
+        QPointF(0, 0),
+        SceneUnits::fromScene(pageBoundarySceneUnits.size())
+    );
+
+    QPicture picture;
+    if (forRaster) {
+        ImagePictureRecorder recorder(&picture);
+        QPainter             painter(&recorder);
+        rootPresentation->render(&painter, pictureRectangle, pageBoundarySceneUnits, Qt::KeepAspectRatio);
+        painter.end();
+    } else {
+        QPainter painter(&picture);
+        rootPresentation->render(&painter, pictureRectangle, pageBoundarySceneUnits, Qt::KeepAspectRatio);
+        painter.end();
+    }
+
+    return PageDisplayList(pageNumber, pageFormat, pictureRectangle, picture);
+}
+
+
+QString PrintingEngine::printDisplayList(
+        QPrinter*                              printer,
+        QPainter*&                             painter,
+        const PrintingEngine::PageDisplayList& displayList
+    ) {
+    QRectF paperRectangle   = startPage(printer, painter, displayList.pageFormat());
+    QRectF pictureRectangle = displayList.pictureRectangle();
+
+    // Match the placement used by QGraphicsScene::render with Qt::KeepAspectRatio, scaled to fit and centered.
+
+    double scaleFactor = std::min(
+        paperRectangle.width() / pictureRectangle.width(),
+        paperRectangle.height() / pictureRectangle.height()
+    );
+
+    QSizeF targetSize = pictureRectangle.size() * scaleFactor;
+    QRectF targetRectangle(
+        paperRectangle.center() - QPointF(targetSize.width() / 2.0, targetSize.height() / 2.0),
+        targetSize
+    );
+
+    if (displayList.image().isNull()) {
+        painter->save();
+        painter->translate(targetRectangle.topLeft());
+        painter->scale(scaleFactor, scaleFactor);
+        painter->translate(-pictureRectangle.topLeft());
+        painter->drawPicture(QPointF(0, 0), displayList.picture());
+        painter->restore();
+    } else {
+        painter->drawImage(targetRectangle, displayList.image());
+    }
 
     QString result;
     if (printer->printerState() == QPrinter::Error) {
@@ -333,4 +693,3 @@ QString PrintingEngine::printPage(
 
     return result;
 }
-
@@ -21,6 +21,7 @@
 #include <ld_range_3_visual.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "trinary_operator_presentation_base.h"
 #include "range_3_presentation.h"
 
@@ -68,7 +69,7 @@ EQt::GraphicsMathGroup* Range3Presentation::updateGraphicsItem(
     currentItem->clearText();
 
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     QString commaSeparator   = tr(", ");
     QString elipsesSeparator = tr(",%1, ").arg(QChar(0x2026));
@@ -30,6 +30,7 @@
 #include "ld_value_field_format.h"
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_tracker.h"
 #include "data_type_presentation_generator.h"
 #include "real_data_type_presentation_generator.h"
@@ -117,7 +118,7 @@ float RealDataTypePresentationGenerator::calculateHeight(
     }
 
     font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     if (hasExponent) {
         float        baseFontHeight = fontMetrics.height();
@@ -232,8 +233,8 @@ EQt::GraphicsMultiTextGroup* RealDataTypePresentationGenerator::updateGraphicsIt
             index
         );
     } else {
-        QFontMetricsF fontMetrics(font);
-        QPointF       position(0, fontMetrics.ascent());
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+        QPointF              position(0, fontMetrics.ascent());
         addText(graphicsItem, tr("* ERROR *"), font, position, index);
     }
 
@@ -31,6 +31,7 @@
 #include "application.h"
 #include "fixer.h"
 #include "plug_in_data.h"
+#include "function_search_index.h"
 #include "registrar.h"
 
 Registrar::Registrar() {
@@ -192,15 +193,21 @@ void Registrar::registerFunction(const Ld::FunctionData& functionData) {
     if (!Ld::FunctionDatabase::registerFunction(functionData)) {
         currentlySuccessful = false;
     }
+
+    FunctionSearchIndex::invalidate();
 }
 
 
 Ld::FunctionData& Registrar::function(const QString& internalName) {
+    // The caller receives a modifiable reference into the function database so the index must be rebuilt.
+
+    FunctionSearchIndex::invalidate();
     return Ld::FunctionDatabase::function(internalName);
 }
 
 
 Ld::FunctionData& Registrar::function(const Ld::VariableName& variableName) {
+    FunctionSearchIndex::invalidate();
     return Ld::FunctionDatabase::function(variableName);
 }
 
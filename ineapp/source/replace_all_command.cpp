@@ -0,0 +1,220 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref ReplaceAllCommand class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+
+#include <ld_element_structures.h>
+#include <ld_element_cursor.h>
+#include <ld_cursor_state_collection.h>
+#include <ld_element.h>
+
+#include "command_container.h"
+#include "command.h"
+#include "replace_all_command.h"
+
+/***********************************************************************************************************************
+ * ReplaceAllCommand::Replacement
+ */
+
+ReplaceAllCommand::Replacement::Replacement() {}
+
+
+ReplaceAllCommand::Replacement::Replacement(
+        const Ld::ElementCursor& position,
+        const QString&           oldText,
+        const QString&           newText
+    ) {
+    currentPosition = position;
+    currentOldText  = oldText;
+    currentNewText  = newText;
+}
+
+
+ReplaceAllCommand::Replacement::Replacement(const ReplaceAllCommand::Replacement& other) {
+    currentPosition = other.currentPosition;
+    currentOldText  = other.currentOldText;
+    currentNewText  = other.currentNewText;
+}
+
+
+ReplaceAllCommand::Replacement::~Replacement() {}
+
+
+const Ld::ElementCursor& ReplaceAllCommand::Replacement::position() const {
+    return currentPosition;
+}
+
+
+const QString& ReplaceAllCommand::Replacement::oldText() const {
+    return currentOldText;
+}
+
+
+const QString& ReplaceAllCommand::Replacement::newText() const {
+    return currentNewText;
+}
+
+
+ReplaceAllCommand::Replacement& ReplaceAllCommand::Replacement::operator=(
+        const ReplaceAllCommand::Replacement& other
+    ) {
+    currentPosition = other.currentPosition;
+    currentOldText  = other.currentOldText;
+    currentNewText  = other.currentNewText;
+
+    return *this;
+}
+
+/***********************************************************************************************************************
+ * ReplaceAllCommand
+ */
+
+ReplaceAllCommand::ReplaceAllCommand(const QList<ReplaceAllCommand::Replacement>& replacements) {
+    currentReplacements = replacements;
+    numberApplied       = 0;
+}
+
+
+ReplaceAllCommand::ReplaceAllCommand(
+        const QList<ReplaceAllCommand::Replacement>& replacements,
+        CursorPointer                                newCursor
+    ):CommandBase(
+        newCursor
+    ) {
+    currentReplacements = replacements;
+    numberApplied       = 0;
+}
+
+
+ReplaceAllCommand::~ReplaceAllCommand() {}
+
+
+Command::CommandType ReplaceAllCommand::commandType() const {
+    return Command::CommandType::REPLACE_ALL;
+}
+
+
+bool ReplaceAllCommand::execute(Ld::CursorStateCollection* cursorStateCollection) {
+    bool success = true;
+
+    // Replacements are applied last to first so that the recorded positions of the remaining replacements stay valid
+    // when a replacement changes the length of a region.
+
+    int numberReplacements = currentReplacements.size();
+    while (success && numberApplied < numberReplacements) {
+        const Replacement& replacement = currentReplacements.at(numberReplacements - numberApplied - 1);
+        success = replaceText(
+            replacement.position(),
+            replacement.oldText(),
+            replacement.newText(),
+            cursorStateCollection
+        );
+
+        if (success) {
+            ++numberApplied;
+        }
+    }
+
+    if (!success) {
+        revertApplied(cursorStateCollection);
+    }
+
+    cursorStateCollection->updateCursorState(false);
+
+    return success;
+}
+
+
+bool ReplaceAllCommand::undo(Ld::CursorStateCollection* cursorStateCollection) {
+    bool success = revertApplied(cursorStateCollection);
+    cursorStateCollection->updateCursorState(false);
+
+    return success;
+}
+
+
+QString ReplaceAllCommand::description() const {
+    QString descriptionText;
+
+    if (currentReplacements.isEmpty()) {
+        descriptionText = tr("Replace all");
+    } else {
+        const Replacement& replacement = currentReplacements.first();
+        descriptionText = tr("Replace all \"%1\" with \"%2\" (%3)")
+                          .arg(replacement.oldText())
+                          .arg(replacement.newText())
+                          .arg(currentReplacements.size());
+    }
+
+    return descriptionText;
+}
+
+
+const QList<ReplaceAllCommand::Replacement>& ReplaceAllCommand::replacements() const {
+    return currentReplacements;
+}
+
+
+bool ReplaceAllCommand::revertApplied(Ld::CursorStateCollection* cursorStateCollection) {
+    bool success = true;
+
+    int numberReplacements = currentReplacements.size();
+    while (success && numberApplied > 0) {
+        const Replacement& replacement = currentReplacements.at(numberReplacements - numberApplied);
+        success = replaceText(
+            replacement.position(),
+            replacement.newText(),
+            replacement.oldText(),
+            cursorStateCollection
+        );
+
+        if (success) {
+            --numberApplied;
+        }
+    }
+
+    return success;
+}
+
+
+bool ReplaceAllCommand::replaceText(
+        const Ld::ElementCursor&   position,
+        const QString&             oldText,
+        const QString&             newText,
+        Ld::CursorStateCollection* cursorStateCollection
+    ) {
+    bool               success;
+    Ld::ElementPointer element = position.element();
+
+    if (!element.isNull() && !position.isWholeElement()) {
+        unsigned long textIndex   = position.textIndex();
+        unsigned      regionIndex = position.regionIndex();
+
+        if (oldText.isEmpty()) {
+            success = true;
+        } else {
+            success = element->removeText(
+                textIndex,
+                regionIndex,
+                textIndex + static_cast<unsigned long>(oldText.length()),
+                regionIndex,
+                cursorStateCollection
+            );
+        }
+
+        if (success && !newText.isEmpty()) {
+            element->insertText(newText, textIndex, regionIndex, cursorStateCollection, false);
+        }
+    } else {
+        success = false;
+    }
+
+    return success;
+}
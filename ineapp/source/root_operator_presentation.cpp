@@ -17,6 +17,7 @@
 #include <ld_format_structures.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "root_operator_presentation_base.h"
 #include "root_operator_presentation.h"
 
@@ -145,7 +146,7 @@ EQt::GraphicsMathGroup* RootOperatorPresentation::updateGraphicsItem(
             child1MaximumAscent
         );
 
-        QFontMetricsF fontMetrics(font);
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
         unsigned parenthesisIndex = 0;
         insertLeftParenthesis(leftParenthesisData, 0.0F, 0.0F, currentItem, parenthesisIndex);
         insertRightParenthesis(
@@ -25,6 +25,7 @@
 #include <ld_operator_format.h>
 #include <ld_visual.h>
 
+#include "font_metrics_cache.h"
 #include "unary_operator_presentation_base.h"
 #include "root_operator_presentation_base.h"
 
@@ -335,7 +336,7 @@ RootOperatorPresentationBase::ChildPlacementData RootOperatorPresentationBase::d
     result.setChild0Size(child0Size);
     result.setChild1Size(child1Size);
 
-    QFontMetricsF fontMetrics(operatorFont(format, relativeScale));
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(operatorFont(format, relativeScale));
     float fontHeight    = fontMetrics.height();
     float fontAscent    = fontMetrics.ascent();
     float fontCapHeight = fontMetrics.capHeight();
@@ -9,6 +9,8 @@
 
 #include <QSharedPointer>
 #include <QGraphicsItem>
+#include <QGraphicsPixmapItem>
+#include <QPixmap>
 #include <QGraphicsView>
 #include <QList>
 #include <QRect>
@@ -37,8 +39,12 @@
 #include "presentation.h"
 #include "page_list.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
+#include "latency_tracer.h"
+#include "memory_governor.h"
 #include "placement_status_notifier.h"
 #include "placement_negotiator.h"
+#include "document_text_index.h"
 #include "root_presentation.h"
 
 RootPresentation::RootPresentation(QObject* parent):EQt::GraphicsScene(parent) {
@@ -198,6 +204,9 @@ RootPresentation::RootPresentation(QObject* parent):EQt::GraphicsScene(parent) {
     recalculateAllChildPositions       = true;
     repositionInProgress               = false;
     repositionRequestPending           = false;
+    repositioningBatchDepth            = 0;
+    currentSceneReleased               = false;
+    currentPlacementGeneration         = 0;
 
     currentMaximumHorizontalExtentPoints = 0;
     currentPresentationUpdatesPending    = false;
@@ -212,7 +221,10 @@ RootPresentation::RootPresentation(QObject* parent):EQt::GraphicsScene(parent) {
 }
 
 
-RootPresentation::~RootPresentation() {}
+RootPresentation::~RootPresentation() {
+    LatencyTracer::documentClosed(this);
+    MemoryGovernor::documentClosed(this);
+}
 
 
 Ld::Visual* RootPresentation::creator(const QString&) {
@@ -256,17 +268,69 @@ Ld::Element::ChildPlacement RootPresentation::childPlacement() const {
 
 
 void RootPresentation::requestRepositioning(Presentation* childPresentation) {
-    QSharedPointer<Ld::RootElement> rootElement    = element();
-    Ld::ElementPointer              childElement   = childPresentation->element();
-    unsigned long                   childIndex     = 0;
-    unsigned long                   numberChildren = rootElement->numberChildren();
+    if (repositioningBatchDepth > 0) {
+        batchedRepositioningRequests.insert(childPresentation->element());
+    } else {
+        QSharedPointer<Ld::RootElement> rootElement    = element();
+        Ld::ElementPointer              childElement   = childPresentation->element();
+        unsigned long                   childIndex     = 0;
+        unsigned long                   numberChildren = rootElement->numberChildren();
+
+        while (childIndex < numberChildren && rootElement->child(childIndex) != childElement) {
+            ++childIndex;
+        }
 
-    while (childIndex < numberChildren && rootElement->child(childIndex) != childElement) {
-        ++childIndex;
+        if (childIndex < numberChildren) {
+            requestRepositioning(childIndex);
+        }
     }
+}
 
-    if (childIndex < numberChildren) {
-        requestRepositioning(childIndex);
+
+void RootPresentation::beginRepositioningBatch() {
+    ++repositioningBatchDepth;
+}
+
+
+void RootPresentation::endRepositioningBatch() {
+    Q_ASSERT(repositioningBatchDepth > 0);
+
+    --repositioningBatchDepth;
+    if (repositioningBatchDepth == 0 && !batchedRepositioningRequests.isEmpty()) {
+        QSharedPointer<Ld::RootElement> rootElement     = element();
+        unsigned long                   numberChildren  = rootElement->numberChildren();
+        int                             numberRequests  = batchedRepositioningRequests.size();
+        int                             numberFound     = 0;
+        unsigned long                   firstChildIndex = static_cast<unsigned long>(-1);
+        unsigned long                   lastChildIndex  = static_cast<unsigned long>(-1);
+        unsigned long                   childIndex      = 0;
+
+        // One sweep over the children replaces the per-request search performed outside of a batch.  Children
+        // removed during the batch are simply not found.
+
+        while (childIndex < numberChildren && numberFound < numberRequests) {
+            if (batchedRepositioningRequests.contains(rootElement->child(childIndex))) {
+                if (firstChildIndex == static_cast<unsigned long>(-1)) {
+                    firstChildIndex = childIndex;
+                }
+
+                lastChildIndex = childIndex;
+                ++numberFound;
+            }
+
+            ++childIndex;
+        }
+
+        batchedRepositioningRequests.clear();
+
+        if (firstChildIndex != static_cast<unsigned long>(-1)) {
+            if (lastChildForRepositioning == static_cast<unsigned long>(-1) ||
+                lastChildForRepositioning < lastChildIndex                     ) {
+                lastChildForRepositioning = lastChildIndex;
+            }
+
+            requestRepositioning(firstChildIndex);
+        }
     }
 }
 
@@ -320,6 +384,8 @@ void RootPresentation::allocateArea(
 
 
 void RootPresentation::areaInsufficient(unsigned long childIdentifier, const QSizeF& size) {
+    PlacementProfiler::areaInsufficient();
+
     cursorY += size.height();
 
     currentChildLocations[childIdentifier].setBottomLocation(currentPageIndex, cursorY);
@@ -371,6 +437,12 @@ bool RootPresentation::arePresentationUpdatesPending() const {
 }
 
 
+DocumentTextIndex& RootPresentation::textIndex() {
+    currentTextIndex.setRootElement(element());
+    return currentTextIndex;
+}
+
+
 QList<QGraphicsView*> RootPresentation::viewsShowingElement(Ld::ElementPointer element) {
     PlacementNegotiator*  placementNegotiator = dynamic_cast<PlacementNegotiator*>(element->visual());
     QList<QGraphicsView*> allViews            = views();
@@ -630,6 +702,68 @@ bool RootPresentation::isDisplayCoherent() const {
 }
 
 
+unsigned long long RootPresentation::estimatedSceneBytes() const {
+    // Rough per item cost of the item, its private data and its entry in the scene.
+    static constexpr unsigned long long bytesPerItem = 512;
+
+    unsigned long long    result     = 0;
+    QList<QGraphicsItem*> sceneItems = items();
+
+    for (  QList<QGraphicsItem*>::const_iterator it = sceneItems.constBegin(), end = sceneItems.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        result += bytesPerItem;
+
+        const QGraphicsPixmapItem* pixmapItem = dynamic_cast<const QGraphicsPixmapItem*>(*it);
+        if (pixmapItem != Q_NULLPTR) {
+            const QPixmap& pixmap = pixmapItem->pixmap();
+            result += static_cast<unsigned long long>(pixmap.width()) * pixmap.height() * ((pixmap.depth() + 7) / 8);
+        }
+    }
+
+    return result;
+}
+
+
+bool RootPresentation::releaseScene() {
+    bool released = !currentSceneReleased && !repositionInProgress;
+
+    if (released) {
+        currentSceneReleased = true;
+        ++currentPlacementGeneration;
+        repositionTimer->stop();
+
+        removeDescendantsFromScene(element());
+        resetPlacement();
+        recalculateAllChildPositions = true;
+
+        // Hold a pending request so that the display is reported as incoherent until the scene is restored.
+        requestRepositioning();
+    }
+
+    return released;
+}
+
+
+void RootPresentation::restoreScene() {
+    if (currentSceneReleased) {
+        currentSceneReleased = false;
+        requestRepositioning();
+    }
+}
+
+
+bool RootPresentation::isSceneReleased() const {
+    return currentSceneReleased;
+}
+
+
+unsigned long long RootPresentation::placementGeneration() const {
+    return currentPlacementGeneration;
+}
+
+
 void RootPresentation::redraw() {
     resetPlacement();
     requestRepositioning();
@@ -787,6 +921,7 @@ void RootPresentation::performRepositioning() {
         bool abortRequested;
 
         repositionInProgress = true;
+        ++currentPlacementGeneration;
 
         bool          terminateEarly       = false;
         unsigned long numberChildLocations = static_cast<unsigned>(currentChildLocations.size());
@@ -836,6 +971,8 @@ void RootPresentation::performRepositioning() {
             Q_ASSERT(currentChildIndex <= lastChildIndex);
 
             placementStatusNotifier->placementStarted(numberChildLocations - currentChildIndex);
+            PlacementProfiler::repositioningStarted(this);
+            LatencyTracer::placementStarted(this);
             terminateEarly = false;
 
             do {
@@ -956,6 +1093,8 @@ void RootPresentation::performRepositioning() {
                 );
             }
 
+            PlacementProfiler::repositioningCompleted(this);
+            LatencyTracer::placementCompleted(this);
             placementStatusNotifier->placementCompleted();
         } while (repositionRequestPending);
 
@@ -973,23 +1112,31 @@ void RootPresentation::performRepositioning() {
             currentPresentationUpdatesPending = false;
             emit presentationUpdatesCompleted();
         }
+
+        MemoryGovernor::repositioningFinished(this);
     }
 }
 
 
 void RootPresentation::elementChanged(Ld::ElementPointer changedElement) {
+    currentTextIndex.elementChanged(changedElement);
+
     Presentation* changedPresentation = dynamic_cast<Presentation*>(changedElement->visual());
     emit presentationChanged(changedPresentation);
 }
 
 
 void RootPresentation::elementAdded(Ld::ElementPointer newElement) {
+    currentTextIndex.elementAdded(newElement);
+
     Presentation* newPresentation = dynamic_cast<Presentation*>(newElement->visual());
     emit presentationAdded(newPresentation);
 }
 
 
 void RootPresentation::elementRemoved(Ld::ElementPointer removedElement) {
+    currentTextIndex.elementRemoved(removedElement);
+
     Presentation* removedPresentation = dynamic_cast<Presentation*>(removedElement->visual());
     emit presentationRemoved(removedPresentation);
 }
@@ -1151,6 +1298,26 @@ void RootPresentation::removeFromScene() {
 }
 
 
+void RootPresentation::removeDescendantsFromScene(Ld::ElementPointer element) {
+    Ld::ElementPointerList childElements = element->children();
+
+    for (  Ld::ElementPointerList::const_iterator it  = childElements.constBegin(), end = childElements.constEnd()
+         ; it != end
+         ; ++it
+           ) {
+        Ld::ElementPointer childElement = *it;
+        if (!childElement.isNull()) {
+            removeDescendantsFromScene(childElement);
+
+            Presentation* childPresentation = dynamic_cast<Presentation*>(childElement->visual());
+            if (childPresentation != Q_NULLPTR) {
+                childPresentation->removeFromScene();
+            }
+        }
+    }
+}
+
+
 QRectF RootPresentation::activeAreaRectangle(unsigned long pageIndex) {
     QSharedPointer<Ld::RootElement> rootElement = element();
 
@@ -1185,7 +1352,7 @@ void RootPresentation::requestRepositioning(unsigned long childIndex) {
     repositionRequestPending = true;
 
     if (!repositionInProgress) {
-        if (!repositionTimer->isActive()) {
+        if (!currentSceneReleased && !repositionTimer->isActive()) {
             repositionTimer->start(0);
         }
     } else {
@@ -1251,6 +1418,7 @@ void RootPresentation::recalculateChildPlacement(
         float              minimumTopSpacing
     ) {
     childLocation.setTopLocation(currentPageIndex, cursorY, minimumTopSpacing);
+    PlacementProfiler::Scope profilerScope(childPresentation);
     childPresentation->recalculatePlacement(
         placementTracker,
         this,
@@ -0,0 +1,388 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref SceneTileCache class.
+***********************************************************************************************************************/
+
+#include <QRect>
+#include <QRectF>
+#include <QPointF>
+#include <QRegion>
+#include <QPixmap>
+#include <QPainter>
+#include <QTransform>
+#include <QBrush>
+#include <QWidget>
+#include <QGraphicsView>
+#include <QHash>
+#include <QMap>
+#include <QList>
+#include <QSet>
+
+#include <cmath>
+#include <algorithm>
+
+#include <util_hash_functions.h>
+
+#include "app_common.h"
+#include "page_list.h"
+#include "root_presentation.h"
+#include "scene_tile_cache.h"
+
+/***********************************************************************************************************************
+ * SceneTileCache::Key
+ */
+
+SceneTileCache::Key::Key() {
+    pageIndex = 0;
+    column    = 0;
+    row       = 0;
+    zoomKey   = 0;
+}
+
+
+SceneTileCache::Key::Key(PageList::Index pageIndex, int column, int row, int zoomKey) {
+    Key::pageIndex = pageIndex;
+    Key::column    = column;
+    Key::row       = row;
+    Key::zoomKey   = zoomKey;
+}
+
+
+bool SceneTileCache::Key::operator==(const Key& other) const {
+    return (
+           pageIndex == other.pageIndex
+        && column == other.column
+        && row == other.row
+        && zoomKey == other.zoomKey
+    );
+}
+
+/***********************************************************************************************************************
+ * SceneTileCache
+ */
+
+SceneTileCache::SceneTileCache() {
+    useCounter          = 0;
+    currentMaximumBytes = defaultMaximumBytes;
+    currentBytesInUse   = 0;
+}
+
+
+SceneTileCache::~SceneTileCache() {}
+
+
+void SceneTileCache::setMaximumBytes(unsigned long long newMaximumBytes) {
+    currentMaximumBytes = newMaximumBytes;
+    trim();
+}
+
+
+unsigned long long SceneTileCache::maximumBytes() const {
+    return currentMaximumBytes;
+}
+
+
+unsigned long long SceneTileCache::bytesInUse() const {
+    return currentBytesInUse;
+}
+
+
+unsigned long SceneTileCache::numberTiles() const {
+    return static_cast<unsigned long>(tiles.size());
+}
+
+
+QRegion SceneTileCache::draw(
+        QPainter*             painter,
+        const QRegion&        viewportRegion,
+        const QGraphicsView*  view,
+        RootPresentation*     rootPresentation,
+        const QBrush&         background
+    ) {
+    QRegion    uncovered        = viewportRegion;
+    QTransform transform        = view->viewportTransform();
+    int        currentZoomKey   = zoomKey(view);
+    qreal      devicePixelRatio = view->viewport()->devicePixelRatioF();
+    double     tileSceneSize    = tileSize / scaleForZoomKey(currentZoomKey);
+    QRectF     sceneBounds      = transform.inverted().mapRect(QRectF(viewportRegion.boundingRect()));
+
+    PageList::Index pageIndex   = 0;
+    QRectF          pageExtents = rootPresentation->extentsSceneUnits(pageIndex);
+    while (!pageExtents.isNull()) {
+        if (pageExtents.intersects(sceneBounds)) {
+            QRect   pageViewportRectangle = transform.mapRect(pageExtents).toAlignedRect();
+            QRegion pageRegion            = viewportRegion.intersected(pageViewportRectangle);
+
+            if (!pageRegion.isEmpty()) {
+                uncovered -= pageRegion;
+
+                painter->save();
+                painter->setClipRegion(pageRegion, Qt::IntersectClip);
+
+                QPointF pageOrigin  = pageExtents.topLeft();
+                QRectF  area        = sceneBounds.intersected(pageExtents);
+                int     firstColumn = std::max(0, static_cast<int>((area.left() - pageOrigin.x()) / tileSceneSize));
+                int     lastColumn  = static_cast<int>((area.right() - pageOrigin.x()) / tileSceneSize);
+                int     firstRow    = std::max(0, static_cast<int>((area.top() - pageOrigin.y()) / tileSceneSize));
+                int     lastRow     = static_cast<int>((area.bottom() - pageOrigin.y()) / tileSceneSize);
+
+                for (int row=firstRow ; row<=lastRow ; ++row) {
+                    for (int column=firstColumn ; column<=lastColumn ; ++column) {
+                        Key    key(pageIndex, column, row, currentZoomKey);
+                        QRectF sceneRectangle = tileSceneRectangle(key, pageOrigin);
+                        QPoint tileCorner     = transform.map(sceneRectangle.topLeft()).toPoint();
+                        QRect  tileRectangle(tileCorner, QSize(tileSize, tileSize));
+
+                        if (pageRegion.intersects(tileRectangle)) {
+                            QHash<Key, Tile>::iterator it = tiles.find(key);
+                            if (it != tiles.end()                                        &&
+                                (it->pageOrigin != pageOrigin                         ||
+                                 it->pixmap.devicePixelRatio() != devicePixelRatio    )    ) {
+                                // The page moved, or the view moved to another screen, since the tile was rendered.
+                                removeTile(it);
+                                it = tiles.end();
+                            }
+
+                            if (it != tiles.end()) {
+                                touch(key, it.value());
+                                painter->drawPixmap(tileRectangle.topLeft(), it->pixmap);
+                            } else {
+                                QRect neededRectangle = tileRectangle.intersected(pageViewportRectangle);
+                                if (drawScaled(painter, key, pageOrigin, neededRectangle, view)) {
+                                    if (!queuedTiles.contains(key)) {
+                                        queuedTiles.insert(key);
+                                        pendingRefinements.append(key);
+                                    }
+                                } else {
+                                    const Tile& tile = renderTile(key, pageOrigin, view, rootPresentation, background);
+                                    painter->drawPixmap(tileRectangle.topLeft(), tile.pixmap);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                painter->restore();
+            }
+        }
+
+        ++pageIndex;
+        pageExtents = rootPresentation->extentsSceneUnits(pageIndex);
+    }
+
+    return uncovered;
+}
+
+
+bool SceneTileCache::refinementPending() const {
+    return !pendingRefinements.isEmpty();
+}
+
+
+QRegion SceneTileCache::refine(
+        const QGraphicsView* view,
+        RootPresentation*    rootPresentation,
+        const QBrush&        background
+    ) {
+    QRegion    refinedRegion;
+    QTransform transform      = view->viewportTransform();
+    QRect      viewportBounds = view->viewport()->rect();
+    int        currentZoomKey = zoomKey(view);
+    unsigned   numberRendered = 0;
+
+    while (numberRendered < tilesPerRefinement && !pendingRefinements.isEmpty()) {
+        Key key = pendingRefinements.takeFirst();
+        queuedTiles.remove(key);
+
+        if (key.zoomKey == currentZoomKey && !tiles.contains(key)) {
+            QRectF pageExtents = rootPresentation->extentsSceneUnits(key.pageIndex);
+            if (!pageExtents.isNull()) {
+                const Tile& tile = renderTile(key, pageExtents.topLeft(), view, rootPresentation, background);
+                QRect       area = transform.mapRect(tile.sceneRectangle).toAlignedRect().intersected(viewportBounds);
+
+                refinedRegion += area;
+                ++numberRendered;
+            }
+        }
+    }
+
+    return refinedRegion;
+}
+
+
+void SceneTileCache::invalidate(const QRectF& sceneRectangle) {
+    // Anti-aliased edges can extend just past the reported area, and QRectF::intersects ignores zero width
+    // rectangles, so we grow the area slightly.
+    QRectF changedArea = sceneRectangle.adjusted(-1, -1, 1, 1);
+
+    QHash<Key, Tile>::iterator it = tiles.begin();
+    while (it != tiles.end()) {
+        if (it->sceneRectangle.intersects(changedArea)) {
+            it = removeTile(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+
+void SceneTileCache::clear() {
+    tiles.clear();
+    tilesByUse.clear();
+    pendingRefinements.clear();
+    queuedTiles.clear();
+
+    currentBytesInUse = 0;
+}
+
+
+int SceneTileCache::zoomKey(const QGraphicsView* view) {
+    return static_cast<int>(std::round(view->viewportTransform().m11() * 1024.0));
+}
+
+
+double SceneTileCache::scaleForZoomKey(int zoomKey) {
+    return zoomKey / 1024.0;
+}
+
+
+QRectF SceneTileCache::tileSceneRectangle(const Key& key, const QPointF& pageOrigin) {
+    double tileSceneSize = tileSize / scaleForZoomKey(key.zoomKey);
+    return QRectF(
+        pageOrigin.x() + key.column * tileSceneSize,
+        pageOrigin.y() + key.row * tileSceneSize,
+        tileSceneSize,
+        tileSceneSize
+    );
+}
+
+
+const SceneTileCache::Tile& SceneTileCache::renderTile(
+        const Key&            key,
+        const QPointF&        pageOrigin,
+        const QGraphicsView*  view,
+        RootPresentation*     rootPresentation,
+        const QBrush&         background
+    ) {
+    qreal devicePixelRatio = view->viewport()->devicePixelRatioF();
+    QRect tileRectangle(0, 0, tileSize, tileSize);
+
+    Tile tile;
+    tile.sceneRectangle = tileSceneRectangle(key, pageOrigin);
+    tile.pageOrigin     = pageOrigin;
+    tile.pixmap         = QPixmap(
+        static_cast<int>(std::ceil(tileSize * devicePixelRatio)),
+        static_cast<int>(std::ceil(tileSize * devicePixelRatio))
+    );
+    tile.pixmap.setDevicePixelRatio(devicePixelRatio);
+
+    QPainter painter(&tile.pixmap);
+    painter.setRenderHints(view->renderHints());
+    painter.fillRect(tileRectangle, background);
+    rootPresentation->render(&painter, QRectF(tileRectangle), tile.sceneRectangle, Qt::IgnoreAspectRatio);
+    painter.end();
+
+    QHash<Key, Tile>::iterator it = tiles.find(key);
+    if (it != tiles.end()) {
+        removeTile(it);
+    }
+
+    currentBytesInUse += static_cast<unsigned long long>(tile.pixmap.width())
+                         * tile.pixmap.height()
+                         * ((tile.pixmap.depth() + 7) / 8);
+
+    tile.lastUse = ++useCounter;
+    tilesByUse.insert(tile.lastUse, key);
+    it = tiles.insert(key, tile);
+
+    trim();
+
+    return it.value();
+}
+
+
+bool SceneTileCache::drawScaled(
+        QPainter*             painter,
+        const Key&            key,
+        const QPointF&        pageOrigin,
+        const QRect&          viewportRectangle,
+        const QGraphicsView*  view
+    ) {
+    QTransform         transform      = view->viewportTransform();
+    QRectF             sceneRectangle = tileSceneRectangle(key, pageOrigin);
+    QRegion            uncovered(viewportRectangle);
+    QList<const Tile*> candidates;
+
+    for (  QHash<Key, Tile>::const_iterator it = tiles.constBegin(), end = tiles.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        const Key&  candidateKey = it.key();
+        const Tile& candidate    = it.value();
+
+        if (candidateKey.pageIndex == key.pageIndex                   &&
+            candidateKey.zoomKey != key.zoomKey                       &&
+            candidate.pageOrigin == pageOrigin                        &&
+            candidate.sceneRectangle.intersects(sceneRectangle)          ) {
+            candidates.append(&candidate);
+            uncovered -= transform.mapRect(candidate.sceneRectangle).toRect();
+        }
+    }
+
+    bool covered = uncovered.isEmpty();
+    if (covered) {
+        painter->save();
+        painter->setClipRect(viewportRectangle, Qt::IntersectClip);
+        painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+        for (  QList<const Tile*>::const_iterator it = candidates.constBegin(), end = candidates.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            const Tile* candidate = *it;
+            painter->drawPixmap(
+                transform.mapRect(candidate->sceneRectangle),
+                candidate->pixmap,
+                QRectF(candidate->pixmap.rect())
+            );
+        }
+
+        painter->restore();
+    }
+
+    return covered;
+}
+
+
+void SceneTileCache::touch(const Key& key, Tile& tile) {
+    tilesByUse.remove(tile.lastUse);
+
+    tile.lastUse = ++useCounter;
+    tilesByUse.insert(tile.lastUse, key);
+}
+
+
+QHash<SceneTileCache::Key, SceneTileCache::Tile>::iterator SceneTileCache::removeTile(
+        QHash<Key, Tile>::iterator it
+    ) {
+    const QPixmap& pixmap = it->pixmap;
+    currentBytesInUse -= static_cast<unsigned long long>(pixmap.width())
+                         * pixmap.height()
+                         * ((pixmap.depth() + 7) / 8);
+
+    tilesByUse.remove(it->lastUse);
+    return tiles.erase(it);
+}
+
+
+void SceneTileCache::trim() {
+    // The most recently used tile is always kept so a tile just rendered can be drawn.
+    while (currentBytesInUse > currentMaximumBytes && tiles.size() > 1) {
+        QMap<unsigned long long, Key>::iterator oldest = tilesByUse.begin();
+        removeTile(tiles.find(oldest.value()));
+    }
+}
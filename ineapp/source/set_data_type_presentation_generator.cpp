@@ -8,6 +8,7 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QVector>
 #include <QGraphicsItem>
 #include <QFont>
 #include <QColor>
@@ -31,6 +32,7 @@
 #include <ld_value_field_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_tracker.h"
 #include "data_type_presentation_generator.h"
 #include "set_data_type_presentation_generator.h"
@@ -50,78 +52,72 @@ float SetDataTypePresentationGenerator::calculateHeight(
         float                 relativeScale,
         float*                ascent
     ) const {
-    unsigned long leadingMemberCount;
-    unsigned long trailingMemberCount;
-    unsigned long hiddenMemberCount;
-    QFont         font;
-
-    if (!format.isNull()                                                         &&
-        (format->capabilities().contains(Ld::SetDataTypeFormat::formatName) ||
-         format->capabilities().contains(Ld::ValueFieldFormat::formatName)     )    ) {
-        QSharedPointer<Ld::SetDataTypeFormat> setFormat = format.dynamicCast<Ld::SetDataTypeFormat>();
+    float result;
+    float maximumAscent;
+
+    if (!cachedHeight(variant, format, relativeScale, result, maximumAscent)) {
+        unsigned long leadingMemberCount;
+        unsigned long trailingMemberCount;
+        unsigned long hiddenMemberCount;
+        QFont         font;
+
+        if (!format.isNull()                                                         &&
+            (format->capabilities().contains(Ld::SetDataTypeFormat::formatName) ||
+             format->capabilities().contains(Ld::ValueFieldFormat::formatName)     )    ) {
+            QSharedPointer<Ld::SetDataTypeFormat> setFormat = format.dynamicCast<Ld::SetDataTypeFormat>();
+
+            leadingMemberCount  = setFormat->leadingMemberCount();
+            trailingMemberCount = setFormat->trailingMemberCount();
+            font                = setFormat->toQFont();
+        } else {
+            leadingMemberCount  = Ld::SetDataTypeFormat::defaultLeadingMemberCount;
+            trailingMemberCount = Ld::SetDataTypeFormat::defaultTrailingMemberCount;
 
-        leadingMemberCount  = setFormat->leadingMemberCount();
-        trailingMemberCount = setFormat->trailingMemberCount();
-        font                = setFormat->toQFont();
-    } else {
-        leadingMemberCount  = Ld::SetDataTypeFormat::defaultLeadingMemberCount;
-        trailingMemberCount = Ld::SetDataTypeFormat::defaultTrailingMemberCount;
+            QSharedPointer<Ld::CharacterFormat> defaultFont = Ld::CharacterFormat::applicationDefaultMathFont();
+            font = defaultFont->toQFont();
+        }
 
-        QSharedPointer<Ld::CharacterFormat> defaultFont = Ld::CharacterFormat::applicationDefaultMathFont();
-        font = defaultFont->toQFont();
-    }
+        bool       ok;
+        Model::Set setValue = variant.toSet(&ok);
+        Q_ASSERT(ok);
+
+        unsigned long numberSetMembers = setValue.size();
+        if (leadingMemberCount == Ld::SetDataTypeFormat::showAllMembers  ||
+            trailingMemberCount == Ld::SetDataTypeFormat::showAllMembers ||
+            leadingMemberCount + trailingMemberCount >= numberSetMembers    ) {
+            leadingMemberCount  = numberSetMembers;
+            hiddenMemberCount   = 0;
+            trailingMemberCount = 0;
+        } else {
+            hiddenMemberCount = numberSetMembers - leadingMemberCount - trailingMemberCount;
+        }
 
-    bool       ok;
-    Model::Set setValue = variant.toSet(&ok);
-    Q_ASSERT(ok);
+        MemberList members = visibleMembers(setValue, leadingMemberCount, hiddenMemberCount, trailingMemberCount);
+
+        font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+        float maximumDescent = fontMetrics.descent();
+        maximumAscent = fontMetrics.ascent();
+
+        // The member list is local so we can't cache the member measurements.
+        calculateMaximumChildHeight(
+            placementTracker,
+            members,
+            format,
+            relativeScale,
+            false,
+            maximumAscent,
+            maximumDescent
+        );
 
-    unsigned long numberSetMembers = setValue.size();
-    if (leadingMemberCount == Ld::SetDataTypeFormat::showAllMembers  ||
-        trailingMemberCount == Ld::SetDataTypeFormat::showAllMembers ||
-        leadingMemberCount + trailingMemberCount >= numberSetMembers    ) {
-        leadingMemberCount  = numberSetMembers;
-        hiddenMemberCount   = 0;
-        trailingMemberCount = 0;
-    } else {
-        hiddenMemberCount = numberSetMembers - leadingMemberCount - trailingMemberCount;
+        result = maximumAscent + maximumDescent;
     }
 
-    font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
-    QFontMetricsF fontMetrics(font);
-    float maximumAscent  = fontMetrics.ascent();
-    float maximumDescent = fontMetrics.descent();
-
-    Model::Set::ConstIterator setIterator = setValue.constBegin();
-
-    placementTracker->addNewJobs(leadingMemberCount + trailingMemberCount);
-
-    calculateMaximumChildHeight(
-        placementTracker,
-        setIterator,
-        leadingMemberCount,
-        format,
-        relativeScale,
-        maximumAscent,
-        maximumDescent
-    );
-
-    setIterator.advance(hiddenMemberCount);
-
-    calculateMaximumChildHeight(
-        placementTracker,
-        setIterator,
-        trailingMemberCount,
-        format,
-        relativeScale,
-        maximumAscent,
-        maximumDescent
-    );
-
     if (ascent != Q_NULLPTR) {
         *ascent = maximumAscent;
     }
 
-    return maximumAscent + maximumDescent;
+    return result;
 }
 
 
@@ -135,6 +131,8 @@ DataTypePresenter::PresentationAreas SetDataTypePresentationGenerator::generateG
         float                                 relativeScale,
         bool                                  forceAppend
     ) const {
+    MeasurementScope measurementScope;
+
     if (!forceAppend) {
         for (  DataTypePresenter::PresentationAreas::iterator areaIterator    = currentPresentationAreas.begin(),
                                                               areaEndIterator = currentPresentationAreas.end()
@@ -206,12 +204,35 @@ DataTypePresenter::PresentationAreas SetDataTypePresentationGenerator::generateG
     float pointSize = font.pointSizeF() * Application::fontScaleFactor();
     font.setPointSizeF(pointSize * relativeScale);
 
-    float maximumChildHeight = calculateHeight(placementTracker, variant, format, relativeScale);
+    // The set is walked once.  Heights measured for the members are reused when the members are rendered.
+
+    MemberList members = visibleMembers(setValue, leadingMemberCount, hiddenMemberCount, trailingMemberCount);
+
+    float maximumChildHeight;
+    float maximumChildAscent;
+    if (!cachedHeight(variant, format, relativeScale, maximumChildHeight, maximumChildAscent)) {
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+        float maximumChildDescent = fontMetrics.descent();
+        maximumChildAscent = fontMetrics.ascent();
+
+        calculateMaximumChildHeight(
+            placementTracker,
+            members,
+            format,
+            relativeScale,
+            true,
+            maximumChildAscent,
+            maximumChildDescent
+        );
+
+        maximumChildHeight = maximumChildAscent + maximumChildDescent;
+    }
+
     currentPresentationAreas = renderWrapped(
         placementTracker,
         currentPresentationAreas,
         presenter,
-        setValue,
+        members,
         format,
         font,
         fontColor,
@@ -251,7 +272,7 @@ DataTypePresenter::PresentationAreas SetDataTypePresentationGenerator::renderWra
         PlacementTracker*                     placementTracker,
         DataTypePresenter::PresentationAreas& currentPresentationAreas,
         DataTypePresenter*                    presenter,
-        const Model::Set&                     set,
+        const MemberList&                     members,
         Ld::FormatPointer                     format,
         const QFont&                          font,
         const QColor&                         fontColor,
@@ -275,12 +296,11 @@ DataTypePresenter::PresentationAreas SetDataTypePresentationGenerator::renderWra
         fontBackgroundColor
     );
 
-    Model::Set::ConstIterator setIterator = set.constBegin();
-
     bool isFirstEntry = true;
     renderSetMembers(
         placementTracker,
-        setIterator,
+        members,
+        0,
         leadingMemberCount,
         isFirstEntry,
         currentPresentationAreas,
@@ -324,13 +344,12 @@ DataTypePresenter::PresentationAreas SetDataTypePresentationGenerator::renderWra
             fontBackgroundColor,
             lineSpacing
         );
-
-        setIterator.advance(hiddenMemberCount);
     }
 
     renderSetMembers(
         placementTracker,
-        setIterator,
+        members,
+        leadingMemberCount,
         trailingMemberCount,
         isFirstEntry,
         currentPresentationAreas,
@@ -358,18 +377,49 @@ DataTypePresenter::PresentationAreas SetDataTypePresentationGenerator::renderWra
 }
 
 
+SetDataTypePresentationGenerator::MemberList SetDataTypePresentationGenerator::visibleMembers(
+        const Model::Set& set,
+        unsigned long     leadingMemberCount,
+        unsigned long     hiddenMemberCount,
+        unsigned long     trailingMemberCount
+    ) {
+    MemberList members;
+    members.reserve(static_cast<int>(leadingMemberCount + trailingMemberCount));
+
+    Model::Set::ConstIterator setIterator = set.constBegin();
+    for (unsigned long index=0 ; index<leadingMemberCount ; ++index) {
+        members.append(setIterator.constReference());
+        ++setIterator;
+    }
+
+    if (trailingMemberCount > 0) {
+        setIterator.advance(hiddenMemberCount);
+
+        for (unsigned long index=0 ; index<trailingMemberCount ; ++index) {
+            members.append(setIterator.constReference());
+            ++setIterator;
+        }
+    }
+
+    return members;
+}
+
+
 void SetDataTypePresentationGenerator::calculateMaximumChildHeight(
-        PlacementTracker*          placementTracker,
-        Model::Set::ConstIterator& setIterator,
-        unsigned long              memberCount,
-        Ld::FormatPointer          format,
-        float                      relativeScale,
-        float&                     maximumAscent,
-        float&                     maximumDescent
+        PlacementTracker* placementTracker,
+        const MemberList& members,
+        Ld::FormatPointer format,
+        float             relativeScale,
+        bool              cacheMeasurements,
+        float&            maximumAscent,
+        float&            maximumDescent
     ) {
+    unsigned long memberCount = static_cast<unsigned long>(members.size());
+    placementTracker->addNewJobs(memberCount);
+
     unsigned long index = 0;
     while (index < memberCount && !placementTracker->abortPlacement()) {
-        const Model::Variant& childValue     = setIterator.constReference();
+        const Model::Variant& childValue     = members.at(static_cast<int>(index));
         Model::ValueType      childValueType = childValue.valueType();
         Ld::DataType          childDataType  = Ld::DataType::fromValueType(childValueType);
 
@@ -379,13 +429,18 @@ void SetDataTypePresentationGenerator::calculateMaximumChildHeight(
 
             if (generator != Q_NULLPTR) {
                 float childAscent;
-                float childHeight  = generator->calculateHeight(
+                float childHeight = generator->calculateHeight(
                     placementTracker,
                     childValue,
                     format,
                     relativeScale,
                     &childAscent
                 );
+
+                if (cacheMeasurements && !placementTracker->abortPlacement()) {
+                    cacheHeight(childValue, format, relativeScale, childHeight, childAscent);
+                }
+
                 float childDescent = childHeight - childAscent;
 
                 if (childAscent > maximumAscent) {
@@ -407,7 +462,8 @@ void SetDataTypePresentationGenerator::calculateMaximumChildHeight(
 
 void SetDataTypePresentationGenerator::renderSetMembers(
         PlacementTracker*                     placementTracker,
-        Model::Set::ConstIterator&            setIterator,
+        const MemberList&                     members,
+        unsigned long                         firstIndex,
         unsigned long                         memberCount,
         bool&                                 isFirstEntry,
         DataTypePresenter::PresentationAreas& currentPresentationAreas,
@@ -437,7 +493,7 @@ void SetDataTypePresentationGenerator::renderSetMembers(
             isFirstEntry = false;
         }
 
-        const Model::Variant& childVariant   = setIterator.constReference();
+        const Model::Variant& childVariant   = members.at(static_cast<int>(firstIndex + index));
         Model::ValueType      childValueType = childVariant.valueType();
         Ld::DataType          childDataType  = Ld::DataType::fromValueType(childValueType);
         if (childDataType.isValid()) {
@@ -494,7 +550,6 @@ void SetDataTypePresentationGenerator::renderSetMembers(
         placementTracker->completedJob();
 
         ++index;
-        ++setIterator;
     }
 }
 
@@ -11,6 +11,12 @@
 #include <QVariant>
 #include <QModelIndex>
 #include <QAbstractTableModel>
+#include <QList>
+#include <QMap>
+#include <QSet>
+
+#include <vector>
+#include <algorithm>
 
 #include <model_set.h>
 #include <model_variant.h>
@@ -19,11 +25,12 @@
 #include <ld_data_type_decoder.h>
 #include <ld_calculated_value.h>
 
+#include "inspector_cell_cache.h"
 #include "set_inspector_model.h"
 
-const Model::Variant SetInspectorModel::dummyVariant;
-
-SetInspectorModel::SetInspectorModel(QObject* parent):QAbstractTableModel(parent) {}
+SetInspectorModel::SetInspectorModel(QObject* parent):QAbstractTableModel(parent) {
+    displayedRowCount = 0;
+}
 
 
 SetInspectorModel::~SetInspectorModel() {}
@@ -38,25 +45,15 @@ QVariant SetInspectorModel::data(const QModelIndex& index, int role) const {
             unsigned long row    = static_cast<unsigned long>(index.row());
             unsigned long column = static_cast<unsigned long>(index.column());
 
-            if (row < static_cast<unsigned>(currentVariantList.size())) {
-                Ld::CalculatedValue calculatedValue(QString(), currentVariantList.at(row));
-
-                if (column == 0) {
-                    Ld::DataType dataType = Ld::DataType::fromValueType(currentVariantList.at(row).valueType());
-                    if (dataType.isValid()) {
-                        if ((dataType.properties() & (Ld::DataType::matrix | Ld::DataType::container)) == 0) {
-                            const Ld::DataTypeDecoder* decoder = dataType.decoder();
-                            if (decoder != Q_NULLPTR) {
-                                result = QVariant::fromValue(decoder->toString(currentVariantList.at(row)));
-                            } else {
-                                result = tr("*** COULD NOT DECODE ***");
-                            }
-                        }
-                    } else {
-                        result = tr("*** Invalid content ***");
+            if (row < displayedRowCount) {
+                QString text;
+                if (cellCache.lookup(row, column, static_cast<unsigned>(role), text)) {
+                    result = QVariant::fromValue(text);
+                } else {
+                    result = formatCell(*iteratorAt(row), column);
+                    if (result.isValid()) {
+                        cellCache.insert(row, column, static_cast<unsigned>(role), result.toString());
                     }
-                } else if (column == 1) {
-                    result = QVariant::fromValue(calculatedValue.description());
                 }
             }
 
@@ -69,7 +66,7 @@ QVariant SetInspectorModel::data(const QModelIndex& index, int role) const {
 
 
 int SetInspectorModel::rowCount(const QModelIndex& /* parent */) const {
-    return currentVariantList.size();
+    return static_cast<int>(displayedRowCount);
 }
 
 
@@ -88,10 +85,8 @@ bool SetInspectorModel::calculatedValueChanged() const {
 }
 
 
-const Model::Variant& SetInspectorModel::valueAt(unsigned long rowIndex) const {
-    return   rowIndex < static_cast<unsigned long>(currentVariantList.size())
-           ? currentVariantList.at(rowIndex)
-           : dummyVariant;
+Model::Variant SetInspectorModel::valueAt(unsigned long rowIndex) const {
+    return rowIndex < displayedRowCount ? *iteratorAt(rowIndex) : Model::Variant();
 }
 
 
@@ -106,37 +101,104 @@ void SetInspectorModel::setCalculatedValue(const Ld::CalculatedValue& newCalcula
 void SetInspectorModel::resetModel() {
     beginResetModel();
 
-    currentSet = inputSet;
-    buildVariantList();
+    currentSet        = inputSet;
+    displayedRowCount = static_cast<unsigned long>(currentSet.size());
+    invalidateRowIndex();
 
     endResetModel();
 }
 
 
 bool SetInspectorModel::removeValue(const Model::Variant& value) {
-    bool success = currentSet.remove(value);
+    return removeValues(QList<Model::Variant>() << value);
+}
 
-    if (success) {
-        beginResetModel();
-        buildVariantList();
-        endResetModel();
+
+bool SetInspectorModel::removeValues(const QList<Model::Variant>& values) {
+    // Locate the rows of the requested values with a single walk of the set.  No cell formatting is performed.
+
+    Model::Set pending;
+    for (QList<Model::Variant>::const_iterator it=values.constBegin(),end=values.constEnd() ; it!=end ; ++it) {
+        pending.insert(*it);
     }
 
-    return success;
+    QList<unsigned long> rowIndexes;
+
+    unsigned long rowIndex = 0;
+    for (  Model::Set::ConstIterator it = currentSet.constBegin(), end = currentSet.constEnd()
+         ; it != end && pending.size() > 0
+         ; ++it
+        ) {
+        if (pending.remove(*it)) {
+            rowIndexes.append(rowIndex);
+        }
+
+        ++rowIndex;
+    }
+
+    bool success = removeRowList(rowIndexes);
+    return success && pending.size() == 0;
 }
 
 
-bool SetInspectorModel::removeValues(const QList<Model::Variant>& values) {
+bool SetInspectorModel::removeRowList(const QList<unsigned long>& rowIndexes) {
     bool success = true;
-    for (QList<Model::Variant>::const_iterator it=values.constBegin(),end=values.constEnd() ; it!=end ; ++it) {
-        if (!currentSet.remove(*it)) {
+
+    // Group the rows into contiguous ranges and capture the values before anything is removed.  Row positions are
+    // stable under removal since the set preserves the relative order of the remaining members.
+
+    QMap<unsigned long, QList<Model::Variant>> rowGroups;
+    QSet<unsigned long>                        rowSet(rowIndexes.constBegin(), rowIndexes.constEnd());
+    QList<unsigned long>                       sortedRows = rowSet.values();
+    std::sort(sortedRows.begin(), sortedRows.end());
+
+    unsigned long startingRow = 0;
+    unsigned long lastRow     = 0;
+    for (  QList<unsigned long>::const_iterator it = sortedRows.constBegin(), end = sortedRows.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        unsigned long rowIndex = *it;
+        if (rowIndex >= displayedRowCount) {
             success = false;
+        } else {
+            if (rowGroups.isEmpty() || rowIndex != lastRow + 1) {
+                startingRow = rowIndex;
+            }
+
+            rowGroups[startingRow].append(*iteratorAt(rowIndex));
+            lastRow = rowIndex;
         }
     }
 
-    beginResetModel();
-    buildVariantList();
-    endResetModel();
+    // Remove from the last group to the first so that earlier row indexes remain valid as we go.
+
+    QMap<unsigned long, QList<Model::Variant>>::const_iterator it    = rowGroups.constEnd();
+    QMap<unsigned long, QList<Model::Variant>>::const_iterator begin = rowGroups.constBegin();
+    while (it != begin) {
+        --it;
+
+        const QList<Model::Variant>& groupValues = it.value();
+        int                          firstRow    = static_cast<int>(it.key());
+        int                          lastRow     = firstRow + groupValues.size() - 1;
+
+        beginRemoveRows(QModelIndex(), firstRow, lastRow);
+
+        for (  QList<Model::Variant>::const_iterator valueIterator    = groupValues.constBegin(),
+                                                     valueEndIterator = groupValues.constEnd()
+             ; valueIterator != valueEndIterator
+             ; ++valueIterator
+            ) {
+            if (currentSet.remove(*valueIterator)) {
+                --displayedRowCount;
+            } else {
+                success = false;
+            }
+        }
+
+        invalidateRowIndex();
+        endRemoveRows();
+    }
 
     return success;
 }
@@ -146,18 +208,80 @@ bool SetInspectorModel::addValue(const Model::Variant& value) {
     bool success = currentSet.insert(value);
 
     if (success) {
-        beginResetModel();
-        buildVariantList();
-        endResetModel();
+        // The set decides where the new member lands so we locate it rather than assume it was appended.  The
+        // displayed row count lags the set until the insert notification has been issued.
+
+        unsigned long rowIndex = 0;
+        Model::Set::ConstIterator it  = currentSet.constBegin();
+        Model::Set::ConstIterator end = currentSet.constEnd();
+        while (it != end && !(*it == value)) {
+            ++it;
+            ++rowIndex;
+        }
+
+        int newRow = static_cast<int>(rowIndex);
+
+        beginInsertRows(QModelIndex(), newRow, newRow);
+        ++displayedRowCount;
+        invalidateRowIndex();
+        endInsertRows();
     }
 
     return success;
 }
 
 
-void SetInspectorModel::buildVariantList() {
-    currentVariantList.clear();
-    for (Model::Set::ConstIterator it=currentSet.constBegin(),end=currentSet.constEnd() ; it!=end ; ++it) {
-        currentVariantList.append(*it);
+void SetInspectorModel::invalidateRowIndex() {
+    checkpoints.clear();
+    cellCache.clear();
+}
+
+
+Model::Set::ConstIterator SetInspectorModel::iteratorAt(unsigned long rowIndex) const {
+    unsigned long checkpointIndex = rowIndex / checkpointInterval;
+
+    if (checkpoints.empty()) {
+        checkpoints.push_back(currentSet.constBegin());
+    }
+
+    while (checkpoints.size() <= checkpointIndex) {
+        Model::Set::ConstIterator it = checkpoints.back();
+        it.advance(checkpointInterval);
+        checkpoints.push_back(it);
+    }
+
+    Model::Set::ConstIterator result = checkpoints.at(checkpointIndex);
+
+    unsigned long offset = rowIndex % checkpointInterval;
+    if (offset > 0) {
+        result.advance(offset);
     }
+
+    return result;
+}
+
+
+QVariant SetInspectorModel::formatCell(const Model::Variant& value, unsigned long column) const {
+    QVariant result;
+
+    if (column == 0) {
+        Ld::DataType dataType = Ld::DataType::fromValueType(value.valueType());
+        if (dataType.isValid()) {
+            if ((dataType.properties() & (Ld::DataType::matrix | Ld::DataType::container)) == 0) {
+                const Ld::DataTypeDecoder* decoder = dataType.decoder();
+                if (decoder != Q_NULLPTR) {
+                    result = QVariant::fromValue(decoder->toString(value));
+                } else {
+                    result = tr("*** COULD NOT DECODE ***");
+                }
+            }
+        } else {
+            result = tr("*** Invalid content ***");
+        }
+    } else if (column == 1) {
+        Ld::CalculatedValue calculatedValue(QString(), value);
+        result = QVariant::fromValue(calculatedValue.description());
+    }
+
+    return result;
 }
@@ -17,6 +17,8 @@
 #include <QModelIndex>
 #include <QAbstractTableModel>
 
+#include <vector>
+
 #include <model_set.h>
 #include <model_variant.h>
 
@@ -24,6 +26,7 @@
 #include <ld_calculated_value.h>
 
 #include "app_common.h"
+#include "inspector_cell_cache.h"
 
 /**
  * Class that provides a list model for sets.
@@ -88,7 +91,7 @@ class APP_PUBLIC_API SetInspectorModel:public QAbstractTableModel {
          * \return Returns the variant data at the specified row.  An invalid value is returned if the row index is
          *         invalid.
          */
-        const Model::Variant& valueAt(unsigned long rowIndex) const;
+        Model::Variant valueAt(unsigned long rowIndex) const;
 
     signals:
         /**
@@ -138,6 +141,16 @@ class APP_PUBLIC_API SetInspectorModel:public QAbstractTableModel {
          */
         bool removeValues(const QList<Model::Variant>& values);
 
+        /**
+         * Slot you can trigger to remove multiple rows from a model.  Contiguous rows are removed as a single range
+         * and the view is notified of each range rather than being reset.
+         *
+         * \param[in] rowIndexes The zero based indexes of the rows to be removed.
+         *
+         * \return Returns true on success, returns false if one or more rows are invalid.
+         */
+        bool removeRowList(const QList<unsigned long>& rowIndexes);
+
         /**
          * Slot you can trigger to insert a new value into the model.
          *
@@ -149,14 +162,36 @@ class APP_PUBLIC_API SetInspectorModel:public QAbstractTableModel {
 
     private:
         /**
-         * Method that builds the variant list from a list.
+         * The spacing, in rows, between iterator checkpoints.
          */
-        void buildVariantList();
+        static constexpr unsigned long checkpointInterval = 64;
 
         /**
-         * A dummy variant value used when the row index is invalid.
+         * Method that discards the row index and cached cell text.  You must call this method whenever the current
+         * set is modified.
          */
-        static const Model::Variant dummyVariant;
+        void invalidateRowIndex();
+
+        /**
+         * Method that obtains an iterator to a given row.  Checkpoints are created lazily, as rows are requested, so
+         * the cost of positioning to a row is bounded by the checkpoint interval once the view has scrolled past it.
+         *
+         * \param[in] rowIndex The zero based row index.  The value must be less than the set size.
+         *
+         * \return Returns an iterator pointing to the requested row.
+         */
+        Model::Set::ConstIterator iteratorAt(unsigned long rowIndex) const;
+
+        /**
+         * Method that formats the text for a cell.
+         *
+         * \param[in] value  The set member to be formatted.
+         *
+         * \param[in] column The zero based column index.
+         *
+         * \return Returns the formatted cell contents.
+         */
+        QVariant formatCell(const Model::Variant& value, unsigned long column) const;
 
         /**
          * The variable name.
@@ -174,9 +209,23 @@ class APP_PUBLIC_API SetInspectorModel:public QAbstractTableModel {
         Model::Set currentSet;
 
         /**
-         * The list of variants in the set.
+         * The number of rows reported to the view.  Tracked separately from the set size so that row insertion and
+         * removal notifications can bracket changes to the set.
+         */
+        unsigned long displayedRowCount;
+
+        /**
+         * Iterators to every \ref checkpointInterval rows of the current set.  Used in place of a full copy of the set
+         * members.
+         */
+        mutable std::vector<Model::Set::ConstIterator> checkpoints;
+
+        /**
+         * Cache of formatted cell text, keyed by row, column and display role.  The inspector formats members using
+         * the default format of each data type so the role is the only format that varies between cells.  The cache is
+         * discarded by \ref invalidateRowIndex whenever the set changes.
          */
-        QList<Model::Variant> currentVariantList;
+        mutable InspectorCellCache cellCache;
 };
 
 #endif
@@ -13,6 +13,7 @@
 #include <QHBoxLayout>
 #include <QTableView>
 #include <QHeaderView>
+#include <QFontMetrics>
 #include <QPushButton>
 #include <QToolButton>
 #include <QPoint>
@@ -62,7 +63,11 @@ SetInspectorWidget::SetInspectorWidget(QWidget* parent):InspectorWidget(parent)
     currentTableView->setShowGrid(false);
     currentTableView->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
     currentTableView->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-    currentTableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    currentTableView->horizontalHeader()->setResizeContentsPrecision(0);
+    currentTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    currentTableView->verticalHeader()->setDefaultSectionSize(
+        static_cast<int>(QFontMetrics(currentTableView->font()).height() * 1.25)
+    );
 
     currentTableView->setContextMenuPolicy(Qt::CustomContextMenu);
     currentTableView->setSelectionBehavior(QTableView::SelectRows);
@@ -236,17 +241,7 @@ void SetInspectorWidget::deleteItems() {
         selectedRows.insert(rowIndex, 0);
     }
 
-    QList<Model::Variant> valuesToRemove;
-    for (  QMap<unsigned long, char>::const_iterator rowIterator    = selectedRows.constBegin(),
-                                                     rowEndIterator = selectedRows.constEnd()
-         ; rowIterator != rowEndIterator
-         ; ++rowIterator
-        ) {
-        unsigned long rowIndex = rowIterator.key();
-        valuesToRemove.append(model->valueAt(rowIndex));
-    }
-
-    model->removeValues(valuesToRemove);
+    model->removeRowList(selectedRows.keys());
 }
 
 
@@ -22,6 +22,7 @@
 #include <ld_value_field_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_tracker.h"
 #include "data_type_presentation_generator.h"
 #include "simple_text_data_type_presentation_generator_base.h"
@@ -53,7 +54,7 @@ float SimpleTextDataTypePresentationGeneratorBase::calculateHeight(
 
     font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     result = fontMetrics.height();
 
     if (ascent != Q_NULLPTR) {
@@ -119,7 +120,7 @@ EQt::GraphicsMultiTextGroup* SimpleTextDataTypePresentationGeneratorBase::update
         font.setPointSizeF(font.pointSizeF() * fontScaleFactor);
     }
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     ascent = fontMetrics.ascent();
 
     graphicsItem->append(text, font, QPointF(0, ascent));
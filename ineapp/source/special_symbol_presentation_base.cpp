@@ -31,6 +31,7 @@
 #include <ld_element_cursor.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
 #include "leaf_presentation.h"
@@ -237,7 +238,7 @@ EQt::GraphicsMultiTextGroup* SpecialSymbolPresentationBase::buildGraphicsItem(
     QFont   font = specialCharactersFont();
 
     font.setPointSizeF(font.pointSizeF() * relativeScale * Application::fontScaleFactor());
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     EQt::GraphicsMultiTextGroup* result = new EQt::GraphicsMultiTextGroup;
     result->append(text, font, QPointF(0, fontMetrics.ascent()));
@@ -17,6 +17,7 @@
 #include <ld_subscript_row_column_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "binary_operator_presentation_base.h"
 #include "subscript_index_operator_presentation.h"
 
@@ -61,7 +62,7 @@ EQt::GraphicsMathGroup* SubscriptIndexOperatorPresentation::updateGraphicsItem(
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     Ld::ElementPointer child0       = element()->child(0);
     bool               includeComma = false;
@@ -125,7 +126,7 @@ EQt::GraphicsMathGroup* SubscriptIndexOperatorPresentation::updateGraphicsItem(
     if (includeComma) {
         QFont commaFont = font;
         commaFont.setPointSizeF(font.pointSizeF() * subscriptSizeAdjustment);
-        QFontMetricsF commaFontMetrics(commaFont);
+        const QFontMetricsF& commaFontMetrics = FontMetricsCache::fontMetrics(commaFont);
 
         QString commaText = tr(",");
         currentItem->append(commaText, commaFont, QPointF(currentX, child1Top + child1MaximumAscent));
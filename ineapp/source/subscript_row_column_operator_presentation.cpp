@@ -19,6 +19,7 @@
 #include <ld_subscript_row_column_operator_element.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "binary_operator_presentation_base.h"
 #include "subscript_row_column_operator_presentation.h"
 
@@ -63,7 +64,7 @@ EQt::GraphicsMathGroup* SubscriptRowColumnOperatorPresentation::updateGraphicsIt
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     Ld::ElementPointer child0       = element()->child(0);
     bool               includeComma = false;
@@ -85,7 +86,7 @@ EQt::GraphicsMathGroup* SubscriptRowColumnOperatorPresentation::updateGraphicsIt
     subscriptFont.setPointSizeF(font.pointSizeF() * subscriptSizeAdjustment);
     subscriptFont.setWeight(static_cast<QFont::Weight>(font.weight() * subscriptWeightAdjustment));
 
-    QFontMetricsF subscriptFontMetrics(subscriptFont);
+    const QFontMetricsF& subscriptFontMetrics = FontMetricsCache::fontMetrics(subscriptFont);
 
     float child0MaximumAscent  = childPresentationAreaData[0].maximumAscent();
     float child0MaximumDescent = childPresentationAreaData[0].maximumDescent();
@@ -39,6 +39,7 @@
 #include "table_frame_presentation_row_location.h"
 #include "table_frame_presentation_rectangle.h"
 #include "placement_tracker.h"
+#include "placement_profiler.h"
 #include "presentation.h"
 #include "presentation_with_positional_children.h"
 #include "presentation_with_grouped_children.h"
@@ -196,6 +197,7 @@ void TableFramePresentation::recalculatePlacement(
 
             nextChildPresentation = dynamic_cast<Presentation*>(child->visual());
             if (currentChildPresentation != Q_NULLPTR) {
+                PlacementProfiler::Scope profilerScope(currentChildPresentation);
                 currentChildPresentation->recalculatePlacement(
                     placementTracker,
                     this,
@@ -216,6 +218,7 @@ void TableFramePresentation::recalculatePlacement(
         float childBottomSpacing;
         if (nextChildPresentation != Q_NULLPTR) {
             currentChildPresentation = nextChildPresentation;
+            PlacementProfiler::Scope profilerScope(currentChildPresentation);
             currentChildPresentation->recalculatePlacement(
                 placementTracker,
                 this,
@@ -305,6 +308,7 @@ void TableFramePresentation::allocateArea(
 
 
 void TableFramePresentation::areaInsufficient(unsigned long /* childIdentifier */, const QSizeF& /* size */) {
+    PlacementProfiler::areaInsufficient();
     currentCursor->areaInsufficient();
 }
 
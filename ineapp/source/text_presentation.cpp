@@ -33,9 +33,11 @@
 #include <ld_element_cursor.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
 #include "leaf_presentation.h"
+#include "graphics_item_pool.h"
 #include "text_presentation.h"
 
 TextPresentation::TextPresentation() {
@@ -107,7 +109,7 @@ void TextPresentation::recalculatePlacement(
 
         QFont unscaledFont = font;
         unscaledFont.setPointSizeF(pointSize * relativeScale);
-        QFontMetricsF unscaledFontMetrics(unscaledFont);
+        const QFontMetricsF& unscaledFontMetrics = FontMetricsCache::fontMetrics(unscaledFont);
 
         positionAdjustment = unscaledFontMetrics.height() * baselineAdjustment;
 
@@ -115,7 +117,7 @@ void TextPresentation::recalculatePlacement(
         font.setWeight(static_cast<QFont::Weight>(weight + weightOffset));
     }
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float baseFontHeight    = fontMetrics.height();
     float baseFontAscent    = fontMetrics.ascent();
     float additionalSpacing = baseFontHeight * (lineSpacing - 1.0);
@@ -177,7 +179,9 @@ void TextPresentation::recalculatePlacement(
 
                             startingLineOffsets[presentationAreaId] = startingIndex;
                         } else {
-                            item = new EQt::GraphicsTextItem(subString, font);
+                            item = GraphicsItemPool<EQt::GraphicsTextItem>::acquire();
+                            item->setText(subString);
+                            item->setFont(font);
                             item->setBrush(fontBrush);
                             if (useBackgroundBrush) {
                                 item->setBackgroundBrush(fontBackgroundBrush);
@@ -213,7 +217,7 @@ void TextPresentation::recalculatePlacement(
 
         EQt::GraphicsTextItem* item;
         if (graphicsItems.isEmpty()) {
-            item = new EQt::GraphicsTextItem;
+            item = GraphicsItemPool<EQt::GraphicsTextItem>::acquire();
             graphicsItems.append(item);
             startingLineOffsets.append(0);
         } else {
@@ -250,7 +254,7 @@ void TextPresentation::redoPlacement(
     font.setPointSizeF(pointSize * relativeScale);
 
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float baseFontHeight    = fontMetrics.height();
     float baseFontAscent    = fontMetrics.ascent();
     float additionalSpacing = baseFontHeight * (lineSpacing - 1.0);
@@ -368,7 +372,7 @@ QList<QRectF> TextPresentation::cursorRangeToScene(
                 bool nonTrivialEndingOffset   = (index == endingIndex && endingOffset != textLength);
 
                 if (nonTrivialStartingOffset || nonTrivialEndingOffset) {
-                    QFontMetricsF fontMetrics(textItem->font());
+                    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(textItem->font());
 
                     if (endingOffset >= textLength) {
                         text += QString(" ").repeated(endingOffset - textLength + 1);
@@ -395,10 +399,10 @@ QList<QRectF> TextPresentation::cursorRangeToScene(
                                                                     .dynamicCast<Ld::CharacterFormat>();
 
                 if (!format.isNull()) {
-                    QFontMetricsF fontMetrics(format->toQFont());
+                    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(format->toQFont());
                     boundingRectangles.append(QRectF(topLeftCorner, QSizeF(0, fontMetrics.height())));
                 } else {
-                    QFontMetricsF fontMetrics(Application::font());
+                    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(Application::font());
                     boundingRectangles.append(QRectF(topLeftCorner, QSizeF(0, fontMetrics.height())));
                 }
             }
@@ -472,7 +476,7 @@ void TextPresentation::textChanged(const QString& newText) {
 void TextPresentation::clearGraphicsItems(unsigned long startingAreaId) {
     for (unsigned long index=startingAreaId ; index<static_cast<unsigned long>(graphicsItems.size()) ; ++index) {
         EQt::GraphicsTextItem* graphicsItem = graphicsItems.at(index);
-        graphicsItem->deleteLater();
+        GraphicsItemPool<EQt::GraphicsTextItem>::release(graphicsItem);
     }
 
     if (startingAreaId == 0) {
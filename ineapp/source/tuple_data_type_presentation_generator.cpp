@@ -8,6 +8,7 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QVector>
 #include <QGraphicsItem>
 #include <QFont>
 #include <QColor>
@@ -31,6 +32,7 @@
 #include <ld_value_field_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_tracker.h"
 #include "data_type_presentation_generator.h"
 #include "tuple_data_type_presentation_generator.h"
@@ -50,94 +52,84 @@ float TupleDataTypePresentationGenerator::calculateHeight(
         float                 relativeScale,
         float*                ascent
     ) const {
-    float                                result;
-
-    Ld::TupleDataTypeFormat::DisplayMode displayMode;
-    unsigned long                        leadingMemberCount;
-    unsigned long                        trailingMemberCount;
-    unsigned long                        hiddenMemberCount;
-    QFont                                font;
-
-    if (!format.isNull()                                                         &&
-        (format->capabilities().contains(Ld::TupleDataTypeFormat::formatName) ||
-         format->capabilities().contains(Ld::ValueFieldFormat::formatName)     )    ) {
-        QSharedPointer<Ld::TupleDataTypeFormat> tupleFormat = format.dynamicCast<Ld::TupleDataTypeFormat>();
-
-        displayMode           = tupleFormat->displayMode();
-        leadingMemberCount    = tupleFormat->leadingMemberCount();
-        trailingMemberCount   = tupleFormat->trailingMemberCount();
-        font                  = tupleFormat->toQFont();
-    } else {
-        displayMode           = Ld::TupleDataTypeFormat::defaultDisplayMode;
-        leadingMemberCount    = Ld::TupleDataTypeFormat::defaultLeadingMemberCount;
-        trailingMemberCount   = Ld::TupleDataTypeFormat::defaultTrailingMemberCount;
-
-        QSharedPointer<Ld::CharacterFormat> defaultFont = Ld::CharacterFormat::applicationDefaultMathFont();
-        font = defaultFont->toQFont();
-    }
-
-    if (displayMode == Ld::TupleDataTypeFormat::DisplayMode::NORMAL  ||
-        displayMode == Ld::TupleDataTypeFormat::DisplayMode::INVALID    ) {
-        bool         ok;
-        Model::Tuple tupleValue = variant.toTuple(&ok);
-        Q_ASSERT(ok);
-
-        unsigned long numberTupleMembers = tupleValue.size();
-        if (leadingMemberCount == Ld::TupleDataTypeFormat::showAllMembers  ||
-            trailingMemberCount == Ld::TupleDataTypeFormat::showAllMembers ||
-            leadingMemberCount + trailingMemberCount >= numberTupleMembers    ) {
-            leadingMemberCount  = numberTupleMembers;
-            hiddenMemberCount   = 0;
-            trailingMemberCount = 0;
+    float result;
+    float resultAscent;
+
+    if (!cachedHeight(variant, format, relativeScale, result, resultAscent)) {
+        Ld::TupleDataTypeFormat::DisplayMode displayMode;
+        unsigned long                        leadingMemberCount;
+        unsigned long                        trailingMemberCount;
+        unsigned long                        hiddenMemberCount;
+        QFont                                font;
+
+        if (!format.isNull()                                                         &&
+            (format->capabilities().contains(Ld::TupleDataTypeFormat::formatName) ||
+             format->capabilities().contains(Ld::ValueFieldFormat::formatName)     )    ) {
+            QSharedPointer<Ld::TupleDataTypeFormat> tupleFormat = format.dynamicCast<Ld::TupleDataTypeFormat>();
+
+            displayMode           = tupleFormat->displayMode();
+            leadingMemberCount    = tupleFormat->leadingMemberCount();
+            trailingMemberCount   = tupleFormat->trailingMemberCount();
+            font                  = tupleFormat->toQFont();
         } else {
-            hiddenMemberCount = numberTupleMembers - leadingMemberCount - trailingMemberCount;
+            displayMode           = Ld::TupleDataTypeFormat::defaultDisplayMode;
+            leadingMemberCount    = Ld::TupleDataTypeFormat::defaultLeadingMemberCount;
+            trailingMemberCount   = Ld::TupleDataTypeFormat::defaultTrailingMemberCount;
+
+            QSharedPointer<Ld::CharacterFormat> defaultFont = Ld::CharacterFormat::applicationDefaultMathFont();
+            font = defaultFont->toQFont();
         }
 
         font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
-        QFontMetricsF fontMetrics(font);
-        float maximumAscent  = fontMetrics.ascent();
-        float maximumDescent = fontMetrics.descent();
-
-        Model::Tuple::ConstIterator tupleIterator = tupleValue.constBegin();
-
-        placementTracker->addNewJobs(leadingMemberCount + trailingMemberCount);
-
-        calculateMaximumChildHeight(
-            placementTracker,
-            tupleIterator,
-            leadingMemberCount,
-            format,
-            relativeScale,
-            maximumAscent,
-            maximumDescent
-        );
-
-        tupleIterator.advance(hiddenMemberCount);
-
-        calculateMaximumChildHeight(
-            placementTracker,
-            tupleIterator,
-            trailingMemberCount,
-            format,
-            relativeScale,
-            maximumAscent,
-            maximumDescent
-        );
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+
+        if (displayMode == Ld::TupleDataTypeFormat::DisplayMode::NORMAL  ||
+            displayMode == Ld::TupleDataTypeFormat::DisplayMode::INVALID    ) {
+            bool         ok;
+            Model::Tuple tupleValue = variant.toTuple(&ok);
+            Q_ASSERT(ok);
+
+            unsigned long numberTupleMembers = tupleValue.size();
+            if (leadingMemberCount == Ld::TupleDataTypeFormat::showAllMembers  ||
+                trailingMemberCount == Ld::TupleDataTypeFormat::showAllMembers ||
+                leadingMemberCount + trailingMemberCount >= numberTupleMembers    ) {
+                leadingMemberCount  = numberTupleMembers;
+                hiddenMemberCount   = 0;
+                trailingMemberCount = 0;
+            } else {
+                hiddenMemberCount = numberTupleMembers - leadingMemberCount - trailingMemberCount;
+            }
 
-        if (ascent != Q_NULLPTR) {
-            *ascent = maximumAscent;
-        }
+            MemberList members = visibleMembers(
+                tupleValue,
+                leadingMemberCount,
+                hiddenMemberCount,
+                trailingMemberCount
+            );
 
-        result = maximumAscent + maximumDescent;
-    } else {
-        font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
-        QFontMetricsF fontMetrics(font);
+            float maximumDescent = fontMetrics.descent();
+            resultAscent = fontMetrics.ascent();
+
+            // The member list is local so we can't cache the member measurements.
+            calculateMaximumChildHeight(
+                placementTracker,
+                members,
+                format,
+                relativeScale,
+                false,
+                resultAscent,
+                maximumDescent
+            );
 
-        if (ascent != Q_NULLPTR) {
-            *ascent = fontMetrics.ascent();
+            result = resultAscent + maximumDescent;
+        } else {
+            resultAscent = fontMetrics.ascent();
+            result       = fontMetrics.height();
         }
+    }
 
-        result = fontMetrics.height();
+    if (ascent != Q_NULLPTR) {
+        *ascent = resultAscent;
     }
 
     return result;
@@ -154,6 +146,8 @@ DataTypePresenter::PresentationAreas TupleDataTypePresentationGenerator::generat
         float                                 relativeScale,
         bool                                  forceAppend
     ) const {
+    MeasurementScope measurementScope;
+
     if (!forceAppend) {
         for (  DataTypePresenter::PresentationAreas::iterator areaIterator    = currentPresentationAreas.begin(),
                                                               areaEndIterator = currentPresentationAreas.end()
@@ -230,12 +224,36 @@ DataTypePresenter::PresentationAreas TupleDataTypePresentationGenerator::generat
         float pointSize = font.pointSizeF() * Application::fontScaleFactor();
         font.setPointSizeF(pointSize * relativeScale);
 
-        float maximumChildHeight = calculateHeight(placementTracker, variant, format, relativeScale);
+        // Only the visible members are visited.  Heights measured for the members are reused when the members are
+        // rendered.
+
+        MemberList members = visibleMembers(tupleValue, leadingMemberCount, hiddenMemberCount, trailingMemberCount);
+
+        float maximumChildHeight;
+        float maximumChildAscent;
+        if (!cachedHeight(variant, format, relativeScale, maximumChildHeight, maximumChildAscent)) {
+            const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+            float maximumChildDescent = fontMetrics.descent();
+            maximumChildAscent = fontMetrics.ascent();
+
+            calculateMaximumChildHeight(
+                placementTracker,
+                members,
+                format,
+                relativeScale,
+                true,
+                maximumChildAscent,
+                maximumChildDescent
+            );
+
+            maximumChildHeight = maximumChildAscent + maximumChildDescent;
+        }
+
         currentPresentationAreas = renderWrapped(
             placementTracker,
             currentPresentationAreas,
             presenter,
-            tupleValue,
+            members,
             format,
             font,
             fontColor,
@@ -291,10 +309,10 @@ DataTypePresenter::PresentationAreas TupleDataTypePresentationGenerator::generat
         }
 
         font.setPointSizeF(font.pointSizeF() * Application::fontScaleFactor() * relativeScale);
-        QFontMetricsF fontMetrics(font);
-        float         height            = fontMetrics.height();
-        float         ascent            = fontMetrics.ascent();
-        float         additionalSpacing = height * (lineSpacing - 1.0);
+        const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
+        float                height            = fontMetrics.height();
+        float                ascent            = fontMetrics.ascent();
+        float                additionalSpacing = height * (lineSpacing - 1.0);
 
         height += additionalSpacing;
         ascent += additionalSpacing;
@@ -376,7 +394,7 @@ DataTypePresenter::PresentationAreas TupleDataTypePresentationGenerator::renderW
         PlacementTracker*                     placementTracker,
         DataTypePresenter::PresentationAreas& currentPresentationAreas,
         DataTypePresenter*                    presenter,
-        const Model::Tuple&                   tuple,
+        const MemberList&                     members,
         Ld::FormatPointer                     format,
         const QFont&                          font,
         const QColor&                         fontColor,
@@ -400,12 +418,11 @@ DataTypePresenter::PresentationAreas TupleDataTypePresentationGenerator::renderW
         fontBackgroundColor
     );
 
-    Model::Tuple::ConstIterator tupleIterator = tuple.constBegin();
-
     bool isFirstEntry = true;
     renderTupleMembers(
         placementTracker,
-        tupleIterator,
+        members,
+        0,
         leadingMemberCount,
         isFirstEntry,
         currentPresentationAreas,
@@ -449,13 +466,12 @@ DataTypePresenter::PresentationAreas TupleDataTypePresentationGenerator::renderW
             fontBackgroundColor,
             lineSpacing
         );
-
-        tupleIterator.advance(hiddenMemberCount);
     }
 
     renderTupleMembers(
         placementTracker,
-        tupleIterator,
+        members,
+        leadingMemberCount,
         trailingMemberCount,
         isFirstEntry,
         currentPresentationAreas,
@@ -483,18 +499,46 @@ DataTypePresenter::PresentationAreas TupleDataTypePresentationGenerator::renderW
 }
 
 
+TupleDataTypePresentationGenerator::MemberList TupleDataTypePresentationGenerator::visibleMembers(
+        const Model::Tuple& tuple,
+        unsigned long       leadingMemberCount,
+        unsigned long       hiddenMemberCount,
+        unsigned long       trailingMemberCount
+    ) {
+    MemberList members;
+    members.reserve(static_cast<int>(leadingMemberCount + trailingMemberCount));
+
+    // Tuples are indexed from 1.  We access the trailing members directly so the hidden members are never visited.
+
+    for (Model::Integer index=1 ; index<=static_cast<Model::Integer>(leadingMemberCount) ; ++index) {
+        members.append(tuple.at(index));
+    }
+
+    Model::Integer firstTrailingIndex = static_cast<Model::Integer>(leadingMemberCount + hiddenMemberCount + 1);
+    Model::Integer lastTrailingIndex  = static_cast<Model::Integer>(firstTrailingIndex + trailingMemberCount);
+    for (Model::Integer index=firstTrailingIndex ; index<lastTrailingIndex ; ++index) {
+        members.append(tuple.at(index));
+    }
+
+    return members;
+}
+
+
 void TupleDataTypePresentationGenerator::calculateMaximumChildHeight(
-        PlacementTracker*            placementTracker,
-        Model::Tuple::ConstIterator& tupleIterator,
-        unsigned long                memberCount,
-        Ld::FormatPointer            format,
-        float                        relativeScale,
-        float&                       maximumAscent,
-        float&                       maximumDescent
+        PlacementTracker* placementTracker,
+        const MemberList& members,
+        Ld::FormatPointer format,
+        float             relativeScale,
+        bool              cacheMeasurements,
+        float&            maximumAscent,
+        float&            maximumDescent
     ) {
+    unsigned long memberCount = static_cast<unsigned long>(members.size());
+    placementTracker->addNewJobs(memberCount);
+
     unsigned long index = 0;
     while (index < memberCount && !placementTracker->abortPlacement()) {
-        const Model::Variant& childValue     = tupleIterator.constReference();
+        const Model::Variant& childValue     = members.at(static_cast<int>(index));
         Model::ValueType      childValueType = childValue.valueType();
         Ld::DataType          childDataType  = Ld::DataType::fromValueType(childValueType);
 
@@ -504,13 +548,18 @@ void TupleDataTypePresentationGenerator::calculateMaximumChildHeight(
 
             if (generator != Q_NULLPTR) {
                 float childAscent;
-                float childHeight  = generator->calculateHeight(
+                float childHeight = generator->calculateHeight(
                     placementTracker,
                     childValue,
                     format,
                     relativeScale,
                     &childAscent
                 );
+
+                if (cacheMeasurements && !placementTracker->abortPlacement()) {
+                    cacheHeight(childValue, format, relativeScale, childHeight, childAscent);
+                }
+
                 float childDescent = childHeight - childAscent;
 
                 if (childAscent > maximumAscent) {
@@ -532,7 +581,8 @@ void TupleDataTypePresentationGenerator::calculateMaximumChildHeight(
 
 void TupleDataTypePresentationGenerator::renderTupleMembers(
         PlacementTracker*                     placementTracker,
-        Model::Tuple::ConstIterator&          tupleIterator,
+        const MemberList&                     members,
+        unsigned long                         firstIndex,
         unsigned long                         memberCount,
         bool&                                 isFirstEntry,
         DataTypePresenter::PresentationAreas& currentPresentationAreas,
@@ -562,7 +612,7 @@ void TupleDataTypePresentationGenerator::renderTupleMembers(
             isFirstEntry = false;
         }
 
-        const Model::Variant& childVariant   = tupleIterator.constReference();
+        const Model::Variant& childVariant   = members.at(static_cast<int>(firstIndex + index));
         Model::ValueType      childValueType = childVariant.valueType();
         Ld::DataType          childDataType  = Ld::DataType::fromValueType(childValueType);
         if (childDataType.isValid()) {
@@ -619,7 +669,6 @@ void TupleDataTypePresentationGenerator::renderTupleMembers(
         placementTracker->completedJob();
 
         ++index;
-        ++tupleIterator;
     }
 }
 
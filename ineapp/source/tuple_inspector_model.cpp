@@ -11,6 +11,10 @@
 #include <QVariant>
 #include <QModelIndex>
 #include <QAbstractTableModel>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QVector>
 
 #include <model_tuple.h>
 #include <model_variant.h>
@@ -19,11 +23,18 @@
 #include <ld_data_type_decoder.h>
 #include <ld_calculated_value.h>
 
+#include "inspector_cell_cache.h"
 #include "tuple_inspector_model.h"
 
 const Model::Variant TupleInspectorModel::dummyVariant;
 
-TupleInspectorModel::TupleInspectorModel(QObject* parent):QAbstractTableModel(parent) {}
+TupleInspectorModel::TupleInspectorModel(QObject* parent):QAbstractTableModel(parent) {
+    membersDetached  = false;
+    cachedTupleValid = false;
+    numberEdits      = 0;
+
+    connect(this, &TupleInspectorModel::modelAboutToBeReset, this, &TupleInspectorModel::clearCellCache);
+}
 
 
 TupleInspectorModel::~TupleInspectorModel() {}
@@ -38,26 +49,15 @@ QVariant TupleInspectorModel::data(const QModelIndex& index, int role) const {
             unsigned long row    = static_cast<unsigned long>(index.row());
             unsigned long column = static_cast<unsigned long>(index.column());
 
-            if (row < static_cast<unsigned>(currentTuple.size())) {
-                Model::Variant      value = currentTuple.at(row + 1);
-                Ld::CalculatedValue calculatedValue(QString(), value);
-
-                if (column == 0) {
-                    Ld::DataType dataType = Ld::DataType::fromValueType(value.valueType());
-                    if (dataType.isValid()) {
-                        if ((dataType.properties() & (Ld::DataType::matrix | Ld::DataType::container)) == 0) {
-                            const Ld::DataTypeDecoder* decoder = dataType.decoder();
-                            if (decoder != Q_NULLPTR) {
-                                result = QVariant::fromValue(decoder->toString(value));
-                            } else {
-                                result = tr("*** COULD NOT DECODE ***");
-                            }
-                        }
-                    } else {
-                        result = tr("*** Invalid content ***");
+            if (row < static_cast<unsigned long>(rowCount())) {
+                QString text;
+                if (cellCache.lookup(row, column, static_cast<unsigned>(role), text)) {
+                    result = QVariant::fromValue(text);
+                } else {
+                    result = formatCell(memberAt(row), column);
+                    if (result.isValid()) {
+                        cellCache.insert(row, column, static_cast<unsigned>(role), result.toString());
                     }
-                } else if (column == 1) {
-                    result = QVariant::fromValue(calculatedValue.description());
                 }
             }
 
@@ -70,7 +70,7 @@ QVariant TupleInspectorModel::data(const QModelIndex& index, int role) const {
 
 
 int TupleInspectorModel::rowCount(const QModelIndex& /* parent */) const {
-    return currentTuple.size();
+    return membersDetached ? currentMembers.size() : static_cast<int>(currentTuple.size());
 }
 
 
@@ -80,107 +80,156 @@ int TupleInspectorModel::columnCount(const QModelIndex& /* parent */) const {
 
 
 bool TupleInspectorModel::removeRows(int row, int rowCount, const QModelIndex& /* parent */) {
-    Model::Tuple  newTuple;
-    unsigned long numberRows = static_cast<unsigned long>(currentTuple.size());
-    for (unsigned long i=0 ; i<numberRows ; ++i) {
-        if (i < static_cast<unsigned long>(row) || i >= static_cast<unsigned long>(row + rowCount)) {
-            newTuple.append(currentTuple.at(i + 1));
+    QMap<unsigned long, unsigned long> rowGroups;
+    rowGroups.insert(static_cast<unsigned long>(row), static_cast<unsigned long>(rowCount));
+
+    return removeRowGroups(rowGroups);
+}
+
+
+bool TupleInspectorModel::removeRowGroups(const QMap<unsigned long, unsigned long>& rowGroups) {
+    bool          success    = true;
+    unsigned long numberRows = static_cast<unsigned long>(rowCount());
+
+    detachMembers();
+
+    // Work from the last group to the first so that earlier row indexes remain valid as we go.
+
+    QMap<unsigned long, unsigned long>::const_iterator it    = rowGroups.constEnd();
+    QMap<unsigned long, unsigned long>::const_iterator begin = rowGroups.constBegin();
+    while (it != begin) {
+        --it;
+
+        unsigned long startingRow = it.key();
+        unsigned long groupSize   = it.value();
+
+        if (startingRow + groupSize > numberRows) {
+            success = false;
+        } else if (groupSize > 0) {
+            int firstRow = static_cast<int>(startingRow);
+            int lastRow  = static_cast<int>(startingRow + groupSize - 1);
+
+            beginRemoveRows(QModelIndex(), firstRow, lastRow);
+            currentMembers.erase(currentMembers.begin() + firstRow, currentMembers.begin() + lastRow + 1);
+            cellCache.clear();
+            endRemoveRows();
+
+            numberRows -= groupSize;
         }
     }
 
-    beginResetModel();
-    currentTuple = newTuple;
-    endResetModel();
-
+    recordEdit();
     generateSignals();
 
-    return true;
+    return success;
 }
 
 
 Ld::CalculatedValue TupleInspectorModel::currentCalculatedValue() const {
-    return Ld::CalculatedValue(currentName, Model::Variant(currentTuple));
+    return Ld::CalculatedValue(currentName, Model::Variant(buildCurrentTuple()));
 }
 
 
 bool TupleInspectorModel::calculatedValueChanged() const {
-    return (currentTuple != inputTuple);
+    return numberEdits != 0 && buildCurrentTuple() != inputTuple;
 }
 
 
 Model::Variant TupleInspectorModel::valueAt(unsigned long rowIndex) const {
-    return rowIndex < static_cast<unsigned long>(currentTuple.size()) ? currentTuple.at(rowIndex + 1) : dummyVariant;
+    return rowIndex < static_cast<unsigned long>(rowCount()) ? memberAt(rowIndex) : dummyVariant;
 }
 
 
 void TupleInspectorModel::mergeAndRelocate(unsigned long newRow, const QList<unsigned long>& aggregateRows) {
-    QSet<unsigned long> rowSet(aggregateRows.constBegin(), aggregateRows.constEnd());
-
-    Model::Tuple newTuple;
-    unsigned long numberTerms = static_cast<unsigned long>(currentTuple.size());
-    for (unsigned long i=0 ; i<numberTerms ; ++i) {
-        if (i == newRow) {
-            for (  QList<unsigned long>::const_iterator aggregateRowIterator    = aggregateRows.constBegin(),
-                                                        aggregateRowEndIterator = aggregateRows.constEnd()
-                 ; aggregateRowIterator != aggregateRowEndIterator
-                 ; ++aggregateRowIterator
-                ) {
-                unsigned long rowIndex = *aggregateRowIterator;
-                newTuple.append(currentTuple.at(rowIndex + 1));
+    unsigned long numberTerms = static_cast<unsigned long>(rowCount());
+    if (!aggregateRows.isEmpty()) {
+        detachMembers();
+
+        QSet<unsigned long> rowSet(aggregateRows.constBegin(), aggregateRows.constEnd());
+
+        // Build the new ordering as a permutation of old row indexes in a single pass.  Only the element handles are
+        // moved; the members themselves are never copied or rebuilt.
+
+        QList<unsigned long> newOrder;
+        newOrder.reserve(static_cast<int>(numberTerms));
+
+        for (unsigned long i=0 ; i<numberTerms ; ++i) {
+            if (i == newRow) {
+                newOrder.append(aggregateRows);
+            }
+
+            if (!rowSet.contains(i)) {
+                newOrder.append(i);
             }
         }
 
-        if (!rowSet.contains(i)) {
-            newTuple.append(currentTuple.at(i + 1));
+        if (newRow >= numberTerms) {
+            newOrder.append(aggregateRows);
         }
-    }
 
-    if (newRow >= numberTerms) {
-        for (  QList<unsigned long>::const_iterator aggregateRowIterator    = aggregateRows.constBegin(),
-                                                    aggregateRowEndIterator = aggregateRows.constEnd()
-             ; aggregateRowIterator != aggregateRowEndIterator
-             ; ++aggregateRowIterator
-            ) {
-            unsigned long rowIndex = *aggregateRowIterator;
-            newTuple.append(currentTuple.at(rowIndex + 1));
+        emit layoutAboutToBeChanged();
+
+        QList<Model::Variant> newMembers;
+        newMembers.reserve(static_cast<int>(numberTerms));
+
+        QVector<int> newRowForOldRow(static_cast<int>(numberTerms));
+        for (int i=0 ; i<newOrder.size() ; ++i) {
+            unsigned long oldRow = newOrder.at(i);
+            newMembers.append(currentMembers.at(static_cast<int>(oldRow)));
+            newRowForOldRow[static_cast<int>(oldRow)] = i;
         }
-    }
 
-    beginResetModel();
-    currentTuple = newTuple;
-    endResetModel();
+        currentMembers.swap(newMembers);
+        cellCache.clear();
+        recordEdit();
+
+        QModelIndexList oldIndexes = persistentIndexList();
+        QModelIndexList newIndexes;
+        for (QModelIndexList::const_iterator it=oldIndexes.constBegin(),end=oldIndexes.constEnd() ; it!=end ; ++it) {
+            newIndexes.append(index(newRowForOldRow.at(it->row()), it->column()));
+        }
+
+        changePersistentIndexList(oldIndexes, newIndexes);
+
+        emit layoutChanged();
+    }
 }
 
 
 void TupleInspectorModel::replaceValue(unsigned long rowIndex, const Model::Variant& variant) {
-    beginResetModel();
-    currentTuple.update(rowIndex + 1, variant);
-    endResetModel();
+    if (rowIndex < static_cast<unsigned long>(rowCount())) {
+        if (membersDetached) {
+            currentMembers[static_cast<int>(rowIndex)] = variant;
+        } else {
+            currentTuple.update(rowIndex + 1, variant);
+        }
 
-    generateSignals();
+        cellCache.invalidate(rowIndex, 0);
+        cellCache.invalidate(rowIndex, 1);
+        recordEdit();
+
+        emit dataChanged(index(static_cast<int>(rowIndex), 0), index(static_cast<int>(rowIndex), 1));
+
+        generateSignals();
+    }
 }
 
 
 void TupleInspectorModel::insertValue(unsigned long rowIndex, const Model::Variant& variant) {
-    Model::Tuple newTuple;
+    unsigned long numberTerms = static_cast<unsigned long>(rowCount());
+    if (rowIndex > numberTerms) {
+        rowIndex = numberTerms;
+    }
 
-    if (rowIndex == 0) {
-        newTuple = currentTuple;
-        newTuple.prepend(variant);
-    } else {
-        unsigned long numberTerms = static_cast<unsigned long>(currentTuple.size());
-        for (unsigned long i=1 ; i<=numberTerms ; ++i) {
-            if (i == rowIndex + 1) {
-                newTuple.append(variant);
-            }
+    detachMembers();
 
-            newTuple.append(currentTuple.at(i));
-        }
-    }
+    beginInsertRows(QModelIndex(), static_cast<int>(rowIndex), static_cast<int>(rowIndex));
+    currentMembers.insert(static_cast<int>(rowIndex), variant);
+    cellCache.clear();
+    recordEdit();
+    endInsertRows();
 
-    beginResetModel();
-    currentTuple = newTuple;
-    endResetModel();
+    generateSignals();
 }
 
 
@@ -194,7 +243,12 @@ void TupleInspectorModel::setCalculatedValue(const Ld::CalculatedValue& newCalcu
 
 void TupleInspectorModel::resetModel() {
     beginResetModel();
-    currentTuple = inputTuple;
+    currentTuple     = inputTuple;
+    membersDetached  = false;
+    cachedTupleValid = false;
+    numberEdits      = 0;
+    currentMembers.clear();
+    cachedTuple = Model::Tuple();
     endResetModel();
 
     generateSignals();
@@ -202,10 +256,94 @@ void TupleInspectorModel::resetModel() {
 
 
 void TupleInspectorModel::generateSignals() {
-    if (currentTuple != inputTuple) {
-        emit valueChanged(Ld::CalculatedValue(currentName, Model::Variant(currentTuple)));
+    if (calculatedValueChanged()) {
+        emit valueChanged(currentCalculatedValue());
     } else {
-        emit valueRestored(Ld::CalculatedValue(currentName, Model::Variant(currentTuple)));
+        emit valueRestored(Ld::CalculatedValue(currentName, Model::Variant(inputTuple)));
     }
 }
 
+
+void TupleInspectorModel::recordEdit() {
+    ++numberEdits;
+    cachedTupleValid = false;
+}
+
+
+void TupleInspectorModel::detachMembers() {
+    if (!membersDetached) {
+        unsigned long numberTerms = static_cast<unsigned long>(currentTuple.size());
+
+        currentMembers.clear();
+        currentMembers.reserve(static_cast<int>(numberTerms));
+
+        for (Model::Tuple::ConstIterator it=currentTuple.constBegin(),end=currentTuple.constEnd() ; it!=end ; ++it) {
+            currentMembers.append(*it);
+        }
+
+        currentTuple    = Model::Tuple();
+        membersDetached = true;
+    }
+}
+
+
+Model::Variant TupleInspectorModel::memberAt(unsigned long rowIndex) const {
+    return membersDetached ? currentMembers.at(static_cast<int>(rowIndex)) : currentTuple.at(rowIndex + 1);
+}
+
+
+Model::Tuple TupleInspectorModel::buildCurrentTuple() const {
+    Model::Tuple result;
+
+    if (membersDetached) {
+        if (!cachedTupleValid) {
+            cachedTuple = Model::Tuple();
+            for (  QList<Model::Variant>::const_iterator it  = currentMembers.constBegin(),
+                                                         end = currentMembers.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                cachedTuple.append(*it);
+            }
+
+            cachedTupleValid = true;
+        }
+
+        result = cachedTuple;
+    } else {
+        result = currentTuple;
+    }
+
+    return result;
+}
+
+
+void TupleInspectorModel::clearCellCache() {
+    cellCache.clear();
+}
+
+
+QVariant TupleInspectorModel::formatCell(const Model::Variant& value, unsigned long column) const {
+    QVariant result;
+
+    if (column == 0) {
+        Ld::DataType dataType = Ld::DataType::fromValueType(value.valueType());
+        if (dataType.isValid()) {
+            if ((dataType.properties() & (Ld::DataType::matrix | Ld::DataType::container)) == 0) {
+                const Ld::DataTypeDecoder* decoder = dataType.decoder();
+                if (decoder != Q_NULLPTR) {
+                    result = QVariant::fromValue(decoder->toString(value));
+                } else {
+                    result = tr("*** COULD NOT DECODE ***");
+                }
+            }
+        } else {
+            result = tr("*** Invalid content ***");
+        }
+    } else if (column == 1) {
+        Ld::CalculatedValue calculatedValue(QString(), value);
+        result = QVariant::fromValue(calculatedValue.description());
+    }
+
+    return result;
+}
@@ -16,6 +16,8 @@
 #include <QVariant>
 #include <QModelIndex>
 #include <QAbstractTableModel>
+#include <QList>
+#include <QMap>
 
 #include <model_tuple.h>
 #include <model_variant.h>
@@ -24,6 +26,7 @@
 #include <ld_calculated_value.h>
 
 #include "app_common.h"
+#include "inspector_cell_cache.h"
 
 /**
  * Class that provides a table model for tuples.
@@ -79,6 +82,17 @@ class APP_PUBLIC_API TupleInspectorModel:public QAbstractTableModel {
          */
         bool removeRows(int row, int rowCount, const QModelIndex& parent = QModelIndex()) override;
 
+        /**
+         * Method that removes several groups of rows in a single pass.  Only one value changed/restored signal is
+         * generated for the entire batch.
+         *
+         * \param[in] rowGroups A map of starting row indexes to the number of rows to remove at that location.  Groups
+         *                      must not overlap.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        bool removeRowGroups(const QMap<unsigned long, unsigned long>& rowGroups);
+
         /**
          * Method that returns the currently displayed data.
          *
@@ -87,7 +101,8 @@ class APP_PUBLIC_API TupleInspectorModel:public QAbstractTableModel {
         Ld::CalculatedValue currentCalculatedValue() const;
 
         /**
-         * Method that indicates if the calculated value has been changed from the initial value.
+         * Method that indicates if the calculated value has been changed from the initial value.  The tuples are only
+         * compared if the model has been edited since it was last reset.
          *
          * \return Returns true if the calculated value changed.  Returns false if the calculated value is unchanged.
          */
@@ -160,12 +175,56 @@ class APP_PUBLIC_API TupleInspectorModel:public QAbstractTableModel {
          */
         void resetModel();
 
+    private slots:
+        /**
+         * Slot that discards all cached cell text.  Triggered whenever the model is reset.
+         */
+        void clearCellCache();
+
     private:
         /**
          * Method that generates signals for the model.
          */
         void generateSignals();
 
+        /**
+         * Method that records an edit to the model and discards the cached tuple.
+         */
+        void recordEdit();
+
+        /**
+         * Method that copies the current tuple into the editable member list.  The list is only created on the first
+         * structural edit so that simply viewing a large tuple never copies it.
+         */
+        void detachMembers();
+
+        /**
+         * Method that obtains a member of the current tuple.
+         *
+         * \param[in] rowIndex The zero based row index of the member.  The value must be valid.
+         *
+         * \return Returns the requested member.
+         */
+        Model::Variant memberAt(unsigned long rowIndex) const;
+
+        /**
+         * Method that builds a tuple from the current member list.  The result is cached until the next edit.
+         *
+         * \return Returns the tuple represented by the current state of the model.
+         */
+        Model::Tuple buildCurrentTuple() const;
+
+        /**
+         * Method that formats the text for a cell.
+         *
+         * \param[in] value  The tuple member to be formatted.
+         *
+         * \param[in] column The zero based column index.
+         *
+         * \return Returns the formatted cell contents.
+         */
+        QVariant formatCell(const Model::Variant& value, unsigned long column) const;
+
         /**
          * A dummy variant value used when the row index is invalid.
          */
@@ -182,9 +241,40 @@ class APP_PUBLIC_API TupleInspectorModel:public QAbstractTableModel {
         Model::Tuple inputTuple;
 
         /**
-         * The current tuple.
+         * The current tuple.  Only valid while \ref membersDetached is false.
          */
         Model::Tuple currentTuple;
+
+        /**
+         * The editable member list.  Splicing this list only moves element handles so inserts, removals and moves
+         * cost time proportional to the affected range rather than rebuilding the tuple.
+         */
+        QList<Model::Variant> currentMembers;
+
+        /**
+         * Flag indicating that the model state lives in \ref currentMembers rather than \ref currentTuple.
+         */
+        bool membersDetached;
+
+        /**
+         * The tuple last built from \ref currentMembers.  Only valid while \ref cachedTupleValid is true.
+         */
+        mutable Model::Tuple cachedTuple;
+
+        /**
+         * Flag indicating that \ref cachedTuple reflects the current member list.
+         */
+        mutable bool cachedTupleValid;
+
+        /**
+         * The number of edits applied since the model was last reset.
+         */
+        unsigned long numberEdits;
+
+        /**
+         * Cache of formatted cell text, keyed by row, column and display role.
+         */
+        mutable InspectorCellCache cellCache;
 };
 
 #endif
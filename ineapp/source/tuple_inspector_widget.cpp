@@ -13,6 +13,7 @@
 #include <QHBoxLayout>
 #include <QTableView>
 #include <QHeaderView>
+#include <QFontMetrics>
 #include <QPushButton>
 #include <QToolButton>
 #include <QPoint>
@@ -64,7 +65,11 @@ TupleInspectorWidget::TupleInspectorWidget(QWidget* parent):InspectorWidget(pare
     currentTableView->setShowGrid(false);
     currentTableView->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
     currentTableView->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-    currentTableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    currentTableView->horizontalHeader()->setResizeContentsPrecision(0);
+    currentTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    currentTableView->verticalHeader()->setDefaultSectionSize(
+        static_cast<int>(QFontMetrics(currentTableView->font()).height() * 1.25)
+    );
 
     currentTableView->setContextMenuPolicy(Qt::CustomContextMenu);
     currentTableView->setSelectionBehavior(QTableView::SelectRows);
@@ -366,12 +371,7 @@ void TupleInspectorWidget::deleteItems() {
         rowGroups.insert(startingRow, numberRows);
     }
 
-    QMap<unsigned long, unsigned long>::const_iterator rowGroupIterator = rowGroups.constEnd();
-    unsigned long                                      count            = static_cast<unsigned long>(rowGroups.size());
-    for (unsigned long i=0 ; i<count ; ++i) {
-        --rowGroupIterator;
-        model->removeRows(rowGroupIterator.key(), rowGroupIterator.value());
-    }
+    model->removeRowGroups(rowGroups);
 
     moveUpButton->setEnabled(false);
     moveDownButton->setEnabled(false);
@@ -35,6 +35,7 @@
 #include <ld_operator_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "presentation.h"
 #include "presentation_with_fixed_children.h"
 #include "scene_units.h"
@@ -82,7 +83,7 @@ EQt::GraphicsMathGroup* UnaryLargeOperatorPresentationBase::updateGraphicsItem(
     ) {
     QFont font = operatorFont(format, relativeScale);
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float fontHeight = fontMetrics.height();
 
     QString opString = operatorString(format);
@@ -100,7 +101,7 @@ EQt::GraphicsMathGroup* UnaryLargeOperatorPresentationBase::updateGraphicsItem(
     float operatorWidth;
     if (maximumHeight > fontHeight) {
         scaledFont.setPointSizeF(font.pointSizeF() * maximumHeight / fontHeight);
-        QFontMetricsF scaledFontMetrics(scaledFont);
+        const QFontMetricsF& scaledFontMetrics = FontMetricsCache::fontMetrics(scaledFont);
         operatorHeight = scaledFontMetrics.height();
         operatorAscent = scaledFontMetrics.ascent();
         operatorWidth  = scaledFontMetrics.horizontalAdvance(opString) + scaledFontMetrics.rightBearing(lastCharacter);
@@ -35,6 +35,7 @@
 #include <ld_operator_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "presentation.h"
 #include "presentation_with_fixed_children.h"
 #include "scene_units.h"
@@ -86,7 +87,7 @@ EQt::GraphicsMathGroup* UnaryOperatorPresentationBase::updateGraphicsItem(
         float&                                     requiredAscent
     ) {
     QFont font = operatorFont(format, relativeScale);
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
 
     QString opString = operatorString(format);
 
@@ -35,6 +35,7 @@
 #include <ld_operator_format.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "presentation.h"
 #include "presentation_with_fixed_children.h"
 #include "scene_units.h"
@@ -89,13 +90,13 @@ EQt::GraphicsMathGroup* UnarySuperscriptOperatorPresentationBase::updateGraphics
     superscriptFont.setWeight(static_cast<QFont::Weight>(newFontWeight));
     superscriptFont.setPointSizeF(superscriptFont.pointSizeF() * superscriptSizeAdjustment);
 
-    QFontMetricsF superscriptFontMetrics(font);
+    const QFontMetricsF& superscriptFontMetrics = FontMetricsCache::fontMetrics(font);
     QString opString = QChar(0x200A) + operatorString(format);
     float operatorAscent  = superscriptFontMetrics.ascent();
     float operatorDescent = superscriptFontMetrics.descent();
     float operatorWidth   = superscriptFontMetrics.horizontalAdvance(opString);
 
-    QFontMetricsF fontMetrics(font);
+    const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
     float positionAdjustment = fontMetrics.height() * superscriptBaseline;
     float superscriptAscent  = fontMetrics.ascent() - positionAdjustment;
 
@@ -11,6 +11,8 @@
 #include <QWeakPointer>
 #include <QString>
 #include <QMap>
+#include <QHash>
+#include <QSet>
 #include <QList>
 
 #include <ld_format_structures.h>
@@ -21,9 +23,12 @@
 #include <ld_cursor_state_collection.h>
 #include <ld_element.h>
 #include <ld_element_with_positional_children.h>
+#include <ld_format.h>
+#include <ld_visual.h>
 
 #include "command.h"
 #include "fixer.h"
+#include "root_presentation.h"
 #include "update_format_command.h"
 
 /***********************************************************************************************************************
@@ -83,7 +88,7 @@ UpdateFormatCommand::UpdateFormatCommand(
         const UpdateFormatCommand::FormatsByElement& formatsByElement,
         bool                                         allowMerge
     ) {
-    currentFormats       = toFormatsByPosition(formatsByElement);
+    currentFormats       = shareIdenticalFormats(toFormatsByPosition(formatsByElement));
     currentMergesAllowed = allowMerge;
 }
 
@@ -97,7 +102,7 @@ Command::CommandType UpdateFormatCommand::commandType() const {
 
 
 void UpdateFormatCommand::setFormatsByElement(const FormatsByElement& newFormatsByElement) {
-    currentFormats = toFormatsByPosition(newFormatsByElement);
+    currentFormats = shareIdenticalFormats(toFormatsByPosition(newFormatsByElement));
 }
 
 
@@ -129,7 +134,13 @@ bool UpdateFormatCommand::mergesNotAllowed() const {
 bool UpdateFormatCommand::execute(Ld::CursorStateCollection* cursorStateCollection) {
     bool success;
 
-    deletedFormats = updateFormats(currentFormats, currentMergesAllowed, cursorAtIssue(), cursorStateCollection);
+    if (reverseMerges(currentMerges, cursorStateCollection)) {
+        currentMerges.clear();
+        deletedFormats = shareIdenticalFormats(
+            updateFormats(currentFormats, currentMergesAllowed, cursorAtIssue(), cursorStateCollection, &currentMerges)
+        );
+    }
+
     if (!deletedFormats.isEmpty()) {
         currentFormats.clear();
         success = true;
@@ -143,8 +154,12 @@ bool UpdateFormatCommand::execute(Ld::CursorStateCollection* cursorStateCollecti
 
 bool UpdateFormatCommand::undo(Ld::CursorStateCollection* cursorStateCollection) {
     bool success;
-    if (!deletedFormats.isEmpty()) {
-        currentFormats = updateFormats(deletedFormats, currentMergesAllowed, cursorAtIssue(), cursorStateCollection);
+    if (!deletedFormats.isEmpty() && reverseMerges(currentMerges, cursorStateCollection)) {
+        currentMerges.clear();
+        currentFormats = shareIdenticalFormats(
+            updateFormats(deletedFormats, currentMergesAllowed, cursorAtIssue(), cursorStateCollection, &currentMerges)
+        );
+
         if (!currentFormats.isEmpty()) {
             deletedFormats.clear();
             success = true;
@@ -205,7 +220,40 @@ UpdateFormatCommand::FormatsByElement UpdateFormatCommand::toFormatsByElement(
         Ld::ElementPointer element = pos.key().element();
         Ld::FormatPointer  format  = pos.value();
 
-        result.insert(element, format);
+        if (!element.isNull()) {
+            result.insert(element, format);
+        }
+    }
+
+    return result;
+}
+
+
+UpdateFormatCommand::FormatsByPosition UpdateFormatCommand::shareIdenticalFormats(
+        const UpdateFormatCommand::FormatsByPosition& formatsByPosition
+    ) {
+    FormatsByPosition                 result;
+    QHash<QString, Ld::FormatPointer> sharedFormats;
+
+    for (  FormatsByPosition::const_iterator pos = formatsByPosition.constBegin(),
+                                             end = formatsByPosition.constEnd()
+         ; pos != end
+         ; ++pos
+        ) {
+        Ld::FormatPointer format = pos.value();
+
+        if (!format.isNull()) {
+            QString key = format->typeName() + QChar('\n') + format->toString();
+
+            QHash<QString, Ld::FormatPointer>::const_iterator shared = sharedFormats.constFind(key);
+            if (shared != sharedFormats.constEnd()) {
+                format = shared.value();
+            } else {
+                sharedFormats.insert(key, format);
+            }
+        }
+
+        result.insert(pos.key(), format);
     }
 
     return result;
@@ -216,7 +264,8 @@ UpdateFormatCommand::FormatsByPosition UpdateFormatCommand::updateFormats(
         const UpdateFormatCommand::FormatsByPosition& formatsByPosition,
         bool                                          mergesAllowed,
         const Cursor&                                 cursor,
-        Ld::CursorStateCollection*                    cursorStateCollection
+        Ld::CursorStateCollection*                    cursorStateCollection,
+        QList<UpdateFormatCommand::MergeRecord>*      merges
     ) {
     FormatsByElement  formatsByElement = toFormatsByElement(formatsByPosition);
     FormatsByPosition oldFormats;
@@ -277,16 +326,45 @@ UpdateFormatCommand::FormatsByPosition UpdateFormatCommand::updateFormats(
         }
     }
 
-    if (success) {
-        for (  FormatsByElement::const_iterator pos = formatsByElement.constBegin(),
-                                                end = formatsByElement.constEnd()
+    if (success && !formatsByElement.isEmpty()) {
+        Ld::ElementPointer rootElement      = formatsByElement.firstKey()->root();
+        RootPresentation*  rootPresentation = Q_NULLPTR;
+
+        if (!rootElement.isNull()) {
+            rootPresentation = dynamic_cast<RootPresentation*>(rootElement->visual());
+        }
+
+        if (rootPresentation != Q_NULLPTR) {
+            rootPresentation->beginRepositioningBatch();
+        }
+
+        // Formats are applied in document order.  Each element must own its format so shared instances are cloned
+        // after their first use.
+
+        // Old formats are recorded here, before any merges, while every position is still valid.  The merges are
+        // recorded so they can be reversed, restoring these positions, before the old formats are reapplied.
+
+        FormatsByPosition         orderedFormats = toFormatsByPosition(formatsByElement);
+        QList<Ld::ElementPointer> updatedElements;
+        QSet<Ld::Format*>         assignedFormats;
+
+        for (  FormatsByPosition::const_iterator pos = orderedFormats.constBegin(),
+                                                 end = orderedFormats.constEnd()
              ; pos != end
              ; ++pos
             ) {
-            Ld::ElementPointer element   = pos.key();
+            Ld::ElementPointer element   = pos.key().element();
             Ld::FormatPointer  format    = pos.value();
             Ld::FormatPointer  oldFormat = element->format();
 
+            if (!format.isNull()) {
+                if (assignedFormats.contains(format.data())) {
+                    format = format->clone();
+                }
+
+                assignedFormats.insert(format.data());
+            }
+
             element->setFormat(format);
 
             const Fixer* fixer = Fixer::fixer(element->typeName());
@@ -297,29 +375,63 @@ UpdateFormatCommand::FormatsByPosition UpdateFormatCommand::updateFormats(
                 }
             }
 
-            bool               lastChild;
-            Ld::ElementPointer nextSibling = element->nextSibling(&lastChild);
-            if (!lastChild && mergesAllowed && isMergeAllowed(element, nextSibling, true)) {
-                Ld::ElementPointer parent = element->parent();
-
-                mergeElements(element, nextSibling, cursorStateCollection);
-                parent->removeChild(nextSibling, cursorStateCollection);
-
-                cursorRestoreNeeded = true;
-            }
-
-            bool firstChild;
-            Ld::ElementPointer previousSibling = element->previousSibling(&firstChild);
-            if (!firstChild && mergesAllowed && isMergeAllowed(previousSibling, element, true)) {
-                Ld::ElementPointer parent = element->parent();
-
-                mergeElements(previousSibling, element, cursorStateCollection);
-                parent->removeChild(element, cursorStateCollection);
+            updatedElements.append(element);
+            oldFormats.insert(pos.key(), oldFormat);
+        }
 
-                cursorRestoreNeeded = true;
+        // Merges are performed in a single sweep once every format is in place.  Working in document order, an
+        // element first absorbs any following siblings it can merge with and is then offered to its preceding
+        // sibling.
+
+        if (mergesAllowed) {
+            for (  QList<Ld::ElementPointer>::const_iterator it  = updatedElements.constBegin(),
+                                                             end = updatedElements.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                Ld::ElementPointer element = *it;
+
+                // Elements absorbed earlier in the sweep are detached and skipped.
+
+                if (!element->parent().isNull()) {
+                    bool               lastChild;
+                    Ld::ElementPointer nextSibling = element->nextSibling(&lastChild);
+                    while (!lastChild && isMergeAllowed(element, nextSibling, true)) {
+                        Ld::ElementPointer parent      = element->parent();
+                        Ld::ElementCursor  mergeCursor = mergeElements(element, nextSibling, cursorStateCollection);
+                        parent->removeChild(nextSibling, cursorStateCollection);
+
+                        MergeRecord merge;
+                        merge.position    = Ld::ElementPosition(element);
+                        merge.textIndex   = mergeCursor.textIndex();
+                        merge.regionIndex = mergeCursor.regionIndex();
+                        merges->append(merge);
+
+                        cursorRestoreNeeded = true;
+                        nextSibling         = element->nextSibling(&lastChild);
+                    }
+
+                    bool firstChild;
+                    Ld::ElementPointer previousSibling = element->previousSibling(&firstChild);
+                    if (!firstChild && isMergeAllowed(previousSibling, element, true)) {
+                        Ld::ElementPointer parent      = element->parent();
+                        Ld::ElementCursor  mergeCursor = mergeElements(previousSibling, element, cursorStateCollection);
+                        parent->removeChild(element, cursorStateCollection);
+
+                        MergeRecord merge;
+                        merge.position    = Ld::ElementPosition(previousSibling);
+                        merge.textIndex   = mergeCursor.textIndex();
+                        merge.regionIndex = mergeCursor.regionIndex();
+                        merges->append(merge);
+
+                        cursorRestoreNeeded = true;
+                    }
+                }
             }
+        }
 
-            oldFormats.insert(Ld::ElementPosition(element), oldFormat);
+        if (rootPresentation != Q_NULLPTR) {
+            rootPresentation->endRepositioningBatch();
         }
 
         if (cursorRestoreNeeded) {
@@ -329,3 +441,35 @@ UpdateFormatCommand::FormatsByPosition UpdateFormatCommand::updateFormats(
 
     return oldFormats;
 }
+
+
+bool UpdateFormatCommand::reverseMerges(
+        const QList<UpdateFormatCommand::MergeRecord>& merges,
+        Ld::CursorStateCollection*                     cursorStateCollection
+    ) {
+    bool success = true;
+
+    QList<MergeRecord>::const_iterator it  = merges.constEnd();
+    QList<MergeRecord>::const_iterator end = merges.constBegin();
+    while (success && it != end) {
+        --it;
+
+        Ld::ElementPointer element = it->position.element();
+        if (!element.isNull()) {
+            Ld::ElementCursor splitCursor(it->textIndex, it->regionIndex, element);
+            if (isSplitAllowed(Fixer::SplitReason::FORMAT_CHANGE, splitCursor)) {
+                splitElement(Fixer::SplitReason::FORMAT_CHANGE, splitCursor, cursorStateCollection);
+            } else {
+                success = false;
+            }
+        } else {
+            success = false;
+        }
+    }
+
+    if (!merges.isEmpty()) {
+        cursorStateCollection->updateCursorState(false);
+    }
+
+    return success;
+}
@@ -40,6 +40,7 @@
 #include <ld_value_field_visual.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "data_type_presentation_generator.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
@@ -401,7 +402,7 @@ ValueFieldPresentation::PresentationAreas ValueFieldPresentation::buildDefaultGr
         font1.setPointSizeF(fontPointSize * fontScaleFactor * relativeScale);
     }
 
-    QFontMetricsF fontMetrics1(font1);
+    const QFontMetricsF& fontMetrics1 = FontMetricsCache::fontMetrics(font1);
     float text1Width  = fontMetrics1.horizontalAdvance(text1);
     float text1Height = fontMetrics1.height();
     float text1Ascent = fontMetrics1.ascent();
@@ -410,7 +411,7 @@ ValueFieldPresentation::PresentationAreas ValueFieldPresentation::buildDefaultGr
     float text2Height;
     float subscriptPositionAdjustment;
 
-    QFontMetricsF fontMetrics2(font2);
+    const QFontMetricsF& fontMetrics2 = FontMetricsCache::fontMetrics(font2);
 
     text2Width                  = fontMetrics2.horizontalAdvance(text2);
     text2Height                 = fontMetrics2.height();
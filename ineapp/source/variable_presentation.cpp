@@ -43,6 +43,7 @@
 #include <ld_element_cursor.h>
 
 #include "application.h"
+#include "font_metrics_cache.h"
 #include "placement_negotiator.h"
 #include "placement_tracker.h"
 #include "leaf_presentation.h"
@@ -110,7 +111,7 @@ void VariablePresentation::recalculatePlacement(
     QPen   fontPen(color.isValid() ? color : QColor(Qt::black));
     QBrush fontBackgroundBrush(backgroundColor.isValid() ? backgroundColor : QColor(255, 255, 255, 0));
 
-    QFontMetricsF fontMetrics1(font1);
+    const QFontMetricsF& fontMetrics1 = FontMetricsCache::fontMetrics(font1);
     float text1Width  = fontMetrics1.horizontalAdvance(text1);
     float text1Height = fontMetrics1.height();
     float text1Ascent = fontMetrics1.ascent();
@@ -119,7 +120,7 @@ void VariablePresentation::recalculatePlacement(
     float text2Height;
     float subscriptPositionAdjustment;
 
-    QFontMetricsF fontMetrics2(font2);
+    const QFontMetricsF& fontMetrics2 = FontMetricsCache::fontMetrics(font2);
 
     text2Width                  = fontMetrics2.horizontalAdvance(text2);
     text2Height                 = fontMetrics2.height();
@@ -303,7 +304,7 @@ QList<QRectF> VariablePresentation::cursorRangeToScene(
             const QFont&                                  font     = entry.font();
             const QPointF&                                baseline = entry.position();
 
-            QFontMetricsF fontMetrics(font);
+            const QFontMetricsF& fontMetrics = FontMetricsCache::fontMetrics(font);
             float startingOffset = fontMetrics.horizontalAdvance(text.left(startingTextIndex));
             float endingOffset   = fontMetrics.horizontalAdvance(text.left(endingTextIndex));
             float height         = fontMetrics.height();
@@ -331,8 +332,8 @@ QList<QRectF> VariablePresentation::cursorRangeToScene(
             const QFont&   font2     = entry2.font();
             const QPointF& baseline2 = entry2.position();
 
-            QFontMetricsF fontMetrics1(font1);
-            QFontMetricsF fontMetrics2(font2);
+            const QFontMetricsF& fontMetrics1 = FontMetricsCache::fontMetrics(font1);
+            const QFontMetricsF& fontMetrics2 = FontMetricsCache::fontMetrics(font2);
 
             float height1        = fontMetrics1.height();
             float ascent1        = fontMetrics1.ascent();
@@ -366,6 +366,29 @@ ViewWidget::SearchResult ViewWidget::searchBackward(
 }
 
 
+QList<DocumentTextIndex::Match> ViewWidget::findAll(
+        const QString& searchText,
+        bool           caseSensitive,
+        bool           wholeWordsOnly,
+        bool           regularExpression
+    ) {
+    Editor* editor = widget<Editor>("editor");
+    return editor->findAll(searchText, caseSensitive, wholeWordsOnly, regularExpression);
+}
+
+
+unsigned long ViewWidget::replaceAll(
+        const QString& searchText,
+        const QString& replacementText,
+        bool           caseSensitive,
+        bool           wholeWordsOnly,
+        bool           regularExpression
+    ) {
+    Editor* editor = widget<Editor>("editor");
+    return editor->replaceAll(searchText, replacementText, caseSensitive, wholeWordsOnly, regularExpression);
+}
+
+
 void ViewWidget::setZoom(float newZoomFactor) {
     Editor* editor = widget<Editor>("editor");
     editor->setZoom(newZoomFactor);
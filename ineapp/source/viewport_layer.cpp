@@ -0,0 +1,113 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref ViewportLayer class.
+***********************************************************************************************************************/
+
+#include <QSize>
+#include <QRect>
+#include <QRegion>
+#include <QPixmap>
+
+#include <cmath>
+#include <cstdlib>
+
+#include "viewport_layer.h"
+
+ViewportLayer::ViewportLayer(bool transparent) {
+    currentTransparent = transparent;
+}
+
+
+ViewportLayer::~ViewportLayer() {}
+
+
+bool ViewportLayer::resize(const QSize& newSize, qreal devicePixelRatio) {
+    bool reallocate = (newSize != currentSize || currentPixmap.devicePixelRatio() != devicePixelRatio);
+
+    if (reallocate) {
+        currentSize   = newSize;
+        currentPixmap = QPixmap(
+            static_cast<int>(std::ceil(newSize.width() * devicePixelRatio)),
+            static_cast<int>(std::ceil(newSize.height() * devicePixelRatio))
+        );
+
+        currentPixmap.setDevicePixelRatio(devicePixelRatio);
+
+        if (currentTransparent) {
+            currentPixmap.fill(Qt::transparent);
+        }
+
+        invalidate();
+    }
+
+    return reallocate;
+}
+
+
+const QSize& ViewportLayer::size() const {
+    return currentSize;
+}
+
+
+void ViewportLayer::scroll(int dx, int dy) {
+    QRect layerRectangle(QPoint(0, 0), currentSize);
+
+    if (std::abs(dx) >= currentSize.width() || std::abs(dy) >= currentSize.height()) {
+        invalidate();
+    } else if (dx != 0 || dy != 0) {
+        qreal devicePixelRatio = currentPixmap.devicePixelRatio();
+        currentPixmap.scroll(
+            static_cast<int>(dx * devicePixelRatio),
+            static_cast<int>(dy * devicePixelRatio),
+            currentPixmap.rect()
+        );
+
+        currentDirtyRegion.translate(dx, dy);
+        currentDirtyRegion &= layerRectangle;
+        currentDirtyRegion |= QRegion(layerRectangle).subtracted(QRegion(layerRectangle.translated(dx, dy)));
+    }
+}
+
+
+void ViewportLayer::invalidate() {
+    currentDirtyRegion = QRegion(QRect(QPoint(0, 0), currentSize));
+}
+
+
+void ViewportLayer::invalidate(const QRect& rectangle) {
+    currentDirtyRegion |= rectangle.intersected(QRect(QPoint(0, 0), currentSize));
+}
+
+
+bool ViewportLayer::isDirty() const {
+    return !currentDirtyRegion.isEmpty();
+}
+
+
+const QRegion& ViewportLayer::dirtyRegion() const {
+    return currentDirtyRegion;
+}
+
+
+void ViewportLayer::markClean() {
+    currentDirtyRegion = QRegion();
+}
+
+
+bool ViewportLayer::isTransparent() const {
+    return currentTransparent;
+}
+
+
+QPixmap& ViewportLayer::pixmap() {
+    return currentPixmap;
+}
+
+
+const QPixmap& ViewportLayer::pixmap() const {
+    return currentPixmap;
+}
@@ -37,6 +37,7 @@
 #include <ld_plot_format.h>
 
 #include "application.h"
+#include "native_plot_item.h"
 #include "plot_2d_engine_base.h"
 #include "xy_plot_presentation_data.h"
 #include "xy_plot_engine.h"
@@ -105,22 +106,43 @@ QSet<PlotEngine::AxisScale> XyPlotEngine::supportedAxisScales(PlotEngine::AxisLo
 }
 
 
+bool XyPlotEngine::supportsNativeRenderer() const {
+    return true;
+}
+
+
 PlotPresentationData* XyPlotEngine::createPresentationData(
         QSharedPointer<Ld::PlotElement> plotElement,
         QSharedPointer<Ld::PlotFormat>  plotFormat
     ) const {
-    EQt::ChartItem*         chartItem        = new EQt::ChartItem;
-    XyPlotPresentationData* presentationData = new XyPlotPresentationData(chartItem);
+    XyPlotPresentationData* presentationData;
+    QSizeF                  sizeSceneUnits = toScene(QSizeF(plotFormat->chartWidth(), plotFormat->chartHeight()));
 
-    QSizeF sizeSceneUnits = toScene(QSizeF(plotFormat->chartWidth(), plotFormat->chartHeight()));
-    chartItem->setGeometry(0, 0, sizeSceneUnits.width(), sizeSceneUnits.height());
+    if (nativeRendererEnabled()) {
+        NativePlotItem* plotItem = new NativePlotItem;
+        presentationData = new XyPlotPresentationData(plotItem);
 
-    dynamic_cast<EQt::GraphicsItemGroup*>(presentationData->graphicsItem())->setForcedGeometry(
-        0, 0,
-        sizeSceneUnits.width(), sizeSceneUnits.height()
-    );
+        plotItem->setGeometry(0, 0, sizeSceneUnits.width(), sizeSceneUnits.height());
+
+        dynamic_cast<EQt::GraphicsItemGroup*>(presentationData->graphicsItem())->setForcedGeometry(
+            0, 0,
+            sizeSceneUnits.width(), sizeSceneUnits.height()
+        );
+
+        configureChart(plotItem, presentationData, plotElement, plotFormat);
+    } else {
+        EQt::ChartItem* chartItem = new EQt::ChartItem;
+        presentationData = new XyPlotPresentationData(chartItem);
+
+        chartItem->setGeometry(0, 0, sizeSceneUnits.width(), sizeSceneUnits.height());
+
+        dynamic_cast<EQt::GraphicsItemGroup*>(presentationData->graphicsItem())->setForcedGeometry(
+            0, 0,
+            sizeSceneUnits.width(), sizeSceneUnits.height()
+        );
 
-    configureChart(chartItem, presentationData, plotElement, plotFormat);
+        configureChart(chartItem, presentationData, plotElement, plotFormat);
+    }
 
     return presentationData;
 }
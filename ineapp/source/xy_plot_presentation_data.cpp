@@ -9,12 +9,12 @@
 
 #include <QObject>
 
-#include <eqt_chart_item.h>
+#include <eqt_graphics_item.h>
 
 #include "plot_2d_presentation_data.h"
 #include "xy_plot_presentation_data.h"
 
-XyPlotPresentationData::XyPlotPresentationData(EQt::ChartItem* chartItem):Plot2DPresentationData(chartItem) {}
+XyPlotPresentationData::XyPlotPresentationData(EQt::GraphicsItem* chartItem):Plot2DPresentationData(chartItem) {}
 
 
 XyPlotPresentationData::~XyPlotPresentationData() {}
@@ -18,7 +18,7 @@
 #include "plot_2d_presentation_data.h"
 
 namespace EQt {
-    class ChartItem;
+    class GraphicsItem;
 }
 
 /**
@@ -31,9 +31,10 @@ class APP_PUBLIC_API XyPlotPresentationData:public Plot2DPresentationData {
         /**
          * Constructor
          *
-         * \param[in] graphicsItem The chart item containing the plot.
+         * \param[in] graphicsItem The chart item containing the plot.  The item must be either an EQt::ChartItem
+         *                         or a \ref NativePlotItem.
          */
-        XyPlotPresentationData(EQt::ChartItem* graphicsItem);
+        XyPlotPresentationData(EQt::GraphicsItem* graphicsItem);
 
         ~XyPlotPresentationData() override;
 };
@@ -0,0 +1,385 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref BenchmarkDocumentGenerator class.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QBuffer>
+#include <QImage>
+#include <QPainter>
+#include <QColor>
+#include <QList>
+#include <QSharedPointer>
+
+#include <ld_element_structures.h>
+#include <ld_format_structures.h>
+#include <ld_element.h>
+#include <ld_element_with_fixed_children.h>
+#include <ld_element_with_grid_children.h>
+#include <ld_visual.h>
+#include <ld_format.h>
+#include <ld_page_format.h>
+#include <ld_paragraph_format.h>
+#include <ld_font_format.h>
+#include <ld_character_format.h>
+#include <ld_operator_format.h>
+#include <ld_image_format.h>
+#include <ld_table_frame_format.h>
+#include <ld_root_element.h>
+#include <ld_paragraph_element.h>
+#include <ld_text_element.h>
+#include <ld_image_element.h>
+#include <ld_table_frame_element.h>
+#include <ld_assignment_operator_element.h>
+#include <ld_addition_operator_element.h>
+#include <ld_fraction_operator_element.h>
+#include <ld_matrix_operator_element.h>
+#include <ld_variable_element.h>
+#include <ld_literal_element.h>
+
+#include <paragraph_presentation.h>
+#include <text_presentation.h>
+#include <image_presentation.h>
+#include <table_frame_presentation.h>
+#include <assignment_operator_presentation.h>
+#include <addition_operator_presentation.h>
+#include <fraction_operator_presentation.h>
+#include <matrix_operator_presentation.h>
+#include <variable_presentation.h>
+#include <literal_presentation.h>
+
+#include "benchmark_document_generator.h"
+
+void BenchmarkDocumentGenerator::registerCreators() {
+    Ld::Format::registerCreator(Ld::PageFormat::formatName, Ld::PageFormat::creator);
+    Ld::Format::registerCreator(Ld::ParagraphFormat::formatName, Ld::ParagraphFormat::creator);
+    Ld::Format::registerCreator(Ld::CharacterFormat::formatName, Ld::CharacterFormat::creator);
+    Ld::Format::registerCreator(Ld::OperatorFormat::formatName, Ld::OperatorFormat::creator);
+    Ld::Format::registerCreator(Ld::ImageFormat::formatName, Ld::ImageFormat::creator);
+    Ld::Format::registerCreator(Ld::TableFrameFormat::formatName, Ld::TableFrameFormat::creator);
+
+    Ld::Element::registerCreator(Ld::ParagraphElement::elementName, Ld::ParagraphElement::creator);
+    Ld::Element::registerCreator(Ld::TextElement::elementName, Ld::TextElement::creator);
+    Ld::Element::registerCreator(Ld::ImageElement::elementName, Ld::ImageElement::creator);
+    Ld::Element::registerCreator(Ld::TableFrameElement::elementName, Ld::TableFrameElement::creator);
+    Ld::Element::registerCreator(Ld::AssignmentOperatorElement::elementName, Ld::AssignmentOperatorElement::creator);
+    Ld::Element::registerCreator(Ld::AdditionOperatorElement::elementName, Ld::AdditionOperatorElement::creator);
+    Ld::Element::registerCreator(Ld::FractionOperatorElement::elementName, Ld::FractionOperatorElement::creator);
+    Ld::Element::registerCreator(Ld::MatrixOperatorElement::elementName, Ld::MatrixOperatorElement::creator);
+    Ld::Element::registerCreator(Ld::VariableElement::elementName, Ld::VariableElement::creator);
+    Ld::Element::registerCreator(Ld::LiteralElement::elementName, Ld::LiteralElement::creator);
+
+    Ld::Visual::registerCreator(Ld::ParagraphElement::elementName, ParagraphPresentation::creator);
+    Ld::Visual::registerCreator(Ld::TextElement::elementName, TextPresentation::creator);
+    Ld::Visual::registerCreator(Ld::ImageElement::elementName, ImagePresentation::creator);
+    Ld::Visual::registerCreator(Ld::TableFrameElement::elementName, TableFramePresentation::creator);
+    Ld::Visual::registerCreator(Ld::AssignmentOperatorElement::elementName, AssignmentOperatorPresentation::creator);
+    Ld::Visual::registerCreator(Ld::AdditionOperatorElement::elementName, AdditionOperatorPresentation::creator);
+    Ld::Visual::registerCreator(Ld::FractionOperatorElement::elementName, FractionOperatorPresentation::creator);
+    Ld::Visual::registerCreator(Ld::MatrixOperatorElement::elementName, MatrixOperatorPresentation::creator);
+    Ld::Visual::registerCreator(Ld::VariableElement::elementName, VariablePresentation::creator);
+    Ld::Visual::registerCreator(Ld::LiteralElement::elementName, LiteralPresentation::creator);
+}
+
+
+QString BenchmarkDocumentGenerator::documentName(BenchmarkDocumentGenerator::DocumentType documentType) {
+    QString result;
+
+    switch (documentType) {
+        case DocumentType::PROSE:     { result = QString("prose");       break; }
+        case DocumentType::EQUATIONS: { result = QString("equations");   break; }
+        case DocumentType::MATRICES:  { result = QString("matrices");    break; }
+        case DocumentType::TABLES:    { result = QString("tables");      break; }
+        case DocumentType::IMAGES:    { result = QString("images");      break; }
+        default: {
+            Q_ASSERT(false);
+            break;
+        }
+    }
+
+    return result;
+}
+
+
+QSharedPointer<Ld::RootElement> BenchmarkDocumentGenerator::createDocument(
+        BenchmarkDocumentGenerator::DocumentType documentType,
+        unsigned                                 scale
+    ) {
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement());
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    switch (documentType) {
+        case DocumentType::PROSE:     { populateProse(rootElement, scale);       break; }
+        case DocumentType::EQUATIONS: { populateEquations(rootElement, scale);   break; }
+        case DocumentType::MATRICES:  { populateMatrices(rootElement, scale);    break; }
+        case DocumentType::TABLES:    { populateTables(rootElement, scale);      break; }
+        case DocumentType::IMAGES:    { populateImages(rootElement, scale);      break; }
+        default: {
+            Q_ASSERT(false);
+            break;
+        }
+    }
+
+    return rootElement;
+}
+
+
+Ld::ElementPointer BenchmarkDocumentGenerator::editTarget(QSharedPointer<Ld::RootElement> rootElement) {
+    QList<Ld::ElementPointer> candidates;
+    QList<Ld::ElementPointer> pending;
+
+    pending.append(rootElement);
+    while (!pending.isEmpty()) {
+        Ld::ElementPointer element  = pending.takeFirst();
+        QString            typeName = element->typeName();
+
+        if (typeName == Ld::TextElement::elementName     ||
+            typeName == Ld::VariableElement::elementName ||
+            typeName == Ld::LiteralElement::elementName     ) {
+            candidates.append(element);
+        }
+
+        unsigned long numberChildren = element->numberChildren();
+        for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+            Ld::ElementPointer child = element->child(childIndex);
+            if (!child.isNull()) {
+                pending.append(child);
+            }
+        }
+    }
+
+    return candidates.isEmpty() ? Ld::ElementPointer() : candidates.at(candidates.size() / 2);
+}
+
+
+void BenchmarkDocumentGenerator::appendParagraph(
+        QSharedPointer<Ld::RootElement> rootElement,
+        Ld::ElementPointer              child
+    ) {
+    QSharedPointer<Ld::ParagraphElement> paragraph = Ld::Element::create(Ld::ParagraphElement::elementName)
+                                                     .dynamicCast<Ld::ParagraphElement>();
+
+    paragraph->setFormat(Ld::Format::create(Ld::ParagraphFormat::formatName));
+    paragraph->append(child, Q_NULLPTR);
+
+    rootElement->append(paragraph, Q_NULLPTR);
+}
+
+
+Ld::ElementPointer BenchmarkDocumentGenerator::createText(
+        QSharedPointer<Ld::RootElement> rootElement,
+        const QString&                  text
+    ) {
+    Ld::ElementPointer textElement = Ld::Element::create(Ld::TextElement::elementName);
+    textElement->setFormat(rootElement->defaultTextFormat()->clone());
+    textElement->setText(text);
+
+    return textElement;
+}
+
+
+Ld::ElementPointer BenchmarkDocumentGenerator::createMathElement(
+        QSharedPointer<Ld::RootElement> rootElement,
+        const QString&                  typeName,
+        const QString&                  text
+    ) {
+    Ld::ElementPointer element = Ld::Element::create(typeName);
+
+    QSharedPointer<Ld::FontFormat> format     = Ld::Format::create(Ld::OperatorFormat::formatName)
+                                                .dynamicCast<Ld::FontFormat>();
+    QSharedPointer<Ld::FontFormat> mathFormat = rootElement->defaultMathTextFormat().dynamicCast<Ld::FontFormat>();
+
+    format->setFamily(mathFormat->family());
+    format->setFontSize(mathFormat->fontSize());
+    format->setFontWeight(mathFormat->fontWeight());
+    format->setItalics(mathFormat->italics());
+
+    element->setFormat(format);
+
+    if (!text.isEmpty()) {
+        element->setText(text, 0);
+    }
+
+    return element;
+}
+
+
+QString BenchmarkDocumentGenerator::proseText(unsigned paragraphIndex) {
+    static const QStringList words = QString(
+        "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor incididunt ut labore et dolore "
+        "magna aliqua enim ad minim veniam quis nostrud exercitation ullamco laboris nisi aliquip ex ea commodo "
+        "consequat duis aute irure in reprehenderit voluptate velit esse cillum fugiat nulla pariatur"
+    ).split(' ');
+
+    unsigned    numberWords = static_cast<unsigned>(words.size());
+    QStringList paragraphWords;
+
+    for (unsigned wordIndex=0 ; wordIndex<numberWordsPerParagraph ; ++wordIndex) {
+        paragraphWords.append(words.at((paragraphIndex * 7 + wordIndex * 13) % numberWords));
+    }
+
+    return paragraphWords.join(' ');
+}
+
+
+QByteArray BenchmarkDocumentGenerator::imagePayload(unsigned imageIndex) {
+    QImage image(imageWidth, imageHeight, QImage::Format_RGB32);
+    image.fill(QColor::fromHsv((imageIndex * 37) % 360, 64, 240));
+
+    QPainter painter(&image);
+    for (unsigned band=0 ; band<16 ; ++band) {
+        painter.fillRect(
+            band * imageWidth / 16,
+            (band * 29 + imageIndex * 11) % imageHeight,
+            imageWidth / 32,
+            imageHeight / 4,
+            QColor::fromHsv((imageIndex * 37 + band * 20) % 360, 200, 200)
+        );
+    }
+
+    painter.end();
+
+    QByteArray payload;
+    QBuffer    buffer(&payload);
+    image.save(&buffer, "PNG");
+
+    return payload;
+}
+
+
+void BenchmarkDocumentGenerator::populateProse(QSharedPointer<Ld::RootElement> rootElement, unsigned scale) {
+    unsigned numberParagraphs = numberProseParagraphs * scale;
+    for (unsigned paragraphIndex=0 ; paragraphIndex<numberParagraphs ; ++paragraphIndex) {
+        appendParagraph(rootElement, createText(rootElement, proseText(paragraphIndex)));
+    }
+}
+
+
+void BenchmarkDocumentGenerator::populateEquations(QSharedPointer<Ld::RootElement> rootElement, unsigned scale) {
+    unsigned numberEquationsToCreate = numberEquations * scale;
+    for (unsigned equationIndex=0 ; equationIndex<numberEquationsToCreate ; ++equationIndex) {
+        // Each equation has the form x_n = (a_n + n) / (n + 1)
+
+        QSharedPointer<Ld::ElementWithFixedChildren>
+            sum = createMathElement(rootElement, Ld::AdditionOperatorElement::elementName)
+                  .dynamicCast<Ld::ElementWithFixedChildren>();
+
+        sum->setChild(
+            0,
+            createMathElement(rootElement, Ld::VariableElement::elementName, QString("a%1").arg(equationIndex)),
+            Q_NULLPTR
+        );
+
+        sum->setChild(
+            1,
+            createMathElement(rootElement, Ld::LiteralElement::elementName, QString::number(equationIndex)),
+            Q_NULLPTR
+        );
+
+        QSharedPointer<Ld::ElementWithFixedChildren>
+            fraction = createMathElement(rootElement, Ld::FractionOperatorElement::elementName)
+                       .dynamicCast<Ld::ElementWithFixedChildren>();
+
+        fraction->setChild(0, sum, Q_NULLPTR);
+        fraction->setChild(
+            1,
+            createMathElement(rootElement, Ld::LiteralElement::elementName, QString::number(equationIndex + 1)),
+            Q_NULLPTR
+        );
+
+        QSharedPointer<Ld::ElementWithFixedChildren>
+            assignment = createMathElement(rootElement, Ld::AssignmentOperatorElement::elementName)
+                         .dynamicCast<Ld::ElementWithFixedChildren>();
+
+        assignment->setChild(
+            0,
+            createMathElement(rootElement, Ld::VariableElement::elementName, QString("x%1").arg(equationIndex)),
+            Q_NULLPTR
+        );
+
+        assignment->setChild(1, fraction, Q_NULLPTR);
+
+        appendParagraph(rootElement, assignment);
+    }
+}
+
+
+void BenchmarkDocumentGenerator::populateMatrices(QSharedPointer<Ld::RootElement> rootElement, unsigned scale) {
+    unsigned numberMatricesToCreate = numberMatrices * scale;
+    for (unsigned matrixIndex=0 ; matrixIndex<numberMatricesToCreate ; ++matrixIndex) {
+        QSharedPointer<Ld::MatrixOperatorElement>
+            matrix = createMathElement(rootElement, Ld::MatrixOperatorElement::elementName)
+                     .dynamicCast<Ld::MatrixOperatorElement>();
+
+        matrix->format().dynamicCast<Ld::OperatorFormat>()->setParenthesisStyle(
+            Ld::OperatorFormat::ParenthesisStyle::BRACKETS
+        );
+
+        matrix->setNumberRows(matrixDimension, Q_NULLPTR);
+        matrix->setNumberColumns(matrixDimension, Q_NULLPTR);
+
+        for (unsigned row=0 ; row<matrixDimension ; ++row) {
+            for (unsigned column=0 ; column<matrixDimension ; ++column) {
+                Ld::ElementPointer literal = createMathElement(
+                    rootElement,
+                    Ld::LiteralElement::elementName,
+                    QString::number((matrixIndex + 1) * (row * matrixDimension + column))
+                );
+
+                matrix->setChild(row, column, literal, Q_NULLPTR);
+            }
+        }
+
+        appendParagraph(
+            rootElement,
+            createMathElement(rootElement, Ld::VariableElement::elementName, QString("M%1").arg(matrixIndex))
+        );
+
+        appendParagraph(rootElement, matrix);
+    }
+}
+
+
+void BenchmarkDocumentGenerator::populateTables(QSharedPointer<Ld::RootElement> rootElement, unsigned scale) {
+    unsigned numberTablesToCreate = numberTables * scale;
+    for (unsigned tableIndex=0 ; tableIndex<numberTablesToCreate ; ++tableIndex) {
+        QSharedPointer<Ld::TableFrameElement> tableElement = Ld::Element::create(Ld::TableFrameElement::elementName)
+                                                             .dynamicCast<Ld::TableFrameElement>();
+
+        tableElement->setFormat(Ld::Format::create(Ld::TableFrameFormat::formatName));
+        tableElement->insertRowsBefore(0, numberTableRows - 1, false);
+        tableElement->insertColumnsBefore(0, numberTableColumns - 1, false);
+
+        appendParagraph(rootElement, createText(rootElement, proseText(tableIndex).left(80)));
+        rootElement->append(tableElement, Q_NULLPTR);
+    }
+}
+
+
+void BenchmarkDocumentGenerator::populateImages(QSharedPointer<Ld::RootElement> rootElement, unsigned scale) {
+    unsigned numberImagesToCreate = numberImages * scale;
+    for (unsigned imageIndex=0 ; imageIndex<numberImagesToCreate ; ++imageIndex) {
+        QSharedPointer<Ld::ImageElement> imageElement = Ld::Element::create(Ld::ImageElement::elementName)
+                                                        .dynamicCast<Ld::ImageElement>();
+
+        QSharedPointer<Ld::ImageFormat>  imageFormat  = Ld::Format::create(Ld::ImageFormat::formatName)
+                                                        .dynamicCast<Ld::ImageFormat>();
+
+        imageFormat->setRotation(Ld::ImageFormat::Rotation::NO_ROTATION);
+        imageFormat->setHorizontalAxis(Ld::ImageFormat::Axis(0.5, Ld::ImageFormat::ImageScalingMode::FRACTIONAL));
+        imageFormat->setVerticalAxis(Ld::ImageFormat::Axis(0.5, Ld::ImageFormat::ImageScalingMode::FRACTIONAL));
+
+        imageElement->setFormat(imageFormat);
+        imageElement->updatePayload(imagePayload(imageIndex));
+
+        appendParagraph(rootElement, createText(rootElement, proseText(imageIndex).left(200)));
+        appendParagraph(rootElement, imageElement);
+    }
+}
@@ -0,0 +1,251 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref BenchmarkDocumentGenerator class.
+***********************************************************************************************************************/
+
+#ifndef BENCHMARK_DOCUMENT_GENERATOR_H
+#define BENCHMARK_DOCUMENT_GENERATOR_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QByteArray>
+#include <QSharedPointer>
+
+#include <ld_element_structures.h>
+#include <ld_root_element.h>
+
+/**
+ * Class that generates synthetic documents used by the benchmarks.  Each document stresses a different portion of
+ * the layout and rendering engine.
+ */
+class BenchmarkDocumentGenerator {
+    public:
+        /**
+         * Enumeration of supported document types.
+         */
+        enum class DocumentType {
+            /**
+             * Long prose, many paragraphs of wrapped text.
+             */
+            PROSE,
+
+            /**
+             * Dense equations, one assignment per paragraph.
+             */
+            EQUATIONS,
+
+            /**
+             * Large matrices.
+             */
+            MATRICES,
+
+            /**
+             * Tables.
+             */
+            TABLES,
+
+            /**
+             * Images interleaved with short paragraphs.
+             */
+            IMAGES
+        };
+
+        /**
+         * Method you can use to register the element, format, and presentation creators needed by the generated
+         * documents.  Note that no presentation is registered for the root element so that benchmarks can control
+         * when the document is first laid out.
+         */
+        static void registerCreators();
+
+        /**
+         * Method you can use to obtain a name for a document type.
+         *
+         * \param[in] documentType The document type of interest.
+         *
+         * \return Returns the document name, used in benchmark reports.
+         */
+        static QString documentName(DocumentType documentType);
+
+        /**
+         * Method you can use to create a synthetic document.
+         *
+         * \param[in] documentType The type of document to create.
+         *
+         * \param[in] scale        A multiplier applied to the default size of the document.
+         *
+         * \return Returns the root element of the newly created document.
+         */
+        static QSharedPointer<Ld::RootElement> createDocument(DocumentType documentType, unsigned scale = 1);
+
+        /**
+         * Method you can use to locate the element to be edited by single edit benchmarks.  The element is a text,
+         * variable, or literal element located near the middle of the document.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \return Returns the element to be edited.  A null pointer is returned if no suitable element exists.
+         */
+        static Ld::ElementPointer editTarget(QSharedPointer<Ld::RootElement> rootElement);
+
+    private:
+        /**
+         * Value indicating the number of prose paragraphs generated at a scale of 1.
+         */
+        static constexpr unsigned numberProseParagraphs = 400;
+
+        /**
+         * Value indicating the number of words in each prose paragraph.
+         */
+        static constexpr unsigned numberWordsPerParagraph = 120;
+
+        /**
+         * Value indicating the number of equations generated at a scale of 1.
+         */
+        static constexpr unsigned numberEquations = 600;
+
+        /**
+         * Value indicating the number of matrices generated at a scale of 1.
+         */
+        static constexpr unsigned numberMatrices = 20;
+
+        /**
+         * Value indicating the number of rows and columns in each matrix.
+         */
+        static constexpr unsigned matrixDimension = 30;
+
+        /**
+         * Value indicating the number of tables generated at a scale of 1.
+         */
+        static constexpr unsigned numberTables = 20;
+
+        /**
+         * Value indicating the number of rows in each table.
+         */
+        static constexpr unsigned numberTableRows = 20;
+
+        /**
+         * Value indicating the number of columns in each table.
+         */
+        static constexpr unsigned numberTableColumns = 8;
+
+        /**
+         * Value indicating the number of images generated at a scale of 1.
+         */
+        static constexpr unsigned numberImages = 50;
+
+        /**
+         * Value indicating the width of each image, in pixels.
+         */
+        static constexpr unsigned imageWidth = 800;
+
+        /**
+         * Value indicating the height of each image, in pixels.
+         */
+        static constexpr unsigned imageHeight = 600;
+
+        /**
+         * Method that appends a paragraph holding a single child element to the document.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] child       The child to place in the paragraph.
+         */
+        static void appendParagraph(QSharedPointer<Ld::RootElement> rootElement, Ld::ElementPointer child);
+
+        /**
+         * Method that creates a text element.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] text        The text to place in the element.
+         *
+         * \return Returns the newly created text element.
+         */
+        static Ld::ElementPointer createText(QSharedPointer<Ld::RootElement> rootElement, const QString& text);
+
+        /**
+         * Method that creates a math element with text.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] typeName    The element type name.
+         *
+         * \param[in] text        The text to place in the element.
+         *
+         * \return Returns the newly created element.
+         */
+        static Ld::ElementPointer createMathElement(
+            QSharedPointer<Ld::RootElement> rootElement,
+            const QString&                  typeName,
+            const QString&                  text = QString()
+        );
+
+        /**
+         * Method that generates a paragraph worth of text.
+         *
+         * \param[in] paragraphIndex The zero based index of the paragraph.  Used to vary the text.
+         *
+         * \return Returns the generated text.
+         */
+        static QString proseText(unsigned paragraphIndex);
+
+        /**
+         * Method that generates a PNG encoded image.
+         *
+         * \param[in] imageIndex The zero based index of the image.  Used to vary the image contents.
+         *
+         * \return Returns the PNG encoded image.
+         */
+        static QByteArray imagePayload(unsigned imageIndex);
+
+        /**
+         * Method that populates a prose document.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] scale       The document scale.
+         */
+        static void populateProse(QSharedPointer<Ld::RootElement> rootElement, unsigned scale);
+
+        /**
+         * Method that populates an equation document.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] scale       The document scale.
+         */
+        static void populateEquations(QSharedPointer<Ld::RootElement> rootElement, unsigned scale);
+
+        /**
+         * Method that populates a matrix document.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] scale       The document scale.
+         */
+        static void populateMatrices(QSharedPointer<Ld::RootElement> rootElement, unsigned scale);
+
+        /**
+         * Method that populates a table document.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] scale       The document scale.
+         */
+        static void populateTables(QSharedPointer<Ld::RootElement> rootElement, unsigned scale);
+
+        /**
+         * Method that populates an image document.
+         *
+         * \param[in] rootElement The root element of the document.
+         *
+         * \param[in] scale       The document scale.
+         */
+        static void populateImages(QSharedPointer<Ld::RootElement> rootElement, unsigned scale);
+};
+
+#endif
@@ -0,0 +1,50 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file is the main entry point for the ineapp layout and rendering benchmarks.
+*
+* The benchmarks can be configured using the following environment variables:
+*
+*     INEAPP_BENCHMARK_OUTPUT - The JSON file to receive the results.  Results are written to
+*                               benchmark_ineapp.json in the current directory by default.  A value of "-" will
+*                               cause results to be written to stdout.
+*
+*     INEAPP_BENCHMARK_SCALE  - A multiplier applied to the size of each generated document.  The default is 1.
+***********************************************************************************************************************/
+
+#include <QDebug>
+#include <QString>
+
+#include <metatypes.h>
+
+#include "application_wrapper.h"
+
+#include "benchmark_recorder.h"
+#include "benchmark_layout.h"
+
+int main(int argumentCount, char** argumentValues) {
+    ApplicationWrapper wrapper(argumentCount, argumentValues);
+    registerMetaTypes();
+
+    QString outputFilename = qEnvironmentVariable("INEAPP_BENCHMARK_OUTPUT", QString("benchmark_ineapp.json"));
+    if (outputFilename == QString("-")) {
+        outputFilename.clear();
+    }
+
+    bool     isOk;
+    unsigned scale = qEnvironmentVariable("INEAPP_BENCHMARK_SCALE", QString("1")).toUInt(&isOk);
+    if (!isOk || scale == 0) {
+        scale = 1;
+    }
+
+    BenchmarkRecorder recorder(outputFilename);
+
+    wrapper.includeTest(new BenchmarkLayout(&recorder, scale));
+
+    int status = wrapper.exec();
+
+    return status;
+}
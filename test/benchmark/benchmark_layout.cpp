@@ -0,0 +1,227 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements layout and rendering benchmarks for the \ref RootPresentation class.
+***********************************************************************************************************************/
+
+#include <QDebug>
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QString>
+#include <QSharedPointer>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+#include <QDir>
+#include <QGraphicsView>
+#include <QScrollBar>
+#include <QPrinter>
+
+#include <algorithm>
+
+#include <ld_handle.h>
+#include <ld_element_structures.h>
+#include <ld_element.h>
+#include <ld_root_element.h>
+#include <ld_plug_in_manager.h>
+
+#include <root_presentation.h>
+#include <printing_engine.h>
+
+#include "benchmark_recorder.h"
+#include "benchmark_document_generator.h"
+#include "benchmark_layout.h"
+
+BenchmarkLayout::BenchmarkLayout(BenchmarkRecorder* recorder, unsigned scale) {
+    currentRecorder = recorder;
+    currentScale    = scale;
+}
+
+
+BenchmarkLayout::~BenchmarkLayout() {}
+
+
+void BenchmarkLayout::initTestCase() {
+    QVERIFY(temporaryDirectory.isValid());
+
+    Ld::Element::setAutoDeleteVisuals(false);
+    Ld::Handle::initialize(0x123456789ABCDEF0ULL);
+
+    BenchmarkDocumentGenerator::registerCreators();
+}
+
+
+void BenchmarkLayout::benchmarkDocument_data() {
+    QTest::addColumn<int>("documentType");
+
+    QTest::newRow("prose")     << static_cast<int>(BenchmarkDocumentGenerator::DocumentType::PROSE);
+    QTest::newRow("equations") << static_cast<int>(BenchmarkDocumentGenerator::DocumentType::EQUATIONS);
+    QTest::newRow("matrices")  << static_cast<int>(BenchmarkDocumentGenerator::DocumentType::MATRICES);
+    QTest::newRow("tables")    << static_cast<int>(BenchmarkDocumentGenerator::DocumentType::TABLES);
+    QTest::newRow("images")    << static_cast<int>(BenchmarkDocumentGenerator::DocumentType::IMAGES);
+}
+
+
+void BenchmarkLayout::benchmarkDocument() {
+    QFETCH(int, documentType);
+
+    BenchmarkDocumentGenerator::DocumentType type = static_cast<BenchmarkDocumentGenerator::DocumentType>(
+        documentType
+    );
+
+    QString documentName = BenchmarkDocumentGenerator::documentName(type);
+    QString filename     = QDir(temporaryDirectory.path()).filePath(documentName + ".ms");
+
+    // Generate the document and save it so that the load phase measures parsing a real file.
+
+    {
+        QSharedPointer<Ld::RootElement> generatedRoot = BenchmarkDocumentGenerator::createDocument(type, currentScale);
+        QVERIFY(generatedRoot->saveAs(filename));
+        generatedRoot->close();
+    }
+
+    // Load
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement());
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    currentRecorder->startMeasurement(documentName, QString("load"));
+    bool loaded = rootElement->openExisting(filename, false, Ld::PlugInsByName());
+    currentRecorder->endMeasurement();
+
+    QVERIFY(loaded);
+
+    // Full layout
+
+    RootPresentation* rootPresentation = new RootPresentation;
+    rootPresentation->addPlacementStatusNotifierReceiver(currentRecorder);
+
+    currentRecorder->startMeasurement(documentName, QString("layout"));
+    rootElement->setVisual(rootPresentation);
+    bool laidOut = waitForLayout(rootPresentation);
+    currentRecorder->endMeasurement();
+
+    QVERIFY(laidOut);
+
+    // Single edit reflow
+
+    Ld::ElementPointer target = BenchmarkDocumentGenerator::editTarget(rootElement);
+    QVERIFY(!target.isNull());
+
+    currentRecorder->startMeasurement(documentName, QString("reflow"));
+    target->insertText(QString("x"), 0, 0, Q_NULLPTR, false);
+    bool reflowed = waitForLayout(rootPresentation);
+    currentRecorder->endMeasurement();
+
+    QVERIFY(reflowed);
+
+    // Scroll
+
+    currentRecorder->startMeasurement(documentName, QString("scroll"));
+    unsigned numberScrollPositions = scrollDocument(rootPresentation);
+    currentRecorder->endMeasurement();
+
+    QVERIFY(numberScrollPositions > 0);
+
+    // Export
+
+    currentRecorder->startMeasurement(documentName, QString("export"));
+    bool exported = exportDocument(rootElement, QDir(temporaryDirectory.path()).filePath(documentName + ".pdf"));
+    currentRecorder->endMeasurement();
+
+    QVERIFY(exported);
+
+    rootPresentation->removePlacementStatusNotifierReceiver(currentRecorder);
+    rootElement->setVisual(Q_NULLPTR);
+    delete rootPresentation;
+
+    rootElement->close();
+}
+
+
+void BenchmarkLayout::cleanupTestCase() {
+    QVERIFY(currentRecorder->writeResults());
+}
+
+
+bool BenchmarkLayout::waitForLayout(RootPresentation* rootPresentation) {
+    QEventLoop eventLoop;
+    QTimer     timeoutTimer;
+
+    timeoutTimer.setSingleShot(true);
+
+    connect(&timeoutTimer, &QTimer::timeout, &eventLoop, &QEventLoop::quit);
+    connect(rootPresentation, &RootPresentation::presentationUpdatesCompleted, &eventLoop, &QEventLoop::quit);
+
+    QCoreApplication::processEvents();
+
+    timeoutTimer.start(layoutTimeoutMilliseconds);
+    while (rootPresentation->arePresentationUpdatesPending() && timeoutTimer.isActive()) {
+        eventLoop.exec();
+    }
+
+    return !rootPresentation->arePresentationUpdatesPending();
+}
+
+
+unsigned BenchmarkLayout::scrollDocument(RootPresentation* rootPresentation) {
+    QGraphicsView view(rootPresentation);
+    view.resize(viewportWidth, viewportHeight);
+    view.show();
+
+    QCoreApplication::processEvents();
+
+    QScrollBar* scrollBar       = view.verticalScrollBar();
+    int         position        = scrollBar->minimum();
+    int         maximum         = scrollBar->maximum();
+    int         step            = std::max(1, scrollBar->pageStep() / 4);
+    unsigned    numberPositions = 0;
+
+    do {
+        scrollBar->setValue(position);
+        view.viewport()->repaint();
+
+        ++numberPositions;
+        position += step;
+    } while (position <= maximum);
+
+    return numberPositions;
+}
+
+
+bool BenchmarkLayout::exportDocument(QSharedPointer<Ld::RootElement> rootElement, const QString& outputFilename) {
+    QPrinter printer(QPrinter::HighResolution);
+
+    printer.setOutputFormat(QPrinter::PdfFormat);
+    printer.setOutputFileName(outputFilename);
+
+    PrintingEngine printingEngine(&printer, rootElement);
+    printingEngine.setRenderingMode(PrintingEngine::RenderingMode::VECTOR_DISPLAY_LISTS);
+
+    // The engine requests display lists from the thread owning the root presentation so the event loop must run
+    // while the engine works.
+
+    QEventLoop eventLoop;
+    bool       success = false;
+
+    connect(
+        &printingEngine,
+        &PrintingEngine::completed,
+        &eventLoop,
+        [&](bool completedSuccessfully) {
+            success = completedSuccessfully;
+            eventLoop.quit();
+        }
+    );
+
+    connect(&printingEngine, &PrintingEngine::aborted, &eventLoop, &QEventLoop::quit);
+
+    printingEngine.start();
+    eventLoop.exec();
+    printingEngine.waitComplete();
+
+    return success;
+}
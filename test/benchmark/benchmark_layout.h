@@ -0,0 +1,111 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides layout and rendering benchmarks for the \ref RootPresentation class.
+***********************************************************************************************************************/
+
+#ifndef BENCHMARK_LAYOUT_H
+#define BENCHMARK_LAYOUT_H
+
+#include <QtGlobal>
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QString>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+
+#include <ld_root_element.h>
+
+class RootPresentation;
+class BenchmarkRecorder;
+
+/**
+ * Class that measures load, full layout, single edit reflow, scroll, and export time for each synthetic document
+ * produced by \ref BenchmarkDocumentGenerator.  Results are reported through a \ref BenchmarkRecorder instance.
+ */
+class BenchmarkLayout:public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * Constructor
+         *
+         * \param[in] recorder The recorder used to collect results.  The recorder is not owned by this class.
+         *
+         * \param[in] scale    A multiplier applied to the size of each generated document.
+         */
+        BenchmarkLayout(BenchmarkRecorder* recorder, unsigned scale = 1);
+
+        ~BenchmarkLayout() override;
+
+    private slots:
+        void initTestCase();
+        void benchmarkDocument_data();
+        void benchmarkDocument();
+        void cleanupTestCase();
+
+    private:
+        /**
+         * The maximum time to wait for a layout to complete, in milliseconds.
+         */
+        static constexpr int layoutTimeoutMilliseconds = 600000;
+
+        /**
+         * The width of the simulated viewport, in pixels.
+         */
+        static constexpr int viewportWidth = 1024;
+
+        /**
+         * The height of the simulated viewport, in pixels.
+         */
+        static constexpr int viewportHeight = 768;
+
+        /**
+         * Method that runs the event loop until all pending presentation updates are complete.
+         *
+         * \param[in] rootPresentation The root presentation to wait on.
+         *
+         * \return Returns true if the layout completed.  Returns false if the layout timed out.
+         */
+        bool waitForLayout(RootPresentation* rootPresentation);
+
+        /**
+         * Method that scrolls a viewport over the full document, painting at each position.
+         *
+         * \param[in] rootPresentation The root presentation to be painted.
+         *
+         * \return Returns the number of positions that were painted.
+         */
+        unsigned scrollDocument(RootPresentation* rootPresentation);
+
+        /**
+         * Method that exports a document to PDF.
+         *
+         * \param[in] rootElement    The root element of the document to be exported.
+         *
+         * \param[in] outputFilename The PDF file to be written.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        bool exportDocument(QSharedPointer<Ld::RootElement> rootElement, const QString& outputFilename);
+
+        /**
+         * The recorder used to collect results.
+         */
+        BenchmarkRecorder* currentRecorder;
+
+        /**
+         * The document scale.
+         */
+        unsigned currentScale;
+
+        /**
+         * Directory used to hold saved and exported documents.
+         */
+        QTemporaryDir temporaryDirectory;
+};
+
+#endif
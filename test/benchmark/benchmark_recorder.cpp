@@ -0,0 +1,181 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref BenchmarkRecorder class.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QSysInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFile>
+
+#include <cstddef>
+#include <cstdio>
+
+#if (defined(Q_OS_WIN))
+
+    #include <Windows.h>
+    #include <Psapi.h>
+
+#elif (defined(Q_OS_LINUX) || defined(Q_OS_DARWIN))
+
+    #include <sys/resource.h>
+
+#else
+
+    #error Unknown platform
+
+#endif
+
+#include <placement_status_notifier.h>
+
+#include "benchmark_recorder.h"
+
+BenchmarkRecorder::BenchmarkRecorder(const QString& outputFilename) {
+    currentOutputFilename  = outputFilename;
+    completedPlacementJobs = 0;
+    currentPlacementJobs   = 0;
+    startingPlacementJobs  = 0;
+}
+
+
+BenchmarkRecorder::~BenchmarkRecorder() {}
+
+
+void BenchmarkRecorder::startMeasurement(const QString& documentName, const QString& phase) {
+    Result result;
+    result.documentName        = documentName;
+    result.phase               = phase;
+    result.wallTimeNanoseconds = 0;
+    result.placementJobs       = 0;
+    result.peakMemoryBytes     = 0;
+
+    currentResults.append(result);
+
+    startingPlacementJobs = totalPlacementJobs();
+    timer.start();
+}
+
+
+const BenchmarkRecorder::Result& BenchmarkRecorder::endMeasurement() {
+    Result& result = currentResults.last();
+
+    result.wallTimeNanoseconds = static_cast<unsigned long long>(timer.nsecsElapsed());
+    result.placementJobs       = totalPlacementJobs() - startingPlacementJobs;
+    result.peakMemoryBytes     = peakMemoryBytes();
+
+    return result;
+}
+
+
+const QList<BenchmarkRecorder::Result>& BenchmarkRecorder::results() const {
+    return currentResults;
+}
+
+
+bool BenchmarkRecorder::writeResults() const {
+    QJsonArray resultArray;
+    for (  QList<Result>::const_iterator it = currentResults.constBegin(), end = currentResults.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        QJsonObject resultObject;
+        resultObject.insert("document", it->documentName);
+        resultObject.insert("phase", it->phase);
+        resultObject.insert("wall_time_ns", static_cast<double>(it->wallTimeNanoseconds));
+        resultObject.insert("placement_jobs", static_cast<double>(it->placementJobs));
+        resultObject.insert("peak_memory_bytes", static_cast<double>(it->peakMemoryBytes));
+
+        resultArray.append(resultObject);
+    }
+
+    QJsonObject rootObject;
+    rootObject.insert("benchmark", QString("ineapp"));
+    rootObject.insert("format_version", 1);
+    rootObject.insert("timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    rootObject.insert("platform", QSysInfo::prettyProductName());
+    rootObject.insert("cpu_architecture", QSysInfo::currentCpuArchitecture());
+    rootObject.insert("results", resultArray);
+
+    QByteArray json = QJsonDocument(rootObject).toJson(QJsonDocument::Indented);
+    bool       success;
+
+    if (currentOutputFilename.isEmpty()) {
+        std::size_t jsonSize = static_cast<std::size_t>(json.size());
+        success = (std::fwrite(json.constData(), 1, jsonSize, stdout) == jsonSize);
+        std::fflush(stdout);
+    } else {
+        QFile outputFile(currentOutputFilename);
+        success = outputFile.open(QFile::WriteOnly | QFile::Truncate);
+        if (success) {
+            success = (outputFile.write(json) == json.size());
+            outputFile.close();
+        }
+    }
+
+    return success;
+}
+
+
+unsigned long long BenchmarkRecorder::peakMemoryBytes() {
+    unsigned long long result;
+
+    #if (defined(Q_OS_WIN))
+
+        PROCESS_MEMORY_COUNTERS memoryCounters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters))) {
+            result = static_cast<unsigned long long>(memoryCounters.PeakWorkingSetSize);
+        } else {
+            result = 0;
+        }
+
+    #elif (defined(Q_OS_LINUX) || defined(Q_OS_DARWIN))
+
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            #if (defined(Q_OS_DARWIN))
+
+                result = static_cast<unsigned long long>(usage.ru_maxrss); // Reported in bytes on MacOS.
+
+            #else
+
+                result = static_cast<unsigned long long>(usage.ru_maxrss) * 1024ULL; // Reported in KiB on Linux.
+
+            #endif
+        } else {
+            result = 0;
+        }
+
+    #else
+
+        #error Unknown platform
+
+    #endif
+
+    return result;
+}
+
+
+void BenchmarkRecorder::placementStarted(unsigned long initialNumberJobs) {
+    completedPlacementJobs += currentPlacementJobs;
+    currentPlacementJobs    = initialNumberJobs;
+}
+
+
+void BenchmarkRecorder::pendingJobsChanged(unsigned long newNumberPendingJobs) {
+    currentPlacementJobs = newNumberPendingJobs;
+}
+
+
+unsigned long long BenchmarkRecorder::totalPlacementJobs() const {
+    return completedPlacementJobs + currentPlacementJobs;
+}
@@ -0,0 +1,162 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref BenchmarkRecorder class.
+***********************************************************************************************************************/
+
+#ifndef BENCHMARK_RECORDER_H
+#define BENCHMARK_RECORDER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+#include <QElapsedTimer>
+
+#include <placement_status_notifier.h>
+
+/**
+ * Class that records wall time, placement jobs and peak memory for each measured phase of a benchmark run.  Results
+ * are written as a single JSON document so that runs can be compared against a stored baseline.
+ *
+ * The class receives placement status from the root presentation in order to count the number of placement jobs
+ * performed during each phase.
+ */
+class BenchmarkRecorder:public PlacementStatusNotifier::Receiver {
+    public:
+        /**
+         * Class that holds the results of a single measurement.
+         */
+        class Result {
+            public:
+                /**
+                 * The name of the synthetic document being measured.
+                 */
+                QString documentName;
+
+                /**
+                 * The name of the measured phase.
+                 */
+                QString phase;
+
+                /**
+                 * The wall time of the phase, in nanoseconds.
+                 */
+                unsigned long long wallTimeNanoseconds;
+
+                /**
+                 * The number of placement jobs performed during the phase.
+                 */
+                unsigned long long placementJobs;
+
+                /**
+                 * The process peak resident memory at the end of the phase, in bytes.
+                 */
+                unsigned long long peakMemoryBytes;
+        };
+
+        /**
+         * Constructor.
+         *
+         * \param[in] outputFilename The file to receive the results.  An empty string will cause results to be
+         *                           written to stdout.
+         */
+        BenchmarkRecorder(const QString& outputFilename = QString());
+
+        ~BenchmarkRecorder() override;
+
+        /**
+         * Method you can use to start a measurement.
+         *
+         * \param[in] documentName The name of the synthetic document being measured.
+         *
+         * \param[in] phase        The name of the phase being measured.
+         */
+        void startMeasurement(const QString& documentName, const QString& phase);
+
+        /**
+         * Method you can use to end the measurement started by \ref BenchmarkRecorder::startMeasurement.
+         *
+         * \return Returns the results of the measurement.
+         */
+        const Result& endMeasurement();
+
+        /**
+         * Method you can use to obtain all the recorded results.
+         *
+         * \return Returns a list of recorded results, in the order they were measured.
+         */
+        const QList<Result>& results() const;
+
+        /**
+         * Method you can use to write the recorded results.
+         *
+         * \return Returns true on success, returns false on error.
+         */
+        bool writeResults() const;
+
+        /**
+         * Method you can use to determine the peak resident memory used by this process.
+         *
+         * \return Returns the peak resident memory, in bytes.  A value of 0 is returned if the peak resident memory
+         *         can not be determined on this platform.
+         */
+        static unsigned long long peakMemoryBytes();
+
+    protected:
+        /**
+         * Method that is called when a placement operation is started.
+         *
+         * \param[in] initialNumberJobs The initial number of jobs to be performed.
+         */
+        void placementStarted(unsigned long initialNumberJobs) override;
+
+        /**
+         * Method that is called when the number of pending jobs changes.
+         *
+         * \param[in] newNumberPendingJobs The new total number of jobs for this placement operation.
+         */
+        void pendingJobsChanged(unsigned long newNumberPendingJobs) override;
+
+    private:
+        /**
+         * Method that determines the total number of placement jobs reported since this recorder was created.
+         *
+         * \return Returns the total number of placement jobs.
+         */
+        unsigned long long totalPlacementJobs() const;
+
+        /**
+         * The file to receive the results.
+         */
+        QString currentOutputFilename;
+
+        /**
+         * Timer used to measure wall time.
+         */
+        QElapsedTimer timer;
+
+        /**
+         * The number of placement jobs in placement operations that have been superseded by later operations.
+         */
+        unsigned long long completedPlacementJobs;
+
+        /**
+         * The number of placement jobs in the current, or last, placement operation.
+         */
+        unsigned long long currentPlacementJobs;
+
+        /**
+         * The total number of placement jobs when the current measurement was started.
+         */
+        unsigned long long startingPlacementJobs;
+
+        /**
+         * The recorded results.
+         */
+        QList<Result> currentResults;
+};
+
+#endif
@@ -23,6 +23,9 @@ HEADERS = application_wrapper.h \
           test_root_child_location.h \
           test_root_presentation.h \
           test_command_container.h \
+          test_inspector_cell_cache.h \
+          test_paragraph_line_index.h \
+          test_function_search_index.h \
 
 #test_element_database.h \
 
@@ -39,6 +42,9 @@ SOURCES = test_ineapp.cpp \
           test_root_child_location.cpp \
           test_root_presentation.cpp \
           test_command_container.cpp \
+          test_inspector_cell_cache.cpp \
+          test_paragraph_line_index.cpp \
+          test_function_search_index.cpp \
 
 #test_element_database.cpp \
 
@@ -0,0 +1,184 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref FunctionSearchIndex class.  Every result is compared against
+* Ld::FunctionDatabase::search over the functions registered with the database.
+***********************************************************************************************************************/
+
+#include <QDebug>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QBitArray>
+#include <QSet>
+#include <QtTest/QtTest>
+
+#include <ld_variable_name.h>
+#include <ld_capabilities.h>
+#include <ld_function_data.h>
+#include <ld_function_database.h>
+
+#include <function_search_index.h>
+
+#include "test_function_search_index.h"
+
+TestFunctionSearchIndex::TestFunctionSearchIndex() {}
+
+
+TestFunctionSearchIndex::~TestFunctionSearchIndex() {}
+
+
+void TestFunctionSearchIndex::initTestCase() {
+    FunctionSearchIndex::build();
+}
+
+
+void TestFunctionSearchIndex::testEmptySearchString() {
+    QList<Ld::FunctionData> functions = Ld::FunctionDatabase::search(Ld::Capabilities(), QString(), QList<QString>());
+
+    QBitArray candidates = FunctionSearchIndex::capabilityMatches(Ld::Capabilities())
+                           & FunctionSearchIndex::categoryMatches(QList<QString>());
+
+    QCOMPARE(FunctionSearchIndex::numberEntries(), static_cast<unsigned>(functions.size()));
+    QCOMPARE(toCommands(FunctionSearchIndex::search(candidates, QString())), toCommands(functions));
+}
+
+
+void TestFunctionSearchIndex::testSearchStrings() {
+    QList<Ld::FunctionData> functions = Ld::FunctionDatabase::search(Ld::Capabilities(), QString(), QList<QString>());
+    if (functions.isEmpty()) {
+        QSKIP("No functions are registered with the function database.");
+    }
+
+    QBitArray      candidates = FunctionSearchIndex::capabilityMatches(Ld::Capabilities());
+    QList<QString> strings    = searchStrings(functions);
+
+    for (QList<QString>::const_iterator it=strings.constBegin(),end=strings.constEnd() ; it!=end ; ++it) {
+        QList<QString> expected = toCommands(Ld::FunctionDatabase::search(Ld::Capabilities(), *it, QList<QString>()));
+        QList<QString> measured = toCommands(FunctionSearchIndex::search(candidates, *it));
+
+        QVERIFY2(measured == expected, qPrintable(QString("Search string \"%1\"").arg(*it)));
+    }
+}
+
+
+void TestFunctionSearchIndex::testCategories() {
+    QList<Ld::FunctionData> functions  = Ld::FunctionDatabase::search(Ld::Capabilities(), QString(), QList<QString>());
+    QList<QString>          categories = Ld::FunctionDatabase::categories();
+    if (functions.isEmpty() || categories.isEmpty()) {
+        QSKIP("No function categories are registered with the function database.");
+    }
+
+    QBitArray      capabilityMatches = FunctionSearchIndex::capabilityMatches(Ld::Capabilities());
+    QList<QString> strings           = searchStrings(functions);
+    strings.prepend(QString());
+
+    QList<QList<QString>> categoryLists;
+    categoryLists.append(categories);
+    for (QList<QString>::const_iterator it=categories.constBegin(),end=categories.constEnd() ; it!=end ; ++it) {
+        categoryLists.append(QList<QString>() << *it);
+    }
+
+    if (categories.size() >= 2) {
+        categoryLists.append(QList<QString>() << categories.first() << categories.last());
+    }
+
+    for (  QList<QList<QString>>::const_iterator categoryIterator    = categoryLists.constBegin(),
+                                                 categoryEndIterator = categoryLists.constEnd()
+         ; categoryIterator != categoryEndIterator
+         ; ++categoryIterator
+        ) {
+        QBitArray candidates = capabilityMatches & FunctionSearchIndex::categoryMatches(*categoryIterator);
+
+        for (QList<QString>::const_iterator it=strings.constBegin(),end=strings.constEnd() ; it!=end ; ++it) {
+            QList<QString> expected = toCommands(
+                Ld::FunctionDatabase::search(Ld::Capabilities(), *it, *categoryIterator)
+            );
+            QList<QString> measured = toCommands(FunctionSearchIndex::search(candidates, *it));
+
+            QVERIFY2(
+                measured == expected,
+                qPrintable(
+                    QString("Search string \"%1\", categories \"%2\"").arg(*it).arg(categoryIterator->join(", "))
+                )
+            );
+        }
+    }
+}
+
+
+void TestFunctionSearchIndex::testInvalidate() {
+    unsigned long generation = FunctionSearchIndex::generation();
+
+    FunctionSearchIndex::invalidate();
+    QVERIFY(FunctionSearchIndex::generation() != generation);
+
+    QList<Ld::FunctionData> functions = Ld::FunctionDatabase::search(Ld::Capabilities(), QString(), QList<QString>());
+    QCOMPARE(FunctionSearchIndex::numberEntries(), static_cast<unsigned>(functions.size()));
+}
+
+
+QList<QString> TestFunctionSearchIndex::searchStrings(const QList<Ld::FunctionData>& functions) {
+    QSet<QString>  stringSet;
+    QList<QString> result;
+
+    for (QList<Ld::FunctionData>::const_iterator it=functions.constBegin(),end=functions.constEnd() ; it!=end ; ++it) {
+        const Ld::VariableName& variableName = it->userVisibleName();
+        QString                 text1        = variableName.text1();
+        QString                 text2        = variableName.text2();
+        QStringList             words        = it->description().split(
+            QChar(' '),
+            Qt::SplitBehaviorFlags::SkipEmptyParts
+        );
+
+        QList<QString> candidates;
+        candidates << text1 << text1.toUpper() << text1.left(1) << text1.left(2) << text1.mid(1) << text2;
+
+        if (!words.isEmpty()) {
+            candidates << words.first() << words.last().toLower() << words.first().left(3).toUpper();
+        }
+
+        for (  QList<QString>::const_iterator candidateIterator    = candidates.constBegin(),
+                                              candidateEndIterator = candidates.constEnd()
+             ; candidateIterator != candidateEndIterator
+             ; ++candidateIterator
+            ) {
+            if (!candidateIterator->isEmpty() && !stringSet.contains(*candidateIterator)) {
+                stringSet.insert(*candidateIterator);
+                result.append(*candidateIterator);
+            }
+        }
+    }
+
+    result.append(QString("zzqzzqzz"));
+    result.append(QString(" "));
+
+    return result;
+}
+
+
+QList<QString> TestFunctionSearchIndex::toCommands(const QVector<unsigned>& entryIndexes) {
+    QList<QString> result;
+
+    for (QVector<unsigned>::const_iterator it=entryIndexes.constBegin(),end=entryIndexes.constEnd() ; it!=end ; ++it) {
+        result.append(FunctionSearchIndex::entry(*it).functionData.functionCommand());
+    }
+
+    return result;
+}
+
+
+QList<QString> TestFunctionSearchIndex::toCommands(const QList<Ld::FunctionData>& functions) {
+    QList<QString> result;
+
+    for (QList<Ld::FunctionData>::const_iterator it=functions.constBegin(),end=functions.constEnd() ; it!=end ; ++it) {
+        result.append(it->functionCommand());
+    }
+
+    return result;
+}
@@ -0,0 +1,43 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides tests for the \ref FunctionSearchIndex class.
+***********************************************************************************************************************/
+
+#ifndef TEST_FUNCTION_SEARCH_INDEX_H
+#define TEST_FUNCTION_SEARCH_INDEX_H
+
+#include <QtGlobal>
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QtTest/QtTest>
+
+#include <ld_function_data.h>
+
+class TestFunctionSearchIndex:public QObject {
+    Q_OBJECT
+
+    public:
+        TestFunctionSearchIndex();
+
+        ~TestFunctionSearchIndex() override;
+
+    private slots:
+        void initTestCase();
+        void testEmptySearchString();
+        void testSearchStrings();
+        void testCategories();
+        void testInvalidate();
+
+    private:
+        static QList<QString> searchStrings(const QList<Ld::FunctionData>& functions);
+        static QList<QString> toCommands(const QVector<unsigned>& entryIndexes);
+        static QList<QString> toCommands(const QList<Ld::FunctionData>& functions);
+};
+
+#endif
@@ -25,6 +25,9 @@
 #include "test_root_child_location.h"
 #include "test_root_presentation.h"
 #include "test_command_container.h"
+#include "test_inspector_cell_cache.h"
+#include "test_paragraph_line_index.h"
+#include "test_function_search_index.h"
 
 int main(int argumentCount, char** argumentValues) {
     ApplicationWrapper wrapper(argumentCount, argumentValues);
@@ -41,6 +44,9 @@ int main(int argumentCount, char** argumentValues) {
     wrapper.includeTest(new TestRootChildLocation);
     wrapper.includeTest(new TestRootPresentation);
     wrapper.includeTest(new TestCommandContainer);
+    wrapper.includeTest(new TestInspectorCellCache);
+    wrapper.includeTest(new TestParagraphLineIndex);
+    wrapper.includeTest(new TestFunctionSearchIndex);
 
     int status = wrapper.exec();
 
@@ -0,0 +1,85 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref InspectorCellCache class.
+***********************************************************************************************************************/
+
+#include <QDebug>
+#include <QObject>
+#include <QString>
+#include <QtTest/QtTest>
+
+#include <inspector_cell_cache.h>
+
+#include "test_inspector_cell_cache.h"
+
+TestInspectorCellCache::TestInspectorCellCache() {}
+
+
+TestInspectorCellCache::~TestInspectorCellCache() {}
+
+
+void TestInspectorCellCache::initTestCase() {}
+
+
+void TestInspectorCellCache::testInsertAndLookup() {
+    InspectorCellCache cache;
+    QString            text;
+
+    QCOMPARE(cache.lookup(1, 2, 0, text), false);
+
+    cache.insert(1, 2, 0, QString("1.5"));
+    cache.insert(1, 2, 1, QString("1.50"));
+
+    QCOMPARE(cache.size(), 2);
+    QCOMPARE(cache.lookup(1, 2, 0, text), true);
+    QCOMPARE(text, QString("1.5"));
+    QCOMPARE(cache.lookup(1, 2, 1, text), true);
+    QCOMPARE(text, QString("1.50"));
+    QCOMPARE(cache.lookup(2, 1, 0, text), false);
+
+    cache.clear();
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.lookup(1, 2, 0, text), false);
+}
+
+
+void TestInspectorCellCache::testInvalidate() {
+    InspectorCellCache cache;
+    QString            text;
+
+    cache.insert(1, 2, 0, QString("a"));
+    cache.insert(1, 2, 1, QString("b"));
+    cache.insert(1, 3, 0, QString("c"));
+
+    cache.invalidate(1, 2);
+
+    QCOMPARE(cache.lookup(1, 2, 0, text), false);
+    QCOMPARE(cache.lookup(1, 2, 1, text), false);
+    QCOMPARE(cache.lookup(1, 3, 0, text), true);
+    QCOMPARE(text, QString("c"));
+}
+
+
+void TestInspectorCellCache::testEviction() {
+    InspectorCellCache cache(4);
+    QString            text;
+
+    QCOMPARE(cache.maximumNumberEntries(), 4);
+
+    for (unsigned long row=0 ; row<4 ; ++row) {
+        cache.insert(row, 0, 0, QString::number(row));
+    }
+
+    QCOMPARE(cache.lookup(0, 0, 0, text), true); // Row 0 is now the most recently used entry.
+
+    cache.insert(4, 0, 0, QString("4"));
+
+    QCOMPARE(cache.size(), 4);
+    QCOMPARE(cache.lookup(0, 0, 0, text), true);
+    QCOMPARE(cache.lookup(1, 0, 0, text), false);
+    QCOMPARE(cache.lookup(4, 0, 0, text), true);
+}
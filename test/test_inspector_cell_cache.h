@@ -0,0 +1,32 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides tests for the \ref InspectorCellCache class.
+***********************************************************************************************************************/
+
+#ifndef TEST_INSPECTOR_CELL_CACHE_H
+#define TEST_INSPECTOR_CELL_CACHE_H
+
+#include <QtGlobal>
+#include <QObject>
+#include <QtTest/QtTest>
+
+class TestInspectorCellCache:public QObject {
+    Q_OBJECT
+
+    public:
+        TestInspectorCellCache();
+
+        ~TestInspectorCellCache() override;
+
+    private slots:
+        void initTestCase();
+        void testInsertAndLookup();
+        void testInvalidate();
+        void testEviction();
+};
+
+#endif
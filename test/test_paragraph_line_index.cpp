@@ -0,0 +1,211 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref ParagraphLineIndex class.
+***********************************************************************************************************************/
+
+#include <QDebug>
+#include <QObject>
+#include <QList>
+#include <QRectF>
+#include <QtTest/QtTest>
+
+#include <random>
+#include <algorithm>
+
+#include <paragraph_line_index.h>
+
+#include "test_paragraph_line_index.h"
+
+TestParagraphLineIndex::TestParagraphLineIndex() {}
+
+
+TestParagraphLineIndex::~TestParagraphLineIndex() {}
+
+
+void TestParagraphLineIndex::initTestCase() {}
+
+
+void TestParagraphLineIndex::testConstructorsAndDestructors() {
+    ParagraphLineIndex::Entry entry(3, 2, QRectF(10, 20, 30, 40));
+    QVERIFY(entry.childIdentifier() == 3);
+    QVERIFY(entry.presentationAreaId() == 2);
+    QVERIFY(entry.rectangle() == QRectF(10, 20, 30, 40));
+
+    ParagraphLineIndex::Line line(1, 5, 17);
+    QVERIFY(line.areaIdentifier() == 1);
+    QVERIFY(line.top() == 5);
+    QVERIFY(line.bottom() == 17);
+    QVERIFY(line.entries().isEmpty());
+
+    line.append(entry);
+    QVERIFY(line.entries().size() == 1);
+
+    ParagraphLineIndex index;
+    QVERIFY(index.numberLines() == 0);
+
+    index.append(line);
+    QVERIFY(index.numberLines() == 1);
+    QVERIFY(index.line(0).areaIdentifier() == 1);
+
+    index.clear();
+    QVERIFY(index.numberLines() == 0);
+}
+
+
+void TestParagraphLineIndex::testLineAtMethodBasic() {
+    ParagraphLineIndex index;
+
+    QVERIFY(index.lineAt(0, 0) == ParagraphLineIndex::notFound);
+
+    index.append(ParagraphLineIndex::Line(0,  0, 12)); // 0
+    index.append(ParagraphLineIndex::Line(0, 12, 24)); // 1
+    index.append(ParagraphLineIndex::Line(0, 30, 42)); // 2
+    index.append(ParagraphLineIndex::Line(1,  0, 16)); // 3
+    index.append(ParagraphLineIndex::Line(1, 16, 28)); // 4
+    index.append(ParagraphLineIndex::Line(3,  4, 10)); // 5
+
+    QVERIFY(index.lineAt(0, -1) == ParagraphLineIndex::notFound);
+    QVERIFY(index.lineAt(0, 0) == 0);
+    QVERIFY(index.lineAt(0, 6) == 0);
+    QVERIFY(index.lineAt(0, 12) == 1);
+    QVERIFY(index.lineAt(0, 23) == 1);
+    QVERIFY(index.lineAt(0, 27) == ParagraphLineIndex::notFound);
+    QVERIFY(index.lineAt(0, 42) == 2);
+    QVERIFY(index.lineAt(0, 43) == ParagraphLineIndex::notFound);
+    QVERIFY(index.lineAt(1, 5) == 3);
+    QVERIFY(index.lineAt(1, 20) == 4);
+    QVERIFY(index.lineAt(1, 40) == ParagraphLineIndex::notFound);
+    QVERIFY(index.lineAt(2, 5) == ParagraphLineIndex::notFound);
+    QVERIFY(index.lineAt(3, 2) == ParagraphLineIndex::notFound);
+    QVERIFY(index.lineAt(3, 8) == 5);
+    QVERIFY(index.lineAt(4, 8) == ParagraphLineIndex::notFound);
+}
+
+
+void TestParagraphLineIndex::testEntryAtMethodBasic() {
+    ParagraphLineIndex::Line line(0, 0, 12);
+
+    QVERIFY(line.entryAt(5) == ParagraphLineIndex::notFound);
+
+    line.append(ParagraphLineIndex::Entry(0, 0, QRectF(10, 0, 20, 12))); // 0
+    line.append(ParagraphLineIndex::Entry(1, 0, QRectF(30, 2, 5, 10)));  // 1
+    line.append(ParagraphLineIndex::Entry(1, 1, QRectF(35, 0, 40, 12))); // 2
+
+    QVERIFY(line.entryAt(0) == 0);
+    QVERIFY(line.entryAt(10) == 0);
+    QVERIFY(line.entryAt(29.5) == 0);
+    QVERIFY(line.entryAt(30) == 1);
+    QVERIFY(line.entryAt(34) == 1);
+    QVERIFY(line.entryAt(35) == 2);
+    QVERIFY(line.entryAt(74) == 2);
+    QVERIFY(line.entryAt(1000) == 2);
+}
+
+
+void TestParagraphLineIndex::testTruncateAreasStartingAtMethod() {
+    ParagraphLineIndex index;
+
+    index.append(ParagraphLineIndex::Line(0,  0, 12));
+    index.append(ParagraphLineIndex::Line(0, 12, 24));
+    index.append(ParagraphLineIndex::Line(1,  0, 12));
+    index.append(ParagraphLineIndex::Line(2,  0, 12));
+    index.append(ParagraphLineIndex::Line(2, 12, 24));
+
+    index.truncateAreasStartingAt(3);
+    QVERIFY(index.numberLines() == 5);
+
+    index.truncateAreasStartingAt(2);
+    QVERIFY(index.numberLines() == 3);
+    QVERIFY(index.lineAt(2, 5) == ParagraphLineIndex::notFound);
+    QVERIFY(index.lineAt(1, 5) == 2);
+
+    index.truncateAreasStartingAt(0);
+    QVERIFY(index.numberLines() == 0);
+}
+
+
+void TestParagraphLineIndex::testLineAtMethodFuzz() {
+    std::mt19937 rng;
+    std::uniform_int_distribution<> numberAreasDistribution(1, maximumFuzzAreas);
+    std::uniform_int_distribution<> numberLinesDistribution(0, maximumFuzzLinesPerArea);
+    std::uniform_int_distribution<> numberEntriesDistribution(1, maximumFuzzEntriesPerLine);
+    std::uniform_int_distribution<> lineGapDistribution(0, 3);
+    std::exponential_distribution<> lineHeightDistribution(1.0 / meanLineHeight);
+    std::exponential_distribution<> entryWidthDistribution(1.0 / meanEntryWidth);
+
+    for (unsigned indexIteration=0 ; indexIteration<numberIndexIterations ; ++indexIteration) {
+        unsigned numberAreas = numberAreasDistribution(rng);
+        double   maximumY    = 0;
+        double   maximumX    = 0;
+
+        ParagraphLineIndex index;
+        for (unsigned areaIdentifier=0 ; areaIdentifier<numberAreas ; ++areaIdentifier) {
+            unsigned numberLines = numberLinesDistribution(rng);
+            double   y           = 0;
+
+            for (unsigned lineNumber=0 ; lineNumber<numberLines ; ++lineNumber) {
+                y += lineGapDistribution(rng) == 0 ? lineHeightDistribution(rng) : 0;
+
+                double                   height = lineHeightDistribution(rng) + 1.0;
+                ParagraphLineIndex::Line line(areaIdentifier, y, y + height);
+
+                unsigned numberEntries = numberEntriesDistribution(rng);
+                double   x             = 0;
+                for (unsigned entryIndex=0 ; entryIndex<numberEntries ; ++entryIndex) {
+                    double width = entryWidthDistribution(rng) + 0.5;
+                    line.append(ParagraphLineIndex::Entry(entryIndex, 0, QRectF(x, y, width, height)));
+                    x += width;
+                }
+
+                index.append(line);
+
+                maximumX  = std::max(maximumX, x);
+                y        += height;
+            }
+
+            maximumY = std::max(maximumY, y);
+        }
+
+        std::uniform_int_distribution<> searchAreaDistribution(0, numberAreas);
+        std::uniform_real_distribution<> searchYDistribution(-1.0, maximumY + 1.0);
+        std::uniform_real_distribution<> searchXDistribution(-1.0, maximumX + 1.0);
+
+        for (unsigned searchIndex=0 ; searchIndex<numberSearchIterationsPerIndex ; ++searchIndex) {
+            unsigned long searchArea = searchAreaDistribution(rng);
+            double        searchY    = searchYDistribution(rng);
+
+            long expectedLine = ParagraphLineIndex::notFound;
+            for (unsigned long lineNumber=0 ; lineNumber<index.numberLines() ; ++lineNumber) {
+                const ParagraphLineIndex::Line& line = index.line(lineNumber);
+                if (line.areaIdentifier() == searchArea && line.top() <= searchY) {
+                    expectedLine = static_cast<long>(lineNumber);
+                }
+            }
+
+            if (expectedLine != ParagraphLineIndex::notFound && searchY > index.line(expectedLine).bottom()) {
+                expectedLine = ParagraphLineIndex::notFound;
+            }
+
+            long testLine = index.lineAt(searchArea, searchY);
+            QCOMPARE(testLine, expectedLine);
+
+            if (testLine != ParagraphLineIndex::notFound) {
+                const ParagraphLineIndex::Line&         line    = index.line(static_cast<unsigned long>(testLine));
+                const QList<ParagraphLineIndex::Entry>& entries = line.entries();
+                double                                  searchX = searchXDistribution(rng);
+
+                long expectedEntry = 0;
+                while (expectedEntry < entries.size() - 1 && entries.at(expectedEntry).rectangle().right() <= searchX) {
+                    ++expectedEntry;
+                }
+
+                long testEntry = line.entryAt(searchX);
+                QCOMPARE(testEntry, expectedEntry);
+            }
+        }
+    }
+}
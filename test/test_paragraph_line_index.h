@@ -0,0 +1,43 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 Inesonic, LLC.
+* All rights reserved.
+********************************************************************************************************************//**
+* \file
+*
+* This header provides tests for the \ref ParagraphLineIndex class.
+***********************************************************************************************************************/
+
+#ifndef TEST_PARAGRAPH_LINE_INDEX_H
+#define TEST_PARAGRAPH_LINE_INDEX_H
+
+#include <QtGlobal>
+#include <QObject>
+#include <QtTest/QtTest>
+
+class TestParagraphLineIndex:public QObject {
+    Q_OBJECT
+
+    public:
+        TestParagraphLineIndex();
+
+        ~TestParagraphLineIndex() override;
+
+    private slots:
+        void initTestCase();
+        void testConstructorsAndDestructors();
+        void testLineAtMethodBasic();
+        void testEntryAtMethodBasic();
+        void testTruncateAreasStartingAtMethod();
+        void testLineAtMethodFuzz();
+
+    private:
+        static constexpr unsigned maximumFuzzAreas               = 8;
+        static constexpr unsigned maximumFuzzLinesPerArea        = 500;
+        static constexpr unsigned maximumFuzzEntriesPerLine      = 40;
+        static constexpr unsigned numberIndexIterations          = 50;
+        static constexpr unsigned numberSearchIterationsPerIndex = 200;
+        static constexpr double   meanLineHeight                 = 14.0;
+        static constexpr double   meanEntryWidth                 = 20.0;
+};
+
+#endif